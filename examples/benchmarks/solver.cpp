@@ -215,6 +215,22 @@ int run_benchmark(viennacl::context ctx)
   std::cout << "ViennaCL time: " << exec_time << std::endl;
 
 
+  std::cout << "------- ICHOLT with ViennaCL ----------" << std::endl;
+
+  timer.start();
+  viennacl::linalg::icholt_precond< viennacl::compressed_matrix<ScalarType> > vcl_icholt(vcl_compressed_matrix, viennacl::linalg::icholt_tag());
+  exec_time = timer.get();
+  std::cout << "Setup time: " << exec_time << std::endl;
+
+  viennacl::backend::finish();
+  timer.start();
+  for (int runs=0; runs<BENCHMARK_RUNS; ++runs)
+    vcl_icholt.apply(vcl_vec1);
+  viennacl::backend::finish();
+  exec_time = timer.get();
+  std::cout << "ViennaCL time: " << exec_time << std::endl;
+
+
   ///////////////////////////////////////////////////////////////////////////////
   //////////////////////           ILU preconditioner         //////////////////
   ///////////////////////////////////////////////////////////////////////////////
@@ -298,6 +314,22 @@ int run_benchmark(viennacl::context ctx)
   exec_time = timer.get();
   std::cout << "ViennaCL time: " << exec_time << std::endl;
 
+  std::cout << "------- Schwarz-ILU0 with ViennaCL ----------" << std::endl;
+
+  timer.start();
+  viennacl::linalg::schwarz_precond< viennacl::compressed_matrix<ScalarType>,
+                                     viennacl::linalg::ilu0_tag>            vcl_schwarz_ilu0(vcl_compressed_matrix, viennacl::linalg::ilu0_tag());
+  exec_time = timer.get();
+  std::cout << "Setup time: " << exec_time << std::endl;
+
+  viennacl::backend::finish();
+  timer.start();
+  for (int runs=0; runs<BENCHMARK_RUNS; ++runs)
+    vcl_schwarz_ilu0.apply(vcl_vec1);
+  viennacl::backend::finish();
+  exec_time = timer.get();
+  std::cout << "ViennaCL time: " << exec_time << std::endl;
+
   ////////////////////////////////////////////
 
   std::cout << "------- ILUT with ublas ----------" << std::endl;
@@ -427,6 +459,9 @@ int run_benchmark(viennacl::context ctx)
   std::cout << "------- CG solver (ICHOL0 preconditioner) via ViennaCL, compressed_matrix ----------" << std::endl;
   run_solver(vcl_compressed_matrix, vcl_vec2, vcl_result, cg_solver, vcl_ichol0, cg_ops);
 
+  std::cout << "------- CG solver (ICHOLT preconditioner) via ViennaCL, compressed_matrix ----------" << std::endl;
+  run_solver(vcl_compressed_matrix, vcl_vec2, vcl_result, cg_solver, vcl_icholt, cg_ops);
+
 
   std::cout << "------- CG solver (ILU0 preconditioner) using ublas ----------" << std::endl;
   run_solver(ublas_matrix, ublas_vec2, ublas_result, cg_solver, ublas_ilu0, cg_ops);
@@ -516,6 +551,9 @@ int run_benchmark(viennacl::context ctx)
   run_solver(vcl_compressed_matrix, vcl_vec2, vcl_result, bicgstab_solver, vcl_block_ilut, bicgstab_ops);
 #endif
 
+  std::cout << "------- BiCGStab solver (Schwarz-ILU0 preconditioner) via ViennaCL, compressed_matrix ----------" << std::endl;
+  run_solver(vcl_compressed_matrix, vcl_vec2, vcl_result, bicgstab_solver, vcl_schwarz_ilu0, bicgstab_ops);
+
 //  std::cout << "------- BiCGStab solver (ILUT preconditioner) via ViennaCL, coordinate_matrix ----------" << std::endl;
 //  run_solver(vcl_coordinate_matrix, vcl_vec2, vcl_result, bicgstab_solver, vcl_ilut, bicgstab_ops);
 
@@ -19,7 +19,7 @@
 /** \example amg.cpp
 *
 *   This tutorial shows the use of algebraic multigrid (AMG) preconditioners.
-*   \warning AMG is currently only experimentally available with the OpenCL backend and depends on Boost.uBLAS
+*   \warning AMG is currently only experimentally available and depends on Boost.uBLAS
 *
 *   We start with some rather general includes and preprocessor variables:
 **/
@@ -259,6 +259,28 @@ int main()
   amg_tag = viennacl::linalg::amg_tag(VIENNACL_AMG_COARSE_AG, VIENNACL_AMG_INTERPOL_SA, 0.08, 0.67, 0.67, 3, 3, 0);
   run_amg (cg_solver, ublas_vec, ublas_result, ublas_matrix, vcl_vec, vcl_result, vcl_compressed_matrix, "AG COARSENING, SA INTERPOLATION",amg_tag);
 
+  /**
+  * Instead of the default Jacobi smoother, other smoothers can be selected. Use a Chebyshev smoother with RS coarsening and direct interpolation:
+  **/
+  amg_tag = viennacl::linalg::amg_tag(VIENNACL_AMG_COARSE_RS, VIENNACL_AMG_INTERPOL_DIRECT, 0.25, 0.2, 0.67, 1, 1, 0);
+  amg_tag.set_smoother(VIENNACL_AMG_SMOOTHER_CHEBYSHEV);
+  run_amg (cg_solver, ublas_vec, ublas_result, ublas_matrix, vcl_vec, vcl_result, vcl_compressed_matrix, "RS COARSENING, DIRECT INTERPOLATION, CHEBYSHEV SMOOTHER", amg_tag);
+
+  /**
+  * Generate the setup for an AMG preconditioner with parallel HMIS coarsening, using aggressive coarsening on the finest level:
+  **/
+  amg_tag = viennacl::linalg::amg_tag(VIENNACL_AMG_COARSE_HMIS, VIENNACL_AMG_INTERPOL_DIRECT, 0.25, 0.2, 0.67, 1, 1, 0);
+  amg_tag.set_smoother(VIENNACL_AMG_SMOOTHER_SGS);
+  amg_tag.set_aggressive_levels(1);
+  run_amg (cg_solver, ublas_vec, ublas_result, ublas_matrix, vcl_vec, vcl_result, vcl_compressed_matrix, "HMIS COARSENING (AGGRESSIVE), MULTIPASS INTERPOLATION", amg_tag);
+
+  /**
+  * Generate the setup for an AMG preconditioner with smoothed aggregation based on MIS-2 aggregates:
+  **/
+  amg_tag = viennacl::linalg::amg_tag(VIENNACL_AMG_COARSE_MIS2, VIENNACL_AMG_INTERPOL_SA, 0.08, 0.67, 0.67, 1, 1, 0);
+  amg_tag.set_smoother(VIENNACL_AMG_SMOOTHER_SGS);
+  run_amg (cg_solver, ublas_vec, ublas_result, ublas_matrix, vcl_vec, vcl_result, vcl_compressed_matrix, "MIS-2 AGGREGATION, SA INTERPOLATION", amg_tag);
+
 
   /**
   *  That's it.
@@ -239,6 +239,18 @@ int main()
   vcl_result = viennacl::linalg::solve(vcl_compressed_matrix, vcl_rhs, viennacl::linalg::gmres_tag(1e-6, 20), vcl_ilut);//with preconditioner
   vcl_result = viennacl::linalg::solve(vcl_compressed_matrix, vcl_rhs, viennacl::linalg::gmres_tag(1e-6, 20), vcl_jacobi);//with preconditioner
 
+  /**
+  * A GMRES solver object keeps the Krylov basis and all other buffers between solver runs.
+  * Here the Krylov basis is orthogonalized with classical Gram-Schmidt and one reorthogonalization pass,
+  * and flexible GMRES allows for preconditioners which change between iterations.
+  **/
+  viennacl::linalg::gmres_tag fgmres_config(1e-6, 20);
+  fgmres_config.orthogonalization(viennacl::linalg::gmres_tag::classical_gram_schmidt_2);
+  fgmres_config.flexible(true);
+  viennacl::linalg::gmres_solver<viennacl::vector<ScalarType> > fgmres_solver(fgmres_config);
+  vcl_result = fgmres_solver(vcl_compressed_matrix, vcl_rhs, vcl_jacobi);
+  vcl_result = fgmres_solver(vcl_compressed_matrix, vcl_rhs, vcl_jacobi); // reuses the buffers of the previous run
+
   /**
   *  That's it, the tutorial is completed.
   **/
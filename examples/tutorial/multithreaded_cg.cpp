@@ -18,6 +18,7 @@
 /** \example multithreaded_cg.cpp
 *
 *   This tutorial shows how to run multiple instances of a conjugate gradient solver, one instance per GPU.
+*   On the host, each instance runs on its own set of CPU cores by means of host contexts.
 *
 *   We start with including the necessary headers:
 **/
@@ -28,6 +29,9 @@
 
 // include necessary system headers
 #include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
 
 //
 // ublas includes
@@ -50,6 +54,7 @@
 #include "viennacl/scalar.hpp"
 #include "viennacl/vector.hpp"
 #include "viennacl/compressed_matrix.hpp"
+#include "viennacl/host_context.hpp"
 #include "viennacl/io/matrix_market.hpp"
 
 #include "viennacl/ocl/device.hpp"
@@ -73,13 +78,13 @@ using namespace boost::numeric;
 
 /**
 *   This functor represents the work carried out in each thread.
-*   It creates the necessary objects, loads the data, and executes the CG solver.
+*   It creates the necessary objects in the provided context, loads the data, and executes the CG solver.
 **/
 template<typename NumericT>
 class worker
 {
 public:
-  worker(std::size_t tid) : thread_id_(tid) {}
+  worker(std::size_t tid, viennacl::context ctx, std::string const & device_name) : thread_id_(tid), ctx_(ctx), device_name_(device_name) {}
 
   /**
   *   The functor interface, entry point for each thread.
@@ -118,7 +123,7 @@ public:
     *  Set up some ViennaCL objects in the respective context.
     *  It is important to place the objects in the correct context (associated with each thread)
     **/
-    viennacl::context ctx(viennacl::ocl::get_context(static_cast<long>(thread_id_)));
+    viennacl::context ctx(ctx_);
 
     std::size_t vcl_size = rhs.size();
     viennacl::compressed_matrix<NumericT> vcl_compressed_matrix(ctx);
@@ -137,7 +142,7 @@ public:
     viennacl::vector<NumericT> vcl_result = viennacl::linalg::solve(vcl_compressed_matrix, vcl_rhs, viennacl::linalg::cg_tag());
 
     std::stringstream ss;
-    ss << "Result of thread " << thread_id_ << " on device " << viennacl::ocl::get_context(static_cast<long>(thread_id_)).devices()[0].name() << ": " << vcl_result[0] << ", should: " << ref_result[0] << std::endl;
+    ss << "Result of thread " << thread_id_ << " on " << device_name_ << ": " << vcl_result[0] << ", should: " << ref_result[0] << std::endl;
     message_ = ss.str();
   }
 
@@ -146,6 +151,8 @@ public:
 private:
   std::string message_;
   std::size_t thread_id_;
+  viennacl::context ctx_;
+  std::string device_name_;
 };
 
 /**
@@ -181,8 +188,8 @@ int main()
   * Part 2: Now let two threads operate on two GPUs in parallel, each running a CG solver
   **/
 
-  worker<ScalarType> work_functor0(0);
-  worker<ScalarType> work_functor1(1);
+  worker<ScalarType> work_functor0(0, viennacl::context(viennacl::ocl::get_context(0)), "device " + viennacl::ocl::get_context(0).devices()[0].name());
+  worker<ScalarType> work_functor1(1, viennacl::context(viennacl::ocl::get_context(1)), "device " + viennacl::ocl::get_context(1).devices()[0].name());
   boost::thread worker_thread_0(boost::ref(work_functor0));
   boost::thread worker_thread_1(boost::ref(work_functor1));
 
@@ -192,6 +199,35 @@ int main()
   std::cout << work_functor0.message() << std::endl;
   std::cout << work_functor1.message() << std::endl;
 
+  /**
+  * Part 3: Run two CG solvers concurrently on the host. Each host context owns a team of threads bound to one half of the CPUs,
+  *         so that the two solvers do not compete for the same cores (with OpenMP enabled).
+  *         The CPU binding of the threads is restored after each operation.
+  **/
+  unsigned int num_cpus = std::max(2u, boost::thread::hardware_concurrency());
+  std::vector<int> cpus0, cpus1;
+  for (unsigned int i = 0; i < num_cpus / 2; ++i)
+  {
+    cpus0.push_back(static_cast<int>(i));
+    cpus1.push_back(static_cast<int>(i + num_cpus / 2));
+  }
+
+  viennacl::host_context host_ctx0;
+  viennacl::host_context host_ctx1;
+  host_ctx0.cpu_affinity(cpus0);
+  host_ctx1.cpu_affinity(cpus1);
+
+  worker<ScalarType> host_functor0(0, viennacl::context(host_ctx0), "the first half of the CPUs");
+  worker<ScalarType> host_functor1(1, viennacl::context(host_ctx1), "the second half of the CPUs");
+  boost::thread host_thread_0(boost::ref(host_functor0));
+  boost::thread host_thread_1(boost::ref(host_functor1));
+
+  host_thread_0.join();
+  host_thread_1.join();
+
+  std::cout << host_functor0.message() << std::endl;
+  std::cout << host_functor1.message() << std::endl;
+
   /**
   *  That's it. Print a success message and exit.
   **/
@@ -86,6 +86,13 @@ typedef enum
   ViennaCLNonUnit
 } ViennaCLDiag;
 
+typedef enum
+{
+  ViennaCLInvalidSide, // for catching uninitialized and invalid values
+  ViennaCLLeft,
+  ViennaCLRight
+} ViennaCLSide;
+
 typedef enum
 {
   ViennaCLInvalidPrecision,  // for catching uninitialized and invalid values
@@ -609,6 +616,92 @@ VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDgemm(ViennaCLBackend back
 
 VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLtrsm(ViennaCLMatrix A, ViennaCLUplo uplo, ViennaCLDiag diag, ViennaCLMatrix B);
 
+// xSYRK: C <- alpha * A A^T + beta * C, where only the triangle of C given by uplo is computed. A^T A if A is transposed.
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLsyrk(ViennaCLHostScalar alpha, ViennaCLMatrix A, ViennaCLHostScalar beta, ViennaCLMatrix C, ViennaCLUplo uplo);
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostSsyrk(ViennaCLBackend backend,
+                                                            ViennaCLOrder orderA, ViennaCLTranspose transA,
+                                                            ViennaCLOrder orderC, ViennaCLUplo uplo,
+                                                            ViennaCLInt n, ViennaCLInt k,
+                                                            float alpha,
+                                                            float *A, ViennaCLInt offA_row, ViennaCLInt offA_col, ViennaCLInt incA_row, ViennaCLInt incA_col, ViennaCLInt lda,
+                                                            float beta,
+                                                            float *C, ViennaCLInt offC_row, ViennaCLInt offC_col, ViennaCLInt incC_row, ViennaCLInt incC_col, ViennaCLInt ldc);
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDsyrk(ViennaCLBackend backend,
+                                                            ViennaCLOrder orderA, ViennaCLTranspose transA,
+                                                            ViennaCLOrder orderC, ViennaCLUplo uplo,
+                                                            ViennaCLInt n, ViennaCLInt k,
+                                                            double alpha,
+                                                            double *A, ViennaCLInt offA_row, ViennaCLInt offA_col, ViennaCLInt incA_row, ViennaCLInt incA_col, ViennaCLInt lda,
+                                                            double beta,
+                                                            double *C, ViennaCLInt offC_row, ViennaCLInt offC_col, ViennaCLInt incC_row, ViennaCLInt incC_col, ViennaCLInt ldc);
+
+// xSYR2K: C <- alpha * (A B^T + B A^T) + beta * C, where only the triangle of C given by uplo is computed. A^T B + B^T A if A and B are transposed.
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLsyr2k(ViennaCLHostScalar alpha, ViennaCLMatrix A, ViennaCLMatrix B, ViennaCLHostScalar beta, ViennaCLMatrix C, ViennaCLUplo uplo);
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostSsyr2k(ViennaCLBackend backend,
+                                                             ViennaCLOrder orderA, ViennaCLOrder orderB, ViennaCLTranspose trans,
+                                                             ViennaCLOrder orderC, ViennaCLUplo uplo,
+                                                             ViennaCLInt n, ViennaCLInt k,
+                                                             float alpha,
+                                                             float *A, ViennaCLInt offA_row, ViennaCLInt offA_col, ViennaCLInt incA_row, ViennaCLInt incA_col, ViennaCLInt lda,
+                                                             float *B, ViennaCLInt offB_row, ViennaCLInt offB_col, ViennaCLInt incB_row, ViennaCLInt incB_col, ViennaCLInt ldb,
+                                                             float beta,
+                                                             float *C, ViennaCLInt offC_row, ViennaCLInt offC_col, ViennaCLInt incC_row, ViennaCLInt incC_col, ViennaCLInt ldc);
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDsyr2k(ViennaCLBackend backend,
+                                                             ViennaCLOrder orderA, ViennaCLOrder orderB, ViennaCLTranspose trans,
+                                                             ViennaCLOrder orderC, ViennaCLUplo uplo,
+                                                             ViennaCLInt n, ViennaCLInt k,
+                                                             double alpha,
+                                                             double *A, ViennaCLInt offA_row, ViennaCLInt offA_col, ViennaCLInt incA_row, ViennaCLInt incA_col, ViennaCLInt lda,
+                                                             double *B, ViennaCLInt offB_row, ViennaCLInt offB_col, ViennaCLInt incB_row, ViennaCLInt incB_col, ViennaCLInt ldb,
+                                                             double beta,
+                                                             double *C, ViennaCLInt offC_row, ViennaCLInt offC_col, ViennaCLInt incC_row, ViennaCLInt incC_col, ViennaCLInt ldc);
+
+// xSYMM: C <- alpha * A B + beta * C (left side) or C <- alpha * B A + beta * C (right side) for a symmetric matrix A of which only the triangle given by uplo is referenced
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLsymm(ViennaCLSide side, ViennaCLUplo uplo, ViennaCLHostScalar alpha, ViennaCLMatrix A, ViennaCLMatrix B, ViennaCLHostScalar beta, ViennaCLMatrix C);
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostSsymm(ViennaCLBackend backend,
+                                                            ViennaCLSide side, ViennaCLUplo uplo,
+                                                            ViennaCLOrder orderA, ViennaCLOrder orderB, ViennaCLOrder orderC,
+                                                            ViennaCLInt m, ViennaCLInt n,
+                                                            float alpha,
+                                                            float *A, ViennaCLInt offA_row, ViennaCLInt offA_col, ViennaCLInt incA_row, ViennaCLInt incA_col, ViennaCLInt lda,
+                                                            float *B, ViennaCLInt offB_row, ViennaCLInt offB_col, ViennaCLInt incB_row, ViennaCLInt incB_col, ViennaCLInt ldb,
+                                                            float beta,
+                                                            float *C, ViennaCLInt offC_row, ViennaCLInt offC_col, ViennaCLInt incC_row, ViennaCLInt incC_col, ViennaCLInt ldc);
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDsymm(ViennaCLBackend backend,
+                                                            ViennaCLSide side, ViennaCLUplo uplo,
+                                                            ViennaCLOrder orderA, ViennaCLOrder orderB, ViennaCLOrder orderC,
+                                                            ViennaCLInt m, ViennaCLInt n,
+                                                            double alpha,
+                                                            double *A, ViennaCLInt offA_row, ViennaCLInt offA_col, ViennaCLInt incA_row, ViennaCLInt incA_col, ViennaCLInt lda,
+                                                            double *B, ViennaCLInt offB_row, ViennaCLInt offB_col, ViennaCLInt incB_row, ViennaCLInt incB_col, ViennaCLInt ldb,
+                                                            double beta,
+                                                            double *C, ViennaCLInt offC_row, ViennaCLInt offC_col, ViennaCLInt incC_row, ViennaCLInt incC_col, ViennaCLInt ldc);
+
+// xTRMM: B <- alpha * A B (left side) or B <- alpha * B A (right side) for a triangular matrix A, optionally transposed
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLtrmm(ViennaCLSide side, ViennaCLUplo uplo, ViennaCLDiag diag, ViennaCLHostScalar alpha, ViennaCLMatrix A, ViennaCLMatrix B);
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostStrmm(ViennaCLBackend backend,
+                                                            ViennaCLSide side, ViennaCLUplo uplo, ViennaCLTranspose transA, ViennaCLDiag diag,
+                                                            ViennaCLOrder orderA, ViennaCLOrder orderB,
+                                                            ViennaCLInt m, ViennaCLInt n,
+                                                            float alpha,
+                                                            float *A, ViennaCLInt offA_row, ViennaCLInt offA_col, ViennaCLInt incA_row, ViennaCLInt incA_col, ViennaCLInt lda,
+                                                            float *B, ViennaCLInt offB_row, ViennaCLInt offB_col, ViennaCLInt incB_row, ViennaCLInt incB_col, ViennaCLInt ldb);
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDtrmm(ViennaCLBackend backend,
+                                                            ViennaCLSide side, ViennaCLUplo uplo, ViennaCLTranspose transA, ViennaCLDiag diag,
+                                                            ViennaCLOrder orderA, ViennaCLOrder orderB,
+                                                            ViennaCLInt m, ViennaCLInt n,
+                                                            double alpha,
+                                                            double *A, ViennaCLInt offA_row, ViennaCLInt offA_col, ViennaCLInt incA_row, ViennaCLInt incA_col, ViennaCLInt lda,
+                                                            double *B, ViennaCLInt offB_row, ViennaCLInt offB_col, ViennaCLInt incB_row, ViennaCLInt incB_col, ViennaCLInt ldb);
+
 #ifdef __cplusplus
 }
 #endif
@@ -270,3 +270,227 @@ VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLtrsm(ViennaCLMatrix A, ViennaC
 
 
 
+
+
+namespace detail
+{
+  /** @brief A dense matrix referring to the buffer of a matrix passed to the shared library */
+  template<typename NumericT>
+  class library_matrix : public viennacl::matrix_base<NumericT>
+  {
+    typedef viennacl::matrix_base<NumericT>            base_type;
+    typedef typename base_type::size_type              size_type;
+
+  public:
+    library_matrix(viennacl::backend::mem_handle & h, ViennaCLMatrix A)
+      : base_type(h,
+                  size_type(A->size1), size_type(A->start1), size_type(A->stride1), size_type(A->internal_size1),
+                  size_type(A->size2), size_type(A->start2), size_type(A->stride2), size_type(A->internal_size2), A->order == ViennaCLRowMajor) {}
+  };
+
+  template<typename NumericT>
+  ViennaCLStatus syrk_impl(NumericT alpha, ViennaCLMatrix A, viennacl::backend::mem_handle & A_handle,
+                           NumericT beta,  ViennaCLMatrix C, viennacl::backend::mem_handle & C_handle, ViennaCLUplo uplo)
+  {
+    if (A->backend->backend_type != ViennaCLHost)  // only available for the host backend
+      return ViennaCLGenericFailure;
+
+    library_matrix<NumericT> mat_A(A_handle, A);
+    library_matrix<NumericT> mat_C(C_handle, C);
+
+    if (uplo == ViennaCLLower)
+      viennacl::linalg::syrk(mat_A, A->trans == ViennaCLTrans, mat_C, alpha, beta, viennacl::linalg::lower_tag());
+    else if (uplo == ViennaCLUpper)
+      viennacl::linalg::syrk(mat_A, A->trans == ViennaCLTrans, mat_C, alpha, beta, viennacl::linalg::upper_tag());
+    else
+      return ViennaCLGenericFailure;
+    return ViennaCLSuccess;
+  }
+
+  template<typename NumericT>
+  ViennaCLStatus syr2k_impl(NumericT alpha, ViennaCLMatrix A, viennacl::backend::mem_handle & A_handle, ViennaCLMatrix B, viennacl::backend::mem_handle & B_handle,
+                            NumericT beta,  ViennaCLMatrix C, viennacl::backend::mem_handle & C_handle, ViennaCLUplo uplo)
+  {
+    if (A->backend->backend_type != ViennaCLHost)  // only available for the host backend
+      return ViennaCLGenericFailure;
+
+    if (A->trans != B->trans)
+      return ViennaCLGenericFailure;
+
+    library_matrix<NumericT> mat_A(A_handle, A);
+    library_matrix<NumericT> mat_B(B_handle, B);
+    library_matrix<NumericT> mat_C(C_handle, C);
+
+    if (uplo == ViennaCLLower)
+      viennacl::linalg::syr2k(mat_A, mat_B, A->trans == ViennaCLTrans, mat_C, alpha, beta, viennacl::linalg::lower_tag());
+    else if (uplo == ViennaCLUpper)
+      viennacl::linalg::syr2k(mat_A, mat_B, A->trans == ViennaCLTrans, mat_C, alpha, beta, viennacl::linalg::upper_tag());
+    else
+      return ViennaCLGenericFailure;
+    return ViennaCLSuccess;
+  }
+
+  template<typename NumericT>
+  ViennaCLStatus symm_impl(ViennaCLSide side, ViennaCLUplo uplo,
+                           NumericT alpha, ViennaCLMatrix A, viennacl::backend::mem_handle & A_handle, ViennaCLMatrix B, viennacl::backend::mem_handle & B_handle,
+                           NumericT beta,  ViennaCLMatrix C, viennacl::backend::mem_handle & C_handle)
+  {
+    if (A->backend->backend_type != ViennaCLHost)  // only available for the host backend
+      return ViennaCLGenericFailure;
+
+    if (side != ViennaCLLeft && side != ViennaCLRight)
+      return ViennaCLGenericFailure;
+
+    library_matrix<NumericT> mat_A(A_handle, A);
+    library_matrix<NumericT> mat_B(B_handle, B);
+    library_matrix<NumericT> mat_C(C_handle, C);
+
+    if (uplo == ViennaCLLower)
+      viennacl::linalg::symm(mat_A, viennacl::linalg::lower_tag(), mat_B, mat_C, alpha, beta, side == ViennaCLLeft);
+    else if (uplo == ViennaCLUpper)
+      viennacl::linalg::symm(mat_A, viennacl::linalg::upper_tag(), mat_B, mat_C, alpha, beta, side == ViennaCLLeft);
+    else
+      return ViennaCLGenericFailure;
+    return ViennaCLSuccess;
+  }
+
+  template<typename NumericT>
+  ViennaCLStatus trmm_impl(ViennaCLSide side, ViennaCLUplo uplo, ViennaCLDiag diag,
+                           NumericT alpha, ViennaCLMatrix A, viennacl::backend::mem_handle & A_handle, ViennaCLMatrix B, viennacl::backend::mem_handle & B_handle)
+  {
+    if (A->backend->backend_type != ViennaCLHost)  // only available for the host backend
+      return ViennaCLGenericFailure;
+
+    if (side != ViennaCLLeft && side != ViennaCLRight)
+      return ViennaCLGenericFailure;
+
+    library_matrix<NumericT> mat_A(A_handle, A);
+    library_matrix<NumericT> mat_B(B_handle, B);
+    bool trans_A = (A->trans == ViennaCLTrans);
+    bool left    = (side == ViennaCLLeft);
+
+    if (uplo == ViennaCLUpper && diag == ViennaCLNonUnit)
+      viennacl::linalg::trmm(mat_A, viennacl::linalg::upper_tag(), trans_A, mat_B, alpha, left);
+    else if (uplo == ViennaCLUpper && diag == ViennaCLUnit)
+      viennacl::linalg::trmm(mat_A, viennacl::linalg::unit_upper_tag(), trans_A, mat_B, alpha, left);
+    else if (uplo == ViennaCLLower && diag == ViennaCLNonUnit)
+      viennacl::linalg::trmm(mat_A, viennacl::linalg::lower_tag(), trans_A, mat_B, alpha, left);
+    else if (uplo == ViennaCLLower && diag == ViennaCLUnit)
+      viennacl::linalg::trmm(mat_A, viennacl::linalg::unit_lower_tag(), trans_A, mat_B, alpha, left);
+    else
+      return ViennaCLGenericFailure;
+    return ViennaCLSuccess;
+  }
+}
+
+// xSYRK
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLsyrk(ViennaCLHostScalar alpha, ViennaCLMatrix A, ViennaCLHostScalar beta, ViennaCLMatrix C, ViennaCLUplo uplo)
+{
+  viennacl::backend::mem_handle A_handle;
+  viennacl::backend::mem_handle C_handle;
+
+  if (init_matrix(A_handle, A) != ViennaCLSuccess)
+    return ViennaCLGenericFailure;
+
+  if (init_matrix(C_handle, C) != ViennaCLSuccess)
+    return ViennaCLGenericFailure;
+
+  switch (A->precision)
+  {
+    case ViennaCLFloat:
+      return detail::syrk_impl<float>(alpha->value_float, A, A_handle, beta->value_float, C, C_handle, uplo);
+
+    case ViennaCLDouble:
+      return detail::syrk_impl<double>(alpha->value_double, A, A_handle, beta->value_double, C, C_handle, uplo);
+
+    default:
+      return ViennaCLGenericFailure;
+  }
+}
+
+// xSYR2K
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLsyr2k(ViennaCLHostScalar alpha, ViennaCLMatrix A, ViennaCLMatrix B, ViennaCLHostScalar beta, ViennaCLMatrix C, ViennaCLUplo uplo)
+{
+  viennacl::backend::mem_handle A_handle;
+  viennacl::backend::mem_handle B_handle;
+  viennacl::backend::mem_handle C_handle;
+
+  if (init_matrix(A_handle, A) != ViennaCLSuccess)
+    return ViennaCLGenericFailure;
+
+  if (init_matrix(B_handle, B) != ViennaCLSuccess)
+    return ViennaCLGenericFailure;
+
+  if (init_matrix(C_handle, C) != ViennaCLSuccess)
+    return ViennaCLGenericFailure;
+
+  switch (A->precision)
+  {
+    case ViennaCLFloat:
+      return detail::syr2k_impl<float>(alpha->value_float, A, A_handle, B, B_handle, beta->value_float, C, C_handle, uplo);
+
+    case ViennaCLDouble:
+      return detail::syr2k_impl<double>(alpha->value_double, A, A_handle, B, B_handle, beta->value_double, C, C_handle, uplo);
+
+    default:
+      return ViennaCLGenericFailure;
+  }
+}
+
+// xSYMM
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLsymm(ViennaCLSide side, ViennaCLUplo uplo, ViennaCLHostScalar alpha, ViennaCLMatrix A, ViennaCLMatrix B, ViennaCLHostScalar beta, ViennaCLMatrix C)
+{
+  viennacl::backend::mem_handle A_handle;
+  viennacl::backend::mem_handle B_handle;
+  viennacl::backend::mem_handle C_handle;
+
+  if (init_matrix(A_handle, A) != ViennaCLSuccess)
+    return ViennaCLGenericFailure;
+
+  if (init_matrix(B_handle, B) != ViennaCLSuccess)
+    return ViennaCLGenericFailure;
+
+  if (init_matrix(C_handle, C) != ViennaCLSuccess)
+    return ViennaCLGenericFailure;
+
+  switch (A->precision)
+  {
+    case ViennaCLFloat:
+      return detail::symm_impl<float>(side, uplo, alpha->value_float, A, A_handle, B, B_handle, beta->value_float, C, C_handle);
+
+    case ViennaCLDouble:
+      return detail::symm_impl<double>(side, uplo, alpha->value_double, A, A_handle, B, B_handle, beta->value_double, C, C_handle);
+
+    default:
+      return ViennaCLGenericFailure;
+  }
+}
+
+// xTRMM
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLtrmm(ViennaCLSide side, ViennaCLUplo uplo, ViennaCLDiag diag, ViennaCLHostScalar alpha, ViennaCLMatrix A, ViennaCLMatrix B)
+{
+  viennacl::backend::mem_handle A_handle;
+  viennacl::backend::mem_handle B_handle;
+
+  if (init_matrix(A_handle, A) != ViennaCLSuccess)
+    return ViennaCLGenericFailure;
+
+  if (init_matrix(B_handle, B) != ViennaCLSuccess)
+    return ViennaCLGenericFailure;
+
+  switch (A->precision)
+  {
+    case ViennaCLFloat:
+      return detail::trmm_impl<float>(side, uplo, diag, alpha->value_float, A, A_handle, B, B_handle);
+
+    case ViennaCLDouble:
+      return detail::trmm_impl<double>(side, uplo, diag, alpha->value_double, A, A_handle, B, B_handle);
+
+    default:
+      return ViennaCLGenericFailure;
+  }
+}
@@ -129,3 +129,370 @@ VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDgemm(ViennaCLBackend back
 }
 
 
+
+
+//
+// xSYRK
+//
+
+namespace detail
+{
+  template <typename NumericT>
+  ViennaCLStatus ViennaCLHostsyrk_impl(ViennaCLBackend /*backend*/,
+                                       ViennaCLOrder orderA, ViennaCLTranspose transA,
+                                       ViennaCLOrder orderC, ViennaCLUplo uplo,
+                                       ViennaCLInt n, ViennaCLInt k,
+                                       NumericT alpha,
+                                       NumericT *A, ViennaCLInt offA_row, ViennaCLInt offA_col, ViennaCLInt incA_row, ViennaCLInt incA_col, ViennaCLInt lda,
+                                       NumericT beta,
+                                       NumericT *C, ViennaCLInt offC_row, ViennaCLInt offC_col, ViennaCLInt incC_row, ViennaCLInt incC_col, ViennaCLInt ldc)
+  {
+    typedef typename viennacl::matrix_base<NumericT>::size_type           size_type;
+    typedef typename viennacl::matrix_base<NumericT>::size_type           difference_type;
+
+    size_type A_size1 = static_cast<size_type>((transA == ViennaCLTrans) ? k : n);
+    size_type A_size2 = static_cast<size_type>((transA == ViennaCLTrans) ? n : k);
+
+    bool A_row_major = (orderA == ViennaCLRowMajor);
+    bool C_row_major = (orderC == ViennaCLRowMajor);
+
+    viennacl::matrix_base<NumericT> matA(A, viennacl::MAIN_MEMORY,
+                                         A_size1, size_type(offA_row), difference_type(incA_row), size_type(A_row_major ? A_size1 : lda),
+                                         A_size2, size_type(offA_col), difference_type(incA_col), size_type(A_row_major ? lda : A_size2), A_row_major);
+
+    viennacl::matrix_base<NumericT> matC(C, viennacl::MAIN_MEMORY,
+                                         size_type(n), size_type(offC_row), difference_type(incC_row), size_type(C_row_major ? n : ldc),
+                                         size_type(n), size_type(offC_col), difference_type(incC_col), size_type(C_row_major ? ldc : n), C_row_major);
+
+    if (uplo == ViennaCLLower)
+      viennacl::linalg::syrk(matA, transA == ViennaCLTrans, matC, alpha, beta, viennacl::linalg::lower_tag());
+    else if (uplo == ViennaCLUpper)
+      viennacl::linalg::syrk(matA, transA == ViennaCLTrans, matC, alpha, beta, viennacl::linalg::upper_tag());
+    else
+      return ViennaCLGenericFailure;
+
+    return ViennaCLSuccess;
+  }
+
+}
+
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostSsyrk(ViennaCLBackend backend,
+                                                            ViennaCLOrder orderA, ViennaCLTranspose transA,
+                                                            ViennaCLOrder orderC, ViennaCLUplo uplo,
+                                                            ViennaCLInt n, ViennaCLInt k,
+                                                            float alpha,
+                                                            float *A, ViennaCLInt offA_row, ViennaCLInt offA_col, ViennaCLInt incA_row, ViennaCLInt incA_col, ViennaCLInt lda,
+                                                            float beta,
+                                                            float *C, ViennaCLInt offC_row, ViennaCLInt offC_col, ViennaCLInt incC_row, ViennaCLInt incC_col, ViennaCLInt ldc)
+{
+  return detail::ViennaCLHostsyrk_impl<float>(backend,
+                                              orderA, transA,
+                                              orderC, uplo,
+                                              n, k,
+                                              alpha,
+                                              A, offA_row, offA_col, incA_row, incA_col, lda,
+                                              beta,
+                                              C, offC_row, offC_col, incC_row, incC_col, ldc);
+}
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDsyrk(ViennaCLBackend backend,
+                                                            ViennaCLOrder orderA, ViennaCLTranspose transA,
+                                                            ViennaCLOrder orderC, ViennaCLUplo uplo,
+                                                            ViennaCLInt n, ViennaCLInt k,
+                                                            double alpha,
+                                                            double *A, ViennaCLInt offA_row, ViennaCLInt offA_col, ViennaCLInt incA_row, ViennaCLInt incA_col, ViennaCLInt lda,
+                                                            double beta,
+                                                            double *C, ViennaCLInt offC_row, ViennaCLInt offC_col, ViennaCLInt incC_row, ViennaCLInt incC_col, ViennaCLInt ldc)
+{
+  return detail::ViennaCLHostsyrk_impl<double>(backend,
+                                               orderA, transA,
+                                               orderC, uplo,
+                                               n, k,
+                                               alpha,
+                                               A, offA_row, offA_col, incA_row, incA_col, lda,
+                                               beta,
+                                               C, offC_row, offC_col, incC_row, incC_col, ldc);
+}
+
+
+
+//
+// xSYR2K
+//
+
+namespace detail
+{
+  template <typename NumericT>
+  ViennaCLStatus ViennaCLHostsyr2k_impl(ViennaCLBackend /*backend*/,
+                                        ViennaCLOrder orderA, ViennaCLOrder orderB, ViennaCLTranspose trans,
+                                        ViennaCLOrder orderC, ViennaCLUplo uplo,
+                                        ViennaCLInt n, ViennaCLInt k,
+                                        NumericT alpha,
+                                        NumericT *A, ViennaCLInt offA_row, ViennaCLInt offA_col, ViennaCLInt incA_row, ViennaCLInt incA_col, ViennaCLInt lda,
+                                        NumericT *B, ViennaCLInt offB_row, ViennaCLInt offB_col, ViennaCLInt incB_row, ViennaCLInt incB_col, ViennaCLInt ldb,
+                                        NumericT beta,
+                                        NumericT *C, ViennaCLInt offC_row, ViennaCLInt offC_col, ViennaCLInt incC_row, ViennaCLInt incC_col, ViennaCLInt ldc)
+  {
+    typedef typename viennacl::matrix_base<NumericT>::size_type           size_type;
+    typedef typename viennacl::matrix_base<NumericT>::size_type           difference_type;
+
+    size_type AB_size1 = static_cast<size_type>((trans == ViennaCLTrans) ? k : n);
+    size_type AB_size2 = static_cast<size_type>((trans == ViennaCLTrans) ? n : k);
+
+    bool A_row_major = (orderA == ViennaCLRowMajor);
+    bool B_row_major = (orderB == ViennaCLRowMajor);
+    bool C_row_major = (orderC == ViennaCLRowMajor);
+
+    viennacl::matrix_base<NumericT> matA(A, viennacl::MAIN_MEMORY,
+                                         AB_size1, size_type(offA_row), difference_type(incA_row), size_type(A_row_major ? AB_size1 : lda),
+                                         AB_size2, size_type(offA_col), difference_type(incA_col), size_type(A_row_major ? lda : AB_size2), A_row_major);
+
+    viennacl::matrix_base<NumericT> matB(B, viennacl::MAIN_MEMORY,
+                                         AB_size1, size_type(offB_row), difference_type(incB_row), size_type(B_row_major ? AB_size1 : ldb),
+                                         AB_size2, size_type(offB_col), difference_type(incB_col), size_type(B_row_major ? ldb : AB_size2), B_row_major);
+
+    viennacl::matrix_base<NumericT> matC(C, viennacl::MAIN_MEMORY,
+                                         size_type(n), size_type(offC_row), difference_type(incC_row), size_type(C_row_major ? n : ldc),
+                                         size_type(n), size_type(offC_col), difference_type(incC_col), size_type(C_row_major ? ldc : n), C_row_major);
+
+    if (uplo == ViennaCLLower)
+      viennacl::linalg::syr2k(matA, matB, trans == ViennaCLTrans, matC, alpha, beta, viennacl::linalg::lower_tag());
+    else if (uplo == ViennaCLUpper)
+      viennacl::linalg::syr2k(matA, matB, trans == ViennaCLTrans, matC, alpha, beta, viennacl::linalg::upper_tag());
+    else
+      return ViennaCLGenericFailure;
+
+    return ViennaCLSuccess;
+  }
+
+}
+
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostSsyr2k(ViennaCLBackend backend,
+                                                             ViennaCLOrder orderA, ViennaCLOrder orderB, ViennaCLTranspose trans,
+                                                             ViennaCLOrder orderC, ViennaCLUplo uplo,
+                                                             ViennaCLInt n, ViennaCLInt k,
+                                                             float alpha,
+                                                             float *A, ViennaCLInt offA_row, ViennaCLInt offA_col, ViennaCLInt incA_row, ViennaCLInt incA_col, ViennaCLInt lda,
+                                                             float *B, ViennaCLInt offB_row, ViennaCLInt offB_col, ViennaCLInt incB_row, ViennaCLInt incB_col, ViennaCLInt ldb,
+                                                             float beta,
+                                                             float *C, ViennaCLInt offC_row, ViennaCLInt offC_col, ViennaCLInt incC_row, ViennaCLInt incC_col, ViennaCLInt ldc)
+{
+  return detail::ViennaCLHostsyr2k_impl<float>(backend,
+                                               orderA, orderB, trans,
+                                               orderC, uplo,
+                                               n, k,
+                                               alpha,
+                                               A, offA_row, offA_col, incA_row, incA_col, lda,
+                                               B, offB_row, offB_col, incB_row, incB_col, ldb,
+                                               beta,
+                                               C, offC_row, offC_col, incC_row, incC_col, ldc);
+}
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDsyr2k(ViennaCLBackend backend,
+                                                             ViennaCLOrder orderA, ViennaCLOrder orderB, ViennaCLTranspose trans,
+                                                             ViennaCLOrder orderC, ViennaCLUplo uplo,
+                                                             ViennaCLInt n, ViennaCLInt k,
+                                                             double alpha,
+                                                             double *A, ViennaCLInt offA_row, ViennaCLInt offA_col, ViennaCLInt incA_row, ViennaCLInt incA_col, ViennaCLInt lda,
+                                                             double *B, ViennaCLInt offB_row, ViennaCLInt offB_col, ViennaCLInt incB_row, ViennaCLInt incB_col, ViennaCLInt ldb,
+                                                             double beta,
+                                                             double *C, ViennaCLInt offC_row, ViennaCLInt offC_col, ViennaCLInt incC_row, ViennaCLInt incC_col, ViennaCLInt ldc)
+{
+  return detail::ViennaCLHostsyr2k_impl<double>(backend,
+                                                orderA, orderB, trans,
+                                                orderC, uplo,
+                                                n, k,
+                                                alpha,
+                                                A, offA_row, offA_col, incA_row, incA_col, lda,
+                                                B, offB_row, offB_col, incB_row, incB_col, ldb,
+                                                beta,
+                                                C, offC_row, offC_col, incC_row, incC_col, ldc);
+}
+
+
+//
+// xSYMM
+//
+
+namespace detail
+{
+  template <typename NumericT>
+  ViennaCLStatus ViennaCLHostsymm_impl(ViennaCLBackend /*backend*/,
+                                       ViennaCLSide side, ViennaCLUplo uplo,
+                                       ViennaCLOrder orderA, ViennaCLOrder orderB, ViennaCLOrder orderC,
+                                       ViennaCLInt m, ViennaCLInt n,
+                                       NumericT alpha,
+                                       NumericT *A, ViennaCLInt offA_row, ViennaCLInt offA_col, ViennaCLInt incA_row, ViennaCLInt incA_col, ViennaCLInt lda,
+                                       NumericT *B, ViennaCLInt offB_row, ViennaCLInt offB_col, ViennaCLInt incB_row, ViennaCLInt incB_col, ViennaCLInt ldb,
+                                       NumericT beta,
+                                       NumericT *C, ViennaCLInt offC_row, ViennaCLInt offC_col, ViennaCLInt incC_row, ViennaCLInt incC_col, ViennaCLInt ldc)
+  {
+    typedef typename viennacl::matrix_base<NumericT>::size_type           size_type;
+    typedef typename viennacl::matrix_base<NumericT>::size_type           difference_type;
+
+    if (side != ViennaCLLeft && side != ViennaCLRight)
+      return ViennaCLGenericFailure;
+
+    size_type A_size = static_cast<size_type>((side == ViennaCLLeft) ? m : n);
+
+    bool A_row_major = (orderA == ViennaCLRowMajor);
+    bool B_row_major = (orderB == ViennaCLRowMajor);
+    bool C_row_major = (orderC == ViennaCLRowMajor);
+
+    viennacl::matrix_base<NumericT> matA(A, viennacl::MAIN_MEMORY,
+                                         A_size, size_type(offA_row), difference_type(incA_row), size_type(A_row_major ? A_size : lda),
+                                         A_size, size_type(offA_col), difference_type(incA_col), size_type(A_row_major ? lda : A_size), A_row_major);
+
+    viennacl::matrix_base<NumericT> matB(B, viennacl::MAIN_MEMORY,
+                                         size_type(m), size_type(offB_row), difference_type(incB_row), size_type(B_row_major ? m : ldb),
+                                         size_type(n), size_type(offB_col), difference_type(incB_col), size_type(B_row_major ? ldb : n), B_row_major);
+
+    viennacl::matrix_base<NumericT> matC(C, viennacl::MAIN_MEMORY,
+                                         size_type(m), size_type(offC_row), difference_type(incC_row), size_type(C_row_major ? m : ldc),
+                                         size_type(n), size_type(offC_col), difference_type(incC_col), size_type(C_row_major ? ldc : n), C_row_major);
+
+    if (uplo == ViennaCLLower)
+      viennacl::linalg::symm(matA, viennacl::linalg::lower_tag(), matB, matC, alpha, beta, side == ViennaCLLeft);
+    else if (uplo == ViennaCLUpper)
+      viennacl::linalg::symm(matA, viennacl::linalg::upper_tag(), matB, matC, alpha, beta, side == ViennaCLLeft);
+    else
+      return ViennaCLGenericFailure;
+
+    return ViennaCLSuccess;
+  }
+
+}
+
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostSsymm(ViennaCLBackend backend,
+                                                            ViennaCLSide side, ViennaCLUplo uplo,
+                                                            ViennaCLOrder orderA, ViennaCLOrder orderB, ViennaCLOrder orderC,
+                                                            ViennaCLInt m, ViennaCLInt n,
+                                                            float alpha,
+                                                            float *A, ViennaCLInt offA_row, ViennaCLInt offA_col, ViennaCLInt incA_row, ViennaCLInt incA_col, ViennaCLInt lda,
+                                                            float *B, ViennaCLInt offB_row, ViennaCLInt offB_col, ViennaCLInt incB_row, ViennaCLInt incB_col, ViennaCLInt ldb,
+                                                            float beta,
+                                                            float *C, ViennaCLInt offC_row, ViennaCLInt offC_col, ViennaCLInt incC_row, ViennaCLInt incC_col, ViennaCLInt ldc)
+{
+  return detail::ViennaCLHostsymm_impl<float>(backend,
+                                              side, uplo,
+                                              orderA, orderB, orderC,
+                                              m, n,
+                                              alpha,
+                                              A, offA_row, offA_col, incA_row, incA_col, lda,
+                                              B, offB_row, offB_col, incB_row, incB_col, ldb,
+                                              beta,
+                                              C, offC_row, offC_col, incC_row, incC_col, ldc);
+}
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDsymm(ViennaCLBackend backend,
+                                                            ViennaCLSide side, ViennaCLUplo uplo,
+                                                            ViennaCLOrder orderA, ViennaCLOrder orderB, ViennaCLOrder orderC,
+                                                            ViennaCLInt m, ViennaCLInt n,
+                                                            double alpha,
+                                                            double *A, ViennaCLInt offA_row, ViennaCLInt offA_col, ViennaCLInt incA_row, ViennaCLInt incA_col, ViennaCLInt lda,
+                                                            double *B, ViennaCLInt offB_row, ViennaCLInt offB_col, ViennaCLInt incB_row, ViennaCLInt incB_col, ViennaCLInt ldb,
+                                                            double beta,
+                                                            double *C, ViennaCLInt offC_row, ViennaCLInt offC_col, ViennaCLInt incC_row, ViennaCLInt incC_col, ViennaCLInt ldc)
+{
+  return detail::ViennaCLHostsymm_impl<double>(backend,
+                                               side, uplo,
+                                               orderA, orderB, orderC,
+                                               m, n,
+                                               alpha,
+                                               A, offA_row, offA_col, incA_row, incA_col, lda,
+                                               B, offB_row, offB_col, incB_row, incB_col, ldb,
+                                               beta,
+                                               C, offC_row, offC_col, incC_row, incC_col, ldc);
+}
+
+
+//
+// xTRMM
+//
+
+namespace detail
+{
+  template <typename NumericT>
+  ViennaCLStatus ViennaCLHosttrmm_impl(ViennaCLBackend /*backend*/,
+                                       ViennaCLSide side, ViennaCLUplo uplo, ViennaCLTranspose transA, ViennaCLDiag diag,
+                                       ViennaCLOrder orderA, ViennaCLOrder orderB,
+                                       ViennaCLInt m, ViennaCLInt n,
+                                       NumericT alpha,
+                                       NumericT *A, ViennaCLInt offA_row, ViennaCLInt offA_col, ViennaCLInt incA_row, ViennaCLInt incA_col, ViennaCLInt lda,
+                                       NumericT *B, ViennaCLInt offB_row, ViennaCLInt offB_col, ViennaCLInt incB_row, ViennaCLInt incB_col, ViennaCLInt ldb)
+  {
+    typedef typename viennacl::matrix_base<NumericT>::size_type           size_type;
+    typedef typename viennacl::matrix_base<NumericT>::size_type           difference_type;
+
+    if (side != ViennaCLLeft && side != ViennaCLRight)
+      return ViennaCLGenericFailure;
+
+    size_type A_size = static_cast<size_type>((side == ViennaCLLeft) ? m : n);
+
+    bool A_row_major = (orderA == ViennaCLRowMajor);
+    bool B_row_major = (orderB == ViennaCLRowMajor);
+
+    viennacl::matrix_base<NumericT> matA(A, viennacl::MAIN_MEMORY,
+                                         A_size, size_type(offA_row), difference_type(incA_row), size_type(A_row_major ? A_size : lda),
+                                         A_size, size_type(offA_col), difference_type(incA_col), size_type(A_row_major ? lda : A_size), A_row_major);
+
+    viennacl::matrix_base<NumericT> matB(B, viennacl::MAIN_MEMORY,
+                                         size_type(m), size_type(offB_row), difference_type(incB_row), size_type(B_row_major ? m : ldb),
+                                         size_type(n), size_type(offB_col), difference_type(incB_col), size_type(B_row_major ? ldb : n), B_row_major);
+
+    bool trans_A = (transA == ViennaCLTrans);
+    bool left    = (side == ViennaCLLeft);
+
+    if (uplo == ViennaCLUpper && diag == ViennaCLNonUnit)
+      viennacl::linalg::trmm(matA, viennacl::linalg::upper_tag(), trans_A, matB, alpha, left);
+    else if (uplo == ViennaCLUpper && diag == ViennaCLUnit)
+      viennacl::linalg::trmm(matA, viennacl::linalg::unit_upper_tag(), trans_A, matB, alpha, left);
+    else if (uplo == ViennaCLLower && diag == ViennaCLNonUnit)
+      viennacl::linalg::trmm(matA, viennacl::linalg::lower_tag(), trans_A, matB, alpha, left);
+    else if (uplo == ViennaCLLower && diag == ViennaCLUnit)
+      viennacl::linalg::trmm(matA, viennacl::linalg::unit_lower_tag(), trans_A, matB, alpha, left);
+    else
+      return ViennaCLGenericFailure;
+
+    return ViennaCLSuccess;
+  }
+
+}
+
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostStrmm(ViennaCLBackend backend,
+                                                            ViennaCLSide side, ViennaCLUplo uplo, ViennaCLTranspose transA, ViennaCLDiag diag,
+                                                            ViennaCLOrder orderA, ViennaCLOrder orderB,
+                                                            ViennaCLInt m, ViennaCLInt n,
+                                                            float alpha,
+                                                            float *A, ViennaCLInt offA_row, ViennaCLInt offA_col, ViennaCLInt incA_row, ViennaCLInt incA_col, ViennaCLInt lda,
+                                                            float *B, ViennaCLInt offB_row, ViennaCLInt offB_col, ViennaCLInt incB_row, ViennaCLInt incB_col, ViennaCLInt ldb)
+{
+  return detail::ViennaCLHosttrmm_impl<float>(backend,
+                                              side, uplo, transA, diag,
+                                              orderA, orderB,
+                                              m, n,
+                                              alpha,
+                                              A, offA_row, offA_col, incA_row, incA_col, lda,
+                                              B, offB_row, offB_col, incB_row, incB_col, ldb);
+}
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDtrmm(ViennaCLBackend backend,
+                                                            ViennaCLSide side, ViennaCLUplo uplo, ViennaCLTranspose transA, ViennaCLDiag diag,
+                                                            ViennaCLOrder orderA, ViennaCLOrder orderB,
+                                                            ViennaCLInt m, ViennaCLInt n,
+                                                            double alpha,
+                                                            double *A, ViennaCLInt offA_row, ViennaCLInt offA_col, ViennaCLInt incA_row, ViennaCLInt incA_col, ViennaCLInt lda,
+                                                            double *B, ViennaCLInt offB_row, ViennaCLInt offB_col, ViennaCLInt incB_row, ViennaCLInt incB_col, ViennaCLInt ldb)
+{
+  return detail::ViennaCLHosttrmm_impl<double>(backend,
+                                               side, uplo, transA, diag,
+                                               orderA, orderB,
+                                               m, n,
+                                               alpha,
+                                               A, offA_row, offA_col, incA_row, incA_col, lda,
+                                               B, offB_row, offB_col, incB_row, incB_col, ldb);
+}
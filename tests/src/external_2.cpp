@@ -52,6 +52,7 @@
 #include "viennacl/linalg/bisect_gpu.hpp"
 #include "viennacl/linalg/cg.hpp"
 #include "viennacl/linalg/direct_solve.hpp"
+#include "viennacl/linalg/gauss_seidel.hpp"
 #include "viennacl/linalg/gmres.hpp"
 #include "viennacl/linalg/ichol.hpp"
 #include "viennacl/linalg/ilu.hpp"
@@ -67,6 +68,8 @@
 #include "viennacl/linalg/reduce.hpp"
 #include "viennacl/linalg/row_scaling.hpp"
 #include "viennacl/linalg/tql2.hpp"
+#include "viennacl/linalg/tridiag_eig.hpp"
+#include "viennacl/linalg/qr-method-reduction.hpp"
 
 #include "viennacl/misc/bandwidth_reduction.hpp"
 
@@ -0,0 +1,421 @@
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+
+/** \file tests/src/host_context.cpp  Tests host contexts: results of operations in a host context, the thread team of preconditioners, and the restoration of the CPU binding.
+*   \test  Tests host contexts: results of operations in a host context, the thread team of preconditioners, and the restoration of the CPU binding.
+**/
+
+//
+// *** System
+//
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <map>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/host_context.hpp"
+#include "viennacl/context.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/inner_prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/ilu.hpp"
+
+#if defined(VIENNACL_WITH_OPENMP) && defined(__linux__) && defined(CPU_SET)
+  #define VIENNACL_TEST_AFFINITY
+#endif
+
+
+typedef double     NumericT;
+
+#ifdef VIENNACL_TEST_AFFINITY
+/** @brief Returns the CPU masks of the threads of an OpenMP team of the given size */
+std::vector<cpu_set_t> team_masks(int team_size)
+{
+  std::vector<cpu_set_t> masks(static_cast<std::size_t>(team_size));
+  #pragma omp parallel num_threads(team_size)
+  {
+    std::size_t tid = static_cast<std::size_t>(omp_get_thread_num());
+    CPU_ZERO(&masks[tid]);
+    sched_getaffinity(0, sizeof(cpu_set_t), &masks[tid]);
+  }
+  return masks;
+}
+
+/** @brief Returns true if the CPU masks of the threads of the team agree with the given masks */
+bool same_masks(std::vector<cpu_set_t> const & masks1, std::vector<cpu_set_t> const & masks2)
+{
+  if (masks1.size() != masks2.size())
+    return false;
+  for (std::size_t i=0; i<masks1.size(); ++i)
+    if (!CPU_EQUAL(&masks1[i], &masks2[i]))
+      return false;
+  return true;
+}
+#endif
+
+//
+// -------------------------------------------------------------
+//
+int test_settings()
+{
+  viennacl::host_context ctx;
+  long id = ctx.id();
+  if (ctx.team_size() != 0 || ctx.is_bound())
+  {
+    std::cout << "# Error: Default host context must use the default team" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  ctx.num_threads(3);
+  if (ctx.team_size() != 3 || ctx.id() == id)
+  {
+    std::cout << "# Error: Number of threads not set" << std::endl;
+    return EXIT_FAILURE;
+  }
+  id = ctx.id();
+
+  std::vector<int> cpus(2, 0);
+  ctx.num_threads(0);
+  ctx.cpu_affinity(cpus);
+  if (ctx.team_size() != 2 || !ctx.is_bound() || ctx.id() == id)
+  {
+    std::cout << "# Error: CPU affinity not set" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // a context in a host context is in main memory and refers to the host context:
+  viennacl::context vcl_ctx(ctx);
+  if (vcl_ctx.memory_type() != viennacl::MAIN_MEMORY || vcl_ctx.host_context_ptr() != &ctx)
+  {
+    std::cout << "# Error: viennacl::context does not refer to the host context" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int test_operations(viennacl::host_context const & host_ctx)
+{
+  std::size_t n = 2000;
+  viennacl::context ctx(host_ctx);
+
+  std::vector<NumericT> host_x(n), host_y(n);
+  for (std::size_t i=0; i<n; ++i)
+  {
+    host_x[i] = NumericT(1) + NumericT(i % 13);
+    host_y[i] = NumericT(2) - NumericT(i % 7);
+  }
+
+  viennacl::vector<NumericT> x(n, ctx), y(n, ctx);
+  viennacl::copy(host_x, x);
+  viennacl::copy(host_y, y);
+
+  // results and temporaries are created in the host context:
+  viennacl::vector<NumericT> z = x + NumericT(2) * y;
+  if (viennacl::traits::context(z).host_context_ptr() != &host_ctx)
+  {
+    std::cout << "# Error: Result is not in the host context" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::vector<NumericT> host_z(n);
+  viennacl::copy(z, host_z);
+  NumericT ref_dot = 0;
+  for (std::size_t i=0; i<n; ++i)
+  {
+    if (std::fabs(host_z[i] - (host_x[i] + 2 * host_y[i])) > 0)
+    {
+      std::cout << "# Error: Vector addition in host context, entry " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+    ref_dot += host_x[i] * host_y[i];
+  }
+
+  NumericT dot = viennacl::linalg::inner_prod(x, y);
+  if (std::fabs(dot - ref_dot) > 1e-12 * std::fabs(ref_dot))
+  {
+    std::cout << "# Error: Inner product in host context: " << dot << " vs. " << ref_dot << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // CG on a 1D Laplace operator:
+  std::vector< std::map<unsigned int, NumericT> > host_A(n);
+  for (std::size_t i=0; i<n; ++i)
+  {
+    host_A[i][static_cast<unsigned int>(i)] = 2.5;
+    if (i > 0)     host_A[i][static_cast<unsigned int>(i - 1)] = -1;
+    if (i + 1 < n) host_A[i][static_cast<unsigned int>(i + 1)] = -1;
+  }
+  viennacl::compressed_matrix<NumericT> A(n, n, ctx);
+  viennacl::copy(host_A, A);
+
+  viennacl::linalg::cg_tag tag(1e-10, 200);
+  viennacl::vector<NumericT> result = viennacl::linalg::solve(A, x, tag);
+  viennacl::vector<NumericT> residual = x - viennacl::linalg::prod(A, result);
+  NumericT rel_residual = viennacl::linalg::norm_2(residual) / viennacl::linalg::norm_2(x);
+  std::cout << "  CG in host context: " << tag.iters() << " iterations, relative residual " << rel_residual << std::endl;
+  if (rel_residual > 1e-8)
+  {
+    std::cout << "# Error: CG in host context did not converge" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+#ifdef VIENNACL_WITH_OPENMP
+/** @brief The Schwarz preconditioner uses one subdomain per thread of the team of the system matrix by default */
+int test_preconditioner_team(std::size_t threads)
+{
+  std::size_t n = 1000;
+  viennacl::host_context host_ctx(threads);
+  viennacl::context ctx(host_ctx);
+
+  std::vector< std::map<unsigned int, NumericT> > host_A(n);
+  for (std::size_t i=0; i<n; ++i)
+  {
+    host_A[i][static_cast<unsigned int>(i)] = 2.5;
+    if (i > 0)     host_A[i][static_cast<unsigned int>(i - 1)] = -1;
+    if (i + 1 < n) host_A[i][static_cast<unsigned int>(i + 1)] = -1;
+  }
+  viennacl::compressed_matrix<NumericT> A(n, n, ctx);
+  viennacl::copy(host_A, A);
+
+  // run an operation in the default context before, so that the team of host_ctx is activated by the preconditioner:
+  {
+    viennacl::vector<NumericT> v = viennacl::scalar_vector<NumericT>(10, NumericT(1));
+    v += v;
+  }
+
+  viennacl::linalg::schwarz_precond<viennacl::compressed_matrix<NumericT>, viennacl::linalg::ilu0_tag> schwarz(A, viennacl::linalg::ilu0_tag());
+  if (schwarz.num_subdomains() != threads)
+  {
+    std::cout << "# Error: Schwarz preconditioner in a host context with " << threads << " threads uses " << schwarz.num_subdomains() << " subdomains" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  viennacl::vector<NumericT> x = viennacl::scalar_vector<NumericT>(n, NumericT(1));
+  viennacl::linalg::cg_tag tag(1e-10, 200);
+  viennacl::vector<NumericT> result = viennacl::linalg::solve(A, x, tag, schwarz);
+  viennacl::vector<NumericT> residual = x - viennacl::linalg::prod(A, result);
+  if (viennacl::linalg::norm_2(residual) > 1e-8 * viennacl::linalg::norm_2(x))
+  {
+    std::cout << "# Error: CG with Schwarz preconditioner in host context did not converge" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+#endif
+
+//
+// -------------------------------------------------------------
+//
+#ifdef VIENNACL_TEST_AFFINITY
+int test_affinity()
+{
+  int default_threads = omp_get_max_threads();
+  std::vector<cpu_set_t> default_masks = team_masks(default_threads);
+
+  // bind the team to the first CPU available to the process:
+  int cpu = 0;
+  while (cpu < CPU_SETSIZE && !CPU_ISSET(cpu, &default_masks[0]))
+    ++cpu;
+
+  viennacl::host_context host_ctx(2);
+  host_ctx.cpu_affinity(std::vector<int>(1, cpu));
+
+  {
+    viennacl::detail::host_context_scope scope(&host_ctx);
+
+    if (omp_get_max_threads() != 2)
+    {
+      std::cout << "# Error: Team size in scope: " << omp_get_max_threads() << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::vector<cpu_set_t> masks = team_masks(2);
+    for (std::size_t i=0; i<masks.size(); ++i)
+      if (CPU_COUNT(&masks[i]) != 1 || !CPU_ISSET(cpu, &masks[i]))
+      {
+        std::cout << "# Error: Thread " << i << " is not bound to CPU " << cpu << std::endl;
+        return EXIT_FAILURE;
+      }
+
+    {
+      viennacl::detail::host_context_scope nested_scope(&host_ctx);
+    }
+    if (!CPU_EQUAL(&team_masks(2)[0], &masks[0]))
+    {
+      std::cout << "# Error: Nested scope of the same context changed the binding" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // a nested scope of another context reactivates the enclosing context when it ends:
+    {
+      viennacl::detail::host_context_scope nested_scope(NULL);
+      if (omp_get_max_threads() != default_threads || !same_masks(team_masks(default_threads), default_masks))
+      {
+        std::cout << "# Error: Default team not restored in nested scope" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    if (omp_get_max_threads() != 2 || !same_masks(team_masks(2), masks))
+    {
+      std::cout << "# Error: Enclosing context not reactivated after nested scope" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // the configuration is kept for the next scope of the same context:
+  if (omp_get_max_threads() != 2 || !CPU_ISSET(cpu, &team_masks(2)[0]) || CPU_COUNT(&team_masks(2)[0]) != 1)
+  {
+    std::cout << "# Error: Binding not kept after scope" << std::endl;
+    return EXIT_FAILURE;
+  }
+  sched_setaffinity(0, sizeof(cpu_set_t), &default_masks[0]);
+  omp_set_num_threads(3);
+  {
+    viennacl::detail::host_context_scope scope(&host_ctx);
+    if (omp_get_max_threads() != 3)
+    {
+      std::cout << "# Error: Scope of the active context reset the number of threads" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    sched_getaffinity(0, sizeof(cpu_set_t), &mask);
+    if (!CPU_EQUAL(&mask, &default_masks[0]))
+    {
+      std::cout << "# Error: Scope of the active context rebound the team" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // the default context restores the default team:
+  {
+    viennacl::detail::host_context_scope scope(NULL);
+  }
+  if (omp_get_max_threads() != default_threads || !same_masks(team_masks(default_threads), default_masks))
+  {
+    std::cout << "# Error: Number of threads or CPU binding not restored by the default context" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // a modified context is applied again:
+  host_ctx.num_threads(1);
+  {
+    viennacl::detail::host_context_scope scope(&host_ctx);
+    if (omp_get_max_threads() != 1)
+    {
+      std::cout << "# Error: Modified context not applied: " << omp_get_max_threads() << " threads" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  host_ctx.num_threads(2);
+
+  // operations in the default context restore the default team after operations in a host context:
+  if (test_operations(host_ctx) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  {
+    viennacl::vector<NumericT> v = viennacl::scalar_vector<NumericT>(10, NumericT(1));
+    v += v;
+  }
+  if (omp_get_max_threads() != default_threads || !same_masks(team_masks(default_threads), default_masks))
+  {
+    std::cout << "# Error: Number of threads or CPU binding not restored after operations in the default context" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // destroying the active context restores the default team:
+  {
+    viennacl::host_context tmp_ctx(2);
+    tmp_ctx.cpu_affinity(std::vector<int>(1, cpu));
+    viennacl::detail::host_context_scope scope(&tmp_ctx);
+  }
+  if (omp_get_max_threads() != default_threads || !same_masks(team_masks(default_threads), default_masks))
+  {
+    std::cout << "# Error: Number of threads or CPU binding not restored after destroying the active context" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+#endif
+
+//
+// -------------------------------------------------------------
+//
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Host Contexts" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  std::cout << "# Testing settings" << std::endl;
+  if (test_settings() != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << "# Testing operations in host contexts" << std::endl;
+  {
+    viennacl::host_context default_team;
+    if (test_operations(default_team) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
+    viennacl::host_context two_threads(2);
+    if (test_operations(two_threads) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+#ifdef VIENNACL_WITH_OPENMP
+  std::cout << "# Testing thread team of preconditioners" << std::endl;
+  if (test_preconditioner_team(2) != EXIT_SUCCESS || test_preconditioner_team(3) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+#endif
+
+#ifdef VIENNACL_TEST_AFFINITY
+  std::cout << "# Testing CPU binding" << std::endl;
+  if (test_affinity() != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+#endif
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
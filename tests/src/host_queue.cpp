@@ -0,0 +1,385 @@
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+
+/** \file tests/src/host_queue.cpp  Tests the host command queue: ordering of dependent tasks (read-after-write, write-after-read, write-after-write), events and failing tasks.
+*   \test  Tests the host command queue: ordering of dependent tasks (read-after-write, write-after-read, write-after-write), events and failing tasks.
+**/
+
+//
+// *** System
+//
+#include <iostream>
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <cmath>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/host_queue.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/vector_proxy.hpp"
+#include "viennacl/linalg/inner_prod.hpp"
+
+
+typedef double     NumericT;
+
+/** @brief Records the order in which tasks start and end. Entries are positions in a global sequence of events. */
+struct task_log
+{
+  task_log(std::size_t num_tasks) : start(num_tasks, -1), end(num_tasks, -1), counter(0) {}
+
+  long next()
+  {
+    long ret;
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp critical (host_queue_test_log)
+#endif
+    ret = counter++;
+    return ret;
+  }
+
+  std::vector<long> start;
+  std::vector<long> end;
+  long counter;
+};
+
+/** @brief A task logging its start and end, with some busy work in between so that concurrently running tasks overlap */
+struct logged_task
+{
+  logged_task(task_log & log, std::size_t id, bool fail = false) : log_(&log), id_(id), fail_(fail) {}
+
+  void operator()() const
+  {
+    log_->start[id_] = log_->next();
+
+    volatile NumericT sum = 0;
+    for (long i=0; i<200000; ++i)
+      sum = sum + std::sqrt(NumericT(i));
+
+    log_->end[id_] = log_->next();
+    if (fail_)
+      throw std::runtime_error("task failed on purpose");
+  }
+
+  task_log * log_;
+  std::size_t id_;
+  bool fail_;
+};
+
+/** @brief A task computing y = alpha * x + beta * y with ViennaCL operations */
+template<typename VectorT1, typename VectorT2>
+struct axpby_task
+{
+  axpby_task(NumericT alpha, VectorT1 const & x, NumericT beta, VectorT2 & y) : alpha_(alpha), x_(&x), beta_(beta), y_(&y) {}
+
+  void operator()() const { *y_ = alpha_ * *x_ + beta_ * *y_; }
+
+  NumericT alpha_;
+  VectorT1 const * x_;
+  NumericT beta_;
+  VectorT2 * y_;
+};
+
+template<typename VectorT1, typename VectorT2>
+axpby_task<VectorT1, VectorT2> make_axpby(NumericT alpha, VectorT1 const & x, NumericT beta, VectorT2 & y)
+{
+  return axpby_task<VectorT1, VectorT2>(alpha, x, beta, y);
+}
+
+/** @brief Checks that task 'second' started only after task 'first' ended */
+bool ordered(task_log const & log, std::size_t first, std::size_t second, std::string const & name)
+{
+  if (log.end[first] < 0 || log.start[second] < 0 || log.start[second] < log.end[first])
+  {
+    std::cout << "# Error: " << name << ": task " << second << " (start " << log.start[second] << ") did not wait for task " << first << " (end " << log.end[first] << ")" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//
+// -------------------------------------------------------------
+//
+int test_dependencies()
+{
+  viennacl::vector<NumericT> x(100), y(100), z(100);
+  viennacl::range r(10, 60);
+  viennacl::slice s(1, 3, 30);
+  viennacl::vector_range<viennacl::vector<NumericT> > x_range(x, r);
+  viennacl::vector_slice<viennacl::vector<NumericT> > x_slice(x, s);
+
+  task_log log(9);
+  viennacl::host_queue queue;
+
+  // RAW: task 1 reads a range of the buffer written by task 0
+  queue.enqueue(logged_task(log, 0), viennacl::host_operands().writes(x));
+  queue.enqueue(logged_task(log, 1), viennacl::host_operands().reads(x_range).writes(y));
+
+  // WAR: task 3 writes a slice of the buffer read by task 2 (and by task 1)
+  queue.enqueue(logged_task(log, 2), viennacl::host_operands().reads(x).writes(z));
+  queue.enqueue(logged_task(log, 3), viennacl::host_operands().writes(x_slice));
+
+  // WAW: task 4 writes a range of the buffer written by task 3
+  queue.enqueue(logged_task(log, 4), viennacl::host_operands().writes(x_range));
+
+  // independent of all tasks above: runs in the first wave, i.e. before the dependent tasks 1 to 4
+  viennacl::vector<NumericT> w(10);
+  queue.enqueue(logged_task(log, 5), viennacl::host_operands().writes(w));
+
+  // reads of the same buffer do not depend on each other, but wait for the last writer:
+  queue.enqueue(logged_task(log, 6), viennacl::host_operands().reads(w));
+  queue.enqueue(logged_task(log, 7), viennacl::host_operands().reads(w).reads(y));
+
+  // a task without operands does not depend on anything:
+  queue.enqueue(logged_task(log, 8));
+
+  if (queue.pending() != 9 || log.counter != 0)
+  {
+    std::cout << "# Error: Tasks executed before finish()" << std::endl;
+    return EXIT_FAILURE;
+  }
+  queue.finish();
+  if (queue.pending() != 0)
+  {
+    std::cout << "# Error: Pending tasks after finish()" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  bool ok = ordered(log, 0, 1, "read-after-write")
+         && ordered(log, 2, 3, "write-after-read")
+         && ordered(log, 1, 3, "write-after-read")
+         && ordered(log, 3, 4, "write-after-write")
+         && ordered(log, 5, 6, "read-after-write")
+         && ordered(log, 5, 7, "read-after-write")
+         && ordered(log, 1, 7, "read-after-write")
+         && ordered(log, 0, 2, "read-after-write");
+  if (!ok)
+    return EXIT_FAILURE;
+
+  // waves: {0, 5, 8}, {1, 2, 6}, {3, 7}, {4}
+  if (log.start[5] > log.start[1] || log.start[8] > log.start[1] || log.start[6] > log.start[3])
+  {
+    std::cout << "# Error: Independent tasks are not executed in the first possible wave" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int test_results()
+{
+  std::size_t n = 1000;
+  viennacl::vector<NumericT> x = viennacl::scalar_vector<NumericT>(n, NumericT(1));
+  viennacl::vector<NumericT> y = viennacl::scalar_vector<NumericT>(n, NumericT(0));
+  viennacl::vector<NumericT> z = viennacl::scalar_vector<NumericT>(n, NumericT(0));
+  viennacl::vector<NumericT> u = viennacl::scalar_vector<NumericT>(n, NumericT(3));
+  viennacl::range r(0, n / 2);
+  viennacl::vector_range<viennacl::vector<NumericT> > x_range(x, r);
+  viennacl::vector_range<viennacl::vector<NumericT> > u_range(u, r);
+
+  viennacl::host_queue queue;
+  queue.enqueue(make_axpby(NumericT(2), x, NumericT(0), y), viennacl::host_operands().reads(x).writes(y));            // y = 2 x = 2
+  queue.enqueue(make_axpby(NumericT(1), u_range, NumericT(4), x_range), viennacl::host_operands().reads(u).writes(x)); // x = 3 + 4 x = 7 on the first half
+  queue.enqueue(make_axpby(NumericT(1), x, NumericT(1), y), viennacl::host_operands().reads(x).writes(y));            // y = x + y = 9 / 3
+  queue.enqueue(make_axpby(NumericT(1), y, NumericT(0), z), viennacl::host_operands().reads(y).writes(z));            // z = y
+  queue.enqueue(make_axpby(NumericT(-1), u, NumericT(1), u), viennacl::host_operands().writes(u));                    // u = 0, after the read of u above
+  queue.finish();
+
+  std::vector<NumericT> host_y(n), host_z(n), host_u(n);
+  viennacl::copy(y, host_y);
+  viennacl::copy(z, host_z);
+  viennacl::copy(u, host_u);
+  for (std::size_t i=0; i<n; ++i)
+  {
+    NumericT ref_y = (i < n / 2) ? 9 : 3;
+    if (std::fabs(host_y[i] - ref_y) > 0 || std::fabs(host_z[i] - ref_y) > 0 || std::fabs(host_u[i]) > 0)
+    {
+      std::cout << "# Error: Results of dependent tasks at entry " << i << ": y = " << host_y[i] << ", z = " << host_z[i] << ", u = " << host_u[i] << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int test_events()
+{
+  task_log log(6);
+  viennacl::host_queue queue;
+  viennacl::vector<NumericT> x(10), y(10);
+
+  viennacl::host_event e0 = queue.enqueue(logged_task(log, 0), viennacl::host_operands().writes(x));
+  viennacl::host_event e1 = queue.enqueue(logged_task(log, 1), viennacl::host_operands().writes(y));
+
+  // no common operands, but explicitly waits for task 0:
+  std::vector<viennacl::host_event> wait_list(1, e0);
+  viennacl::host_event e2 = queue.enqueue(logged_task(log, 2), viennacl::host_operands(), wait_list);
+
+  if (e0.completed() || e1.completed() || e2.completed())
+  {
+    std::cout << "# Error: Event completed before execution" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  e2.wait();
+  if (!e0.completed() || !e1.completed() || !e2.completed() || queue.pending() != 0)
+  {
+    std::cout << "# Error: Events not completed after wait()" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (!ordered(log, 0, 2, "wait list"))
+    return EXIT_FAILURE;
+
+  // waiting for a completed event or a default-constructed event returns right away:
+  e2.wait();
+  viennacl::host_event empty_event;
+  if (!empty_event.completed())
+  {
+    std::cout << "# Error: Default-constructed event not completed" << std::endl;
+    return EXIT_FAILURE;
+  }
+  empty_event.wait();
+
+  // an event of another queue is resolved when the waiting task is enqueued:
+  viennacl::host_queue other_queue;
+  viennacl::host_event e3 = other_queue.enqueue(logged_task(log, 3));
+  queue.enqueue(logged_task(log, 4), viennacl::host_operands(), std::vector<viennacl::host_event>(1, e3));
+  if (!e3.completed() || other_queue.pending() != 0 || queue.pending() != 1)
+  {
+    std::cout << "# Error: Event of another queue not resolved" << std::endl;
+    return EXIT_FAILURE;
+  }
+  queue.finish();
+  if (!ordered(log, 3, 4, "wait list of another queue"))
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int test_failure()
+{
+  task_log log(10);
+  viennacl::host_queue queue;
+  viennacl::vector<NumericT> x(10), y(10), z(10), w(10), v(10);
+
+  viennacl::host_event e0 = queue.enqueue(logged_task(log, 0, true), viennacl::host_operands().writes(x));                // fails
+  viennacl::host_event e1 = queue.enqueue(logged_task(log, 1),       viennacl::host_operands().writes(y));                // independent
+  viennacl::host_event e2 = queue.enqueue(logged_task(log, 2),       viennacl::host_operands().reads(x).writes(z));       // reads the result of the failing task
+  viennacl::host_event e3 = queue.enqueue(logged_task(log, 3),       viennacl::host_operands().reads(y).writes(w));       // independent, second wave
+  viennacl::host_event e4 = queue.enqueue(logged_task(log, 4),       viennacl::host_operands().reads(z));                 // transitively depends on the failing task
+  viennacl::host_event e5 = queue.enqueue(logged_task(log, 5),       viennacl::host_operands().reads(w).writes(v));       // independent, third wave
+  std::vector<viennacl::host_event> wait_list(1, e2);
+  viennacl::host_event e6 = queue.enqueue(logged_task(log, 6),       viennacl::host_operands(), wait_list);               // waits for a skipped task
+
+  bool thrown = false;
+  try
+  {
+    queue.finish();
+  }
+  catch (std::runtime_error const &)
+  {
+    thrown = true;
+  }
+
+  if (!thrown)
+  {
+    std::cout << "# Error: Failing task did not raise an exception" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (log.end[1] < 0 || log.end[3] < 0 || log.end[5] < 0 || !e1.completed() || !e3.completed() || !e5.completed() || e1.failed() || e3.failed() || e5.failed())
+  {
+    std::cout << "# Error: Task independent of the failing task not executed" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (log.start[2] >= 0 || log.start[4] >= 0 || log.start[6] >= 0 || queue.pending() != 0)
+  {
+    std::cout << "# Error: Task depending on the failing task executed" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (e0.completed() || e2.completed() || e4.completed() || e6.completed() || !e0.failed() || !e2.failed() || !e4.failed() || !e6.failed())
+  {
+    std::cout << "# Error: Failed or skipped task reported as completed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the queue remains usable, but tasks waiting for a failed task are skipped:
+  queue.enqueue(logged_task(log, 7), viennacl::host_operands().reads(x));
+  viennacl::host_event e8 = queue.enqueue(logged_task(log, 8), viennacl::host_operands().writes(y), std::vector<viennacl::host_event>(1, e0));
+  viennacl::host_event e9 = queue.enqueue(logged_task(log, 9), viennacl::host_operands().reads(y));
+  queue.finish();
+  if (log.end[7] < 0)
+  {
+    std::cout << "# Error: Queue not usable after a failure" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (log.start[8] >= 0 || log.start[9] >= 0 || !e8.failed() || !e9.failed())
+  {
+    std::cout << "# Error: Task waiting for a failed task of an earlier finish() executed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Host Queue" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  std::cout << "# Testing dependencies" << std::endl;
+  if (test_dependencies() != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << "# Testing results of dependent tasks" << std::endl;
+  if (test_results() != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << "# Testing events" << std::endl;
+  if (test_events() != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << "# Testing failing tasks" << std::endl;
+  if (test_failure() != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
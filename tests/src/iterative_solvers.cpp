@@ -0,0 +1,582 @@
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+
+/** \file tests/src/iterative_solvers.cpp  Tests the variants of the iterative solvers on the host: Orthogonalization schemes of GMRES, flexible GMRES, the solver objects, the Chebyshev iteration and Krylov subspace recycling for sequences of systems.
+*   \test  Tests the variants of the iterative solvers on the host: Orthogonalization schemes of GMRES, flexible GMRES, the solver objects, the Chebyshev iteration and Krylov subspace recycling for sequences of systems.
+**/
+
+//
+// *** System
+//
+#include <iostream>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <string>
+
+#ifndef NDEBUG
+ #define BOOST_UBLAS_NDEBUG
+#endif
+
+//
+// *** Boost
+//
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <boost/numeric/ublas/operation_sparse.hpp>
+
+//
+// *** ViennaCL
+//
+#define VIENNACL_WITH_UBLAS 1
+
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/bicgstab.hpp"
+#include "viennacl/linalg/gmres.hpp"
+#include "viennacl/linalg/ilu.hpp"
+#include "viennacl/linalg/jacobi_precond.hpp"
+#include "viennacl/linalg/deflated_cg.hpp"
+#include "viennacl/linalg/gcrodr.hpp"
+#include "viennacl/linalg/chebyshev.hpp"
+
+
+typedef double     NumericT;
+
+
+/** @brief Assembles the 5-point finite difference discretization of -div(grad u) + convection * du/dx + c(x) u on an n-by-n grid, where c varies between 0 and 'reaction' */
+void assemble_grid(unsigned int n, NumericT convection, viennacl::compressed_matrix<NumericT> & A, NumericT reaction = 0)
+{
+  std::vector< std::map<unsigned int, NumericT> > host_A(n * n);
+  for (unsigned int i=0; i<n; ++i)
+    for (unsigned int j=0; j<n; ++j)
+    {
+      unsigned int row = i * n + j;
+      host_A[row][row] = 4 + reaction * NumericT(row % 13) / NumericT(13);
+      if (i > 0)     host_A[row][row - n] = -1;
+      if (i < n - 1) host_A[row][row + n] = -1;
+      if (j > 0)     host_A[row][row - 1] = -1 - convection;
+      if (j < n - 1) host_A[row][row + 1] = -1 + convection;
+    }
+  viennacl::copy(host_A, A);
+}
+
+/** @brief Returns the relative residual norm ||b - A x|| / ||b|| */
+NumericT relative_residual(viennacl::compressed_matrix<NumericT> const & A, viennacl::vector<NumericT> const & x, viennacl::vector<NumericT> const & b)
+{
+  viennacl::vector<NumericT> r = b;
+  r -= viennacl::linalg::prod(A, x);
+  return viennacl::linalg::norm_2(r) / viennacl::linalg::norm_2(b);
+}
+
+/** @brief Solves A x = b with the given solver and preconditioner and checks the true residual and the number of iterations */
+template<typename SolverTagT, typename PrecondT>
+int check_solve(std::string const & name, viennacl::compressed_matrix<NumericT> const & A, viennacl::vector<NumericT> const & b,
+                SolverTagT const & solver, PrecondT const & precond, std::size_t max_iters)
+{
+  viennacl::vector<NumericT> x = viennacl::linalg::solve(A, b, solver, precond);
+  NumericT residual = relative_residual(A, x, b);
+
+  std::cout << "  " << name << ": " << solver.iters() << " iterations, relative residual " << residual << std::endl;
+  if (residual > NumericT(1e-6) || solver.iters() > max_iters)
+  {
+    std::cout << "# Error at operation: " << name << std::endl;
+    std::cout << "  Maximum number of iterations: " << max_iters << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+/** @brief A preconditioner which changes from one application to the next: ILU0 and Jacobi are applied alternately */
+class alternating_precond
+{
+public:
+  alternating_precond(viennacl::compressed_matrix<NumericT> const & A)
+    : ilu0_(A, ilu0_tag_), jacobi_(A, viennacl::linalg::jacobi_tag()), num_applications_(0) {}
+
+  void apply(viennacl::vector<NumericT> & x) const
+  {
+    if (num_applications_++ % 2)
+      jacobi_.apply(x);
+    else
+      ilu0_.apply(x);
+  }
+
+  std::size_t num_applications() const { return num_applications_; }
+
+private:
+  viennacl::linalg::ilu0_tag ilu0_tag_; // ilu0_precond keeps a reference to its tag
+  viennacl::linalg::ilu0_precond< viennacl::compressed_matrix<NumericT> >   ilu0_;
+  viennacl::linalg::jacobi_precond< viennacl::compressed_matrix<NumericT> > jacobi_;
+  mutable std::size_t num_applications_;
+};
+
+//
+// -------------------------------------------------------------
+//
+int test_gmres_variants(unsigned int n)
+{
+  viennacl::compressed_matrix<NumericT> A;
+  assemble_grid(n, NumericT(0.3), A);
+  viennacl::vector<NumericT> b = viennacl::scalar_vector<NumericT>(A.size1(), NumericT(1));
+
+  viennacl::linalg::no_precond no_precond;
+  viennacl::linalg::ilu0_tag ilu0_config;
+  viennacl::linalg::ilu0_precond< viennacl::compressed_matrix<NumericT> > ilu0(A, ilu0_config);
+
+  // reference: modified Gram-Schmidt
+  viennacl::linalg::gmres_tag tag(1e-8, 1000, 30);
+  tag.orthogonalization(viennacl::linalg::gmres_tag::modified_gram_schmidt);
+  if (check_solve("GMRES, MGS", A, b, tag, no_precond, 1000) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  std::size_t mgs_iters = tag.iters();
+  if (check_solve("GMRES, MGS + ILU0", A, b, tag, ilu0, mgs_iters / 2) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  std::size_t mgs_ilu0_iters = tag.iters();
+
+  // the classical Gram-Schmidt variants need about the same number of iterations for this well-conditioned system:
+  viennacl::linalg::gmres_tag::orthogonalization_type cgs_variants[2] = { viennacl::linalg::gmres_tag::classical_gram_schmidt_2,
+                                                                         viennacl::linalg::gmres_tag::one_sync_gram_schmidt };
+  std::string cgs_names[2] = { "CGS2", "one-sync CGS" };
+  for (std::size_t i=0; i<2; ++i)
+  {
+    tag.orthogonalization(cgs_variants[i]);
+    for (int flexible = 0; flexible <= 1; ++flexible)
+    {
+      tag.flexible(flexible != 0);
+      std::string name = std::string(flexible ? "FGMRES, " : "GMRES, ") + cgs_names[i];
+      if (check_solve(name, A, b, tag, no_precond, mgs_iters + 2) != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+      if (check_solve(name + " + ILU0", A, b, tag, ilu0, mgs_ilu0_iters + 2) != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+    }
+    tag.flexible(false);
+  }
+
+  // restarts: a small Krylov space needs more iterations, but converges to the same accuracy:
+  viennacl::linalg::gmres_tag restarted_tag(1e-8, 3000, 5);
+  restarted_tag.orthogonalization(viennacl::linalg::gmres_tag::one_sync_gram_schmidt);
+  if (check_solve("GMRES(5), one-sync CGS + ILU0", A, b, restarted_tag, ilu0, 3000) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // a preconditioner changing from one iteration to the next requires flexible GMRES:
+  viennacl::linalg::gmres_tag fgmres_tag(1e-8, 1000, 30);
+  fgmres_tag.orthogonalization(viennacl::linalg::gmres_tag::classical_gram_schmidt_2);
+  fgmres_tag.flexible(true);
+  alternating_precond alternating(A);
+  if (check_solve("FGMRES, CGS2 + alternating ILU0/Jacobi", A, b, fgmres_tag, alternating, mgs_iters) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // without restarts, FGMRES applies the preconditioner exactly once per iteration:
+  if (alternating.num_applications() != fgmres_tag.iters())
+  {
+    std::cout << "# Error: FGMRES applied the preconditioner " << alternating.num_applications() << " times in " << fgmres_tag.iters() << " iterations" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/** @brief Records the calls of a solver monitor: Number of calls, the last estimate, and the largest deviation of the estimate from the true residual of the approximation passed */
+template<typename MatrixT, typename VectorT>
+struct monitor_log
+{
+  monitor_log(MatrixT const & A_, VectorT const & b_, NumericT stop_below_) : A(&A_), b(&b_), stop_below(stop_below_), calls(0), last_estimate(0), max_deviation(0) {}
+
+  MatrixT const * A;
+  VectorT const * b;
+  NumericT stop_below;
+  std::size_t calls;
+  NumericT last_estimate;
+  NumericT max_deviation;
+};
+
+/** @brief Returns ||b - A x|| / ||b|| for uBLAS types */
+NumericT relative_residual(boost::numeric::ublas::compressed_matrix<NumericT> const & A, boost::numeric::ublas::vector<NumericT> const & x, boost::numeric::ublas::vector<NumericT> const & b)
+{
+  boost::numeric::ublas::vector<NumericT> r = b - boost::numeric::ublas::prod(A, x);
+  return boost::numeric::ublas::norm_2(r) / boost::numeric::ublas::norm_2(b);
+}
+
+/** @brief Monitor callback: Logs the call and compares the estimate with the true residual. Stops the solver once the estimate drops below 'stop_below'. */
+template<typename MatrixT, typename VectorT>
+bool log_monitor(VectorT const & x, NumericT estimate, void * user_data)
+{
+  monitor_log<MatrixT, VectorT> * log = static_cast<monitor_log<MatrixT, VectorT> *>(user_data);
+  ++log->calls;
+  log->last_estimate = estimate;
+  log->max_deviation = std::max(log->max_deviation, std::fabs(relative_residual(*log->A, x, *log->b) - estimate));
+  return estimate < log->stop_below;
+}
+
+/** @brief Checks a solver object: Reuse of the result buffer and of the workspace, warm starts and the monitor */
+template<typename SolverT, typename MatrixT, typename VectorT>
+int check_solver_object(std::string const & name, SolverT & solver, MatrixT const & A, VectorT const & b1, VectorT const & b2,
+                        bool estimate_is_true_residual)
+{
+  // repeated solves with the same system size reuse the result buffer:
+  VectorT const & x1 = solver(A, b1);
+  VectorT x1_copy = x1;
+  std::size_t cold_iters = solver.tag().iters();
+  VectorT const & x2 = solver(A, b2);
+  NumericT residual_1 = relative_residual(A, x1_copy, b1);
+  NumericT residual_2 = relative_residual(A, x2, b2);
+  std::cout << "  " << name << ": " << cold_iters << " iterations, relative residuals of two solves with reused buffers " << residual_1 << ", " << residual_2 << std::endl;
+  if (&x1 != &x2 || residual_1 > NumericT(1e-6) || residual_2 > NumericT(1e-6))
+  {
+    std::cout << "# Error at operation: " << name << ", reuse of buffers" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // warm start with the solution: (almost) no iterations
+  solver.set_initial_guess(x1_copy);
+  solver(A, b1);
+  std::size_t warm_iters = solver.tag().iters();
+  VectorT x = x1_copy;
+  solver.solve(A, b1, x);
+  std::cout << "  " << name << ": warm start from the solution: " << warm_iters << " and " << solver.tag().iters() << " iterations" << std::endl;
+  if (warm_iters > 1 || solver.tag().iters() > 1 || relative_residual(A, x, b1) > NumericT(1e-6))
+  {
+    std::cout << "# Error at operation: " << name << ", warm start" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // warm start from the solution of a nearby system needs fewer iterations than a cold start:
+  VectorT b_nearby = b1 + NumericT(1e-3) * b2;
+  x = x1_copy;
+  solver.solve(A, b_nearby, x);
+  std::cout << "  " << name << ": warm start for a nearby system: " << solver.tag().iters() << " iterations" << std::endl;
+  if (solver.tag().iters() >= cold_iters || relative_residual(A, x, b_nearby) > NumericT(1e-6))
+  {
+    std::cout << "# Error at operation: " << name << ", warm start for a nearby system" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the monitor is called in every iteration except for the converged one and receives the current approximation:
+  monitor_log<MatrixT, VectorT> log(A, b1, 0);
+  solver.set_monitor(log_monitor<MatrixT, VectorT>, &log);
+  x = x1_copy;
+  x *= NumericT(0);
+  solver.solve(A, b1, x);
+  std::cout << "  " << name << ": monitor calls: " << log.calls << " in " << solver.tag().iters() << " iterations, deviation of the estimates: " << log.max_deviation << std::endl;
+  if (log.calls + 1 != solver.tag().iters() || (estimate_is_true_residual && log.max_deviation > NumericT(1e-8)))
+  {
+    std::cout << "# Error at operation: " << name << ", monitor" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the monitor stops the solver:
+  log = monitor_log<MatrixT, VectorT>(A, b1, NumericT(1e-3));
+  x *= NumericT(0);
+  solver.solve(A, b1, x);
+  NumericT stopped_residual = relative_residual(A, x, b1);
+  std::cout << "  " << name << ": stopped by the monitor after " << solver.tag().iters() << " iterations, relative residual " << stopped_residual << std::endl;
+  if (log.calls != solver.tag().iters() || solver.tag().iters() >= cold_iters || log.last_estimate >= NumericT(1e-3)
+      || (estimate_is_true_residual && stopped_residual >= NumericT(1e-3)))
+  {
+    std::cout << "# Error at operation: " << name << ", stop by the monitor" << std::endl;
+    return EXIT_FAILURE;
+  }
+  solver.set_monitor(NULL, NULL);
+
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int test_solver_objects(unsigned int n)
+{
+  typedef viennacl::compressed_matrix<NumericT>               MatrixType;
+  typedef viennacl::vector<NumericT>                          VectorType;
+  typedef boost::numeric::ublas::compressed_matrix<NumericT>  UblasMatrixType;
+  typedef boost::numeric::ublas::vector<NumericT>             UblasVectorType;
+
+  MatrixType A_spd, A;
+  assemble_grid(n, 0, A_spd);
+  assemble_grid(n, NumericT(0.3), A);
+
+  std::vector<NumericT> host_b1(A.size1()), host_b2(A.size1());
+  for (std::size_t i=0; i<host_b1.size(); ++i)
+  {
+    host_b1[i] = NumericT(1);
+    host_b2[i] = NumericT(i % 7) - NumericT(3);
+  }
+  VectorType b1(A.size1()), b2(A.size1());
+  viennacl::copy(host_b1, b1);
+  viennacl::copy(host_b2, b2);
+
+  viennacl::linalg::cg_solver<VectorType> cg(viennacl::linalg::cg_tag(1e-8, 1000));
+  if (check_solver_object("CG", cg, A_spd, b1, b2, false) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  viennacl::linalg::bicgstab_solver<VectorType> bicgstab(viennacl::linalg::bicgstab_tag(1e-8, 1000));
+  if (check_solver_object("BiCGStab", bicgstab, A, b1, b2, false) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // Arnoldi-based GMRES: the estimate is the residual of the current approximation
+  viennacl::linalg::gmres_tag gmres_config(1e-8, 1000, 30);
+  gmres_config.orthogonalization(viennacl::linalg::gmres_tag::classical_gram_schmidt_2);
+  viennacl::linalg::gmres_solver<VectorType> gmres(gmres_config);
+  if (check_solver_object("GMRES, CGS2", gmres, A, b1, b2, true) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  gmres_config.flexible(true);
+  viennacl::linalg::gmres_solver<VectorType> fgmres(gmres_config);
+  if (check_solver_object("FGMRES, CGS2", fgmres, A, b1, b2, true) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // Householder-based GMRES for uBLAS types:
+  UblasMatrixType ublas_A(A.size1(), A.size2());
+  viennacl::copy(A, ublas_A);
+  UblasVectorType ublas_b1(A.size1()), ublas_b2(A.size1());
+  std::copy(host_b1.begin(), host_b1.end(), ublas_b1.begin());
+  std::copy(host_b2.begin(), host_b2.end(), ublas_b2.begin());
+  viennacl::linalg::gmres_solver<UblasVectorType> ublas_gmres(viennacl::linalg::gmres_tag(1e-8, 1000, 30));
+  if (check_solver_object("GMRES, Householder, uBLAS", ublas_gmres, ublas_A, ublas_b1, ublas_b2, true) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // a system of a different size resizes the buffers:
+  MatrixType A_small;
+  assemble_grid(n / 2, NumericT(0.3), A_small);
+  VectorType b_small = viennacl::scalar_vector<NumericT>(A_small.size1(), NumericT(1));
+  viennacl::linalg::gmres_solver<VectorType> gmres_resized(gmres_config);
+  gmres_resized(A, b2);
+  VectorType x_small = gmres_resized(A_small, b_small);
+  VectorType x_large = gmres_resized(A, b1);
+  std::cout << "  GMRES, CGS2: different system sizes: relative residuals " << relative_residual(A_small, x_small, b_small) << ", " << relative_residual(A, x_large, b1) << std::endl;
+  if (relative_residual(A_small, x_small, b_small) > NumericT(1e-6) || relative_residual(A, x_large, b1) > NumericT(1e-6))
+  {
+    std::cout << "# Error at operation: GMRES, different system sizes" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int test_chebyshev(unsigned int n)
+{
+  typedef viennacl::compressed_matrix<NumericT>   MatrixType;
+  typedef viennacl::vector<NumericT>              VectorType;
+
+  MatrixType A;
+  assemble_grid(n, 0, A);
+  VectorType b = viennacl::scalar_vector<NumericT>(A.size1(), NumericT(1));
+
+  // the return values of a tag are defined before the first solver run:
+  viennacl::linalg::chebyshev_tag estimated(1e-8, 2000, 10);
+  if (estimated.iters() != 0 || estimated.error() > 0 || estimated.spectrum_lower() > 0 || estimated.spectrum_upper() > 0)
+  {
+    std::cout << "# Error: Chebyshev tag is not initialized" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // exact bounds of the spectrum of the 5-point stencil: The residual is reduced by 1/T_k(sigma) <= 2 q^k with q = (sqrt(kappa) - 1) / (sqrt(kappa) + 1)
+  NumericT pi = std::acos(NumericT(-1));
+  NumericT lambda_min = 8 * std::pow(std::sin(pi / NumericT(2 * (n + 1))), 2);
+  NumericT lambda_max = 8 * std::pow(std::cos(pi / NumericT(2 * (n + 1))), 2);
+  NumericT q = (std::sqrt(lambda_max / lambda_min) - 1) / (std::sqrt(lambda_max / lambda_min) + 1);
+  std::size_t bound = static_cast<std::size_t>(std::ceil(std::log(NumericT(1e-8) / 2) / std::log(q))) + 10;
+
+  viennacl::linalg::chebyshev_tag exact(1e-8, 2000, 10);
+  exact.set_spectrum_bounds(lambda_min, lambda_max);
+  if (check_solve("Chebyshev, exact bounds", A, b, exact, viennacl::linalg::no_precond(), bound) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // estimated bounds: The upper bound needs to enclose the spectrum, the lower bound may be larger than lambda_min
+  if (check_solve("Chebyshev, estimated bounds", A, b, estimated, viennacl::linalg::no_precond(), 3 * bound) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  std::cout << "  Chebyshev: estimated bounds [" << estimated.spectrum_lower() << ", " << estimated.spectrum_upper() << "], exact [" << lambda_min << ", " << lambda_max << "]" << std::endl;
+  if (estimated.spectrum_upper() < lambda_max || estimated.spectrum_upper() > NumericT(1.1) * lambda_max || estimated.spectrum_lower() <= 0)
+  {
+    std::cout << "# Error: Chebyshev: invalid estimate of the spectrum" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Jacobi preconditioner for a varying diagonal:
+  MatrixType A_reaction;
+  assemble_grid(n, 0, A_reaction, NumericT(40));
+  viennacl::linalg::jacobi_precond<MatrixType> jacobi(A_reaction, viennacl::linalg::jacobi_tag());
+  viennacl::linalg::chebyshev_tag no_precond_tag(1e-8, 2000, 10), jacobi_tag(1e-8, 2000, 10);
+  if (check_solve("Chebyshev, varying diagonal", A_reaction, b, no_precond_tag, viennacl::linalg::no_precond(), 2000) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (check_solve("Chebyshev, varying diagonal, Jacobi", A_reaction, b, jacobi_tag, jacobi, no_precond_tag.iters()) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // without checks of the residual, exactly max_iterations iterations are run:
+  viennacl::linalg::chebyshev_tag unchecked(1e-8, 25, 0);
+  viennacl::linalg::solve(A, b, unchecked);
+  if (unchecked.iters() != 25)
+  {
+    std::cout << "# Error: Chebyshev without residual checks: " << unchecked.iters() << " iterations instead of 25" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the estimate fails for a negative definite matrix:
+  std::vector< std::map<unsigned int, NumericT> > host_negative(A.size1());
+  for (unsigned int i=0; i<host_negative.size(); ++i)
+    host_negative[i][i] = -NumericT(1 + i % 3);
+  MatrixType A_negative;
+  viennacl::copy(host_negative, A_negative);
+  bool thrown = false;
+  try
+  {
+    viennacl::linalg::solve(A_negative, b, viennacl::linalg::chebyshev_tag());
+  }
+  catch (viennacl::linalg::chebyshev_spectrum_exception const &)
+  {
+    thrown = true;
+  }
+  if (!thrown)
+  {
+    std::cout << "# Error: Chebyshev: no exception for a failed estimate of the spectrum" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/** @brief Solves a sequence of slowly varying systems with a recycling solver and with a fresh solver per system.
+*
+* All solutions need to converge, and the recycling solver needs fewer iterations than the fresh solver for every system after the first one.
+*/
+template<typename SolverT, typename TagT>
+int check_recycling(std::string const & name, TagT const & tag, unsigned int n, NumericT convection, bool use_ilu0)
+{
+  typedef viennacl::compressed_matrix<NumericT>   MatrixType;
+  typedef viennacl::vector<NumericT>              VectorType;
+
+  SolverT recycling_solver(tag);
+  std::size_t recycled_iters = 0, fresh_iters = 0;
+  for (unsigned int t=0; t<4; ++t)
+  {
+    MatrixType A;
+    assemble_grid(n, convection, A, NumericT(0.05) * NumericT(t));
+    std::vector<NumericT> host_b(A.size1());
+    for (std::size_t i=0; i<host_b.size(); ++i)
+      host_b[i] = NumericT(1) + NumericT(0.1) * std::sin(NumericT(i + t));
+    VectorType b(A.size1());
+    viennacl::copy(host_b, b);
+
+    viennacl::linalg::ilu0_tag ilu0_config;
+    viennacl::linalg::ilu0_precond<MatrixType> ilu0(A, ilu0_config);
+    SolverT fresh_solver(tag);
+    VectorType x_recycled, x_fresh;
+    if (use_ilu0)
+    {
+      x_recycled = recycling_solver(A, b, ilu0);
+      x_fresh    = fresh_solver(A, b, ilu0);
+    }
+    else
+    {
+      x_recycled = recycling_solver(A, b);
+      x_fresh    = fresh_solver(A, b);
+    }
+
+    NumericT residual = std::max(relative_residual(A, x_recycled, b), relative_residual(A, x_fresh, b));
+    std::cout << "  " << name << ", system " << t << ": " << recycling_solver.tag().iters() << " iterations with recycling, "
+              << fresh_solver.tag().iters() << " without, relative residual " << residual << std::endl;
+    if (residual > NumericT(1e-6))
+    {
+      std::cout << "# Error at operation: " << name << ", system " << t << " did not converge" << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (t > 0)
+    {
+      if (recycling_solver.tag().iters() >= fresh_solver.tag().iters())
+      {
+        std::cout << "# Error at operation: " << name << ", no reduction of the number of iterations for system " << t << std::endl;
+        return EXIT_FAILURE;
+      }
+      recycled_iters += recycling_solver.tag().iters();
+      fresh_iters    += fresh_solver.tag().iters();
+    }
+  }
+
+  // the recycle space needs to pay off clearly, not just by an iteration or two:
+  if (10 * recycled_iters > 9 * fresh_iters)
+  {
+    std::cout << "# Error at operation: " << name << ", total number of iterations " << recycled_iters << " with recycling vs. " << fresh_iters << " without" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int test_recycling(unsigned int n)
+{
+  typedef viennacl::vector<NumericT>   VectorType;
+
+  if (check_recycling< viennacl::linalg::deflated_cg_solver<VectorType> >("Deflated CG", viennacl::linalg::deflated_cg_tag(1e-8, 1000, 10, 30), n, 0, false) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (check_recycling< viennacl::linalg::deflated_cg_solver<VectorType> >("Deflated CG, ILU0", viennacl::linalg::deflated_cg_tag(1e-8, 1000, 10, 30), n, 0, true) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (check_recycling< viennacl::linalg::gcrodr_solver<VectorType> >("GCRO-DR", viennacl::linalg::gcrodr_tag(1e-8, 1000, 30, 10), n, NumericT(0.1), false) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (check_recycling< viennacl::linalg::gcrodr_solver<VectorType> >("GCRO-DR, ILU0", viennacl::linalg::gcrodr_tag(1e-8, 1000, 20, 8), n, NumericT(0.3), true) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Iterative Solvers" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  std::cout << "# Testing setup: 2D grid, 32x32 unknowns" << std::endl;
+
+  std::cout << "## GMRES: orthogonalization schemes and flexible GMRES" << std::endl;
+  if (test_gmres_variants(32) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << "## Solver objects: reuse of buffers, warm starts and monitors" << std::endl;
+  if (test_solver_objects(32) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << "## Chebyshev iteration" << std::endl;
+  if (test_chebyshev(32) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << "## Krylov subspace recycling: sequences of systems" << std::endl;
+  if (test_recycling(32) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -23,6 +23,7 @@
 // include necessary system headers
 #include <iostream>
 #include <vector>
+#include <algorithm>
 
 // Some helper functions for this tutorial:
 #include "viennacl.hpp"
@@ -96,6 +97,110 @@ T get_value(std::vector<T> & array, ViennaCLInt i, ViennaCLInt j,
 }
 
 
+/** @brief Position of a strided submatrix within an array holding a full matrix */
+struct matrix_layout
+{
+  matrix_layout(ViennaCLInt start1_, ViennaCLInt start2_, ViennaCLInt stride1_, ViennaCLInt stride2_, ViennaCLInt rows_, ViennaCLInt columns_, ViennaCLOrder order_)
+    : start1(start1_), start2(start2_), stride1(stride1_), stride2(stride2_), rows(rows_), columns(columns_), order(order_) {}
+
+  std::size_t index(ViennaCLInt i, ViennaCLInt j) const
+  {
+    if (order == ViennaCLRowMajor)
+      return static_cast<std::size_t>((i*stride1 + start1) * columns + (j*stride2 + start2));
+    return static_cast<std::size_t>((i*stride1 + start1) + (j*stride2 + start2) * rows);
+  }
+
+  /** @brief Leading dimension of the array */
+  ViennaCLInt ld() const { return (order == ViennaCLRowMajor) ? columns : rows; }
+
+  ViennaCLInt start1, start2, stride1, stride2, rows, columns;
+  ViennaCLOrder order;
+};
+
+/** @brief Reference for C <- alpha * (op(A) op(B)^T + op(B) op(A)^T) + beta * C on the triangle of C given by uplo */
+template<typename T>
+void reference_syr2k(ViennaCLUplo uplo, ViennaCLTranspose trans, ViennaCLInt n, ViennaCLInt k, T alpha,
+                     std::vector<T> const & A, matrix_layout const & lA,
+                     std::vector<T> const & B, matrix_layout const & lB,
+                     T beta, std::vector<T> & C, matrix_layout const & lC)
+{
+  for (ViennaCLInt i=0; i<n; ++i)
+    for (ViennaCLInt j=0; j<n; ++j)
+    {
+      if ((uplo == ViennaCLLower) ? (j > i) : (j < i))
+        continue;
+
+      T val = 0;
+      for (ViennaCLInt l=0; l<k; ++l)
+      {
+        if (trans == ViennaCLTrans)
+          val += A[lA.index(l, i)] * B[lB.index(l, j)] + B[lB.index(l, i)] * A[lA.index(l, j)];
+        else
+          val += A[lA.index(i, l)] * B[lB.index(j, l)] + B[lB.index(i, l)] * A[lA.index(j, l)];
+      }
+      C[lC.index(i, j)] = alpha * val + beta * C[lC.index(i, j)];
+    }
+}
+
+/** @brief Reference for C <- alpha * A B + beta * C (left) or C <- alpha * B A + beta * C (right), where A is symmetric and given by the triangle uplo */
+template<typename T>
+void reference_symm(ViennaCLSide side, ViennaCLUplo uplo, ViennaCLInt m, ViennaCLInt n, T alpha,
+                    std::vector<T> const & A, matrix_layout const & lA,
+                    std::vector<T> const & B, matrix_layout const & lB,
+                    T beta, std::vector<T> & C, matrix_layout const & lC)
+{
+  for (ViennaCLInt i=0; i<m; ++i)
+    for (ViennaCLInt j=0; j<n; ++j)
+    {
+      T val = 0;
+      for (ViennaCLInt l=0; l < ((side == ViennaCLLeft) ? m : n); ++l)
+      {
+        ViennaCLInt a_row = (side == ViennaCLLeft) ? i : l;
+        ViennaCLInt a_col = (side == ViennaCLLeft) ? l : j;
+        bool in_triangle = (uplo == ViennaCLLower) ? (a_col <= a_row) : (a_row <= a_col);
+        T a = in_triangle ? A[lA.index(a_row, a_col)] : A[lA.index(a_col, a_row)];
+        val += (side == ViennaCLLeft) ? a * B[lB.index(l, j)] : B[lB.index(i, l)] * a;
+      }
+      C[lC.index(i, j)] = alpha * val + beta * C[lC.index(i, j)];
+    }
+}
+
+/** @brief Reference for B <- alpha * op(A) B (left) or B <- alpha * B op(A) (right), where A is triangular and given by the triangle uplo */
+template<typename T>
+void reference_trmm(ViennaCLSide side, ViennaCLUplo uplo, ViennaCLTranspose trans, ViennaCLDiag diag, ViennaCLInt m, ViennaCLInt n, T alpha,
+                    std::vector<T> const & A, matrix_layout const & lA,
+                    std::vector<T> & B, matrix_layout const & lB)
+{
+  std::vector<T> result(static_cast<std::size_t>(m * n));
+  for (ViennaCLInt i=0; i<m; ++i)
+    for (ViennaCLInt j=0; j<n; ++j)
+    {
+      T val = 0;
+      for (ViennaCLInt l=0; l < ((side == ViennaCLLeft) ? m : n); ++l)
+      {
+        // entry (a_row, a_col) of op(A), i.e. entry (a_col, a_row) of A if transposed:
+        ViennaCLInt a_row = (side == ViennaCLLeft) ? i : l;
+        ViennaCLInt a_col = (side == ViennaCLLeft) ? l : j;
+        if (trans == ViennaCLTrans)
+          std::swap(a_row, a_col);
+
+        T a = 0;
+        if (a_row == a_col && diag == ViennaCLUnit)
+          a = 1;
+        else if ((uplo == ViennaCLLower) ? (a_col <= a_row) : (a_row <= a_col))
+          a = A[lA.index(a_row, a_col)];
+
+        val += (side == ViennaCLLeft) ? a * B[lB.index(l, j)] : B[lB.index(i, l)] * a;
+      }
+      result[static_cast<std::size_t>(i * n + j)] = alpha * val;
+    }
+
+  for (ViennaCLInt i=0; i<m; ++i)
+    for (ViennaCLInt j=0; j<n; ++j)
+      B[lB.index(i, j)] = result[static_cast<std::size_t>(i * n + j)];
+}
+
+
 void test_blas(ViennaCLBackend my_backend,
                float eps_float, double eps_double,
                std::vector<float> & C_float, std::vector<double> & C_double,
@@ -267,6 +372,139 @@ void test_blas(ViennaCLBackend my_backend,
   }
 #endif
 
+  // Compute reference for SYRK on the lower triangle of the leading square block of C, i.e. op(A) * op(A)^T:
+  for (ViennaCLInt i=0; i<C_size1; ++i)
+    for (ViennaCLInt j=0; j<=i; ++j)
+    {
+      float val_float = 0;
+      double val_double = 0;
+      for (ViennaCLInt k=0; k<size_k; ++k)
+      {
+        val_float  += get_value(A_float,  i, k, A_start1, A_start2, A_stride1, A_stride2, A_rows, A_columns, order_A, trans_A)
+                    * get_value(A_float,  j, k, A_start1, A_start2, A_stride1, A_stride2, A_rows, A_columns, order_A, trans_A);
+        val_double += get_value(A_double, i, k, A_start1, A_start2, A_stride1, A_stride2, A_rows, A_columns, order_A, trans_A)
+                    * get_value(A_double, j, k, A_start1, A_start2, A_stride1, A_stride2, A_rows, A_columns, order_A, trans_A);
+      }
+
+      if (order_C == ViennaCLRowMajor)
+      {
+        C_float [static_cast<std::size_t>((i*C_stride1 + C_start1) * C_columns + (j*C_stride2 + C_start2))] = val_float;
+        C_double[static_cast<std::size_t>((i*C_stride1 + C_start1) * C_columns + (j*C_stride2 + C_start2))] = val_double;
+      }
+      else
+      {
+        C_float [static_cast<std::size_t>((i*C_stride1 + C_start1) + (j*C_stride2 + C_start2) * C_rows)] = val_float;
+        C_double[static_cast<std::size_t>((i*C_stride1 + C_start1) + (j*C_stride2 + C_start2) * C_rows)] = val_double;
+      }
+    }
+
+  // Run SYRK and compare results (entries of C above the diagonal must remain untouched):
+  ViennaCLHostSsyrk(my_backend,
+                    order_A, trans_A, order_C, ViennaCLLower,
+                    C_size1, size_k,
+                    1.0f,
+                    viennacl::linalg::host_based::detail::extract_raw_pointer<float>(host_A_float), A_start1, A_start2, A_stride1, A_stride2, (order_A == ViennaCLRowMajor) ? A_columns : A_rows,
+                    0.0f,
+                    viennacl::linalg::host_based::detail::extract_raw_pointer<float>(host_C_float), C_start1, C_start2, C_stride1, C_stride2, (order_C == ViennaCLRowMajor) ? C_columns : C_rows);
+  check(C_float, host_C_float, eps_float);
+
+  ViennaCLHostDsyrk(my_backend,
+                    order_A, trans_A, order_C, ViennaCLLower,
+                    C_size1, size_k,
+                    1.0,
+                    viennacl::linalg::host_based::detail::extract_raw_pointer<double>(host_A_double), A_start1, A_start2, A_stride1, A_stride2, (order_A == ViennaCLRowMajor) ? A_columns : A_rows,
+                    0.0,
+                    viennacl::linalg::host_based::detail::extract_raw_pointer<double>(host_C_double), C_start1, C_start2, C_stride1, C_stride2, (order_C == ViennaCLRowMajor) ? C_columns : C_rows);
+  check(C_double, host_C_double, eps_double);
+
+  matrix_layout layout_A(A_start1, A_start2, A_stride1, A_stride2, A_rows, A_columns, order_A);
+  matrix_layout layout_B(B_start1, B_start2, B_stride1, B_stride2, B_rows, B_columns, order_B);
+  matrix_layout layout_C(C_start1, C_start2, C_stride1, C_stride2, C_rows, C_columns, order_C);
+
+  float  * ptr_A_float  = viennacl::linalg::host_based::detail::extract_raw_pointer<float>(host_A_float);
+  double * ptr_A_double = viennacl::linalg::host_based::detail::extract_raw_pointer<double>(host_A_double);
+  float  * ptr_B_float  = viennacl::linalg::host_based::detail::extract_raw_pointer<float>(host_B_float);
+  double * ptr_B_double = viennacl::linalg::host_based::detail::extract_raw_pointer<double>(host_B_double);
+  float  * ptr_C_float  = viennacl::linalg::host_based::detail::extract_raw_pointer<float>(host_C_float);
+  double * ptr_C_double = viennacl::linalg::host_based::detail::extract_raw_pointer<double>(host_C_double);
+
+  ViennaCLUplo uplos[2] = { ViennaCLLower, ViennaCLUpper };
+  ViennaCLSide sides[2] = { ViennaCLLeft, ViennaCLRight };
+  ViennaCLDiag diags[2] = { ViennaCLNonUnit, ViennaCLUnit };
+
+  // The scaling factors keep the entries of C of order one over all layouts tested.
+
+  // SYR2K on the leading square block of C with n = C_size1 and k = C_size2, where op(B) is the leading block of the matrix stored for B.
+  // transpose flag as for A:
+  for (std::size_t u=0; u<2; ++u)
+  {
+    reference_syr2k(uplos[u], trans_A, C_size1, C_size2, 0.03125f, A_float,  layout_A, B_float,  layout_B, 0.5f, C_float,  layout_C);
+    reference_syr2k(uplos[u], trans_A, C_size1, C_size2, 0.03125,  A_double, layout_A, B_double, layout_B, 0.5,  C_double, layout_C);
+
+    ViennaCLHostSsyr2k(my_backend, order_A, order_B, trans_A, order_C, uplos[u], C_size1, C_size2,
+                       0.03125f,
+                       ptr_A_float, A_start1, A_start2, A_stride1, A_stride2, layout_A.ld(),
+                       ptr_B_float, B_start1, B_start2, B_stride1, B_stride2, layout_B.ld(),
+                       0.5f,
+                       ptr_C_float, C_start1, C_start2, C_stride1, C_stride2, layout_C.ld());
+    check(C_float, host_C_float, eps_float);
+
+    ViennaCLHostDsyr2k(my_backend, order_A, order_B, trans_A, order_C, uplos[u], C_size1, C_size2,
+                       0.03125,
+                       ptr_A_double, A_start1, A_start2, A_stride1, A_stride2, layout_A.ld(),
+                       ptr_B_double, B_start1, B_start2, B_stride1, B_stride2, layout_B.ld(),
+                       0.5,
+                       ptr_C_double, C_start1, C_start2, C_stride1, C_stride2, layout_C.ld());
+    check(C_double, host_C_double, eps_double);
+  }
+
+  // SYMM with the leading square block of the matrix stored for A. C is m x n with m = C_size1 and n = C_size2 (left) or n = C_size1 (right):
+  for (std::size_t s=0; s<2; ++s)
+    for (std::size_t u=0; u<2; ++u)
+    {
+      ViennaCLInt n = (sides[s] == ViennaCLLeft) ? C_size2 : C_size1;
+      reference_symm(sides[s], uplos[u], C_size1, n, 0.03125f, A_float,  layout_A, B_float,  layout_B, 0.5f, C_float,  layout_C);
+      reference_symm(sides[s], uplos[u], C_size1, n, 0.03125,  A_double, layout_A, B_double, layout_B, 0.5,  C_double, layout_C);
+
+      ViennaCLHostSsymm(my_backend, sides[s], uplos[u], order_A, order_B, order_C, C_size1, n,
+                        0.03125f,
+                        ptr_A_float, A_start1, A_start2, A_stride1, A_stride2, layout_A.ld(),
+                        ptr_B_float, B_start1, B_start2, B_stride1, B_stride2, layout_B.ld(),
+                        0.5f,
+                        ptr_C_float, C_start1, C_start2, C_stride1, C_stride2, layout_C.ld());
+      check(C_float, host_C_float, eps_float);
+
+      ViennaCLHostDsymm(my_backend, sides[s], uplos[u], order_A, order_B, order_C, C_size1, n,
+                        0.03125,
+                        ptr_A_double, A_start1, A_start2, A_stride1, A_stride2, layout_A.ld(),
+                        ptr_B_double, B_start1, B_start2, B_stride1, B_stride2, layout_B.ld(),
+                        0.5,
+                        ptr_C_double, C_start1, C_start2, C_stride1, C_stride2, layout_C.ld());
+      check(C_double, host_C_double, eps_double);
+    }
+
+  // TRMM on C with the leading square block of the matrix stored for A, transpose flag as for A. C is m x n as for SYMM:
+  for (std::size_t s=0; s<2; ++s)
+    for (std::size_t u=0; u<2; ++u)
+      for (std::size_t d=0; d<2; ++d)
+      {
+        ViennaCLInt n = (sides[s] == ViennaCLLeft) ? C_size2 : C_size1;
+        reference_trmm(sides[s], uplos[u], trans_A, diags[d], C_size1, n, 0.0625f, A_float,  layout_A, C_float,  layout_C);
+        reference_trmm(sides[s], uplos[u], trans_A, diags[d], C_size1, n, 0.0625,  A_double, layout_A, C_double, layout_C);
+
+        ViennaCLHostStrmm(my_backend, sides[s], uplos[u], trans_A, diags[d], order_A, order_C, C_size1, n,
+                          0.0625f,
+                          ptr_A_float, A_start1, A_start2, A_stride1, A_stride2, layout_A.ld(),
+                          ptr_C_float, C_start1, C_start2, C_stride1, C_stride2, layout_C.ld());
+        check(C_float, host_C_float, eps_float);
+
+        ViennaCLHostDtrmm(my_backend, sides[s], uplos[u], trans_A, diags[d], order_A, order_C, C_size1, n,
+                          0.0625,
+                          ptr_A_double, A_start1, A_start2, A_stride1, A_stride2, layout_A.ld(),
+                          ptr_C_double, C_start1, C_start2, C_stride1, C_stride2, layout_C.ld());
+        check(C_double, host_C_double, eps_double);
+      }
+
   std::cout << std::endl;
 }
 
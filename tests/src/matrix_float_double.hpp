@@ -985,6 +985,58 @@ int run_test(double epsilon)
       }
     }
 
+    std::cout << "//" << std::endl;
+    std::cout << "////////// Test: Transposition //////////" << std::endl;
+    std::cout << "//" << std::endl;
+
+    {
+      MatrixType ublas_trans = trans(ublas_A);
+
+      std::cout << "Testing transposition of range... ";
+      VCLMatrixType vcl_trans = viennacl::trans(vcl_range_A);
+      if (!check_for_equality(ublas_trans, vcl_trans, epsilon))
+        return EXIT_FAILURE;
+
+      std::cout << "Testing in-place transposition (rectangular)... ";
+      VCLMatrixType vcl_temp = vcl_A;
+      vcl_temp = viennacl::trans(vcl_temp);
+      if (!check_for_equality(ublas_trans, vcl_temp, epsilon))
+        return EXIT_FAILURE;
+
+      std::cout << "Testing in-place transposition (square)... ";
+      MatrixType ublas_square = boost::numeric::ublas::subrange(ublas_A, 0, dim_cols, 0, dim_cols);
+      VCLMatrixType vcl_square(dim_cols, dim_cols);
+      viennacl::copy(ublas_square, vcl_square);
+      ublas_square = trans(ublas_square);
+      vcl_square   = viennacl::trans(vcl_square);
+      if (!check_for_equality(ublas_square, vcl_square, epsilon))
+        return EXIT_FAILURE;
+
+      std::cout << "Testing transposition of a rectangular submatrix into its own matrix... ";
+      MatrixType ublas_sub_trans = trans(boost::numeric::ublas::project(ublas_A, boost::numeric::ublas::range(1, dim_rows - 1), boost::numeric::ublas::range(2, dim_cols)));
+      VCLMatrixType vcl_M = vcl_A;
+      vcl_M = viennacl::trans(viennacl::project(vcl_M, viennacl::range(1, dim_rows - 1), viennacl::range(2, dim_cols)));
+      if (vcl_M.size1() != ublas_sub_trans.size1() || vcl_M.size2() != ublas_sub_trans.size2())
+      {
+        std::cout << "Size mismatch: " << vcl_M.size1() << "x" << vcl_M.size2() << " instead of " << ublas_sub_trans.size1() << "x" << ublas_sub_trans.size2() << std::endl;
+        return EXIT_FAILURE;
+      }
+      if (!check_for_equality(ublas_sub_trans, vcl_M, epsilon))
+        return EXIT_FAILURE;
+
+      std::cout << "Testing layout conversion (to row-major)... ";
+      viennacl::matrix<ScalarType, viennacl::row_major> vcl_row_major(dim_rows, dim_cols);
+      vcl_row_major = vcl_A;
+      if (!check_for_equality(ublas_A, vcl_row_major, epsilon))
+        return EXIT_FAILURE;
+
+      std::cout << "Testing layout conversion (to column-major)... ";
+      viennacl::matrix<ScalarType, viennacl::column_major> vcl_col_major(dim_rows, dim_cols);
+      vcl_col_major = vcl_A;
+      if (!check_for_equality(ublas_A, vcl_col_major, epsilon))
+        return EXIT_FAILURE;
+    }
+
     std::cout << "//" << std::endl;
     std::cout << "////////// Test: Initializer for matrix type //////////" << std::endl;
     std::cout << "//" << std::endl;
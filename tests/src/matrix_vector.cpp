@@ -24,6 +24,8 @@
 // *** System
 //
 #include <iostream>
+#include <string>
+#include <vector>
 
 //
 // *** Boost
@@ -49,6 +51,7 @@
 #include "viennacl/linalg/norm_2.hpp"
 #include "viennacl/linalg/direct_solve.hpp"
 #include "viennacl/linalg/lu.hpp"
+#include "viennacl/linalg/cholesky.hpp"
 #include "examples/tutorial/Random.hpp"
 
 //
@@ -222,6 +225,56 @@ int test_prod_rank1(Epsilon const & epsilon,
    }
    // --------------------------------------------------------------------------
 
+   std::cout << "Matrix-Vector product and transposed Matrix-Vector product at once" << std::endl;
+   {
+     viennacl::copy(ublas_v1.begin(), ublas_v1.end(), vcl_v1.begin());
+     viennacl::copy(ublas_v2.begin(), ublas_v2.end(), vcl_v2.begin());
+
+     // results in a vector and in a slice, which must not share memory with the inputs:
+     viennacl::vector<NumericT> vcl_y(ublas_v1.size());
+     viennacl::vector<NumericT> vcl_z_large(3 * ublas_v2.size() + 5);
+     viennacl::vector_slice< viennacl::vector<NumericT> > vcl_z(vcl_z_large, viennacl::slice(5, 3, ublas_v2.size()));
+
+     UblasVectorType ublas_y = viennacl::linalg::prod(ublas_m1, ublas_v2);
+     UblasVectorType ublas_z = viennacl::linalg::prod(trans(ublas_m1), ublas_v1);
+     viennacl::linalg::prod_and_trans_prod(vcl_m1, vcl_v2, vcl_y, vcl_v1, vcl_z);
+
+     if ( std::fabs(diff(ublas_y, vcl_y)) > epsilon || std::fabs(diff(ublas_z, vcl_z)) > epsilon )
+     {
+        std::cout << "# Error at operation: matrix-vector product and transposed matrix-vector product at once" << std::endl;
+        std::cout << "  diff: " << std::fabs(diff(ublas_y, vcl_y)) << ", " << std::fabs(diff(ublas_z, vcl_z)) << std::endl;
+        retval = EXIT_FAILURE;
+     }
+
+     // swapped roles of the vectors, i.e. the product with the stored rows is strided:
+     viennacl::vector<NumericT> vcl_y_large(2 * ublas_v1.size() + 1);
+     viennacl::vector_slice< viennacl::vector<NumericT> > vcl_y_slice(vcl_y_large, viennacl::slice(1, 2, ublas_v1.size()));
+     viennacl::vector<NumericT> vcl_z_native(ublas_v2.size());
+     viennacl::linalg::prod_and_trans_prod(vcl_m1, vcl_v2, vcl_y_slice, vcl_v1, vcl_z_native);
+
+     if ( std::fabs(diff(ublas_y, vcl_y_slice)) > epsilon || std::fabs(diff(ublas_z, vcl_z_native)) > epsilon )
+     {
+        std::cout << "# Error at operation: matrix-vector product and transposed matrix-vector product at once, strided results" << std::endl;
+        std::cout << "  diff: " << std::fabs(diff(ublas_y, vcl_y_slice)) << ", " << std::fabs(diff(ublas_z, vcl_z_native)) << std::endl;
+        retval = EXIT_FAILURE;
+     }
+
+     // results overwriting the inputs:
+     viennacl::vector<NumericT> vcl_yw(ublas_v1.size());
+     viennacl::vector<NumericT> vcl_zx(ublas_v2.size());
+     viennacl::copy(ublas_v1.begin(), ublas_v1.end(), vcl_yw.begin());
+     viennacl::copy(ublas_v2.begin(), ublas_v2.end(), vcl_zx.begin());
+     viennacl::linalg::prod_and_trans_prod(vcl_m1, vcl_zx, vcl_yw, vcl_yw, vcl_zx);
+
+     if ( std::fabs(diff(ublas_y, vcl_yw)) > epsilon || std::fabs(diff(ublas_z, vcl_zx)) > epsilon )
+     {
+        std::cout << "# Error at operation: matrix-vector product and transposed matrix-vector product at once, results aliasing the inputs" << std::endl;
+        std::cout << "  diff: " << std::fabs(diff(ublas_y, vcl_yw)) << ", " << std::fabs(diff(ublas_z, vcl_zx)) << std::endl;
+        retval = EXIT_FAILURE;
+     }
+   }
+   // --------------------------------------------------------------------------
+
    viennacl::copy(ublas_v1.begin(), ublas_v1.end(), vcl_v1.begin());
    viennacl::copy(ublas_v2.begin(), ublas_v2.end(), vcl_v2.begin());
 
@@ -407,6 +460,39 @@ int test_solve(Epsilon const & epsilon,
 //
 // -------------------------------------------------------------
 //
+template<typename NumericT, typename F>
+int test_empty_prod(std::size_t rows, std::size_t cols)
+{
+   // ranges of a matrix with a zero dimension, vectors with non-unit stride:
+   viennacl::matrix<NumericT, F> vcl_m_large = viennacl::scalar_matrix<NumericT>(rows + 7, cols + 7, NumericT(1));
+   viennacl::matrix_range< viennacl::matrix<NumericT, F> > vcl_m(vcl_m_large, viennacl::range(3, 3 + rows), viennacl::range(2, 2 + cols));
+   viennacl::vector<NumericT> vcl_large = viennacl::scalar_vector<NumericT>(3 * (rows + cols) + 3, NumericT(1));
+   viennacl::vector_slice< viennacl::vector<NumericT> > vcl_x(vcl_large, viennacl::slice(0, 3, cols));
+   viennacl::vector_slice< viennacl::vector<NumericT> > vcl_w(vcl_large, viennacl::slice(1, 3, rows));
+   viennacl::vector<NumericT> vcl_large_result = viennacl::scalar_vector<NumericT>(2 * (rows + cols) + 2, NumericT(1));
+   viennacl::vector_slice< viennacl::vector<NumericT> > vcl_y(vcl_large_result, viennacl::slice(0, 2, rows));
+   viennacl::vector_slice< viennacl::vector<NumericT> > vcl_z(vcl_large_result, viennacl::slice(1, 2, cols));
+
+   vcl_y = viennacl::linalg::prod(vcl_m, vcl_x);
+   vcl_z = viennacl::linalg::prod(trans(vcl_m), vcl_w);
+   if (viennacl::linalg::norm_2(vcl_y) > 0 || viennacl::linalg::norm_2(vcl_z) > 0)
+   {
+      std::cout << "# Error at operation: matrix-vector product with a " << rows << "x" << cols << " matrix" << std::endl;
+      return EXIT_FAILURE;
+   }
+
+   vcl_large_result = viennacl::scalar_vector<NumericT>(vcl_large_result.size(), NumericT(1));
+   viennacl::linalg::prod_and_trans_prod(vcl_m, vcl_x, vcl_y, vcl_w, vcl_z);
+   if (viennacl::linalg::norm_2(vcl_y) > 0 || viennacl::linalg::norm_2(vcl_z) > 0)
+   {
+      std::cout << "# Error at operation: matrix-vector product and transposed matrix-vector product at once with a " << rows << "x" << cols << " matrix" << std::endl;
+      return EXIT_FAILURE;
+   }
+
+   return EXIT_SUCCESS;
+}
+
+
 template< typename NumericT, typename F, typename Epsilon >
 int test(Epsilon const& epsilon)
 {
@@ -1048,6 +1134,142 @@ int test(Epsilon const& epsilon)
    }
 
 
+   ////////////// Cholesky factorization:
+
+   std::cout << "Cholesky solver" << std::endl;
+   for (std::size_t i=0; i<lu_dim; ++i)
+   {
+     for (std::size_t j=0; j<i; ++j)
+     {
+       square_matrix(i,j) = -static_cast<NumericT>(0.1) * random<NumericT>();
+       square_matrix(j,i) = square_matrix(i,j);
+     }
+     square_matrix(i,i) = static_cast<NumericT>(20.0) + random<NumericT>();
+     lu_rhs(i) = random<NumericT>();
+   }
+
+   viennacl::matrix<NumericT, F> vcl_spd_matrix(lu_dim, lu_dim);
+   viennacl::copy(square_matrix, vcl_square_matrix);
+   viennacl::copy(square_matrix, vcl_spd_matrix);
+   viennacl::copy(lu_rhs, vcl_lu_rhs);
+
+   viennacl::linalg::cholesky_factorize(vcl_square_matrix);
+   viennacl::linalg::cholesky_substitute(vcl_square_matrix, vcl_lu_rhs);
+
+   viennacl::vector<NumericT> vcl_cholesky_check = viennacl::linalg::prod(vcl_spd_matrix, vcl_lu_rhs);
+   if ( std::fabs(diff(lu_rhs, vcl_cholesky_check)) > epsilon )
+   {
+      std::cout << "# Error at operation: Cholesky solver" << std::endl;
+      retval = EXIT_FAILURE;
+   }
+
+   square_matrix(lu_dim / 2, lu_dim / 2) = -static_cast<NumericT>(1.0);
+   viennacl::copy(square_matrix, vcl_square_matrix);
+   try
+   {
+     viennacl::linalg::cholesky_factorize(vcl_square_matrix);
+     std::cout << "# Error at operation: Cholesky factorization of indefinite matrix succeeded" << std::endl;
+     retval = EXIT_FAILURE;
+   }
+   catch (viennacl::linalg::not_positive_definite_exception const & e)
+   {
+     if (e.pivot_index() != lu_dim / 2 || e.is_batched())
+     {
+       std::cout << "# Error at operation: Cholesky factorization reported wrong pivot " << e.pivot_index() << std::endl;
+       retval = EXIT_FAILURE;
+     }
+   }
+
+   std::cout << "Batched Cholesky factorization" << std::endl;
+   {
+     // matrices of different sizes, the last one large enough for the blocked factorization:
+     std::size_t batch_sizes[5] = { 1, 7, 33, 64, 150 };
+     std::vector< ublas::matrix<NumericT> > batch_ref;
+     std::vector< viennacl::matrix<NumericT, F> > vcl_batch;
+     for (std::size_t b=0; b<5; ++b)
+     {
+       std::size_t n = batch_sizes[b];
+       ublas::matrix<NumericT> spd(n, n);
+       for (std::size_t i=0; i<n; ++i)
+       {
+         for (std::size_t j=0; j<i; ++j)
+         {
+           spd(i,j) = -static_cast<NumericT>(0.1) * random<NumericT>();
+           spd(j,i) = spd(i,j);
+         }
+         spd(i,i) = static_cast<NumericT>(n) + random<NumericT>();
+       }
+       batch_ref.push_back(spd);
+       vcl_batch.push_back(viennacl::matrix<NumericT, F>(n, n));
+       viennacl::copy(spd, vcl_batch.back());
+     }
+
+     viennacl::linalg::cholesky_factorize(vcl_batch);
+
+     for (std::size_t b=0; b<5; ++b)
+     {
+       std::size_t n = batch_sizes[b];
+       ublas::vector<NumericT> rhs(n);
+       for (std::size_t i=0; i<n; ++i)
+         rhs(i) = random<NumericT>();
+       viennacl::vector<NumericT> vcl_rhs(n);
+       viennacl::copy(rhs, vcl_rhs);
+
+       viennacl::linalg::cholesky_substitute(vcl_batch[b], vcl_rhs);
+
+       ublas::vector<NumericT> result(n);
+       viennacl::copy(vcl_rhs, result);
+       ublas::vector<NumericT> check_rhs = ublas::prod(batch_ref[b], result);
+       viennacl::copy(check_rhs, vcl_rhs);
+       if ( std::fabs(diff(rhs, vcl_rhs)) > epsilon )
+       {
+         std::cout << "# Error at operation: batched Cholesky factorization, matrix " << b << std::endl;
+         retval = EXIT_FAILURE;
+       }
+     }
+
+     // matrices 1 and 3 are indefinite: the first of them is reported, all others are still factorized
+     batch_ref[1](4, 4) = -static_cast<NumericT>(1.0);
+     batch_ref[3](20, 20) = -static_cast<NumericT>(1.0);
+     for (std::size_t b=0; b<5; ++b)
+       viennacl::copy(batch_ref[b], vcl_batch[b]);
+     try
+     {
+       viennacl::linalg::cholesky_factorize(vcl_batch);
+       std::cout << "# Error at operation: batched Cholesky factorization of indefinite matrices succeeded" << std::endl;
+       retval = EXIT_FAILURE;
+     }
+     catch (viennacl::linalg::not_positive_definite_exception const & e)
+     {
+       if (!e.is_batched() || e.matrix_index() != 1 || e.pivot_index() != 4 || std::string(e.what()).find("Matrix 1 in batch") == std::string::npos)
+       {
+         std::cout << "# Error at operation: batched Cholesky factorization reported matrix " << e.matrix_index() << ", pivot " << e.pivot_index() << ": " << e.what() << std::endl;
+         retval = EXIT_FAILURE;
+       }
+     }
+
+     ublas::vector<NumericT> rhs(batch_sizes[4]);
+     for (std::size_t i=0; i<rhs.size(); ++i)
+       rhs(i) = random<NumericT>();
+     viennacl::vector<NumericT> vcl_rhs(rhs.size());
+     viennacl::copy(rhs, vcl_rhs);
+     viennacl::linalg::cholesky_substitute(vcl_batch[4], vcl_rhs);
+     ublas::vector<NumericT> result(rhs.size());
+     viennacl::copy(vcl_rhs, result);
+     ublas::vector<NumericT> check_rhs = ublas::prod(batch_ref[4], result);
+     viennacl::copy(check_rhs, vcl_rhs);
+     if ( std::fabs(diff(rhs, vcl_rhs)) > epsilon )
+     {
+       std::cout << "# Error at operation: batched Cholesky factorization, matrix after a failing matrix" << std::endl;
+       retval = EXIT_FAILURE;
+     }
+   }
+
+   std::cout << "Matrix-Vector products with empty matrices" << std::endl;
+   if (   test_empty_prod<NumericT, F>(0, 5) != EXIT_SUCCESS
+       || test_empty_prod<NumericT, F>(5, 0) != EXIT_SUCCESS
+       || test_empty_prod<NumericT, F>(0, 0) != EXIT_SUCCESS)
+     retval = EXIT_FAILURE;
 
    return retval;
 }
@@ -0,0 +1,886 @@
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+
+/** \file tests/src/preconditioner.cpp  Tests the convergence of iterative solvers with the preconditioners on the host.
+*   \test  Tests the convergence of iterative solvers with the preconditioners on the host.
+**/
+
+//
+// *** System
+//
+#include <iostream>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <stdexcept>
+
+#ifndef NDEBUG
+ #define BOOST_UBLAS_NDEBUG
+#endif
+
+// AMG depends on Boost.uBLAS:
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <boost/numeric/ublas/operation_sparse.hpp>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/gmres.hpp"
+#include "viennacl/linalg/gauss_seidel.hpp"
+#include "viennacl/linalg/ichol.hpp"
+#include "viennacl/linalg/ilu.hpp"
+#include "viennacl/linalg/amg.hpp"
+#include "viennacl/linalg/polynomial_precond.hpp"
+
+
+typedef double     NumericT;
+
+
+/** @brief Assembles the 5-point finite difference discretization of -div(grad u) + convection * du/dx on an n-by-n grid */
+void assemble_grid(unsigned int n, NumericT convection, viennacl::compressed_matrix<NumericT> & A)
+{
+  std::vector< std::map<unsigned int, NumericT> > host_A(n * n);
+  for (unsigned int i=0; i<n; ++i)
+    for (unsigned int j=0; j<n; ++j)
+    {
+      unsigned int row = i * n + j;
+      host_A[row][row] = 4;
+      if (i > 0)     host_A[row][row - n] = -1;
+      if (i < n - 1) host_A[row][row + n] = -1;
+      if (j > 0)     host_A[row][row - 1] = -1 - convection;
+      if (j < n - 1) host_A[row][row + 1] = -1 + convection;
+    }
+  viennacl::copy(host_A, A);
+}
+
+/** @brief Returns the relative residual norm ||b - A x|| / ||b|| */
+NumericT relative_residual(viennacl::compressed_matrix<NumericT> const & A, viennacl::vector<NumericT> const & x, viennacl::vector<NumericT> const & b)
+{
+  viennacl::vector<NumericT> r = b;
+  r -= viennacl::linalg::prod(A, x);
+  return viennacl::linalg::norm_2(r) / viennacl::linalg::norm_2(b);
+}
+
+/** @brief Solves A x = b with the given solver and preconditioner and checks the residual and the number of iterations */
+template<typename SolverTagT, typename PrecondT>
+int check_solve(std::string const & name, viennacl::compressed_matrix<NumericT> const & A, viennacl::vector<NumericT> const & b,
+                SolverTagT const & solver, PrecondT const & precond, std::size_t max_iters)
+{
+  viennacl::vector<NumericT> x = viennacl::linalg::solve(A, b, solver, precond);
+  NumericT residual = relative_residual(A, x, b);
+
+  std::cout << "  " << name << ": " << solver.iters() << " iterations, relative residual " << residual << std::endl;
+  if (!(residual <= NumericT(1e-6)) || solver.iters() > max_iters) // fails for NaN as well
+  {
+    std::cout << "# Error at operation: " << name << std::endl;
+    std::cout << "  Maximum number of iterations: " << max_iters << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int test_multicolor_gauss_seidel(unsigned int n)
+{
+  viennacl::compressed_matrix<NumericT> A;
+  assemble_grid(n, 0, A);
+  viennacl::vector<NumericT> b = viennacl::scalar_vector<NumericT>(A.size1(), NumericT(1));
+
+  std::vector< std::map<unsigned int, NumericT> > host_A(A.size1());
+  viennacl::copy(A, host_A);
+  std::vector<unsigned int> colors;
+  unsigned int num_colors = 0;
+
+  // coloring is valid:
+  {
+    std::vector<unsigned int> row_buffer(1, 0), col_buffer;
+    for (std::size_t i=0; i<host_A.size(); ++i)
+    {
+      for (std::map<unsigned int, NumericT>::const_iterator it = host_A[i].begin(); it != host_A[i].end(); ++it)
+        col_buffer.push_back(it->first);
+      row_buffer.push_back(static_cast<unsigned int>(col_buffer.size()));
+    }
+
+    num_colors = viennacl::linalg::detail::jones_plassmann_coloring(&row_buffer[0], &col_buffer[0], host_A.size(), colors);
+    std::cout << "  Coloring: " << num_colors << " colors" << std::endl;
+    for (std::size_t i=0; i<host_A.size(); ++i)
+    {
+      for (unsigned int k=row_buffer[i]; k<row_buffer[i+1]; ++k)
+        if (col_buffer[k] != i && colors[col_buffer[k]] == colors[i])
+        {
+          std::cout << "# Error: Rows " << i << " and " << col_buffer[k] << " are coupled and have the same color" << std::endl;
+          return EXIT_FAILURE;
+        }
+      if (colors[i] >= num_colors)
+      {
+        std::cout << "# Error: Invalid color of row " << i << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    if (num_colors > 6) // 5-point stencil: at most 5 colors by the greedy rule
+    {
+      std::cout << "# Error: Too many colors: " << num_colors << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // SSOR application agrees with sequential sweeps over the rows ordered by color:
+  viennacl::linalg::gauss_seidel_precond< viennacl::compressed_matrix<NumericT> > ssor(A, viennacl::linalg::gauss_seidel_tag(1.5, true, 2));
+  {
+    std::vector<unsigned int> order;
+    for (unsigned int c=0; c<num_colors; ++c)
+      for (std::size_t i=0; i<colors.size(); ++i)
+        if (colors[i] == c)
+          order.push_back(static_cast<unsigned int>(i));
+
+    std::vector<NumericT> rhs(A.size1()), ref(A.size1(), 0), result(A.size1());
+    for (std::size_t i=0; i<rhs.size(); ++i)
+      rhs[i] = NumericT(1) + NumericT(i % 5);
+    for (unsigned int sweep=0; sweep<4; ++sweep) // two symmetric sweeps
+      for (std::size_t k=0; k<order.size(); ++k)
+      {
+        unsigned int i = (sweep % 2) ? order[order.size() - k - 1] : order[k];
+        NumericT sum = rhs[i];
+        for (std::map<unsigned int, NumericT>::const_iterator it = host_A[i].begin(); it != host_A[i].end(); ++it)
+          sum -= it->second * ref[it->first];
+        ref[i] += NumericT(1.5) * sum / host_A[i][i];
+      }
+
+    viennacl::vector<NumericT> x(A.size1());
+    viennacl::copy(rhs, x);
+    ssor.apply(x);
+    viennacl::copy(x, result);
+
+    NumericT diff = 0;
+    for (std::size_t i=0; i<ref.size(); ++i)
+      diff = std::max(diff, std::fabs(ref[i] - result[i]) / std::fabs(ref[i]));
+    std::cout << "  SSOR vs. sequential sweeps: " << diff << std::endl;
+    if (diff > NumericT(1e-12))
+    {
+      std::cout << "# Error: Multicolor SSOR does not match sequential sweeps" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  viennacl::linalg::cg_tag cg_solver(1e-8, 1000);
+  viennacl::linalg::no_precond no_precond;
+  if (check_solve("CG", A, b, cg_solver, no_precond, 1000) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  std::size_t cg_iters = cg_solver.iters();
+
+  // symmetric Gauss-Seidel must reduce the number of CG iterations (multicolor orderings are weaker than the natural ordering):
+  viennacl::linalg::gauss_seidel_precond< viennacl::compressed_matrix<NumericT> > sgs(A, viennacl::linalg::gauss_seidel_tag(1.0, true));
+  if (check_solve("CG + SGS", A, b, cg_solver, sgs, cg_iters - 1) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  if (check_solve("CG + SSOR(1.5, 2 sweeps)", A, b, cg_solver, ssor, cg_iters * 4 / 5) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // nonsymmetric problem: forward Gauss-Seidel with GMRES
+  viennacl::compressed_matrix<NumericT> B;
+  assemble_grid(n, NumericT(0.5), B);
+  viennacl::linalg::gmres_tag gmres_solver(1e-8, 1000, 30);
+  if (check_solve("GMRES", B, b, gmres_solver, no_precond, 1000) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  std::size_t gmres_iters = gmres_solver.iters();
+
+  viennacl::linalg::gauss_seidel_precond< viennacl::compressed_matrix<NumericT> > gs(B, viennacl::linalg::gauss_seidel_tag(1.0, false));
+  if (check_solve("GMRES + GS", B, b, gmres_solver, gs, gmres_iters / 2) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // strided vectors give the same result as contiguous vectors, also if the buffers are reused:
+  {
+    std::vector<NumericT> host_x(A.size1());
+    std::vector<NumericT> strided_data(2 * A.size1());
+    for (std::size_t i=0; i<host_x.size(); ++i)
+    {
+      host_x[i] = NumericT(i % 7) - NumericT(3);
+      strided_data[2 * i + 1] = host_x[i];
+    }
+
+    viennacl::vector<NumericT> x(A.size1());
+    viennacl::copy(host_x, x);
+    viennacl::vector<NumericT> x_strided(&strided_data[0], viennacl::MAIN_MEMORY, A.size1(), 1, 2);
+    for (int repeat = 0; repeat < 2; ++repeat)
+    {
+      ssor.apply(x);
+      ssor.apply(x_strided);
+    }
+
+    viennacl::copy(x, host_x);
+    NumericT diff = 0;
+    for (std::size_t i=0; i<host_x.size(); ++i)
+      diff = std::max(diff, std::fabs(host_x[i] - strided_data[2 * i + 1]));
+    std::cout << "  Strided vs. contiguous application: " << diff << std::endl;
+    if (diff > 0)
+    {
+      std::cout << "# Error: Application of the preconditioner to a strided vector differs" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // AMG with multicolor Gauss-Seidel smoothers:
+  unsigned int const smoothers[2] = { VIENNACL_AMG_SMOOTHER_MULTICOLOR_GS, VIENNACL_AMG_SMOOTHER_MULTICOLOR_SGS };
+  char const * smoother_names[2] = { "CG + AMG (multicolor GS smoother)", "CG + AMG (multicolor SGS smoother)" };
+  for (std::size_t i=0; i<2; ++i)
+  {
+    viennacl::linalg::amg_tag amg_tag(VIENNACL_AMG_COARSE_PMIS, VIENNACL_AMG_INTERPOL_DIRECT, 0.25, 0.2, 1, 1, 1, 0);
+    amg_tag.set_smoother(smoothers[i]);
+    viennacl::linalg::amg_precond< viennacl::compressed_matrix<NumericT> > amg(A, amg_tag);
+    amg.setup();
+    if (check_solve(smoother_names[i], A, b, cg_solver, amg, cg_iters / 4) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int test_incomplete_cholesky(unsigned int n)
+{
+  viennacl::compressed_matrix<NumericT> A;
+  assemble_grid(n, 0, A);
+  viennacl::vector<NumericT> b = viennacl::scalar_vector<NumericT>(A.size1(), NumericT(1));
+
+  std::vector< std::map<unsigned int, NumericT> > host_A(A.size1());
+  viennacl::copy(A, host_A);
+
+  // precondition() writes L^T to the upper triangular part. IC(0) reproduces A on its sparsity pattern: (L L^T)_ij = A_ij
+  viennacl::compressed_matrix<NumericT> LT;
+  LT = A; // deep copy
+  viennacl::linalg::precondition(LT, viennacl::linalg::ichol0_tag());
+  std::vector< std::map<unsigned int, NumericT> > host_LT(A.size1());
+  viennacl::copy(LT, host_LT);
+  for (std::size_t i=0; i<host_LT.size(); ++i)
+    for (std::map<unsigned int, NumericT>::iterator it = host_LT[i].begin(); it != host_LT[i].end(); )
+    {
+      if (it->first < i)
+        host_LT[i].erase(it++);
+      else
+        ++it;
+    }
+
+  // columns of L^T, i.e. rows of L:
+  std::vector< std::map<unsigned int, NumericT> > host_L(A.size1());
+  for (std::size_t j=0; j<host_LT.size(); ++j)
+    for (std::map<unsigned int, NumericT>::const_iterator it = host_LT[j].begin(); it != host_LT[j].end(); ++it)
+      host_L[it->first][static_cast<unsigned int>(j)] = it->second;
+
+  NumericT pattern_error = 0;
+  for (std::size_t i=0; i<host_A.size(); ++i)
+    for (std::map<unsigned int, NumericT>::const_iterator it = host_A[i].begin(); it != host_A[i].end(); ++it)
+    {
+      NumericT LLT_ij = 0;
+      for (std::map<unsigned int, NumericT>::const_iterator it2 = host_L[i].begin(); it2 != host_L[i].end(); ++it2)
+        if (host_L[it->first].find(it2->first) != host_L[it->first].end())
+          LLT_ij += it2->second * host_L[it->first][it2->first];
+      pattern_error = std::max(pattern_error, std::fabs(LLT_ij - it->second));
+    }
+  std::cout << "  IC(0): max |(L L^T - A)_ij| on the pattern of A: " << pattern_error << std::endl;
+  if (pattern_error > NumericT(1e-12))
+  {
+    std::cout << "# Error: IC(0) factor does not reproduce A on its sparsity pattern" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the level-scheduled substitutions solve L L^T y = b:
+  viennacl::linalg::ichol0_precond< viennacl::compressed_matrix<NumericT> > ichol0(A, viennacl::linalg::ichol0_tag());
+  {
+    std::vector<NumericT> host_b(A.size1()), y(A.size1()), z(A.size1(), 0), LLT_y(A.size1(), 0);
+    for (std::size_t i=0; i<host_b.size(); ++i)
+      host_b[i] = NumericT(1) + NumericT(i % 3);
+    viennacl::vector<NumericT> vcl_y(A.size1());
+    viennacl::copy(host_b, vcl_y);
+    ichol0.apply(vcl_y);
+    viennacl::copy(vcl_y, y);
+
+    for (std::size_t j=0; j<host_LT.size(); ++j)  // z = L^T y
+      for (std::map<unsigned int, NumericT>::const_iterator it = host_LT[j].begin(); it != host_LT[j].end(); ++it)
+        z[j] += it->second * y[it->first];
+    for (std::size_t i=0; i<host_L.size(); ++i)   // L z
+      for (std::map<unsigned int, NumericT>::const_iterator it = host_L[i].begin(); it != host_L[i].end(); ++it)
+        LLT_y[i] += it->second * z[it->first];
+
+    NumericT apply_error = 0;
+    for (std::size_t i=0; i<host_b.size(); ++i)
+      apply_error = std::max(apply_error, std::fabs(LLT_y[i] - host_b[i]) / host_b[i]);
+    std::cout << "  IC(0): max relative error of L L^T y = b: " << apply_error << std::endl;
+    if (apply_error > NumericT(1e-12))
+    {
+      std::cout << "# Error: Application of the IC(0) preconditioner does not solve L L^T y = b" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  viennacl::linalg::cg_tag cg_solver(1e-8, 1000);
+  viennacl::linalg::no_precond no_precond;
+  if (check_solve("CG", A, b, cg_solver, no_precond, 1000) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  std::size_t cg_iters = cg_solver.iters();
+
+  if (check_solve("CG + IC(0)", A, b, cg_solver, ichol0, cg_iters / 2) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  std::size_t ichol0_iters = cg_solver.iters();
+
+  // ICT keeps more fill-in than IC(0) and must not need more iterations:
+  viennacl::linalg::icholt_precond< viennacl::compressed_matrix<NumericT> > icholt(A, viennacl::linalg::icholt_tag(10, 1e-3));
+  std::cout << "  Nonzeros: IC(0) " << ichol0.nnz() << ", ICT " << icholt.nnz() << std::endl;
+  if (icholt.nnz() < ichol0.nnz())
+  {
+    std::cout << "# Error: ICT factor has fewer nonzeros than IC(0)" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (check_solve("CG + ICT(10, 1e-3)", A, b, cg_solver, icholt, ichol0_iters) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // without dropping, ICT is the complete Cholesky factorization:
+  viennacl::linalg::icholt_precond< viennacl::compressed_matrix<NumericT> > cholesky(A, viennacl::linalg::icholt_tag(n, 0.0));
+  if (check_solve("CG + ICT without dropping", A, b, cg_solver, cholesky, 2) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int test_schwarz(unsigned int n)
+{
+  viennacl::compressed_matrix<NumericT> A;
+  assemble_grid(n, NumericT(0.2), A);
+  viennacl::vector<NumericT> b = viennacl::scalar_vector<NumericT>(A.size1(), NumericT(1));
+
+  // The Householder variant of GMRES measures the left-preconditioned residual, hence the Arnoldi variant is used for comparing the true residual:
+  viennacl::linalg::gmres_tag gmres_solver(1e-8, 1000, 50);
+  gmres_solver.orthogonalization(viennacl::linalg::gmres_tag::modified_gram_schmidt);
+  viennacl::linalg::no_precond no_precond;
+  if (check_solve("GMRES", A, b, gmres_solver, no_precond, 1000) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  std::size_t gmres_iters = gmres_solver.iters();
+
+  typedef viennacl::linalg::schwarz_precond< viennacl::compressed_matrix<NumericT>, viennacl::linalg::ilu0_tag >  SchwarzILU0Type;
+  typedef viennacl::linalg::schwarz_precond< viennacl::compressed_matrix<NumericT>, viennacl::linalg::ilut_tag >  SchwarzILUTType;
+
+  // a single subdomain with a complete factorization is a direct solver:
+  SchwarzILUTType exact(A, viennacl::linalg::ilut_tag(2 * n + 1, 0.0), viennacl::linalg::schwarz_tag(1, 0));
+  if (check_solve("GMRES + Schwarz, one subdomain, complete LU", A, b, gmres_solver, exact, 1) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // overlap reduces the number of iterations of restricted additive Schwarz:
+  std::size_t previous_iters = gmres_iters;
+  for (unsigned int overlap = 0; overlap <= 2; ++overlap)
+  {
+    SchwarzILU0Type ras(A, viennacl::linalg::ilu0_tag(), viennacl::linalg::schwarz_tag(8, overlap));
+    if (ras.num_subdomains() != 8)
+    {
+      std::cout << "# Error: Expected 8 subdomains, got " << ras.num_subdomains() << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::ostringstream name;
+    name << "GMRES + RAS/ILU0, 8 subdomains, overlap " << overlap;
+    if (check_solve(name.str(), A, b, gmres_solver, ras, (overlap == 0) ? previous_iters / 2 : previous_iters) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    previous_iters = gmres_solver.iters();
+
+    // strided vectors give the same result as contiguous vectors:
+    std::vector<NumericT> host_x(A.size1());
+    std::vector<NumericT> strided_data(3 * A.size1());
+    for (std::size_t i=0; i<host_x.size(); ++i)
+    {
+      host_x[i] = NumericT(i % 11) - NumericT(5);
+      strided_data[3 * i] = host_x[i];
+    }
+    viennacl::vector<NumericT> x(A.size1());
+    viennacl::copy(host_x, x);
+    viennacl::vector<NumericT> x_strided(&strided_data[0], viennacl::MAIN_MEMORY, A.size1(), 0, 3);
+    ras.apply(x);
+    ras.apply(x_strided);
+    viennacl::copy(x, host_x);
+    for (std::size_t i=0; i<host_x.size(); ++i)
+      if (host_x[i] < strided_data[3 * i] || host_x[i] > strided_data[3 * i])
+      {
+        std::cout << "# Error: Application of the Schwarz preconditioner to a strided vector differs at entry " << i << std::endl;
+        return EXIT_FAILURE;
+      }
+  }
+
+  // additive Schwarz with ILUT:
+  SchwarzILUTType as(A, viennacl::linalg::ilut_tag(), viennacl::linalg::schwarz_tag(8, 1, false));
+  if (check_solve("GMRES + AS/ILUT, 8 subdomains, overlap 1", A, b, gmres_solver, as, gmres_iters / 2) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int test_chebyshev_preconditioners(unsigned int n)
+{
+  typedef viennacl::compressed_matrix<NumericT>   MatrixType;
+
+  MatrixType A;
+  assemble_grid(n, 0, A);
+  viennacl::vector<NumericT> b = viennacl::scalar_vector<NumericT>(A.size1(), NumericT(1));
+
+  viennacl::linalg::cg_tag cg_solver(1e-8, 1000);
+  if (check_solve("CG", A, b, cg_solver, viennacl::linalg::no_precond(), 1000) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  std::size_t cg_iters = cg_solver.iters();
+
+  // The eigenvectors of the 5-point stencil are products of sine modes. The preconditioner scales them by p(mu) / 4 with mu = lambda / 4 an eigenvalue of the Jacobi-scaled matrix.
+  // For mu inside the bounds of the polynomial, the Chebyshev polynomial guarantees |1 - p(mu) mu| <= 1 / T_{d+1}(sigma), and the truncated Neumann series gives 1 - p(mu) mu = (1 - mu / theta)^{d+1}:
+  for (unsigned int degree = 1; degree <= 4; ++degree)
+  {
+    viennacl::linalg::polynomial_precond<MatrixType> chebyshev(A, viennacl::linalg::polynomial_precond_tag(degree));
+    viennacl::linalg::polynomial_precond<MatrixType> neumann(A, viennacl::linalg::polynomial_precond_tag(degree, viennacl::linalg::polynomial_precond_tag::neumann_polynomial));
+    NumericT lower = NumericT(chebyshev.spectrum_lower());
+    NumericT upper = NumericT(chebyshev.spectrum_upper());
+    NumericT theta = (upper + lower) / 2;
+    NumericT sigma = (upper + lower) / (upper - lower);
+    NumericT chebyshev_bound = 1 / std::cosh(NumericT(degree + 1) * std::log(sigma + std::sqrt(sigma * sigma - 1)));
+
+    NumericT pi = std::acos(NumericT(-1));
+    NumericT max_deviation = 0;
+    for (unsigned int k = 1; k <= n; k += 5)
+      for (unsigned int l = 1; l <= n; l += 7)
+      {
+        std::vector<NumericT> host_v(A.size1()), host_y(A.size1());
+        for (unsigned int i = 0; i < n; ++i)
+          for (unsigned int j = 0; j < n; ++j)
+            host_v[i * n + j] = std::sin(pi * NumericT(k * (i + 1)) / NumericT(n + 1)) * std::sin(pi * NumericT(l * (j + 1)) / NumericT(n + 1));
+        NumericT mu = (4 - 2 * std::cos(pi * NumericT(k) / NumericT(n + 1)) - 2 * std::cos(pi * NumericT(l) / NumericT(n + 1))) / 4;
+
+        for (int type = 0; type < 2; ++type)
+        {
+          viennacl::vector<NumericT> v(A.size1());
+          viennacl::copy(host_v, v);
+          if (type == 0)
+            chebyshev.apply(v);
+          else
+            neumann.apply(v);
+          viennacl::copy(v, host_y);
+
+          // p(mu) from the largest entry, then check that v is scaled uniformly:
+          std::size_t index = (n / 3) * n + n / 5;
+          NumericT p_mu = 4 * host_y[index] / host_v[index];
+          for (std::size_t i = 0; i < host_v.size(); ++i)
+            max_deviation = std::max(max_deviation, std::fabs(host_y[i] - p_mu / 4 * host_v[i]));
+
+          bool ok = (type == 0) ? ((mu >= lower) ? std::fabs(1 - p_mu * mu) <= chebyshev_bound + NumericT(1e-10) : (p_mu * mu > 0 && p_mu * mu < 1))
+                                : std::fabs(1 - p_mu * mu - std::pow(1 - mu / theta, NumericT(degree + 1))) <= NumericT(1e-10);
+          if (!ok)
+          {
+            std::cout << "# Error: " << ((type == 0) ? "Chebyshev" : "Neumann") << " polynomial of degree " << degree << " at mu = " << mu << ": p(mu) mu = " << p_mu * mu << std::endl;
+            return EXIT_FAILURE;
+          }
+        }
+      }
+    std::cout << "  Polynomial preconditioners of degree " << degree << ": bounds [" << lower << ", " << upper << "], 1/T_{d+1}(sigma) = " << chebyshev_bound
+              << ", deviation from eigenvectors " << max_deviation << std::endl;
+    if (max_deviation > NumericT(1e-10))
+    {
+      std::cout << "# Error: Polynomial preconditioners of degree " << degree << " do not preserve the eigenvectors" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Preconditioned CG needs fewer iterations. The reduction is less than suggested by the condition number, because the equioscillating Chebyshev polynomial maps many eigenvalues from the interior of the spectrum to the lower end:
+  viennacl::linalg::polynomial_precond<MatrixType> chebyshev(A, viennacl::linalg::polynomial_precond_tag(3));
+  if (check_solve("CG + Chebyshev polynomial, degree 3", A, b, cg_solver, chebyshev, cg_iters - 1) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  viennacl::linalg::polynomial_precond<MatrixType> neumann(A, viennacl::linalg::polynomial_precond_tag(3, viennacl::linalg::polynomial_precond_tag::neumann_polynomial));
+  if (check_solve("CG + Neumann polynomial, degree 3", A, b, cg_solver, neumann, cg_iters - 1) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // bounds supplied by the user are used as they are:
+  viennacl::linalg::polynomial_precond_tag bounds_tag(3);
+  bounds_tag.set_spectrum_bounds(0.001, 2.1);
+  viennacl::linalg::polynomial_precond<MatrixType> chebyshev_bounds(A, bounds_tag);
+  if (chebyshev_bounds.spectrum_lower() < 0.001 || chebyshev_bounds.spectrum_lower() > 0.001 || chebyshev_bounds.spectrum_upper() < 2.1 || chebyshev_bounds.spectrum_upper() > 2.1)
+  {
+    std::cout << "# Error: Polynomial preconditioner does not use the bounds of the tag" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (check_solve("CG + Chebyshev polynomial, degree 3, bounds from tag", A, b, cg_solver, chebyshev_bounds, cg_iters - 1) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // AMG with the Chebyshev smoother vs. the Jacobi smoother:
+  viennacl::linalg::amg_tag amg_config(VIENNACL_AMG_COARSE_MIS2, VIENNACL_AMG_INTERPOL_SA, 0.08, 0.67, 0.67, 1, 1, 0);
+  viennacl::linalg::amg_precond<MatrixType> amg_jacobi(A, amg_config);
+  amg_jacobi.setup();
+  if (check_solve("CG + AMG, Jacobi smoother", A, b, cg_solver, amg_jacobi, cg_iters / 4) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  std::size_t amg_jacobi_iters = cg_solver.iters();
+
+  // a smoother of degree 1 is a damped Jacobi step for an interval which is not adapted to the matrix, higher degrees are at least as good as Jacobi:
+  amg_config.set_smoother(VIENNACL_AMG_SMOOTHER_CHEBYSHEV);
+  for (unsigned int degree = 1; degree <= 3; ++degree)
+  {
+    amg_config.set_chebyshev_degree(degree);
+    viennacl::linalg::amg_precond<MatrixType> amg_chebyshev(A, amg_config);
+    amg_chebyshev.setup();
+
+    std::ostringstream name;
+    name << "CG + AMG, Chebyshev smoother of degree " << degree;
+    if (check_solve(name.str(), A, b, cg_solver, amg_chebyshev, (degree == 1) ? cg_iters / 3 : amg_jacobi_iters) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int test_amg_coarsening(unsigned int n)
+{
+  typedef viennacl::compressed_matrix<NumericT>   MatrixType;
+
+  MatrixType A;
+  assemble_grid(n, 0, A);
+  viennacl::vector<NumericT> b = viennacl::scalar_vector<NumericT>(A.size1(), NumericT(1));
+
+  viennacl::linalg::cg_tag cg_solver(1e-8, 1000);
+  if (check_solve("CG", A, b, cg_solver, viennacl::linalg::no_precond(), 1000) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  std::size_t cg_iters = cg_solver.iters();
+
+  unsigned int const coarsenings[2] = { VIENNACL_AMG_COARSE_PMIS, VIENNACL_AMG_COARSE_HMIS };
+  char const * coarsening_names[2] = { "PMIS", "HMIS" };
+  for (std::size_t i=0; i<2; ++i)
+  {
+    viennacl::linalg::amg_tag amg_config(coarsenings[i], VIENNACL_AMG_INTERPOL_DIRECT, 0.25, 0.2, 0.67, 1, 1, 0);
+    amg_config.set_smoother(VIENNACL_AMG_SMOOTHER_SGS);
+
+    viennacl::linalg::amg_precond<MatrixType> amg(A, amg_config);
+    amg.setup();
+    std::vector<NumericT> avgstencil;
+    NumericT operator_complexity = amg.calc_complexity(avgstencil);
+    NumericT grid_complexity     = amg.calc_grid_complexity();
+    std::cout << "  " << coarsening_names[i] << ": " << amg.tag().get_coarselevels() << " coarse levels, operator complexity " << operator_complexity
+              << ", grid complexity " << grid_complexity << std::endl;
+    if (check_solve(std::string("CG + AMG, ") + coarsening_names[i] + " coarsening, direct interpolation", A, b, cg_solver, amg, cg_iters / 5) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
+    // multipass interpolation without aggressive coarsening:
+    amg_config.set_interpol(VIENNACL_AMG_INTERPOL_MULTIPASS);
+    viennacl::linalg::amg_precond<MatrixType> amg_multipass(A, amg_config);
+    amg_multipass.setup();
+    if (check_solve(std::string("CG + AMG, ") + coarsening_names[i] + " coarsening, multipass interpolation", A, b, cg_solver, amg_multipass, cg_iters / 5) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
+    // aggressive coarsening on the finest level(s) reduces the size of the hierarchy at the price of more iterations:
+    for (unsigned int aggressive_levels = 1; aggressive_levels <= 2; ++aggressive_levels)
+    {
+      amg_config.set_aggressive_levels(aggressive_levels);
+      viennacl::linalg::amg_precond<MatrixType> amg_aggressive(A, amg_config);
+      amg_aggressive.setup();
+      NumericT aggressive_operator_complexity = amg_aggressive.calc_complexity(avgstencil);
+      NumericT aggressive_grid_complexity     = amg_aggressive.calc_grid_complexity();
+      std::cout << "  " << coarsening_names[i] << ", aggressive on " << aggressive_levels << " level(s): " << amg_aggressive.tag().get_coarselevels()
+                << " coarse levels, operator complexity " << aggressive_operator_complexity << ", grid complexity " << aggressive_grid_complexity << std::endl;
+      if (aggressive_operator_complexity >= operator_complexity || aggressive_grid_complexity >= grid_complexity)
+      {
+        std::cout << "# Error: Aggressive coarsening does not reduce the operator and grid complexities" << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      std::ostringstream name;
+      name << "CG + AMG, " << coarsening_names[i] << " coarsening, aggressive on " << aggressive_levels << " level(s), multipass interpolation";
+      if (check_solve(name.str(), A, b, cg_solver, amg_aggressive, cg_iters / 3) != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int test_amg_smoothers(unsigned int n)
+{
+  typedef viennacl::compressed_matrix<NumericT>   MatrixType;
+
+  MatrixType A;
+  assemble_grid(n, 0, A);
+  viennacl::vector<NumericT> b = viennacl::scalar_vector<NumericT>(A.size1(), NumericT(1));
+
+  std::vector< std::map<unsigned int, NumericT> > host_A(A.size1());
+  viennacl::copy(A, host_A);
+
+  viennacl::linalg::cg_tag cg_solver(1e-8, 1000);
+  if (check_solve("CG", A, b, cg_solver, viennacl::linalg::no_precond(), 1000) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  std::size_t cg_iters = cg_solver.iters();
+
+  viennacl::linalg::amg_tag amg_config(VIENNACL_AMG_COARSE_PMIS, VIENNACL_AMG_INTERPOL_DIRECT, 0.25, 0.2, 0.67, 1, 1, 0);
+
+  // the public Jacobi smoother agrees with two damped Jacobi steps x <- x + omega D^{-1} (b - A x) from x = 0 on the host:
+  {
+    viennacl::linalg::amg_precond<MatrixType> amg(A, amg_config);
+    amg.setup();
+
+    std::vector<NumericT> host_b(A.size1()), ref(A.size1(), 0), result(A.size1());
+    for (std::size_t i=0; i<host_b.size(); ++i)
+      host_b[i] = NumericT(1) + NumericT(i % 7);
+    for (unsigned int iter=0; iter<2; ++iter)
+    {
+      std::vector<NumericT> r(host_b);
+      for (std::size_t i=0; i<host_A.size(); ++i)
+        for (std::map<unsigned int, NumericT>::const_iterator it = host_A[i].begin(); it != host_A[i].end(); ++it)
+          r[i] -= it->second * ref[it->first];
+      for (std::size_t i=0; i<ref.size(); ++i)
+        ref[i] += NumericT(0.67) * r[i] / host_A[i][static_cast<unsigned int>(i)];
+    }
+
+    viennacl::vector<NumericT> x = viennacl::zero_vector<NumericT>(A.size1());
+    viennacl::vector<NumericT> rhs(A.size1());
+    viennacl::copy(host_b, rhs);
+    amg.smooth_jacobi(0, 2, x, rhs);
+    viennacl::copy(x, result);
+
+    NumericT diff = 0;
+    for (std::size_t i=0; i<ref.size(); ++i)
+      diff = std::max(diff, std::fabs(ref[i] - result[i]) / std::fabs(ref[i]));
+    std::cout << "  AMG Jacobi smoother vs. damped Jacobi steps: " << diff << std::endl;
+    if (diff > NumericT(1e-12))
+    {
+      std::cout << "# Error: Jacobi smoother of AMG does not match damped Jacobi steps" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // each smoother reduces the residual on the finest level, and AMG converges with each of them:
+  unsigned int const smoothers[4] = { VIENNACL_AMG_SMOOTHER_JACOBI, VIENNACL_AMG_SMOOTHER_L1_JACOBI, VIENNACL_AMG_SMOOTHER_GS, VIENNACL_AMG_SMOOTHER_SGS };
+  char const * smoother_names[4] = { "Jacobi", "l1-Jacobi", "hybrid GS", "hybrid SGS" };
+  std::size_t jacobi_iters = 0;
+  for (std::size_t i=0; i<4; ++i)
+  {
+    amg_config.set_smoother(smoothers[i]);
+    viennacl::linalg::amg_precond<MatrixType> amg(A, amg_config);
+    amg.setup();
+
+    viennacl::vector<NumericT> x = viennacl::zero_vector<NumericT>(A.size1());
+    amg.smooth(0, 5, x, b);
+    NumericT residual = relative_residual(A, x, b);
+    std::cout << "  " << smoother_names[i] << " smoother: relative residual after 5 sweeps " << residual << std::endl;
+    if (residual >= NumericT(1) || residual != residual)
+    {
+      std::cout << "# Error: " << smoother_names[i] << " smoother does not reduce the residual" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Gauss-Seidel smoothers (backward sweeps for postsmoothing) must not need more iterations than Jacobi:
+    if (check_solve(std::string("CG + AMG, ") + smoother_names[i] + " smoother", A, b, cg_solver, amg, (i < 2) ? cg_iters / 4 : jacobi_iters) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    if (i == 0)
+      jacobi_iters = cg_solver.iters();
+  }
+
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+/** @brief Adds a spring between the nodes p and q in direction (dx, dy) to the stiffness matrix of a truss with two displacement unknowns per node */
+void add_spring(std::vector< std::map<unsigned int, NumericT> > & K, unsigned int p, unsigned int q, NumericT dx, NumericT dy)
+{
+  NumericT len = std::sqrt(dx * dx + dy * dy);
+  NumericT d[2] = { dx / len, dy / len };
+  for (unsigned int a = 0; a < 2; ++a)
+    for (unsigned int c = 0; c < 2; ++c)
+    {
+      K[2*p+a][2*p+c] += d[a] * d[c];
+      K[2*q+a][2*q+c] += d[a] * d[c];
+      K[2*p+a][2*q+c] -= d[a] * d[c];
+      K[2*q+a][2*p+c] -= d[a] * d[c];
+    }
+}
+
+int test_smoothed_aggregation(unsigned int n)
+{
+  typedef viennacl::compressed_matrix<NumericT>   MatrixType;
+
+  // Truss of springs on an n-by-n grid, clamped at the left edge and loaded at the right edge.
+  // The rigid body modes (two translations, one rotation) as near-nullspace must reduce the number of iterations compared to the constant near-nullspace:
+  {
+    std::vector< std::map<unsigned int, NumericT> > host_K(2 * n * n);
+    std::vector<NumericT> host_f(2 * n * n);
+    std::vector<double> rigid_body_modes(2 * n * n * 3);
+    for (unsigned int i = 0; i < n; ++i)
+      for (unsigned int j = 0; j < n; ++j)
+      {
+        unsigned int p = i * n + j;   // node at x = j, y = i
+        if (j + 1 < n)              add_spring(host_K, p, p + 1,     NumericT(1),  NumericT(0));
+        if (i + 1 < n)              add_spring(host_K, p, p + n,     NumericT(0),  NumericT(1));
+        if (i + 1 < n && j + 1 < n) add_spring(host_K, p, p + n + 1, NumericT(1),  NumericT(1));
+        if (i + 1 < n && j > 0)     add_spring(host_K, p, p + n - 1, NumericT(-1), NumericT(1));
+
+        if (j == 0)      // clamped
+        {
+          host_K[2*p][2*p]     += NumericT(1);
+          host_K[2*p+1][2*p+1] += NumericT(1);
+        }
+        if (j + 1 == n)  // load
+          host_f[2*p+1] = NumericT(-1);
+
+        double x = double(j) / double(n) - 0.5;
+        double y = double(i) / double(n) - 0.5;
+        double modes[6] = { 1, 0, -y,
+                            0, 1,  x };
+        for (unsigned int k = 0; k < 6; ++k)
+          rigid_body_modes[6 * p + k] = modes[k];
+      }
+
+    MatrixType K(2 * n * n, 2 * n * n);
+    viennacl::vector<NumericT> f(2 * n * n);
+    viennacl::copy(host_K, K);
+    viennacl::copy(host_f, f);
+
+    viennacl::linalg::amg_tag amg_config(VIENNACL_AMG_COARSE_MIS2, VIENNACL_AMG_INTERPOL_SA, 0.08, 0.67, 0.67, 1, 1, 0);
+    amg_config.set_smoother(VIENNACL_AMG_SMOOTHER_SGS);
+    amg_config.set_block_size(2);
+
+    viennacl::linalg::cg_tag cg_solver(1e-8, 1000);
+    viennacl::linalg::amg_precond<MatrixType> amg_constant(K, amg_config);
+    amg_constant.setup();
+    if (check_solve("CG + SA-AMG for a truss, constant near-nullspace", K, f, cg_solver, amg_constant, 1000) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    std::size_t constant_iters = cg_solver.iters();
+
+    amg_config.set_nullspace(rigid_body_modes, 3);
+    viennacl::linalg::amg_precond<MatrixType> amg_rigid(K, amg_config);
+    amg_rigid.setup();
+    if (check_solve("CG + SA-AMG for a truss, rigid body modes as near-nullspace", K, f, cg_solver, amg_rigid, constant_iters - 1) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  // Poisson problem with a constraint coupling the first and the last unknown. The row of the constraint has no diagonal entry, which must receive one in the filtered operator of smoothed aggregation:
+  {
+    unsigned int size = n * n + 1;
+    std::vector< std::map<unsigned int, NumericT> > host_A(size);
+    for (unsigned int i = 0; i < n; ++i)
+      for (unsigned int j = 0; j < n; ++j)
+      {
+        unsigned int p = i * n + j;
+        host_A[p][p] = NumericT(4);
+        if (i > 0)     host_A[p][p - n] = NumericT(-1);
+        if (i + 1 < n) host_A[p][p + n] = NumericT(-1);
+        if (j > 0)     host_A[p][p - 1] = NumericT(-1);
+        if (j + 1 < n) host_A[p][p + 1] = NumericT(-1);
+      }
+    host_A[size - 1][0]         = NumericT(1);   // no diagonal entry in the last row
+    host_A[size - 1][n * n - 1] = NumericT(-1);
+    host_A[0][size - 1]         = NumericT(1);
+    host_A[n * n - 1][size - 1] = NumericT(-1);
+
+    std::vector<NumericT> host_b(size, NumericT(1));
+    host_b[size - 1] = 0;
+
+    MatrixType A(size, size);
+    viennacl::vector<NumericT> b(size);
+    viennacl::copy(host_A, A);
+    viennacl::copy(host_b, b);
+
+    try
+    {
+      viennacl::linalg::amg_tag amg_config(VIENNACL_AMG_COARSE_MIS2, VIENNACL_AMG_INTERPOL_SA, 0.08, 0.67, 0.67, 1, 1, 0);
+      viennacl::linalg::amg_precond<MatrixType> amg(A, amg_config);
+      amg.setup();
+
+      viennacl::linalg::gmres_tag gmres_solver(1e-8, 300, 30);
+      if (check_solve("GMRES + SA-AMG, row without diagonal entry", A, b, gmres_solver, amg, 300) != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+    }
+    catch (std::exception const & e)
+    {
+      std::cout << "# Error: SA-AMG for a matrix with a row without diagonal entry throws: " << e.what() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Preconditioners" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  std::cout << "# Testing setup: 2D grid, 48x48 unknowns" << std::endl;
+
+  std::cout << "## Multicolor Gauss-Seidel, SOR and SSOR" << std::endl;
+  if (test_multicolor_gauss_seidel(48) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << "## Incomplete Cholesky: IC(0) and ICT" << std::endl;
+  if (test_incomplete_cholesky(48) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << "## Overlapping additive Schwarz" << std::endl;
+  if (test_schwarz(48) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << "## AMG: PMIS and HMIS coarsening, aggressive coarsening, multipass interpolation" << std::endl;
+  if (test_amg_coarsening(48) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << "## AMG smoothers: Jacobi, l1-Jacobi, hybrid Gauss-Seidel and symmetric Gauss-Seidel" << std::endl;
+  if (test_amg_smoothers(48) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << "## Chebyshev preconditioners: polynomial preconditioner and AMG smoother" << std::endl;
+  if (test_chebyshev_preconditioners(48) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << "## Smoothed aggregation: near-nullspace and rows without diagonal entry" << std::endl;
+  if (test_smoothed_aggregation(40) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
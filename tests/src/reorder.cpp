@@ -0,0 +1,380 @@
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+
+/** \file tests/src/reorder.cpp  Tests the reordering of compressed matrices: reverse Cuthill-McKee, nested dissection and permute().
+*   \test  Tests the reordering of compressed matrices: reverse Cuthill-McKee, nested dissection and permute().
+**/
+
+//
+// *** System
+//
+#include <iostream>
+#include <vector>
+#include <map>
+#include <string>
+#include <algorithm>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/misc/bandwidth_reduction.hpp"
+
+
+typedef double     NumericT;
+typedef std::vector< std::map<unsigned int, NumericT> >  host_matrix;
+
+/** @brief Deterministic pseudo-random numbers (linear congruential generator), so that failures are reproducible */
+class lcg
+{
+public:
+  lcg(unsigned long seed) : state_(seed) {}
+  std::size_t operator()(std::size_t n) { state_ = (state_ * 1103515245UL + 12345UL) % 2147483648UL; return static_cast<std::size_t>(state_ >> 8) % n; }
+private:
+  unsigned long state_;
+};
+
+/** @brief Adds the five-point stencil on an nx-by-ny grid to A, where the unknown k of the grid is numbered numbering[offset + k] */
+void add_grid(std::size_t nx, std::size_t ny, std::vector<unsigned int> const & numbering, std::size_t offset, host_matrix & A)
+{
+  for (std::size_t j=0; j<ny; ++j)
+    for (std::size_t i=0; i<nx; ++i)
+    {
+      std::size_t k = offset + j * nx + i;
+      unsigned int row = numbering[k];
+      A[row][row] = 4;
+      if (i > 0)      A[row][numbering[k - 1]]  = -1;
+      if (i + 1 < nx) A[row][numbering[k + 1]]  = -1;
+      if (j > 0)      A[row][numbering[k - nx]] = -1;
+      if (j + 1 < ny) A[row][numbering[k + nx]] = -1;
+    }
+}
+
+/** @brief Returns a random permutation of 0, ..., n-1 */
+std::vector<unsigned int> random_permutation(std::size_t n, unsigned long seed)
+{
+  lcg rng(seed);
+  std::vector<unsigned int> r(n);
+  for (std::size_t i=0; i<n; ++i)
+    r[i] = static_cast<unsigned int>(i);
+  for (std::size_t i=n; i>1; --i)
+    std::swap(r[i-1], r[rng(i)]);
+  return r;
+}
+
+/** @brief Returns the bandwidth of a matrix, i.e. the maximum of |i - j| over all nonzeros (i, j) */
+std::size_t bandwidth(host_matrix const & A)
+{
+  std::size_t bw = 0;
+  for (std::size_t i=0; i<A.size(); ++i)
+    for (host_matrix::value_type::const_iterator it = A[i].begin(); it != A[i].end(); ++it)
+      bw = std::max(bw, (it->first > i) ? it->first - i : i - it->first);
+  return bw;
+}
+
+/** @brief Returns the number of nonzeros in the Cholesky factor L of a matrix with symmetric sparsity pattern (symbolic factorization via the elimination tree) */
+std::size_t cholesky_fill(host_matrix const & A)
+{
+  std::size_t n = A.size();
+  std::size_t none = n;
+  std::vector<std::size_t> parent(n, none), ancestor(n, none), marker(n, none);
+
+  std::size_t nnz = 0;
+  for (std::size_t i=0; i<n; ++i)
+  {
+    marker[i] = i;
+    ++nnz; // diagonal
+    for (host_matrix::value_type::const_iterator it = A[i].begin(); it != A[i].end() && it->first < i; ++it)
+    {
+      // elimination tree (Liu), with path compression:
+      std::size_t k = it->first;
+      while (ancestor[k] != none && ancestor[k] != i)
+      {
+        std::size_t next = ancestor[k];
+        ancestor[k] = i;
+        k = next;
+      }
+      if (ancestor[k] == none)
+      {
+        ancestor[k] = i;
+        parent[k] = i;
+      }
+
+      // the nonzeros of row i of L are the nodes on the paths from the columns of A(i, 0:i-1) to i:
+      for (std::size_t j = it->first; marker[j] != i; j = parent[j])
+      {
+        marker[j] = i;
+        ++nnz;
+      }
+    }
+  }
+  return nnz;
+}
+
+/** @brief Checks that r is a permutation of 0, ..., n-1 */
+int check_permutation(std::vector<unsigned int> const & r, std::size_t n, std::string const & name)
+{
+  if (r.size() != n)
+  {
+    std::cout << "# Error: " << name << ": size of permutation is " << r.size() << " instead of " << n << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::vector<bool> seen(n, false);
+  for (std::size_t i=0; i<n; ++i)
+  {
+    if (r[i] >= n || seen[r[i]])
+    {
+      std::cout << "# Error: " << name << ": not a permutation, entry " << i << " is " << r[i] << std::endl;
+      return EXIT_FAILURE;
+    }
+    seen[r[i]] = true;
+  }
+  return EXIT_SUCCESS;
+}
+
+/** @brief Checks that permute() yields B(r[i], r[j]) == A(i, j) for all entries and that B has no further entries. Returns B in host_B. */
+int check_permute(host_matrix const & host_A, viennacl::compressed_matrix<NumericT> const & A, std::vector<unsigned int> const & r,
+                  host_matrix & host_B, std::string const & name)
+{
+  viennacl::compressed_matrix<NumericT> B;
+  viennacl::permute(A, r, B);
+
+  if (B.size1() != A.size1() || B.size2() != A.size2() || B.nnz() != A.nnz())
+  {
+    std::cout << "# Error: " << name << ": permuted matrix has size " << B.size1() << "x" << B.size2() << " with " << B.nnz() << " nonzeros" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  host_B.clear();
+  host_B.resize(B.size1());
+  viennacl::copy(B, host_B);
+
+  std::size_t num_entries = 0;
+  for (std::size_t i=0; i<host_A.size(); ++i)
+    for (host_matrix::value_type::const_iterator it = host_A[i].begin(); it != host_A[i].end(); ++it, ++num_entries)
+    {
+      host_matrix::value_type::const_iterator it_B = host_B[r[i]].find(r[it->first]);
+      if (it_B == host_B[r[i]].end() || it_B->second != it->second)
+      {
+        std::cout << "# Error: " << name << ": B(r[" << i << "], r[" << it->first << "]) != A(" << i << ", " << it->first << ")" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+  std::size_t num_entries_B = 0;
+  for (std::size_t i=0; i<host_B.size(); ++i)
+    num_entries_B += host_B[i].size();
+  if (num_entries_B != num_entries)
+  {
+    std::cout << "# Error: " << name << ": permuted matrix has " << num_entries_B << " entries instead of " << num_entries << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int test_grid(std::size_t nx, std::size_t ny)
+{
+  std::cout << "# Testing scrambled " << nx << "x" << ny << " grid" << std::endl;
+
+  std::size_t n = nx * ny;
+  host_matrix host_A(n);
+  add_grid(nx, ny, random_permutation(n, 42 + nx), 0, host_A);
+  viennacl::compressed_matrix<NumericT> A(n, n);
+  viennacl::copy(host_A, A);
+
+  std::size_t bw_scrambled   = bandwidth(host_A);
+  std::size_t fill_scrambled = cholesky_fill(host_A);
+  host_matrix host_B;
+
+  // reverse Cuthill-McKee: the bandwidth of a grid is reduced to about the size of the smaller dimension
+  std::vector<unsigned int> r = viennacl::reorder(A, viennacl::reverse_cuthill_mckee_tag());
+  if (check_permutation(r, n, "RCM") != EXIT_SUCCESS || check_permute(host_A, A, r, host_B, "RCM") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::size_t bw_rcm = bandwidth(host_B);
+  std::cout << "  Bandwidth: scrambled " << bw_scrambled << ", reverse Cuthill-McKee " << bw_rcm << std::endl;
+  if (bw_rcm > 2 * std::min(nx, ny) + 2)
+  {
+    std::cout << "# Error: Bandwidth after reverse Cuthill-McKee too large" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // nested dissection: less fill-in in a Cholesky factorization than for the scrambled matrix
+  r = viennacl::reorder(A, viennacl::nested_dissection_tag(16));
+  if (check_permutation(r, n, "nested dissection") != EXIT_SUCCESS || check_permute(host_A, A, r, host_B, "nested dissection") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::size_t fill_nd = cholesky_fill(host_B);
+  std::cout << "  Nonzeros in Cholesky factor: scrambled " << fill_scrambled << ", nested dissection " << fill_nd << std::endl;
+  if (2 * fill_nd > fill_scrambled)
+  {
+    std::cout << "# Error: Fill-in after nested dissection too large" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // a subgraph size above the number of unknowns does not dissect at all:
+  r = viennacl::reorder(A, viennacl::nested_dissection_tag(n + 1));
+  if (check_permutation(r, n, "nested dissection without separators") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int test_disconnected()
+{
+  std::cout << "# Testing disconnected graph with empty rows" << std::endl;
+
+  // two grids, a path and isolated unknowns without any entries, scrambled:
+  std::size_t n1 = 30 * 20, n2 = 15 * 15, n3 = 50, n_empty = 7;
+  std::size_t n = n1 + n2 + n3 + n_empty;
+  std::vector<unsigned int> numbering = random_permutation(n, 7);
+
+  host_matrix host_A(n);
+  add_grid(30, 20, numbering, 0,  host_A);
+  add_grid(15, 15, numbering, n1, host_A);
+  for (std::size_t i=0; i<n3; ++i)
+  {
+    unsigned int row = numbering[n1 + n2 + i];
+    host_A[row][row] = 2;
+    if (i > 0)      host_A[row][numbering[n1 + n2 + i - 1]] = -1;
+    if (i + 1 < n3) host_A[row][numbering[n1 + n2 + i + 1]] = -1;
+  }
+  // the last n_empty entries of 'numbering' remain empty rows
+
+  viennacl::compressed_matrix<NumericT> A(n, n);
+  viennacl::copy(host_A, A);
+  host_matrix host_B;
+
+  std::vector<unsigned int> r = viennacl::reorder(A, viennacl::reverse_cuthill_mckee_tag());
+  if (check_permutation(r, n, "RCM") != EXIT_SUCCESS || check_permute(host_A, A, r, host_B, "RCM") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  std::cout << "  Bandwidth: scrambled " << bandwidth(host_A) << ", reverse Cuthill-McKee " << bandwidth(host_B) << std::endl;
+  if (bandwidth(host_B) > 2 * 20 + 2)
+  {
+    std::cout << "# Error: Bandwidth after reverse Cuthill-McKee too large" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  r = viennacl::reorder(A, viennacl::nested_dissection_tag(16));
+  if (check_permutation(r, n, "nested dissection") != EXIT_SUCCESS || check_permute(host_A, A, r, host_B, "nested dissection") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // matrices without any entries, with and without initialized row buffer:
+  host_matrix host_Z(5);
+  viennacl::compressed_matrix<NumericT> Z(5, 5), Z_uninitialized(5, 5);
+  viennacl::copy(viennacl::tools::const_sparse_matrix_adapter<NumericT, unsigned int>(host_Z, 5, 5), Z);
+  r = viennacl::reorder(Z, viennacl::reverse_cuthill_mckee_tag());
+  if (check_permutation(r, 5, "RCM of empty matrix") != EXIT_SUCCESS || check_permute(host_Z, Z, r, host_B, "RCM of empty matrix") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  r = viennacl::reorder(Z, viennacl::nested_dissection_tag());
+  if (check_permutation(r, 5, "nested dissection of empty matrix") != EXIT_SUCCESS || check_permute(host_Z, Z, r, host_B, "nested dissection of empty matrix") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (   check_permutation(viennacl::reorder(Z_uninitialized, viennacl::reverse_cuthill_mckee_tag()), 5, "RCM of empty matrix") != EXIT_SUCCESS
+      || check_permutation(viennacl::reorder(Z_uninitialized, viennacl::nested_dissection_tag()), 5, "nested dissection of empty matrix") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int test_wide_levels()
+{
+  std::cout << "# Testing graph with wide levels" << std::endl;
+
+  // a hub connected to many paths of length two, so that the levels of the breadth-first search are processed in parallel:
+  std::size_t num_paths = 3000;
+  std::size_t n = 1 + 2 * num_paths;
+  std::vector<unsigned int> numbering = random_permutation(n, 3);
+
+  host_matrix host_A(n);
+  unsigned int hub = numbering[0];
+  host_A[hub][hub] = NumericT(num_paths + 1);
+  for (std::size_t k=0; k<num_paths; ++k)
+  {
+    unsigned int a = numbering[1 + 2 * k], b = numbering[2 + 2 * k];
+    host_A[hub][a] = host_A[a][hub] = -1;
+    host_A[a][b]   = host_A[b][a]   = -1;
+    host_A[a][a] = 3;
+    host_A[b][b] = 2;
+  }
+  viennacl::compressed_matrix<NumericT> A(n, n);
+  viennacl::copy(host_A, A);
+  host_matrix host_B;
+
+  std::vector<unsigned int> r = viennacl::reorder(A, viennacl::reverse_cuthill_mckee_tag());
+  if (check_permutation(r, n, "RCM") != EXIT_SUCCESS || check_permute(host_A, A, r, host_B, "RCM") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+#ifdef VIENNACL_WITH_OPENMP
+  // the ordering does not depend on the number of threads:
+  int num_threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  std::vector<unsigned int> r_sequential = viennacl::reorder(A, viennacl::reverse_cuthill_mckee_tag());
+  omp_set_num_threads(num_threads);
+  if (r != r_sequential)
+  {
+    std::cout << "# Error: Reverse Cuthill-McKee ordering depends on the number of threads" << std::endl;
+    return EXIT_FAILURE;
+  }
+#endif
+
+  r = viennacl::reorder(A, viennacl::nested_dissection_tag());
+  if (check_permutation(r, n, "nested dissection") != EXIT_SUCCESS || check_permute(host_A, A, r, host_B, "nested dissection") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Reordering of Sparse Matrices" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  if (test_grid(60, 50) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_grid(200, 15) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_disconnected() != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_wide_levels() != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
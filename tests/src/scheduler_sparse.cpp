@@ -50,6 +50,7 @@
 #include "viennacl/compressed_matrix.hpp"
 #include "viennacl/coordinate_matrix.hpp"
 #include "viennacl/ell_matrix.hpp"
+#include "viennacl/sliced_ell_matrix.hpp"
 #include "viennacl/hyb_matrix.hpp"
 #include "viennacl/vector.hpp"
 #include "viennacl/vector_proxy.hpp"
@@ -214,6 +215,7 @@ int test(Epsilon const& epsilon)
   viennacl::compressed_matrix<NumericT> vcl_compressed_matrix(rhs.size(), rhs.size());
   viennacl::coordinate_matrix<NumericT> vcl_coordinate_matrix(rhs.size(), rhs.size());
   viennacl::ell_matrix<NumericT> vcl_ell_matrix;
+  viennacl::sliced_ell_matrix<NumericT> vcl_sliced_ell_matrix;
   viennacl::hyb_matrix<NumericT> vcl_hyb_matrix;
 
   viennacl::copy(rhs.begin(), rhs.end(), vcl_rhs.begin());
@@ -288,6 +290,25 @@ int test(Epsilon const& epsilon)
     retval = EXIT_FAILURE;
   }
 
+  //std::cout << "Copying sliced_ell_matrix" << std::endl;
+  viennacl::copy(ublas_matrix, vcl_sliced_ell_matrix);
+
+  std::cout << "Testing products: sliced_ell_matrix" << std::endl;
+  rhs *= NumericT(1.1);
+  vcl_rhs *= NumericT(1.1);
+  result     = viennacl::linalg::prod(ublas_matrix, rhs);
+  {
+  viennacl::scheduler::statement my_statement(vcl_result, viennacl::op_assign(), viennacl::linalg::prod(vcl_sliced_ell_matrix, vcl_rhs));
+  viennacl::scheduler::execute(my_statement);
+  }
+
+  if ( std::fabs(diff(result, vcl_result)) > epsilon )
+  {
+    std::cout << "# Error at operation: matrix-vector product with sliced_ell_matrix" << std::endl;
+    std::cout << "  diff: " << std::fabs(diff(result, vcl_result)) << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
   //std::cout << "Copying hyb_matrix" << std::endl;
   viennacl::copy(ublas_matrix, vcl_hyb_matrix);
   ublas_matrix.clear();
@@ -319,6 +340,7 @@ int test(Epsilon const& epsilon)
   copy(ublas_matrix, vcl_compressed_matrix);
   copy(ublas_matrix, vcl_coordinate_matrix);
   copy(ublas_matrix, vcl_ell_matrix);
+  copy(ublas_matrix, vcl_sliced_ell_matrix);
   copy(ublas_matrix, vcl_hyb_matrix);
 
   std::cout << "Testing scaled additions of products and vectors: compressed_matrix" << std::endl;
@@ -372,6 +394,23 @@ int test(Epsilon const& epsilon)
     retval = EXIT_FAILURE;
   }
 
+  std::cout << "Testing scaled additions of products and vectors: sliced_ell_matrix" << std::endl;
+  copy(result.begin(), result.end(), vcl_result.begin());
+  rhs *= NumericT(1.1);
+  vcl_rhs *= NumericT(1.1);
+  result     = alpha * viennacl::linalg::prod(ublas_matrix, rhs) + beta * result;
+  {
+  viennacl::scheduler::statement my_statement(vcl_result2, viennacl::op_assign(), alpha * viennacl::linalg::prod(vcl_sliced_ell_matrix, vcl_rhs) + beta * vcl_result);
+  viennacl::scheduler::execute(my_statement);
+  }
+
+  if ( std::fabs(diff(result, vcl_result2)) > epsilon )
+  {
+    std::cout << "# Error at operation: matrix-vector product (sliced_ell_matrix) with scaled additions" << std::endl;
+    std::cout << "  diff: " << std::fabs(diff(result, vcl_result2)) << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
   std::cout << "Testing scaled additions of products and vectors: hyb_matrix" << std::endl;
   copy(result.begin(), result.end(), vcl_result.begin());
   rhs *= NumericT(1.1);
@@ -389,6 +428,26 @@ int test(Epsilon const& epsilon)
     retval = EXIT_FAILURE;
   }
 
+  std::cout << "Testing scaled additions of products and vector ranges: compressed_matrix" << std::endl;
+  {
+  viennacl::vector<NumericT> vcl_rhs_large(2 * rhs.size());
+  viennacl::range r(rhs.size() / 2, rhs.size() / 2 + rhs.size());
+  viennacl::vector_range<viennacl::vector<NumericT> > vcl_rhs_range(vcl_rhs_large, r);
+  viennacl::copy(rhs.begin(), rhs.end(), vcl_rhs_range.begin());
+
+  copy(result.begin(), result.end(), vcl_result.begin());
+  result     = alpha * viennacl::linalg::prod(ublas_matrix, rhs) + beta * result;
+  viennacl::scheduler::statement my_statement(vcl_result2, viennacl::op_assign(), alpha * viennacl::linalg::prod(vcl_compressed_matrix, vcl_rhs_range) + beta * vcl_result);
+  viennacl::scheduler::execute(my_statement);
+  }
+
+  if ( std::fabs(diff(result, vcl_result2)) > epsilon )
+  {
+    std::cout << "# Error at operation: matrix-vector product (compressed_matrix) of vector range with scaled additions" << std::endl;
+    std::cout << "  diff: " << std::fabs(diff(result, vcl_result2)) << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
 
   // --------------------------------------------------------------------------
   return retval;
@@ -26,6 +26,10 @@
 //
 #include <iostream>
 #include <iomanip>
+#include <list>
+#include <vector>
+#include <string>
+#include <map>
 
 //
 // *** Boost
@@ -41,13 +45,18 @@
 #define VIENNACL_WITH_UBLAS 1
 #include "viennacl/vector.hpp"
 #include "viennacl/matrix.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
 #include "viennacl/vector_proxy.hpp"
 #include "viennacl/linalg/inner_prod.hpp"
 #include "viennacl/linalg/norm_1.hpp"
 #include "viennacl/linalg/norm_2.hpp"
 #include "viennacl/linalg/norm_inf.hpp"
+#include "viennacl/linalg/maxmin.hpp"
 
 #include "viennacl/scheduler/execute.hpp"
+#include "viennacl/scheduler/execute_fused.hpp"
+#include "viennacl/scheduler/graph.hpp"
 #include "viennacl/scheduler/io.hpp"
 
 #include "Random.hpp"
@@ -565,6 +574,447 @@ int test(Epsilon const& epsilon,
 }
 
 
+//
+// -------------------------------------------------------------
+//
+/** @brief Executes the statements fused as well as one after another on the same initial values and compares all vectors and scalars. Also checks the number of steps of the fused program. */
+template<typename NumericT>
+int check_fused(std::string const & name, std::list<viennacl::scheduler::statement> const & statements,
+                std::vector<viennacl::vector_base<NumericT> *> const & vectors, std::vector<viennacl::scalar<NumericT> *> const & scalars,
+                std::size_t expected_steps, double epsilon)
+{
+  typedef std::list<viennacl::scheduler::statement>::const_iterator  iterator_type;
+
+  std::cout << "Testing fused execution: " << name << "..." << std::endl;
+
+  // initial values:
+  std::vector<ublas::vector<NumericT> > initial_vectors(vectors.size());
+  std::vector<NumericT>                 initial_scalars(scalars.size());
+  for (std::size_t i=0; i<vectors.size(); ++i)
+  {
+    initial_vectors[i].resize(vectors[i]->size());
+    viennacl::copy(*vectors[i], initial_vectors[i]);
+  }
+  for (std::size_t i=0; i<scalars.size(); ++i)
+    initial_scalars[i] = *scalars[i];
+
+  // reference: statements one after another
+  for (iterator_type it = statements.begin(); it != statements.end(); ++it)
+    viennacl::scheduler::execute(*it);
+
+  std::vector<ublas::vector<NumericT> > sequential_vectors(vectors.size());
+  std::vector<NumericT>                 sequential_scalars(scalars.size());
+  for (std::size_t i=0; i<vectors.size(); ++i)
+  {
+    sequential_vectors[i].resize(vectors[i]->size());
+    viennacl::copy(*vectors[i], sequential_vectors[i]);
+    viennacl::copy(initial_vectors[i], *vectors[i]);
+  }
+  for (std::size_t i=0; i<scalars.size(); ++i)
+  {
+    sequential_scalars[i] = *scalars[i];
+    *scalars[i] = initial_scalars[i];
+  }
+
+  // fused:
+  viennacl::scheduler::detail::fused_program program;
+  for (iterator_type it = statements.begin(); it != statements.end(); ++it)
+    program.push_back(*it);
+  if (program.num_steps() != expected_steps)
+  {
+    std::cout << "# Error! Number of steps: " << program.num_steps() << " instead of " << expected_steps << std::endl;
+    return EXIT_FAILURE;
+  }
+  program.run();
+
+  for (std::size_t i=0; i<vectors.size(); ++i)
+    if (check(sequential_vectors[i], *vectors[i], epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  for (std::size_t i=0; i<scalars.size(); ++i)
+    if (check(sequential_scalars[i], *scalars[i], epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
+  // execute() for a statements_container gives the same results:
+  for (std::size_t i=0; i<vectors.size(); ++i)
+    viennacl::copy(initial_vectors[i], *vectors[i]);
+  for (std::size_t i=0; i<scalars.size(); ++i)
+    *scalars[i] = initial_scalars[i];
+  viennacl::scheduler::execute(viennacl::device_specific::statements_container(statements, viennacl::device_specific::statements_container::SEQUENTIAL));
+  for (std::size_t i=0; i<vectors.size(); ++i)
+    if (check(sequential_vectors[i], *vectors[i], epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  for (std::size_t i=0; i<scalars.size(); ++i)
+    if (check(sequential_scalars[i], *scalars[i], epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
+
+
+/** @brief Tests the fused execution of groups of statements on vectors of the given size */
+template<typename NumericT>
+int test_fused(double epsilon, std::size_t size)
+{
+  typedef viennacl::scheduler::statement   statement;
+  typedef viennacl::vector_base<NumericT>  vector_base;
+
+  std::cout << "Running fused tests for vectors of size " << size << std::endl;
+
+  ublas::vector<NumericT> host_x(size), host_p(size), host_r(size), host_q(size), host_long(3 * size + 2);
+  for (std::size_t i=0; i<size; ++i)
+  {
+    host_x[i] = NumericT(1.0) + random<NumericT>();
+    host_p[i] = NumericT(1.0) + random<NumericT>();
+    host_r[i] = random<NumericT>() - NumericT(0.5);
+    host_q[i] = NumericT(1.0) + random<NumericT>();
+  }
+  for (std::size_t i=0; i<host_long.size(); ++i)
+    host_long[i] = NumericT(1.0) + random<NumericT>();
+
+  viennacl::vector<NumericT> x(size), p(size), r(size), q(size), y(size), long_vec(3 * size + 2);
+  viennacl::copy(host_x, x);
+  viennacl::copy(host_p, p);
+  viennacl::copy(host_r, r);
+  viennacl::copy(host_q, q);
+  viennacl::copy(host_long, long_vec);
+  y = viennacl::scalar_vector<NumericT>(size, NumericT(0));
+
+  viennacl::scalar<NumericT> alpha(NumericT(0.75)), rr(0), nrm1(0), nrm2(0), nrm_inf(0), max_r(0), min_r(0), dot(0);
+
+  std::vector<vector_base *> vectors;
+  vectors.push_back(&x); vectors.push_back(&p); vectors.push_back(&r); vectors.push_back(&q); vectors.push_back(&y); vectors.push_back(&long_vec);
+
+  std::vector<viennacl::scalar<NumericT> *> scalars;
+  scalars.push_back(&alpha); scalars.push_back(&rr); scalars.push_back(&nrm1); scalars.push_back(&nrm2);
+  scalars.push_back(&nrm_inf); scalars.push_back(&max_r); scalars.push_back(&min_r); scalars.push_back(&dot);
+
+  // CG update followed by reductions of the new residual, a single group:
+  {
+    std::list<statement> statements;
+    statements.push_back(statement(x, viennacl::op_inplace_add(), alpha * p));
+    statements.push_back(statement(r, viennacl::op_inplace_sub(), alpha * q));
+    statements.push_back(statement(rr,      viennacl::op_assign(), viennacl::linalg::inner_prod(r, r)));
+    statements.push_back(statement(nrm1,    viennacl::op_assign(), viennacl::linalg::norm_1(r)));
+    statements.push_back(statement(nrm2,    viennacl::op_assign(), viennacl::linalg::norm_2(r)));
+    statements.push_back(statement(nrm_inf, viennacl::op_assign(), viennacl::linalg::norm_inf(r)));
+    statements.push_back(statement(max_r,   viennacl::op_assign(), viennacl::linalg::max(r)));
+    statements.push_back(statement(min_r,   viennacl::op_assign(), viennacl::linalg::min(r)));
+    statements.push_back(statement(dot,     viennacl::op_assign(), viennacl::linalg::inner_prod(x + r, p - q)));
+    if (check_fused<NumericT>("CG update and reductions", statements, vectors, scalars, 1, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  // a scalar reduced and then read by the next statements starts a new group, which reads the new value:
+  {
+    std::list<statement> statements;
+    statements.push_back(statement(r,     viennacl::op_inplace_sub(), alpha * q));
+    statements.push_back(statement(rr,    viennacl::op_assign(), viennacl::linalg::inner_prod(r, r)));
+    statements.push_back(statement(alpha, viennacl::op_assign(), viennacl::linalg::norm_inf(r)));
+    statements.push_back(statement(p,     viennacl::op_assign(), r + rr * p));
+    statements.push_back(statement(x,     viennacl::op_inplace_add(), alpha * p));
+    if (check_fused<NumericT>("reduced scalar read in the same container", statements, vectors, scalars, 2, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  // reading a written buffer at a different offset must split groups, otherwise entries at the block boundaries are read before (or after) they are written:
+  {
+    viennacl::vector_range<viennacl::vector<NumericT> > head(long_vec, viennacl::range(0, size));
+    viennacl::vector_range<viennacl::vector<NumericT> > shifted(long_vec, viennacl::range(1, size + 1));
+
+    std::list<statement> statements;
+    statements.push_back(statement(head, viennacl::op_assign(), NumericT(2) * head + p));   // read-after-write of 'shifted'
+    statements.push_back(statement(y,    viennacl::op_assign(), shifted - q));
+    statements.push_back(statement(shifted, viennacl::op_inplace_add(), x));            // write-after-read of 'head'
+    statements.push_back(statement(y,    viennacl::op_inplace_add(), head));
+    if (check_fused<NumericT>("ranges of a written buffer", statements, vectors, scalars, 3, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  // the same for slices, whereas ranges and slices accessing the same entries of a buffer are fused:
+  {
+    viennacl::vector_slice<viennacl::vector<NumericT> > even(long_vec, viennacl::slice(0, 2, size));
+    viennacl::vector_slice<viennacl::vector<NumericT> > odd(long_vec,  viennacl::slice(1, 2, size));
+    viennacl::vector_slice<viennacl::vector<NumericT> > every_third(long_vec, viennacl::slice(2, 3, size));
+
+    std::list<statement> statements;
+    statements.push_back(statement(even,        viennacl::op_assign(), even + alpha * p));
+    statements.push_back(statement(y,           viennacl::op_assign(), viennacl::linalg::element_prod(even, q)));
+    statements.push_back(statement(odd,         viennacl::op_assign(), viennacl::linalg::element_div(y, even)));
+    statements.push_back(statement(every_third, viennacl::op_inplace_sub(), x));
+    statements.push_back(statement(dot,         viennacl::op_assign(), viennacl::linalg::inner_prod(every_third, q)));
+    if (check_fused<NumericT>("strided operands", statements, vectors, scalars, 3, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+/** @brief Tests the repeated execution of recorded operations: re-reading of scalars, capturing of host scalars, rebinding of objects, and vectors changing their buffer or size between executions */
+template<typename NumericT>
+int test_graph(double epsilon, std::size_t size)
+{
+  std::cout << "Testing operation_graph for vectors of size " << size << "..." << std::endl;
+
+  ublas::vector<NumericT> host_x(size), host_p(size), host_r(size), host_q(size);
+  for (std::size_t i=0; i<size; ++i)
+  {
+    host_x[i] = NumericT(1.0) + random<NumericT>();
+    host_p[i] = NumericT(1.0) + random<NumericT>();
+    host_r[i] = random<NumericT>() - NumericT(0.5);
+    host_q[i] = NumericT(1.0) + random<NumericT>();
+  }
+
+  viennacl::vector<NumericT> x(size), p(size), r(size), q(size), p2(size);
+  viennacl::copy(host_x, x);
+  viennacl::copy(host_p, p);
+  viennacl::copy(host_r, r);
+  viennacl::copy(host_q, q);
+  viennacl::copy(host_q, p2);
+
+  viennacl::scalar<NumericT> alpha(0), rr(0);
+  NumericT beta = NumericT(0.5);
+
+  viennacl::scheduler::operation_graph update;
+  update.record(x,  viennacl::op_inplace_add(), alpha * p);
+  update.record(r,  viennacl::op_inplace_sub(), alpha * q);
+  update.record(rr, viennacl::op_assign(),      viennacl::linalg::inner_prod(r, r));
+  update.record(p,  viennacl::op_assign(),      r + beta * p);
+  if (update.size() != 4)
+  {
+    std::cout << "# Error! Number of recorded operations: " << update.size() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the host scalar 'beta' is captured at recording, the device scalar 'alpha' is read at each execution:
+  beta = NumericT(100);
+  NumericT host_beta = NumericT(0.5);
+  for (std::size_t iter = 0; iter < 3; ++iter)
+  {
+    NumericT host_alpha = NumericT(0.1) * NumericT(iter + 1);
+    alpha = host_alpha;
+    update.execute();
+
+    host_x += host_alpha * host_p;
+    host_r -= host_alpha * host_q;
+    NumericT host_rr = ublas::inner_prod(host_r, host_r);
+    host_p = host_r + host_beta * host_p;
+
+    if (   check(host_x, x, epsilon) != EXIT_SUCCESS || check(host_r, r, epsilon) != EXIT_SUCCESS
+        || check(host_p, p, epsilon) != EXIT_SUCCESS || check(host_rr, rr, epsilon) != EXIT_SUCCESS)
+    {
+      std::cout << "# Error at replay " << iter << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // rebind 'p' to 'p2': replaces the operands in the first, second and fourth operation (twice)
+  ublas::vector<NumericT> host_p2(host_q);
+  if (update.rebind(static_cast<viennacl::vector_base<NumericT> const &>(p), static_cast<viennacl::vector_base<NumericT> const &>(p2)) != 3)
+  {
+    std::cout << "# Error! Wrong number of rebound operands" << std::endl;
+    return EXIT_FAILURE;
+  }
+  alpha = NumericT(0.25);
+  update.execute();
+  host_x += NumericT(0.25) * host_p2;
+  host_r -= NumericT(0.25) * host_q;
+  host_p2 = host_r + host_beta * host_p2;
+  if (   check(host_x, x, epsilon) != EXIT_SUCCESS || check(host_r, r, epsilon) != EXIT_SUCCESS
+      || check(host_p2, p2, epsilon) != EXIT_SUCCESS || check(host_p, p, epsilon) != EXIT_SUCCESS)
+  {
+    std::cout << "# Error after rebind()" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // rebinding scalars:
+  viennacl::scalar<NumericT> alpha2(NumericT(-0.5));
+  if (update.rebind(alpha, alpha2) != 2)
+  {
+    std::cout << "# Error! Wrong number of rebound scalars" << std::endl;
+    return EXIT_FAILURE;
+  }
+  update.execute();
+  host_x -= NumericT(0.5) * host_p2;
+  host_r += NumericT(0.5) * host_q;
+  host_p2 = host_r + host_beta * host_p2;
+  if (check(host_x, x, epsilon) != EXIT_SUCCESS || check(host_r, r, epsilon) != EXIT_SUCCESS || check(host_p2, p2, epsilon) != EXIT_SUCCESS)
+  {
+    std::cout << "# Error after rebinding a scalar" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // swapping the buffers of two vectors after compilation:
+  viennacl::scheduler::operation_graph copy_update;
+  copy_update.record(x, viennacl::op_assign(), NumericT(2) * q);
+  copy_update.execute();
+  host_x = NumericT(2) * host_q;
+  viennacl::fast_swap(q, r);   // exchanges the buffers, q now holds the entries of r and vice versa
+  std::swap(host_q, host_r);
+  copy_update.execute();
+  host_x = NumericT(2) * host_q;
+  if (check(host_x, x, epsilon) != EXIT_SUCCESS || check(host_q, q, epsilon) != EXIT_SUCCESS || check(host_r, r, epsilon) != EXIT_SUCCESS)
+  {
+    std::cout << "# Error after swapping vectors" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // resizing the vectors after compilation:
+  std::size_t new_size = size + 300;
+  x.resize(new_size, false);
+  q.resize(new_size, false);
+  host_q.resize(new_size, false);
+  for (std::size_t i=0; i<new_size; ++i)
+    host_q[i] = NumericT(1.0) + random<NumericT>();
+  viennacl::copy(host_q, q);
+  copy_update.execute();
+  host_x = NumericT(2) * host_q;
+  if (check(host_x, x, epsilon) != EXIT_SUCCESS)
+  {
+    std::cout << "# Error after resizing vectors" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+/** @brief Tests the evaluation of statements with subexpressions which are not elementwise (e.g. sparse matrix-vector products), common subexpressions, and the reuse of temporaries */
+template<typename NumericT>
+int test_lowering(double epsilon, std::size_t size)
+{
+  typedef viennacl::scheduler::statement   statement;
+  typedef viennacl::vector_base<NumericT>  vector_base;
+
+  std::cout << "Running tests of compound statements for vectors of size " << size << std::endl;
+
+  // tridiagonal matrix:
+  std::vector<std::map<unsigned int, NumericT> > host_A(size);
+  for (std::size_t i=0; i<size; ++i)
+  {
+    host_A[i][static_cast<unsigned int>(i)] = NumericT(4) + NumericT(i % 5) / NumericT(5);
+    if (i > 0)        host_A[i][static_cast<unsigned int>(i - 1)] = NumericT(-1);
+    if (i + 1 < size) host_A[i][static_cast<unsigned int>(i + 1)] = NumericT(-0.5);
+  }
+  viennacl::compressed_matrix<NumericT> A(size, size);
+  viennacl::copy(host_A, A);
+
+  ublas::vector<NumericT> host_y(size), host_z(size), host_u(size), host_v(size);
+  for (std::size_t i=0; i<size; ++i)
+  {
+    host_y[i] = NumericT(1.0) + random<NumericT>();
+    host_z[i] = NumericT(1.0) + random<NumericT>();
+    host_u[i] = random<NumericT>() - NumericT(0.5);
+    host_v[i] = NumericT(1.0) + random<NumericT>();
+  }
+
+  viennacl::vector<NumericT> x(size), w(size), y(size), z(size), u(size), v(size);
+  viennacl::copy(host_y, y);
+  viennacl::copy(host_z, z);
+  viennacl::copy(host_u, u);
+  viennacl::copy(host_v, v);
+  x = viennacl::scalar_vector<NumericT>(size, NumericT(0));
+  w = viennacl::scalar_vector<NumericT>(size, NumericT(0));
+
+  NumericT alpha = NumericT(0.75);
+  viennacl::scalar<NumericT> beta(NumericT(-1.25)), s(0);
+
+  std::vector<vector_base *> vectors;
+  vectors.push_back(&x); vectors.push_back(&w); vectors.push_back(&y); vectors.push_back(&z); vectors.push_back(&u); vectors.push_back(&v);
+  std::vector<viennacl::scalar<NumericT> *> scalars;
+  scalars.push_back(&beta); scalars.push_back(&s);
+
+  // host reference for x = prod(A, y) + alpha * z - element_prod(u, v):
+  ublas::vector<NumericT> host_Ay(size);
+  for (std::size_t i=0; i<size; ++i)
+  {
+    host_Ay[i] = 0;
+    for (typename std::map<unsigned int, NumericT>::const_iterator it = host_A[i].begin(); it != host_A[i].end(); ++it)
+      host_Ay[i] += it->second * host_y[it->first];
+  }
+  ublas::vector<NumericT> host_x = host_Ay + alpha * host_z - ublas::element_prod(host_u, host_v);
+
+  // the product is computed into a temporary, the remainder is a single fused loop:
+  {
+    std::list<statement> statements;
+    statements.push_back(statement(x, viennacl::op_assign(), viennacl::linalg::prod(A, y) + alpha * z - viennacl::linalg::element_prod(u, v)));
+    if (check_fused<NumericT>("x = prod(A, y) + alpha * z - element_prod(u, v)", statements, vectors, scalars, 2, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    if (check(host_x, x, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  // identical subexpressions are computed once: one product, one fused loop
+  {
+    std::list<statement> statements;
+    statements.push_back(statement(x, viennacl::op_assign(), viennacl::linalg::prod(A, y) + beta * viennacl::linalg::prod(A, y)));
+    if (check_fused<NumericT>("x = prod(A, y) + beta * prod(A, y)", statements, vectors, scalars, 2, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    ublas::vector<NumericT> host_result = (NumericT(1) + NumericT(beta)) * host_Ay;
+    if (check(host_result, x, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  // reductions within elementwise expressions, computed once and read by the next group:
+  {
+    std::list<statement> statements;
+    statements.push_back(statement(x, viennacl::op_assign(), viennacl::linalg::inner_prod(u, v) * z + viennacl::linalg::inner_prod(u, v) * y));
+    statements.push_back(statement(s, viennacl::op_assign(), viennacl::linalg::norm_2(x - viennacl::linalg::element_prod(u, u))));
+    if (check_fused<NumericT>("x = inner_prod(u, v) * z + inner_prod(u, v) * y", statements, vectors, scalars, 2, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  // temporaries are reused by subsequent statements:
+  {
+    viennacl::scheduler::detail::fused_program program;
+    program.push_back(statement(x, viennacl::op_assign(),      viennacl::linalg::prod(A, y) - z));
+    program.push_back(statement(w, viennacl::op_assign(),      viennacl::linalg::prod(A, z) + viennacl::linalg::prod(A, u)));
+    program.push_back(statement(x, viennacl::op_inplace_add(), viennacl::linalg::prod(A, v) * alpha));
+    if (program.num_temporaries() != 2)
+    {
+      std::cout << "# Error! Number of temporaries: " << program.num_temporaries() << " instead of 2" << std::endl;
+      return EXIT_FAILURE;
+    }
+    program.run();
+    program.run();   // repeated runs reuse the temporaries as well
+
+    ublas::vector<NumericT> host_Az(size), host_Au(size), host_Av(size);
+    for (std::size_t i=0; i<size; ++i)
+    {
+      host_Az[i] = host_Au[i] = host_Av[i] = 0;
+      for (typename std::map<unsigned int, NumericT>::const_iterator it = host_A[i].begin(); it != host_A[i].end(); ++it)
+      {
+        host_Az[i] += it->second * host_z[it->first];
+        host_Au[i] += it->second * host_u[it->first];
+        host_Av[i] += it->second * host_v[it->first];
+      }
+    }
+    ublas::vector<NumericT> host_result_x = host_Ay - host_z + alpha * host_Av;
+    ublas::vector<NumericT> host_result_w = host_Az + host_Au;
+    if (check(host_result_x, x, epsilon) != EXIT_SUCCESS || check(host_result_w, w, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  // replays of a recorded compound statement pick up new values of the operands:
+  {
+    viennacl::scheduler::operation_graph graph;
+    graph.record(x, viennacl::op_assign(), viennacl::linalg::prod(A, y) + alpha * z - viennacl::linalg::element_prod(u, v));
+    graph.execute();
+    if (check(host_x, x, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
+    host_y *= NumericT(2);
+    viennacl::copy(host_y, y);
+    graph.execute();
+    host_x = NumericT(2) * host_Ay + alpha * host_z - ublas::element_prod(host_u, host_v);
+    if (check(host_x, x, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
 template< typename NumericT, typename Epsilon >
 int test(Epsilon const& epsilon)
 {
@@ -712,6 +1162,30 @@ int test(Epsilon const& epsilon)
   if (retval != EXIT_SUCCESS)
     return EXIT_FAILURE;
 
+  //
+  // Fused execution of groups of statements, below and above the size for multithreaded execution:
+  //
+  if (test_fused<NumericT>(epsilon, 1000) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_fused<NumericT>(epsilon, 3 * VIENNACL_OPENMP_VECTOR_MIN_SIZE + 17) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  //
+  // Recorded operations:
+  //
+  if (test_graph<NumericT>(epsilon, 1000) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_graph<NumericT>(epsilon, 3 * VIENNACL_OPENMP_VECTOR_MIN_SIZE + 17) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  //
+  // Statements with subexpressions which are not elementwise:
+  //
+  if (test_lowering<NumericT>(epsilon, 1000) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_lowering<NumericT>(epsilon, 3 * VIENNACL_OPENMP_VECTOR_MIN_SIZE + 17) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
   return EXIT_SUCCESS;
 }
 
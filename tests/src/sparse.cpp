@@ -29,6 +29,10 @@
 // *** System
 //
 #include <iostream>
+#include <vector>
+#include <string>
+#include <limits>
+#include <cmath>
 
 //
 // *** Boost
@@ -224,6 +228,173 @@ int strided_matrix_vector_product_test(Epsilon epsilon,
 }
 
 
+/** @brief Returns the largest entrywise error of a ViennaCL vector relative to the largest reference entry. NaN entries count as failure. */
+template<typename NumericT, typename VCLVectorT>
+NumericT max_relative_error(std::vector<double> const & reference, VCLVectorT const & vcl_vec)
+{
+  std::vector<NumericT> host_vec(vcl_vec.size());
+  viennacl::copy(vcl_vec.begin(), vcl_vec.end(), host_vec.begin());
+
+  double max_ref = 0;
+  for (std::size_t i=0; i<reference.size(); ++i)
+    max_ref = std::max(max_ref, std::fabs(reference[i]));
+
+  double error = 0;
+  for (std::size_t i=0; i<reference.size(); ++i)
+  {
+    double current_error = std::fabs(double(host_vec[i]) - reference[i]) / max_ref;
+    if (current_error != current_error)   // NaN
+      return std::numeric_limits<NumericT>::infinity();
+    error = std::max(error, current_error);
+  }
+  return NumericT(error);
+}
+
+
+/** @brief Tests prod_axpby() with diagonal scaling, the fused inner product, strided vectors and aliasing of 'y' and 'w' with the result vector */
+template<typename NumericT, typename VCL_MatrixT, typename Epsilon>
+int prod_axpby_test(Epsilon epsilon, std::string const & name,
+                    ublas::compressed_matrix<NumericT> const & ublas_matrix, ublas::vector<NumericT> const & rhs,
+                    VCL_MatrixT const & vcl_matrix)
+{
+  int retval = EXIT_SUCCESS;
+  std::size_t n = ublas_matrix.size1();
+  NumericT alpha = NumericT(2.786);
+  NumericT beta  = NumericT(1.432);
+
+  // reference data, products evaluated in double precision:
+  ublas::vector<NumericT> Ax = ublas::prod(ublas_matrix, rhs);
+  std::vector<NumericT> host_y(n), host_diag(n), host_w(n);
+  for (std::size_t i=0; i<n; ++i)
+  {
+    host_y[i]    = NumericT(1) - NumericT(i % 5) / NumericT(4);
+    host_diag[i] = NumericT(0.5) + NumericT(i % 7) / NumericT(7);
+    host_w[i]    = NumericT(i % 3) - NumericT(1);
+  }
+
+  viennacl::vector<NumericT> vcl_rhs(n), vcl_y(n), vcl_diag(n), vcl_w(n), vcl_result(n);
+  viennacl::copy(rhs.begin(), rhs.end(), vcl_rhs.begin());
+  viennacl::copy(host_y, vcl_y);
+  viennacl::copy(host_diag, vcl_diag);
+  viennacl::copy(host_w, vcl_w);
+
+  viennacl::vector_base<NumericT> const * no_diag = NULL;
+  std::vector<double> ref(n);
+  double ref_dot = 0, ref_norm = 0;
+
+  // result = diag .* (alpha * A * x + beta * y), dot = <result, w>:
+  for (std::size_t i=0; i<n; ++i)
+  {
+    ref[i] = double(host_diag[i]) * (double(alpha) * double(Ax[i]) + double(beta) * double(host_y[i]));
+    ref_dot  += ref[i] * double(host_w[i]);
+    ref_norm += std::fabs(ref[i] * double(host_w[i]));
+  }
+  vcl_result = viennacl::scalar_vector<NumericT>(n, NumericT(7));
+  NumericT dot = viennacl::linalg::prod_axpby(vcl_matrix, vcl_rhs, alpha, vcl_y, beta, vcl_result, &vcl_diag, &vcl_w);
+  if ( max_relative_error<NumericT>(ref, vcl_result) > epsilon || !(std::fabs(double(dot) - ref_dot) <= epsilon * ref_norm) )
+  {
+    std::cout << "# Error at operation: prod_axpby (" << name << ") with diagonal and inner product" << std::endl;
+    std::cout << "  diff: " << max_relative_error<NumericT>(ref, vcl_result) << ", dot: " << dot << " vs. " << ref_dot << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  // diagonal only, no inner product:
+  for (std::size_t i=0; i<n; ++i)
+    ref[i] = double(host_diag[i]) * (double(alpha) * double(Ax[i]) + double(beta) * double(host_y[i]));
+  dot = viennacl::linalg::prod_axpby(vcl_matrix, vcl_rhs, alpha, vcl_y, beta, vcl_result, &vcl_diag);
+  if ( max_relative_error<NumericT>(ref, vcl_result) > epsilon || dot != NumericT(0) )
+  {
+    std::cout << "# Error at operation: prod_axpby (" << name << ") with diagonal" << std::endl;
+    std::cout << "  diff: " << max_relative_error<NumericT>(ref, vcl_result) << ", dot: " << dot << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  // inner product only, y aliasing the result: result = alpha * A * x + beta * result
+  std::vector<double> old_result(ref);
+  ref_dot = 0; ref_norm = 0;
+  for (std::size_t i=0; i<n; ++i)
+  {
+    ref[i] = double(alpha) * double(Ax[i]) + double(beta) * old_result[i];
+    ref_dot  += ref[i] * double(host_w[i]);
+    ref_norm += std::fabs(ref[i] * double(host_w[i]));
+  }
+  dot = viennacl::linalg::prod_axpby(vcl_matrix, vcl_rhs, alpha, vcl_result, beta, vcl_result, no_diag, &vcl_w);
+  if ( max_relative_error<NumericT>(ref, vcl_result) > epsilon || !(std::fabs(double(dot) - ref_dot) <= epsilon * ref_norm) )
+  {
+    std::cout << "# Error at operation: prod_axpby (" << name << ") with inner product and y == result" << std::endl;
+    std::cout << "  diff: " << max_relative_error<NumericT>(ref, vcl_result) << ", dot: " << dot << " vs. " << ref_dot << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  // prod_impl() with scaling factors updates the result in place:
+  old_result = ref;
+  for (std::size_t i=0; i<n; ++i)
+    ref[i] = double(alpha) * double(Ax[i]) + double(beta) * old_result[i];
+  viennacl::linalg::prod_impl(vcl_matrix, vcl_rhs, vcl_result, alpha, beta);
+  if ( max_relative_error<NumericT>(ref, vcl_result) > epsilon )
+  {
+    std::cout << "# Error at operation: prod_impl (" << name << ") with alpha and beta" << std::endl;
+    std::cout << "  diff: " << max_relative_error<NumericT>(ref, vcl_result) << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  // beta == 0: y must not be read, so NaNs in the aliased result must not propagate:
+  vcl_result = viennacl::scalar_vector<NumericT>(n, std::numeric_limits<NumericT>::quiet_NaN());
+  for (std::size_t i=0; i<n; ++i)
+    ref[i] = double(host_diag[i]) * double(alpha) * double(Ax[i]);
+  viennacl::linalg::prod_axpby(vcl_matrix, vcl_rhs, alpha, vcl_result, NumericT(0), vcl_result, &vcl_diag);
+  if ( max_relative_error<NumericT>(ref, vcl_result) > epsilon )
+  {
+    std::cout << "# Error at operation: prod_axpby (" << name << ") with beta == 0 and y == result" << std::endl;
+    std::cout << "  diff: " << max_relative_error<NumericT>(ref, vcl_result) << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  // w aliasing the result: inner product of the new result with itself
+  ref_dot = 0;
+  for (std::size_t i=0; i<n; ++i)
+  {
+    ref[i] = double(alpha) * double(Ax[i]) + double(beta) * double(host_y[i]);
+    ref_dot += ref[i] * ref[i];
+  }
+  dot = viennacl::linalg::prod_axpby(vcl_matrix, vcl_rhs, alpha, vcl_y, beta, vcl_result, no_diag, &vcl_result);
+  if ( max_relative_error<NumericT>(ref, vcl_result) > epsilon || !(std::fabs(double(dot) - ref_dot) <= epsilon * ref_dot) )
+  {
+    std::cout << "# Error at operation: prod_axpby (" << name << ") with w == result" << std::endl;
+    std::cout << "  diff: " << max_relative_error<NumericT>(ref, vcl_result) << ", dot: " << dot << " vs. " << ref_dot << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  // strided result, y and diag, contiguous w:
+  viennacl::vector<NumericT> vcl_strided(3 * n + 1), vcl_strided_y(2 * n), vcl_strided_diag(2 * n + 3);
+  vcl_strided = viennacl::scalar_vector<NumericT>(3 * n + 1, NumericT(7));
+  viennacl::slice s_result(1, 3, n), s_y(0, 2, n), s_diag(3, 2, n);
+  viennacl::project(vcl_strided_y, s_y)       = vcl_y;
+  viennacl::project(vcl_strided_diag, s_diag) = vcl_diag;
+  viennacl::vector_slice<viennacl::vector<NumericT> > result_slice(vcl_strided, s_result);
+  ref_dot = 0; ref_norm = 0;
+  for (std::size_t i=0; i<n; ++i)
+  {
+    ref[i] = double(host_diag[i]) * (double(alpha) * double(Ax[i]) + double(beta) * double(host_y[i]));
+    ref_dot  += ref[i] * double(host_w[i]);
+    ref_norm += std::fabs(ref[i] * double(host_w[i]));
+  }
+  viennacl::vector_slice<viennacl::vector<NumericT> > y_slice(vcl_strided_y, s_y);
+  viennacl::vector_slice<viennacl::vector<NumericT> > diag_slice(vcl_strided_diag, s_diag);
+  dot = viennacl::linalg::prod_axpby(vcl_matrix, vcl_rhs, alpha, y_slice, beta, result_slice, &diag_slice, &vcl_w);
+  vcl_result = result_slice;
+  NumericT gap_entry = vcl_strided(3 * n);
+  if ( max_relative_error<NumericT>(ref, vcl_result) > epsilon || !(std::fabs(double(dot) - ref_dot) <= epsilon * ref_norm) || gap_entry != NumericT(7) )
+  {
+    std::cout << "# Error at operation: prod_axpby (" << name << ") with strided vectors" << std::endl;
+    std::cout << "  diff: " << max_relative_error<NumericT>(ref, vcl_result) << ", dot: " << dot << " vs. " << ref_dot << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  return retval;
+}
+
+
 template< typename NumericT, typename VCL_MATRIX, typename Epsilon >
 int resize_test(Epsilon const& epsilon)
 {
@@ -850,6 +1021,22 @@ int test(Epsilon const& epsilon)
     retval = EXIT_FAILURE;
   }
 
+  std::cout << "Testing prod_axpby: compressed_matrix" << std::endl;
+  if (prod_axpby_test<NumericT>(epsilon, "compressed_matrix", ublas_matrix, rhs, vcl_compressed_matrix) != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
+  std::cout << "Testing prod_axpby: coordinate_matrix" << std::endl;
+  if (prod_axpby_test<NumericT>(epsilon, "coordinate_matrix", ublas_matrix, rhs, vcl_coordinate_matrix) != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
+  std::cout << "Testing prod_axpby: ell_matrix" << std::endl;
+  if (prod_axpby_test<NumericT>(epsilon, "ell_matrix", ublas_matrix, rhs, vcl_ell_matrix) != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
+  std::cout << "Testing prod_axpby: sliced_ell_matrix" << std::endl;
+  if (prod_axpby_test<NumericT>(epsilon, "sliced_ell_matrix", ublas_matrix, rhs, vcl_sliced_ell_matrix) != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
+  std::cout << "Testing prod_axpby: hyb_matrix" << std::endl;
+  if (prod_axpby_test<NumericT>(epsilon, "hyb_matrix", ublas_matrix, rhs, vcl_hyb_matrix) != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
+
   ////////////// Test of .clear() ////////////////
   ublas_matrix.clear();
 
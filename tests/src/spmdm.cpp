@@ -24,6 +24,7 @@
 // include necessary system headers
 //
 #include <iostream>
+#include <string>
 #include <cmath>
 
 //
@@ -56,7 +57,9 @@
 #include "viennacl/compressed_matrix.hpp"
 #include "viennacl/coordinate_matrix.hpp"
 #include "viennacl/ell_matrix.hpp"
+#include "viennacl/sliced_ell_matrix.hpp"
 #include "viennacl/hyb_matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
 #include "viennacl/linalg/prod.hpp"       //generic matrix-vector product
 #include "viennacl/linalg/norm_2.hpp"     //generic l2-norm for vectors
 #include "viennacl/io/matrix_market.hpp"
@@ -91,6 +94,149 @@ int check_matrices(const ublas::matrix< ScalarType >& ref_mat, const ublas::matr
   return EXIT_SUCCESS;
 }
 
+/** @brief Compares the block of a ViennaCL matrix starting at (row_start, col_start) with stride (row_stride, col_stride) with the reference. All other entries must equal 'fill'. */
+template<typename NumericT, typename LayoutT>
+int check_block(const ublas::matrix<NumericT> & ref_mat, viennacl::matrix<NumericT, LayoutT> const & big,
+                std::size_t row_start, std::size_t row_stride, std::size_t col_start, std::size_t col_stride,
+                NumericT fill, NumericT eps)
+{
+  ublas::matrix<NumericT> big_host(big.size1(), big.size2());
+  viennacl::copy(big, big_host);
+
+  ublas::matrix<NumericT> block(ref_mat.size1(), ref_mat.size2());
+  for (std::size_t i = 0; i < big_host.size1(); ++i)
+    for (std::size_t j = 0; j < big_host.size2(); ++j)
+    {
+      bool in_block =    i >= row_start && (i - row_start) % row_stride == 0 && (i - row_start) / row_stride < ref_mat.size1()
+                      && j >= col_start && (j - col_start) % col_stride == 0 && (j - col_start) / col_stride < ref_mat.size2();
+      if (in_block)
+        block((i - row_start) / row_stride, (j - col_start) / col_stride) = big_host(i, j);
+      else if (big_host(i, j) < fill || big_host(i, j) > fill)
+      {
+        std::cout << "ERROR: Entry (" << i << ", " << j << ") outside of the result block was modified" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+  for (std::size_t i = 0; i < ref_mat.size1(); ++i)
+    for (std::size_t j = 0; j < ref_mat.size2(); ++j)
+    {
+      NumericT rel_error = std::abs(ref_mat(i,j) - block(i,j)) / std::max(std::abs(ref_mat(i,j)), std::abs(block(i,j)));
+      if ( rel_error > eps || block(i,j) != block(i,j) ) {
+        std::cout << "ERROR: Verification failed at (" << i <<", "<< j << "): "
+                  << " Expected: " << ref_mat(i,j) << ", got: " << block(i,j) << " (relative error: " << rel_error << ")" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
+
+/** @brief Tests the product of a sparse matrix with dense matrices of the given number of columns, including ranges (contiguous rows) and slices (strided rows) of larger matrices */
+template<typename NumericT, typename ResultLayoutT, typename FactorLayoutT, typename SparseMatrixT>
+int test_block(std::string const & name, SparseMatrixT const & lhs, ublas::compressed_matrix<NumericT> const & ublas_lhs,
+               std::size_t cols_rhs, NumericT epsilon)
+{
+  std::size_t rows = ublas_lhs.size1();
+  std::size_t inner = ublas_lhs.size2();
+  NumericT fill = NumericT(42);
+
+  ublas::matrix<NumericT> ublas_rhs(inner, cols_rhs);
+  for (std::size_t i = 0; i < inner; i++)
+    for (std::size_t j = 0; j < cols_rhs; j++)
+      ublas_rhs(i,j) = NumericT(0.5) + NumericT(0.1) * random<NumericT>();
+  ublas::matrix<NumericT> ublas_result = ublas::zero_matrix<NumericT>(rows, cols_rhs);
+  for (typename ublas::compressed_matrix<NumericT>::const_iterator1 row_it = ublas_lhs.begin1(); row_it != ublas_lhs.end1(); ++row_it)
+    for (typename ublas::compressed_matrix<NumericT>::const_iterator2 col_it = row_it.begin(); col_it != row_it.end(); ++col_it)
+      for (std::size_t j = 0; j < cols_rhs; j++)
+        ublas_result(col_it.index1(), j) += *col_it * ublas_rhs(col_it.index2(), j);
+
+  std::cout << "Testing " << name << " lhs * dense rhs with " << cols_rhs << " columns" << std::endl;
+
+  // full matrices:
+  viennacl::matrix<NumericT, FactorLayoutT> rhs(inner, cols_rhs);
+  viennacl::copy(ublas_rhs, rhs);
+  viennacl::matrix<NumericT, ResultLayoutT> result(rows, cols_rhs);
+  result = viennacl::linalg::prod(lhs, rhs);
+  if (check_block(ublas_result, result, 0, 1, 0, 1, fill, epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // ranges of larger matrices (rows contiguous, but not adjacent in memory):
+  ublas::matrix<NumericT> ublas_big_rhs = ublas::scalar_matrix<NumericT>(inner + 3, cols_rhs + 5, fill);
+  ublas::project(ublas_big_rhs, ublas::range(2, inner + 2), ublas::range(3, cols_rhs + 3)) = ublas_rhs;
+  viennacl::matrix<NumericT, FactorLayoutT> big_rhs(inner + 3, cols_rhs + 5);
+  viennacl::copy(ublas_big_rhs, big_rhs);
+
+  viennacl::matrix<NumericT, ResultLayoutT> big_result(rows + 1, cols_rhs + 4);
+  big_result = viennacl::scalar_matrix<NumericT>(rows + 1, cols_rhs + 4, fill);
+
+  viennacl::matrix_range<viennacl::matrix<NumericT, FactorLayoutT> >  rhs_range(big_rhs, viennacl::range(2, inner + 2), viennacl::range(3, cols_rhs + 3));
+  viennacl::matrix_range<viennacl::matrix<NumericT, ResultLayoutT> > result_range(big_result, viennacl::range(1, rows + 1), viennacl::range(2, cols_rhs + 2));
+  result_range = viennacl::linalg::prod(lhs, rhs_range);
+  if (check_block(ublas_result, big_result, 1, 1, 2, 1, fill, epsilon) != EXIT_SUCCESS)
+  {
+    std::cout << "ERROR: Product with matrix ranges failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // slices of larger matrices with strided rows and columns:
+  ublas::matrix<NumericT> ublas_sliced_rhs = ublas::scalar_matrix<NumericT>(2 * inner, 2 * cols_rhs + 1, fill);
+  ublas::project(ublas_sliced_rhs, ublas::slice(1, 2, inner), ublas::slice(1, 2, cols_rhs)) = ublas_rhs;
+  viennacl::matrix<NumericT, FactorLayoutT> sliced_rhs(2 * inner, 2 * cols_rhs + 1);
+  viennacl::copy(ublas_sliced_rhs, sliced_rhs);
+
+  viennacl::matrix<NumericT, ResultLayoutT> sliced_result(2 * rows, 2 * cols_rhs);
+  sliced_result = viennacl::scalar_matrix<NumericT>(2 * rows, 2 * cols_rhs, fill);
+
+  viennacl::matrix_slice<viennacl::matrix<NumericT, FactorLayoutT> >  rhs_slice(sliced_rhs, viennacl::slice(1, 2, inner), viennacl::slice(1, 2, cols_rhs));
+  viennacl::matrix_slice<viennacl::matrix<NumericT, ResultLayoutT> > result_slice(sliced_result, viennacl::slice(0, 2, rows), viennacl::slice(1, 2, cols_rhs));
+  result_slice = viennacl::linalg::prod(lhs, rhs_slice);
+  if (check_block(ublas_result, sliced_result, 0, 2, 1, 2, fill, epsilon) != EXIT_SUCCESS)
+  {
+    std::cout << "ERROR: Product with matrix slices failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/** @brief Tests the products of all sparse formats with dense matrices of several widths, covering all block widths of the kernels for row-major operands and their remainders */
+template<typename NumericT, typename ResultLayoutT, typename FactorLayoutT>
+int test_blocks(ublas::compressed_matrix<NumericT> const & ublas_lhs, NumericT epsilon)
+{
+  // leading block of the matrix keeps the test short, an empty row exercises the zero padding of the ELL formats:
+  std::size_t n = 1000;
+  ublas::compressed_matrix<NumericT> ublas_block(n, n);
+  for (typename ublas::compressed_matrix<NumericT>::const_iterator1 row_it = ublas_lhs.begin1(); row_it != ublas_lhs.end1(); ++row_it)
+    for (typename ublas::compressed_matrix<NumericT>::const_iterator2 col_it = row_it.begin(); col_it != row_it.end(); ++col_it)
+      if (col_it.index1() < n && col_it.index2() < n && col_it.index1() != 17)
+        ublas_block(col_it.index1(), col_it.index2()) = *col_it;
+
+  viennacl::compressed_matrix<NumericT>  compressed_lhs;
+  viennacl::ell_matrix<NumericT>         ell_lhs;
+  viennacl::sliced_ell_matrix<NumericT>  sliced_ell_lhs;
+  viennacl::coordinate_matrix<NumericT>  coo_lhs;
+  viennacl::hyb_matrix<NumericT>         hyb_lhs;
+  viennacl::copy(ublas_block, compressed_lhs);
+  viennacl::copy(ublas_block, ell_lhs);
+  viennacl::copy(ublas_block, sliced_ell_lhs);
+  viennacl::copy(ublas_block, coo_lhs);
+  viennacl::copy(ublas_block, hyb_lhs);
+
+  std::size_t widths[] = {1, 3, 7, 16, 31, 37};
+  for (std::size_t i = 0; i < sizeof(widths) / sizeof(widths[0]); ++i)
+  {
+    if (   test_block<NumericT, ResultLayoutT, FactorLayoutT>("compressed(CSR)", compressed_lhs, ublas_block, widths[i], epsilon) != EXIT_SUCCESS
+        || test_block<NumericT, ResultLayoutT, FactorLayoutT>("compressed(ELL)", ell_lhs,        ublas_block, widths[i], epsilon) != EXIT_SUCCESS
+        || test_block<NumericT, ResultLayoutT, FactorLayoutT>("sliced_ell",      sliced_ell_lhs, ublas_block, widths[i], epsilon) != EXIT_SUCCESS
+        || test_block<NumericT, ResultLayoutT, FactorLayoutT>("compressed(COO)", coo_lhs,        ublas_block, widths[i], epsilon) != EXIT_SUCCESS
+        || test_block<NumericT, ResultLayoutT, FactorLayoutT>("compressed(HYB)", hyb_lhs,        ublas_block, widths[i], epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
 template<typename NumericT, typename ResultLayoutT, typename FactorLayoutT>
 int test(NumericT epsilon)
 {
@@ -148,7 +294,8 @@ int test(NumericT epsilon)
 
   temp.clear();
   viennacl::copy( result, temp);
-  retVal = check_matrices(ublas_result, temp, epsilon);
+  if (check_matrices(ublas_result, temp, epsilon) != EXIT_SUCCESS)
+    retVal = EXIT_FAILURE;
 
   /******************************************************************/
   std::cout << "Testing compressed(ELL) lhs * dense rhs" << std::endl;
@@ -157,7 +304,8 @@ int test(NumericT epsilon)
 
   temp.clear();
   viennacl::copy( result, temp);
-  check_matrices(ublas_result, temp, epsilon);
+  if (check_matrices(ublas_result, temp, epsilon) != EXIT_SUCCESS)
+    retVal = EXIT_FAILURE;
 
   /******************************************************************/
 
@@ -167,7 +315,8 @@ int test(NumericT epsilon)
 
   temp.clear();
   viennacl::copy( result, temp);
-  check_matrices(ublas_result, temp, epsilon);
+  if (check_matrices(ublas_result, temp, epsilon) != EXIT_SUCCESS)
+    retVal = EXIT_FAILURE;
 
   /******************************************************************/
 
@@ -177,7 +326,8 @@ int test(NumericT epsilon)
 
   temp.clear();
   viennacl::copy( result, temp);
-  check_matrices(ublas_result, temp, epsilon);
+  if (check_matrices(ublas_result, temp, epsilon) != EXIT_SUCCESS)
+    retVal = EXIT_FAILURE;
 
   /******************************************************************/
 
@@ -191,7 +341,8 @@ int test(NumericT epsilon)
 
   temp.clear();
   viennacl::copy( result, temp);
-  retVal = check_matrices(ublas_result, temp, epsilon);
+  if (check_matrices(ublas_result, temp, epsilon) != EXIT_SUCCESS)
+    retVal = EXIT_FAILURE;
 
   /******************************************************************/
   std::cout << "Testing compressed(ELL) lhs * transposed dense rhs" << std::endl;
@@ -200,7 +351,8 @@ int test(NumericT epsilon)
 
   temp.clear();
   viennacl::copy( result, temp);
-  check_matrices(ublas_result, temp, epsilon);
+  if (check_matrices(ublas_result, temp, epsilon) != EXIT_SUCCESS)
+    retVal = EXIT_FAILURE;
 
   /******************************************************************/
   std::cout << "Testing compressed(COO) lhs * transposed dense rhs" << std::endl;
@@ -209,7 +361,8 @@ int test(NumericT epsilon)
 
   temp.clear();
   viennacl::copy( result, temp);
-  check_matrices(ublas_result, temp, epsilon);
+  if (check_matrices(ublas_result, temp, epsilon) != EXIT_SUCCESS)
+    retVal = EXIT_FAILURE;
 
   /******************************************************************/
 
@@ -219,7 +372,12 @@ int test(NumericT epsilon)
 
   temp.clear();
   viennacl::copy( result, temp);
-  check_matrices(ublas_result, temp, epsilon);
+  if (check_matrices(ublas_result, temp, epsilon) != EXIT_SUCCESS)
+    retVal = EXIT_FAILURE;
+
+  /******************************************************************/
+  if (test_blocks<NumericT, ResultLayoutT, FactorLayoutT>(ublas_lhs, epsilon) != EXIT_SUCCESS)
+    retVal = EXIT_FAILURE;
 
   /******************************************************************/
   if (retVal == EXIT_SUCCESS) {
@@ -0,0 +1,317 @@
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+
+/** \file tests/src/tridiag_eig.cpp  Tests the eigensolver for symmetric tridiagonal matrices (bisection, QL and divide-and-conquer).
+*   \test  Tests the eigensolver for symmetric tridiagonal matrices (bisection, QL and divide-and-conquer).
+**/
+
+//
+// *** System
+//
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <string>
+#include <limits>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/linalg/tridiag_eig.hpp"
+
+
+typedef double     NumericT;
+
+#define EPS 1e-11
+
+
+/** @brief Returns the maximum relative deviation of the eigenvalues from a reference */
+NumericT diff(std::vector<NumericT> const & eigenvalues, std::vector<NumericT> const & ref, NumericT norm_T)
+{
+  if (eigenvalues.size() != ref.size())
+    return NumericT(1);
+
+  NumericT ret = 0;
+  for (std::size_t i=0; i<ref.size(); ++i)
+    ret = std::max(ret, std::fabs(eigenvalues[i] - ref[i]) / norm_T);
+  return ret;
+}
+
+/** @brief Returns the norm of the tridiagonal matrix (maximum absolute row sum) */
+NumericT tridiag_norm(std::vector<NumericT> const & d, std::vector<NumericT> const & e)
+{
+  NumericT ret = 0;
+  for (std::size_t i=0; i<d.size(); ++i)
+  {
+    NumericT row_sum = std::fabs(d[i]);
+    if (i > 0)            row_sum += std::fabs(e[i]);
+    if (i + 1 < d.size()) row_sum += std::fabs(e[i+1]);
+    ret = std::max(ret, row_sum);
+  }
+  return ret;
+}
+
+/** @brief Checks the eigenvalues returned by the different code paths against the reference eigenvalues in ascending order */
+int check_eigenvalues(std::string const & name, std::vector<NumericT> const & d, std::vector<NumericT> const & e, std::vector<NumericT> const & ref)
+{
+  NumericT norm_T = std::max<NumericT>(tridiag_norm(d, e), std::numeric_limits<NumericT>::min());
+  std::size_t n = d.size();
+
+  // full spectrum (QL method or bisection, depending on the number of threads):
+  std::vector<NumericT> all = viennacl::linalg::tridiag_eigenvalues(d, e);
+  std::cout << "  " << name << ", all eigenvalues: " << diff(all, ref, norm_T) << std::endl;
+  if (diff(all, ref, norm_T) > EPS)
+  {
+    std::cout << "# Error at operation: " << name << ", all eigenvalues" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // a few eigenvalues at both ends of the spectrum (bisection):
+  std::size_t num = std::min<std::size_t>(n, 3);
+  viennacl::linalg::tridiag_eig_tag tag(false);
+  tag.set_index_range(0, num);
+  std::vector<NumericT> lowest = viennacl::linalg::tridiag_eigenvalues(d, e, tag);
+  tag.set_index_range(n - num, n);
+  std::vector<NumericT> highest = viennacl::linalg::tridiag_eigenvalues(d, e, tag);
+  NumericT range_diff = std::max(diff(lowest,  std::vector<NumericT>(ref.begin(), ref.begin() + static_cast<long>(num)), norm_T),
+                                 diff(highest, std::vector<NumericT>(ref.end() - static_cast<long>(num), ref.end()), norm_T));
+  std::cout << "  " << name << ", index ranges: " << range_diff << std::endl;
+  if (range_diff > EPS)
+  {
+    std::cout << "# Error at operation: " << name << ", index ranges" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // eigenvalues in a value range containing the lower half of the spectrum:
+  if (n > 1)
+  {
+    NumericT split = (ref[n/2 - 1] + ref[n/2]) / 2;
+    if (ref[n/2 - 1] < split && split < ref[n/2])
+    {
+      tag.set_value_range(ref[0] - norm_T, split);
+      std::vector<NumericT> lower_half = viennacl::linalg::tridiag_eigenvalues(d, e, tag);
+      NumericT value_diff = diff(lower_half, std::vector<NumericT>(ref.begin(), ref.begin() + static_cast<long>(n/2)), norm_T);
+      std::cout << "  " << name << ", value range: " << value_diff << std::endl;
+      if (value_diff > EPS)
+      {
+        std::cout << "# Error at operation: " << name << ", value range" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/** @brief Computes the maximum residual |T q - lambda q| / |T| and the maximum deviation of Q^T Q from the identity for the column-major n x m matrix Q */
+void eigenpair_errors(std::vector<NumericT> const & d, std::vector<NumericT> const & e,
+                      std::vector<NumericT> const & eigenvalues, std::vector<NumericT> const & Q,
+                      NumericT & residual, NumericT & orthogonality)
+{
+  NumericT norm_T = std::max<NumericT>(tridiag_norm(d, e), std::numeric_limits<NumericT>::min());
+  std::size_t n = d.size();
+
+  residual = 0;
+  orthogonality = 0;
+  for (std::size_t j=0; j<eigenvalues.size(); ++j)
+  {
+    NumericT const * q = &Q[j * n];
+    for (std::size_t i=0; i<n; ++i)
+    {
+      NumericT Tq = d[i] * q[i];
+      if (i > 0)     Tq += e[i] * q[i-1];
+      if (i + 1 < n) Tq += e[i+1] * q[i+1];
+      residual = std::max(residual, std::fabs(Tq - eigenvalues[j] * q[i]) / norm_T);
+    }
+
+    for (std::size_t k=0; k<=j; ++k)
+    {
+      NumericT dot = 0;
+      for (std::size_t i=0; i<n; ++i)
+        dot += Q[k * n + i] * q[i];
+      orthogonality = std::max(orthogonality, std::fabs(dot - ((k == j) ? NumericT(1) : NumericT(0))));
+    }
+  }
+}
+
+/** @brief Checks the eigenpairs for the index range [first, last) against the full eigendecomposition */
+int check_eigenpair_range(std::string const & name, std::vector<NumericT> const & d, std::vector<NumericT> const & e,
+                          std::vector<NumericT> const & all_eigenvalues, std::size_t first, std::size_t last)
+{
+  NumericT norm_T = std::max<NumericT>(tridiag_norm(d, e), std::numeric_limits<NumericT>::min());
+  std::size_t n = d.size();
+
+  viennacl::linalg::tridiag_eig_tag tag;
+  tag.set_index_range(first, last);
+  std::vector<NumericT> sub_eigenvalues, sub_Q;
+  viennacl::linalg::tridiag_eig(d, e, sub_eigenvalues, sub_Q, tag);
+  bool sub_ok = (sub_eigenvalues.size() == last - first) && (sub_Q.size() == n * sub_eigenvalues.size());
+  for (std::size_t j=0; sub_ok && j<sub_eigenvalues.size(); ++j)
+    sub_ok = std::fabs(sub_eigenvalues[j] - all_eigenvalues[first + j]) <= EPS * norm_T;
+  if (!sub_ok)
+  {
+    std::cout << "# Error at operation: " << name << ", eigenvalues for the index range [" << first << ", " << last << ")" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  NumericT residual, orthogonality;
+  eigenpair_errors(d, e, sub_eigenvalues, sub_Q, residual, orthogonality);
+  std::cout << "  " << name << ", eigenpairs [" << first << ", " << last << "): residual " << residual << ", orthogonality " << orthogonality << std::endl;
+  if (residual > EPS || orthogonality > EPS)
+  {
+    std::cout << "# Error at operation: " << name << ", eigenpairs for the index range [" << first << ", " << last << ")" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/** @brief Checks the eigenpairs from divide-and-conquer: Residuals T q - lambda q, orthogonality of the eigenvectors, and the eigenvalues against the values-only solver */
+int check_eigenpairs(std::string const & name, std::vector<NumericT> const & d, std::vector<NumericT> const & e)
+{
+  NumericT norm_T = std::max<NumericT>(tridiag_norm(d, e), std::numeric_limits<NumericT>::min());
+  std::size_t n = d.size();
+
+  std::vector<NumericT> eigenvalues, Q;
+  viennacl::linalg::tridiag_eig(d, e, eigenvalues, Q);
+  if (eigenvalues.size() != n || Q.size() != n * n)
+  {
+    std::cout << "# Error at operation: " << name << ", size of the eigendecomposition" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  NumericT residual, orthogonality;
+  eigenpair_errors(d, e, eigenvalues, Q, residual, orthogonality);
+
+  std::vector<NumericT> values_only = viennacl::linalg::tridiag_eigenvalues(d, e);
+  NumericT value_diff = diff(eigenvalues, values_only, norm_T);
+
+  std::cout << "  " << name << ", eigenpairs: residual " << residual << ", orthogonality " << orthogonality << ", eigenvalues " << value_diff << std::endl;
+  if (residual > EPS || orthogonality > EPS || value_diff > EPS)
+  {
+    std::cout << "# Error at operation: " << name << ", eigenpairs" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // subsets of eigenpairs (small subsets by inverse iteration, large subsets by divide-and-conquer):
+  if (check_eigenpair_range(name, d, e, eigenvalues, n / 3, n / 2) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (check_eigenpair_range(name, d, e, eigenvalues, 0, std::min<std::size_t>(n, 3)) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (check_eigenpair_range(name, d, e, eigenvalues, n / 8, n - n / 8) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Symmetric Tridiagonal Eigensolver" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  NumericT const pi = std::acos(NumericT(-1));
+
+  // 1D Laplace operator: lambda_k = 2 - 2 cos(k pi / (n+1)). Large enough for several levels of divide-and-conquer.
+  {
+    std::size_t n = 300;
+    std::vector<NumericT> d(n, 2), e(n, -1), ref(n);
+    for (std::size_t k=0; k<n; ++k)
+      ref[k] = 2 - 2 * std::cos(NumericT(k + 1) * pi / NumericT(n + 1));
+    if (check_eigenvalues("1D Laplace", d, e, ref) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    if (check_eigenpairs("1D Laplace", d, e) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  // Wilkinson matrix W_{2m+1}^+: pairs of very close eigenvalues
+  {
+    std::size_t m = 60;
+    std::size_t n = 2 * m + 1;
+    std::vector<NumericT> d(n), e(n, 1);
+    for (std::size_t i=0; i<n; ++i)
+      d[i] = std::fabs(NumericT(i) - NumericT(m));
+    if (check_eigenpairs("Wilkinson", d, e) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  // Block diagonal with repeated blocks (zero off-diagonal entries, multiple eigenvalues, deflation):
+  {
+    std::size_t block = 5;
+    std::size_t n = 40 * block;
+    std::vector<NumericT> d(n, 2), e(n, -1), ref;
+    for (std::size_t i=0; i<n; i += block)
+      e[i] = 0;
+    for (std::size_t k=0; k<block; ++k)
+      for (std::size_t b=0; b<n/block; ++b)
+        ref.push_back(2 - 2 * std::cos(NumericT(k + 1) * pi / NumericT(block + 1)));
+    if (check_eigenvalues("Repeated blocks", d, e, ref) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    if (check_eigenpairs("Repeated blocks", d, e) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  // Diagonal matrix with unsorted entries and a graded matrix:
+  {
+    std::size_t n = 97;
+    std::vector<NumericT> d(n), e(n, 0), ref(n);
+    for (std::size_t i=0; i<n; ++i)
+      d[i] = NumericT((i * 37) % n) - NumericT(40);
+    ref = d;
+    std::sort(ref.begin(), ref.end());
+    if (check_eigenvalues("Diagonal", d, e, ref) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    if (check_eigenpairs("Diagonal", d, e) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
+    for (std::size_t i=0; i<n; ++i)
+    {
+      d[i] = std::pow(NumericT(0.8), NumericT(i));
+      e[i] = (i > 0) ? std::pow(NumericT(0.8), NumericT(i) - NumericT(0.5)) / 4 : 0;
+    }
+    if (check_eigenpairs("Graded", d, e) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  // Tiny matrices:
+  for (std::size_t n=1; n<=3; ++n)
+  {
+    std::vector<NumericT> d(n, 2), e(n, -1), ref(n);
+    for (std::size_t k=0; k<n; ++k)
+      ref[k] = 2 - 2 * std::cos(NumericT(k + 1) * pi / NumericT(n + 1));
+    if (check_eigenvalues("Tiny", d, e, ref) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    if (check_eigenpairs("Tiny", d, e) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -2026,6 +2026,69 @@ int test(Epsilon const& epsilon,
     host_v1[i] = host_v2[i] / alpha   +     beta * host_v1[i] - alpha * host_v2[i] + beta * host_v1[i] - alpha * host_v1[i];
   vcl_v1   = vcl_v2 / gpu_alpha + gpu_beta *   vcl_v1 - alpha *   vcl_v2 + beta *   vcl_v1 - alpha *   vcl_v1;
 
+  if (check(host_v1, vcl_v1, epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // --------------------------------------------------------------------------
+  std::cout << "Testing gather..." << std::endl;
+  std::vector<unsigned int> indices;
+  std::vector<NumericT> values;
+  for (std::size_t i=0; i<host_v1.size(); i += 3)
+  {
+    indices.push_back(static_cast<unsigned int>(host_v1.size() - 1 - i));
+    indices.push_back(static_cast<unsigned int>(i / 2));  // duplicates some indices
+  }
+  proxy_copy(host_v1, vcl_v1);
+  values = viennacl::linalg::gather(vcl_v1, indices);
+  for (std::size_t i=0; i<indices.size(); ++i)
+    if (diff(host_v1[indices[i]], values[i]) > epsilon)
+    {
+      std::cout << "# Error at operation: gather" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+  std::cout << "Testing scatter..." << std::endl;
+  for (std::size_t i=0; i<indices.size(); ++i)
+  {
+    values[i] = NumericT(i) / NumericT(indices.size());
+    host_v1[indices[i]] = values[i];
+  }
+  viennacl::linalg::scatter(values, indices, vcl_v1);
+  if (check(host_v1, vcl_v1, epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  for (std::size_t i=0; i<indices.size(); ++i)
+    host_v1[indices[i]] += values[i];
+  viennacl::linalg::scatter(values, indices, vcl_v1, viennacl::op_inplace_add());
+  if (check(host_v1, vcl_v1, epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  for (std::size_t i=0; i<indices.size(); ++i)
+  {
+    values[i] = NumericT(1) - values[i];
+    host_v1[indices[i]] = std::max(host_v1[indices[i]], values[i]);
+  }
+  viennacl::linalg::scatter(values, indices, vcl_v1, viennacl::op_max());
+  if (check(host_v1, vcl_v1, epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // many updates of a few entries at the end of the vector, applied in the order given (enough for a parallel scatter):
+  indices.resize(4 * host_v1.size());
+  values.resize(indices.size());
+  for (std::size_t i=0; i<indices.size(); ++i)
+  {
+    indices[i] = static_cast<unsigned int>(host_v1.size() - 1 - (i * i) % 7);
+    values[i]  = NumericT(1) / NumericT(1 + i % 13);
+  }
+  for (std::size_t i=0; i<indices.size(); ++i)
+    host_v1[indices[i]] = values[i];
+  viennacl::linalg::scatter(values, indices, vcl_v1);
+  if (check(host_v1, vcl_v1, epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  for (std::size_t i=0; i<indices.size(); ++i)
+    host_v1[indices[i]] += values[i];
+  viennacl::linalg::scatter(values, indices, vcl_v1, viennacl::op_inplace_add());
   if (check(host_v1, vcl_v1, epsilon) != EXIT_SUCCESS)
     return EXIT_FAILURE;
 
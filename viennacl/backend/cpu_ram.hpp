@@ -25,6 +25,7 @@
 #include <cassert>
 #include <vector>
 #include "viennacl/tools/shared_ptr.hpp"
+#include "viennacl/host_context.hpp"
 
 namespace viennacl
 {
@@ -77,6 +78,36 @@ inline handle_type  memory_create(vcl_size_t size_in_bytes, const void * host_pt
   return new_handle;
 }
 
+/** @brief Creates an array of the specified size in main RAM, which is first touched by the thread team of the provided host context.
+ *
+ * Operating systems with a first-touch policy (such as Linux) place each memory page on the NUMA node of the core which writes to it first.
+ * The array is initialized in contiguous chunks by the team, which matches the static partitioning of the host kernels.
+ * If the host context does not bind its threads to CPUs, this is the same as memory_create(size_in_bytes, host_ptr).
+ *
+ * @param size_in_bytes   Number of bytes to allocate
+ * @param host_ptr        Pointer to data which will be copied to the new array. Must point to at least 'size_in_bytes' bytes of data. If NULL, the array is zero-initialized.
+ * @param ctx             The host context providing the thread team
+ */
+inline handle_type  memory_create(vcl_size_t size_in_bytes, const void * host_ptr, viennacl::host_context const * ctx)
+{
+  if (!ctx || !ctx->is_bound())
+    return memory_create(size_in_bytes, host_ptr);
+
+  handle_type new_handle(new char[size_in_bytes], detail::array_deleter<char>());
+
+  viennacl::detail::host_context_scope scope(ctx);
+
+  char * raw_ptr = new_handle.get();
+  const char * data_ptr = static_cast<const char *>(host_ptr);
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for
+#endif
+  for (long i = 0; i < static_cast<long>(size_in_bytes); ++i)
+    raw_ptr[i] = data_ptr ? data_ptr[i] : 0;
+
+  return new_handle;
+}
+
 /** @brief Copies 'bytes_to_copy' bytes from address 'src_buffer + src_offset' to memory starting at address 'dst_buffer + dst_offset'.
  *
  *  @param src_buffer     A smart pointer to the begin of an allocated buffer
@@ -26,6 +26,7 @@
 #include <cassert>
 #include "viennacl/forwards.h"
 #include "viennacl/tools/shared_ptr.hpp"
+#include "viennacl/host_context.hpp"
 #include "viennacl/backend/cpu_ram.hpp"
 
 #ifdef VIENNACL_WITH_OPENCL
@@ -93,13 +94,18 @@ public:
   typedef viennacl::tools::shared_ptr<char>      cuda_handle_type;
 
   /** @brief Default CTOR. No memory is allocated */
-  mem_handle() : active_handle_(MEMORY_NOT_INITIALIZED), size_in_bytes_(0) {}
+  mem_handle() : active_handle_(MEMORY_NOT_INITIALIZED), ram_context_(NULL), size_in_bytes_(0) {}
 
   /** @brief Returns the handle to a buffer in CPU RAM. NULL is returned if no such buffer has been allocated. */
   ram_handle_type       & ram_handle()       { return ram_handle_; }
   /** @brief Returns the handle to a buffer in CPU RAM. NULL is returned if no such buffer has been allocated. */
   ram_handle_type const & ram_handle() const { return ram_handle_; }
 
+  /** @brief Returns the host context the buffer in CPU RAM was created in. NULL refers to the default host context. */
+  viennacl::host_context const * ram_context() const { return ram_context_; }
+  /** @brief Sets the host context of the buffer in CPU RAM. */
+  void ram_context(viennacl::host_context const * ctx) { ram_context_ = ctx; }
+
 #ifdef VIENNACL_WITH_OPENCL
   /** @brief Returns the handle to an OpenCL buffer. The handle contains NULL if no such buffer has been allocated. */
   viennacl::ocl::handle<cl_mem>       & opencl_handle()       { return opencl_handle_; }
@@ -215,6 +221,10 @@ public:
     other.ram_handle_ = ram_handle_;
     ram_handle_ = ram_handle_tmp;
 
+    viennacl::host_context const * ram_context_tmp = other.ram_context_;
+    other.ram_context_ = ram_context_;
+    ram_context_ = ram_context_tmp;
+
     // swap OpenCL handle:
 #ifdef VIENNACL_WITH_OPENCL
     opencl_handle_.swap(other.opencl_handle_);
@@ -235,6 +245,7 @@ public:
 private:
   memory_types active_handle_;
   ram_handle_type ram_handle_;
+  viennacl::host_context const * ram_context_;
 #ifdef VIENNACL_WITH_OPENCL
   viennacl::ocl::handle<cl_mem> opencl_handle_;
 #endif
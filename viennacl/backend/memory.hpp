@@ -30,6 +30,7 @@
 #include "viennacl/traits/handle.hpp"
 #include "viennacl/traits/context.hpp"
 #include "viennacl/backend/util.hpp"
+#include "viennacl/host_queue.hpp"
 
 #include "viennacl/backend/cpu_ram.hpp"
 
@@ -50,9 +51,10 @@ namespace backend
 
 
   // if a user compiles with CUDA, it is reasonable to expect that CUDA should be the default
-  /** @brief Synchronizes the execution. finish() will only return after all compute kernels (CUDA, OpenCL) have completed. */
+  /** @brief Synchronizes the execution. finish() will only return after all compute kernels (CUDA, OpenCL) and all tasks in the default host queue have completed. */
   inline void finish()
   {
+    viennacl::default_host_queue().finish();
 #ifdef VIENNACL_WITH_CUDA
     cudaDeviceSynchronize();
 #endif
@@ -94,7 +96,8 @@ namespace backend
       switch (handle.get_active_handle_id())
       {
       case MAIN_MEMORY:
-        handle.ram_handle() = cpu_ram::memory_create(size_in_bytes, host_ptr);
+        handle.ram_context(ctx.host_context_ptr());
+        handle.ram_handle() = cpu_ram::memory_create(size_in_bytes, host_ptr, handle.ram_context());
         handle.raw_size(size_in_bytes);
         break;
 #ifdef VIENNACL_WITH_OPENCL
@@ -368,11 +371,17 @@ namespace backend
   void switch_memory_context(mem_handle & handle, viennacl::context new_ctx)
   {
     if (handle.get_active_handle_id() == new_ctx.memory_type())
+    {
+      if (new_ctx.memory_type() == MAIN_MEMORY)  // only the thread team changes, data stays in place
+        handle.ram_context(new_ctx.host_context_ptr());
       return;
+    }
 
     if (handle.get_active_handle_id() == viennacl::MEMORY_NOT_INITIALIZED || handle.raw_size() == 0)
     {
       handle.switch_active_handle_id(new_ctx.memory_type());
+      if (new_ctx.memory_type() == MAIN_MEMORY)
+        handle.ram_context(new_ctx.host_context_ptr());
 #ifdef VIENNACL_WITH_OPENCL
       if (new_ctx.memory_type() == OPENCL_MEMORY)
         handle.opencl_handle().context(new_ctx.opencl_context());
@@ -417,7 +426,8 @@ namespace backend
         switch (new_ctx.memory_type())
         {
         case MAIN_MEMORY:
-          handle.ram_handle() = cpu_ram::memory_create(handle.raw_size());
+          handle.ram_context(new_ctx.host_context_ptr());
+          handle.ram_handle() = cpu_ram::memory_create(handle.raw_size(), NULL, handle.ram_context());
           opencl::memory_read(handle.opencl_handle(), 0, handle.raw_size(), handle.ram_handle().get());
           break;
 #ifdef VIENNACL_WITH_CUDA
@@ -441,7 +451,8 @@ namespace backend
         switch (new_ctx.memory_type())
         {
         case MAIN_MEMORY:
-          handle.ram_handle() = cpu_ram::memory_create(handle.raw_size());
+          handle.ram_context(new_ctx.host_context_ptr());
+          handle.ram_handle() = cpu_ram::memory_create(handle.raw_size(), NULL, handle.ram_context());
           cuda::memory_read(handle.cuda_handle(), 0, handle.raw_size(), handle.ram_handle().get());
           break;
 #ifdef VIENNACL_WITH_OPENCL
@@ -490,6 +490,11 @@ public:
       row_blocks_.opencl_handle().context(ctx.opencl_context());
     }
 #endif
+    // buffers allocated later (e.g. by copy()) are created in the host context of the matrix:
+    row_buffer_.ram_context(ctx.host_context_ptr());
+    col_buffer_.ram_context(ctx.host_context_ptr());
+    elements_.ram_context(ctx.host_context_ptr());
+    row_blocks_.ram_context(ctx.host_context_ptr());
     if (rows > 0)
     {
       viennacl::backend::memory_create(row_buffer_, viennacl::backend::typesafe_host_array<unsigned int>().element_size() * (rows + 1), ctx);
@@ -524,6 +529,11 @@ public:
       row_blocks_.opencl_handle().context(ctx.opencl_context());
     }
 #endif
+    // buffers allocated later (e.g. by copy()) are created in the host context of the matrix:
+    row_buffer_.ram_context(ctx.host_context_ptr());
+    col_buffer_.ram_context(ctx.host_context_ptr());
+    elements_.ram_context(ctx.host_context_ptr());
+    row_blocks_.ram_context(ctx.host_context_ptr());
     if (rows > 0)
     {
       viennacl::backend::memory_create(row_buffer_, viennacl::backend::typesafe_host_array<unsigned int>().element_size() * (rows + 1), ctx);
@@ -550,6 +560,11 @@ public:
       row_blocks_.opencl_handle().context(ctx.opencl_context());
     }
 #endif
+    // buffers allocated later (e.g. by copy()) are created in the host context of the matrix:
+    row_buffer_.ram_context(ctx.host_context_ptr());
+    col_buffer_.ram_context(ctx.host_context_ptr());
+    elements_.ram_context(ctx.host_context_ptr());
+    row_blocks_.ram_context(ctx.host_context_ptr());
   }
 
 
@@ -919,9 +934,15 @@ namespace detail
   {
     static void apply(vector_base<T> & lhs, vector_expression<const compressed_matrix<T, A>, const vector_base<T>, op_prod> const & rhs)
     {
-      viennacl::vector<T> temp(lhs);
-      viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), temp);
-      lhs += temp;
+      // check for the special case x += A * x
+      if (viennacl::traits::handle(lhs) == viennacl::traits::handle(rhs.rhs()))
+      {
+        viennacl::vector<T> temp(lhs);
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), temp);
+        lhs += temp;
+      }
+      else
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), lhs, T(1), T(1));
     }
   };
 
@@ -930,9 +951,15 @@ namespace detail
   {
     static void apply(vector_base<T> & lhs, vector_expression<const compressed_matrix<T, A>, const vector_base<T>, op_prod> const & rhs)
     {
-      viennacl::vector<T> temp(lhs);
-      viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), temp);
-      lhs -= temp;
+      // check for the special case x -= A * x
+      if (viennacl::traits::handle(lhs) == viennacl::traits::handle(rhs.rhs()))
+      {
+        viennacl::vector<T> temp(lhs);
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), temp);
+        lhs -= temp;
+      }
+      else
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), lhs, T(-1), T(1));
     }
   };
 
@@ -955,9 +982,7 @@ namespace detail
     static void apply(vector_base<T> & lhs, vector_expression<const compressed_matrix<T, A>, vector_expression<const LHS, const RHS, OP>, op_prod> const & rhs)
     {
       viennacl::vector<T> temp(rhs.rhs(), viennacl::traits::context(rhs));
-      viennacl::vector<T> temp_result(lhs);
-      viennacl::linalg::prod_impl(rhs.lhs(), temp, temp_result);
-      lhs += temp_result;
+      viennacl::linalg::prod_impl(rhs.lhs(), temp, lhs, T(1), T(1));
     }
   };
 
@@ -968,9 +993,7 @@ namespace detail
     static void apply(vector_base<T> & lhs, vector_expression<const compressed_matrix<T, A>, const vector_expression<const LHS, const RHS, OP>, op_prod> const & rhs)
     {
       viennacl::vector<T> temp(rhs.rhs(), viennacl::traits::context(rhs));
-      viennacl::vector<T> temp_result(lhs);
-      viennacl::linalg::prod_impl(rhs.lhs(), temp, temp_result);
-      lhs -= temp_result;
+      viennacl::linalg::prod_impl(rhs.lhs(), temp, lhs, T(-1), T(1));
     }
   };
 
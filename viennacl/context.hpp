@@ -28,6 +28,7 @@
 #include "viennacl/forwards.h"
 #include "viennacl/ocl/forwards.h"
 #include "viennacl/backend/mem_handle.hpp"
+#include "viennacl/host_context.hpp"
 
 namespace viennacl
 {
@@ -39,7 +40,7 @@ namespace viennacl
 class context
 {
 public:
-  context() : mem_type_(viennacl::backend::default_memory_type())
+  context() : mem_type_(viennacl::backend::default_memory_type()), host_context_ptr_(NULL)
   {
 #ifdef VIENNACL_WITH_OPENCL
     if (mem_type_ == OPENCL_MEMORY)
@@ -49,7 +50,7 @@ public:
 #endif
   }
 
-  explicit context(viennacl::memory_types mtype) : mem_type_(mtype)
+  explicit context(viennacl::memory_types mtype) : mem_type_(mtype), host_context_ptr_(NULL)
   {
     if (mem_type_ == MEMORY_NOT_INITIALIZED)
       mem_type_ = viennacl::backend::default_memory_type();
@@ -62,7 +63,7 @@ public:
   }
 
 #ifdef VIENNACL_WITH_OPENCL
-  context(viennacl::ocl::context const & ctx) : mem_type_(OPENCL_MEMORY), ocl_context_ptr_(&ctx) {}
+  context(viennacl::ocl::context const & ctx) : mem_type_(OPENCL_MEMORY), host_context_ptr_(NULL), ocl_context_ptr_(&ctx) {}
 
   viennacl::ocl::context const & opencl_context() const
   {
@@ -71,12 +72,24 @@ public:
   }
 #endif
 
-  // TODO: Add CUDA and OpenMP contexts
+  /** @brief Creates a context in main memory, where host kernels use the thread team of the provided host context. */
+  context(viennacl::host_context const & ctx) : mem_type_(MAIN_MEMORY), host_context_ptr_(&ctx)
+  {
+#ifdef VIENNACL_WITH_OPENCL
+    ocl_context_ptr_ = NULL;
+#endif
+  }
+
+  /** @brief Returns the host context for main memory. NULL refers to the default host context. */
+  viennacl::host_context const * host_context_ptr() const { return host_context_ptr_; }
+
+  // TODO: Add CUDA contexts
 
   viennacl::memory_types  memory_type() const { return mem_type_; }
 
 private:
   viennacl::memory_types   mem_type_;
+  viennacl::host_context const * host_context_ptr_;
 #ifdef VIENNACL_WITH_OPENCL
   viennacl::ocl::context const * ocl_context_ptr_;
 #endif
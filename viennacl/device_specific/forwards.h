@@ -33,6 +33,7 @@
 #include "viennacl/ocl/forwards.h"
 #include "viennacl/tools/shared_ptr.hpp"
 #include "viennacl/scheduler/forwards.h"
+#include "viennacl/device_specific/statements_container.hpp"
 
 #include "viennacl/backend/mem_handle.hpp"
 
@@ -248,35 +249,6 @@ inline tools::shared_ptr<symbolic_binder> make_binder(binding_policy_t policy)
 template<char C>
 struct char_to_type{ };
 
-class statements_container
-{
-public:
-  typedef std::list<scheduler::statement> data_type;
-  enum order_type { SEQUENTIAL, INDEPENDENT };
-
-  statements_container(data_type const & data, order_type order) : data_(data), order_(order)
-  { }
-
-  statements_container(scheduler::statement const & s0) : order_(INDEPENDENT)
-  {
-    data_.push_back(s0);
-  }
-
-  statements_container(scheduler::statement const & s0, scheduler::statement const & s1, order_type order) : order_(order)
-  {
-    data_.push_back(s0);
-    data_.push_back(s1);
-  }
-
-  std::list<scheduler::statement> const & data() const { return data_; }
-
-  order_type order() const { return order_; }
-
-private:
-  std::list<scheduler::statement> data_;
-  order_type order_;
-};
-
 }
 
 }
@@ -0,0 +1,68 @@
+#ifndef VIENNACL_DEVICE_SPECIFIC_STATEMENTS_CONTAINER_HPP
+#define VIENNACL_DEVICE_SPECIFIC_STATEMENTS_CONTAINER_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+/** @file viennacl/device_specific/statements_container.hpp
+    @brief A group of statements executed together. Does not depend on OpenCL, hence is also used by the host backend (cf. viennacl/scheduler/execute_fused.hpp).
+*/
+
+#include <list>
+
+#include "viennacl/scheduler/forwards.h"
+
+namespace viennacl
+{
+namespace device_specific
+{
+
+/** @brief A list of statements, which are either executed one after another (SEQUENTIAL) or do not depend on each other (INDEPENDENT) */
+class statements_container
+{
+public:
+  typedef std::list<scheduler::statement> data_type;
+  enum order_type { SEQUENTIAL, INDEPENDENT };
+
+  statements_container(data_type const & data, order_type order) : data_(data), order_(order)
+  { }
+
+  statements_container(scheduler::statement const & s0) : order_(INDEPENDENT)
+  {
+    data_.push_back(s0);
+  }
+
+  statements_container(scheduler::statement const & s0, scheduler::statement const & s1, order_type order) : order_(order)
+  {
+    data_.push_back(s0);
+    data_.push_back(s1);
+  }
+
+  std::list<scheduler::statement> const & data() const { return data_; }
+
+  order_type order() const { return order_; }
+
+private:
+  std::list<scheduler::statement> data_;
+  order_type order_;
+};
+
+}
+
+}
+#endif
@@ -0,0 +1,348 @@
+#ifndef VIENNACL_HOST_CONTEXT_HPP_
+#define VIENNACL_HOST_CONTEXT_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/host_context.hpp
+    @brief Implementation of a context for the host backend, which owns the thread team (number of threads, CPU affinity, NUMA node) used by host kernels.
+*/
+
+#include <vector>
+#include <cstdio>
+#include <algorithm>
+#include "viennacl/forwards.h"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+#if defined(VIENNACL_WITH_OPENMP) && defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace viennacl
+{
+
+class host_context;
+
+namespace detail
+{
+  /** @brief Returns a new identifier for a host context configuration. Identifiers are never reused, so a modified context or a new context at the address of a destroyed one is never mistaken for the active context of a thread. */
+  inline long new_host_context_id()
+  {
+    static long counter = 0;
+    long id;
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp critical (viennacl_host_context_id)
+#endif
+    id = ++counter;
+    return id;
+  }
+
+  inline void deactivate_host_context(long id);
+
+  /** @brief Returns the CPUs of a NUMA node as reported by the Linux kernel. An empty list is returned if the node does not exist or the information is not available. */
+  inline std::vector<int> numa_node_cpus(int node)
+  {
+    std::vector<int> cpus;
+#if defined(__linux__)
+    char filename[64];
+    std::sprintf(filename, "/sys/devices/system/node/node%d/cpulist", node);
+    std::FILE * file = std::fopen(filename, "r");
+    if (!file)
+      return cpus;
+
+    // format: comma-separated list of CPUs or CPU ranges, e.g. '0-3,8-11'
+    int first, last;
+    while (std::fscanf(file, "%d", &first) == 1)
+    {
+      last = first;
+      int c = std::fgetc(file);
+      if (c == '-')
+      {
+        if (std::fscanf(file, "%d", &last) != 1)
+          break;
+        c = std::fgetc(file);
+      }
+      for (int cpu = first; cpu <= last; ++cpu)
+        cpus.push_back(cpu);
+      if (c != ',')
+        break;
+    }
+    std::fclose(file);
+#else
+    (void)node;
+#endif
+    return cpus;
+  }
+}
+
+/** @brief A context for main memory, which owns the thread team used by the host kernels.
+  *
+  * All objects created in a viennacl::context constructed from a host_context keep a reference to it.
+  * Operations on these objects are then executed with the number of threads, the CPU affinity and the NUMA node of the host_context,
+  * so that several computations running concurrently in different threads of the application can be kept on disjoint sets of cores.
+  * Memory of such objects is first touched by the thread team of the host_context, so that it is placed on the NUMA node(s) of the respective cores.
+  *
+  * The thread team of the calling thread stays configured for the host_context after an operation, so that consecutive operations in the same context do not reconfigure the team.
+  * It is reset by the next operation on objects in another context (including the default context) or when the host_context is destroyed.
+  *
+  * Similar to viennacl::ocl::context, the host_context must outlive all objects created in it.
+  * Without OpenMP, the settings are stored but have no effect.
+  */
+class host_context
+{
+public:
+  /** @brief Creates a host context using the given number of threads. A value of zero refers to the default of the OpenMP runtime. */
+  explicit host_context(vcl_size_t threads = 0) : id_(detail::new_host_context_id()), num_threads_(threads), numa_node_(-1) {}
+
+  /** @brief Resets the thread team of the calling thread if the context is active in it. */
+  ~host_context() { detail::deactivate_host_context(id_); }
+
+  /** @brief Returns the number of threads requested for this context. Zero refers to the default of the OpenMP runtime, or to the number of CPUs if an affinity is set. */
+  vcl_size_t num_threads() const { return num_threads_; }
+  /** @brief Sets the number of threads. Zero refers to the default of the OpenMP runtime, or to the number of CPUs if an affinity is set. */
+  void num_threads(vcl_size_t threads) { num_threads_ = threads; id_ = detail::new_host_context_id(); }
+
+  /** @brief Returns the CPUs the thread team is bound to. An empty list denotes no binding. */
+  std::vector<int> const & cpu_affinity() const { return cpus_.size() > 0 ? cpus_ : numa_cpus_; }
+  /** @brief Binds the thread team to the provided CPUs. Thread i of the team is bound to CPU cpus[i % cpus.size()]. */
+  void cpu_affinity(std::vector<int> const & cpus) { cpus_ = cpus; id_ = detail::new_host_context_id(); }
+
+  /** @brief Returns the NUMA node of the context, or -1 if no NUMA node is set. */
+  int numa_node() const { return numa_node_; }
+  /** @brief Places the context on a NUMA node. Unless a CPU affinity is set explicitly, the thread team is bound to the CPUs of that node. */
+  void numa_node(int node)
+  {
+    numa_node_ = node;
+    numa_cpus_ = (node >= 0) ? detail::numa_node_cpus(node) : std::vector<int>();
+    id_ = detail::new_host_context_id();
+  }
+
+  /** @brief Returns the number of threads actually used by the team, or zero if the default of the OpenMP runtime is used. */
+  vcl_size_t team_size() const
+  {
+    if (num_threads_ > 0)
+      return num_threads_;
+    return cpu_affinity().size();
+  }
+
+  /** @brief Returns true if the thread team is bound to CPUs, in which case memory is first touched by the team. */
+  bool is_bound() const { return cpu_affinity().size() > 0; }
+
+  /** @brief Returns a unique identifier of the current configuration, which changes whenever a setting is modified. Used to decide whether the thread team needs to be reconfigured. */
+  long id() const { return id_; }
+
+private:
+  long id_;
+  vcl_size_t num_threads_;
+  std::vector<int> cpus_;
+  int numa_node_;
+  std::vector<int> numa_cpus_;
+};
+
+
+namespace detail
+{
+#ifdef VIENNACL_WITH_OPENMP
+  /** @brief Configuration of the thread team of an application thread. The default team is described by active_id == 0. */
+  struct host_team_state
+  {
+    long active_id;         ///< Identifier of the host context the team is configured for
+    int  default_threads;   ///< Number of OpenMP threads before the first change, or zero if unchanged
+#if defined(__linux__) && defined(CPU_SET)
+    std::vector<cpu_set_t> * default_masks;  ///< CPU masks of the threads of the team before they were first bound, or NULL if no thread is bound
+#endif
+  };
+
+  /** @brief Returns the configuration of the thread team of the calling thread */
+  inline host_team_state & current_host_team_state()
+  {
+#if defined(__linux__) && defined(CPU_SET)
+    static host_team_state state = {0, 0, NULL};
+#else
+    static host_team_state state = {0, 0};
+#endif
+    #pragma omp threadprivate(state)
+    return state;
+  }
+
+#if defined(__linux__) && defined(CPU_SET)
+  /** @brief Binds the calling thread and the workers of its OpenMP team to the CPUs of the host context.
+    *
+    * The CPU mask of thread i of the team is stored in default_masks[i] unless it has been stored before.
+    */
+  inline void bind_host_team(viennacl::host_context const & ctx, int team_size, std::vector<cpu_set_t> & default_masks)
+  {
+    std::vector<int> const & cpus = ctx.cpu_affinity();
+    vcl_size_t saved_masks = default_masks.size();
+    if (default_masks.size() < static_cast<vcl_size_t>(team_size))
+      default_masks.resize(static_cast<vcl_size_t>(team_size));
+
+    #pragma omp parallel num_threads(team_size)
+    {
+      vcl_size_t tid = static_cast<vcl_size_t>(omp_get_thread_num());
+      if (tid >= saved_masks)
+      {
+        CPU_ZERO(&default_masks[tid]);
+        sched_getaffinity(0, sizeof(cpu_set_t), &default_masks[tid]);
+      }
+
+      cpu_set_t mask;
+      CPU_ZERO(&mask);
+      CPU_SET(cpus[tid % cpus.size()], &mask);
+      sched_setaffinity(0, sizeof(mask), &mask);
+    }
+  }
+
+  /** @brief Restores the CPU masks of the calling thread and the workers of its OpenMP team saved by bind_host_team().
+    *
+    * Relies on the OpenMP runtime to assign the same threads to the same thread numbers for consecutive teams, as common runtimes do.
+    */
+  inline void restore_host_team(std::vector<cpu_set_t> const & default_masks)
+  {
+    #pragma omp parallel num_threads(static_cast<int>(default_masks.size()))
+    {
+      vcl_size_t tid = static_cast<vcl_size_t>(omp_get_thread_num());
+      if (tid < default_masks.size())
+        sched_setaffinity(0, sizeof(cpu_set_t), &default_masks[tid]);
+    }
+  }
+#endif
+
+  /** @brief Configures the thread team of the calling thread for the host context. A NULL pointer refers to the default team. Nothing is done if the team is already configured for the context. */
+  inline void activate_host_context(viennacl::host_context const * ctx)
+  {
+    host_team_state & state = current_host_team_state();
+    long id = ctx ? ctx->id() : 0;
+    if (id == state.active_id)
+      return;
+
+    int team_size = ctx ? static_cast<int>(ctx->team_size()) : 0;
+    if (team_size > 0)
+    {
+      if (state.default_threads == 0)
+        state.default_threads = omp_get_max_threads();
+      if (team_size != omp_get_max_threads())
+        omp_set_num_threads(team_size);
+    }
+    else if (state.default_threads > 0)
+    {
+      omp_set_num_threads(state.default_threads);
+      state.default_threads = 0;
+    }
+
+#if defined(__linux__) && defined(CPU_SET)
+    if (ctx && ctx->is_bound())
+    {
+      if (!state.default_masks)
+        state.default_masks = new std::vector<cpu_set_t>();
+      bind_host_team(*ctx, omp_get_max_threads(), *state.default_masks);
+    }
+    else if (state.default_masks)
+    {
+      restore_host_team(*state.default_masks);
+      delete state.default_masks;
+      state.default_masks = NULL;
+    }
+#endif
+
+    state.active_id = id;
+  }
+
+  /** @brief Resets the thread team of the calling thread to the default team if it is configured for the host context with the given identifier */
+  inline void deactivate_host_context(long id)
+  {
+    if (!omp_in_parallel() && current_host_team_state().active_id == id)
+      activate_host_context(NULL);
+  }
+#else
+  inline void deactivate_host_context(long) {}
+#endif
+
+  /** @brief Activates the thread team of a host context for the calling thread during the lifetime of the object.
+    *
+    * The team is configured with the number of threads and the CPU binding of the host context.
+    * The configuration is kept after the scope ends, so that consecutive scopes of the same context do not touch the team.
+    * A scope nested in a scope of a different context reactivates the context of the enclosing scope when it ends.
+    * A NULL pointer refers to the default host context, for which the default team of the calling thread is restored if needed.
+    */
+  class host_context_scope
+  {
+  public:
+    explicit host_context_scope(viennacl::host_context const * ctx) : previous_ctx_(NULL), entered_(false), nested_(false)
+    {
+#ifdef VIENNACL_WITH_OPENMP
+      if (omp_in_parallel())
+        return;
+
+      previous_ctx_ = active_ctx();
+      nested_ = (depth() > 0) && (ctx ? ctx->id() : 0) != current_host_team_state().active_id;
+      activate_host_context(ctx);
+      active_ctx() = ctx;
+      ++depth();
+      entered_ = true;
+#else
+      (void)ctx;
+#endif
+    }
+
+    ~host_context_scope()
+    {
+#ifdef VIENNACL_WITH_OPENMP
+      if (!entered_)
+        return;
+
+      --depth();
+      if (nested_)
+        activate_host_context(previous_ctx_);
+      active_ctx() = previous_ctx_;
+#endif
+    }
+
+  private:
+    host_context_scope(host_context_scope const &);
+    host_context_scope & operator=(host_context_scope const &);
+
+#ifdef VIENNACL_WITH_OPENMP
+    /** @brief Number of scopes of the calling thread currently alive */
+    static int & depth()
+    {
+      static int value = 0;
+      #pragma omp threadprivate(value)
+      return value;
+    }
+
+    /** @brief Host context of the innermost scope of the calling thread */
+    static viennacl::host_context const * & active_ctx()
+    {
+      static viennacl::host_context const * value = NULL;
+      #pragma omp threadprivate(value)
+      return value;
+    }
+#endif
+
+    viennacl::host_context const * previous_ctx_;
+    bool entered_;
+    bool nested_;
+  };
+}
+
+}
+
+#endif
@@ -0,0 +1,406 @@
+#ifndef VIENNACL_HOST_QUEUE_HPP_
+#define VIENNACL_HOST_QUEUE_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/host_queue.hpp
+    @brief Implementation of a command queue for the host backend, which records tasks and executes independent tasks concurrently.
+*/
+
+#include <vector>
+#include <map>
+#include <string>
+#include <stdexcept>
+#include <algorithm>
+#include <cassert>
+#include "viennacl/forwards.h"
+#include "viennacl/host_context.hpp"
+#include "viennacl/traits/handle.hpp"
+#include "viennacl/tools/shared_ptr.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace viennacl
+{
+
+/** @brief Describes the objects a task of a host_queue reads from and writes to.
+  *
+  * Objects are identified by their buffer in main memory, so any ViennaCL object with a handle (vectors, matrices, sparse matrices, scalars) can be passed.
+  * Dependencies between tasks are inferred from these accesses: A task waits for all earlier tasks writing to an object it reads (read-after-write),
+  * and for all earlier tasks reading or writing an object it writes to (write-after-read, write-after-write).
+  */
+class host_operands
+{
+  friend class host_queue;
+
+public:
+  /** @brief Declares that the task reads from the provided object */
+  template<typename T>
+  host_operands & reads(T const & obj)
+  {
+    reads_.push_back(key(obj));
+    return *this;
+  }
+
+  /** @brief Declares that the task writes to the provided object. Objects both read and written only need to be declared as written. */
+  template<typename T>
+  host_operands & writes(T const & obj)
+  {
+    writes_.push_back(key(obj));
+    return *this;
+  }
+
+private:
+  template<typename T>
+  static void const * key(T const & obj)
+  {
+    assert(viennacl::traits::active_handle_id(obj) == viennacl::MAIN_MEMORY && bool("Operands of a host_queue must reside in main memory!"));
+    return viennacl::traits::handle(obj).ram_handle().get();
+  }
+
+  std::vector<void const *> reads_;
+  std::vector<void const *> writes_;
+};
+
+
+namespace detail
+{
+  /** @brief Execution state of a task recorded in a host_queue */
+  enum host_task_status
+  {
+    HOST_TASK_PENDING,    ///< Not executed yet
+    HOST_TASK_COMPLETED,  ///< Executed successfully
+    HOST_TASK_FAILED,     ///< Threw an exception
+    HOST_TASK_SKIPPED     ///< Not executed, because a task it depends on failed or was skipped
+  };
+
+  /** @brief Interface of a task recorded in a host_queue */
+  class host_task_base
+  {
+  public:
+    host_task_base() : status_(HOST_TASK_PENDING), level_(0) {}
+    virtual ~host_task_base() {}
+
+    virtual void run() = 0;
+
+    host_task_status status() const { return status_; }
+    void status(host_task_status s) { status_ = s; }
+
+    bool pending() const { return status_ == HOST_TASK_PENDING; }
+    bool completed() const { return status_ == HOST_TASK_COMPLETED; }
+    bool failed() const { return status_ == HOST_TASK_FAILED || status_ == HOST_TASK_SKIPPED; }
+
+    /** @brief Index of the wave of independent tasks this task is executed in */
+    vcl_size_t level() const { return level_; }
+    void level(vcl_size_t l) { level_ = l; }
+
+    /** @brief Pending tasks producing data this task consumes. If one of them fails, this task is skipped. */
+    std::vector<host_task_base *> & inputs() { return inputs_; }
+
+  private:
+    host_task_status status_;
+    vcl_size_t level_;
+    std::vector<host_task_base *> inputs_;
+  };
+
+  /** @brief A task wrapping a copy of a user-provided functor */
+  template<typename FunctorT>
+  class host_task : public host_task_base
+  {
+  public:
+    host_task(FunctorT const & f) : f_(f) {}
+
+    void run() { f_(); }
+
+  private:
+    FunctorT f_;
+  };
+
+  /** @brief Shared state of a host_queue: pending tasks and the last accesses to each buffer */
+  class host_queue_state
+  {
+    typedef viennacl::tools::shared_ptr<host_task_base>    task_handle;
+
+    /** @brief Pending tasks accessing a buffer: the last writer and all readers since */
+    struct buffer_access
+    {
+      buffer_access() : last_writer(NULL) {}
+
+      host_task_base *               last_writer;
+      std::vector<host_task_base *>  readers;
+    };
+
+  public:
+    host_queue_state(viennacl::host_context const * ctx) : ctx_(ctx) {}
+
+    ~host_queue_state()
+    {
+      try { finish(); } catch (...) {}
+    }
+
+    /** @brief Records a task. Predecessors are pending tasks of this queue the task waits for explicitly.
+      *
+      * Read-after-write and write-after-write dependencies as well as explicit predecessors pass failures on, i.e. the task is skipped if one of these tasks fails.
+      * Write-after-read dependencies only order the tasks.
+      */
+    task_handle enqueue(host_task_base * task, std::vector<void const *> const & reads, std::vector<void const *> const & writes,
+                        std::vector<host_task_base *> const & predecessors)
+    {
+      task_handle t(task);
+      std::vector<host_task_base *> & inputs = task->inputs();
+
+      // the task runs in the wave after the latest wave of the tasks it depends on:
+      vcl_size_t level = 0;
+      for (vcl_size_t i=0; i<predecessors.size(); ++i)
+        if (predecessors[i]->pending())
+        {
+          level = std::max(level, predecessors[i]->level() + 1);
+          inputs.push_back(predecessors[i]);
+        }
+
+      for (vcl_size_t i=0; i<reads.size(); ++i)
+      {
+        buffer_access & access = accesses_[reads[i]];
+        if (access.last_writer)
+        {
+          level = std::max(level, access.last_writer->level() + 1);
+          inputs.push_back(access.last_writer);
+        }
+      }
+      for (vcl_size_t i=0; i<writes.size(); ++i)
+      {
+        buffer_access & access = accesses_[writes[i]];
+        if (access.last_writer)
+        {
+          level = std::max(level, access.last_writer->level() + 1);
+          inputs.push_back(access.last_writer);
+        }
+        for (vcl_size_t j=0; j<access.readers.size(); ++j)
+          level = std::max(level, access.readers[j]->level() + 1);
+      }
+      task->level(level);
+
+      // update accesses:
+      for (vcl_size_t i=0; i<reads.size(); ++i)
+        accesses_[reads[i]].readers.push_back(task);
+      for (vcl_size_t i=0; i<writes.size(); ++i)
+      {
+        buffer_access & access = accesses_[writes[i]];
+        access.last_writer = task;
+        access.readers.clear();
+      }
+
+      pending_.push_back(t);
+      return t;
+    }
+
+    /** @brief Executes all pending tasks. Independent tasks are executed concurrently by the threads of the team, each running its own operations single-threaded.
+      *
+      * If a task throws, all tasks depending on it (directly or transitively) are skipped, while all other tasks are still executed.
+      * An exception is thrown after all tasks have been processed.
+      */
+    void finish()
+    {
+      if (pending_.size() == 0)
+        return;
+
+      // take over the pending tasks, so that tasks may enqueue new tasks:
+      std::vector<task_handle> tasks;
+      tasks.swap(pending_);
+      accesses_.clear();
+
+      vcl_size_t num_levels = 0;
+      for (vcl_size_t i=0; i<tasks.size(); ++i)
+        num_levels = std::max(num_levels, tasks[i]->level() + 1);
+
+      std::vector<std::vector<host_task_base *> > waves(num_levels);
+      for (vcl_size_t i=0; i<tasks.size(); ++i)
+        waves[tasks[i]->level()].push_back(tasks[i].get());
+
+      viennacl::detail::host_context_scope scope(ctx_);
+
+      bool failed = false;
+      std::string what;
+      for (vcl_size_t l=0; l<waves.size(); ++l)
+      {
+        std::vector<host_task_base *> wave;
+        for (vcl_size_t i=0; i<waves[l].size(); ++i)
+        {
+          // the inputs of a task are in earlier waves, hence already processed:
+          host_task_base * task = waves[l][i];
+          bool skip = false;
+          for (vcl_size_t j=0; j<task->inputs().size(); ++j)
+            skip = skip || task->inputs()[j]->failed();
+          std::vector<host_task_base *>().swap(task->inputs());
+
+          if (skip || !task->pending())
+            task->status(HOST_TASK_SKIPPED);
+          else
+            wave.push_back(task);
+        }
+
+        if (wave.size() == 1) // a single task uses the whole team
+          run_task(wave[0], failed, what);
+        else if (wave.size() > 1)
+        {
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for schedule(dynamic, 1)
+#endif
+          for (long i=0; i<static_cast<long>(wave.size()); ++i)
+            run_task(wave[static_cast<vcl_size_t>(i)], failed, what);
+        }
+      }
+
+      if (failed)
+        throw std::runtime_error("Task in host_queue failed: " + what);
+    }
+
+    vcl_size_t size() const { return pending_.size(); }
+
+  private:
+    static void run_task(host_task_base * task, bool & failed, std::string & what)
+    {
+      try
+      {
+        task->run();
+        task->status(HOST_TASK_COMPLETED);
+      }
+      catch (std::exception const & e)
+      {
+        task->status(HOST_TASK_FAILED);
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp critical (viennacl_host_queue_error)
+#endif
+        { failed = true; what = e.what(); }
+      }
+      catch (...)
+      {
+        task->status(HOST_TASK_FAILED);
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp critical (viennacl_host_queue_error)
+#endif
+        { failed = true; what = "unknown exception"; }
+      }
+    }
+
+    viennacl::host_context const * ctx_;
+    std::vector<task_handle> pending_;
+    std::map<void const *, buffer_access> accesses_;
+  };
+}
+
+
+/** @brief An event referring to a task in a host_queue. */
+class host_event
+{
+  friend class host_queue;
+
+public:
+  host_event() {}
+
+  /** @brief Returns true if the task has been executed successfully */
+  bool completed() const { return !task_.get() || task_->completed(); }
+
+  /** @brief Returns true if the task threw an exception or was skipped because a task it depends on failed */
+  bool failed() const { return task_.get() && task_->failed(); }
+
+  /** @brief Blocks until the task has been processed. All pending tasks of the queue are executed, and an exception is thrown if one of them fails. */
+  void wait() const
+  {
+    if (task_.get() && task_->pending())
+      state_->finish();
+  }
+
+private:
+  host_event(viennacl::tools::shared_ptr<detail::host_task_base> const & t,
+             viennacl::tools::shared_ptr<detail::host_queue_state> const & s) : task_(t), state_(s) {}
+
+  viennacl::tools::shared_ptr<detail::host_task_base>    task_;
+  viennacl::tools::shared_ptr<detail::host_queue_state>  state_;
+};
+
+
+/** @brief A command queue for the host backend.
+  *
+  * Tasks are functors (providing 'void operator()()') recorded together with the objects they read and write.
+  * Execution is deferred until finish() is called on the queue or wait() is called on an event, at which point independent tasks are executed concurrently.
+  * This allows independent work such as the setup of a preconditioner and a sparse matrix-vector product to share the cores.
+  * All ViennaCL operations called directly (i.e. not as part of a task) are executed immediately on an implicit default queue, so existing code is not affected.
+  *
+  * The operands of the tasks must remain valid until the tasks have been executed. A host_queue must not be used from several threads concurrently.
+  */
+class host_queue
+{
+public:
+  /** @brief Creates a queue using the default thread team */
+  host_queue() : state_(new detail::host_queue_state(NULL)) {}
+
+  /** @brief Creates a queue executing its tasks with the thread team of the provided host context */
+  explicit host_queue(viennacl::host_context const & ctx) : state_(new detail::host_queue_state(&ctx)) {}
+
+  /** @brief Records a task, which is executed after all earlier tasks accessing the same objects in a conflicting way. */
+  template<typename FunctorT>
+  host_event enqueue(FunctorT const & f, host_operands const & operands = host_operands())
+  {
+    return enqueue(f, operands, std::vector<host_event>());
+  }
+
+  /** @brief Records a task, which additionally waits for the tasks referred to by the provided events. */
+  template<typename FunctorT>
+  host_event enqueue(FunctorT const & f, host_operands const & operands, std::vector<host_event> const & wait_list)
+  {
+    std::vector<detail::host_task_base *> predecessors;
+    bool skip = false;
+    for (vcl_size_t i=0; i<wait_list.size(); ++i)
+    {
+      if (wait_list[i].state_.get() != state_.get())  // events of other queues are resolved right away
+        wait_list[i].wait();
+      if (wait_list[i].failed())
+        skip = true;
+      else if (!wait_list[i].completed())
+        predecessors.push_back(wait_list[i].task_.get());
+    }
+
+    detail::host_task_base * task = new detail::host_task<FunctorT>(f);
+    if (skip)  // a task waited for failed in an earlier finish(). Tasks reading the results of this task are skipped as well.
+      task->status(detail::HOST_TASK_SKIPPED);
+    return host_event(state_->enqueue(task, operands.reads_, operands.writes_, predecessors), state_);
+  }
+
+  /** @brief Executes all pending tasks and returns after all of them have completed */
+  void finish() { state_->finish(); }
+
+  /** @brief Returns the number of tasks not executed yet */
+  vcl_size_t pending() const { return state_->size(); }
+
+private:
+  viennacl::tools::shared_ptr<detail::host_queue_state>  state_;
+};
+
+/** @brief Returns the default host queue, which is synchronized by viennacl::backend::finish() */
+inline host_queue & default_host_queue()
+{
+  static host_queue queue;
+  return queue;
+}
+
+}
+
+#endif
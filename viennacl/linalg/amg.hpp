@@ -35,12 +35,18 @@
 #include <cmath>
 #include "viennacl/forwards.h"
 #include "viennacl/tools/tools.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/direct_solve.hpp"
+#include "viennacl/linalg/iterative_operations.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
 
 #include "viennacl/linalg/detail/amg/amg_base.hpp"
 #include "viennacl/linalg/detail/amg/amg_coarse.hpp"
 #include "viennacl/linalg/detail/amg/amg_interpol.hpp"
+#include "viennacl/linalg/detail/amg/amg_smooth.hpp"
+#include "viennacl/linalg/detail/amg/amg_sa.hpp"
 
 #include <map>
 
@@ -134,6 +140,77 @@ void amg_setup(InternalT1 & A, InternalT1 & P, InternalT2 & pointvector, amg_tag
   tag.set_coarselevels(i);
 }
 
+/** @brief Setup smoothed aggregation AMG with MIS-2 aggregation (VIENNACL_AMG_COARSE_MIS2)
+*
+*  Aggregates and sparsity patterns stored in 'levels' are reused if the sparsity pattern of the finest operator did not change since the last setup.
+*
+* @param A            Operator matrices on all levels
+* @param P            Prolongation/Interpolation operators on all levels
+* @param levels       Aggregates and sparsity patterns on all levels
+* @param tag          AMG preconditioner tag
+*/
+template<typename InternalT1, typename NumericT>
+void amg_setup_sa(InternalT1 & A, InternalT1 & P, std::vector<detail::amg::amg_sa_level<NumericT> > & levels, amg_tag & tag)
+{
+  unsigned int i, iterations;
+
+  iterations = tag.get_coarselevels();
+  if (iterations == 0)
+    iterations = VIENNACL_AMG_MAX_LEVELS;
+
+  levels.resize(iterations + 1);
+
+  // Reuse previous hierarchy only if the sparsity pattern of the system matrix is unchanged
+  detail::amg::amg_csr_matrix<NumericT> A0;
+  detail::amg::amg_csr_from_setup(A[0], A0);
+  bool reuse = levels[0].valid_
+               && levels[0].A_.row_buffer_ == A0.row_buffer_
+               && levels[0].A_.col_buffer_ == A0.col_buffer_;
+  std::swap(levels[0].A_, A0);
+
+  // Near-nullspace on the finest level. The constant vector is used if none is provided.
+  unsigned int num_vectors = tag.get_nullspace_vectors();
+  std::vector<NumericT> nullspace(tag.get_nullspace().begin(), tag.get_nullspace().end());
+  std::vector<NumericT> coarse_nullspace;
+  if (num_vectors == 0)
+  {
+    num_vectors = 1;
+    nullspace.clear();
+  }
+  levels[0].block_size_ = tag.get_block_size();
+
+  for (i=0; i<iterations; ++i)
+  {
+    levels[i].valid_ = levels[i].valid_ && reuse;
+
+    vcl_size_t coarse_size = detail::amg::amg_sa_coarsen(i, levels[i], levels[i+1].A_, nullspace, num_vectors, coarse_nullspace, tag);
+
+    // Stop routine when no further coarsening is possible. Coarsest level is level i.
+    if (coarse_size == 0)
+      break;
+
+    detail::amg::amg_csr_to_setup(levels[i].P_, P[i]);
+    detail::amg::amg_csr_to_setup(levels[i+1].A_, A[i+1]);
+
+    // Unknowns of one aggregate form a node on the coarse level
+    levels[i+1].block_size_ = num_vectors;
+    nullspace.swap(coarse_nullspace);
+
+    #ifdef VIENNACL_AMG_DEBUG
+    std::cout << "Coarse Grid Operator Matrix:" << std::endl;
+    printmatrix (A[i+1]);
+    #endif
+
+    // If Limit of coarse points is reached then stop. Coarsest level is level i+1.
+    if (tag.get_coarselevels() == 0 && coarse_size <= VIENNACL_AMG_COARSE_LIMIT)
+    {
+      tag.set_coarselevels(i+1);
+      return;
+    }
+  }
+  tag.set_coarselevels(i);
+}
+
 /** @brief Initialize AMG preconditioner
 *
 * @param mat          System matrix
@@ -367,6 +444,10 @@ class amg_precond
   mutable boost::numeric::ublas::vector<VectorType> rhs_;
   mutable boost::numeric::ublas::vector<VectorType> residual_;
 
+  mutable std::vector<detail::amg::amg_level_csr<NumericType> > levels_;
+
+  std::vector<detail::amg::amg_sa_level<NumericType> > sa_levels_;
+
   mutable bool done_init_apply_;
 
   amg_tag tag_;
@@ -387,12 +468,30 @@ public:
     done_init_apply_ = false;
   }
 
+  /** @brief Replaces the system matrix, e.g. in a nonlinear or time-dependent simulation. Call setup() afterwards.
+  *
+  *  With VIENNACL_AMG_COARSE_MIS2, aggregates and the sparsity patterns of all operators are reused if the sparsity pattern of the matrix did not change.
+  *
+  * @param mat  System matrix
+  */
+  void update_matrix(MatrixT const & mat)
+  {
+    amg_init (mat, A_setup_, P_setup_, pointvector_, tag_);
+
+    done_init_apply_ = false;
+  }
+
   /** @brief Start setup phase for this class and copy data structures.
   */
   void setup()
   {
+    viennacl::detail::host_context_scope scope(NULL);
+
     // Start setup phase.
-    amg_setup(A_setup_, P_setup_, pointvector_, tag_);
+    if (tag_.get_coarse() == VIENNACL_AMG_COARSE_MIS2)
+      amg_setup_sa(A_setup_, P_setup_, sa_levels_, tag_);
+    else
+      amg_setup(A_setup_, P_setup_, pointvector_, tag_);
     // Transform to CPU-Matrixtype for precondition phase.
     amg_transform_cpu(A_, P_, R_, A_setup_, P_setup_, tag_);
 
@@ -401,12 +500,19 @@ public:
 
   /** @brief Prepare data structures for preconditioning:
    *  Build data structures for precondition phase.
+   *  Copy operators to CSR arrays and precompute smoother data on all but the coarsest level.
    *  Do LU factorization on coarsest level.
   */
   void init_apply() const
   {
+    viennacl::detail::host_context_scope scope(NULL);
+
     // Setup precondition phase (Data structures).
     amg_setup_apply(result_, rhs_, residual_, A_setup_, tag_);
+    // Setup smoothers. No memory is allocated in apply() afterwards.
+    levels_.resize(tag_.get_coarselevels());
+    for (unsigned int level=0; level < tag_.get_coarselevels(); ++level)
+      detail::amg::amg_level_init(levels_[level], A_setup_[level], tag_);
     // Do LU factorization for direct solve.
     amg_lu(op_, permutation_, A_setup_[tag_.get_coarselevels()]);
 
@@ -442,6 +548,15 @@ public:
     return static_cast<NumericType>(nonzero) / static_cast<NumericType>(systemmat_nonzero);
   }
 
+  /** @brief Returns the grid complexity, i.e. the sum of the number of unknowns on all levels divided by the number of unknowns on the finest level. */
+  NumericType calc_grid_complexity() const
+  {
+    vcl_size_t unknowns = 0;
+    for (unsigned int level=0; level < tag_.get_coarselevels()+1; ++level)
+      unknowns += A_setup_[level].size1();
+    return static_cast<NumericType>(unknowns) / static_cast<NumericType>(A_setup_[0].size1());
+  }
+
   /** @brief Precondition Operation
   *
   * @param vec The vector to which preconditioning is applied to (ublas version)
@@ -453,16 +568,17 @@ public:
     if (!done_init_apply_)
       init_apply();
 
+    viennacl::detail::host_context_scope scope(NULL);
     int level;
 
     // Precondition operation (Yang, p.3)
-    rhs_[0] = vec;
+    std::copy(vec.begin(), vec.end(), rhs_[0].begin());
     for (level=0; level<static_cast<int>(tag_.get_coarselevels()); level++)
     {
       result_[level].clear();
 
       // Apply Smoother presmooth_ times.
-      smooth_jacobi (level, tag_.get_presmooth(), result_[level], rhs_[level]);
+      smooth(level, tag_.get_presmooth(), result_[level], rhs_[level]);
 
       #ifdef VIENNACL_AMG_DEBUG
       std::cout << "After presmooth:" << std::endl;
@@ -470,7 +586,7 @@ public:
       #endif
 
       // Compute residual.
-      residual_[level] = rhs_[level] - boost::numeric::ublas::prod(A_[level], result_[level]);
+      detail::amg::amg_residual(levels_[level], &(result_[level][0]), &(rhs_[level][0]), &(residual_[level][0]));
 
       #ifdef VIENNACL_AMG_DEBUG
       std::cout << "Residual:" << std::endl;
@@ -478,7 +594,7 @@ public:
       #endif
 
       // Restrict to coarse level. Restricted residual is RHS of coarse level.
-      rhs_[level+1] = boost::numeric::ublas::prod(R_[level], residual_[level]);
+      boost::numeric::ublas::axpy_prod(R_[level], residual_[level], rhs_[level+1], true);
 
       #ifdef VIENNACL_AMG_DEBUG
       std::cout << "Restricted Residual: " << std::endl;
@@ -503,7 +619,7 @@ public:
       #endif
 
       // Interpolate error to fine level. Correct solution by adding error.
-      result_[level] += boost::numeric::ublas::prod(P_[level], result_[level+1]);
+      boost::numeric::ublas::axpy_prod(P_[level], result_[level+1], result_[level], false);
 
       #ifdef VIENNACL_AMG_DEBUG
       std::cout << "Corrected Result: " << std::endl;
@@ -511,14 +627,29 @@ public:
       #endif
 
       // Apply Smoother postsmooth_ times.
-      smooth_jacobi(level, tag_.get_postsmooth(), result_[level], rhs_[level]);
+      smooth(level, tag_.get_postsmooth(), result_[level], rhs_[level], true);
 
       #ifdef VIENNACL_AMG_DEBUG
       std::cout << "After postsmooth: " << std::endl;
       printvector(result_[level]);
       #endif
     }
-    vec = result_[0];
+    std::copy(result_[0].begin(), result_[0].end(), vec.begin());
+  }
+
+  /** @brief Applies the smoother selected in the AMG tag (CPU version). Uses the data precomputed in init_apply() and does not allocate memory.
+  * @param level       Coarse level to which smoother is applied to
+  * @param iterations  Number of smoother iterations
+  * @param x           The vector smoothing is applied to
+  * @param rhs_smooth  The right hand side of the equation for the smoother
+  * @param postsmooth  Whether the smoother is applied after the coarse grid correction
+  */
+  template<typename VectorT>
+  void smooth(int level, unsigned int iterations, VectorT & x, VectorT const & rhs_smooth, bool postsmooth = false) const
+  {
+    viennacl::detail::host_context_scope scope(NULL);
+    if (x.size() > 0)
+      detail::amg::amg_smooth(levels_[static_cast<vcl_size_t>(level)], tag_, iterations, &(x[0]), &(rhs_smooth[0]), postsmooth);
   }
 
   /** @brief (Weighted) Jacobi Smoother (CPU version)
@@ -530,32 +661,14 @@ public:
   template<typename VectorT>
   void smooth_jacobi(int level, int const iterations, VectorT & x, VectorT const & rhs_smooth) const
   {
-    VectorT old_result(x.size());
-    long index;
+    if (!done_init_apply_)
+      init_apply();
 
-    for (int i=0; i<iterations; ++i)
-    {
-      old_result = x;
-      x.clear();
-#ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for
-#endif
-      for (index=0; index < static_cast<long>(A_setup_[level].size1()); ++index)
-      {
-        InternalConstRowIterator row_iter = A_setup_[level].begin1();
-        row_iter += index;
-        NumericType sum  = 0;
-        NumericType diag = 1;
-        for (InternalConstColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
-        {
-          if (col_iter.index1() == col_iter.index2())
-            diag = *col_iter;
-          else
-            sum += *col_iter * old_result[col_iter.index2()];
-        }
-        x[index]= static_cast<NumericType>(tag_.get_jacobiweight()) * (rhs_smooth[index] - sum) / diag + (1-static_cast<NumericType>(tag_.get_jacobiweight())) * old_result[index];
-      }
-    }
+    viennacl::detail::host_context_scope scope(NULL);
+    if (x.size() > 0)
+      detail::amg::amg_smooth_jacobi(levels_[static_cast<vcl_size_t>(level)], levels_[static_cast<vcl_size_t>(level)].diag_inv_,
+                                     static_cast<NumericType>(tag_.get_jacobiweight()), static_cast<unsigned int>(iterations),
+                                     &(x[0]), &(rhs_smooth[0]));
   }
 
   amg_tag & tag() { return tag_; }
@@ -592,6 +705,16 @@ class amg_precond< compressed_matrix<NumericT, AlignmentV> >
   mutable boost::numeric::ublas::vector<VectorType> rhs_;
   mutable boost::numeric::ublas::vector<VectorType> residual_;
 
+  // Smoother data: CSR operators for host-based smoothing, inverse (l1-)diagonals and work vectors for all other backends
+  mutable std::vector<detail::amg::amg_level_csr<NumericT> > levels_;
+  mutable boost::numeric::ublas::vector<VectorType> diag_inv_;
+  mutable boost::numeric::ublas::vector<VectorType> work1_;
+  mutable boost::numeric::ublas::vector<VectorType> work2_;
+  mutable boost::numeric::ublas::vector<VectorType> work3_;
+  mutable boost::numeric::ublas::vector<NumericT>   coarse_cpu_;
+
+  std::vector<detail::amg::amg_sa_level<NumericT> > sa_levels_;
+
   viennacl::context ctx_;
 
   mutable bool done_init_apply_;
@@ -621,12 +744,33 @@ public:
     done_init_apply_ = false;
   }
 
+  /** @brief Replaces the system matrix, e.g. in a nonlinear or time-dependent simulation. Call setup() afterwards.
+  *
+  *  With VIENNACL_AMG_COARSE_MIS2, aggregates and the sparsity patterns of all operators are reused if the sparsity pattern of the matrix did not change.
+  *
+  * @param mat  System matrix
+  */
+  void update_matrix(compressed_matrix<NumericT, AlignmentV> const & mat)
+  {
+    std::vector<std::map<unsigned int, NumericT> > mat2 = std::vector<std::map<unsigned int, NumericT> >(mat.size1());
+    viennacl::copy(mat, mat2);
+    amg_init (mat2, A_setup_, P_setup_, pointvector_, tag_);
+
+    done_init_apply_ = false;
+  }
+
   /** @brief Start setup phase for this class and copy data structures.
   */
   void setup()
   {
+    // The setup runs on the host, using the thread team of the system matrix if it resides in main memory:
+    viennacl::detail::host_context_scope scope(ctx_.host_context_ptr());
+
     // Start setup phase.
-    amg_setup(A_setup_, P_setup_, pointvector_, tag_);
+    if (tag_.get_coarse() == VIENNACL_AMG_COARSE_MIS2)
+      amg_setup_sa(A_setup_, P_setup_, sa_levels_, tag_);
+    else
+      amg_setup(A_setup_, P_setup_, pointvector_, tag_);
     // Transform to GPU-Matrixtype for precondition phase.
     amg_transform_gpu(A_, P_, R_, A_setup_, P_setup_, tag_, ctx_);
 
@@ -639,10 +783,43 @@ public:
   */
   void init_apply() const
   {
+    viennacl::detail::host_context_scope scope(ctx_.host_context_ptr());
+
     // Setup precondition phase (Data structures).
     amg_setup_apply(result_, rhs_, residual_, A_setup_, tag_, ctx_);
+
+    // Setup smoothers. No memory is allocated in apply() afterwards.
+    unsigned int levels = tag_.get_coarselevels();
+    levels_.resize(levels);
+    diag_inv_.resize(levels);
+    work1_.resize(levels);
+    work2_.resize(levels);
+    work3_.resize(levels);
+    for (unsigned int level=0; level < levels; ++level)
+    {
+      detail::amg::amg_level_init(levels_[level], A_setup_[level], tag_);
+      work1_[level] = VectorType(A_setup_[level].size1(), ctx_);
+
+      if (ctx_.memory_type() != viennacl::MAIN_MEMORY)
+      {
+        // Gauss-Seidel smoothers are not available on the device. l1-Jacobi is used instead.
+        bool use_l1 = (tag_.get_smoother() != VIENNACL_AMG_SMOOTHER_JACOBI && tag_.get_smoother() != VIENNACL_AMG_SMOOTHER_CHEBYSHEV);
+        diag_inv_[level] = VectorType(A_setup_[level].size1(), ctx_);
+        viennacl::copy(use_l1 ? levels_[level].l1_diag_inv_ : levels_[level].diag_inv_, diag_inv_[level]);
+        work2_[level] = VectorType(A_setup_[level].size1(), ctx_);
+        if (tag_.get_smoother() == VIENNACL_AMG_SMOOTHER_CHEBYSHEV)
+          work3_[level] = VectorType(A_setup_[level].size1(), ctx_);
+
+        // Only the eigenvalue estimate is needed on the host:
+        NumericT lambda_max = levels_[level].lambda_max_;
+        levels_[level] = detail::amg::amg_level_csr<NumericT>();
+        levels_[level].lambda_max_ = lambda_max;
+      }
+    }
+    coarse_cpu_.resize(A_setup_[levels].size1());
+
     // Do LU factorization for direct solve.
-    amg_lu(op_, permutation_, A_setup_[tag_.get_coarselevels()]);
+    amg_lu(op_, permutation_, A_setup_[levels]);
 
     done_init_apply_ = true;
   }
@@ -676,6 +853,15 @@ public:
     return nonzero/static_cast<double>(systemmat_nonzero);
   }
 
+  /** @brief Returns the grid complexity, i.e. the sum of the number of unknowns on all levels divided by the number of unknowns on the finest level. */
+  NumericT calc_grid_complexity() const
+  {
+    vcl_size_t unknowns = 0;
+    for (unsigned int level=0; level < tag_.get_coarselevels()+1; ++level)
+      unknowns += A_[level].size1();
+    return static_cast<NumericT>(unknowns) / static_cast<NumericT>(A_[0].size1());
+  }
+
   /** @brief Precondition Operation
   *
   * @param vec The vector to which preconditioning is applied to
@@ -695,7 +881,7 @@ public:
       result_[level].clear();
 
       // Apply Smoother presmooth_ times.
-      smooth_jacobi(level, tag_.get_presmooth(), result_[level], rhs_[level]);
+      smooth(level, tag_.get_presmooth(), result_[level], rhs_[level]);
 
       #ifdef VIENNACL_AMG_DEBUG
       std::cout << "After presmooth: " << std::endl;
@@ -724,12 +910,9 @@ public:
 
     // On highest level use direct solve to solve equation (on the CPU)
     //TODO: Use GPU direct solve!
-    result_[level] = rhs_[level];
-    boost::numeric::ublas::vector<NumericT> result_cpu(result_[level].size());
-
-    viennacl::copy(result_[level], result_cpu);
-    boost::numeric::ublas::lu_substitute(op_, permutation_, result_cpu);
-    viennacl::copy(result_cpu, result_[level]);
+    viennacl::copy(rhs_[level], coarse_cpu_);
+    boost::numeric::ublas::lu_substitute(op_, permutation_, coarse_cpu_);
+    viennacl::copy(coarse_cpu_, result_[level]);
 
     #ifdef VIENNACL_AMG_DEBUG
     std::cout << "After direct solve: " << std::endl;
@@ -746,7 +929,8 @@ public:
       #endif
 
       // Interpolate error to fine level and correct solution.
-      result_[level] += viennacl::linalg::prod(P_[level], result_[level+1]);
+      work1_[level] = viennacl::linalg::prod(P_[level], result_[level+1]);
+      result_[level] += work1_[level];
 
       #ifdef VIENNACL_AMG_DEBUG
       std::cout << "Corrected Result: " << std::endl;
@@ -754,7 +938,7 @@ public:
       #endif
 
       // Apply Smoother postsmooth_ times.
-      smooth_jacobi(level, tag_.get_postsmooth(), result_[level], rhs_[level]);
+      smooth(level, tag_.get_postsmooth(), result_[level], rhs_[level], true);
 
       #ifdef VIENNACL_AMG_DEBUG
       std::cout << "After postsmooth: " << std::endl;
@@ -764,7 +948,43 @@ public:
     vec = result_[0];
   }
 
-  /** @brief Jacobi Smoother (GPU version)
+  /** @brief Applies the smoother selected in the AMG tag. Uses the data precomputed in init_apply() and does not allocate memory.
+  *
+  * Host-based smoothing runs directly on the CSR arrays of the level. On other backends, Gauss-Seidel smoothers are replaced by l1-Jacobi.
+  *
+  * @param level       Coarse level to which smoother is applied to
+  * @param iterations  Number of smoother iterations
+  * @param x           The vector smoothing is applied to
+  * @param rhs_smooth  The right hand side of the equation for the smoother
+  * @param postsmooth  Whether the smoother is applied after the coarse grid correction
+  */
+  template<typename VectorT>
+  void smooth(vcl_size_t level, unsigned int iterations, VectorT & x, VectorT const & rhs_smooth, bool postsmooth = false) const
+  {
+    if (iterations == 0)
+      return;
+
+    if (!done_init_apply_)
+      init_apply();
+
+    if (ctx_.memory_type() == viennacl::MAIN_MEMORY)
+    {
+      viennacl::detail::host_context_scope scope(ctx_.host_context_ptr());
+      detail::amg::amg_smooth(levels_[level], tag_, iterations,
+                              viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(x),
+                              viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(rhs_smooth), postsmooth);
+      return;
+    }
+
+    if (tag_.get_smoother() == VIENNACL_AMG_SMOOTHER_CHEBYSHEV)
+      smooth_chebyshev(level, iterations, x, rhs_smooth);
+    else if (tag_.get_smoother() == VIENNACL_AMG_SMOOTHER_JACOBI)
+      smooth_jacobi(level, iterations, x, rhs_smooth);
+    else // l1-Jacobi
+      smooth_jacobi(level, iterations, x, rhs_smooth, NumericT(1));
+  }
+
+  /** @brief (Weighted) Jacobi Smoother. Runs on the CSR arrays of the level for vectors in main memory.
   * @param level       Coarse level to which smoother is applied to
   * @param iterations  Number of smoother iterations
   * @param x           The vector smoothing is applied to
@@ -773,27 +993,98 @@ public:
   template<typename VectorT>
   void smooth_jacobi(vcl_size_t level, unsigned int iterations, VectorT & x, VectorT const & rhs_smooth) const
   {
-    VectorType old_result = x;
+    if (!done_init_apply_)
+      init_apply();
 
-    viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(x).context());
-    viennacl::linalg::opencl::kernels::compressed_matrix<NumericT>::init(ctx);
-    viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::compressed_matrix<NumericT>::program_name(), "jacobi");
+    if (ctx_.memory_type() == viennacl::MAIN_MEMORY)
+    {
+      assert(viennacl::traits::start(x) == 0 && viennacl::traits::stride(x) == 1 && viennacl::traits::start(rhs_smooth) == 0 && viennacl::traits::stride(rhs_smooth) == 1
+             && bool("Jacobi smoother requires vectors without offset and stride"));
+      viennacl::detail::host_context_scope scope(ctx_.host_context_ptr());
+      detail::amg::amg_smooth_jacobi(levels_[level], levels_[level].diag_inv_, static_cast<NumericT>(tag_.get_jacobiweight()), iterations,
+                                     viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(x),
+                                     viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(rhs_smooth));
+      return;
+    }
 
-    for (unsigned int i=0; i<iterations; ++i)
+#ifdef VIENNACL_WITH_OPENCL
+    if (ctx_.memory_type() == viennacl::OPENCL_MEMORY)
     {
-      if (i > 0)
+      VectorType & old_result = work2_[level];
+
+      viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(x).context());
+      viennacl::linalg::opencl::kernels::compressed_matrix<NumericT>::init(ctx);
+      viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::compressed_matrix<NumericT>::program_name(), "jacobi");
+
+      for (unsigned int i=0; i<iterations; ++i)
+      {
         old_result = x;
-      x.clear();
-      viennacl::ocl::enqueue(k(A_[level].handle1().opencl_handle(), A_[level].handle2().opencl_handle(), A_[level].handle().opencl_handle(),
-                              static_cast<NumericT>(tag_.get_jacobiweight()),
-                              viennacl::traits::opencl_handle(old_result),
-                              viennacl::traits::opencl_handle(x),
-                              viennacl::traits::opencl_handle(rhs_smooth),
-                              static_cast<cl_uint>(rhs_smooth.size())));
+        x.clear();
+        viennacl::ocl::enqueue(k(A_[level].handle1().opencl_handle(), A_[level].handle2().opencl_handle(), A_[level].handle().opencl_handle(),
+                                static_cast<NumericT>(tag_.get_jacobiweight()),
+                                viennacl::traits::opencl_handle(old_result),
+                                viennacl::traits::opencl_handle(x),
+                                viennacl::traits::opencl_handle(rhs_smooth),
+                                static_cast<cl_uint>(rhs_smooth.size())));
+      }
+      return;
+    }
+#endif
+    smooth_jacobi(level, iterations, x, rhs_smooth, static_cast<NumericT>(tag_.get_jacobiweight()));
+  }
 
+private:
+  /** @brief Backend-agnostic (weighted) Jacobi smoother x <- x + omega * D^{-1} (rhs - A x), where D^{-1} is given by diag_inv_[level]. */
+  template<typename VectorT>
+  void smooth_jacobi(vcl_size_t level, unsigned int iterations, VectorT & x, VectorT const & rhs_smooth, NumericT omega) const
+  {
+    VectorType & r = work1_[level];
+    for (unsigned int i=0; i<iterations; ++i)
+    {
+      r = viennacl::linalg::prod(A_[level], x);
+      r = rhs_smooth - r;
+      r = viennacl::linalg::element_prod(diag_inv_[level], r);
+      x += omega * r;
     }
   }
 
+  /** @brief Backend-agnostic Chebyshev smoother, cf. detail::amg::amg_smooth_chebyshev() */
+  template<typename VectorT>
+  void smooth_chebyshev(vcl_size_t level, unsigned int iterations, VectorT & x, VectorT const & rhs_smooth) const
+  {
+    VectorType & r  = work1_[level];
+    VectorType & d  = work2_[level];
+    VectorType & Ad = work3_[level];
+
+    NumericT upper = NumericT(1.1) * levels_[level].lambda_max_;
+    NumericT lower = upper / static_cast<NumericT>(tag_.get_chebyshev_ratio());
+    NumericT theta = (upper + lower) / NumericT(2);
+    NumericT delta = (upper - lower) / NumericT(2);
+    NumericT sigma = theta / delta;
+
+    for (unsigned int i=0; i<iterations; ++i)
+    {
+      NumericT rho = NumericT(1) / sigma;
+
+      r = viennacl::linalg::prod(A_[level], x);
+      r = rhs_smooth - r;
+      d = viennacl::linalg::element_prod(diag_inv_[level], r);
+      d /= theta;
+
+      // residual by recurrence, hence only one matrix-vector product and one fused vector update per step:
+      for (unsigned int k=1; k<tag_.get_chebyshev_degree(); ++k)
+      {
+        NumericT rho_new = NumericT(1) / (NumericT(2) * sigma - rho);
+
+        Ad = viennacl::linalg::prod(A_[level], d);
+        viennacl::linalg::chebyshev_vector_update(x, r, d, Ad, rho_new * rho, NumericT(2) * rho_new / delta, &(diag_inv_[level]));
+        rho = rho_new;
+      }
+      x += d;
+    }
+  }
+
+public:
   amg_tag & tag() { return tag_; }
 };
 
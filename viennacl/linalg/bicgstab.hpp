@@ -36,6 +36,7 @@
 #include "viennacl/traits/context.hpp"
 #include "viennacl/meta/result_of.hpp"
 #include "viennacl/linalg/iterative_operations.hpp"
+#include "viennacl/linalg/detail/iterative_solver_support.hpp"
 
 namespace viennacl
 {
@@ -86,22 +87,53 @@ private:
 
 namespace detail
 {
-  /** @brief Implementation of a pipelined stabilized Bi-conjugate gradient solver */
+  /** @brief Buffers of the stabilized Bi-conjugate gradient solver, which are kept by bicgstab_solver between solver runs */
+  template<typename VectorT>
+  class bicgstab_workspace
+  {
+  public:
+    VectorT residual;
+    VectorT r0star;
+    VectorT p;
+    VectorT s;
+    VectorT tmp0;
+    VectorT tmp1;
+  };
+
+  /** @brief Buffers of the stabilized Bi-conjugate gradient solver for ViennaCL vectors, including the buffers of the pipelined implementation */
+  template<typename NumericT>
+  class bicgstab_workspace< viennacl::vector<NumericT> >
+  {
+  public:
+    viennacl::vector<NumericT> residual;
+    viennacl::vector<NumericT> r0star;
+    viennacl::vector<NumericT> p;
+    viennacl::vector<NumericT> s;
+    viennacl::vector<NumericT> tmp0;
+    viennacl::vector<NumericT> tmp1;
+    viennacl::vector<NumericT> inner_prod_buffer;
+    std::vector<NumericT>      host_inner_prod_buffer;
+  };
+
+  /** @brief Implementation of a pipelined stabilized Bi-conjugate gradient solver
+  *
+  * @param A                  The system matrix
+  * @param rhs                The load vector
+  * @param result             The result vector. Holds the initial guess on entry if 'use_initial_guess' is true.
+  * @param use_initial_guess  If false, the iteration starts from a zero initial guess
+  * @param tag                Solver configuration tag
+  * @param ws                 Buffers, which are reused across calls
+  * @param monitor            Monitor called after each iteration
+  */
   template<typename MatrixT, typename NumericT>
-  viennacl::vector<NumericT> pipelined_solve(MatrixT const & A, //MatrixType const & A,
-                                             viennacl::vector_base<NumericT> const & rhs,
-                                             bicgstab_tag const & tag,
-                                             viennacl::linalg::no_precond)
+  void pipelined_solve_impl(MatrixT const & A,
+                            viennacl::vector_base<NumericT> const & rhs,
+                            viennacl::vector<NumericT> & result,
+                            bool use_initial_guess,
+                            bicgstab_tag const & tag,
+                            bicgstab_workspace< viennacl::vector<NumericT> > & ws,
+                            solver_monitor< viennacl::vector<NumericT> > const & monitor)
   {
-    viennacl::vector<NumericT> result = viennacl::zero_vector<NumericT>(rhs.size(), viennacl::traits::context(rhs));
-
-    viennacl::vector<NumericT> residual = rhs;
-    viennacl::vector<NumericT> p = rhs;
-    viennacl::vector<NumericT> r0star = rhs;
-    viennacl::vector<NumericT> Ap = rhs;
-    viennacl::vector<NumericT> s  = rhs;
-    viennacl::vector<NumericT> As = rhs;
-
     // Layout of temporary buffer:
     //  chunk 0: <residual, r_0^*>
     //  chunk 1: <As, As>
@@ -111,15 +143,52 @@ namespace detail
     //  chunk 5: <s, s>
     vcl_size_t buffer_size_per_vector = 256;
     vcl_size_t num_buffer_chunks = 6;
-    viennacl::vector<NumericT> inner_prod_buffer = viennacl::zero_vector<NumericT>(num_buffer_chunks*buffer_size_per_vector, viennacl::traits::context(rhs)); // temporary buffer
-    std::vector<NumericT>      host_inner_prod_buffer(inner_prod_buffer.size());
 
-    NumericT norm_rhs_host = viennacl::linalg::norm_2(residual);
+    viennacl::context ctx = viennacl::traits::context(rhs);
+    detail::prepare_workspace_vector(ws.residual, rhs.size(), ctx);
+    detail::prepare_workspace_vector(ws.r0star,   rhs.size(), ctx);
+    detail::prepare_workspace_vector(ws.p,        rhs.size(), ctx);
+    detail::prepare_workspace_vector(ws.s,        rhs.size(), ctx);
+    detail::prepare_workspace_vector(ws.tmp0,     rhs.size(), ctx);
+    detail::prepare_workspace_vector(ws.tmp1,     rhs.size(), ctx);
+    detail::prepare_workspace_vector(ws.inner_prod_buffer, num_buffer_chunks*buffer_size_per_vector, ctx); // temporary buffer
+    ws.host_inner_prod_buffer.resize(ws.inner_prod_buffer.size());
+
+    viennacl::vector<NumericT> & residual = ws.residual;
+    viennacl::vector<NumericT> & p        = ws.p;
+    viennacl::vector<NumericT> & r0star   = ws.r0star;
+    viennacl::vector<NumericT> & Ap       = ws.tmp0;
+    viennacl::vector<NumericT> & s        = ws.s;
+    viennacl::vector<NumericT> & As       = ws.tmp1;
+    viennacl::vector<NumericT> & inner_prod_buffer      = ws.inner_prod_buffer;
+    std::vector<NumericT>      & host_inner_prod_buffer = ws.host_inner_prod_buffer;
+
+    tag.iters(0);
+
+    NumericT norm_rhs_host = viennacl::linalg::norm_2(rhs);
     NumericT beta;
     NumericT alpha;
     NumericT omega;
-    NumericT residual_norm = norm_rhs_host;
-    inner_prod_buffer[0] = norm_rhs_host * norm_rhs_host;
+
+    if (norm_rhs_host <= 0) //solution is zero if RHS norm is zero
+    {
+      result.clear();
+      tag.error(0);
+      return;
+    }
+
+    residual = rhs;
+    if (use_initial_guess)
+    {
+      Ap = viennacl::linalg::prod(A, result);
+      residual -= Ap;
+    }
+    p = residual;
+    r0star = residual;
+
+    NumericT residual_norm = use_initial_guess ? viennacl::linalg::norm_2(residual) : norm_rhs_host;
+    inner_prod_buffer.clear(); // buffers from previous runs may hold partial results in chunk 0
+    inner_prod_buffer[0] = residual_norm * residual_norm;
 
     NumericT  r_dot_r0 = 0;
     NumericT As_dot_As = 0;
@@ -128,8 +197,11 @@ namespace detail
     NumericT As_dot_r0 = 0;
     NumericT  s_dot_s  = 0;
 
-    if (norm_rhs_host <= 0) //solution is zero if RHS norm is zero
-      return result;
+    if (residual_norm / norm_rhs_host < tag.tolerance() && use_initial_guess) // initial guess is accurate enough
+    {
+      tag.error(residual_norm / norm_rhs_host);
+      return;
+    }
 
     for (vcl_size_t i = 0; i < tag.max_iterations(); ++i)
     {
@@ -193,11 +265,25 @@ namespace detail
                                                           residual, As,
                                                           beta, Ap,
                                                           r0star, inner_prod_buffer, buffer_size_per_vector);
+
+      if (monitor(result, residual_norm / norm_rhs_host))
+        break;
     }
 
     //store last error estimate:
     tag.error(residual_norm / norm_rhs_host);
+  }
 
+  /** @brief Pipelined stabilized Bi-conjugate gradient solver with zero initial guess and temporary buffers */
+  template<typename MatrixT, typename NumericT>
+  viennacl::vector<NumericT> pipelined_solve(MatrixT const & A, //MatrixType const & A,
+                                             viennacl::vector_base<NumericT> const & rhs,
+                                             bicgstab_tag const & tag,
+                                             viennacl::linalg::no_precond)
+  {
+    viennacl::vector<NumericT> result = viennacl::zero_vector<NumericT>(rhs.size(), viennacl::traits::context(rhs));
+    bicgstab_workspace< viennacl::vector<NumericT> > ws;
+    pipelined_solve_impl(A, rhs, result, false, tag, ws, solver_monitor< viennacl::vector<NumericT> >());
     return result;
   }
 }
@@ -418,94 +504,152 @@ viennacl::vector<NumericT> solve(viennacl::hyb_matrix<NumericT> const & A,
 
 
 
-/** @brief Implementation of the stabilized Bi-conjugate gradient solver
-*
-* Following the description in "Iterative Methods for Sparse Linear Systems" by Y. Saad
-*
-* @param matrix     The system matrix
-* @param rhs        The load vector
-* @param tag        Solver configuration tag
-* @return The result vector
-*/
-template<typename MatrixT, typename VectorT>
-VectorT solve(MatrixT const & matrix, VectorT const & rhs, bicgstab_tag const & tag)
+namespace detail
 {
-  typedef typename viennacl::result_of::value_type<VectorT>::type            NumericType;
-  typedef typename viennacl::result_of::cpu_value_type<NumericType>::type    CPU_NumericType;
-  VectorT result = rhs;
-  viennacl::traits::clear(result);
 
-  VectorT residual = rhs;
-  VectorT p = rhs;
-  VectorT r0star = rhs;
-  VectorT tmp0 = rhs;
-  VectorT tmp1 = rhs;
-  VectorT s = rhs;
-
-  CPU_NumericType norm_rhs_host = viennacl::linalg::norm_2(residual);
-  CPU_NumericType ip_rr0star = norm_rhs_host * norm_rhs_host;
-  CPU_NumericType beta;
-  CPU_NumericType alpha;
-  CPU_NumericType omega;
-  //ScalarType inner_prod_temp; //temporary variable for inner product computation
-  CPU_NumericType new_ip_rr0star = 0;
-  CPU_NumericType residual_norm = norm_rhs_host;
-
-  if (norm_rhs_host <= 0) //solution is zero if RHS norm is zero
-    return result;
-
-  bool restart_flag = true;
-  vcl_size_t last_restart = 0;
-  for (vcl_size_t i = 0; i < tag.max_iterations(); ++i)
+  /** @brief Implementation of the preconditioned stabilized Bi-conjugate gradient solver
+  *
+  * Following the description of the unpreconditioned case in "Iterative Methods for Sparse Linear Systems" by Y. Saad
+  *
+  * @param matrix             The system matrix
+  * @param rhs                The load vector
+  * @param result             The result vector. Holds the initial guess on entry if 'use_initial_guess' is true.
+  * @param use_initial_guess  If false, the iteration starts from a zero initial guess
+  * @param tag                Solver configuration tag
+  * @param precond            A preconditioner. Precondition operation is done via member function apply()
+  * @param ws                 Buffers, which are reused across calls
+  * @param monitor            Monitor called after each iteration
+  */
+  template<typename MatrixT, typename VectorT, typename PreconditionerT>
+  void solve_impl(MatrixT const & matrix,
+                  VectorT const & rhs,
+                  VectorT & result,
+                  bool use_initial_guess,
+                  bicgstab_tag const & tag,
+                  PreconditionerT const & precond,
+                  bicgstab_workspace<VectorT> & ws,
+                  solver_monitor<VectorT> const & monitor)
   {
-    if (restart_flag)
+    typedef typename viennacl::result_of::value_type<VectorT>::type            NumericType;
+    typedef typename viennacl::result_of::cpu_value_type<NumericType>::type    CPU_NumericType;
+
+    detail::prepare_workspace_vector(ws.residual, rhs);
+    detail::prepare_workspace_vector(ws.r0star,   rhs);
+    detail::prepare_workspace_vector(ws.p,        rhs);
+    detail::prepare_workspace_vector(ws.s,        rhs);
+    detail::prepare_workspace_vector(ws.tmp0,     rhs);
+    detail::prepare_workspace_vector(ws.tmp1,     rhs);
+
+    VectorT & residual = ws.residual;
+    VectorT & r0star   = ws.r0star;  //can be chosen arbitrarily in fact
+    VectorT & p        = ws.p;
+    VectorT & s        = ws.s;
+    VectorT & tmp0     = ws.tmp0;
+    VectorT & tmp1     = ws.tmp1;
+
+    CPU_NumericType norm_rhs_host = viennacl::linalg::norm_2(rhs);
+    CPU_NumericType ip_rr0star = norm_rhs_host * norm_rhs_host;
+    CPU_NumericType beta;
+    CPU_NumericType alpha;
+    CPU_NumericType omega;
+    CPU_NumericType new_ip_rr0star = 0;
+    CPU_NumericType residual_norm = norm_rhs_host;
+
+    tag.iters(0);
+    tag.error(0);
+
+    if (norm_rhs_host <= 0) //solution is zero if RHS norm is zero
     {
-      residual = rhs;
-      residual -= viennacl::linalg::prod(matrix, result);
-      p = residual;
-      r0star = residual;
-      ip_rr0star = viennacl::linalg::norm_2(residual);
-      ip_rr0star *= ip_rr0star;
-      restart_flag = false;
-      last_restart = i;
+      viennacl::traits::clear(result);
+      return;
     }
 
-    tag.iters(i+1);
-    tmp0 = viennacl::linalg::prod(matrix, p);
-    alpha = ip_rr0star / viennacl::linalg::inner_prod(tmp0, r0star);
+    bool restart_flag = true;
+    vcl_size_t last_restart = 0;
+    for (vcl_size_t i = 0; i < tag.max_iterations(); ++i)
+    {
+      if (restart_flag)
+      {
+        residual = rhs;
+        residual -= viennacl::linalg::prod(matrix, result);
+        precond.apply(residual);
+        p = residual;
+        r0star = residual;
+        ip_rr0star = viennacl::linalg::norm_2(residual);
+        ip_rr0star *= ip_rr0star;
+        restart_flag = false;
+        last_restart = i;
+
+        if (i == 0 && use_initial_guess && std::sqrt(ip_rr0star) / norm_rhs_host < tag.tolerance()) // initial guess is accurate enough
+        {
+          residual_norm = std::sqrt(ip_rr0star);
+          break;
+        }
+      }
 
-    s = residual - alpha*tmp0;
+      tag.iters(i+1);
+      tmp0 = viennacl::linalg::prod(matrix, p);
+      precond.apply(tmp0);
+      alpha = ip_rr0star / viennacl::linalg::inner_prod(tmp0, r0star);
+
+      s = residual - alpha*tmp0;
+
+      tmp1 = viennacl::linalg::prod(matrix, s);
+      precond.apply(tmp1);
+      CPU_NumericType norm_tmp1 = viennacl::linalg::norm_2(tmp1);
+      omega = viennacl::linalg::inner_prod(tmp1, s) / (norm_tmp1 * norm_tmp1);
+
+      result += alpha * p + omega * s;
+      residual = s - omega * tmp1;
 
-    tmp1 = viennacl::linalg::prod(matrix, s);
-    CPU_NumericType norm_tmp1 = viennacl::linalg::norm_2(tmp1);
-    omega = viennacl::linalg::inner_prod(tmp1, s) / (norm_tmp1 * norm_tmp1);
+      residual_norm = viennacl::linalg::norm_2(residual);
+      if (residual_norm / norm_rhs_host < tag.tolerance())
+        break;
+
+      if (monitor(result, residual_norm / norm_rhs_host))
+        break;
 
-    result += alpha * p + omega * s;
-    residual = s - omega * tmp1;
+      new_ip_rr0star = viennacl::linalg::inner_prod(residual, r0star);
 
-    new_ip_rr0star = viennacl::linalg::inner_prod(residual, r0star);
-    residual_norm = viennacl::linalg::norm_2(residual);
-    if (std::fabs(residual_norm / norm_rhs_host) < tag.tolerance())
-      break;
+      beta = new_ip_rr0star / ip_rr0star * alpha/omega;
+      ip_rr0star = new_ip_rr0star;
 
-    beta = new_ip_rr0star / ip_rr0star * alpha/omega;
-    ip_rr0star = new_ip_rr0star;
+      if (    (ip_rr0star <= 0 && ip_rr0star >= 0)
+           || (omega <= 0 && omega >= 0)
+           || (i - last_restart > tag.max_iterations_before_restart())
+         ) //search direction degenerate. A restart might help
+        restart_flag = true;
 
-    if (    (ip_rr0star <= 0 && ip_rr0star >= 0)
-         || (omega <= 0 && omega >= 0)
-         || (i - last_restart > tag.max_iterations_before_restart())
-       ) //search direction degenerate. A restart might help
-      restart_flag = true;
+      // Execution of
+      //  p = residual + beta * (p - omega*tmp0);
+      // without introducing temporary vectors:
+      p -= omega * tmp0;
+      p = residual + beta * p;
+    }
 
-    // Execution of
-    //  p = residual + beta * (p - omega*tmp0);
-    // without introducing temporary vectors:
-    p -= omega * tmp0;
-    p = residual + beta * p;
+    //store last error estimate:
+    tag.error(residual_norm / norm_rhs_host);
   }
 
-  //store last error estimate:
-  tag.error(residual_norm / norm_rhs_host);
+}
+
+/** @brief Implementation of the stabilized Bi-conjugate gradient solver
+*
+* Following the description in "Iterative Methods for Sparse Linear Systems" by Y. Saad
+*
+* @param matrix     The system matrix
+* @param rhs        The load vector
+* @param tag        Solver configuration tag
+* @return The result vector
+*/
+template<typename MatrixT, typename VectorT>
+VectorT solve(MatrixT const & matrix, VectorT const & rhs, bicgstab_tag const & tag)
+{
+  VectorT result = rhs;
+  viennacl::traits::clear(result);
+
+  detail::bicgstab_workspace<VectorT> ws;
+  detail::solve_impl(matrix, rhs, result, false, tag, viennacl::linalg::no_precond(), ws, detail::solver_monitor<VectorT>());
 
   return result;
 }
@@ -529,88 +673,149 @@ VectorT solve(MatrixT const & matrix, VectorT const & rhs, bicgstab_tag const &
 template<typename MatrixT, typename VectorT, typename PreconditionerT>
 VectorT solve(MatrixT const & matrix, VectorT const & rhs, bicgstab_tag const & tag, PreconditionerT const & precond)
 {
-  typedef typename viennacl::result_of::value_type<VectorT>::type            NumericType;
-  typedef typename viennacl::result_of::cpu_value_type<NumericType>::type    CPU_NumericType;
   VectorT result = rhs;
   viennacl::traits::clear(result);
 
-  VectorT residual = rhs;
-  VectorT r0star = residual;  //can be chosen arbitrarily in fact
-  VectorT tmp0 = rhs;
-  VectorT tmp1 = rhs;
-  VectorT s = rhs;
+  detail::bicgstab_workspace<VectorT> ws;
+  detail::solve_impl(matrix, rhs, result, false, tag, precond, ws, detail::solver_monitor<VectorT>());
 
-  VectorT p = residual;
+  return result;
+}
 
-  CPU_NumericType ip_rr0star = viennacl::linalg::norm_2(residual);
-  CPU_NumericType norm_rhs_host = viennacl::linalg::norm_2(residual);
-  CPU_NumericType beta;
-  CPU_NumericType alpha;
-  CPU_NumericType omega;
-  CPU_NumericType new_ip_rr0star = 0;
-  CPU_NumericType residual_norm = norm_rhs_host;
 
-  if (!norm_rhs_host) //solution is zero if RHS norm is zero
-    return result;
+namespace detail
+{
+  /** @brief Runs the generic stabilized Bi-conjugate gradient implementation for a solver object */
+  template<typename MatrixT, typename VectorT, typename PreconditionerT>
+  void run_solver(MatrixT const & A, VectorT const & rhs, VectorT & result, bool use_initial_guess, bicgstab_tag const & tag, PreconditionerT const & precond,
+                  bicgstab_workspace<VectorT> & ws, solver_monitor<VectorT> const & monitor)
+  {
+    solve_impl(A, rhs, result, use_initial_guess, tag, precond, ws, monitor);
+  }
 
-  bool restart_flag = true;
-  vcl_size_t last_restart = 0;
-  for (unsigned int i = 0; i < tag.max_iterations(); ++i)
+  /** @brief Runs the pipelined stabilized Bi-conjugate gradient implementation for a solver object. Overload for compressed_matrix without preconditioner. */
+  template<typename NumericT>
+  void run_solver(viennacl::compressed_matrix<NumericT> const & A, viennacl::vector<NumericT> const & rhs, viennacl::vector<NumericT> & result, bool use_initial_guess,
+                  bicgstab_tag const & tag, viennacl::linalg::no_precond,
+                  bicgstab_workspace< viennacl::vector<NumericT> > & ws, solver_monitor< viennacl::vector<NumericT> > const & monitor)
   {
-    if (restart_flag)
-    {
-      residual = rhs;
-      residual -= viennacl::linalg::prod(matrix, result);
-      precond.apply(residual);
-      p = residual;
-      r0star = residual;
-      ip_rr0star = viennacl::linalg::norm_2(residual);
-      ip_rr0star *= ip_rr0star;
-      restart_flag = false;
-      last_restart = i;
-    }
+    pipelined_solve_impl(A, rhs, result, use_initial_guess, tag, ws, monitor);
+  }
+
+  /** @brief Runs the pipelined stabilized Bi-conjugate gradient implementation for a solver object. Overload for coordinate_matrix without preconditioner. */
+  template<typename NumericT>
+  void run_solver(viennacl::coordinate_matrix<NumericT> const & A, viennacl::vector<NumericT> const & rhs, viennacl::vector<NumericT> & result, bool use_initial_guess,
+                  bicgstab_tag const & tag, viennacl::linalg::no_precond,
+                  bicgstab_workspace< viennacl::vector<NumericT> > & ws, solver_monitor< viennacl::vector<NumericT> > const & monitor)
+  {
+    pipelined_solve_impl(A, rhs, result, use_initial_guess, tag, ws, monitor);
+  }
 
-    tag.iters(i+1);
-    tmp0 = viennacl::linalg::prod(matrix, p);
-    precond.apply(tmp0);
-    alpha = ip_rr0star / viennacl::linalg::inner_prod(tmp0, r0star);
+  /** @brief Runs the pipelined stabilized Bi-conjugate gradient implementation for a solver object. Overload for ell_matrix without preconditioner. */
+  template<typename NumericT>
+  void run_solver(viennacl::ell_matrix<NumericT> const & A, viennacl::vector<NumericT> const & rhs, viennacl::vector<NumericT> & result, bool use_initial_guess,
+                  bicgstab_tag const & tag, viennacl::linalg::no_precond,
+                  bicgstab_workspace< viennacl::vector<NumericT> > & ws, solver_monitor< viennacl::vector<NumericT> > const & monitor)
+  {
+    pipelined_solve_impl(A, rhs, result, use_initial_guess, tag, ws, monitor);
+  }
 
-    s = residual - alpha*tmp0;
+  /** @brief Runs the pipelined stabilized Bi-conjugate gradient implementation for a solver object. Overload for sliced_ell_matrix without preconditioner. */
+  template<typename NumericT>
+  void run_solver(viennacl::sliced_ell_matrix<NumericT> const & A, viennacl::vector<NumericT> const & rhs, viennacl::vector<NumericT> & result, bool use_initial_guess,
+                  bicgstab_tag const & tag, viennacl::linalg::no_precond,
+                  bicgstab_workspace< viennacl::vector<NumericT> > & ws, solver_monitor< viennacl::vector<NumericT> > const & monitor)
+  {
+    pipelined_solve_impl(A, rhs, result, use_initial_guess, tag, ws, monitor);
+  }
 
-    tmp1 = viennacl::linalg::prod(matrix, s);
-    precond.apply(tmp1);
-    CPU_NumericType norm_tmp1 = viennacl::linalg::norm_2(tmp1);
-    omega = viennacl::linalg::inner_prod(tmp1, s) / (norm_tmp1 * norm_tmp1);
+  /** @brief Runs the pipelined stabilized Bi-conjugate gradient implementation for a solver object. Overload for hyb_matrix without preconditioner. */
+  template<typename NumericT>
+  void run_solver(viennacl::hyb_matrix<NumericT> const & A, viennacl::vector<NumericT> const & rhs, viennacl::vector<NumericT> & result, bool use_initial_guess,
+                  bicgstab_tag const & tag, viennacl::linalg::no_precond,
+                  bicgstab_workspace< viennacl::vector<NumericT> > & ws, solver_monitor< viennacl::vector<NumericT> > const & monitor)
+  {
+    pipelined_solve_impl(A, rhs, result, use_initial_guess, tag, ws, monitor);
+  }
+}
 
-    result += alpha * p + omega * s;
-    residual = s - omega * tmp1;
+/** @brief A stabilized Bi-conjugate gradient solver object, which keeps all buffers of the solver between solver runs.
+*
+* Repeated solves of systems with the same size do not allocate new buffers.
+* An initial guess can be provided either via set_initial_guess() or by passing the result vector to solve(), which then iterates in place.
+* A monitor callback set via set_monitor() is called after each iteration and may stop the solver run by returning true.
+*/
+template<typename VectorT>
+class bicgstab_solver
+{
+public:
+  typedef typename detail::solver_monitor<VectorT>::numeric_type    numeric_type;
 
-    residual_norm = viennacl::linalg::norm_2(residual);
-    if (residual_norm / norm_rhs_host < tag.tolerance())
-      break;
+  bicgstab_solver(bicgstab_tag const & tag = bicgstab_tag()) : tag_(tag), use_initial_guess_(false) {}
 
-    new_ip_rr0star = viennacl::linalg::inner_prod(residual, r0star);
+  /** @brief Solves A x = b using the preconditioner 'precond' and returns x. Starts from the initial guess if one is set.
+  *
+  * The result is kept in a buffer of the solver object, hence no memory is allocated if the system size does not change.
+  * The returned reference is valid until the next call of operator().
+  */
+  template<typename MatrixT, typename PreconditionerT>
+  VectorT const & operator()(MatrixT const & A, VectorT const & b, PreconditionerT const & precond) const
+  {
+    detail::prepare_workspace_vector(result_, b);
+    if (use_initial_guess_)
+      result_ = init_guess_;
+    else
+      viennacl::traits::clear(result_);
+    detail::run_solver(A, b, result_, use_initial_guess_, tag_, precond, workspace_, monitor_);
+    return result_;
+  }
 
-    beta = new_ip_rr0star / ip_rr0star * alpha/omega;
-    ip_rr0star = new_ip_rr0star;
+  /** @brief Solves A x = b without preconditioner and returns x. Starts from the initial guess if one is set. */
+  template<typename MatrixT>
+  VectorT const & operator()(MatrixT const & A, VectorT const & b) const
+  {
+    return operator()(A, b, viennacl::linalg::no_precond());
+  }
 
-    if (!ip_rr0star || !omega || i - last_restart > tag.max_iterations_before_restart()) //search direction degenerate. A restart might help
-      restart_flag = true;
+  /** @brief Solves A x = b in place using the preconditioner 'precond'. The entries of 'x' on entry are used as initial guess. No buffers are allocated if the system size does not change. */
+  template<typename MatrixT, typename PreconditionerT>
+  void solve(MatrixT const & A, VectorT const & b, VectorT & x, PreconditionerT const & precond) const
+  {
+    detail::run_solver(A, b, x, true, tag_, precond, workspace_, monitor_);
+  }
 
-    // Execution of
-    //  p = residual + beta * (p - omega*tmp0);
-    // without introducing temporary vectors:
-    p -= omega * tmp0;
-    p = residual + beta * p;
+  /** @brief Solves A x = b in place without preconditioner. The entries of 'x' on entry are used as initial guess. */
+  template<typename MatrixT>
+  void solve(MatrixT const & A, VectorT const & b, VectorT & x) const
+  {
+    solve(A, b, x, viennacl::linalg::no_precond());
+  }
 
-    //std::cout << "Rel. Residual in current step: " << std::sqrt(std::fabs(viennacl::linalg::inner_prod(residual, residual) / norm_rhs_host)) << std::endl;
+  /** @brief Sets the initial guess used by operator() */
+  void set_initial_guess(VectorT const & x)
+  {
+    detail::prepare_workspace_vector(init_guess_, x);
+    init_guess_ = x;
+    use_initial_guess_ = true;
   }
 
-  //store last error estimate:
-  tag.error(residual_norm / norm_rhs_host);
+  /** @brief Sets a monitor, which is called after each iteration with the current result, the estimated relative residual and 'user_data'. The solver stops if the monitor returns true. */
+  void set_monitor(bool (*monitor_fun)(VectorT const &, numeric_type, void *), void * user_data)
+  {
+    monitor_.set(monitor_fun, user_data);
+  }
 
-  return result;
-}
+  /** @brief Returns the solver tag holding the configuration as well as the number of iterations and the estimated error of the last run */
+  bicgstab_tag const & tag() const { return tag_; }
+
+private:
+  bicgstab_tag tag_;
+  VectorT init_guess_;
+  mutable VectorT result_;
+  bool use_initial_guess_;
+  detail::solver_monitor<VectorT> monitor_;
+  mutable detail::bicgstab_workspace<VectorT> workspace_;
+};
 
 }
 }
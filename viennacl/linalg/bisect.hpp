@@ -29,6 +29,7 @@
 #include <limits>
 #include <cstddef>
 #include "viennacl/meta/result_of.hpp"
+#include "viennacl/linalg/tridiag_eig.hpp"
 
 namespace viennacl
 {
@@ -64,9 +65,11 @@ namespace detail
 /**
 *   @brief Implementation of the bisect-algorithm for the calculation of the eigenvalues of a tridiagonal matrix. Experimental - interface might change.
 *
+*   Disjoint ranges of eigenvalues are computed in parallel if OpenMP is enabled, cf. viennacl::linalg::tridiag_eigenvalues().
+*
 *   @param alphas       Elements of the main diagonal
 *   @param betas        Elements of the secondary diagonal
-*   @return             Returns the eigenvalues of the tridiagonal matrix defined by alpha and beta
+*   @return             Returns the eigenvalues of the tridiagonal matrix defined by alpha and beta in ascending order
 */
 template<typename VectorT>
 std::vector<
@@ -78,97 +81,14 @@ bisect(VectorT const & alphas, VectorT const & betas)
   typedef typename viennacl::result_of::cpu_value_type<NumericType>::type   CPU_NumericType;
 
   vcl_size_t size = betas.size();
-  std::vector<CPU_NumericType>  x_temp(size);
-
-
-  std::vector<CPU_NumericType> beta_bisect;
-  std::vector<CPU_NumericType> wu;
-
-  double rel_error = std::numeric_limits<CPU_NumericType>::epsilon();
-  beta_bisect.push_back(0);
-
-  for (vcl_size_t i = 1; i < size; i++)
-    beta_bisect.push_back(betas[i] * betas[i]);
-
-  double xmin = alphas[size - 1] - std::fabs(betas[size - 1]);
-  double xmax = alphas[size - 1] + std::fabs(betas[size - 1]);
-
-  for (vcl_size_t i = 0; i < size - 1; i++)
-  {
-    double h = std::fabs(betas[i]) + std::fabs(betas[i + 1]);
-    if (alphas[i] + h > xmax)
-      xmax = alphas[i] + h;
-    if (alphas[i] - h < xmin)
-      xmin = alphas[i] - h;
-  }
-
-
-  double eps1 = 1e-6;
-  /*double eps2 = (xmin + xmax > 0) ? (rel_error * xmax) : (-rel_error * xmin);
-  if (eps1 <= 0)
-    eps1 = eps2;
-  else
-    eps2 = 0.5 * eps1 + 7.0 * eps2; */
-
-  double x0 = xmax;
+  std::vector<CPU_NumericType> d(alphas.size()), e(size);
 
-  for (vcl_size_t i = 0; i < size; i++)
-  {
-    x_temp[i] = xmax;
-    wu.push_back(xmin);
-  }
+  // bulk copies, avoiding one transfer per entry for ViennaCL vectors:
+  detail::copy_vec_to_vec(alphas, d);
+  detail::copy_vec_to_vec(betas, e);
+  d.resize(size);
 
-  for (long k = static_cast<long>(size) - 1; k >= 0; --k)
-  {
-    double xu = xmin;
-    for (long i = k; i >= 0; --i)
-    {
-      if (xu < wu[vcl_size_t(k-i)])
-      {
-        xu = wu[vcl_size_t(i)];
-        break;
-      }
-    }
-
-    if (x0 > x_temp[vcl_size_t(k)])
-      x0 = x_temp[vcl_size_t(k)];
-
-    double x1 = (xu + x0) / 2.0;
-    while (x0 - xu > 2.0 * rel_error * (std::fabs(xu) + std::fabs(x0)) + eps1)
-    {
-      vcl_size_t a = 0;
-      double q = 1;
-      for (vcl_size_t i = 0; i < size; i++)
-      {
-        if (q > 0 || q < 0)
-          q = alphas[i] - x1 - beta_bisect[i] / q;
-        else
-          q = alphas[i] - x1 - std::fabs(betas[i] / rel_error);
-
-        if (q < 0)
-          a++;
-      }
-
-      if (a <= static_cast<vcl_size_t>(k))
-      {
-        xu = x1;
-        if (a < 1)
-          wu[0] = x1;
-        else
-        {
-          wu[a] = x1;
-          if (x_temp[a - 1] > x1)
-              x_temp[a - 1] = x1;
-        }
-      }
-      else
-        x0 = x1;
-
-      x1 = (xu + x0) / 2.0;
-    }
-    x_temp[vcl_size_t(k)] = x1;
-  }
-  return x_temp;
+  return viennacl::linalg::tridiag_eigenvalues(d, e);
 }
 
 } // end namespace linalg
@@ -37,6 +37,7 @@
 #include "viennacl/traits/size.hpp"
 #include "viennacl/meta/result_of.hpp"
 #include "viennacl/linalg/iterative_operations.hpp"
+#include "viennacl/linalg/detail/iterative_solver_support.hpp"
 
 namespace viennacl
 {
@@ -86,21 +87,49 @@ namespace detail
   template<typename VectorT, typename PreconditionerT>
   class z_handler{
   public:
-    z_handler(VectorT & residual) : z_(residual){ }
+    z_handler(VectorT & residual, VectorT & z_buffer) : z_(z_buffer)
+    {
+      detail::prepare_workspace_vector(z_, residual);
+      z_ = residual;
+    }
     VectorT & get() { return z_; }
   private:
-    VectorT z_;
+    VectorT & z_;
   };
 
   template<typename VectorT>
   class z_handler<VectorT, viennacl::linalg::no_precond>{
   public:
-    z_handler(VectorT & residual) : presidual_(&residual){ }
+    z_handler(VectorT & residual, VectorT &) : presidual_(&residual){ }
     VectorT & get() { return *presidual_; }
   private:
     VectorT * presidual_;
   };
 
+  /** @brief Buffers of the conjugate gradient solver, which are kept by cg_solver between solver runs */
+  template<typename VectorT>
+  class cg_workspace
+  {
+  public:
+    VectorT residual;
+    VectorT p;
+    VectorT tmp;
+    VectorT z;
+  };
+
+  /** @brief Buffers of the conjugate gradient solver for ViennaCL vectors, including the buffers of the pipelined implementation */
+  template<typename NumericT>
+  class cg_workspace< viennacl::vector<NumericT> >
+  {
+  public:
+    viennacl::vector<NumericT> residual;
+    viennacl::vector<NumericT> p;
+    viennacl::vector<NumericT> tmp;
+    viennacl::vector<NumericT> z;
+    viennacl::vector<NumericT> inner_prod_buffer;
+    std::vector<NumericT>      host_inner_prod_buffer;
+  };
+
 }
 
 namespace detail
@@ -110,37 +139,68 @@ namespace detail
   *
   * Pipelined version from A. T. Chronopoulos and C. W. Gear, J. Comput. Appl. Math. 25(2), 153–168 (1989)
   *
-  * @param A          The system matrix
-  * @param rhs        The load vector
-  * @param tag        Solver configuration tag
-  * @return The result vector
+  * @param A                  The system matrix
+  * @param rhs                The load vector
+  * @param result             The result vector. Holds the initial guess on entry if 'use_initial_guess' is true.
+  * @param use_initial_guess  If false, the iteration starts from a zero initial guess
+  * @param tag                Solver configuration tag
+  * @param ws                 Buffers, which are reused across calls
+  * @param monitor            Monitor called after each iteration
   */
-  //template<typename MatrixType, typename ScalarType>
   template<typename MatrixT, typename NumericT>
-  viennacl::vector<NumericT> pipelined_solve(MatrixT const & A, //MatrixType const & A,
-                                             viennacl::vector<NumericT> const & rhs,
-                                             cg_tag const & tag,
-                                             viennacl::linalg::no_precond)
+  void pipelined_solve_impl(MatrixT const & A,
+                            viennacl::vector<NumericT> const & rhs,
+                            viennacl::vector<NumericT> & result,
+                            bool use_initial_guess,
+                            cg_tag const & tag,
+                            cg_workspace< viennacl::vector<NumericT> > & ws,
+                            solver_monitor< viennacl::vector<NumericT> > const & monitor)
   {
     typedef typename viennacl::vector<NumericT>::difference_type   difference_type;
 
-    viennacl::vector<NumericT> result(rhs);
-    viennacl::traits::clear(result);
-
-    viennacl::vector<NumericT> residual(rhs);
-    viennacl::vector<NumericT> p(rhs);
-    viennacl::vector<NumericT> Ap = viennacl::linalg::prod(A, p);
-    viennacl::vector<NumericT> inner_prod_buffer = viennacl::zero_vector<NumericT>(3*256, viennacl::traits::context(rhs)); // temporary buffer
-    std::vector<NumericT>      host_inner_prod_buffer(inner_prod_buffer.size());
+    detail::prepare_workspace_vector(ws.residual, rhs);
+    detail::prepare_workspace_vector(ws.p,        rhs);
+    detail::prepare_workspace_vector(ws.tmp,      rhs);
+    detail::prepare_workspace_vector(ws.inner_prod_buffer, 3*256, viennacl::traits::context(rhs)); // temporary buffer
+    ws.host_inner_prod_buffer.resize(ws.inner_prod_buffer.size());
+
+    viennacl::vector<NumericT> & residual = ws.residual;
+    viennacl::vector<NumericT> & p        = ws.p;
+    viennacl::vector<NumericT> & Ap       = ws.tmp;
+    viennacl::vector<NumericT> & inner_prod_buffer      = ws.inner_prod_buffer;
+    std::vector<NumericT>      & host_inner_prod_buffer = ws.host_inner_prod_buffer;
     vcl_size_t                 buffer_size_per_vector = inner_prod_buffer.size() / 3;
     difference_type            buffer_offset_per_vector = static_cast<difference_type>(buffer_size_per_vector);
 
-    NumericT norm_rhs_squared = viennacl::linalg::norm_2(residual); norm_rhs_squared *= norm_rhs_squared;
+    tag.iters(0);
+
+    NumericT norm_rhs_squared = viennacl::linalg::norm_2(rhs); norm_rhs_squared *= norm_rhs_squared;
 
     if (!norm_rhs_squared) //check for early convergence of A*x = 0
-      return result;
+    {
+      result.clear();
+      tag.error(0);
+      return;
+    }
 
+    residual = rhs;
     NumericT inner_prod_rr = norm_rhs_squared;
+    if (use_initial_guess)
+    {
+      Ap = viennacl::linalg::prod(A, result);
+      residual -= Ap;
+      inner_prod_rr = viennacl::linalg::norm_2(residual); inner_prod_rr *= inner_prod_rr;
+
+      if (inner_prod_rr / norm_rhs_squared < tag.tolerance() *  tag.tolerance()) // initial guess is accurate enough
+      {
+        tag.error(std::sqrt(inner_prod_rr / norm_rhs_squared));
+        return;
+      }
+    }
+
+    p = residual;
+    Ap = viennacl::linalg::prod(A, p);
+
     NumericT alpha = inner_prod_rr / viennacl::linalg::inner_prod(p, Ap);
     NumericT beta  = viennacl::linalg::norm_2(Ap); beta = (alpha * alpha * beta * beta - inner_prod_rr) / inner_prod_rr;
     NumericT inner_prod_ApAp = 0;
@@ -163,13 +223,27 @@ namespace detail
       if (std::fabs(inner_prod_rr / norm_rhs_squared) < tag.tolerance() *  tag.tolerance())    //squared norms involved here
         break;
 
+      if (monitor(result, std::sqrt(std::fabs(inner_prod_rr) / norm_rhs_squared)))
+        break;
+
       alpha = inner_prod_rr / inner_prod_pAp;
       beta  = (alpha*alpha*inner_prod_ApAp - inner_prod_rr) / inner_prod_rr;
     }
 
     //store last error estimate:
     tag.error(std::sqrt(std::fabs(inner_prod_rr) / norm_rhs_squared));
+  }
 
+  /** @brief Pipelined conjugate gradient algorithm (no preconditioner) with zero initial guess and temporary buffers */
+  template<typename MatrixT, typename NumericT>
+  viennacl::vector<NumericT> pipelined_solve(MatrixT const & A, //MatrixType const & A,
+                                             viennacl::vector<NumericT> const & rhs,
+                                             cg_tag const & tag,
+                                             viennacl::linalg::no_precond)
+  {
+    viennacl::vector<NumericT> result = viennacl::zero_vector<NumericT>(rhs.size(), viennacl::traits::context(rhs));
+    cg_workspace< viennacl::vector<NumericT> > ws;
+    pipelined_solve_impl(A, rhs, result, false, tag, ws, solver_monitor< viennacl::vector<NumericT> >());
     return result;
   }
 }
@@ -394,6 +468,117 @@ viennacl::vector<NumericT> solve(viennacl::hyb_matrix<NumericT> const & A,
 
 
 
+namespace detail
+{
+
+  /** @brief Implementation of the preconditioned conjugate gradient solver, generic implementation for non-ViennaCL types.
+  *
+  * Following Algorithm 9.1 in "Iterative Methods for Sparse Linear Systems" by Y. Saad
+  *
+  * @param matrix             The system matrix
+  * @param rhs                The load vector
+  * @param result             The result vector. Holds the initial guess on entry if 'use_initial_guess' is true.
+  * @param use_initial_guess  If false, the iteration starts from a zero initial guess
+  * @param tag                Solver configuration tag
+  * @param precond            A preconditioner. Precondition operation is done via member function apply()
+  * @param ws                 Buffers, which are reused across calls
+  * @param monitor            Monitor called after each iteration
+  */
+  template<typename MatrixT, typename VectorT, typename PreconditionerT>
+  void solve_impl(MatrixT const & matrix,
+                  VectorT const & rhs,
+                  VectorT & result,
+                  bool use_initial_guess,
+                  cg_tag const & tag,
+                  PreconditionerT const & precond,
+                  cg_workspace<VectorT> & ws,
+                  solver_monitor<VectorT> const & monitor)
+  {
+    typedef typename viennacl::result_of::value_type<VectorT>::type           NumericType;
+    typedef typename viennacl::result_of::cpu_value_type<NumericType>::type   CPU_NumericType;
+
+    detail::prepare_workspace_vector(ws.residual, rhs);
+    detail::prepare_workspace_vector(ws.tmp,      rhs);
+    detail::prepare_workspace_vector(ws.p,        rhs);
+
+    VectorT & residual = ws.residual;
+    VectorT & tmp      = ws.tmp;
+    VectorT & p        = ws.p;
+
+    residual = rhs;
+    detail::z_handler<VectorT, PreconditionerT> zhandler(residual, ws.z);
+    VectorT & z = zhandler.get();
+
+    precond.apply(z);
+
+    CPU_NumericType ip_rr = viennacl::linalg::inner_prod(residual, z);
+    CPU_NumericType alpha;
+    CPU_NumericType new_ip_rr = 0;
+    CPU_NumericType beta;
+    CPU_NumericType norm_rhs_squared = ip_rr;
+    CPU_NumericType new_ipp_rr_over_norm_rhs;
+
+    tag.iters(0);
+    tag.error(0);
+
+    if (norm_rhs_squared <= 0) //solution is zero if RHS norm is zero
+    {
+      viennacl::traits::clear(result);
+      return;
+    }
+
+    if (use_initial_guess)
+    {
+      tmp = viennacl::linalg::prod(matrix, result);
+      residual -= tmp;
+      z = residual;
+      precond.apply(z);
+      ip_rr = viennacl::linalg::inner_prod(residual, z);
+
+      tag.error(std::sqrt(std::fabs(ip_rr / norm_rhs_squared)));
+      if (tag.error() < tag.tolerance()) // initial guess is accurate enough
+        return;
+    }
+
+    p = z;
+
+    for (unsigned int i = 0; i < tag.max_iterations(); ++i)
+    {
+      tag.iters(i+1);
+      tmp = viennacl::linalg::prod(matrix, p);
+
+      alpha = ip_rr / viennacl::linalg::inner_prod(tmp, p);
+
+      result += alpha * p;
+      residual -= alpha * tmp;
+      z = residual;
+      precond.apply(z);
+
+      if (static_cast<VectorT*>(&residual)==static_cast<VectorT*>(&z))
+        new_ip_rr = std::pow(viennacl::linalg::norm_2(residual),2);
+      else
+        new_ip_rr = viennacl::linalg::inner_prod(residual, z);
+
+      new_ipp_rr_over_norm_rhs = new_ip_rr / norm_rhs_squared;
+
+      //store current error estimate:
+      tag.error(std::sqrt(std::fabs(new_ipp_rr_over_norm_rhs)));
+
+      if (std::fabs(new_ipp_rr_over_norm_rhs) < tag.tolerance() *  tag.tolerance())    //squared norms involved here
+        break;
+
+      if (monitor(result, static_cast<CPU_NumericType>(tag.error())))
+        break;
+
+      beta = new_ip_rr / ip_rr;
+      ip_rr = new_ip_rr;
+
+      p = z + beta*p;
+    }
+  }
+
+}
+
 /** @brief Implementation of the preconditioned conjugate gradient solver, generic implementation for non-ViennaCL types.
 *
 * Following Algorithm 9.1 in "Iterative Methods for Sparse Linear Systems" by Y. Saad
@@ -407,68 +592,155 @@ viennacl::vector<NumericT> solve(viennacl::hyb_matrix<NumericT> const & A,
 template<typename MatrixT, typename VectorT, typename PreconditionerT>
 VectorT solve(MatrixT const & matrix, VectorT const & rhs, cg_tag const & tag, PreconditionerT const & precond)
 {
-  typedef typename viennacl::result_of::value_type<VectorT>::type           NumericType;
-  typedef typename viennacl::result_of::cpu_value_type<NumericType>::type   CPU_NumericType;
-
   VectorT result = rhs;
   viennacl::traits::clear(result);
 
-  VectorT residual = rhs;
-  VectorT tmp = rhs;
-  detail::z_handler<VectorT, PreconditionerT> zhandler(residual);
-  VectorT & z = zhandler.get();
+  detail::cg_workspace<VectorT> ws;
+  detail::solve_impl(matrix, rhs, result, false, tag, precond, ws, detail::solver_monitor<VectorT>());
+
+  return result;
+}
+
+template<typename MatrixT, typename VectorT>
+VectorT solve(MatrixT const & matrix, VectorT const & rhs, cg_tag const & tag)
+{
+  return solve(matrix, rhs, tag, viennacl::linalg::no_precond());
+}
 
-  precond.apply(z);
-  VectorT p = z;
+namespace detail
+{
+  /** @brief Runs the generic conjugate gradient implementation for a solver object */
+  template<typename MatrixT, typename VectorT, typename PreconditionerT>
+  void run_solver(MatrixT const & A, VectorT const & rhs, VectorT & result, bool use_initial_guess, cg_tag const & tag, PreconditionerT const & precond,
+                  cg_workspace<VectorT> & ws, solver_monitor<VectorT> const & monitor)
+  {
+    solve_impl(A, rhs, result, use_initial_guess, tag, precond, ws, monitor);
+  }
 
-  CPU_NumericType ip_rr = viennacl::linalg::inner_prod(residual, z);
-  CPU_NumericType alpha;
-  CPU_NumericType new_ip_rr = 0;
-  CPU_NumericType beta;
-  CPU_NumericType norm_rhs_squared = ip_rr;
-  CPU_NumericType new_ipp_rr_over_norm_rhs;
+  /** @brief Runs the pipelined conjugate gradient implementation for a solver object. Overload for compressed_matrix without preconditioner. */
+  template<typename NumericT>
+  void run_solver(viennacl::compressed_matrix<NumericT> const & A, viennacl::vector<NumericT> const & rhs, viennacl::vector<NumericT> & result, bool use_initial_guess,
+                  cg_tag const & tag, viennacl::linalg::no_precond,
+                  cg_workspace< viennacl::vector<NumericT> > & ws, solver_monitor< viennacl::vector<NumericT> > const & monitor)
+  {
+    pipelined_solve_impl(A, rhs, result, use_initial_guess, tag, ws, monitor);
+  }
 
-  if (norm_rhs_squared <= 0) //solution is zero if RHS norm is zero
-    return result;
+  /** @brief Runs the pipelined conjugate gradient implementation for a solver object. Overload for coordinate_matrix without preconditioner. */
+  template<typename NumericT>
+  void run_solver(viennacl::coordinate_matrix<NumericT> const & A, viennacl::vector<NumericT> const & rhs, viennacl::vector<NumericT> & result, bool use_initial_guess,
+                  cg_tag const & tag, viennacl::linalg::no_precond,
+                  cg_workspace< viennacl::vector<NumericT> > & ws, solver_monitor< viennacl::vector<NumericT> > const & monitor)
+  {
+    pipelined_solve_impl(A, rhs, result, use_initial_guess, tag, ws, monitor);
+  }
 
-  for (unsigned int i = 0; i < tag.max_iterations(); ++i)
+  /** @brief Runs the pipelined conjugate gradient implementation for a solver object. Overload for ell_matrix without preconditioner. */
+  template<typename NumericT>
+  void run_solver(viennacl::ell_matrix<NumericT> const & A, viennacl::vector<NumericT> const & rhs, viennacl::vector<NumericT> & result, bool use_initial_guess,
+                  cg_tag const & tag, viennacl::linalg::no_precond,
+                  cg_workspace< viennacl::vector<NumericT> > & ws, solver_monitor< viennacl::vector<NumericT> > const & monitor)
   {
-    tag.iters(i+1);
-    tmp = viennacl::linalg::prod(matrix, p);
+    pipelined_solve_impl(A, rhs, result, use_initial_guess, tag, ws, monitor);
+  }
 
-    alpha = ip_rr / viennacl::linalg::inner_prod(tmp, p);
+  /** @brief Runs the pipelined conjugate gradient implementation for a solver object. Overload for sliced_ell_matrix without preconditioner. */
+  template<typename NumericT>
+  void run_solver(viennacl::sliced_ell_matrix<NumericT> const & A, viennacl::vector<NumericT> const & rhs, viennacl::vector<NumericT> & result, bool use_initial_guess,
+                  cg_tag const & tag, viennacl::linalg::no_precond,
+                  cg_workspace< viennacl::vector<NumericT> > & ws, solver_monitor< viennacl::vector<NumericT> > const & monitor)
+  {
+    pipelined_solve_impl(A, rhs, result, use_initial_guess, tag, ws, monitor);
+  }
 
-    result += alpha * p;
-    residual -= alpha * tmp;
-    z = residual;
-    precond.apply(z);
+  /** @brief Runs the pipelined conjugate gradient implementation for a solver object. Overload for hyb_matrix without preconditioner. */
+  template<typename NumericT>
+  void run_solver(viennacl::hyb_matrix<NumericT> const & A, viennacl::vector<NumericT> const & rhs, viennacl::vector<NumericT> & result, bool use_initial_guess,
+                  cg_tag const & tag, viennacl::linalg::no_precond,
+                  cg_workspace< viennacl::vector<NumericT> > & ws, solver_monitor< viennacl::vector<NumericT> > const & monitor)
+  {
+    pipelined_solve_impl(A, rhs, result, use_initial_guess, tag, ws, monitor);
+  }
+}
+
+/** @brief A conjugate gradient solver object, which keeps all buffers of the solver between solver runs.
+*
+* Repeated solves of systems with the same size do not allocate new buffers.
+* An initial guess can be provided either via set_initial_guess() or by passing the result vector to solve(), which then iterates in place.
+* A monitor callback set via set_monitor() is called after each iteration and may stop the solver run by returning true.
+*/
+template<typename VectorT>
+class cg_solver
+{
+public:
+  typedef typename detail::solver_monitor<VectorT>::numeric_type    numeric_type;
+
+  cg_solver(cg_tag const & tag = cg_tag()) : tag_(tag), use_initial_guess_(false) {}
 
-    if (static_cast<VectorT*>(&residual)==static_cast<VectorT*>(&z))
-      new_ip_rr = std::pow(viennacl::linalg::norm_2(residual),2);
+  /** @brief Solves A x = b using the preconditioner 'precond' and returns x. Starts from the initial guess if one is set.
+  *
+  * The result is kept in a buffer of the solver object, hence no memory is allocated if the system size does not change.
+  * The returned reference is valid until the next call of operator().
+  */
+  template<typename MatrixT, typename PreconditionerT>
+  VectorT const & operator()(MatrixT const & A, VectorT const & b, PreconditionerT const & precond) const
+  {
+    detail::prepare_workspace_vector(result_, b);
+    if (use_initial_guess_)
+      result_ = init_guess_;
     else
-      new_ip_rr = viennacl::linalg::inner_prod(residual, z);
+      viennacl::traits::clear(result_);
+    detail::run_solver(A, b, result_, use_initial_guess_, tag_, precond, workspace_, monitor_);
+    return result_;
+  }
+
+  /** @brief Solves A x = b without preconditioner and returns x. Starts from the initial guess if one is set. */
+  template<typename MatrixT>
+  VectorT const & operator()(MatrixT const & A, VectorT const & b) const
+  {
+    return operator()(A, b, viennacl::linalg::no_precond());
+  }
+
+  /** @brief Solves A x = b in place using the preconditioner 'precond'. The entries of 'x' on entry are used as initial guess. No buffers are allocated if the system size does not change. */
+  template<typename MatrixT, typename PreconditionerT>
+  void solve(MatrixT const & A, VectorT const & b, VectorT & x, PreconditionerT const & precond) const
+  {
+    detail::run_solver(A, b, x, true, tag_, precond, workspace_, monitor_);
+  }
 
-    new_ipp_rr_over_norm_rhs = new_ip_rr / norm_rhs_squared;
-    if (std::fabs(new_ipp_rr_over_norm_rhs) < tag.tolerance() *  tag.tolerance())    //squared norms involved here
-      break;
+  /** @brief Solves A x = b in place without preconditioner. The entries of 'x' on entry are used as initial guess. */
+  template<typename MatrixT>
+  void solve(MatrixT const & A, VectorT const & b, VectorT & x) const
+  {
+    solve(A, b, x, viennacl::linalg::no_precond());
+  }
 
-    beta = new_ip_rr / ip_rr;
-    ip_rr = new_ip_rr;
+  /** @brief Sets the initial guess used by operator() */
+  void set_initial_guess(VectorT const & x)
+  {
+    detail::prepare_workspace_vector(init_guess_, x);
+    init_guess_ = x;
+    use_initial_guess_ = true;
+  }
 
-    p = z + beta*p;
+  /** @brief Sets a monitor, which is called after each iteration with the current result, the estimated relative residual and 'user_data'. The solver stops if the monitor returns true. */
+  void set_monitor(bool (*monitor_fun)(VectorT const &, numeric_type, void *), void * user_data)
+  {
+    monitor_.set(monitor_fun, user_data);
   }
 
-  //store last error estimate:
-  tag.error(std::sqrt(std::fabs(new_ip_rr / norm_rhs_squared)));
+  /** @brief Returns the solver tag holding the configuration as well as the number of iterations and the estimated error of the last run */
+  cg_tag const & tag() const { return tag_; }
 
-  return result;
-}
+private:
+  cg_tag tag_;
+  VectorT init_guess_;
+  mutable VectorT result_;
+  bool use_initial_guess_;
+  detail::solver_monitor<VectorT> monitor_;
+  mutable detail::cg_workspace<VectorT> workspace_;
+};
 
-template<typename MatrixT, typename VectorT>
-VectorT solve(MatrixT const & matrix, VectorT const & rhs, cg_tag const & tag)
-{
-  return solve(matrix, rhs, tag, viennacl::linalg::no_precond());
-}
 
 }
 }
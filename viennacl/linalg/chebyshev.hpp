@@ -0,0 +1,340 @@
+#ifndef VIENNACL_LINALG_CHEBYSHEV_HPP_
+#define VIENNACL_LINALG_CHEBYSHEV_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/chebyshev.hpp
+    @brief The Chebyshev (semi-)iteration for symmetric positive definite systems is implemented here.
+*/
+
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <exception>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/tools/tools.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/inner_prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/tridiag_eig.hpp"
+#include "viennacl/linalg/iterative_operations.hpp"
+#include "viennacl/traits/clear.hpp"
+#include "viennacl/traits/context.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+
+/** @brief Exception thrown by the Chebyshev iteration if the bounds of the spectrum cannot be estimated, i.e. if the (preconditioned) system matrix is not positive definite. */
+class chebyshev_spectrum_exception : public std::exception
+{
+public:
+  virtual const char* what() const throw() { return "ViennaCL: Chebyshev iteration: Estimate of the spectrum failed. Is the (preconditioned) system matrix positive definite?"; }
+};
+
+/** @brief A tag for the Chebyshev iteration. Used for supplying solver parameters and for dispatching the solve() function.
+*
+* The Chebyshev iteration requires bounds [lower, upper] of the spectrum of the (preconditioned) system matrix.
+* If no bounds are set, they are estimated from a few Lanczos steps at the beginning of each solver run.
+* If this estimate fails, the solver throws a chebyshev_spectrum_exception.
+*/
+class chebyshev_tag
+{
+public:
+  /** @brief The constructor
+  *
+  * @param tol              Relative tolerance for the residual (solver quits if ||r|| < tol * ||rhs||)
+  * @param max_iterations   The maximum number of iterations
+  * @param check_interval   Number of iterations between two checks of the residual norm. Zero disables all checks, i.e. exactly max_iterations iterations are run without any inner product.
+  */
+  chebyshev_tag(double tol = 1e-8, unsigned int max_iterations = 300, unsigned int check_interval = 10)
+    : tol_(tol), iterations_(max_iterations), check_interval_(check_interval), estimation_steps_(20), lower_(0), upper_(0),
+      used_lower_(0), used_upper_(0), iters_taken_(0), last_error_(0) {}
+
+  /** @brief Returns the relative tolerance */
+  double tolerance() const { return tol_; }
+  /** @brief Returns the maximum number of iterations */
+  unsigned int max_iterations() const { return iterations_; }
+  /** @brief Returns the number of iterations between two checks of the residual norm (zero if the residual is not checked) */
+  unsigned int check_interval() const { return check_interval_; }
+
+  /** @brief Sets the bounds of the spectrum of the (preconditioned) system matrix. Passing zero for both restores the automatic estimate. */
+  void set_spectrum_bounds(double lower, double upper) { lower_ = lower; upper_ = upper; }
+  /** @brief Returns true if the bounds of the spectrum are set by the user rather than estimated */
+  bool has_spectrum_bounds() const { return upper_ > 0; }
+
+  /** @brief Sets the number of Lanczos steps used for estimating the bounds of the spectrum */
+  void set_estimation_steps(unsigned int steps) { if (steps > 0) estimation_steps_ = steps; }
+  /** @brief Returns the number of Lanczos steps used for estimating the bounds of the spectrum */
+  unsigned int estimation_steps() const { return estimation_steps_; }
+
+  /** @brief Returns the lower bound of the spectrum set by the user, or the one used in the last solver run (zero before the first run) if no bounds are set */
+  double spectrum_lower() const { return has_spectrum_bounds() ? lower_ : used_lower_; }
+  /** @brief Returns the upper bound of the spectrum set by the user, or the one used in the last solver run (zero before the first run) if no bounds are set */
+  double spectrum_upper() const { return has_spectrum_bounds() ? upper_ : used_upper_; }
+  /** @brief Sets the bounds of the spectrum used in the solver run */
+  void spectrum_used(double lower, double upper) const { used_lower_ = lower; used_upper_ = upper; }
+
+  /** @brief Return the number of solver iterations: */
+  unsigned int iters() const { return iters_taken_; }
+  void iters(unsigned int i) const { iters_taken_ = i; }
+
+  /** @brief Returns the estimated relative error at the end of the solver run */
+  double error() const { return last_error_; }
+  /** @brief Sets the estimated relative error at the end of the solver run */
+  void error(double e) const { last_error_ = e; }
+
+private:
+  double tol_;
+  unsigned int iterations_;
+  unsigned int check_interval_;
+  unsigned int estimation_steps_;
+  double lower_;
+  double upper_;
+
+  //return values from solver
+  mutable double used_lower_;
+  mutable double used_upper_;
+  mutable unsigned int iters_taken_;
+  mutable double last_error_;
+};
+
+namespace detail
+{
+  /** @brief Estimates the extremal eigenvalues of the preconditioned matrix M^{-1}A of a symmetric positive definite system.
+  *
+  * Runs 'steps' iterations of the preconditioned conjugate gradient method for a pseudo-random right hand side and computes the eigenvalues of the Lanczos tridiagonal matrix assembled from the CG coefficients.
+  * The Ritz values are inside the spectrum, hence lambda_max is approached from below and lambda_min from above.
+  * Both bounds are set to zero if the estimate fails (e.g. if the matrix is not positive definite).
+  *
+  * @param A            The system matrix
+  * @param precond      The preconditioner M, which is applied via the member function apply()
+  * @param size         The size of the system
+  * @param ctx          The memory domain for the work vectors
+  * @param steps        The maximum number of Lanczos steps
+  * @param lambda_min   Receives the smallest Ritz value
+  * @param lambda_max   Receives the largest Ritz value
+  */
+  template<typename NumericT, typename MatrixT, typename PreconditionerT>
+  void chebyshev_estimate_spectrum(MatrixT const & A, PreconditionerT const & precond,
+                                   vcl_size_t size, viennacl::context const & ctx, unsigned int steps,
+                                   double & lambda_min, double & lambda_max)
+  {
+    lambda_min = 0;
+    lambda_max = 0;
+    if (size == 0)
+      return;
+
+    // 'random' starting vector with only positive entries:
+    std::vector<NumericT> host_r(size);
+    unsigned int seed = 12345;
+    for (vcl_size_t i=0; i<size; ++i)
+    {
+      seed = seed * 1103515245u + 12345u;
+      host_r[i] = NumericT(0.5) + NumericT((seed >> 16) & 0x7fff) / NumericT(32768);
+    }
+
+    viennacl::vector<NumericT> r(size, ctx);
+    viennacl::vector<NumericT> z(size, ctx);
+    viennacl::vector<NumericT> p(size, ctx);
+    viennacl::vector<NumericT> Ap(size, ctx);
+    viennacl::copy(host_r, r);
+
+    z = r;
+    precond.apply(z);
+    p = z;
+    NumericT rz = viennacl::linalg::inner_prod(r, z);
+    NumericT rz_initial = rz;
+
+    std::vector<NumericT> diagonal;
+    std::vector<NumericT> offdiagonal(1);
+    NumericT alpha_old = 0;
+    NumericT beta_old = 0;
+
+    vcl_size_t max_steps = std::min<vcl_size_t>(steps, size);
+    for (vcl_size_t j=0; j<max_steps; ++j)
+    {
+      Ap = viennacl::linalg::prod(A, p);
+      NumericT pAp = viennacl::linalg::inner_prod(p, Ap);
+      if (rz <= 0 || pAp <= 0)
+        break;
+
+      NumericT alpha = rz / pAp;
+      diagonal.push_back(NumericT(1) / alpha + (j > 0 ? beta_old / alpha_old : NumericT(0)));
+      if (j > 0)
+        offdiagonal.push_back(std::sqrt(beta_old) / alpha_old);
+
+      r -= alpha * Ap;
+      z = r;
+      precond.apply(z);
+      NumericT rz_new = viennacl::linalg::inner_prod(r, z);
+      if (rz_new <= std::numeric_limits<NumericT>::epsilon() * std::numeric_limits<NumericT>::epsilon() * rz_initial) // invariant subspace found
+        break;
+
+      NumericT beta = rz_new / rz;
+      p = z + beta * p;
+
+      alpha_old = alpha;
+      beta_old  = beta;
+      rz        = rz_new;
+    }
+
+    if (diagonal.empty())
+      return;
+
+    std::vector<NumericT> eigenvalues;
+    std::vector<NumericT> eigenvectors;
+    viennacl::linalg::tridiag_eig(diagonal, offdiagonal, eigenvalues, eigenvectors, viennacl::linalg::tridiag_eig_tag(false));
+
+    lambda_min = static_cast<double>(eigenvalues.front());
+    lambda_max = static_cast<double>(eigenvalues.back());
+  }
+
+  /** @brief Returns the interval used by the Chebyshev iteration for the Ritz values from chebyshev_estimate_spectrum().
+  *
+  * The upper bound is enlarged slightly, because eigenvalues above the interval are amplified by the Chebyshev polynomial, whereas eigenvalues below the lower bound only slow down convergence.
+  */
+  inline void chebyshev_safe_bounds(double & lower, double & upper)
+  {
+    upper *= 1.05;
+    if (lower <= 0 || lower >= upper)
+      lower = upper / 30.0;
+  }
+
+  /** @brief Computes the search direction update d = alpha * d + beta * M^{-1} r, where the residual is updated by chebyshev_vector_update() */
+  template<typename NumericT, typename PreconditionerT>
+  void chebyshev_step(viennacl::vector<NumericT> & x, viennacl::vector<NumericT> & r, viennacl::vector<NumericT> & d,
+                      viennacl::vector<NumericT> const & Ad, viennacl::vector<NumericT> & z,
+                      NumericT alpha, NumericT beta, PreconditionerT const & precond)
+  {
+    viennacl::linalg::chebyshev_vector_update(x, r, d, Ad, alpha, NumericT(0));
+    z = r;
+    precond.apply(z);
+    d += beta * z;
+  }
+
+  /** @brief Fully fused search direction update if there is no preconditioner */
+  template<typename NumericT>
+  void chebyshev_step(viennacl::vector<NumericT> & x, viennacl::vector<NumericT> & r, viennacl::vector<NumericT> & d,
+                      viennacl::vector<NumericT> const & Ad, viennacl::vector<NumericT> &,
+                      NumericT alpha, NumericT beta, viennacl::linalg::no_precond const &)
+  {
+    viennacl::linalg::chebyshev_vector_update(x, r, d, Ad, alpha, beta);
+  }
+
+  /** @brief Implementation of the preconditioned Chebyshev iteration with a zero initial guess. */
+  template<typename MatrixT, typename NumericT, typename PreconditionerT>
+  void chebyshev_solve_impl(MatrixT const & A, viennacl::vector<NumericT> const & rhs, viennacl::vector<NumericT> & x,
+                            chebyshev_tag const & tag, PreconditionerT const & precond)
+  {
+    viennacl::context ctx = viennacl::traits::context(rhs);
+    vcl_size_t size = rhs.size();
+
+    tag.iters(0);
+    tag.error(0);
+    viennacl::traits::clear(x);
+
+    NumericT norm_rhs = viennacl::linalg::norm_2(rhs);
+    if (norm_rhs <= 0)
+      return;
+
+    double lower = 0;
+    double upper = 0;
+    if (tag.has_spectrum_bounds())
+    {
+      lower = tag.spectrum_lower();
+      upper = tag.spectrum_upper();
+    }
+    else
+    {
+      chebyshev_estimate_spectrum<NumericT>(A, precond, size, ctx, tag.estimation_steps(), lower, upper);
+      if (upper <= 0)
+        throw chebyshev_spectrum_exception();
+      chebyshev_safe_bounds(lower, upper);
+    }
+    tag.spectrum_used(lower, upper);
+    assert(lower > 0 && lower < upper && bool("Invalid bounds of the spectrum for the Chebyshev iteration!"));
+
+    NumericT theta = NumericT((upper + lower) / 2.0);
+    NumericT delta = NumericT((upper - lower) / 2.0);
+    NumericT sigma = theta / delta;
+    NumericT rho   = NumericT(1) / sigma;
+
+    viennacl::vector<NumericT> r = rhs;
+    viennacl::vector<NumericT> d(size, ctx);
+    viennacl::vector<NumericT> Ad(size, ctx);
+    viennacl::vector<NumericT> z(size, ctx);
+
+    z = r;
+    precond.apply(z);
+    d = z / theta;
+
+    NumericT tol = NumericT(tag.tolerance()) * norm_rhs;
+    for (unsigned int i=0; i<tag.max_iterations(); ++i)
+    {
+      NumericT rho_new = NumericT(1) / (NumericT(2) * sigma - rho);
+
+      Ad = viennacl::linalg::prod(A, d);
+      chebyshev_step(x, r, d, Ad, z, rho_new * rho, NumericT(2) * rho_new / delta, precond);
+      rho = rho_new;
+      tag.iters(i+1);
+
+      if (tag.check_interval() > 0 && (i+1) % tag.check_interval() == 0 && viennacl::linalg::norm_2(r) < tol)
+        break;
+    }
+
+    tag.error(viennacl::linalg::norm_2(r) / norm_rhs);
+  }
+}
+
+/** @brief Implementation of the preconditioned Chebyshev iteration for symmetric positive definite systems.
+*
+* Following Algorithm 12.1 in "Iterative Methods for Sparse Linear Systems" by Y. Saad, with the residual updated by recurrence.
+* Apart from the (optional) estimate of the spectrum, each iteration consists of a sparse matrix-vector product, the preconditioner, and a single fused vector update.
+* Inner products are only computed every tag.check_interval() iterations.
+*
+* @param A          The system matrix. Any of the ViennaCL sparse matrix types can be used.
+* @param rhs        The load vector
+* @param tag        Solver configuration tag
+* @param precond    A symmetric positive definite preconditioner. Precondition operation is done via member function apply()
+* @return The result vector
+*
+* Throws a chebyshev_spectrum_exception if no bounds of the spectrum are set in the tag and the estimate fails.
+*/
+template<typename MatrixT, typename NumericT, typename PreconditionerT>
+viennacl::vector<NumericT> solve(MatrixT const & A, viennacl::vector<NumericT> const & rhs, chebyshev_tag const & tag, PreconditionerT const & precond)
+{
+  viennacl::vector<NumericT> result(rhs.size(), viennacl::traits::context(rhs));
+  detail::chebyshev_solve_impl(A, rhs, result, tag, precond);
+  return result;
+}
+
+template<typename MatrixT, typename NumericT>
+viennacl::vector<NumericT> solve(MatrixT const & A, viennacl::vector<NumericT> const & rhs, chebyshev_tag const & tag)
+{
+  return solve(A, rhs, tag, viennacl::linalg::no_precond());
+}
+
+}
+}
+
+#endif
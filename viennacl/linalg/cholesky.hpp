@@ -0,0 +1,360 @@
+#ifndef VIENNACL_LINALG_CHOLESKY_HPP
+#define VIENNACL_LINALG_CHOLESKY_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/cholesky.hpp
+    @brief Implementations of the Cholesky factorization A = L * L^T for dense symmetric positive definite matrices.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/direct_solve.hpp"
+#include "viennacl/linalg/matrix_operations.hpp"
+#include "viennacl/linalg/host_based/matrix_operations.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+
+/** @brief Exception thrown by cholesky_factorize() if a matrix is not (numerically) positive definite */
+class not_positive_definite_exception : public std::exception
+{
+public:
+  /** @brief Failure of the factorization of a single matrix */
+  explicit not_positive_definite_exception(vcl_size_t pivot_index) : pivot_index_(pivot_index), matrix_index_(0), is_batched_(false)
+  {
+    std::stringstream ss;
+    ss << "ViennaCL: Matrix is not positive definite: Non-positive pivot at index " << pivot_index;
+    message_ = ss.str();
+  }
+
+  /** @brief Failure of the factorization of the matrix at position matrix_index of a batch */
+  not_positive_definite_exception(vcl_size_t pivot_index, vcl_size_t matrix_index) : pivot_index_(pivot_index), matrix_index_(matrix_index), is_batched_(true)
+  {
+    std::stringstream ss;
+    ss << "ViennaCL: Matrix " << matrix_index << " in batch is not positive definite: Non-positive pivot at index " << pivot_index;
+    message_ = ss.str();
+  }
+
+  virtual const char* what() const throw() { return message_.c_str(); }
+
+  /** @brief Returns the (zero-based) row index of the first non-positive pivot */
+  vcl_size_t pivot_index() const { return pivot_index_; }
+
+  /** @brief Returns true if the exception was raised by a batched factorization. Only then matrix_index() is meaningful. */
+  bool is_batched() const { return is_batched_; }
+
+  /** @brief Returns the (zero-based) position of the failing matrix in the batch if is_batched() is true, zero otherwise */
+  vcl_size_t matrix_index() const { return matrix_index_; }
+
+  virtual ~not_positive_definite_exception() throw() {}
+
+private:
+  vcl_size_t pivot_index_;
+  vcl_size_t matrix_index_;
+  bool is_batched_;
+  std::string message_;
+};
+
+namespace detail
+{
+  /** @brief Number of columns of the panels in the blocked Cholesky factorization */
+  static const vcl_size_t cholesky_block_size = 64;
+
+  /** @brief Returns the strides of the submatrix of A starting at (i, j) */
+  template<typename NumericT>
+  viennacl::linalg::host_based::detail::dense_strides<NumericT> cholesky_subblock(viennacl::linalg::host_based::detail::dense_strides<NumericT> const & A, vcl_size_t i, vcl_size_t j)
+  {
+    viennacl::linalg::host_based::detail::dense_strides<NumericT> s = A;
+    s.data += i * A.row_inc + j * A.col_inc;
+    return s;
+  }
+
+  /** @brief Unblocked Cholesky factorization of the leading n-by-n block of A, overwriting the lower triangle with L.
+  *
+  * @return The index of the first non-positive pivot, or n if the factorization succeeded
+  */
+  template<typename NumericT>
+  vcl_size_t cholesky_unblocked(viennacl::linalg::host_based::detail::dense_strides<NumericT> const & A, vcl_size_t n)
+  {
+    for (vcl_size_t j = 0; j < n; ++j)
+    {
+      NumericT d = A(j, j);
+      for (vcl_size_t k = 0; k < j; ++k)
+        d -= A(j, k) * A(j, k);
+
+      if (!(d > 0)) // also catches NaN
+        return j;
+
+      d = std::sqrt(d);
+      A(j, j) = d;
+
+      for (vcl_size_t i = j + 1; i < n; ++i)
+      {
+        NumericT s = A(i, j);
+        for (vcl_size_t k = 0; k < j; ++k)
+          s -= A(i, k) * A(j, k);
+        A(i, j) = s / d;
+      }
+    }
+    return n;
+  }
+
+  /** @brief Computes L21 = A21 * L11^{-T} for the panel below a factorized diagonal block, processing the rows of A21 in parallel */
+  template<typename NumericT>
+  void cholesky_panel_solve(viennacl::linalg::host_based::detail::dense_strides<NumericT> const & L11,
+                            viennacl::linalg::host_based::detail::dense_strides<NumericT> const & A21,
+                            vcl_size_t rows, vcl_size_t block_size)
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (rows * block_size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+    for (long row2 = 0; row2 < static_cast<long>(rows); ++row2)
+    {
+      vcl_size_t row = static_cast<vcl_size_t>(row2);
+      for (vcl_size_t j = 0; j < block_size; ++j)
+      {
+        NumericT s = A21(row, j);
+        for (vcl_size_t k = 0; k < j; ++k)
+          s -= A21(row, k) * L11(j, k);
+        A21(row, j) = s / L11(j, j);
+      }
+    }
+  }
+
+  /** @brief Blocked right-looking Cholesky factorization of a matrix in main memory. Trailing updates are carried out with syrk().
+  *
+  * @return The index of the first non-positive pivot, or size1(A) if the factorization succeeded
+  */
+  template<typename NumericT>
+  vcl_size_t cholesky_factorize_host(matrix_base<NumericT> & A)
+  {
+    typedef viennacl::linalg::host_based::detail::dense_strides<NumericT>   StridesType;
+
+    vcl_size_t n = A.size1();
+    StridesType strides_A = viennacl::linalg::host_based::detail::make_dense_strides(A, viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A));
+
+    if (n <= cholesky_block_size)
+      return cholesky_unblocked(strides_A, n);
+
+    for (vcl_size_t offset = 0; offset < n; offset += cholesky_block_size)
+    {
+      vcl_size_t block_size = std::min(cholesky_block_size, n - offset);
+
+      StridesType A11 = cholesky_subblock(strides_A, offset, offset);
+      vcl_size_t pivot = cholesky_unblocked(A11, block_size);
+      if (pivot < block_size)
+        return offset + pivot;
+
+      if (offset + block_size < n)
+      {
+        cholesky_panel_solve(A11, cholesky_subblock(strides_A, offset + block_size, offset), n - offset - block_size, block_size);
+
+        viennacl::range block_range(offset, offset + block_size);
+        viennacl::range remainder_range(offset + block_size, n);
+        viennacl::matrix_range<matrix_base<NumericT> > L21(A, remainder_range, block_range);
+        viennacl::matrix_range<matrix_base<NumericT> > A22(A, remainder_range, remainder_range);
+        viennacl::linalg::syrk(L21, false, A22, NumericT(-1), NumericT(1), viennacl::linalg::lower_tag());
+      }
+    }
+    return n;
+  }
+
+  /** @brief Returns the position of entry (i, j) of A in its buffer */
+  template<typename NumericT>
+  vcl_size_t cholesky_mem_index(matrix_base<NumericT> const & A, vcl_size_t i, vcl_size_t j)
+  {
+    if (A.row_major())
+      return (A.start1() + i * A.stride1()) * A.internal_size2() + A.start2() + j * A.stride2();
+    return A.start1() + i * A.stride1() + (A.start2() + j * A.stride2()) * A.internal_size1();
+  }
+
+  /** @brief Blocked Cholesky factorization for matrices in OpenCL or CUDA memory.
+  *
+  * The diagonal blocks are factorized on the host, the panels and trailing updates use inplace_solve() and prod() on the device.
+  *
+  * @return The index of the first non-positive pivot, or size1(A) if the factorization succeeded
+  */
+  template<typename NumericT>
+  vcl_size_t cholesky_factorize_device(matrix_base<NumericT> & A)
+  {
+    vcl_size_t n = A.size1();
+    std::vector<NumericT> buffer;
+
+    for (vcl_size_t offset = 0; offset < n; offset += cholesky_block_size)
+    {
+      vcl_size_t block_size = std::min(cholesky_block_size, n - offset);
+
+      // Read the memory region holding the diagonal block and factorize on the host:
+      vcl_size_t first = cholesky_mem_index(A, offset, offset);
+      vcl_size_t last  = cholesky_mem_index(A, offset + block_size - 1, offset + block_size - 1);
+      buffer.resize(last - first + 1);
+      viennacl::backend::memory_read(A.handle(), sizeof(NumericT) * first, sizeof(NumericT) * buffer.size(), &(buffer[0]));
+
+      viennacl::linalg::host_based::detail::dense_strides<NumericT> A11;
+      A11.data    = &(buffer[0]);
+      A11.row_inc = A.row_major() ? A.stride1() * A.internal_size2() : A.stride1();
+      A11.col_inc = A.row_major() ? A.stride2() : A.stride2() * A.internal_size1();
+      vcl_size_t pivot = cholesky_unblocked(A11, block_size);
+      if (pivot < block_size)
+        return offset + pivot;
+
+      viennacl::backend::memory_write(A.handle(), sizeof(NumericT) * first, sizeof(NumericT) * buffer.size(), &(buffer[0]));
+
+      if (offset + block_size < n)
+      {
+        viennacl::range block_range(offset, offset + block_size);
+        viennacl::range remainder_range(offset + block_size, n);
+        viennacl::matrix_range<matrix_base<NumericT> > L11(A, block_range, block_range);
+        viennacl::matrix_range<matrix_base<NumericT> > A21(A, remainder_range, block_range);
+        viennacl::matrix_range<matrix_base<NumericT> > A22(A, remainder_range, remainder_range);
+
+        // L21 = A21 * L11^{-T}, i.e. L21^T = L11^{-1} * A21^T
+        viennacl::linalg::inplace_solve(L11, trans(A21), viennacl::linalg::lower_tag());
+
+        A22 -= viennacl::linalg::prod(A21, trans(A21));
+      }
+    }
+    return n;
+  }
+
+  template<typename NumericT>
+  vcl_size_t cholesky_factorize_impl(matrix_base<NumericT> & A)
+  {
+    if (viennacl::traits::active_handle_id(A) == viennacl::MAIN_MEMORY)
+    {
+      viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(A));
+      return cholesky_factorize_host(A);
+    }
+    return cholesky_factorize_device(A);
+  }
+}
+
+
+/** @brief Cholesky factorization A = L * L^T of a dense symmetric positive definite matrix.
+*
+* Uses a blocked right-looking algorithm: Each diagonal block is factorized directly, the panel below is obtained from a triangular solve, and the trailing matrix is updated with a symmetric rank-k update.
+* Only the lower triangle of A is referenced.
+* With the host backend, the strictly upper triangle of A remains unchanged, while other backends use it for intermediate results.
+*
+* @param A    The system matrix, where L is directly written to the lower triangle
+* @throws not_positive_definite_exception if a non-positive pivot is encountered. The lower triangle of A then holds intermediate results.
+*/
+template<typename NumericT>
+void cholesky_factorize(matrix_base<NumericT> & A)
+{
+  assert(A.size1() == A.size2() && bool("Matrix must be square"));
+
+  vcl_size_t pivot = detail::cholesky_factorize_impl(A);
+  if (pivot < A.size1())
+    throw not_positive_definite_exception(pivot);
+}
+
+/** @brief Cholesky factorization of a batch of dense symmetric positive definite matrices.
+*
+* With the host backend, the matrices are factorized in parallel, which is much more efficient than factorizing many small matrices one after another.
+* All matrices are processed even if some of them are not positive definite.
+*
+* @param batch  The matrices, each of which is overwritten by its Cholesky factor as in cholesky_factorize()
+* @throws not_positive_definite_exception for the first matrix in the batch which is not positive definite. Its is_batched() is true and matrix_index() returns the position of the matrix.
+*/
+template<typename MatrixT>
+void cholesky_factorize(std::vector<MatrixT> & batch)
+{
+  std::vector<vcl_size_t> pivots(batch.size());
+
+  bool all_host = true;
+  for (vcl_size_t i = 0; i < batch.size(); ++i)
+  {
+    assert(batch[i].size1() == batch[i].size2() && bool("Matrix must be square"));
+    all_host = all_host && (viennacl::traits::active_handle_id(batch[i]) == viennacl::MAIN_MEMORY);
+  }
+
+  if (all_host && batch.size() > 0)
+  {
+    viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(batch[0]));
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for (long i2 = 0; i2 < static_cast<long>(batch.size()); ++i2)
+    {
+      vcl_size_t i = static_cast<vcl_size_t>(i2);
+      pivots[i] = detail::cholesky_factorize_host(batch[i]);
+    }
+  }
+  else
+  {
+    for (vcl_size_t i = 0; i < batch.size(); ++i)
+      pivots[i] = detail::cholesky_factorize_impl(batch[i]);
+  }
+
+  for (vcl_size_t i = 0; i < batch.size(); ++i)
+    if (pivots[i] < batch[i].size1())
+      throw not_positive_definite_exception(pivots[i], i);
+}
+
+
+//
+// Convenience layer:
+//
+
+/** @brief Solves A X = B for multiple right hand sides, where A = L * L^T has been computed by cholesky_factorize().
+*
+* @param L    The Cholesky factor in the lower triangle as computed by cholesky_factorize()
+* @param B    The matrix of load vectors (as columns), where the solution is directly written to
+*/
+template<typename NumericT>
+void cholesky_substitute(matrix_base<NumericT> const & L,
+                         matrix_base<NumericT> & B)
+{
+  assert(L.size1() == L.size2() && bool("Matrix must be square"));
+  assert(L.size1() == B.size1() && bool("Size check failed in cholesky_substitute(): size1(L) != size1(B)"));
+  inplace_solve(L, B, lower_tag());
+  inplace_solve(trans(L), B, upper_tag());
+}
+
+/** @brief Solves A x = b, where A = L * L^T has been computed by cholesky_factorize().
+*
+* @param L      The Cholesky factor in the lower triangle as computed by cholesky_factorize()
+* @param vec    The load vector, where the solution is directly written to
+*/
+template<typename NumericT>
+void cholesky_substitute(matrix_base<NumericT> const & L,
+                         vector_base<NumericT> & vec)
+{
+  assert(L.size1() == L.size2() && bool("Matrix must be square"));
+  assert(L.size1() == vec.size() && bool("Size check failed in cholesky_substitute(): size1(L) != size(b)"));
+  inplace_solve(L, vec, lower_tag());
+  inplace_solve(trans(L), vec, upper_tag());
+}
+
+}
+}
+
+#endif
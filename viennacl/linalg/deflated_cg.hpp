@@ -0,0 +1,379 @@
+#ifndef VIENNACL_LINALG_DEFLATED_CG_HPP_
+#define VIENNACL_LINALG_DEFLATED_CG_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/deflated_cg.hpp
+    @brief The deflated conjugate gradient method with a recycle space, which is carried over from one solver run to the next.
+
+    Implementation following Y. Saad, M. Yeung, J. Erhel, F. Guyomarc'h, SIAM J. Sci. Comput. 21(5), 1909-1926 (2000).
+*/
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/inner_prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/traits/context.hpp"
+#include "viennacl/linalg/detail/iterative_solver_support.hpp"
+#include "viennacl/linalg/detail/krylov_recycling.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+
+/** @brief A tag for the deflated conjugate gradient method. Used for supplying solver parameters to deflated_cg_solver.
+*/
+class deflated_cg_tag
+{
+public:
+  /** @brief The constructor
+  *
+  * @param tol                Relative tolerance for the residual (solver quits if ||r|| < tol * ||b||)
+  * @param max_iterations     The maximum number of iterations
+  * @param recycle_dim        Dimension of the recycle space (number of deflated eigenmodes)
+  * @param stored_directions  Number of search directions of a solver run, which are used for updating the recycle space
+  */
+  deflated_cg_tag(double tol = 1e-8, unsigned int max_iterations = 300, unsigned int recycle_dim = 8, unsigned int stored_directions = 20)
+    : tol_(tol), iterations_(max_iterations), recycle_dim_(recycle_dim), stored_directions_(stored_directions) {}
+
+  /** @brief Returns the relative tolerance */
+  double tolerance() const { return tol_; }
+  /** @brief Returns the maximum number of iterations */
+  unsigned int max_iterations() const { return iterations_; }
+  /** @brief Returns the dimension of the recycle space */
+  unsigned int recycle_dim() const { return recycle_dim_; }
+  /** @brief Returns the number of search directions used for updating the recycle space */
+  unsigned int stored_directions() const { return stored_directions_; }
+
+  /** @brief Return the number of solver iterations: */
+  unsigned int iters() const { return iters_taken_; }
+  void iters(unsigned int i) const { iters_taken_ = i; }
+
+  /** @brief Returns the estimated relative error at the end of the solver run */
+  double error() const { return last_error_; }
+  /** @brief Sets the estimated relative error at the end of the solver run */
+  void error(double e) const { last_error_ = e; }
+
+private:
+  double tol_;
+  unsigned int iterations_;
+  unsigned int recycle_dim_;
+  unsigned int stored_directions_;
+
+  //return values from solver
+  mutable unsigned int iters_taken_;
+  mutable double last_error_;
+};
+
+
+/** @brief A deflated conjugate gradient solver for sequences of symmetric positive definite systems. Only available for ViennaCL vectors. */
+template<typename VectorT>
+class deflated_cg_solver;
+
+/** @brief A deflated conjugate gradient solver for sequences of symmetric positive definite systems.
+*
+* The search directions are kept A-orthogonal to the recycle space W, so the eigenmodes captured by W do not slow down convergence.
+* After each solver run, W is replaced by the harmonic Ritz vectors of smallest harmonic Ritz value within the span of W and the first search directions of the run.
+* Thus, the recycle space improves from one system to the next for slowly varying sequences of systems.
+*
+* W and A*W are stored as column-major dense matrices in the memory domain of the right hand side.
+* The projections (A*W)^T z and W mu in each iteration are dense matrix-vector products, which traverse the stored basis once.
+*/
+template<typename NumericT>
+class deflated_cg_solver< viennacl::vector<NumericT> >
+{
+public:
+  typedef viennacl::vector<NumericT>                            vector_type;
+  typedef viennacl::matrix<NumericT, viennacl::column_major>    matrix_type;
+
+  deflated_cg_solver(deflated_cg_tag const & tag = deflated_cg_tag()) : tag_(tag), recycle_size_(0) {}
+
+  /** @brief Solves A x = b using the preconditioner 'precond' (symmetric positive definite) and returns x, starting from a zero initial guess. The recycle space is updated. */
+  template<typename MatrixT, typename PreconditionerT>
+  vector_type operator()(MatrixT const & A, vector_type const & b, PreconditionerT const & precond)
+  {
+    vector_type result(b.size(), viennacl::traits::context(b));
+    solve(A, b, result, precond);
+    return result;
+  }
+
+  /** @brief Solves A x = b without preconditioner and returns x, starting from a zero initial guess. The recycle space is updated. */
+  template<typename MatrixT>
+  vector_type operator()(MatrixT const & A, vector_type const & b)
+  {
+    return operator()(A, b, viennacl::linalg::no_precond());
+  }
+
+  /** @brief Solves A x = b without preconditioner in place. The entries of 'x' on entry are used as initial guess. The recycle space is updated. */
+  template<typename MatrixT>
+  void solve(MatrixT const & A, vector_type const & b, vector_type & x)
+  {
+    solve(A, b, x, viennacl::linalg::no_precond());
+  }
+
+  /** @brief Solves A x = b using the preconditioner 'precond' (symmetric positive definite) in place. The entries of 'x' on entry are used as initial guess. The recycle space is updated. */
+  template<typename MatrixT, typename PreconditionerT>
+  void solve(MatrixT const & A, vector_type const & b, vector_type & x, PreconditionerT const & precond);
+
+  /** @brief Returns the number of columns of the current recycle space */
+  vcl_size_t recycle_size() const { return recycle_size_; }
+
+  /** @brief Returns the current recycle space W as a dense matrix with recycle_size() columns */
+  matrix_type recycle_space() const
+  {
+    matrix_type W(basis_.size1(), recycle_size_, viennacl::traits::context(basis_));
+    if (recycle_size_ > 0)
+      W = viennacl::project(basis_, viennacl::range(0, basis_.size1()), viennacl::range(0, recycle_size_));
+    return W;
+  }
+
+  /** @brief Sets the recycle space used for the next solver run, e.g. approximations of eigenvectors of the smallest eigenvalues known from the application. At most recycle_dim() columns of 'W' are used. */
+  void set_recycle_space(matrix_type const & W)
+  {
+    vcl_size_t cols = std::min<vcl_size_t>(W.size2(), tag_.recycle_dim());
+    viennacl::linalg::detail::prepare_workspace_matrix(basis_, W.size1(), tag_.recycle_dim() + tag_.stored_directions(), viennacl::traits::context(W));
+    if (cols > 0)
+      viennacl::project(basis_, viennacl::range(0, W.size1()), viennacl::range(0, cols)) = viennacl::project(W, viennacl::range(0, W.size1()), viennacl::range(0, cols));
+    recycle_size_ = cols;
+  }
+
+  /** @brief Discards the recycle space, so that the next solver run is a plain conjugate gradient run */
+  void clear_recycle_space() { recycle_size_ = 0; }
+
+  /** @brief Returns the solver tag holding the configuration as well as the number of iterations and the estimated error of the last run */
+  deflated_cg_tag const & tag() const { return tag_; }
+
+private:
+  /** @brief Updates the recycle space from the basis [W, P] and the products [A*W, A*P] with 'num_directions' stored search directions P */
+  void update_recycle_space(vcl_size_t num_directions);
+
+  deflated_cg_tag tag_;
+  vcl_size_t recycle_size_;
+
+  matrix_type basis_;      // [W, P]: recycle space followed by the stored search directions
+  matrix_type A_basis_;    // [A*W, A*P]
+  matrix_type new_basis_;
+  vector_type residual_;
+  vector_type p_;
+  vector_type Ap_;
+  vector_type z_;
+  vector_type projection_;  // device buffer for (A*W)^T z and mu
+  std::vector<NumericT> WtAW_;    // Cholesky factor of W^T A W
+  std::vector<NumericT> mu_;
+};
+
+
+template<typename NumericT>
+template<typename MatrixT, typename PreconditionerT>
+void deflated_cg_solver< viennacl::vector<NumericT> >::solve(MatrixT const & A, vector_type const & b, vector_type & x, PreconditionerT const & precond)
+{
+  typedef viennacl::matrix_range<matrix_type>   MatrixRangeType;
+
+  vcl_size_t n = b.size();
+  viennacl::context ctx = viennacl::traits::context(b);
+  vcl_size_t max_cols = tag_.recycle_dim() + tag_.stored_directions();
+
+  if (basis_.size1() != n)
+    recycle_size_ = 0;
+  viennacl::linalg::detail::prepare_workspace_matrix(basis_,   n, max_cols, ctx);
+  viennacl::linalg::detail::prepare_workspace_matrix(A_basis_, n, max_cols, ctx);
+  viennacl::linalg::detail::prepare_workspace_vector(residual_, n, ctx);
+  viennacl::linalg::detail::prepare_workspace_vector(p_, n, ctx);
+  viennacl::linalg::detail::prepare_workspace_vector(Ap_, n, ctx);
+  viennacl::linalg::detail::prepare_workspace_vector(z_, n, ctx);
+  viennacl::linalg::detail::prepare_workspace_vector(projection_, std::max<vcl_size_t>(tag_.recycle_dim(), 1), ctx);
+
+  tag_.iters(0);
+  tag_.error(0);
+
+  NumericT norm_rhs = viennacl::linalg::norm_2(b);
+  if (norm_rhs <= 0) //solution is zero if RHS norm is zero
+  {
+    x.clear();
+    return;
+  }
+
+  viennacl::range all_rows(0, n);
+  vcl_size_t k = recycle_size_;
+
+  //
+  // Set up W^T A W for the (possibly changed) system matrix:
+  //
+  if (k > 0)
+  {
+    for (vcl_size_t j = 0; j < k; ++j)
+    {
+      viennacl::vector_base<NumericT> w_j (basis_.handle(),   n, j * basis_.internal_size1(),   1);
+      viennacl::vector_base<NumericT> Aw_j(A_basis_.handle(), n, j * A_basis_.internal_size1(), 1);
+      Aw_j = viennacl::linalg::prod(A, w_j);
+    }
+
+    MatrixRangeType W (basis_,   all_rows, viennacl::range(0, k));
+    MatrixRangeType AW(A_basis_, all_rows, viennacl::range(0, k));
+    matrix_type WtAW = viennacl::linalg::prod(trans(W), AW);
+    viennacl::linalg::detail::reduction_matrix_to_host(WtAW, WtAW_);
+    for (vcl_size_t j = 0; j < k; ++j)  // symmetrize
+      for (vcl_size_t i = j + 1; i < k; ++i)
+        WtAW_[i + j * k] = WtAW_[j + i * k] = (WtAW_[i + j * k] + WtAW_[j + i * k]) / NumericT(2);
+    if (!viennacl::linalg::detail::recycling_cholesky(k, &WtAW_[0], k))
+      k = recycle_size_ = 0;
+  }
+
+  viennacl::vector_range<vector_type> projection(projection_, viennacl::range(0, std::max<vcl_size_t>(k, 1)));
+  mu_.resize(std::max<vcl_size_t>(k, 1));
+
+  //
+  // Initial residual, projected such that W^T r = 0:
+  //
+  residual_ = viennacl::linalg::prod(A, x);
+  residual_ = b - residual_;
+  if (k > 0)
+  {
+    MatrixRangeType W (basis_,   all_rows, viennacl::range(0, k));
+    MatrixRangeType AW(A_basis_, all_rows, viennacl::range(0, k));
+
+    // x += W (W^T A W)^{-1} W^T r,  r -= A W (W^T A W)^{-1} W^T r
+    projection = viennacl::linalg::prod(trans(W), residual_);
+    viennacl::backend::memory_read(projection_.handle(), 0, sizeof(NumericT) * k, &mu_[0]);
+    viennacl::linalg::detail::recycling_cholesky_trsm(false, k, &WtAW_[0], k, 1, &mu_[0], k);
+    viennacl::linalg::detail::recycling_cholesky_trsm(true,  k, &WtAW_[0], k, 1, &mu_[0], k);
+    viennacl::backend::memory_write(projection_.handle(), 0, sizeof(NumericT) * k, &mu_[0]);
+    x         += viennacl::linalg::prod(W,  projection);
+    residual_ -= viennacl::linalg::prod(AW, projection);
+  }
+
+  NumericT norm_residual = viennacl::linalg::norm_2(residual_);
+  tag_.error(norm_residual / norm_rhs);
+  if (tag_.error() < tag_.tolerance())
+    return;
+
+  vcl_size_t num_directions = 0;
+  NumericT ip_rz = 0;
+  for (unsigned int i = 0; i < tag_.max_iterations(); ++i)
+  {
+    tag_.iters(i + 1);
+
+    // z = M^{-1} r,  p = beta * p + z - W mu  with  mu = (W^T A W)^{-1} (A W)^T z
+    z_ = residual_;
+    precond.apply(z_);
+    NumericT ip_rz_new = viennacl::linalg::inner_prod(residual_, z_);
+    if (i == 0)
+      p_ = z_;
+    else
+    {
+      p_ *= ip_rz_new / ip_rz;
+      p_ += z_;
+    }
+    ip_rz = ip_rz_new;
+
+    if (k > 0)
+    {
+      MatrixRangeType W (basis_,   all_rows, viennacl::range(0, k));
+      MatrixRangeType AW(A_basis_, all_rows, viennacl::range(0, k));
+
+      projection = viennacl::linalg::prod(trans(AW), z_);
+      viennacl::backend::memory_read(projection_.handle(), 0, sizeof(NumericT) * k, &mu_[0]);
+      viennacl::linalg::detail::recycling_cholesky_trsm(false, k, &WtAW_[0], k, 1, &mu_[0], k);
+      viennacl::linalg::detail::recycling_cholesky_trsm(true,  k, &WtAW_[0], k, 1, &mu_[0], k);
+      viennacl::backend::memory_write(projection_.handle(), 0, sizeof(NumericT) * k, &mu_[0]);
+      p_ -= viennacl::linalg::prod(W, projection);
+    }
+
+    Ap_ = viennacl::linalg::prod(A, p_);
+
+    // keep the first search directions for the update of the recycle space:
+    if (num_directions < tag_.stored_directions())
+    {
+      vcl_size_t col = k + num_directions;
+      viennacl::vector_base<NumericT> p_col (basis_.handle(),   n, col * basis_.internal_size1(),   1);
+      viennacl::vector_base<NumericT> Ap_col(A_basis_.handle(), n, col * A_basis_.internal_size1(), 1);
+      p_col  = p_;
+      Ap_col = Ap_;
+      ++num_directions;
+    }
+
+    NumericT alpha = ip_rz / viennacl::linalg::inner_prod(p_, Ap_);
+    x         += alpha * p_;
+    residual_ -= alpha * Ap_;
+
+    norm_residual = viennacl::linalg::norm_2(residual_);
+    tag_.error(norm_residual / norm_rhs);
+    if (tag_.error() < tag_.tolerance())
+      break;
+  }
+
+  update_recycle_space(num_directions);
+}
+
+
+template<typename NumericT>
+void deflated_cg_solver< viennacl::vector<NumericT> >::update_recycle_space(vcl_size_t num_directions)
+{
+  typedef viennacl::matrix_range<matrix_type>   MatrixRangeType;
+
+  vcl_size_t n = basis_.size1();
+  vcl_size_t s = recycle_size_ + num_directions;
+  vcl_size_t new_size = std::min<vcl_size_t>(tag_.recycle_dim(), s);
+  if (num_directions == 0 || new_size == 0)
+    return;
+
+  viennacl::range all_rows(0, n);
+  MatrixRangeType Z (basis_,   all_rows, viennacl::range(0, s));
+  MatrixRangeType AZ(A_basis_, all_rows, viennacl::range(0, s));
+
+  // harmonic Ritz problem (AZ)^T (AZ) y = theta Z^T (AZ) y:
+  matrix_type F_device = viennacl::linalg::prod(trans(AZ), AZ);
+  matrix_type G_device = viennacl::linalg::prod(trans(Z),  AZ);
+  std::vector<NumericT> F, G, Y;
+  viennacl::linalg::detail::reduction_matrix_to_host(F_device, F);
+  viennacl::linalg::detail::reduction_matrix_to_host(G_device, G);
+  for (vcl_size_t j = 0; j < s; ++j)  // symmetrize
+    for (vcl_size_t i = j + 1; i < s; ++i)
+    {
+      F[i + j * s] = F[j + i * s] = (F[i + j * s] + F[j + i * s]) / NumericT(2);
+      G[i + j * s] = G[j + i * s] = (G[i + j * s] + G[j + i * s]) / NumericT(2);
+    }
+
+  if (!viennacl::linalg::detail::recycling_harmonic_ritz_spd(s, F, G, new_size, Y))
+    return;
+
+  // W = Z Y, A W = (A Z) Y:
+  matrix_type Y_device(s, new_size, viennacl::traits::context(basis_));
+  viennacl::linalg::detail::reduction_host_to_matrix(Y, Y_device);
+  viennacl::linalg::detail::prepare_workspace_matrix(new_basis_, n, new_size, viennacl::traits::context(basis_));
+
+  new_basis_ = viennacl::linalg::prod(Z, Y_device);
+  MatrixRangeType(basis_, all_rows, viennacl::range(0, new_size)) = new_basis_;
+  new_basis_ = viennacl::linalg::prod(AZ, Y_device);
+  MatrixRangeType(A_basis_, all_rows, viennacl::range(0, new_size)) = new_basis_;
+
+  recycle_size_ = new_size;
+}
+
+}
+}
+
+#endif
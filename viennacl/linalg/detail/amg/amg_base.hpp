@@ -27,6 +27,7 @@
 #include <boost/numeric/ublas/operation.hpp>
 #include <boost/numeric/ublas/vector.hpp>
 #include <cmath>
+#include <vector>
 #include <set>
 #include <list>
 #include <algorithm>
@@ -43,10 +44,21 @@
 #define VIENNACL_AMG_COARSE_RS0 3
 #define VIENNACL_AMG_COARSE_RS3 4
 #define VIENNACL_AMG_COARSE_AG 5
+#define VIENNACL_AMG_COARSE_PMIS 6
+#define VIENNACL_AMG_COARSE_HMIS 7
+#define VIENNACL_AMG_COARSE_MIS2 8
 #define VIENNACL_AMG_INTERPOL_DIRECT 1
 #define VIENNACL_AMG_INTERPOL_CLASSIC 2
 #define VIENNACL_AMG_INTERPOL_AG 3
 #define VIENNACL_AMG_INTERPOL_SA 4
+#define VIENNACL_AMG_INTERPOL_MULTIPASS 5
+#define VIENNACL_AMG_SMOOTHER_JACOBI 1
+#define VIENNACL_AMG_SMOOTHER_L1_JACOBI 2
+#define VIENNACL_AMG_SMOOTHER_CHEBYSHEV 3
+#define VIENNACL_AMG_SMOOTHER_GS 4
+#define VIENNACL_AMG_SMOOTHER_SGS 5
+#define VIENNACL_AMG_SMOOTHER_MULTICOLOR_GS 6
+#define VIENNACL_AMG_SMOOTHER_MULTICOLOR_SGS 7
 
 namespace viennacl
 {
@@ -72,6 +84,8 @@ public:
   * @param coarselevels  Number of coarse levels that are constructed
   *      (Default: 0 = Optimize coarse levels for direct solver such that coarsest level has a maximum of COARSE_LIMIT points)
   *      (Note: Coarsening stops when number of coarse points = 0 and overwrites the parameter with actual number of coarse levels)
+  *
+  * The smoother defaults to weighted Jacobi and can be changed via set_smoother().
   */
   amg_tag(unsigned int coarse = 1,
           unsigned int interpol = 1,
@@ -83,7 +97,9 @@ public:
           unsigned int coarselevels = 0)
   : coarse_(coarse), interpol_(interpol),
     threshold_(threshold), interpolweight_(interpolweight), jacobiweight_(jacobiweight),
-    presmooth_(presmooth), postsmooth_(postsmooth), coarselevels_(coarselevels) {}
+    presmooth_(presmooth), postsmooth_(postsmooth), coarselevels_(coarselevels),
+    smoother_(VIENNACL_AMG_SMOOTHER_JACOBI), chebyshev_degree_(2), chebyshev_ratio_(30), aggressive_levels_(0),
+    block_size_(1), nullspace_vectors_(0) {}
 
   // Getter-/Setter-Functions
   void set_coarse(unsigned int coarse) { coarse_ = coarse; }
@@ -110,10 +126,50 @@ public:
   void set_coarselevels(unsigned int coarselevels)  { coarselevels_ = coarselevels; }
   unsigned int get_coarselevels() const { return coarselevels_; }
 
+  /** @brief Sets the smoother. One out of VIENNACL_AMG_SMOOTHER_JACOBI, VIENNACL_AMG_SMOOTHER_L1_JACOBI, VIENNACL_AMG_SMOOTHER_CHEBYSHEV, VIENNACL_AMG_SMOOTHER_GS, VIENNACL_AMG_SMOOTHER_SGS,
+   *         VIENNACL_AMG_SMOOTHER_MULTICOLOR_GS, VIENNACL_AMG_SMOOTHER_MULTICOLOR_SGS */
+  void set_smoother(unsigned int smoother) { smoother_ = smoother; }
+  unsigned int get_smoother() const { return smoother_; }
+
+  /** @brief Sets the degree of the Chebyshev polynomial applied in each smoothing step (VIENNACL_AMG_SMOOTHER_CHEBYSHEV only) */
+  void set_chebyshev_degree(unsigned int degree) { if (degree > 0) chebyshev_degree_ = degree; }
+  unsigned int get_chebyshev_degree() const { return chebyshev_degree_; }
+
+  /** @brief Sets the ratio of the largest and the smallest eigenvalue targeted by the Chebyshev smoother, i.e. eigenvalues in [lambda_max/ratio, lambda_max] are damped */
+  void set_chebyshev_ratio(double ratio) { if (ratio > 1) chebyshev_ratio_ = ratio; }
+  double get_chebyshev_ratio() const { return chebyshev_ratio_; }
+
+  /** @brief Sets the number of finest levels on which aggressive coarsening (two passes of PMIS/HMIS with multipass interpolation) is used. Only used with VIENNACL_AMG_COARSE_PMIS and VIENNACL_AMG_COARSE_HMIS. */
+  void set_aggressive_levels(unsigned int levels) { aggressive_levels_ = levels; }
+  unsigned int get_aggressive_levels() const { return aggressive_levels_; }
+
+  /** @brief Sets the number of unknowns per node (e.g. the spatial dimension for elasticity), which are aggregated together. Only used with VIENNACL_AMG_COARSE_MIS2. */
+  void set_block_size(unsigned int block_size) { if (block_size > 0) block_size_ = block_size; }
+  unsigned int get_block_size() const { return block_size_; }
+
+  /** @brief Sets the near-nullspace vectors (e.g. rigid body modes) used for the tentative prolongator. Only used with VIENNACL_AMG_COARSE_MIS2.
+  *
+  * @param nullspace    Vectors stored row-wise, i.e. nullspace[i * num_vectors + j] is the entry of the j-th vector for the i-th unknown
+  * @param num_vectors  Number of near-nullspace vectors. If zero (default), the constant vector is used.
+  */
+  void set_nullspace(std::vector<double> const & nullspace, unsigned int num_vectors)
+  {
+    nullspace_ = nullspace;
+    nullspace_vectors_ = num_vectors;
+  }
+  std::vector<double> const & get_nullspace() const { return nullspace_; }
+  unsigned int get_nullspace_vectors() const { return nullspace_vectors_; }
+
 private:
   unsigned int coarse_, interpol_;
   double threshold_, interpolweight_, jacobiweight_;
   unsigned int presmooth_, postsmooth_, coarselevels_;
+  unsigned int smoother_, chebyshev_degree_;
+  double chebyshev_ratio_;
+  unsigned int aggressive_levels_;
+  unsigned int block_size_;
+  std::vector<double> nullspace_;
+  unsigned int nullspace_vectors_;
 };
 
 /** @brief A class for a scalar that can be written to the sparse matrix or sparse vector datatypes.
@@ -23,6 +23,8 @@
 */
 
 #include <cmath>
+#include <vector>
+#include <algorithm>
 #include "viennacl/linalg/detail/amg/amg_base.hpp"
 
 #include <map>
@@ -58,6 +60,8 @@ void amg_coarse(unsigned int level, InternalT1 & A, InternalT2 & pointvector, In
   case VIENNACL_AMG_COARSE_RS0:     amg_coarse_rs0(level, A, pointvector, slicing, tag); break;
   case VIENNACL_AMG_COARSE_RS3:     amg_coarse_rs3(level, A, pointvector, slicing, tag); break;
   case VIENNACL_AMG_COARSE_AG:      amg_coarse_ag(level, A, pointvector, tag); break;
+  case VIENNACL_AMG_COARSE_PMIS:
+  case VIENNACL_AMG_COARSE_HMIS:    amg_coarse_pmis(level, A, pointvector, tag); break;
   }
 }
 
@@ -142,6 +146,469 @@ void amg_influence(unsigned int level, InternalT1 const & A, InternalT2 & pointv
 
 }
 
+/** @brief Strength-of-connection matrix in CSR format. Row i holds the points strongly influencing point i.
+*/
+struct amg_strength_csr
+{
+  std::vector<unsigned int> row_buffer_;
+  std::vector<unsigned int> col_buffer_;
+
+  vcl_size_t size() const { return row_buffer_.size() - 1; }
+};
+
+/** @brief States of points during PMIS/HMIS coarsening */
+enum amg_point_state
+{
+  AMG_POINT_UNDECIDED = 0,
+  AMG_POINT_C,
+  AMG_POINT_F
+};
+
+/** @brief Deterministic pseudo-random number in [0,1) for point i. Used for breaking ties in PMIS independently of the number of threads. */
+inline double amg_random_weight(unsigned int i)
+{
+  unsigned int h = i * 2654435761u;
+  h ^= h >> 16;
+  h *= 2246822519u;
+  h ^= h >> 13;
+  return static_cast<double>(h) / 4294967296.0;
+}
+
+/** @brief Computes the transpose of a strength-of-connection matrix, i.e. row i holds the points strongly influenced by point i.
+*
+* @param S   Strength matrix
+* @param ST  Transposed strength matrix (output)
+*/
+inline void amg_strength_transpose(amg_strength_csr const & S, amg_strength_csr & ST)
+{
+  vcl_size_t size = S.size();
+  ST.row_buffer_.assign(size + 1, 0);
+  ST.col_buffer_.resize(S.col_buffer_.size());
+
+  for (vcl_size_t k=0; k<S.col_buffer_.size(); ++k)
+    ++ST.row_buffer_[S.col_buffer_[k] + 1];
+  for (vcl_size_t i=0; i<size; ++i)
+    ST.row_buffer_[i+1] += ST.row_buffer_[i];
+
+  std::vector<unsigned int> pos(ST.row_buffer_.begin(), ST.row_buffer_.end() - 1);
+  for (vcl_size_t i=0; i<size; ++i)
+    for (unsigned int k = S.row_buffer_[i]; k < S.row_buffer_[i+1]; ++k)
+      ST.col_buffer_[pos[S.col_buffer_[k]]++] = static_cast<unsigned int>(i);
+}
+
+/** @brief Determines strong influences in the system matrix directly on its rows (classical criterion, cf. amg_influence()). Multi-threaded!
+*
+* @param A    Operator matrix of the level
+* @param S    Strength matrix (output)
+* @param ST   Transposed strength matrix (output)
+* @param tag  AMG preconditioner tag
+*/
+template<typename SparseMatrixT>
+void amg_strength(SparseMatrixT & A, amg_strength_csr & S, amg_strength_csr & ST, amg_tag const & tag)
+{
+  typedef typename SparseMatrixT::value_type                      ScalarType;
+  typedef std::map<unsigned int, ScalarType>                      RowType;
+  typedef typename RowType::const_iterator                        RowIterator;
+
+  std::vector<RowType> const & rows = *(A.get_internal_pointer());
+  vcl_size_t size = rows.size();
+  ScalarType threshold = static_cast<ScalarType>(tag.get_threshold());
+
+  // Per row: Strong connections satisfy -a_ij * sign(a_ii) >= threshold * max_k(-a_ik * sign(a_ii))
+  std::vector<ScalarType> row_threshold(size);
+  S.row_buffer_.assign(size + 1, 0);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for
+#endif
+  for (long i2=0; i2<static_cast<long>(size); ++i2)
+  {
+    unsigned int i = static_cast<unsigned int>(i2);
+    RowIterator diag_iter = rows[i].find(i);
+    ScalarType diag_sign = (diag_iter != rows[i].end() && diag_iter->second < 0) ? ScalarType(-1) : ScalarType(1);
+
+    ScalarType max = 0;
+    for (RowIterator it = rows[i].begin(); it != rows[i].end(); ++it)
+      if (it->first != i)
+        max = std::max(max, -diag_sign * it->second);
+
+    row_threshold[i] = threshold * max;
+    unsigned int num_strong = 0;
+    if (max > 0)
+      for (RowIterator it = rows[i].begin(); it != rows[i].end(); ++it)
+        if (it->first != i && -diag_sign * it->second >= row_threshold[i])
+          ++num_strong;
+    S.row_buffer_[i+1] = num_strong;
+  }
+
+  for (vcl_size_t i=0; i<size; ++i)
+    S.row_buffer_[i+1] += S.row_buffer_[i];
+  S.col_buffer_.resize(S.row_buffer_[size]);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for
+#endif
+  for (long i2=0; i2<static_cast<long>(size); ++i2)
+  {
+    unsigned int i = static_cast<unsigned int>(i2);
+    if (S.row_buffer_[i] == S.row_buffer_[i+1])
+      continue;
+
+    RowIterator diag_iter = rows[i].find(i);
+    ScalarType diag_sign = (diag_iter != rows[i].end() && diag_iter->second < 0) ? ScalarType(-1) : ScalarType(1);
+
+    unsigned int k = S.row_buffer_[i];
+    for (RowIterator it = rows[i].begin(); it != rows[i].end(); ++it)
+      if (it->first != i && -diag_sign * it->second >= row_threshold[i])
+        S.col_buffer_[k++] = it->first;
+  }
+
+  amg_strength_transpose(S, ST);
+}
+
+/** @brief Transfers a strength matrix to the influence lists of the points, which are used by the interpolation routines. Multi-threaded!
+*
+* @param S            Strength matrix
+* @param ST           Transposed strength matrix
+* @param pointvector  Points of the level
+*/
+template<typename PointVectorT>
+void amg_strength_to_points(amg_strength_csr const & S, amg_strength_csr const & ST, PointVectorT & pointvector)
+{
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for
+#endif
+  for (long i2=0; i2<static_cast<long>(S.size()); ++i2)
+  {
+    vcl_size_t i = static_cast<vcl_size_t>(i2);
+    amg_point * point = pointvector[static_cast<unsigned int>(i)];
+    for (unsigned int k = S.row_buffer_[i]; k < S.row_buffer_[i+1]; ++k)
+      point->add_influencing_point(pointvector[S.col_buffer_[k]]);
+    for (unsigned int k = ST.row_buffer_[i]; k < ST.row_buffer_[i+1]; ++k)
+      point->add_influenced_point(pointvector[ST.col_buffer_[k]]);
+  }
+}
+
+/** @brief Parallel modified independent set (PMIS) selection of C points (De Sterck, Yang, Heys, 2006). Multi-threaded!
+*
+*  Points already marked as C points in 'state' are kept. Undecided points influencing no other point become F points.
+*  Then, repeatedly, all points depending on a C point become F points and all undecided points with a larger measure than all their undecided neighbors become C points.
+*
+* @param S      Strength matrix
+* @param ST     Transposed strength matrix
+* @param state  Point states (input and output, see amg_point_state)
+*/
+inline void amg_pmis(amg_strength_csr const & S, amg_strength_csr const & ST, std::vector<char> & state)
+{
+  long size = static_cast<long>(S.size());
+  std::vector<double> measure(static_cast<vcl_size_t>(size));
+  std::vector<char>   new_cpoint(static_cast<vcl_size_t>(size), 0);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for
+#endif
+  for (long i=0; i<size; ++i)
+  {
+    vcl_size_t ui = static_cast<vcl_size_t>(i);
+    measure[ui] = static_cast<double>(ST.row_buffer_[ui+1] - ST.row_buffer_[ui]) + amg_random_weight(static_cast<unsigned int>(i));
+    if (state[ui] == AMG_POINT_UNDECIDED && measure[ui] < 1.0)
+      state[ui] = AMG_POINT_F;
+  }
+
+  long undecided = 1;
+  while (undecided > 0)
+  {
+    // Points depending on a C point become F points:
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for
+#endif
+    for (long i=0; i<size; ++i)
+    {
+      vcl_size_t ui = static_cast<vcl_size_t>(i);
+      if (state[ui] != AMG_POINT_UNDECIDED)
+        continue;
+      for (unsigned int k = S.row_buffer_[ui]; k < S.row_buffer_[ui+1]; ++k)
+        if (state[S.col_buffer_[k]] == AMG_POINT_C)
+        {
+          state[ui] = AMG_POINT_F;
+          break;
+        }
+    }
+
+    // Undecided points with locally maximal measure become C points:
+    undecided = 0;
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for reduction(+: undecided)
+#endif
+    for (long i=0; i<size; ++i)
+    {
+      vcl_size_t ui = static_cast<vcl_size_t>(i);
+      new_cpoint[ui] = 0;
+      if (state[ui] != AMG_POINT_UNDECIDED)
+        continue;
+
+      bool is_max = true;
+      for (unsigned int k = S.row_buffer_[ui]; k < S.row_buffer_[ui+1] && is_max; ++k)
+        if (state[S.col_buffer_[k]] == AMG_POINT_UNDECIDED && measure[S.col_buffer_[k]] >= measure[ui] && S.col_buffer_[k] != ui)
+          is_max = false;
+      for (unsigned int k = ST.row_buffer_[ui]; k < ST.row_buffer_[ui+1] && is_max; ++k)
+        if (state[ST.col_buffer_[k]] == AMG_POINT_UNDECIDED && measure[ST.col_buffer_[k]] >= measure[ui] && ST.col_buffer_[k] != ui)
+          is_max = false;
+
+      if (is_max)
+        new_cpoint[ui] = 1;
+      else
+        ++undecided;
+    }
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for
+#endif
+    for (long i=0; i<size; ++i)
+      if (new_cpoint[static_cast<vcl_size_t>(i)])
+        state[static_cast<vcl_size_t>(i)] = AMG_POINT_C;
+  }
+}
+
+/** @brief Classical Ruge-Stueben first pass restricted to the rows [start, stop) and the strong connections within this block. Single-threaded!
+*
+*  Points are kept in buckets sorted by their influence measure, so that each step is O(1) apart from the updates of neighbors.
+*
+* @param S      Strength matrix
+* @param ST     Transposed strength matrix
+* @param start  First row of the block
+* @param stop   One past the last row of the block
+* @param state  Point states (output for the block)
+*/
+inline void amg_rs_first_pass_block(amg_strength_csr const & S, amg_strength_csr const & ST, unsigned int start, unsigned int stop, std::vector<char> & state)
+{
+  if (stop <= start)
+    return;
+
+  vcl_size_t block_size = stop - start;
+  std::vector<unsigned int> measure(block_size);
+  unsigned int max_measure = 0;
+  for (unsigned int i = start; i < stop; ++i)
+  {
+    unsigned int m = 0;
+    for (unsigned int k = ST.row_buffer_[i]; k < ST.row_buffer_[i+1]; ++k)
+      if (ST.col_buffer_[k] >= start && ST.col_buffer_[k] < stop)
+        ++m;
+    measure[i - start] = m;
+    max_measure = std::max(max_measure, m);
+  }
+
+  // Doubly linked lists of points per measure. A measure can at most double during the first pass.
+  unsigned int const none = static_cast<unsigned int>(-1);
+  std::vector<unsigned int> bucket_head(2 * max_measure + 2, none);
+  std::vector<unsigned int> next(block_size, none);
+  std::vector<unsigned int> prev(block_size, none);
+
+  for (unsigned int i = 0; i < block_size; ++i)
+  {
+    unsigned int m = measure[i];
+    next[i] = bucket_head[m];
+    if (bucket_head[m] != none)
+      prev[bucket_head[m]] = i;
+    bucket_head[m] = i;
+  }
+
+  unsigned int top = max_measure;
+  while (top > 0)
+  {
+    unsigned int c = bucket_head[top];
+    if (c == none)
+    {
+      --top;
+      continue;
+    }
+
+    // Remove from bucket and make C point:
+    bucket_head[top] = next[c];
+    if (next[c] != none)
+      prev[next[c]] = none;
+    state[start + c] = AMG_POINT_C;
+
+    // All undecided points strongly influenced by the new C point become F points:
+    for (unsigned int k = ST.row_buffer_[start + c]; k < ST.row_buffer_[start + c + 1]; ++k)
+    {
+      unsigned int j = ST.col_buffer_[k];
+      if (j < start || j >= stop || state[j] != AMG_POINT_UNDECIDED)
+        continue;
+
+      unsigned int lj = j - start;
+      if (prev[lj] != none) next[prev[lj]] = next[lj]; else bucket_head[measure[lj]] = next[lj];
+      if (next[lj] != none) prev[next[lj]] = prev[lj];
+      state[j] = AMG_POINT_F;
+
+      // Undecided points strongly influencing the new F point gain importance:
+      for (unsigned int l = S.row_buffer_[j]; l < S.row_buffer_[j+1]; ++l)
+      {
+        unsigned int m = S.col_buffer_[l];
+        if (m < start || m >= stop || state[m] != AMG_POINT_UNDECIDED)
+          continue;
+
+        unsigned int lm = m - start;
+        if (prev[lm] != none) next[prev[lm]] = next[lm]; else bucket_head[measure[lm]] = next[lm];
+        if (next[lm] != none) prev[next[lm]] = prev[lm];
+
+        ++measure[lm];
+        prev[lm] = none;
+        next[lm] = bucket_head[measure[lm]];
+        if (bucket_head[measure[lm]] != none)
+          prev[bucket_head[measure[lm]]] = lm;
+        bucket_head[measure[lm]] = lm;
+        top = std::max(top, measure[lm]);
+      }
+    }
+  }
+}
+
+/** @brief Hybrid MIS (HMIS) selection of C points (De Sterck, Yang, Heys, 2006). Multi-threaded!
+*
+*  Runs the classical first pass on one block of rows per thread and uses the resulting C points as initial independent set for PMIS.
+*
+* @param S      Strength matrix
+* @param ST     Transposed strength matrix
+* @param state  Point states (output)
+*/
+inline void amg_hmis(amg_strength_csr const & S, amg_strength_csr const & ST, std::vector<char> & state)
+{
+  vcl_size_t size = S.size();
+  long num_blocks = 1;
+#ifdef VIENNACL_WITH_OPENMP
+  num_blocks = omp_get_max_threads();
+#endif
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for
+#endif
+  for (long b=0; b<num_blocks; ++b)
+    amg_rs_first_pass_block(S, ST,
+                            static_cast<unsigned int>((static_cast<vcl_size_t>(b)     * size) / static_cast<vcl_size_t>(num_blocks)),
+                            static_cast<unsigned int>((static_cast<vcl_size_t>(b + 1) * size) / static_cast<vcl_size_t>(num_blocks)),
+                            state);
+
+  // Only keep the C points, PMIS decides on all other points (including the ones at the block boundaries)
+  for (vcl_size_t i=0; i<size; ++i)
+    if (state[i] != AMG_POINT_C)
+      state[i] = AMG_POINT_UNDECIDED;
+
+  amg_pmis(S, ST, state);
+}
+
+/** @brief Builds the strength matrix between the C points for the second pass of aggressive coarsening: C point j strongly influences C point i if there is a path of length at most two in S.
+*
+* @param S        Strength matrix of all points
+* @param state    Point states after the first pass
+* @param S2       Strength matrix between the C points (output, C points are numbered consecutively)
+* @param cpoints  Indices of the C points (output)
+*/
+inline void amg_strength_distance_two(amg_strength_csr const & S, std::vector<char> const & state, amg_strength_csr & S2, std::vector<unsigned int> & cpoints)
+{
+  vcl_size_t size = S.size();
+  unsigned int const none = static_cast<unsigned int>(-1);
+
+  std::vector<unsigned int> coarse_index(size, none);
+  cpoints.clear();
+  for (vcl_size_t i=0; i<size; ++i)
+    if (state[i] == AMG_POINT_C)
+    {
+      coarse_index[i] = static_cast<unsigned int>(cpoints.size());
+      cpoints.push_back(static_cast<unsigned int>(i));
+    }
+
+  std::vector<std::vector<unsigned int> > rows(cpoints.size());
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for
+#endif
+  for (long ci=0; ci<static_cast<long>(cpoints.size()); ++ci)
+  {
+    std::vector<unsigned int> & row = rows[static_cast<vcl_size_t>(ci)];
+    unsigned int i = cpoints[static_cast<vcl_size_t>(ci)];
+    for (unsigned int k = S.row_buffer_[i]; k < S.row_buffer_[i+1]; ++k)
+    {
+      unsigned int j = S.col_buffer_[k];
+      if (coarse_index[j] != none)
+        row.push_back(coarse_index[j]);
+      for (unsigned int l = S.row_buffer_[j]; l < S.row_buffer_[j+1]; ++l)
+        if (coarse_index[S.col_buffer_[l]] != none && S.col_buffer_[l] != i)
+          row.push_back(coarse_index[S.col_buffer_[l]]);
+    }
+    std::sort(row.begin(), row.end());
+    row.erase(std::unique(row.begin(), row.end()), row.end());
+  }
+
+  S2.row_buffer_.assign(cpoints.size() + 1, 0);
+  for (vcl_size_t ci=0; ci<cpoints.size(); ++ci)
+    S2.row_buffer_[ci+1] = S2.row_buffer_[ci] + static_cast<unsigned int>(rows[ci].size());
+  S2.col_buffer_.resize(S2.row_buffer_[cpoints.size()]);
+  for (vcl_size_t ci=0; ci<cpoints.size(); ++ci)
+    std::copy(rows[ci].begin(), rows[ci].end(), S2.col_buffer_.begin() + S2.row_buffer_[ci]);
+}
+
+/** @brief PMIS and HMIS coarsening, optionally aggressive. Multi-threaded! (VIENNACL_AMG_COARSE_PMIS, VIENNACL_AMG_COARSE_HMIS)
+*
+*  On the first tag.get_aggressive_levels() levels, the selection is applied a second time to the C points using distance-two strong connections.
+*  Interpolation on these levels is always multipass interpolation.
+*
+* @param level        Coarse level identifier
+* @param A            Operator matrix on all levels
+* @param pointvector  Vector of points on all levels
+* @param tag          AMG preconditioner tag
+*/
+template<typename InternalT1, typename InternalT2>
+void amg_coarse_pmis(unsigned int level, InternalT1 & A, InternalT2 & pointvector, amg_tag & tag)
+{
+  amg_strength_csr S, ST;
+  amg_strength(A[level], S, ST, tag);
+
+  vcl_size_t size = S.size();
+  std::vector<char> state(size, AMG_POINT_UNDECIDED);
+
+  if (tag.get_coarse() == VIENNACL_AMG_COARSE_HMIS)
+    amg_hmis(S, ST, state);
+  else
+    amg_pmis(S, ST, state);
+
+  // Aggressive coarsening: Second pass on the graph of the C points.
+  if (level < tag.get_aggressive_levels())
+  {
+    amg_strength_csr S2, ST2;
+    std::vector<unsigned int> cpoints;
+    amg_strength_distance_two(S, state, S2, cpoints);
+    amg_strength_transpose(S2, ST2);
+
+    std::vector<char> state2(cpoints.size(), AMG_POINT_UNDECIDED);
+    if (tag.get_coarse() == VIENNACL_AMG_COARSE_HMIS)
+      amg_hmis(S2, ST2, state2);
+    else
+      amg_pmis(S2, ST2, state2);
+
+    for (vcl_size_t ci=0; ci<cpoints.size(); ++ci)
+      if (state2[ci] != AMG_POINT_C)
+        state[cpoints[ci]] = AMG_POINT_F;
+  }
+
+  // Save influences and C/F splitting in the point data structures used for interpolation:
+  amg_strength_to_points(S, ST, pointvector[level]);
+  for (vcl_size_t i=0; i<size; ++i)
+  {
+    amg_point * point = pointvector[level][static_cast<unsigned int>(i)];
+    if (state[i] == AMG_POINT_C)
+      pointvector[level].make_cpoint(point);
+    else
+      pointvector[level].make_fpoint(point);
+  }
+
+  #if defined (VIENNACL_AMG_DEBUG)
+  std::cout << "PMIS/HMIS: Level " << level << ": ";
+  std::cout << "No of C points = " << pointvector[level].get_cpoints() << ", ";
+  std::cout << "No of F points = " << pointvector[level].get_fpoints() << std::endl;
+  #endif
+}
+
 
 /** @brief Classical (RS) one-pass coarsening. Single-Threaded! (VIENNACL_AMG_COARSE_CLASSIC_ONEPASS)
 * @param level         Course level identifier
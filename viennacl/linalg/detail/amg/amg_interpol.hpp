@@ -24,6 +24,7 @@
 
 #include <boost/numeric/ublas/vector.hpp>
 #include <cmath>
+#include <vector>
 #include "viennacl/linalg/detail/amg/amg_base.hpp"
 
 #include <map>
@@ -52,12 +53,21 @@ namespace amg
 template<typename InternalT1, typename InternalT2>
 void amg_interpol(unsigned int level, InternalT1 & A, InternalT1 & P, InternalT2 & pointvector, amg_tag & tag)
 {
+  // Aggressive coarsening leaves F points without strongly influencing C points, hence only multipass interpolation is applicable:
+  if (level < tag.get_aggressive_levels()
+      && (tag.get_coarse() == VIENNACL_AMG_COARSE_PMIS || tag.get_coarse() == VIENNACL_AMG_COARSE_HMIS))
+  {
+    amg_interpol_multipass(level, A, P, pointvector, tag);
+    return;
+  }
+
   switch (tag.get_interpol())
   {
   case VIENNACL_AMG_INTERPOL_DIRECT:  amg_interpol_direct (level, A, P, pointvector, tag); break;
   case VIENNACL_AMG_INTERPOL_CLASSIC: amg_interpol_classic(level, A, P, pointvector, tag); break;
   case VIENNACL_AMG_INTERPOL_AG:      amg_interpol_ag     (level, A, P, pointvector, tag); break;
   case VIENNACL_AMG_INTERPOL_SA:      amg_interpol_sa     (level, A, P, pointvector, tag); break;
+  case VIENNACL_AMG_INTERPOL_MULTIPASS: amg_interpol_multipass(level, A, P, pointvector, tag); break;
   }
 }
 
@@ -131,7 +141,8 @@ void amg_interpol_direct(unsigned int level, InternalT1 & A, InternalT1 & P, Int
           if (pointx->is_influencing(pointy))
             c_sum += *col_iter;
       }
-      ScalarType temp_res = -row_sum/(c_sum*diag);
+      // F points without strongly influencing C points (possible with PMIS coarsening) are not interpolated
+      ScalarType temp_res = (c_sum > 0 || c_sum < 0) ? -row_sum/(c_sum*diag) : ScalarType(0);
 
       // Iterate over all strongly influencing points of point x
       for (amg_point::iterator iter = pointx->begin_influencing(); iter != pointx->end_influencing(); ++iter)
@@ -160,6 +171,147 @@ void amg_interpol_direct(unsigned int level, InternalT1 & A, InternalT1 & P, Int
   #endif
 }
 
+/** @brief Multipass interpolation (Stueben, 2001). Suitable for aggressive coarsening, where F points may not have strongly influencing C points. Multi-threaded! (VIENNACL_AMG_INTERPOL_MULTIPASS)
+ *
+ *  In the first pass, F points with strongly influencing C points are interpolated directly. In each subsequent pass, F points are interpolated
+ *  via the interpolation formulas of strongly influencing points from previous passes.
+ *
+ * @param level        Coarse level identifier
+ * @param A            Operator matrix on all levels
+ * @param P            Prolongation matrices. P[level] is constructed
+ * @param pointvector  Vector of points on all levels
+ * @param tag          AMG preconditioner tag
+*/
+template<typename InternalT1, typename InternalT2>
+void amg_interpol_multipass(unsigned int level, InternalT1 & A, InternalT1 & P, InternalT2 & pointvector, amg_tag & tag)
+{
+  typedef typename InternalT1::value_type           SparseMatrixType;
+  typedef typename SparseMatrixType::value_type     ScalarType;
+  typedef std::map<unsigned int, ScalarType>        RowType;
+  typedef typename RowType::const_iterator          RowIterator;
+
+  unsigned int c_points = pointvector[level].get_cpoints();
+  long size = static_cast<long>(pointvector[level].size());
+
+  // Setup Prolongation/Interpolation matrix
+  P[level] = SparseMatrixType(static_cast<unsigned int>(A[level].size1()), c_points);
+  P[level].clear();
+
+  // Assign indices to C points
+  pointvector[level].build_index();
+
+  std::vector<RowType> const & A_rows = *(A[level].get_internal_pointer());
+  std::vector<RowType> P_rows(static_cast<vcl_size_t>(size));
+
+  // pass[i] is the pass in which point i was interpolated, zero if not yet interpolated. C points are assigned in pass 1.
+  std::vector<unsigned int> pass(static_cast<vcl_size_t>(size), 0);
+  long remaining = 0;
+  for (long x=0; x < size; ++x)
+  {
+    amg_point *pointx = pointvector[level][static_cast<unsigned int>(x)];
+    if (pointx->is_cpoint())
+    {
+      pass[static_cast<vcl_size_t>(x)] = 1;
+      P_rows[static_cast<vcl_size_t>(x)][pointx->get_coarse_index()] = 1;
+    }
+    else
+      ++remaining;
+  }
+
+  for (unsigned int current_pass = 2; remaining > 0; ++current_pass)
+  {
+    long interpolated = 0;
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for reduction(+: interpolated)
+#endif
+    for (long x=0; x < size; ++x)
+    {
+      vcl_size_t ux = static_cast<vcl_size_t>(x);
+      if (pass[ux] > 0)
+        continue;
+
+      amg_point *pointx = pointvector[level][static_cast<unsigned int>(x)];
+
+      // Sum of strongly influencing points from previous passes:
+      ScalarType strong_sum = 0;
+      bool has_strong = false;
+      for (amg_point::iterator iter = pointx->begin_influencing(); iter != pointx->end_influencing(); ++iter)
+      {
+        unsigned int y = (*iter)->get_index();
+        if (pass[y] > 0 && pass[y] < current_pass)
+        {
+          RowIterator a_xy = A_rows[ux].find(y);
+          if (a_xy != A_rows[ux].end())
+            strong_sum += a_xy->second;
+          has_strong = true;
+        }
+      }
+      if (!has_strong || !(strong_sum > 0 || strong_sum < 0))
+        continue;
+
+      ScalarType row_sum = 0;
+      ScalarType diag    = 0;
+      for (RowIterator col_iter = A_rows[ux].begin(); col_iter != A_rows[ux].end(); ++col_iter)
+      {
+        if (col_iter->first == ux)
+          diag += col_iter->second;
+        else
+          row_sum += col_iter->second;
+      }
+      if (!(diag > 0 || diag < 0))
+        continue;
+
+      // P_x = sum_y -alpha * a_xy / a_xx * P_y with alpha = row_sum / strong_sum
+      ScalarType temp_res = -row_sum / (strong_sum * diag);
+      RowType & row = P_rows[ux];
+      for (amg_point::iterator iter = pointx->begin_influencing(); iter != pointx->end_influencing(); ++iter)
+      {
+        unsigned int y = (*iter)->get_index();
+        if (pass[y] > 0 && pass[y] < current_pass)
+        {
+          RowIterator a_xy = A_rows[ux].find(y);
+          if (a_xy == A_rows[ux].end())
+            continue;
+          for (RowIterator p_iter = P_rows[y].begin(); p_iter != P_rows[y].end(); ++p_iter)
+            row[p_iter->first] += temp_res * a_xy->second * p_iter->second;
+        }
+      }
+      ++interpolated;
+    }
+
+    if (interpolated == 0) // remaining F points are not connected to any interpolated point
+      break;
+
+    for (long x=0; x < size; ++x)
+      if (pass[static_cast<vcl_size_t>(x)] == 0 && !P_rows[static_cast<vcl_size_t>(x)].empty())
+      {
+        pass[static_cast<vcl_size_t>(x)] = current_pass;
+        --remaining;
+      }
+  }
+
+  // Write to prolongation matrix
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for
+#endif
+  for (long x=0; x < size; ++x)
+  {
+    RowType const & row = P_rows[static_cast<vcl_size_t>(x)];
+    for (RowIterator iter = row.begin(); iter != row.end(); ++iter)
+      if (iter->second > 0 || iter->second < 0)
+        P[level](static_cast<unsigned int>(x), iter->first) = iter->second;
+
+    //Truncate interpolation if chosen
+    if (tag.get_interpolweight() > 0 && pass[static_cast<vcl_size_t>(x)] > 1)
+      amg_truncate_row(P[level], static_cast<unsigned int>(x), tag);
+  }
+
+  #ifdef VIENNACL_AMG_DEBUG
+  std::cout << "Prolongation Matrix:" << std::endl;
+  printmatrix (P[level]);
+  #endif
+}
+
 /** @brief Classical interpolation. Don't use with onepass classical coarsening or RS0 (Yang, p.14)! Multi-threaded! (VIENNACL_AMG_INTERPOL_CLASSIC)
  * @param level        Coarse level identifier
  * @param A            Operator matrix on all levels
@@ -0,0 +1,910 @@
+#ifndef VIENNACL_LINALG_DETAIL_AMG_AMG_SA_HPP
+#define VIENNACL_LINALG_DETAIL_AMG_AMG_SA_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file amg_sa.hpp
+    @brief Smoothed aggregation AMG with parallel MIS-2 aggregation operating on CSR arrays (setup phase). Experimental.
+
+    Aggregates are the distance-two neighborhoods of a maximal independent set of distance two (Bell, Dalton, Olson, 2012).
+    Tentative prolongators are obtained from a QR decomposition of the near-nullspace vectors restricted to each aggregate (Vanek, Mandel, Brezina, 1996)
+    and smoothed by one damped Jacobi step. All sparse matrix-matrix products are split into a symbolic and a numeric phase,
+    so that a hierarchy for a matrix with unchanged sparsity pattern only requires the numeric phases.
+*/
+
+#include <vector>
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+#include "viennacl/forwards.h"
+#include "viennacl/linalg/detail/amg/amg_base.hpp"
+#include "viennacl/linalg/detail/amg/amg_coarse.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace detail
+{
+namespace amg
+{
+
+/** @brief Sparse matrix in CSR format used during the setup of smoothed aggregation AMG.
+*/
+template<typename NumericT>
+struct amg_csr_matrix
+{
+  amg_csr_matrix() : size1_(0), size2_(0) {}
+
+  vcl_size_t size1_;
+  vcl_size_t size2_;
+  std::vector<unsigned int> row_buffer_;
+  std::vector<unsigned int> col_buffer_;
+  std::vector<NumericT>     elements_;
+};
+
+/** @brief Data of one level of smoothed aggregation AMG, kept between setups for reusing aggregates and sparsity patterns.
+*/
+template<typename NumericT>
+struct amg_sa_level
+{
+  amg_sa_level() : num_aggregates_(0), block_size_(1), valid_(false) {}
+
+  // Operator of the level
+  amg_csr_matrix<NumericT> A_;
+  // Symmetrized strength-of-connection graph of the nodes (a node consists of block_size_ unknowns)
+  amg_strength_csr S_;
+  // Aggregate of each node, or amg_sa_level::none if the node is not aggregated
+  std::vector<unsigned int> aggregates_;
+  unsigned int num_aggregates_;
+  unsigned int block_size_;
+
+  amg_csr_matrix<NumericT> A_filtered_;
+  amg_csr_matrix<NumericT> P_tentative_;
+  amg_csr_matrix<NumericT> P_;
+  amg_csr_matrix<NumericT> R_;
+  amg_csr_matrix<NumericT> AP_;
+
+  // True if aggregates and sparsity patterns match the pattern of A_
+  bool valid_;
+
+  static unsigned int none() { return static_cast<unsigned int>(-1); }
+};
+
+/** @brief Copies a matrix from the setup data structure to CSR format. Multi-threaded!
+*
+* @param A    Setup matrix
+* @param csr  CSR matrix (output)
+*/
+template<typename NumericT>
+void amg_csr_from_setup(amg_sparsematrix<NumericT> & A, amg_csr_matrix<NumericT> & csr)
+{
+  typedef std::map<unsigned int, NumericT>       RowType;
+  typedef typename RowType::const_iterator       RowIterator;
+
+  std::vector<RowType> const & rows = *(A.get_internal_pointer());
+  csr.size1_ = A.size1();
+  csr.size2_ = A.size2();
+  csr.row_buffer_.resize(csr.size1_ + 1);
+  csr.row_buffer_[0] = 0;
+  for (vcl_size_t i=0; i<csr.size1_; ++i)
+    csr.row_buffer_[i+1] = csr.row_buffer_[i] + static_cast<unsigned int>(rows[i].size());
+  csr.col_buffer_.resize(csr.row_buffer_[csr.size1_]);
+  csr.elements_.resize(csr.row_buffer_[csr.size1_]);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for
+#endif
+  for (long i2=0; i2<static_cast<long>(csr.size1_); ++i2)
+  {
+    vcl_size_t i = static_cast<vcl_size_t>(i2);
+    unsigned int k = csr.row_buffer_[i];
+    for (RowIterator it = rows[i].begin(); it != rows[i].end(); ++it, ++k)
+    {
+      csr.col_buffer_[k] = it->first;
+      csr.elements_[k]   = it->second;
+    }
+  }
+}
+
+/** @brief Copies a CSR matrix to the setup data structure. Multi-threaded!
+*
+* @param csr  CSR matrix
+* @param A    Setup matrix (output)
+*/
+template<typename NumericT>
+void amg_csr_to_setup(amg_csr_matrix<NumericT> const & csr, amg_sparsematrix<NumericT> & A)
+{
+  typedef std::map<unsigned int, NumericT>       RowType;
+
+  A = amg_sparsematrix<NumericT>(static_cast<unsigned int>(csr.size1_), static_cast<unsigned int>(csr.size2_));
+  std::vector<RowType> & rows = *(A.get_internal_pointer());
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for
+#endif
+  for (long i2=0; i2<static_cast<long>(csr.size1_); ++i2)
+  {
+    vcl_size_t i = static_cast<vcl_size_t>(i2);
+    RowType & row = rows[i];
+    row.clear();
+    for (unsigned int k = csr.row_buffer_[i]; k < csr.row_buffer_[i+1]; ++k)
+      row.insert(row.end(), std::make_pair(csr.col_buffer_[k], csr.elements_[k]));
+  }
+}
+
+/** @brief Computes the transpose of a CSR matrix. Column indices of the result are sorted.
+*
+* @param A   CSR matrix
+* @param AT  Transposed matrix (output)
+*/
+template<typename NumericT>
+void amg_csr_transpose(amg_csr_matrix<NumericT> const & A, amg_csr_matrix<NumericT> & AT)
+{
+  AT.size1_ = A.size2_;
+  AT.size2_ = A.size1_;
+  AT.row_buffer_.assign(AT.size1_ + 1, 0);
+  AT.col_buffer_.resize(A.col_buffer_.size());
+  AT.elements_.resize(A.elements_.size());
+
+  for (vcl_size_t k=0; k<A.col_buffer_.size(); ++k)
+    ++AT.row_buffer_[A.col_buffer_[k] + 1];
+  for (vcl_size_t i=0; i<AT.size1_; ++i)
+    AT.row_buffer_[i+1] += AT.row_buffer_[i];
+
+  std::vector<unsigned int> pos(AT.row_buffer_.begin(), AT.row_buffer_.end() - 1);
+  for (vcl_size_t i=0; i<A.size1_; ++i)
+    for (unsigned int k = A.row_buffer_[i]; k < A.row_buffer_[i+1]; ++k)
+    {
+      unsigned int j = pos[A.col_buffer_[k]]++;
+      AT.col_buffer_[j] = static_cast<unsigned int>(i);
+      AT.elements_[j]   = A.elements_[k];
+    }
+}
+
+/** @brief Symbolic phase of the sparse matrix-matrix product C = A * B: Computes the sparsity pattern of C with sorted column indices. Multi-threaded!
+*
+* @param A  Left factor
+* @param B  Right factor
+* @param C  Result matrix. Only size and sparsity pattern are computed, entries are allocated but not initialized.
+*/
+template<typename NumericT>
+void amg_spgemm_symbolic(amg_csr_matrix<NumericT> const & A, amg_csr_matrix<NumericT> const & B, amg_csr_matrix<NumericT> & C)
+{
+  C.size1_ = A.size1_;
+  C.size2_ = B.size2_;
+  C.row_buffer_.assign(C.size1_ + 1, 0);
+
+  // First pass: Count entries per row
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel
+#endif
+  {
+    std::vector<unsigned int> marker(B.size2_, amg_sa_level<NumericT>::none());
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp for
+#endif
+    for (long i2=0; i2<static_cast<long>(A.size1_); ++i2)
+    {
+      unsigned int i = static_cast<unsigned int>(i2);
+      unsigned int num_entries = 0;
+      for (unsigned int k = A.row_buffer_[i]; k < A.row_buffer_[i+1]; ++k)
+      {
+        unsigned int j = A.col_buffer_[k];
+        for (unsigned int l = B.row_buffer_[j]; l < B.row_buffer_[j+1]; ++l)
+          if (marker[B.col_buffer_[l]] != i)
+          {
+            marker[B.col_buffer_[l]] = i;
+            ++num_entries;
+          }
+      }
+      C.row_buffer_[i+1] = num_entries;
+    }
+  }
+
+  for (vcl_size_t i=0; i<C.size1_; ++i)
+    C.row_buffer_[i+1] += C.row_buffer_[i];
+  C.col_buffer_.resize(C.row_buffer_[C.size1_]);
+  C.elements_.resize(C.row_buffer_[C.size1_]);
+
+  // Second pass: Write and sort column indices
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel
+#endif
+  {
+    std::vector<unsigned int> marker(B.size2_, amg_sa_level<NumericT>::none());
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp for
+#endif
+    for (long i2=0; i2<static_cast<long>(A.size1_); ++i2)
+    {
+      unsigned int i = static_cast<unsigned int>(i2);
+      unsigned int pos = C.row_buffer_[i];
+      for (unsigned int k = A.row_buffer_[i]; k < A.row_buffer_[i+1]; ++k)
+      {
+        unsigned int j = A.col_buffer_[k];
+        for (unsigned int l = B.row_buffer_[j]; l < B.row_buffer_[j+1]; ++l)
+          if (marker[B.col_buffer_[l]] != i)
+          {
+            marker[B.col_buffer_[l]] = i;
+            C.col_buffer_[pos++] = B.col_buffer_[l];
+          }
+      }
+      std::sort(C.col_buffer_.begin() + C.row_buffer_[i], C.col_buffer_.begin() + C.row_buffer_[i+1]);
+    }
+  }
+}
+
+/** @brief Numeric phase of the sparse matrix-matrix product C = A * B. The sparsity pattern of C must have been computed by amg_spgemm_symbolic(). Multi-threaded!
+*
+* @param A  Left factor
+* @param B  Right factor
+* @param C  Result matrix with precomputed sparsity pattern
+*/
+template<typename NumericT>
+void amg_spgemm_numeric(amg_csr_matrix<NumericT> const & A, amg_csr_matrix<NumericT> const & B, amg_csr_matrix<NumericT> & C)
+{
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel
+#endif
+  {
+    std::vector<NumericT> accumulator(B.size2_);
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp for
+#endif
+    for (long i2=0; i2<static_cast<long>(A.size1_); ++i2)
+    {
+      unsigned int i = static_cast<unsigned int>(i2);
+      for (unsigned int k = C.row_buffer_[i]; k < C.row_buffer_[i+1]; ++k)
+        accumulator[C.col_buffer_[k]] = 0;
+
+      for (unsigned int k = A.row_buffer_[i]; k < A.row_buffer_[i+1]; ++k)
+      {
+        NumericT a_ij = A.elements_[k];
+        unsigned int j = A.col_buffer_[k];
+        for (unsigned int l = B.row_buffer_[j]; l < B.row_buffer_[j+1]; ++l)
+          accumulator[B.col_buffer_[l]] += a_ij * B.elements_[l];
+      }
+
+      for (unsigned int k = C.row_buffer_[i]; k < C.row_buffer_[i+1]; ++k)
+        C.elements_[k] = accumulator[C.col_buffer_[k]];
+    }
+  }
+}
+
+/** @brief Computes the symmetrized strength-of-connection graph of the nodes: Node J is strongly connected to node I if ||A_IJ|| >= eps * sqrt(||A_II|| * ||A_JJ||) in the Frobenius norm,
+*          where eps is the threshold of the tag halved on each coarser level (Vanek et al.). Multi-threaded!
+*
+* @param level  Level identifier
+* @param L      Level data. A_ and block_size_ must be set, S_ is computed.
+* @param tag    AMG preconditioner tag
+*/
+template<typename NumericT>
+void amg_sa_strength(unsigned int level, amg_sa_level<NumericT> & L, amg_tag const & tag)
+{
+  amg_csr_matrix<NumericT> const & A = L.A_;
+  unsigned int block_size = L.block_size_;
+  long num_nodes = static_cast<long>(A.size1_ / block_size);
+  NumericT eps = static_cast<NumericT>(tag.get_threshold() * std::pow(0.5, static_cast<double>(level)));
+
+  // Norms of the diagonal blocks:
+  std::vector<NumericT> diag_norm(static_cast<vcl_size_t>(num_nodes));
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for
+#endif
+  for (long node=0; node<num_nodes; ++node)
+  {
+    NumericT norm = 0;
+    for (unsigned int i = static_cast<unsigned int>(node) * block_size; i < static_cast<unsigned int>(node + 1) * block_size; ++i)
+      for (unsigned int k = A.row_buffer_[i]; k < A.row_buffer_[i+1]; ++k)
+        if (A.col_buffer_[k] / block_size == static_cast<unsigned int>(node))
+          norm += A.elements_[k] * A.elements_[k];
+    diag_norm[static_cast<vcl_size_t>(node)] = std::sqrt(norm);
+  }
+
+  std::vector<std::vector<unsigned int> > rows(static_cast<vcl_size_t>(num_nodes));
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel
+#endif
+  {
+    std::vector<NumericT>     block_norm(static_cast<vcl_size_t>(num_nodes));
+    std::vector<unsigned int> marker(static_cast<vcl_size_t>(num_nodes), amg_sa_level<NumericT>::none());
+    std::vector<unsigned int> touched;
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp for
+#endif
+    for (long node=0; node<num_nodes; ++node)
+    {
+      unsigned int I = static_cast<unsigned int>(node);
+      touched.clear();
+      for (unsigned int i = I * block_size; i < (I + 1) * block_size; ++i)
+        for (unsigned int k = A.row_buffer_[i]; k < A.row_buffer_[i+1]; ++k)
+        {
+          unsigned int J = A.col_buffer_[k] / block_size;
+          if (J == I)
+            continue;
+          if (marker[J] != I)
+          {
+            marker[J] = I;
+            block_norm[J] = 0;
+            touched.push_back(J);
+          }
+          block_norm[J] += A.elements_[k] * A.elements_[k];
+        }
+
+      for (vcl_size_t t=0; t<touched.size(); ++t)
+      {
+        unsigned int J = touched[t];
+        if (std::sqrt(block_norm[J]) >= eps * std::sqrt(diag_norm[I] * diag_norm[J]))
+          rows[I].push_back(J);
+      }
+    }
+  }
+
+  // Symmetrize:
+  std::vector<vcl_size_t> num_strong(rows.size());
+  for (vcl_size_t I=0; I<rows.size(); ++I)
+    num_strong[I] = rows[I].size();
+  for (vcl_size_t I=0; I<rows.size(); ++I)
+    for (vcl_size_t k=0; k<num_strong[I]; ++k)
+      rows[rows[I][k]].push_back(static_cast<unsigned int>(I));
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for
+#endif
+  for (long node=0; node<num_nodes; ++node)
+  {
+    std::vector<unsigned int> & row = rows[static_cast<vcl_size_t>(node)];
+    std::sort(row.begin(), row.end());
+    row.erase(std::unique(row.begin(), row.end()), row.end());
+  }
+
+  L.S_.row_buffer_.resize(rows.size() + 1);
+  L.S_.row_buffer_[0] = 0;
+  for (vcl_size_t I=0; I<rows.size(); ++I)
+    L.S_.row_buffer_[I+1] = L.S_.row_buffer_[I] + static_cast<unsigned int>(rows[I].size());
+  L.S_.col_buffer_.resize(L.S_.row_buffer_[rows.size()]);
+  for (vcl_size_t I=0; I<rows.size(); ++I)
+    std::copy(rows[I].begin(), rows[I].end(), L.S_.col_buffer_.begin() + L.S_.row_buffer_[I]);
+}
+
+/** @brief Node state and tie-breaking weight used for the distance-two maximal independent set
+*/
+struct amg_mis2_tuple
+{
+  unsigned int state;
+  unsigned int weight;
+  unsigned int index;
+
+  bool operator<(amg_mis2_tuple const & other) const
+  {
+    if (state != other.state)
+      return state < other.state;
+    if (weight != other.weight)
+      return weight < other.weight;
+    return index < other.index;
+  }
+};
+
+/** @brief Aggregation based on a maximal independent set of distance two (MIS-2) of the strength graph. Multi-threaded!
+*
+*  The MIS-2 is computed by repeatedly propagating the maximum of (state, random weight, index) over two layers of neighbors, see Bell, Dalton, Olson (2012).
+*  Each node of the MIS-2 forms an aggregate with its strongly connected neighbors, the remaining nodes join an aggregate of one of their neighbors.
+*  Nodes without strong connections are not aggregated.
+*  The result does not depend on the number of threads.
+*
+* @param L  Level data. S_ must be set, aggregates_ and num_aggregates_ are computed.
+*/
+template<typename NumericT>
+void amg_sa_aggregate(amg_sa_level<NumericT> & L)
+{
+  amg_strength_csr const & S = L.S_;
+  long num_nodes = static_cast<long>(S.size());
+  unsigned int const none = amg_sa_level<NumericT>::none();
+  unsigned int const out = 0, undecided = 1, in = 2;
+
+  std::vector<amg_mis2_tuple> tuples(static_cast<vcl_size_t>(num_nodes));
+  std::vector<amg_mis2_tuple> tuples_max1(static_cast<vcl_size_t>(num_nodes));
+  std::vector<amg_mis2_tuple> tuples_max2(static_cast<vcl_size_t>(num_nodes));
+
+  long num_undecided = 0;
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for reduction(+: num_undecided)
+#endif
+  for (long i=0; i<num_nodes; ++i)
+  {
+    vcl_size_t ui = static_cast<vcl_size_t>(i);
+    // Nodes without strong connections are not aggregated
+    tuples[ui].state  = (S.row_buffer_[ui] == S.row_buffer_[ui+1]) ? out : undecided;
+    tuples[ui].weight = static_cast<unsigned int>(amg_random_weight(static_cast<unsigned int>(i)) * 4294967295.0);
+    tuples[ui].index  = static_cast<unsigned int>(i);
+    if (tuples[ui].state == undecided)
+      ++num_undecided;
+  }
+
+  while (num_undecided > 0)
+  {
+    // Maximum over distance one:
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for
+#endif
+    for (long i=0; i<num_nodes; ++i)
+    {
+      vcl_size_t ui = static_cast<vcl_size_t>(i);
+      amg_mis2_tuple t = tuples[ui];
+      for (unsigned int k = S.row_buffer_[ui]; k < S.row_buffer_[ui+1]; ++k)
+        if (t < tuples[S.col_buffer_[k]])
+          t = tuples[S.col_buffer_[k]];
+      tuples_max1[ui] = t;
+    }
+
+    // Maximum over distance two:
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for
+#endif
+    for (long i=0; i<num_nodes; ++i)
+    {
+      vcl_size_t ui = static_cast<vcl_size_t>(i);
+      amg_mis2_tuple t = tuples_max1[ui];
+      for (unsigned int k = S.row_buffer_[ui]; k < S.row_buffer_[ui+1]; ++k)
+        if (t < tuples_max1[S.col_buffer_[k]])
+          t = tuples_max1[S.col_buffer_[k]];
+      tuples_max2[ui] = t;
+    }
+
+    // Nodes maximal in their distance-two neighborhood join the MIS-2, nodes with a MIS-2 node in their distance-two neighborhood are removed:
+    num_undecided = 0;
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for reduction(+: num_undecided)
+#endif
+    for (long i=0; i<num_nodes; ++i)
+    {
+      vcl_size_t ui = static_cast<vcl_size_t>(i);
+      if (tuples[ui].state != undecided)
+        continue;
+
+      if (tuples_max2[ui].index == ui)
+        tuples[ui].state = in;
+      else if (tuples_max2[ui].state == in)
+        tuples[ui].state = out;
+      else
+        ++num_undecided;
+    }
+  }
+
+  // Number aggregates in the order of their root nodes:
+  L.aggregates_.assign(static_cast<vcl_size_t>(num_nodes), none);
+  unsigned int num_aggregates = 0;
+  for (long i=0; i<num_nodes; ++i)
+    if (tuples[static_cast<vcl_size_t>(i)].state == in)
+      L.aggregates_[static_cast<vcl_size_t>(i)] = num_aggregates++;
+  L.num_aggregates_ = num_aggregates;
+
+  // Neighbors of root nodes join the aggregate of the root. Root nodes are at least three edges apart, hence the root is unique.
+  std::vector<unsigned int> aggregates_first(L.aggregates_);
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for
+#endif
+  for (long i=0; i<num_nodes; ++i)
+  {
+    vcl_size_t ui = static_cast<vcl_size_t>(i);
+    if (aggregates_first[ui] != none)
+      continue;
+    for (unsigned int k = S.row_buffer_[ui]; k < S.row_buffer_[ui+1]; ++k)
+      if (tuples[S.col_buffer_[k]].state == in)
+      {
+        L.aggregates_[ui] = aggregates_first[S.col_buffer_[k]];
+        break;
+      }
+  }
+
+  // Remaining nodes join the aggregate of the first aggregated neighbor:
+  aggregates_first = L.aggregates_;
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for
+#endif
+  for (long i=0; i<num_nodes; ++i)
+  {
+    vcl_size_t ui = static_cast<vcl_size_t>(i);
+    if (aggregates_first[ui] != none)
+      continue;
+    for (unsigned int k = S.row_buffer_[ui]; k < S.row_buffer_[ui+1]; ++k)
+      if (aggregates_first[S.col_buffer_[k]] != none)
+      {
+        L.aggregates_[ui] = aggregates_first[S.col_buffer_[k]];
+        break;
+      }
+  }
+}
+
+/** @brief Computes the tentative prolongator from a QR decomposition of the near-nullspace vectors restricted to each aggregate. Multi-threaded!
+*
+*  The Q factors form the columns of the tentative prolongator belonging to an aggregate, the R factors form the near-nullspace vectors on the coarse level.
+*
+* @param L                   Level data. aggregates_ must be set, P_tentative_ is computed. The sparsity pattern of P_tentative_ is only computed if L.valid_ is false.
+* @param nullspace           Near-nullspace vectors of the level, stored row-wise. The constant vector is used if empty.
+* @param num_vectors         Number of near-nullspace vectors
+* @param coarse_nullspace    Near-nullspace vectors of the coarse level (output)
+*/
+template<typename NumericT>
+void amg_sa_tentative(amg_sa_level<NumericT> & L, std::vector<NumericT> const & nullspace, unsigned int num_vectors, std::vector<NumericT> & coarse_nullspace)
+{
+  unsigned int const none = amg_sa_level<NumericT>::none();
+  unsigned int block_size = L.block_size_;
+  vcl_size_t num_nodes = L.aggregates_.size();
+  vcl_size_t size = L.A_.size1_;
+  amg_csr_matrix<NumericT> & P = L.P_tentative_;
+
+  // Nodes per aggregate:
+  std::vector<unsigned int> aggregate_ptr(L.num_aggregates_ + 1, 0);
+  std::vector<unsigned int> aggregate_nodes(num_nodes);
+  for (vcl_size_t node=0; node<num_nodes; ++node)
+    if (L.aggregates_[node] != none)
+      ++aggregate_ptr[L.aggregates_[node] + 1];
+  for (vcl_size_t a=0; a<L.num_aggregates_; ++a)
+    aggregate_ptr[a+1] += aggregate_ptr[a];
+  {
+    std::vector<unsigned int> pos(aggregate_ptr.begin(), aggregate_ptr.end() - 1);
+    for (vcl_size_t node=0; node<num_nodes; ++node)
+      if (L.aggregates_[node] != none)
+        aggregate_nodes[pos[L.aggregates_[node]]++] = static_cast<unsigned int>(node);
+  }
+
+  // Sparsity pattern: Each aggregated unknown couples to the num_vectors coarse unknowns of its aggregate
+  if (!L.valid_)
+  {
+    P.size1_ = size;
+    P.size2_ = vcl_size_t(L.num_aggregates_) * num_vectors;
+    P.row_buffer_.resize(size + 1);
+    P.row_buffer_[0] = 0;
+    for (vcl_size_t i=0; i<size; ++i)
+      P.row_buffer_[i+1] = P.row_buffer_[i] + ((L.aggregates_[i / block_size] != none) ? num_vectors : 0);
+    P.col_buffer_.resize(P.row_buffer_[size]);
+    P.elements_.resize(P.row_buffer_[size]);
+    for (vcl_size_t i=0; i<size; ++i)
+      for (unsigned int c=0; c<P.row_buffer_[i+1] - P.row_buffer_[i]; ++c)
+        P.col_buffer_[P.row_buffer_[i] + c] = L.aggregates_[i / block_size] * num_vectors + c;
+  }
+
+  coarse_nullspace.resize(vcl_size_t(L.num_aggregates_) * num_vectors * num_vectors);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel
+#endif
+  {
+    std::vector<NumericT> Q;
+    std::vector<NumericT> R(num_vectors * num_vectors);
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp for
+#endif
+    for (long a2=0; a2<static_cast<long>(L.num_aggregates_); ++a2)
+    {
+      vcl_size_t a = static_cast<vcl_size_t>(a2);
+      vcl_size_t rows = (aggregate_ptr[a+1] - aggregate_ptr[a]) * block_size;
+
+      // Gather nullspace vectors, Q is stored row-wise (rows x num_vectors)
+      Q.resize(rows * num_vectors);
+      for (vcl_size_t n = aggregate_ptr[a]; n < aggregate_ptr[a+1]; ++n)
+        for (unsigned int b=0; b<block_size; ++b)
+        {
+          vcl_size_t i = vcl_size_t(aggregate_nodes[n]) * block_size + b;
+          vcl_size_t r = (n - aggregate_ptr[a]) * block_size + b;
+          for (unsigned int c=0; c<num_vectors; ++c)
+            Q[r * num_vectors + c] = nullspace.empty() ? NumericT(1) : nullspace[i * num_vectors + c];
+        }
+
+      // Modified Gram-Schmidt. Linearly dependent columns result in zero columns of Q.
+      std::fill(R.begin(), R.end(), NumericT(0));
+      for (unsigned int c=0; c<num_vectors; ++c)
+      {
+        for (unsigned int p=0; p<c; ++p)
+        {
+          NumericT dot = 0;
+          for (vcl_size_t r=0; r<rows; ++r)
+            dot += Q[r * num_vectors + p] * Q[r * num_vectors + c];
+          R[p * num_vectors + c] = dot;
+          for (vcl_size_t r=0; r<rows; ++r)
+            Q[r * num_vectors + c] -= dot * Q[r * num_vectors + p];
+        }
+
+        NumericT norm = 0;
+        for (vcl_size_t r=0; r<rows; ++r)
+          norm += Q[r * num_vectors + c] * Q[r * num_vectors + c];
+        norm = std::sqrt(norm);
+        R[c * num_vectors + c] = norm;
+        for (vcl_size_t r=0; r<rows; ++r)
+          Q[r * num_vectors + c] = (norm > 0) ? Q[r * num_vectors + c] / norm : NumericT(0);
+      }
+
+      // Scatter Q to the rows of the tentative prolongator, R to the coarse nullspace:
+      for (vcl_size_t n = aggregate_ptr[a]; n < aggregate_ptr[a+1]; ++n)
+        for (unsigned int b=0; b<block_size; ++b)
+        {
+          vcl_size_t i = vcl_size_t(aggregate_nodes[n]) * block_size + b;
+          vcl_size_t r = (n - aggregate_ptr[a]) * block_size + b;
+          for (unsigned int c=0; c<num_vectors; ++c)
+            P.elements_[P.row_buffer_[i] + c] = Q[r * num_vectors + c];
+        }
+      for (unsigned int p=0; p<num_vectors; ++p)
+        for (unsigned int c=0; c<num_vectors; ++c)
+          coarse_nullspace[(a * num_vectors + p) * num_vectors + c] = R[p * num_vectors + c];
+    }
+  }
+}
+
+/** @brief Computes the filtered operator, where weak connections between nodes are added to the diagonal. Multi-threaded!
+*
+* The diagonal of A_filtered_ is always stored: Rows of A without a stored diagonal entry receive one, which then holds the sum of the weak connections of the row.
+* The column indices of the rows of A are assumed to be sorted.
+*
+* @param L  Level data. A_ and S_ must be set, A_filtered_ is computed. The sparsity pattern of A_filtered_ is only computed if L.valid_ is false.
+*/
+template<typename NumericT>
+void amg_sa_filter(amg_sa_level<NumericT> & L)
+{
+  amg_csr_matrix<NumericT> const & A = L.A_;
+  amg_csr_matrix<NumericT> & AF = L.A_filtered_;
+  amg_strength_csr const & S = L.S_;
+  unsigned int block_size = L.block_size_;
+  long size = static_cast<long>(A.size1_);
+
+  if (!L.valid_)
+  {
+    AF.size1_ = A.size1_;
+    AF.size2_ = A.size2_;
+    AF.row_buffer_.assign(A.size1_ + 1, 0);
+  }
+
+  for (int pass = L.valid_ ? 1 : 0; pass < 2; ++pass)
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for
+#endif
+    for (long i2=0; i2<size; ++i2)
+    {
+      unsigned int i = static_cast<unsigned int>(i2);
+      unsigned int I = i / block_size;
+      std::vector<unsigned int>::const_iterator S_begin = S.col_buffer_.begin() + S.row_buffer_[I];
+      std::vector<unsigned int>::const_iterator S_end   = S.col_buffer_.begin() + S.row_buffer_[I+1];
+
+      unsigned int no_diag = static_cast<unsigned int>(-1);
+      unsigned int pos = (pass == 0) ? 0 : AF.row_buffer_[i];
+      unsigned int diag_pos = no_diag;
+      NumericT weak_sum = 0;
+      for (unsigned int k = A.row_buffer_[i]; k <= A.row_buffer_[i+1]; ++k)
+      {
+        // insert a zero diagonal entry if A has none, keeping the columns sorted:
+        if (diag_pos == no_diag && (k == A.row_buffer_[i+1] || A.col_buffer_[k] > i))
+        {
+          if (pass == 1)
+          {
+            AF.col_buffer_[pos] = i;
+            AF.elements_[pos]   = 0;
+          }
+          diag_pos = pos++;
+        }
+        if (k == A.row_buffer_[i+1])
+          break;
+
+        unsigned int j = A.col_buffer_[k];
+        unsigned int J = j / block_size;
+        if (j == i)
+          diag_pos = pos;
+        if (J == I || std::binary_search(S_begin, S_end, J))
+        {
+          if (pass == 1)
+          {
+            AF.col_buffer_[pos] = j;
+            AF.elements_[pos]   = A.elements_[k];
+          }
+          ++pos;
+        }
+        else
+          weak_sum += A.elements_[k];
+      }
+
+      if (pass == 0)
+        AF.row_buffer_[i+1] = pos;
+      else
+        AF.elements_[diag_pos] += weak_sum;
+    }
+
+    if (pass == 0)
+    {
+      for (vcl_size_t i=0; i<AF.size1_; ++i)
+        AF.row_buffer_[i+1] += AF.row_buffer_[i];
+      AF.col_buffer_.resize(AF.row_buffer_[AF.size1_]);
+      AF.elements_.resize(AF.row_buffer_[AF.size1_]);
+    }
+  }
+}
+
+/** @brief Estimates the spectral radius of D^{-1} A_F using a few power iterations. Rows with zero diagonal are ignored. Multi-threaded!
+*
+* @param AF          The filtered operator
+* @param iterations  Number of power iterations
+*/
+template<typename NumericT>
+NumericT amg_sa_estimate_spectral_radius(amg_csr_matrix<NumericT> const & AF, unsigned int iterations = 10)
+{
+  long size = static_cast<long>(AF.size1_);
+  std::vector<NumericT> diag_inv(AF.size1_);
+  std::vector<NumericT> x(AF.size1_);
+  std::vector<NumericT> y(AF.size1_);
+
+  // Deterministic pseudo-random start vector as for the Chebyshev smoother, cf. amg_estimate_lambda_max():
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for
+#endif
+  for (long i2=0; i2<size; ++i2)
+  {
+    unsigned int i = static_cast<unsigned int>(i2);
+    NumericT diag = 0;
+    for (unsigned int k = AF.row_buffer_[i]; k < AF.row_buffer_[i+1]; ++k)
+      if (AF.col_buffer_[k] == i)
+        diag = AF.elements_[k];
+    diag_inv[i] = (diag > 0 || diag < 0) ? NumericT(1) / diag : NumericT(0);
+    x[i] = NumericT((vcl_size_t(i) * 7919) % 1013) / NumericT(1013) - NumericT(0.5);
+  }
+
+  NumericT rho = 0;
+  for (unsigned int iter=0; iter<iterations; ++iter)
+  {
+    NumericT norm_x = 0;
+    NumericT norm_y = 0;
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for reduction(+: norm_x, norm_y)
+#endif
+    for (long i2=0; i2<size; ++i2)
+    {
+      unsigned int i = static_cast<unsigned int>(i2);
+      NumericT sum = 0;
+      for (unsigned int k = AF.row_buffer_[i]; k < AF.row_buffer_[i+1]; ++k)
+        sum += AF.elements_[k] * x[AF.col_buffer_[k]];
+      sum *= diag_inv[i];
+      y[i] = sum;
+      norm_x += x[i] * x[i];
+      norm_y += sum * sum;
+    }
+
+    if (norm_x <= 0 || norm_y <= 0)
+      break;
+
+    rho = std::sqrt(norm_y / norm_x);
+    NumericT scale = NumericT(1) / std::sqrt(norm_y);
+    for (vcl_size_t i=0; i<x.size(); ++i)
+      x[i] = y[i] * scale;
+  }
+
+  return rho;
+}
+
+/** @brief Smoothes the tentative prolongator with one damped Jacobi step based on the filtered operator: P = (I - omega * D^{-1} A_F) P_tentative. Multi-threaded!
+*
+* @param L      Level data. A_filtered_ and P_tentative_ must be set, P_ is computed. The sparsity pattern of P_ is only computed if L.valid_ is false.
+* @param omega  Jacobi weight
+*/
+template<typename NumericT>
+void amg_sa_smooth_prolongator(amg_sa_level<NumericT> & L, NumericT omega)
+{
+  amg_csr_matrix<NumericT> const & AF = L.A_filtered_;
+  amg_csr_matrix<NumericT> const & PT = L.P_tentative_;
+  amg_csr_matrix<NumericT> & P = L.P_;
+
+  // The diagonal of A_F is always stored (cf. amg_sa_filter()), hence the pattern of P_tentative is contained in the pattern of A_F * P_tentative
+  if (!L.valid_)
+    amg_spgemm_symbolic(AF, PT, P);
+  amg_spgemm_numeric(AF, PT, P);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for
+#endif
+  for (long i2=0; i2<static_cast<long>(P.size1_); ++i2)
+  {
+    unsigned int i = static_cast<unsigned int>(i2);
+    NumericT diag = 0;
+    for (unsigned int k = AF.row_buffer_[i]; k < AF.row_buffer_[i+1]; ++k)
+      if (AF.col_buffer_[k] == i)
+        diag = AF.elements_[k];
+    NumericT factor = (diag > 0 || diag < 0) ? -omega / diag : NumericT(0);
+
+    unsigned int l = PT.row_buffer_[i];
+    for (unsigned int k = P.row_buffer_[i]; k < P.row_buffer_[i+1]; ++k)
+    {
+      P.elements_[k] *= factor;
+      if (l < PT.row_buffer_[i+1] && PT.col_buffer_[l] == P.col_buffer_[k])
+        P.elements_[k] += PT.elements_[l++];
+    }
+  }
+}
+
+/** @brief Builds prolongator and Galerkin operator for one level of smoothed aggregation AMG. (VIENNACL_AMG_COARSE_MIS2)
+*
+*  If L.valid_ is true, aggregates and all sparsity patterns from a previous call are reused and only the numeric phases are run.
+*
+* @param level             Level identifier
+* @param L                 Level data. A_ and block_size_ must be set.
+* @param A_coarse          Galerkin operator R * A * P (output). The sparsity pattern is reused if L.valid_ is true.
+* @param nullspace         Near-nullspace vectors of the level, stored row-wise. The constant vector is used if empty.
+* @param num_vectors       Number of near-nullspace vectors
+* @param coarse_nullspace  Near-nullspace vectors of the coarse level (output)
+* @param tag               AMG preconditioner tag
+* @return                  Number of unknowns on the coarse level. Zero if the level cannot be coarsened further.
+*/
+template<typename NumericT>
+vcl_size_t amg_sa_coarsen(unsigned int level, amg_sa_level<NumericT> & L, amg_csr_matrix<NumericT> & A_coarse,
+                          std::vector<NumericT> const & nullspace, unsigned int num_vectors, std::vector<NumericT> & coarse_nullspace,
+                          amg_tag const & tag)
+{
+  assert(L.A_.size1_ % L.block_size_ == 0 && bool("Number of unknowns is not a multiple of the block size!"));
+
+  if (!L.valid_)
+  {
+    amg_sa_strength(level, L, tag);
+    amg_sa_aggregate(L);
+
+    // Stop if no further coarsening is possible
+    if (L.num_aggregates_ == 0 || vcl_size_t(L.num_aggregates_) * num_vectors >= L.A_.size1_)
+      return 0;
+  }
+
+  amg_sa_tentative(L, nullspace, num_vectors, coarse_nullspace);
+
+  // Unsmoothed aggregation if aggregation-based interpolation is requested, smoothed aggregation otherwise
+  if (tag.get_interpol() == VIENNACL_AMG_INTERPOL_AG)
+    L.P_ = L.P_tentative_;
+  else
+  {
+    // Damping omega = 4 / (3 rho(D^{-1} A_F)), where the power iteration approaches rho from below:
+    amg_sa_filter(L);
+    NumericT rho = amg_sa_estimate_spectral_radius(L.A_filtered_);
+    NumericT omega = (rho > 0) ? NumericT(4) / (NumericT(3) * NumericT(1.1) * rho) : NumericT(tag.get_interpolweight());
+    amg_sa_smooth_prolongator(L, omega);
+  }
+
+  // Galerkin product A_coarse = R * (A * P)
+  amg_csr_transpose(L.P_, L.R_);
+  if (!L.valid_)
+  {
+    amg_spgemm_symbolic(L.A_, L.P_, L.AP_);
+    amg_spgemm_symbolic(L.R_, L.AP_, A_coarse);
+  }
+  amg_spgemm_numeric(L.A_, L.P_, L.AP_);
+  amg_spgemm_numeric(L.R_, L.AP_, A_coarse);
+
+  L.valid_ = true;
+
+  #if defined (VIENNACL_AMG_DEBUG)
+  std::cout << "MIS-2 aggregation: Level " << level << ": ";
+  std::cout << "No of aggregates = " << L.num_aggregates_ << ", ";
+  std::cout << "No of coarse unknowns = " << A_coarse.size1_ << std::endl;
+  #endif
+
+  return A_coarse.size1_;
+}
+
+} //namespace amg
+} //namespace detail
+} //namespace linalg
+} //namespace viennacl
+
+#endif
@@ -0,0 +1,406 @@
+#ifndef VIENNACL_LINALG_DETAIL_AMG_AMG_SMOOTH_HPP
+#define VIENNACL_LINALG_DETAIL_AMG_AMG_SMOOTH_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file amg_smooth.hpp
+    @brief Smoothers for the AMG preconditioner (precondition phase) operating on CSR arrays on the host. Experimental.
+
+    All data required by the smoothers (inverse diagonals, eigenvalue estimates, work vectors) is computed in amg_level_init(),
+    so that the smoothers themselves never allocate memory.
+*/
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "viennacl/forwards.h"
+#include "viennacl/linalg/detail/amg/amg_base.hpp"
+#include "viennacl/linalg/gauss_seidel.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace detail
+{
+namespace amg
+{
+
+/** @brief Operator of one AMG level in CSR format together with all data precomputed for smoothing.
+*/
+template<typename NumericT>
+struct amg_level_csr
+{
+  amg_level_csr() : lambda_max_(1) {}
+
+  std::vector<unsigned int> row_buffer_;
+  std::vector<unsigned int> col_buffer_;
+  std::vector<NumericT>     elements_;
+
+  // Inverse diagonal entries (Jacobi, Chebyshev, Gauss-Seidel) and inverse l1-row norms (l1-Jacobi)
+  std::vector<NumericT>     diag_inv_;
+  std::vector<NumericT>     l1_diag_inv_;
+
+  // Row offsets of the blocks processed by the individual threads in the hybrid Gauss-Seidel smoothers. Has one entry more than there are blocks.
+  std::vector<unsigned int> block_offsets_;
+
+  // Work vectors of the size of the level
+  std::vector<NumericT>     work1_;
+  std::vector<NumericT>     work2_;
+
+  // Estimate of the largest eigenvalue of D^{-1} A, used by the Chebyshev smoother
+  NumericT lambda_max_;
+
+  // Operator with rows permuted by color, used by the multicolor Gauss-Seidel smoothers
+  viennacl::linalg::detail::multicolor_csr<NumericT> multicolor_;
+
+  vcl_size_t size() const { return diag_inv_.size(); }
+};
+
+
+/** @brief Computes r = rhs - A * x for the operator of an AMG level. Multi-threaded!
+*
+* @param L    AMG level
+* @param x    Current iterate
+* @param rhs  Right hand side
+* @param r    Residual (output)
+*/
+template<typename NumericT>
+void amg_residual(amg_level_csr<NumericT> const & L, NumericT const * x, NumericT const * rhs, NumericT * r)
+{
+  unsigned int const * row_buffer = &(L.row_buffer_[0]);
+  unsigned int const * col_buffer = L.col_buffer_.size() ? &(L.col_buffer_[0]) : NULL;
+  NumericT     const * elements   = L.elements_.size()   ? &(L.elements_[0])   : NULL;
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for
+#endif
+  for (long row = 0; row < static_cast<long>(L.size()); ++row)
+  {
+    NumericT sum = rhs[row];
+    unsigned int row_end = row_buffer[row+1];
+    for (unsigned int j = row_buffer[row]; j < row_end; ++j)
+      sum -= elements[j] * x[col_buffer[j]];
+    r[row] = sum;
+  }
+}
+
+/** @brief Estimates the largest eigenvalue of D^{-1} A of an AMG level using a few power iterations. Uses the work vectors of the level.
+*
+* @param L           AMG level. The estimate is stored in L.lambda_max_
+* @param iterations  Number of power iterations
+*/
+template<typename NumericT>
+void amg_estimate_lambda_max(amg_level_csr<NumericT> & L, unsigned int iterations = 10)
+{
+  vcl_size_t size = L.size();
+  NumericT * x = &(L.work1_[0]);
+  NumericT * y = &(L.work2_[0]);
+
+  unsigned int const * row_buffer = &(L.row_buffer_[0]);
+  unsigned int const * col_buffer = L.col_buffer_.size() ? &(L.col_buffer_[0]) : NULL;
+  NumericT     const * elements   = L.elements_.size()   ? &(L.elements_[0])   : NULL;
+  NumericT     const * diag_inv   = &(L.diag_inv_[0]);
+
+  // Deterministic pseudo-random start vector, so that high-frequency modes are present and the result does not depend on the number of threads:
+  for (vcl_size_t i=0; i<size; ++i)
+    x[i] = NumericT((i * 7919) % 1013) / NumericT(1013) - NumericT(0.5);
+
+  NumericT lambda = 1;
+  for (unsigned int iter=0; iter<iterations; ++iter)
+  {
+    NumericT norm_x = 0;
+    NumericT norm_y = 0;
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for reduction(+: norm_x, norm_y)
+#endif
+    for (long row = 0; row < static_cast<long>(size); ++row)
+    {
+      NumericT sum = 0;
+      unsigned int row_end = row_buffer[row+1];
+      for (unsigned int j = row_buffer[row]; j < row_end; ++j)
+        sum += elements[j] * x[col_buffer[j]];
+      sum *= diag_inv[row];
+      y[row] = sum;
+      norm_x += x[row] * x[row];
+      norm_y += sum * sum;
+    }
+
+    if (norm_x <= 0 || norm_y <= 0)
+      break;
+
+    lambda = std::sqrt(norm_y / norm_x);
+    NumericT scale = NumericT(1) / std::sqrt(norm_y);
+    for (vcl_size_t i=0; i<size; ++i)
+      x[i] = y[i] * scale;
+  }
+
+  L.lambda_max_ = lambda;
+}
+
+/** @brief Sets up an AMG level for the precondition phase: Copies the operator to CSR arrays, precomputes inverse diagonals and allocates all work vectors.
+*
+* @param L    AMG level (output)
+* @param A    Operator matrix of the level from the setup phase
+* @param tag  AMG preconditioner tag
+*/
+template<typename NumericT, typename SparseMatrixT>
+void amg_level_init(amg_level_csr<NumericT> & L, SparseMatrixT const & A, amg_tag const & tag)
+{
+  typedef typename SparseMatrixT::const_iterator1 ConstRowIterator;
+  typedef typename SparseMatrixT::const_iterator2 ConstColIterator;
+
+  vcl_size_t size = A.size1();
+
+  L.row_buffer_.assign(size + 1, 0);
+  L.col_buffer_.clear();
+  L.elements_.clear();
+  L.diag_inv_.assign(size, NumericT(1));
+  L.l1_diag_inv_.assign(size, NumericT(1));
+
+  for (ConstRowIterator row_iter = A.begin1(); row_iter != A.end1(); ++row_iter)
+  {
+    vcl_size_t row = row_iter.index1();
+    NumericT l1_norm = 0;
+    for (ConstColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
+    {
+      NumericT value = *col_iter;
+      L.col_buffer_.push_back(static_cast<unsigned int>(col_iter.index2()));
+      L.elements_.push_back(value);
+      l1_norm += std::fabs(value);
+      if (col_iter.index2() == row && std::fabs(value) > 0)
+        L.diag_inv_[row] = NumericT(1) / value;
+    }
+    L.row_buffer_[row+1] = static_cast<unsigned int>(L.elements_.size());
+    if (l1_norm > 0)
+      L.l1_diag_inv_[row] = NumericT(1) / l1_norm;
+  }
+  // make row_buffer consistent for trailing empty rows:
+  for (vcl_size_t row = 1; row <= size; ++row)
+    L.row_buffer_[row] = std::max(L.row_buffer_[row], L.row_buffer_[row-1]);
+
+  // One contiguous block of rows per thread for the hybrid Gauss-Seidel smoothers:
+  vcl_size_t num_blocks = 1;
+#ifdef VIENNACL_WITH_OPENMP
+  num_blocks = static_cast<vcl_size_t>(omp_get_max_threads());
+#endif
+  num_blocks = std::max<vcl_size_t>(1, std::min(num_blocks, size));
+  L.block_offsets_.resize(num_blocks + 1);
+  for (vcl_size_t i=0; i<=num_blocks; ++i)
+    L.block_offsets_[i] = static_cast<unsigned int>((i * size) / num_blocks);
+
+  L.work1_.assign(size, NumericT(0));
+  L.work2_.assign(size, NumericT(0));
+
+  if (tag.get_smoother() == VIENNACL_AMG_SMOOTHER_CHEBYSHEV && size > 0)
+    amg_estimate_lambda_max(L);
+
+  if ((tag.get_smoother() == VIENNACL_AMG_SMOOTHER_MULTICOLOR_GS || tag.get_smoother() == VIENNACL_AMG_SMOOTHER_MULTICOLOR_SGS) && size > 0)
+    viennacl::linalg::detail::multicolor_csr_init(&(L.row_buffer_[0]), &(L.col_buffer_[0]), &(L.elements_[0]), size, L.multicolor_);
+}
+
+
+/** @brief (Weighted) Jacobi smoother: x <- x + omega * D^{-1} (rhs - A x). Multi-threaded!
+*
+* @param L           AMG level
+* @param diag_inv    Inverse diagonal (D^{-1}) to use, either the inverse diagonal entries or the inverse l1-row norms
+* @param omega       Damping factor
+* @param iterations  Number of smoother iterations
+* @param x           Current iterate, overwritten with the smoothed iterate
+* @param rhs         Right hand side
+*/
+template<typename NumericT>
+void amg_smooth_jacobi(amg_level_csr<NumericT> & L, std::vector<NumericT> const & diag_inv, NumericT omega, unsigned int iterations, NumericT * x, NumericT const * rhs)
+{
+  NumericT       * r = &(L.work1_[0]);
+  NumericT const * d = &(diag_inv[0]);
+
+  for (unsigned int i=0; i<iterations; ++i)
+  {
+    amg_residual(L, x, rhs, r);
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for
+#endif
+    for (long row = 0; row < static_cast<long>(L.size()); ++row)
+      x[row] += omega * d[row] * r[row];
+  }
+}
+
+/** @brief Chebyshev smoother for D^{-1} A targeting the eigenvalue interval [lambda_max/ratio, lambda_max]. Multi-threaded!
+*
+*  Each iteration applies a Chebyshev polynomial of degree tag.get_chebyshev_degree(). Uses the estimate L.lambda_max_ from the setup.
+*
+* @param L           AMG level
+* @param tag         AMG preconditioner tag
+* @param iterations  Number of smoother iterations
+* @param x           Current iterate, overwritten with the smoothed iterate
+* @param rhs         Right hand side
+*/
+template<typename NumericT>
+void amg_smooth_chebyshev(amg_level_csr<NumericT> & L, amg_tag const & tag, unsigned int iterations, NumericT * x, NumericT const * rhs)
+{
+  NumericT       * r = &(L.work1_[0]);
+  NumericT       * d = &(L.work2_[0]);
+  NumericT const * diag_inv = &(L.diag_inv_[0]);
+
+  // Slightly overestimate the upper bound, since the power iteration approaches the largest eigenvalue from below:
+  NumericT upper = NumericT(1.1) * L.lambda_max_;
+  NumericT lower = upper / static_cast<NumericT>(tag.get_chebyshev_ratio());
+  NumericT theta = (upper + lower) / NumericT(2);
+  NumericT delta = (upper - lower) / NumericT(2);
+  NumericT sigma = theta / delta;
+
+  long size = static_cast<long>(L.size());
+
+  for (unsigned int i=0; i<iterations; ++i)
+  {
+    NumericT rho = NumericT(1) / sigma;
+
+    amg_residual(L, x, rhs, r);
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for
+#endif
+    for (long row = 0; row < size; ++row)
+    {
+      d[row] = diag_inv[row] * r[row] / theta;
+      x[row] += d[row];
+    }
+
+    for (unsigned int k=1; k<tag.get_chebyshev_degree(); ++k)
+    {
+      NumericT rho_new = NumericT(1) / (NumericT(2) * sigma - rho);
+      NumericT alpha   = rho_new * rho;
+      NumericT beta    = NumericT(2) * rho_new / delta;
+
+      amg_residual(L, x, rhs, r);
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for
+#endif
+      for (long row = 0; row < size; ++row)
+      {
+        d[row] = alpha * d[row] + beta * diag_inv[row] * r[row];
+        x[row] += d[row];
+      }
+      rho = rho_new;
+    }
+  }
+}
+
+/** @brief Hybrid Gauss-Seidel smoother. Multi-threaded!
+*
+*  Each thread runs Gauss-Seidel sweeps on its block of rows, while values from other blocks are taken from the previous iterate (Jacobi coupling).
+*  Without OpenMP this is the classical Gauss-Seidel method.
+*
+* @param L           AMG level
+* @param iterations  Number of smoother iterations
+* @param symmetric   If true, each forward sweep is followed by a backward sweep (symmetric Gauss-Seidel)
+* @param backward    If true (and symmetric is false), backward sweeps are carried out instead of forward sweeps
+* @param x           Current iterate, overwritten with the smoothed iterate
+* @param rhs         Right hand side
+*/
+template<typename NumericT>
+void amg_smooth_gauss_seidel(amg_level_csr<NumericT> & L, unsigned int iterations, bool symmetric, bool backward, NumericT * x, NumericT const * rhs)
+{
+  NumericT           * x_old      = &(L.work1_[0]);
+  unsigned int const * row_buffer = &(L.row_buffer_[0]);
+  unsigned int const * col_buffer = L.col_buffer_.size() ? &(L.col_buffer_[0]) : NULL;
+  NumericT     const * elements   = L.elements_.size()   ? &(L.elements_[0])   : NULL;
+  NumericT     const * diag_inv   = &(L.diag_inv_[0]);
+  long num_blocks = static_cast<long>(L.block_offsets_.size()) - 1;
+
+  for (unsigned int i=0; i<iterations; ++i)
+  {
+    for (unsigned int sweep = 0; sweep < (symmetric ? 2u : 1u); ++sweep)
+    {
+      if (num_blocks > 1)
+        std::copy(x, x + L.size(), x_old);
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for
+#endif
+      for (long block = 0; block < num_blocks; ++block)
+      {
+        unsigned int block_start = L.block_offsets_[static_cast<vcl_size_t>(block)];
+        unsigned int block_end   = L.block_offsets_[static_cast<vcl_size_t>(block) + 1];
+
+        for (unsigned int k = block_start; k < block_end; ++k)
+        {
+          bool reverse = symmetric ? (sweep == 1) : backward;
+          unsigned int row = reverse ? block_end - 1 - (k - block_start) : k;
+          NumericT sum = rhs[row];
+          unsigned int row_end = row_buffer[row+1];
+          for (unsigned int j = row_buffer[row]; j < row_end; ++j)
+          {
+            unsigned int col = col_buffer[j];
+            sum -= elements[j] * ((col >= block_start && col < block_end) ? x[col] : x_old[col]);
+          }
+          x[row] += sum * diag_inv[row];
+        }
+      }
+    }
+  }
+}
+
+/** @brief Applies the smoother selected in the AMG tag to the level.
+*
+*  Gauss-Seidel uses forward sweeps for presmoothing and backward sweeps for postsmoothing, so that the V-cycle remains symmetric.
+*
+* @param L           AMG level
+* @param tag         AMG preconditioner tag
+* @param iterations  Number of smoother iterations
+* @param x           Current iterate, overwritten with the smoothed iterate
+* @param rhs         Right hand side
+* @param postsmooth  Whether the smoother is applied after the coarse grid correction
+*/
+template<typename NumericT>
+void amg_smooth(amg_level_csr<NumericT> & L, amg_tag const & tag, unsigned int iterations, NumericT * x, NumericT const * rhs, bool postsmooth = false)
+{
+  if (iterations == 0 || L.size() == 0)
+    return;
+
+  switch (tag.get_smoother())
+  {
+  case VIENNACL_AMG_SMOOTHER_L1_JACOBI: amg_smooth_jacobi(L, L.l1_diag_inv_, NumericT(1), iterations, x, rhs); break;
+  case VIENNACL_AMG_SMOOTHER_CHEBYSHEV: amg_smooth_chebyshev(L, tag, iterations, x, rhs); break;
+  case VIENNACL_AMG_SMOOTHER_GS:        amg_smooth_gauss_seidel(L, iterations, false, postsmooth, x, rhs); break;
+  case VIENNACL_AMG_SMOOTHER_SGS:       amg_smooth_gauss_seidel(L, iterations, true, false, x, rhs); break;
+  case VIENNACL_AMG_SMOOTHER_MULTICOLOR_GS:
+    for (unsigned int i=0; i<iterations; ++i)
+      viennacl::linalg::detail::multicolor_sor_sweep(L.multicolor_, x, rhs, NumericT(1), postsmooth);
+    break;
+  case VIENNACL_AMG_SMOOTHER_MULTICOLOR_SGS:
+    for (unsigned int i=0; i<iterations; ++i)
+    {
+      viennacl::linalg::detail::multicolor_sor_sweep(L.multicolor_, x, rhs, NumericT(1), false);
+      viennacl::linalg::detail::multicolor_sor_sweep(L.multicolor_, x, rhs, NumericT(1), true);
+    }
+    break;
+  default:                              amg_smooth_jacobi(L, L.diag_inv_, static_cast<NumericT>(tag.get_jacobiweight()), iterations, x, rhs);
+  }
+}
+
+} //namespace amg
+} //namespace detail
+} //namespace linalg
+} //namespace viennacl
+
+#endif
@@ -19,23 +19,63 @@
 ============================================================================= */
 
 /** @file viennacl/linalg/detail/ilu/block_ilu.hpp
-    @brief Implementations of incomplete block factorization preconditioners
+    @brief Implementations of incomplete block factorization preconditioners and of overlapping Schwarz preconditioners with incomplete factorizations on each subdomain
 */
 
 #include <vector>
 #include <cmath>
+#include <algorithm>
 #include "viennacl/forwards.h"
 #include "viennacl/tools/tools.hpp"
+#include "viennacl/vector.hpp"
 #include "viennacl/linalg/detail/ilu/common.hpp"
 #include "viennacl/linalg/detail/ilu/ilu0.hpp"
 #include "viennacl/linalg/detail/ilu/ilut.hpp"
 
 #include <map>
 
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
 namespace viennacl
 {
 namespace linalg
 {
+
+/** @brief A tag for (restricted) additive Schwarz preconditioners with incomplete factorizations on each subdomain
+*/
+class schwarz_tag
+{
+public:
+  /** @brief The constructor.
+  *
+  * @param num_subdomains   Number of subdomains. If zero, one subdomain per OpenMP thread is used.
+  * @param overlap          Number of layers of neighboring unknowns added to each subdomain
+  * @param restricted       If true, each unknown is only updated by the subdomain owning it (restricted additive Schwarz). Otherwise, the results of all subdomains are summed up (additive Schwarz).
+  */
+  schwarz_tag(vcl_size_t   num_subdomains = 0,
+              unsigned int overlap = 1,
+              bool         restricted = true)
+    : num_subdomains_(num_subdomains),
+      overlap_(overlap),
+      restricted_(restricted) {}
+
+  void set_num_subdomains(vcl_size_t num) { num_subdomains_ = num; }
+  vcl_size_t get_num_subdomains() const { return num_subdomains_; }
+
+  void set_overlap(unsigned int num) { overlap_ = num; }
+  unsigned int get_overlap() const { return overlap_; }
+
+  bool restricted() const { return restricted_; }
+  void restricted(bool b) { restricted_ = b; }
+
+private:
+  vcl_size_t   num_subdomains_;
+  unsigned int overlap_;
+  bool         restricted_;
+};
+
 namespace detail
 {
   /** @brief Helper range class for representing a subvector of a larger buffer. */
@@ -119,6 +159,396 @@ namespace detail
     }
   }
 
+
+  /** @brief Computes the symmetrized sparsity pattern of a square CSR matrix without diagonal entries.
+  *
+  * @param row_buffer      Row array of the matrix
+  * @param col_buffer      Column array of the matrix
+  * @param size            Number of rows
+  * @param sym_row_buffer  Row array of the pattern of A + A^T (output)
+  * @param sym_col_buffer  Column array of the pattern of A + A^T (output)
+  */
+  inline void schwarz_symmetric_pattern(unsigned int const * row_buffer, unsigned int const * col_buffer, vcl_size_t size,
+                                        std::vector<unsigned int> & sym_row_buffer, std::vector<unsigned int> & sym_col_buffer)
+  {
+    // count, allowing for duplicates from A and A^T:
+    std::vector<unsigned int> counts(size + 1, 0);
+    for (vcl_size_t i=0; i<size; ++i)
+      for (unsigned int k=row_buffer[i]; k<row_buffer[i+1]; ++k)
+        if (col_buffer[k] != i)
+        {
+          ++counts[i+1];
+          ++counts[col_buffer[k]+1];
+        }
+    for (vcl_size_t i=0; i<size; ++i)
+      counts[i+1] += counts[i];
+
+    std::vector<unsigned int> entries(counts[size]);
+    {
+      std::vector<unsigned int> pos(counts.begin(), counts.end() - 1);
+      for (vcl_size_t i=0; i<size; ++i)
+        for (unsigned int k=row_buffer[i]; k<row_buffer[i+1]; ++k)
+          if (col_buffer[k] != i)
+          {
+            entries[pos[i]++] = col_buffer[k];
+            entries[pos[col_buffer[k]]++] = static_cast<unsigned int>(i);
+          }
+    }
+
+    // remove duplicates:
+    sym_row_buffer.assign(size + 1, 0);
+    sym_col_buffer.clear();
+    sym_col_buffer.reserve(entries.size());
+    for (vcl_size_t i=0; i<size; ++i)
+    {
+      std::sort(entries.begin() + counts[i], entries.begin() + counts[i+1]);
+      std::vector<unsigned int>::iterator new_end = std::unique(entries.begin() + counts[i], entries.begin() + counts[i+1]);
+      sym_col_buffer.insert(sym_col_buffer.end(), entries.begin() + counts[i], new_end);
+      sym_row_buffer[i+1] = static_cast<unsigned int>(sym_col_buffer.size());
+    }
+  }
+
+  /** @brief Partitions the graph of a symmetric sparsity pattern into parts of equal size.
+  *
+  * The unknowns are ordered by breadth-first search starting from a pseudo-peripheral node in each connected component.
+  * Consecutive chunks of this ordering form the parts, which are thus compact and mostly connected.
+  *
+  * @param row_buffer   Row array of the symmetric pattern
+  * @param col_buffer   Column array of the symmetric pattern
+  * @param size         Number of unknowns
+  * @param num_parts    Number of parts
+  * @param part         Part of each unknown (output)
+  */
+  inline void schwarz_partition(std::vector<unsigned int> const & row_buffer, std::vector<unsigned int> const & col_buffer, vcl_size_t size,
+                                vcl_size_t num_parts, std::vector<unsigned int> & part)
+  {
+    unsigned int const none = static_cast<unsigned int>(-1);
+
+    std::vector<unsigned int> order;
+    order.reserve(size);
+    std::vector<unsigned int> visited(size, none); // BFS run in which a node was reached
+    std::vector<bool> ordered(size, false);
+    unsigned int bfs_run = 0;
+
+    for (vcl_size_t seed=0; seed<size; ++seed)
+    {
+      if (ordered[seed])
+        continue;
+
+      // find pseudo-peripheral node of the component by repeated BFS:
+      unsigned int start = static_cast<unsigned int>(seed);
+      vcl_size_t eccentricity = 0;
+      for (unsigned int attempt=0; attempt<4; ++attempt)
+      {
+        std::vector<unsigned int> queue(1, start);
+        std::vector<unsigned int> depth(1, 0);
+        visited[start] = bfs_run;
+        for (vcl_size_t q=0; q<queue.size(); ++q)
+          for (unsigned int k=row_buffer[queue[q]]; k<row_buffer[queue[q]+1]; ++k)
+            if (visited[col_buffer[k]] != bfs_run)
+            {
+              visited[col_buffer[k]] = bfs_run;
+              queue.push_back(col_buffer[k]);
+              depth.push_back(depth[q] + 1);
+            }
+        ++bfs_run;
+
+        if (attempt > 0 && depth.back() <= eccentricity)
+          break;
+        eccentricity = depth.back();
+        start = queue.back();
+      }
+
+      // final BFS defines the ordering of the component:
+      vcl_size_t first = order.size();
+      order.push_back(start);
+      ordered[start] = true;
+      for (vcl_size_t q=first; q<order.size(); ++q)
+        for (unsigned int k=row_buffer[order[q]]; k<row_buffer[order[q]+1]; ++k)
+          if (!ordered[col_buffer[k]])
+          {
+            ordered[col_buffer[k]] = true;
+            order.push_back(col_buffer[k]);
+          }
+    }
+
+    part.resize(size);
+    for (vcl_size_t k=0; k<size; ++k)
+      part[order[k]] = static_cast<unsigned int>((k * num_parts) / size);
+  }
+
+  /** @brief Factorizes a subdomain matrix with ILU0 in place. */
+  template<typename NumericT>
+  void schwarz_factor_dispatch(viennacl::compressed_matrix<NumericT> & LU, viennacl::linalg::ilu0_tag const & tag)
+  {
+    viennacl::linalg::precondition(LU, tag);
+  }
+
+  /** @brief Factorizes a subdomain matrix with ILUT, the factors replace the subdomain matrix. */
+  template<typename NumericT>
+  void schwarz_factor_dispatch(viennacl::compressed_matrix<NumericT> & LU, viennacl::linalg::ilut_tag const & tag)
+  {
+    std::vector< std::map<unsigned int, NumericT> > temp(LU.size1());
+    viennacl::linalg::precondition(LU, temp, tag);
+    viennacl::copy(temp, LU);
+  }
+
+  /** @brief Overlapping subdomains with incomplete LU factors of all subdomain matrices stored in contiguous buffers.
+  *
+  * The local unknowns of all subdomains are numbered consecutively, subdomain p holds local unknowns subdomain_buffer_[p], ..., subdomain_buffer_[p+1] - 1.
+  */
+  template<typename NumericT>
+  struct schwarz_subdomains
+  {
+    schwarz_subdomains() : size_(0), ram_ctx_(NULL) {}
+
+    vcl_size_t size_;
+
+    // host context whose thread team sets up and applies the preconditioner (NULL for the default host context)
+    viennacl::host_context const * ram_ctx_;
+
+    std::vector<unsigned int> subdomain_buffer_;
+    // global index of each local unknown
+    std::vector<unsigned int> nodes_;
+
+    // LU factors in CSR format, rows of all subdomains consecutive. Column indices refer to the numbering within the subdomain.
+    std::vector<unsigned int> row_buffer_;
+    std::vector<unsigned int> col_buffer_;
+    std::vector<NumericT>     elements_;
+
+    // local unknowns contributing to each global unknown: node_positions_[node_buffer_[i]], ..., node_positions_[node_buffer_[i+1] - 1]
+    std::vector<unsigned int> node_buffer_;
+    std::vector<unsigned int> node_positions_;
+
+    vcl_size_t num_subdomains() const { return subdomain_buffer_.size() - 1; }
+  };
+
+  /** @brief Sets up the overlapping subdomains and computes the incomplete factorizations of the subdomain matrices in parallel.
+  *
+  * @param row_buffer   Row array of the system matrix
+  * @param col_buffer   Column array of the system matrix
+  * @param elements     Values of the system matrix
+  * @param size         Number of rows
+  * @param tag          The Schwarz tag
+  * @param ilu_tag      Tag of the incomplete factorization used on each subdomain
+  * @param sd           The subdomains (output)
+  */
+  template<typename NumericT, typename ILUTagT>
+  void schwarz_setup(unsigned int const * row_buffer, unsigned int const * col_buffer, NumericT const * elements, vcl_size_t size,
+                     schwarz_tag const & tag, ILUTagT const & ilu_tag, schwarz_subdomains<NumericT> & sd)
+  {
+    unsigned int const none = static_cast<unsigned int>(-1);
+
+    vcl_size_t num_subdomains = tag.get_num_subdomains();
+    if (num_subdomains == 0)
+    {
+#ifdef VIENNACL_WITH_OPENMP
+      num_subdomains = static_cast<vcl_size_t>(omp_get_max_threads());
+#else
+      num_subdomains = 1;
+#endif
+    }
+    num_subdomains = std::max<vcl_size_t>(1, std::min(num_subdomains, size));
+
+    std::vector<unsigned int> sym_row_buffer, sym_col_buffer;
+    schwarz_symmetric_pattern(row_buffer, col_buffer, size, sym_row_buffer, sym_col_buffer);
+
+    std::vector<unsigned int> part;
+    schwarz_partition(sym_row_buffer, sym_col_buffer, size, num_subdomains, part);
+
+    // Step 1: owned unknowns of each subdomain, extended by the overlap layers. Then extract and factor the subdomain matrices.
+    std::vector<std::vector<unsigned int> > owned(num_subdomains);
+    for (vcl_size_t i=0; i<size; ++i)
+      owned[part[i]].push_back(static_cast<unsigned int>(i));
+
+    std::vector<std::vector<unsigned int> > nodes(num_subdomains);
+    std::vector<std::vector<unsigned int> > LU_row_buffers(num_subdomains);
+    std::vector<std::vector<unsigned int> > LU_col_buffers(num_subdomains);
+    std::vector<std::vector<NumericT> >     LU_elements(num_subdomains);
+    viennacl::context host_context(viennacl::MAIN_MEMORY);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel
+#endif
+    {
+      std::vector<unsigned int> local_index(size, none);
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp for schedule(dynamic)
+#endif
+      for (long p2=0; p2<static_cast<long>(num_subdomains); ++p2)
+      {
+        vcl_size_t p = static_cast<vcl_size_t>(p2);
+        std::vector<unsigned int> & sub_nodes = nodes[p];
+        sub_nodes = owned[p];
+        for (vcl_size_t k=0; k<sub_nodes.size(); ++k)
+          local_index[sub_nodes[k]] = 0;
+
+        vcl_size_t layer_begin = 0;
+        for (unsigned int layer=0; layer<tag.get_overlap(); ++layer)
+        {
+          vcl_size_t layer_end = sub_nodes.size();
+          for (vcl_size_t k=layer_begin; k<layer_end; ++k)
+            for (unsigned int j=sym_row_buffer[sub_nodes[k]]; j<sym_row_buffer[sub_nodes[k]+1]; ++j)
+              if (local_index[sym_col_buffer[j]] == none)
+              {
+                local_index[sym_col_buffer[j]] = 0;
+                sub_nodes.push_back(sym_col_buffer[j]);
+              }
+          layer_begin = layer_end;
+        }
+
+        // keep the original ordering of unknowns within the subdomain:
+        std::sort(sub_nodes.begin(), sub_nodes.end());
+        vcl_size_t sub_size = sub_nodes.size();
+        vcl_size_t sub_nnz = 0;
+        for (vcl_size_t k=0; k<sub_size; ++k)
+        {
+          local_index[sub_nodes[k]] = static_cast<unsigned int>(k);
+          sub_nnz += row_buffer[sub_nodes[k]+1] - row_buffer[sub_nodes[k]];
+        }
+
+        // extract subdomain matrix:
+        viennacl::compressed_matrix<NumericT> sub_matrix(sub_size, sub_size, sub_nnz, host_context);
+
+        NumericT     * sub_elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(sub_matrix.handle());
+        unsigned int * sub_row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(sub_matrix.handle1());
+        unsigned int * sub_col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(sub_matrix.handle2());
+
+        unsigned int counter = 0;
+        for (vcl_size_t k=0; k<sub_size; ++k)
+        {
+          sub_row_buffer[k] = counter;
+          unsigned int row = sub_nodes[k];
+          for (unsigned int j=row_buffer[row]; j<row_buffer[row+1]; ++j)
+            if (local_index[col_buffer[j]] != none)
+            {
+              sub_col_buffer[counter] = local_index[col_buffer[j]];
+              sub_elements[counter]   = elements[j];
+              ++counter;
+            }
+        }
+        sub_row_buffer[sub_size] = counter;
+
+        for (vcl_size_t k=0; k<sub_size; ++k)
+          local_index[sub_nodes[k]] = none;
+
+        schwarz_factor_dispatch(sub_matrix, ilu_tag);
+
+        unsigned int const * LU_row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(sub_matrix.handle1());
+        unsigned int const * LU_col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(sub_matrix.handle2());
+        NumericT     const * LU_values     = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(sub_matrix.handle());
+        LU_row_buffers[p].assign(LU_row_buffer, LU_row_buffer + sub_size + 1);
+        LU_col_buffers[p].assign(LU_col_buffer, LU_col_buffer + LU_row_buffer[sub_size]);
+        LU_elements[p].assign(LU_values, LU_values + LU_row_buffer[sub_size]);
+      }
+    }
+
+    // Step 2: pack factors into contiguous buffers:
+    sd.size_ = size;
+    sd.subdomain_buffer_.assign(num_subdomains + 1, 0);
+    std::vector<unsigned int> nnz_offsets(num_subdomains + 1, 0);
+    for (vcl_size_t p=0; p<num_subdomains; ++p)
+    {
+      sd.subdomain_buffer_[p+1] = sd.subdomain_buffer_[p] + static_cast<unsigned int>(nodes[p].size());
+      nnz_offsets[p+1]          = nnz_offsets[p]          + static_cast<unsigned int>(LU_elements[p].size());
+    }
+
+    vcl_size_t total_size = sd.subdomain_buffer_[num_subdomains];
+    sd.nodes_.resize(total_size);
+    sd.row_buffer_.resize(total_size + 1);
+    sd.col_buffer_.resize(nnz_offsets[num_subdomains]);
+    sd.elements_.resize(nnz_offsets[num_subdomains]);
+    sd.row_buffer_[total_size] = nnz_offsets[num_subdomains];
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for
+#endif
+    for (long p2=0; p2<static_cast<long>(num_subdomains); ++p2)
+    {
+      vcl_size_t p = static_cast<vcl_size_t>(p2);
+      unsigned int offset = sd.subdomain_buffer_[p];
+
+      for (vcl_size_t k=0; k<nodes[p].size(); ++k)
+      {
+        sd.nodes_[offset + k]      = nodes[p][k];
+        sd.row_buffer_[offset + k] = nnz_offsets[p] + LU_row_buffers[p][k];
+      }
+      std::copy(LU_col_buffers[p].begin(), LU_col_buffers[p].end(), sd.col_buffer_.begin() + nnz_offsets[p]);
+      std::copy(LU_elements[p].begin(),    LU_elements[p].end(),    sd.elements_.begin()   + nnz_offsets[p]);
+
+      std::vector<unsigned int>().swap(LU_row_buffers[p]);
+      std::vector<unsigned int>().swap(LU_col_buffers[p]);
+      std::vector<NumericT>().swap(LU_elements[p]);
+    }
+
+    // Step 3: local unknowns contributing to each global unknown:
+    sd.node_buffer_.assign(size + 1, 0);
+    for (vcl_size_t p=0; p<num_subdomains; ++p)
+      for (unsigned int k=sd.subdomain_buffer_[p]; k<sd.subdomain_buffer_[p+1]; ++k)
+        if (!tag.restricted() || part[sd.nodes_[k]] == p)
+          ++sd.node_buffer_[sd.nodes_[k] + 1];
+    for (vcl_size_t i=0; i<size; ++i)
+      sd.node_buffer_[i+1] += sd.node_buffer_[i];
+
+    sd.node_positions_.resize(sd.node_buffer_[size]);
+    std::vector<unsigned int> pos(sd.node_buffer_.begin(), sd.node_buffer_.end() - 1);
+    for (vcl_size_t p=0; p<num_subdomains; ++p)
+      for (unsigned int k=sd.subdomain_buffer_[p]; k<sd.subdomain_buffer_[p+1]; ++k)
+        if (!tag.restricted() || part[sd.nodes_[k]] == p)
+          sd.node_positions_[pos[sd.nodes_[k]]++] = k;
+  }
+
+  /** @brief Applies the Schwarz preconditioner: Solves with the incomplete factors on all subdomains concurrently, then combines the subdomain results.
+  *
+  * @param sd     The subdomains
+  * @param vec    The vector the preconditioner is applied to
+  * @param work   Work buffer holding the local unknowns of all subdomains
+  */
+  template<typename NumericT, typename VectorT>
+  void schwarz_apply(schwarz_subdomains<NumericT> const & sd, VectorT & vec, std::vector<NumericT> & work)
+  {
+    if (sd.size_ == 0)
+      return;
+
+    viennacl::detail::host_context_scope scope(sd.ram_ctx_);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for (long p2=0; p2<static_cast<long>(sd.num_subdomains()); ++p2)
+    {
+      vcl_size_t p = static_cast<vcl_size_t>(p2);
+      unsigned int offset   = sd.subdomain_buffer_[p];
+      unsigned int sub_size = sd.subdomain_buffer_[p+1] - offset;
+      if (sub_size == 0)
+        continue;
+
+      NumericT * sub_vec = &(work[offset]);
+      for (unsigned int k=0; k<sub_size; ++k)
+        sub_vec[k] = vec[sd.nodes_[offset + k]];
+
+      unsigned int const * row_buffer = &(sd.row_buffer_[offset]);
+      unsigned int const * col_buffer = sd.col_buffer_.size() > 0 ? &(sd.col_buffer_[0]) : NULL;
+      NumericT     const * elements   = sd.elements_.size() > 0 ? &(sd.elements_[0]) : NULL;
+
+      viennacl::linalg::host_based::detail::csr_inplace_solve<NumericT>(row_buffer, col_buffer, elements, sub_vec, sub_size, unit_lower_tag());
+      viennacl::linalg::host_based::detail::csr_inplace_solve<NumericT>(row_buffer, col_buffer, elements, sub_vec, sub_size, upper_tag());
+    }
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for
+#endif
+    for (long i2=0; i2<static_cast<long>(sd.size_); ++i2)
+    {
+      vcl_size_t i = static_cast<vcl_size_t>(i2);
+      NumericT sum = 0;
+      for (unsigned int k=sd.node_buffer_[i]; k<sd.node_buffer_[i+1]; ++k)
+        sum += work[sd.node_positions_[k]];
+      vec[i] = sum;
+    }
+  }
+
 } // namespace detail
 
 
@@ -173,8 +603,15 @@ public:
   template<typename VectorT>
   void apply(VectorT & vec) const
   {
-    for (vcl_size_t i=0; i<block_indices_.size(); ++i)
+    viennacl::detail::host_context_scope scope(NULL);
+
+    // Blocks are disjoint, hence they are solved concurrently:
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for
+#endif
+    for (long i2=0; i2<static_cast<long>(block_indices_.size()); ++i2)
     {
+      vcl_size_t i = static_cast<vcl_size_t>(i2);
       detail::ilu_vector_range<VectorT, ScalarType>  vec_range(vec, block_indices_[i].first, LU_blocks[i].size2());
 
       unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LU_blocks[i].handle1());
@@ -195,6 +632,7 @@ private:
     viennacl::copy(A, mat);
 
     unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(mat.handle1());
+    viennacl::detail::host_context_scope scope(NULL);
 
 #ifdef VIENNACL_WITH_OPENMP
     #pragma omp parallel for
@@ -327,6 +765,9 @@ private:
 
     unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(mat.handle1());
 
+    // the blocks are factored by the thread team of the system matrix:
+    viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(A));
+
 #ifdef VIENNACL_WITH_OPENMP
     #pragma omp parallel for
 #endif
@@ -446,13 +887,141 @@ private:
 };
 
 
-}
-}
+/** @brief Overlapping (restricted) additive Schwarz preconditioner with an incomplete LU factorization on each subdomain, can be supplied to solve()-routines.
+*
+* Subdomains are obtained from a partition of the graph of the system matrix and extended by the number of overlap layers specified in the schwarz_tag.
+* Setup and application are carried out on the host, one subdomain per thread.
+*
+* @tparam MatrixT   Type of the system matrix
+* @tparam ILUTagT   Type of the tag identifiying the ILU preconditioner to be used on each subdomain (either ilu0_tag or ilut_tag)
+*/
+template<typename MatrixT, typename ILUTagT>
+class schwarz_precond
+{
+  typedef typename MatrixT::value_type      NumericType;
 
+public:
+  schwarz_precond(MatrixT const & mat,
+                  ILUTagT const & ilu_tag,
+                  schwarz_tag const & tag = schwarz_tag()
+                 ) : tag_(tag), ilu_tag_(ilu_tag)
+  {
+    init(mat);
+  }
 
+  template<typename VectorT>
+  void apply(VectorT & vec) const
+  {
+    detail::schwarz_apply(subdomains_, vec, work_);
+  }
 
+  /** @brief Returns the number of subdomains */
+  vcl_size_t num_subdomains() const { return subdomains_.num_subdomains(); }
 
-#endif
+private:
+  void init(MatrixT const & mat)
+  {
+    viennacl::context host_context(viennacl::MAIN_MEMORY);
+    viennacl::compressed_matrix<NumericType> temp(host_context);
+    viennacl::copy(mat, temp);
+
+    viennacl::detail::host_context_scope scope(NULL);
+    detail::schwarz_setup(viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(temp.handle1()),
+                          viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(temp.handle2()),
+                          viennacl::linalg::host_based::detail::extract_raw_pointer<NumericType>(temp.handle()),
+                          temp.size1(), tag_, ilu_tag_, subdomains_);
+    work_.resize(subdomains_.nodes_.size());
+  }
+
+  schwarz_tag tag_;
+  ILUTagT ilu_tag_;
+  detail::schwarz_subdomains<NumericType> subdomains_;
+  mutable std::vector<NumericType> work_;
+};
+
+
+/** @brief Overlapping (restricted) additive Schwarz preconditioner class, can be supplied to solve()-routines.
+*
+*  Specialization for compressed_matrix. Vectors not residing in main memory are temporarily migrated to the host.
+*/
+template<typename NumericT, unsigned int AlignmentV, typename ILUTagT>
+class schwarz_precond< compressed_matrix<NumericT, AlignmentV>, ILUTagT>
+{
+  typedef compressed_matrix<NumericT, AlignmentV>        MatrixType;
+
+public:
+  schwarz_precond(MatrixType const & mat,
+                  ILUTagT const & ilu_tag,
+                  schwarz_tag const & tag = schwarz_tag()
+                 ) : tag_(tag), ilu_tag_(ilu_tag)
+  {
+    init(mat);
+  }
+
+  void apply(vector<NumericT> & vec) const
+  {
+    if (viennacl::traits::context(vec).memory_type() != viennacl::MAIN_MEMORY)
+    {
+      viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+      viennacl::context old_ctx = viennacl::traits::context(vec);
+
+      viennacl::switch_memory_context(vec, host_ctx);
+      apply_host(vec);
+      viennacl::switch_memory_context(vec, old_ctx);
+    }
+    else
+      apply_host(vec);
+  }
 
+  /** @brief Returns the number of subdomains */
+  vcl_size_t num_subdomains() const { return subdomains_.num_subdomains(); }
 
+private:
+  void apply_host(vector<NumericT> & vec) const
+  {
+    NumericT * data = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(vec.handle()) + vec.start();
+    if (vec.stride() == 1)
+      detail::schwarz_apply(subdomains_, data, work_);
+    else
+    {
+      // Strided vectors are gathered into a contiguous buffer allocated in init()
+      for (vcl_size_t i=0; i<vec.size(); ++i)
+        temp_[i] = data[i * vec.stride()];
+      detail::schwarz_apply(subdomains_, temp_, work_);
+      for (vcl_size_t i=0; i<vec.size(); ++i)
+        data[i * vec.stride()] = temp_[i];
+    }
+  }
 
+  void init(MatrixType const & mat)
+  {
+    viennacl::context host_context(viennacl::MAIN_MEMORY);
+    viennacl::compressed_matrix<NumericT> temp(mat.size1(), mat.size2(), viennacl::traits::context(mat));
+    viennacl::switch_memory_context(temp, host_context);
+    temp = mat;
+
+    // the number of subdomains defaults to the size of the thread team of the system matrix, which also applies the preconditioner:
+    subdomains_.ram_ctx_ = viennacl::traits::ram_context(mat);
+    viennacl::detail::host_context_scope scope(subdomains_.ram_ctx_);
+    detail::schwarz_setup(viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(temp.handle1()),
+                          viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(temp.handle2()),
+                          viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(temp.handle()),
+                          temp.size1(), tag_, ilu_tag_, subdomains_);
+    work_.resize(subdomains_.nodes_.size());
+    temp_.resize(temp.size1());
+  }
+
+  schwarz_tag tag_;
+  ILUTagT ilu_tag_;
+  detail::schwarz_subdomains<NumericT> subdomains_;
+  mutable std::vector<NumericT> work_;
+  mutable std::vector<NumericT> temp_;
+};
+
+}
+}
+
+
+
+
+#endif
@@ -0,0 +1,104 @@
+#ifndef VIENNACL_LINALG_DETAIL_ITERATIVE_SOLVER_SUPPORT_HPP
+#define VIENNACL_LINALG_DETAIL_ITERATIVE_SOLVER_SUPPORT_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/detail/iterative_solver_support.hpp
+ *
+ * @brief Helpers shared by the solver objects of the iterative solvers: persistent buffers and monitor callbacks.
+*/
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/context.hpp"
+#include "viennacl/meta/result_of.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace detail
+{
+
+/** @brief Makes 'vec' a buffer of the same size as 'ref'. Generic vector types are assigned if the sizes differ. */
+template<typename VectorT>
+void prepare_workspace_vector(VectorT & vec, VectorT const & ref)
+{
+  if (viennacl::traits::size(vec) != viennacl::traits::size(ref))
+    vec = ref;
+}
+
+/** @brief Makes 'vec' a buffer with 'size' entries in the memory domain of 'ctx'. Memory is only allocated if the size or the memory domain changes; new buffers are zero-initialized. */
+template<typename NumericT>
+void prepare_workspace_vector(viennacl::vector<NumericT> & vec, vcl_size_t size, viennacl::context const & ctx)
+{
+  if (vec.size() > 0 && viennacl::traits::active_handle_id(vec) != ctx.memory_type())
+    vec.switch_memory_context(ctx);
+  if (vec.size() != size)
+    vec.resize(size, ctx, false);
+}
+
+/** @brief Makes 'vec' a buffer of the same size and in the same memory domain as 'ref' */
+template<typename NumericT>
+void prepare_workspace_vector(viennacl::vector<NumericT> & vec, viennacl::vector<NumericT> const & ref)
+{
+  prepare_workspace_vector(vec, ref.size(), viennacl::traits::context(ref));
+}
+
+
+/** @brief A monitor callback of a solver object, which is called with the current approximation of the solution and the estimated relative residual.
+*
+* The solver run is stopped if the callback returns true. No callback is set by default.
+*/
+template<typename VectorT>
+class solver_monitor
+{
+public:
+  typedef typename viennacl::result_of::cpu_value_type<typename viennacl::result_of::value_type<VectorT>::type>::type   numeric_type;
+  typedef bool (*callback_type)(VectorT const &, numeric_type, void *);
+
+  solver_monitor() : callback_(NULL), user_data_(NULL) {}
+
+  /** @brief Sets the callback and the user data passed to each call of the callback */
+  void set(callback_type callback, void * user_data)
+  {
+    callback_  = callback;
+    user_data_ = user_data;
+  }
+
+  /** @brief Returns true if a callback is set. Solvers which need extra work for providing the current solution (e.g. GMRES) skip it otherwise. */
+  bool is_set() const { return callback_ != NULL; }
+
+  /** @brief Calls the callback if there is one. Returns true if the solver is requested to stop. */
+  bool operator()(VectorT const & current_solution, numeric_type relative_residual) const
+  {
+    return callback_ && callback_(current_solution, relative_residual, user_data_);
+  }
+
+private:
+  callback_type callback_;
+  void * user_data_;
+};
+
+} //namespace detail
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -0,0 +1,314 @@
+#ifndef VIENNACL_LINALG_DETAIL_KRYLOV_RECYCLING_HPP
+#define VIENNACL_LINALG_DETAIL_KRYLOV_RECYCLING_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/detail/krylov_recycling.hpp
+ *
+ * @brief Helpers of the Krylov solvers with subspace recycling (deflated CG, GCRO-DR).
+ *
+ * The recycle spaces and Krylov bases are column-major ViennaCL matrices, such that projections are dense matrix-vector or matrix-matrix products.
+ * The small projected problems are dense column-major arrays on the host and are solved by the Householder routines of the QR method.
+*/
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/traits/context.hpp"
+#include "viennacl/linalg/qr-method-reduction.hpp"
+#include "viennacl/linalg/tridiag_eig.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace detail
+{
+
+/** @brief Makes 'M' a column-major rows x cols matrix in the memory domain of 'ctx'. Memory is only allocated if the size or the memory domain changes, in which case the entries are not preserved. */
+template<typename NumericT>
+void prepare_workspace_matrix(viennacl::matrix<NumericT, viennacl::column_major> & M, vcl_size_t rows, vcl_size_t cols, viennacl::context const & ctx)
+{
+  if (M.size1() != rows || M.size2() != cols)
+    M.resize(rows, cols, false);
+  if (viennacl::traits::active_handle_id(M) != ctx.memory_type())
+    viennacl::backend::switch_memory_context<NumericT>(M.handle(), ctx);
+}
+
+/** @brief Cholesky factorization A = L * L^T of a small symmetric positive definite column-major host matrix. L overwrites the lower triangle of A.
+*
+* @return false if A is not numerically positive definite
+*/
+template<typename NumericT>
+bool recycling_cholesky(vcl_size_t n, NumericT * A, vcl_size_t lda)
+{
+  for (vcl_size_t j = 0; j < n; ++j)
+  {
+    NumericT diag = A[j + j * lda];
+    for (vcl_size_t l = 0; l < j; ++l)
+      diag -= A[j + l * lda] * A[j + l * lda];
+    if (!(diag > 0))
+      return false;
+    diag = std::sqrt(diag);
+    A[j + j * lda] = diag;
+
+    for (vcl_size_t i = j + 1; i < n; ++i)
+    {
+      NumericT value = A[i + j * lda];
+      for (vcl_size_t l = 0; l < j; ++l)
+        value -= A[i + l * lda] * A[j + l * lda];
+      A[i + j * lda] = value / diag;
+    }
+  }
+  return true;
+}
+
+/** @brief Solves L * X = B (transposed == false) or L^T * X = B (transposed == true) in place for the lower triangular factor L computed by recycling_cholesky() */
+template<typename NumericT>
+void recycling_cholesky_trsm(bool transposed, vcl_size_t n, NumericT const * L, vcl_size_t ldl, vcl_size_t nrhs, NumericT * B, vcl_size_t ldb)
+{
+  for (vcl_size_t c = 0; c < nrhs; ++c)
+  {
+    NumericT * b = B + c * ldb;
+    if (!transposed)
+    {
+      for (vcl_size_t i = 0; i < n; ++i)
+      {
+        NumericT value = b[i];
+        for (vcl_size_t l = 0; l < i; ++l)
+          value -= L[i + l * ldl] * b[l];
+        b[i] = value / L[i + i * ldl];
+      }
+    }
+    else
+    {
+      for (vcl_size_t i = n; i-- > 0; )
+      {
+        NumericT value = b[i];
+        for (vcl_size_t l = i + 1; l < n; ++l)
+          value -= L[l + i * ldl] * b[l];
+        b[i] = value / L[i + i * ldl];
+      }
+    }
+  }
+}
+
+/** @brief Householder QR factorization of the m x n (m >= n) column-major host matrix A.
+*
+* On exit, R is stored in the upper triangle of A, and reflector j has its head at row j and its trailing part in A(j+1:m, j).
+*/
+template<typename NumericT>
+void recycling_qr(vcl_size_t m, vcl_size_t n, NumericT * A, vcl_size_t lda, std::vector<NumericT> & tau)
+{
+  tau.resize(n);
+  for (vcl_size_t j = 0; j < n; ++j)
+  {
+    NumericT * v = A + j + j * lda;
+    tau[j] = reduction_householder(m - j, v[0], v + 1);
+    if (tau[j] == 0)
+      continue;
+
+    for (vcl_size_t c = j + 1; c < n; ++c)
+    {
+      NumericT * a = A + j + c * lda;
+      NumericT dot = a[0];
+      for (vcl_size_t i = 1; i < m - j; ++i)
+        dot += v[i] * a[i];
+      dot *= tau[j];
+      a[0] -= dot;
+      for (vcl_size_t i = 1; i < m - j; ++i)
+        a[i] -= dot * v[i];
+    }
+  }
+}
+
+/** @brief Applies Q^T (transposed == true) or Q of a factorization computed by recycling_qr() to the columns of the m x nrhs matrix B */
+template<typename NumericT>
+void recycling_apply_q(bool transposed, vcl_size_t m, vcl_size_t n, NumericT const * A, vcl_size_t lda, std::vector<NumericT> const & tau,
+                       vcl_size_t nrhs, NumericT * B, vcl_size_t ldb)
+{
+  for (vcl_size_t c = 0; c < nrhs; ++c)
+  {
+    NumericT * b = B + c * ldb;
+    for (vcl_size_t jj = 0; jj < n; ++jj)
+    {
+      vcl_size_t j = transposed ? jj : n - jj - 1;
+      NumericT const * v = A + j + j * lda;
+      NumericT dot = b[j];
+      for (vcl_size_t i = 1; i < m - j; ++i)
+        dot += v[i] * b[j + i];
+      dot *= tau[j];
+      b[j] -= dot;
+      for (vcl_size_t i = 1; i < m - j; ++i)
+        b[j + i] -= dot * v[i];
+    }
+  }
+}
+
+/** @brief Returns the thin m x n factor Q of a factorization computed by recycling_qr() as a column-major host array */
+template<typename NumericT>
+std::vector<NumericT> recycling_thin_q(vcl_size_t m, vcl_size_t n, NumericT const * A, vcl_size_t lda, std::vector<NumericT> const & tau)
+{
+  std::vector<NumericT> Q(m * n);
+  for (vcl_size_t j = 0; j < n; ++j)
+    Q[j + j * m] = NumericT(1);
+  recycling_apply_q(false, m, n, A, lda, tau, n, &Q[0], m);
+  return Q;
+}
+
+/** @brief Computes the 'k' smallest harmonic Ritz pairs of the symmetric positive definite generalized eigenvalue problem F y = theta G y, where both F and G are symmetric positive definite s x s host matrices.
+*
+* G = L L^T is factored, the symmetric problem L^{-1} F L^{-T} u = theta u is solved via tridiagonal reduction, and y = L^{-T} u.
+*
+* @return false if G is not numerically positive definite
+*/
+template<typename NumericT>
+bool recycling_harmonic_ritz_spd(vcl_size_t s, std::vector<NumericT> const & F, std::vector<NumericT> G, vcl_size_t k, std::vector<NumericT> & Y)
+{
+  if (!recycling_cholesky(s, &G[0], s))
+    return false;
+
+  // S = L^{-1} F L^{-T}:
+  std::vector<NumericT> S(F);
+  recycling_cholesky_trsm(false, s, &G[0], s, s, &S[0], s);
+  for (vcl_size_t i = 0; i < s; ++i)     // S <- S^T, so that the second solve acts on the rows
+    for (vcl_size_t j = i + 1; j < s; ++j)
+      std::swap(S[i + j * s], S[j + i * s]);
+  recycling_cholesky_trsm(false, s, &G[0], s, s, &S[0], s);
+
+  // eigenpairs of S via the reduction to tridiagonal form of the QR method:
+  std::vector<NumericT> d, e, tau;
+  tridiagonal_reduction_blocked(s, &S[0], s, d, e, tau);
+  std::vector<NumericT> Q(s * s);
+  Q[0] = NumericT(1);
+  if (s > 1)
+    reduction_form_q(s - 1, s - 1, &S[1], s, &tau[0], &Q[1 + s], s);
+
+  std::vector<NumericT> E(s);
+  for (vcl_size_t i = 1; i < s; ++i)
+    E[i] = e[i - 1];
+  std::vector<NumericT> eigenvalues, eigenvectors;
+  viennacl::linalg::tridiag_eig_tag eig_tag;
+  eig_tag.set_index_range(0, k);
+  viennacl::linalg::tridiag_eig(d, E, eigenvalues, eigenvectors, eig_tag);
+
+  Y.resize(s * k);
+  reduction_gemm(false, false, s, k, s, NumericT(1), &Q[0], s, &eigenvectors[0], s, NumericT(0), &Y[0], s);
+  recycling_cholesky_trsm(true, s, &G[0], s, k, &Y[0], s);
+  return true;
+}
+
+/** @brief C = A * B for small column-major host matrices (m x l times l x n), for which the blocked host matrix-matrix product does not pay off */
+template<typename NumericT>
+void recycling_small_gemm(vcl_size_t m, vcl_size_t n, vcl_size_t l, NumericT const * A, NumericT const * B, NumericT * C)
+{
+  for (vcl_size_t j = 0; j < n; ++j)
+  {
+    NumericT * c = C + j * m;
+    std::fill(c, c + m, NumericT(0));
+    for (vcl_size_t p = 0; p < l; ++p)
+    {
+      NumericT b = B[p + j * l];
+      NumericT const * a = A + p * m;
+      for (vcl_size_t i = 0; i < m; ++i)
+        c[i] += a[i] * b;
+    }
+  }
+}
+
+/** @brief Computes a basis of the invariant subspace belonging to at most 'k' harmonic Ritz values of smallest magnitude of the generalized eigenvalue problem F y = theta B y,
+*          where F is a symmetric positive definite s x s host matrix and B is a general s x s host matrix.
+*
+* The subspace is obtained by orthogonal iteration with F^{-1} B, so complex conjugate pairs of harmonic Ritz values are represented by a real basis.
+* The leading j columns of the iterate converge to an invariant subspace only if the j-th and the (j+1)-th harmonic Ritz values differ in magnitude,
+* which fails if the k-th value is one half of a complex conjugate pair. In that case the largest leading block which is close to convergence is returned instead.
+* A recycle space does not need to be accurate, so the iteration stops at a moderate tolerance. The returned basis is orthonormal.
+*
+* @return The number of columns of the basis 'Y', or zero if F is not numerically positive definite
+*/
+template<typename NumericT>
+vcl_size_t recycling_harmonic_ritz(vcl_size_t s, std::vector<NumericT> F, std::vector<NumericT> const & B, vcl_size_t k, std::vector<NumericT> & Y)
+{
+  if (k == 0 || !recycling_cholesky(s, &F[0], s))
+    return 0;
+
+  // T = F^{-1} B
+  std::vector<NumericT> T(B);
+  recycling_cholesky_trsm(false, s, &F[0], s, s, &T[0], s);
+  recycling_cholesky_trsm(true,  s, &F[0], s, s, &T[0], s);
+
+  // deterministic start basis with components in all directions:
+  Y.resize(s * k);
+  for (vcl_size_t j = 0; j < k; ++j)
+    for (vcl_size_t i = 0; i < s; ++i)
+      Y[i + j * s] = (i == j) ? NumericT(1) : NumericT(0.01) * std::sin(NumericT(1 + i + j * s));
+
+  // block_error[j]: distance of the leading j+1 columns of T Y from the span of the leading j+1 columns of Y
+  std::vector<NumericT> Z(s * k), residual(s), block_error(k), tau;
+  NumericT tolerance = std::max<NumericT>(NumericT(1e-6), std::sqrt(std::numeric_limits<NumericT>::epsilon()));
+  for (vcl_size_t iter = 0; iter < 4 * s + 50; ++iter)
+  {
+    // Z = T Y, orthonormalized:
+    recycling_small_gemm(s, k, s, &T[0], &Y[0], &Z[0]);
+    recycling_qr(s, k, &Z[0], s, tau);
+    Z = recycling_thin_q(s, k, &Z[0], s, tau);
+
+    // Project column l of Z onto Y(:, 0), Y(:, 1), ... in turn. After the projection onto the leading j+1 columns, the remainder contributes to block_error[j] for all j >= l:
+    std::fill(block_error.begin(), block_error.end(), NumericT(0));
+    for (vcl_size_t l = 0; l < k; ++l)
+    {
+      std::copy(Z.begin() + static_cast<long>(l * s), Z.begin() + static_cast<long>((l + 1) * s), residual.begin());
+      for (vcl_size_t j = 0; j < k; ++j)
+      {
+        NumericT dot = 0;
+        for (vcl_size_t i = 0; i < s; ++i)
+          dot += Y[i + j * s] * Z[i + l * s];
+        NumericT remainder = 0;
+        for (vcl_size_t i = 0; i < s; ++i)
+        {
+          residual[i] -= Y[i + j * s] * dot;
+          remainder = std::max<NumericT>(remainder, std::fabs(residual[i]));
+        }
+        if (j >= l)
+          block_error[j] = std::max(block_error[j], remainder);
+      }
+    }
+
+    Y.swap(Z);
+    if (block_error[k - 1] < tolerance)
+      return k;
+  }
+
+  // no convergence of the full block: use the largest leading block which is close to an invariant subspace, if any
+  for (vcl_size_t j = k - 1; j > 0; --j)
+    if (block_error[j - 1] < std::sqrt(tolerance))
+      return j;
+  return k;
+}
+
+} //namespace detail
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
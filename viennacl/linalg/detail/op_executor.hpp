@@ -51,6 +51,20 @@ bool op_aliasing(vector_base<NumericT> const & lhs, vector_expression<const LhsT
 }
 
 
+/** @brief Returns true if 'b' is exactly the vector 'lhs' (same buffer, offset, stride and size), so that x = x + expr can be evaluated as x += expr. */
+template<typename NumericT, typename B>
+bool op_identical(vector_base<NumericT> const & /*lhs*/, B const & /*b*/)
+{
+  return false;
+}
+
+template<typename NumericT>
+bool op_identical(vector_base<NumericT> const & lhs, vector_base<NumericT> const & b)
+{
+  return lhs.handle() == b.handle() && lhs.start() == b.start() && lhs.stride() == b.stride() && lhs.size() == b.size();
+}
+
+
 template<typename NumericT, typename B>
 bool op_aliasing(matrix_base<NumericT> const & /*lhs*/, B const & /*b*/)
 {
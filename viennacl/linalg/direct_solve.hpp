@@ -66,8 +66,11 @@ namespace detail
     switch (viennacl::traits::handle(A).get_active_handle_id())
     {
       case viennacl::MAIN_MEMORY:
+      {
+        viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(A));
         viennacl::linalg::host_based::inplace_solve(A, const_cast<matrix_base<NumericT> &>(B), SolverTagT());
         break;
+      }
   #ifdef VIENNACL_WITH_OPENCL
       case viennacl::OPENCL_MEMORY:
         viennacl::linalg::opencl::inplace_solve(A, const_cast<matrix_base<NumericT> &>(B), SolverTagT());
@@ -101,8 +104,11 @@ namespace detail
     switch (viennacl::traits::handle(mat).get_active_handle_id())
     {
       case viennacl::MAIN_MEMORY:
+      {
+        viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(mat));
         viennacl::linalg::host_based::inplace_solve(mat, const_cast<vector_base<NumericT> &>(vec), SolverTagT());
         break;
+      }
   #ifdef VIENNACL_WITH_OPENCL
       case viennacl::OPENCL_MEMORY:
         viennacl::linalg::opencl::inplace_solve(mat, const_cast<vector_base<NumericT> &>(vec), SolverTagT());
@@ -57,8 +57,11 @@ void direct(viennacl::vector<NumericT, AlignmentV> const & in,
   switch (viennacl::traits::handle(in).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
+  {
+    viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(in));
     viennacl::linalg::host_based::direct(in, out, size, stride, batch_num, sign, data_order);
     break;
+  }
 #ifdef VIENNACL_WITH_OPENCL
   case viennacl::OPENCL_MEMORY:
     viennacl::linalg::opencl::direct(viennacl::traits::opencl_handle(in), viennacl::traits::opencl_handle(out), size, stride, batch_num, sign,data_order);
@@ -95,8 +98,11 @@ void direct(viennacl::matrix<NumericT, viennacl::row_major, AlignmentV> const &
   switch (viennacl::traits::handle(in).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
+  {
+    viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(in));
     viennacl::linalg::host_based::direct(in, out, size, stride, batch_num, sign, data_order);
     break;
+  }
 #ifdef VIENNACL_WITH_OPENCL
   case viennacl::OPENCL_MEMORY:
     viennacl::linalg::opencl::direct(viennacl::traits::opencl_handle(in), viennacl::traits::opencl_handle(out), size, stride, batch_num, sign,data_order);
@@ -129,8 +135,11 @@ void reorder(viennacl::vector<NumericT, AlignmentV>& in, vcl_size_t size, vcl_si
   switch (viennacl::traits::handle(in).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
+  {
+    viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(in));
     viennacl::linalg::host_based::reorder(in, size, stride, bits_datasize, batch_num, data_order);
     break;
+  }
 #ifdef VIENNACL_WITH_OPENCL
   case viennacl::OPENCL_MEMORY:
     viennacl::linalg::opencl::reorder<NumericT>(viennacl::traits::opencl_handle(in), size, stride, bits_datasize, batch_num, data_order);
@@ -166,8 +175,11 @@ void radix2(viennacl::matrix<NumericT, viennacl::row_major, AlignmentV> & in, vc
   switch (viennacl::traits::handle(in).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
+  {
+    viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(in));
     viennacl::linalg::host_based::radix2(in, size, stride, batch_num, sign, data_order);
     break;
+  }
 #ifdef VIENNACL_WITH_OPENCL
   case viennacl::OPENCL_MEMORY:
     viennacl::linalg::opencl::radix2(viennacl::traits::opencl_handle(in), size, stride, batch_num, sign,data_order);
@@ -203,8 +215,11 @@ void radix2(viennacl::vector<NumericT, AlignmentV>& in, vcl_size_t size, vcl_siz
   switch (viennacl::traits::handle(in).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
+  {
+    viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(in));
     viennacl::linalg::host_based::radix2(in, size, stride, batch_num, sign, data_order);
     break;
+  }
 #ifdef VIENNACL_WITH_OPENCL
   case viennacl::OPENCL_MEMORY:
     viennacl::linalg::opencl::radix2(viennacl::traits::opencl_handle(in), size, stride, batch_num, sign,data_order);
@@ -239,8 +254,11 @@ void bluestein(viennacl::vector<NumericT, AlignmentV> & in,
   switch (viennacl::traits::handle(in).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
+  {
+    viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(in));
     viennacl::linalg::host_based::bluestein(in, out, 1);
     break;
+  }
 #ifdef VIENNACL_WITH_OPENCL
   case viennacl::OPENCL_MEMORY:
     viennacl::linalg::opencl::bluestein(in, out, 1);
@@ -271,8 +289,11 @@ void multiply_complex(viennacl::vector<NumericT, AlignmentV> const & input1,
   switch (viennacl::traits::handle(input1).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
+  {
+    viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(input1));
     viennacl::linalg::host_based::multiply_complex(input1, input2, output);
     break;
+  }
 #ifdef VIENNACL_WITH_OPENCL
   case viennacl::OPENCL_MEMORY:
     viennacl::linalg::opencl::multiply_complex(input1, input2, output);
@@ -301,8 +322,11 @@ void normalize(viennacl::vector<NumericT, AlignmentV> & input)
   switch (viennacl::traits::handle(input).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
+  {
+    viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(input));
     viennacl::linalg::host_based::normalize(input);
     break;
+  }
 #ifdef VIENNACL_WITH_OPENCL
   case viennacl::OPENCL_MEMORY:
     viennacl::linalg::opencl::normalize(input);
@@ -331,8 +355,11 @@ void transpose(viennacl::matrix<NumericT, viennacl::row_major, AlignmentV> & inp
   switch (viennacl::traits::handle(input).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
+  {
+    viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(input));
     viennacl::linalg::host_based::transpose(input);
     break;
+  }
 #ifdef VIENNACL_WITH_OPENCL
   case viennacl::OPENCL_MEMORY:
     viennacl::linalg::opencl::transpose(input);
@@ -362,8 +389,11 @@ void transpose(viennacl::matrix<NumericT, viennacl::row_major, AlignmentV> const
   switch (viennacl::traits::handle(input).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
+  {
+    viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(input));
     viennacl::linalg::host_based::transpose(input, output);
     break;
+  }
 #ifdef VIENNACL_WITH_OPENCL
   case viennacl::OPENCL_MEMORY:
     viennacl::linalg::opencl::transpose(input, output);
@@ -393,8 +423,11 @@ void real_to_complex(viennacl::vector_base<NumericT> const & in,
   switch (viennacl::traits::handle(in).get_active_handle_id())
   {
     case viennacl::MAIN_MEMORY:
+    {
+      viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(in));
       viennacl::linalg::host_based::real_to_complex(in, out, size);
       break;
+    }
 #ifdef VIENNACL_WITH_OPENCL
       case viennacl::OPENCL_MEMORY:
       viennacl::linalg::opencl::real_to_complex(in,out,size);
@@ -424,8 +457,11 @@ void complex_to_real(viennacl::vector_base<NumericT> const & in,
   switch (viennacl::traits::handle(in).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
+  {
+    viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(in));
     viennacl::linalg::host_based::complex_to_real(in, out, size);
     break;
+  }
 #ifdef VIENNACL_WITH_OPENCL
   case viennacl::OPENCL_MEMORY:
     viennacl::linalg::opencl::complex_to_real(in, out, size);
@@ -454,8 +490,11 @@ void reverse(viennacl::vector_base<NumericT> & in)
   switch (viennacl::traits::handle(in).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
+  {
+    viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(in));
     viennacl::linalg::host_based::reverse(in);
     break;
+  }
 #ifdef VIENNACL_WITH_OPENCL
   case viennacl::OPENCL_MEMORY:
     viennacl::linalg::opencl::reverse(in);
@@ -0,0 +1,473 @@
+#ifndef VIENNACL_LINALG_GAUSS_SEIDEL_HPP_
+#define VIENNACL_LINALG_GAUSS_SEIDEL_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/gauss_seidel.hpp
+  @brief Implementations of multicolor Gauss-Seidel, SOR and SSOR preconditioners on the host.
+
+  The rows of the system matrix are colored in parallel such that no two rows of the same color are coupled.
+  All rows of one color are then updated in parallel. Rows are stored in the order of their colors, so that each color is a contiguous block of the matrix.
+*/
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "viennacl/forwards.h"
+#include "viennacl/tools/tools.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+
+#include "viennacl/linalg/host_based/common.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+
+/** @brief A tag for multicolor Gauss-Seidel type preconditioners: Gauss-Seidel (omega = 1), SOR (omega != 1), and their symmetric variants.
+*/
+class gauss_seidel_tag
+{
+public:
+  /** @brief The constructor.
+  *
+  * @param omega       Relaxation parameter. omega = 1 results in Gauss-Seidel, other values in SOR. Must be in (0, 2).
+  * @param symmetric   If true, each sweep consists of a forward and a backward sweep (SGS/SSOR). Required for use with CG.
+  * @param sweeps      Number of sweeps per application of the preconditioner
+  */
+  gauss_seidel_tag(double omega = 1.0, bool symmetric = true, unsigned int sweeps = 1)
+    : omega_(omega), symmetric_(symmetric), sweeps_(sweeps) {}
+
+  double omega() const { return omega_; }
+  void omega(double w) { if (w > 0 && w < 2) omega_ = w; }
+
+  bool symmetric() const { return symmetric_; }
+  void symmetric(bool b) { symmetric_ = b; }
+
+  unsigned int sweeps() const { return sweeps_; }
+  void sweeps(unsigned int num) { if (num > 0) sweeps_ = num; }
+
+private:
+  double omega_;
+  bool symmetric_;
+  unsigned int sweeps_;
+};
+
+
+namespace detail
+{
+  /** @brief A CSR matrix with rows permuted by color, together with the inverse diagonal. Column indices refer to the original numbering of unknowns.
+  */
+  template<typename NumericT>
+  struct multicolor_csr
+  {
+    multicolor_csr() : size_(0) {}
+
+    vcl_size_t size_;
+    // color_buffer_[c] is the first (permuted) row of color c
+    std::vector<unsigned int> color_buffer_;
+    // Original index of each permuted row
+    std::vector<unsigned int> row_index_;
+    std::vector<unsigned int> row_buffer_;
+    std::vector<unsigned int> col_buffer_;
+    std::vector<NumericT>     elements_;
+    std::vector<NumericT>     diag_inv_;
+
+    vcl_size_t num_colors() const { return color_buffer_.size() - 1; }
+  };
+
+  /** @brief Pseudo-random priority of a row in the Jones-Plassmann coloring. Does not depend on the number of threads, hence the coloring is reproducible. */
+  inline unsigned int coloring_priority(unsigned int i)
+  {
+    unsigned int h = (i ^ 61u) ^ (i >> 16);
+    h *= 9u;
+    h ^= h >> 4;
+    h *= 0x27d4eb2du;
+    h ^= h >> 15;
+    return h;
+  }
+
+  /** @brief Returns true if row i is colored before its neighbor j in the Jones-Plassmann coloring. Ties of the priorities are broken by the row index. */
+  inline bool coloring_precedes(unsigned int i, unsigned int j)
+  {
+    unsigned int priority_i = coloring_priority(i);
+    unsigned int priority_j = coloring_priority(j);
+    return priority_i > priority_j || (priority_i == priority_j && i > j);
+  }
+
+  /** @brief Parallel distance-1 coloring of the symmetrized sparsity pattern of a CSR matrix (Jones-Plassmann).
+  *
+  * In each round, all uncolored rows with a higher priority than all of their uncolored neighbors form an independent set.
+  * These rows are colored in parallel with the smallest color not used by any of their neighbors.
+  *
+  * @param row_buffer  Row array of the matrix
+  * @param col_buffer  Column array of the matrix
+  * @param size        Number of rows (matrix must be square)
+  * @param colors      Color of each row (output)
+  * @return            Number of colors
+  */
+  inline unsigned int jones_plassmann_coloring(unsigned int const * row_buffer, unsigned int const * col_buffer, vcl_size_t size, std::vector<unsigned int> & colors)
+  {
+    unsigned int const none = static_cast<unsigned int>(-1);
+
+    // Transposed pattern, so that couplings in both directions are considered:
+    std::vector<unsigned int> trans_row_buffer(size + 1, 0);
+    std::vector<unsigned int> trans_col_buffer(row_buffer[size]);
+    for (unsigned int k=0; k<row_buffer[size]; ++k)
+      ++trans_row_buffer[col_buffer[k] + 1];
+    for (vcl_size_t i=0; i<size; ++i)
+      trans_row_buffer[i+1] += trans_row_buffer[i];
+    {
+      std::vector<unsigned int> pos(trans_row_buffer.begin(), trans_row_buffer.end() - 1);
+      for (vcl_size_t i=0; i<size; ++i)
+        for (unsigned int k=row_buffer[i]; k<row_buffer[i+1]; ++k)
+          trans_col_buffer[pos[col_buffer[k]]++] = static_cast<unsigned int>(i);
+    }
+
+    colors.assign(size, none);
+    std::vector<unsigned int> uncolored(size);
+    for (vcl_size_t i=0; i<size; ++i)
+      uncolored[i] = static_cast<unsigned int>(i);
+    std::vector<unsigned char> selected(size, 0);
+
+    while (!uncolored.empty())
+    {
+      long num_uncolored = static_cast<long>(uncolored.size());
+
+      // Phase 1: select the rows with the highest priority among their uncolored neighbors. Colors are only read.
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for
+#endif
+      for (long k2=0; k2<num_uncolored; ++k2)
+      {
+        unsigned int i = uncolored[static_cast<vcl_size_t>(k2)];
+        unsigned char is_max = 1;
+        for (unsigned int k=row_buffer[i]; k<row_buffer[i+1] && is_max; ++k)
+          if (col_buffer[k] != i && colors[col_buffer[k]] == none && coloring_precedes(col_buffer[k], i))
+            is_max = 0;
+        for (unsigned int k=trans_row_buffer[i]; k<trans_row_buffer[i+1] && is_max; ++k)
+          if (trans_col_buffer[k] != i && colors[trans_col_buffer[k]] == none && coloring_precedes(trans_col_buffer[k], i))
+            is_max = 0;
+        selected[i] = is_max;
+      }
+
+      // Phase 2: the selected rows are not coupled, hence the colors of their neighbors do not change while they are colored.
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel
+#endif
+      {
+        std::vector<unsigned int> neighbor_colors;
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp for
+#endif
+        for (long k2=0; k2<num_uncolored; ++k2)
+        {
+          unsigned int i = uncolored[static_cast<vcl_size_t>(k2)];
+          if (!selected[i])
+            continue;
+
+          neighbor_colors.clear();
+          for (unsigned int k=row_buffer[i]; k<row_buffer[i+1]; ++k)
+            if (colors[col_buffer[k]] != none)
+              neighbor_colors.push_back(colors[col_buffer[k]]);
+          for (unsigned int k=trans_row_buffer[i]; k<trans_row_buffer[i+1]; ++k)
+            if (colors[trans_col_buffer[k]] != none)
+              neighbor_colors.push_back(colors[trans_col_buffer[k]]);
+          std::sort(neighbor_colors.begin(), neighbor_colors.end());
+
+          unsigned int c = 0;
+          for (vcl_size_t j=0; j<neighbor_colors.size() && neighbor_colors[j] <= c; ++j)
+            if (neighbor_colors[j] == c)
+              ++c;
+          colors[i] = c;
+        }
+      }
+
+      vcl_size_t num_remaining = 0;
+      for (vcl_size_t k=0; k<uncolored.size(); ++k)
+        if (colors[uncolored[k]] == none)
+          uncolored[num_remaining++] = uncolored[k];
+      uncolored.resize(num_remaining);
+    }
+
+    unsigned int num_colors = 0;
+    for (vcl_size_t i=0; i<size; ++i)
+      num_colors = std::max(num_colors, colors[i] + 1);
+    return num_colors;
+  }
+
+  /** @brief Colors the rows of a CSR matrix and stores the matrix with rows permuted by color.
+  *
+  * @param row_buffer  Row array of the matrix
+  * @param col_buffer  Column array of the matrix
+  * @param elements    Entries of the matrix
+  * @param size        Number of rows (matrix must be square)
+  * @param mc          Permuted matrix (output)
+  */
+  template<typename NumericT>
+  void multicolor_csr_init(unsigned int const * row_buffer, unsigned int const * col_buffer, NumericT const * elements, vcl_size_t size,
+                           multicolor_csr<NumericT> & mc)
+  {
+    std::vector<unsigned int> colors;
+    unsigned int num_colors = jones_plassmann_coloring(row_buffer, col_buffer, size, colors);
+
+    mc.size_ = size;
+
+    // Rows per color:
+    mc.color_buffer_.assign(num_colors + 1, 0);
+    for (vcl_size_t i=0; i<size; ++i)
+      ++mc.color_buffer_[colors[i] + 1];
+    for (unsigned int c=0; c<num_colors; ++c)
+      mc.color_buffer_[c+1] += mc.color_buffer_[c];
+
+    mc.row_index_.resize(size);
+    {
+      std::vector<unsigned int> pos(mc.color_buffer_.begin(), mc.color_buffer_.end() - 1);
+      for (vcl_size_t i=0; i<size; ++i)
+        mc.row_index_[pos[colors[i]]++] = static_cast<unsigned int>(i);
+    }
+
+    // Permuted CSR arrays:
+    mc.row_buffer_.resize(size + 1);
+    mc.row_buffer_[0] = 0;
+    for (vcl_size_t k=0; k<size; ++k)
+    {
+      unsigned int i = mc.row_index_[k];
+      mc.row_buffer_[k+1] = mc.row_buffer_[k] + (row_buffer[i+1] - row_buffer[i]);
+    }
+    mc.col_buffer_.resize(mc.row_buffer_[size]);
+    mc.elements_.resize(mc.row_buffer_[size]);
+    mc.diag_inv_.resize(size);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for
+#endif
+    for (long k2=0; k2<static_cast<long>(size); ++k2)
+    {
+      vcl_size_t k = static_cast<vcl_size_t>(k2);
+      unsigned int i = mc.row_index_[k];
+      NumericT diag = 0;
+      unsigned int pos = mc.row_buffer_[k];
+      for (unsigned int j=row_buffer[i]; j<row_buffer[i+1]; ++j, ++pos)
+      {
+        mc.col_buffer_[pos] = col_buffer[j];
+        mc.elements_[pos]   = elements[j];
+        if (col_buffer[j] == i)
+          diag += elements[j];
+      }
+      mc.diag_inv_[k] = (diag > 0 || diag < 0) ? NumericT(1) / diag : NumericT(0);
+    }
+  }
+
+  /** @brief Runs one multicolor SOR sweep x += omega * D^{-1} (rhs - A x) row by row. All rows of one color are updated in parallel.
+  *
+  * @param mc        Permuted matrix
+  * @param x         Current iterate (updated in place). Accessed via operator[] in the original numbering.
+  * @param rhs       Right hand side in the original numbering
+  * @param omega     Relaxation parameter
+  * @param backward  If true, colors are processed in reverse order
+  */
+  template<typename NumericT, typename VectorT1, typename VectorT2>
+  void multicolor_sor_sweep(multicolor_csr<NumericT> const & mc, VectorT1 & x, VectorT2 const & rhs, NumericT omega, bool backward)
+  {
+    vcl_size_t num_colors = mc.num_colors();
+    for (vcl_size_t c2=0; c2<num_colors; ++c2)
+    {
+      vcl_size_t c = backward ? num_colors - c2 - 1 : c2;
+      long row_start = static_cast<long>(mc.color_buffer_[c]);
+      long row_stop  = static_cast<long>(mc.color_buffer_[c+1]);
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for
+#endif
+      for (long k2=row_start; k2<row_stop; ++k2)
+      {
+        vcl_size_t k = static_cast<vcl_size_t>(k2);
+        unsigned int i = mc.row_index_[k];
+        NumericT sum = rhs[i];
+        for (unsigned int j=mc.row_buffer_[k]; j<mc.row_buffer_[k+1]; ++j)
+          sum -= mc.elements_[j] * x[mc.col_buffer_[j]];
+        x[i] += omega * mc.diag_inv_[k] * sum;
+      }
+    }
+  }
+
+  /** @brief Applies the multicolor (S)SOR preconditioner, i.e. runs the sweeps specified in the tag for the system A x = vec with zero initial guess and overwrites vec with x.
+  *
+  * @param mc    Permuted matrix
+  * @param vec   Right hand side on input, result on output
+  * @param rhs   Work buffer of the size of the system
+  * @param tag   The tag holding relaxation parameter and number of sweeps
+  */
+  template<typename NumericT, typename VectorT>
+  void multicolor_sor_apply(multicolor_csr<NumericT> const & mc, VectorT & vec, std::vector<NumericT> & rhs, gauss_seidel_tag const & tag)
+  {
+    for (vcl_size_t i=0; i<mc.size_; ++i)
+    {
+      rhs[i] = vec[i];
+      vec[i] = 0;
+    }
+
+    NumericT omega = static_cast<NumericT>(tag.omega());
+    for (unsigned int s=0; s<tag.sweeps(); ++s)
+    {
+      multicolor_sor_sweep(mc, vec, rhs, omega, false);
+      if (tag.symmetric())
+        multicolor_sor_sweep(mc, vec, rhs, omega, true);
+    }
+  }
+}
+
+
+/** @brief Multicolor Gauss-Seidel/SOR/SSOR preconditioner class, can be supplied to solve()-routines.
+*
+*  The preconditioner is always set up and applied on the host.
+*/
+template<typename MatrixT>
+class gauss_seidel_precond
+{
+  typedef typename MatrixT::value_type      NumericType;
+
+public:
+  gauss_seidel_precond(MatrixT const & mat, gauss_seidel_tag const & tag) : tag_(tag)
+  {
+    init(mat);
+  }
+
+  template<typename VectorT>
+  void apply(VectorT & vec) const
+  {
+    viennacl::detail::host_context_scope scope(NULL);
+    detail::multicolor_sor_apply(mc_, vec, rhs_, tag_);
+  }
+
+  /** @brief Returns the number of colors used for the rows of the system matrix */
+  vcl_size_t num_colors() const { return mc_.num_colors(); }
+
+private:
+  void init(MatrixT const & mat)
+  {
+    viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+    viennacl::compressed_matrix<NumericType> temp(mat.size1(), mat.size2(), host_ctx);
+    viennacl::switch_memory_context(temp, host_ctx);
+    viennacl::copy(mat, temp);
+
+    viennacl::detail::host_context_scope scope(NULL);
+
+    detail::multicolor_csr_init(viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(temp.handle1()),
+                                viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(temp.handle2()),
+                                viennacl::linalg::host_based::detail::extract_raw_pointer<NumericType>(temp.handle()),
+                                temp.size1(), mc_);
+    rhs_.resize(temp.size1());
+  }
+
+  gauss_seidel_tag tag_;
+  detail::multicolor_csr<NumericType> mc_;
+  mutable std::vector<NumericType> rhs_;
+};
+
+
+/** @brief Multicolor Gauss-Seidel/SOR/SSOR preconditioner class, can be supplied to solve()-routines.
+*
+*  Specialization for compressed_matrix. Vectors not residing in main memory are temporarily migrated to the host.
+*/
+template<typename NumericT, unsigned int AlignmentV>
+class gauss_seidel_precond< compressed_matrix<NumericT, AlignmentV> >
+{
+  typedef compressed_matrix<NumericT, AlignmentV>   MatrixType;
+
+public:
+  gauss_seidel_precond(MatrixType const & mat, gauss_seidel_tag const & tag) : tag_(tag), ram_ctx_(NULL)
+  {
+    init(mat);
+  }
+
+  void apply(vector<NumericT> & vec) const
+  {
+    if (viennacl::traits::context(vec).memory_type() != viennacl::MAIN_MEMORY)
+    {
+      viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+      viennacl::context old_ctx = viennacl::traits::context(vec);
+
+      viennacl::switch_memory_context(vec, host_ctx);
+      apply_host(vec);
+      viennacl::switch_memory_context(vec, old_ctx);
+    }
+    else
+      apply_host(vec);
+  }
+
+  /** @brief Returns the number of colors used for the rows of the system matrix */
+  vcl_size_t num_colors() const { return mc_.num_colors(); }
+
+private:
+  void apply_host(vector<NumericT> & vec) const
+  {
+    viennacl::detail::host_context_scope scope(ram_ctx_);
+    NumericT * data = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(vec.handle()) + vec.start();
+    if (vec.stride() == 1)
+      detail::multicolor_sor_apply(mc_, data, rhs_, tag_);
+    else
+    {
+      // Strided vectors are gathered into a contiguous buffer allocated in init()
+      for (vcl_size_t i=0; i<vec.size(); ++i)
+        temp_[i] = data[i * vec.stride()];
+      detail::multicolor_sor_apply(mc_, temp_, rhs_, tag_);
+      for (vcl_size_t i=0; i<vec.size(); ++i)
+        data[i * vec.stride()] = temp_[i];
+    }
+  }
+
+  void init(MatrixType const & mat)
+  {
+    viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+    viennacl::compressed_matrix<NumericT> temp(mat.size1(), mat.size2(), viennacl::traits::context(mat));
+    viennacl::switch_memory_context(temp, host_ctx);
+    temp = mat;
+
+    // the colors and the reordered matrix are computed by the thread team of the system matrix, which is also used in apply():
+    ram_ctx_ = viennacl::traits::ram_context(mat);
+    viennacl::detail::host_context_scope scope(ram_ctx_);
+    detail::multicolor_csr_init(viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(temp.handle1()),
+                                viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(temp.handle2()),
+                                viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(temp.handle()),
+                                temp.size1(), mc_);
+    rhs_.resize(temp.size1());
+    temp_.resize(temp.size1());
+  }
+
+  gauss_seidel_tag tag_;
+  detail::multicolor_csr<NumericT> mc_;
+  mutable std::vector<NumericT> rhs_;
+  mutable std::vector<NumericT> temp_;
+  viennacl::host_context const * ram_ctx_;
+};
+
+}
+}
+
+
+
+
+#endif
@@ -0,0 +1,624 @@
+#ifndef VIENNACL_LINALG_GCRODR_HPP_
+#define VIENNACL_LINALG_GCRODR_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/gcrodr.hpp
+    @brief GCRO-DR, a restarted GMRES variant with deflated restarting and Krylov subspace recycling across solver runs.
+
+    Implementation following M. L. Parks, E. de Sturler, G. Mackey, D. D. Johnson, S. Maiti, SIAM J. Sci. Comput. 28(5), 1651-1674 (2006).
+*/
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/traits/context.hpp"
+#include "viennacl/linalg/detail/iterative_solver_support.hpp"
+#include "viennacl/linalg/detail/krylov_recycling.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+
+/** @brief A tag for GCRO-DR. Used for supplying solver parameters to gcrodr_solver.
+*/
+class gcrodr_tag
+{
+public:
+  /** @brief The constructor
+  *
+  * @param tol              Relative tolerance for the residual (solver quits if ||r|| < tol * ||b||)
+  * @param max_iterations   The maximum number of iterations (i.e. Arnoldi steps)
+  * @param krylov_dim       Maximum dimension of the search space per cycle, including the recycle space
+  * @param recycle_dim      Dimension of the recycle space, must be smaller than krylov_dim
+  */
+  gcrodr_tag(double tol = 1e-10, unsigned int max_iterations = 300, unsigned int krylov_dim = 30, unsigned int recycle_dim = 10)
+    : tol_(tol), iterations_(max_iterations), krylov_dim_(krylov_dim), recycle_dim_(std::min(recycle_dim, krylov_dim > 0 ? krylov_dim - 1 : 0)) {}
+
+  /** @brief Returns the relative tolerance */
+  double tolerance() const { return tol_; }
+  /** @brief Returns the maximum number of iterations */
+  unsigned int max_iterations() const { return iterations_; }
+  /** @brief Returns the maximum dimension of the search space per cycle */
+  unsigned int krylov_dim() const { return krylov_dim_; }
+  /** @brief Returns the dimension of the recycle space */
+  unsigned int recycle_dim() const { return recycle_dim_; }
+
+  /** @brief Return the number of solver iterations: */
+  unsigned int iters() const { return iters_taken_; }
+  void iters(unsigned int i) const { iters_taken_ = i; }
+
+  /** @brief Returns the estimated relative error at the end of the solver run */
+  double error() const { return last_error_; }
+  /** @brief Sets the estimated relative error at the end of the solver run */
+  void error(double e) const { last_error_ = e; }
+
+private:
+  double tol_;
+  unsigned int iterations_;
+  unsigned int krylov_dim_;
+  unsigned int recycle_dim_;
+
+  //return values from solver
+  mutable unsigned int iters_taken_;
+  mutable double last_error_;
+};
+
+
+/** @brief A GCRO-DR solver for sequences of general systems. Only available for ViennaCL vectors. */
+template<typename VectorT>
+class gcrodr_solver;
+
+/** @brief A GCRO-DR solver for sequences of general systems with right preconditioning.
+*
+* The recycle space U and C = A M^{-1} U with orthonormal columns are kept between cycles and between solver runs.
+* Each cycle runs the Arnoldi process with the operator (I - C C^T) A M^{-1}, so the search space consists of U and the new Krylov basis,
+* and afterwards replaces U by the harmonic Ritz vectors of smallest harmonic Ritz value within this search space.
+* At the beginning of a solver run, C is recomputed for the current system matrix and preconditioner.
+*
+* U, C and the Krylov basis are stored as column-major dense matrices in the memory domain of the right hand side,
+* so that all projections are dense matrix-vector products, which traverse the stored basis once per orthogonalization pass.
+*/
+template<typename NumericT>
+class gcrodr_solver< viennacl::vector<NumericT> >
+{
+public:
+  typedef viennacl::vector<NumericT>                            vector_type;
+  typedef viennacl::matrix<NumericT, viennacl::column_major>    matrix_type;
+
+  gcrodr_solver(gcrodr_tag const & tag = gcrodr_tag()) : tag_(tag), recycle_size_(0) {}
+
+  /** @brief Solves A x = b using the preconditioner 'precond' and returns x, starting from a zero initial guess. The recycle space is updated. */
+  template<typename MatrixT, typename PreconditionerT>
+  vector_type operator()(MatrixT const & A, vector_type const & b, PreconditionerT const & precond)
+  {
+    vector_type result(b.size(), viennacl::traits::context(b));
+    solve(A, b, result, precond);
+    return result;
+  }
+
+  /** @brief Solves A x = b without preconditioner and returns x, starting from a zero initial guess. The recycle space is updated. */
+  template<typename MatrixT>
+  vector_type operator()(MatrixT const & A, vector_type const & b)
+  {
+    return operator()(A, b, viennacl::linalg::no_precond());
+  }
+
+  /** @brief Solves A x = b without preconditioner in place. The entries of 'x' on entry are used as initial guess. The recycle space is updated. */
+  template<typename MatrixT>
+  void solve(MatrixT const & A, vector_type const & b, vector_type & x)
+  {
+    solve(A, b, x, viennacl::linalg::no_precond());
+  }
+
+  /** @brief Solves A x = b using the preconditioner 'precond' in place. The entries of 'x' on entry are used as initial guess. The recycle space is updated. */
+  template<typename MatrixT, typename PreconditionerT>
+  void solve(MatrixT const & A, vector_type const & b, vector_type & x, PreconditionerT const & precond);
+
+  /** @brief Returns the number of columns of the current recycle space */
+  vcl_size_t recycle_size() const { return recycle_size_; }
+
+  /** @brief Returns the current recycle space U as a dense matrix with recycle_size() columns */
+  matrix_type recycle_space() const
+  {
+    matrix_type U(U_.size1(), recycle_size_, viennacl::traits::context(U_));
+    if (recycle_size_ > 0)
+      U = viennacl::project(U_, viennacl::range(0, U_.size1()), viennacl::range(0, recycle_size_));
+    return U;
+  }
+
+  /** @brief Sets the recycle space used for the next solver run. At most recycle_dim() columns of 'U' are used, which need to be linearly independent. */
+  void set_recycle_space(matrix_type const & U)
+  {
+    vcl_size_t cols = std::min<vcl_size_t>(U.size2(), tag_.recycle_dim());
+    viennacl::linalg::detail::prepare_workspace_matrix(U_, U.size1(), std::max<vcl_size_t>(tag_.recycle_dim(), 1), viennacl::traits::context(U));
+    if (cols > 0)
+      viennacl::project(U_, viennacl::range(0, U.size1()), viennacl::range(0, cols)) = viennacl::project(U, viennacl::range(0, U.size1()), viennacl::range(0, cols));
+    recycle_size_ = cols;
+  }
+
+  /** @brief Discards the recycle space, so that the next solver run starts with a plain GMRES cycle */
+  void clear_recycle_space() { recycle_size_ = 0; }
+
+  /** @brief Returns the solver tag holding the configuration as well as the number of iterations and the estimated error of the last run */
+  gcrodr_tag const & tag() const { return tag_; }
+
+private:
+  typedef viennacl::matrix_range<matrix_type>   MatrixRangeType;
+
+  /** @brief y = A M^{-1} v */
+  template<typename MatrixT, typename PreconditionerT>
+  void apply_operator(MatrixT const & A, PreconditionerT const & precond, viennacl::vector_base<NumericT> const & v, viennacl::vector_base<NumericT> & y)
+  {
+    z_ = v;
+    precond.apply(z_);
+    y = viennacl::linalg::prod(A, z_);
+  }
+
+  /** @brief Copies the first 'size' entries of the device buffer to the host */
+  void read_buffer(vcl_size_t size, NumericT * host)
+  {
+    viennacl::backend::memory_read(buffer_.handle(), 0, sizeof(NumericT) * size, host);
+  }
+
+  /** @brief Copies 'size' entries from the host to the beginning of the device buffer */
+  void write_buffer(vcl_size_t size, NumericT const * host)
+  {
+    viennacl::backend::memory_write(buffer_.handle(), 0, sizeof(NumericT) * size, host);
+  }
+
+  /** @brief Orthonormalizes the columns of C by two passes of Cholesky QR and applies the same transformation to U. Returns false if C is rank deficient. */
+  bool orthonormalize_recycle_space(vcl_size_t n, vcl_size_t k);
+
+  /** @brief Runs up to 'steps' steps of the Arnoldi process for the operator (I - C C^T) A M^{-1}, starting from V(:,0).
+  *
+  * Fills the (steps+1) x steps Hessenberg matrix 'H' and the k x steps matrix 'B' = C^T A M^{-1} V, and returns the number of steps carried out.
+  * The least squares problem min || beta e_{k+1} - G y || with G = [D B; 0 H] is updated by Givens rotations of the Hessenberg part after each step,
+  * which provides its residual. Stops early once the residual drops below 'target'.
+  * On exit, G and the solution y belong to the last step.
+  */
+  template<typename MatrixT, typename PreconditionerT>
+  vcl_size_t arnoldi(MatrixT const & A, PreconditionerT const & precond, vcl_size_t n, vcl_size_t k, vcl_size_t steps, std::vector<NumericT> const & D,
+                     NumericT beta, NumericT target, std::vector<NumericT> & G, std::vector<NumericT> & y);
+
+  /** @brief Assembles the (k+m+1) x (k+m) matrix G = [D B; 0 H] of the cycle from the Hessenberg matrix and the projections onto C */
+  void assemble_G(vcl_size_t k, vcl_size_t m, std::vector<NumericT> const & D, std::vector<NumericT> & G) const;
+
+  /** @brief Computes a new recycle space of dimension at most 'k_max' from the harmonic Ritz vectors of the last cycle with 'm' Arnoldi steps. U has unit columns on entry. */
+  bool update_recycle_space(vcl_size_t n, vcl_size_t k, vcl_size_t m, vcl_size_t k_max, std::vector<NumericT> const & G);
+
+  gcrodr_tag tag_;
+  vcl_size_t recycle_size_;
+
+  matrix_type U_;
+  matrix_type C_;
+  matrix_type V_;
+  matrix_type new_U_;
+  matrix_type new_C_;
+  vector_type residual_;
+  vector_type w_;
+  vector_type z_;
+  vector_type buffer_;      // small device buffer for projection coefficients
+
+  std::vector<NumericT> H_;  // Hessenberg matrix of the Arnoldi process, leading dimension krylov_dim + 1
+  std::vector<NumericT> B_;  // C^T A M^{-1} V, leading dimension recycle_dim
+};
+
+
+template<typename NumericT>
+bool gcrodr_solver< viennacl::vector<NumericT> >::orthonormalize_recycle_space(vcl_size_t n, vcl_size_t k)
+{
+  viennacl::range all_rows(0, n);
+  MatrixRangeType U(U_, all_rows, viennacl::range(0, k));
+  MatrixRangeType C(C_, all_rows, viennacl::range(0, k));
+
+  for (vcl_size_t pass = 0; pass < 2; ++pass)
+  {
+    // C^T C = L L^T,  C <- C L^{-T},  U <- U L^{-T}
+    matrix_type CtC_device = viennacl::linalg::prod(trans(C), C);
+    std::vector<NumericT> L;
+    viennacl::linalg::detail::reduction_matrix_to_host(CtC_device, L);
+    if (!viennacl::linalg::detail::recycling_cholesky(k, &L[0], k))
+      return false;
+
+    std::vector<NumericT> R_inv(k * k);   // L^{-T} is upper triangular
+    for (vcl_size_t i = 0; i < k; ++i)
+      R_inv[i + i * k] = NumericT(1);
+    viennacl::linalg::detail::recycling_cholesky_trsm(true, k, &L[0], k, k, &R_inv[0], k);
+
+    matrix_type R_inv_device(k, k, viennacl::traits::context(C_));
+    viennacl::linalg::detail::reduction_host_to_matrix(R_inv, R_inv_device);
+    MatrixRangeType new_C(new_C_, all_rows, viennacl::range(0, k));
+    MatrixRangeType new_U(new_U_, all_rows, viennacl::range(0, k));
+    new_C = viennacl::linalg::prod(C, R_inv_device);
+    new_U = viennacl::linalg::prod(U, R_inv_device);
+    C = new_C;
+    U = new_U;
+  }
+  return true;
+}
+
+
+template<typename NumericT>
+template<typename MatrixT, typename PreconditionerT>
+vcl_size_t gcrodr_solver< viennacl::vector<NumericT> >::arnoldi(MatrixT const & A, PreconditionerT const & precond, vcl_size_t n, vcl_size_t k, vcl_size_t steps,
+                                                               std::vector<NumericT> const & D, NumericT beta, NumericT target,
+                                                               std::vector<NumericT> & G, std::vector<NumericT> & y)
+{
+  vcl_size_t ldh = tag_.krylov_dim() + 1;
+  vcl_size_t ldb = std::max<vcl_size_t>(tag_.recycle_dim(), 1);
+  viennacl::range all_rows(0, n);
+  std::vector<NumericT> h(ldh), h2(ldh);
+
+  // Since the leading k columns of G are diagonal, only the Hessenberg part needs to be triangularized.
+  // R is its upper triangular factor, g = Q^T beta e_1 the rotated right hand side of its rows:
+  std::vector<NumericT> R(ldh * steps), cs(steps), sn(steps), g(steps + 1);
+  g[0] = beta;
+
+  vcl_size_t j = 0;
+  while (j < steps && tag_.iters() < tag_.max_iterations())
+  {
+    viennacl::vector_base<NumericT> v_j  (V_.handle(), n,  j    * V_.internal_size1(), 1);
+    viennacl::vector_base<NumericT> v_new(V_.handle(), n, (j+1) * V_.internal_size1(), 1);
+
+    apply_operator(A, precond, v_j, w_);
+
+    // project out C: b_j = C^T w,  w -= C b_j
+    if (k > 0)
+    {
+      MatrixRangeType C(C_, all_rows, viennacl::range(0, k));
+      viennacl::vector_range<vector_type> coeffs(buffer_, viennacl::range(0, k));
+      coeffs = viennacl::linalg::prod(trans(C), w_);
+      w_ -= viennacl::linalg::prod(C, coeffs);
+      read_buffer(k, &B_[j * ldb]);
+    }
+
+    // classical Gram-Schmidt with reorthogonalization against v_0, ..., v_j:
+    MatrixRangeType V(V_, all_rows, viennacl::range(0, j + 1));
+    viennacl::vector_range<vector_type> coeffs(buffer_, viennacl::range(0, j + 1));
+    coeffs = viennacl::linalg::prod(trans(V), w_);
+    w_ -= viennacl::linalg::prod(V, coeffs);
+    read_buffer(j + 1, &h[0]);
+    coeffs = viennacl::linalg::prod(trans(V), w_);
+    w_ -= viennacl::linalg::prod(V, coeffs);
+    read_buffer(j + 1, &h2[0]);
+    for (vcl_size_t i = 0; i <= j; ++i)
+      H_[i + j * ldh] = h[i] + h2[i];
+
+    NumericT h_next = viennacl::linalg::norm_2(w_);
+    H_[j + 1 + j * ldh] = h_next;
+    if (h_next > 0)
+      v_new = w_ / h_next;
+
+    // apply the previous Givens rotations to the new column, then eliminate its subdiagonal entry:
+    NumericT * r = &R[j * ldh];
+    std::copy(H_.begin() + static_cast<long>(j * ldh), H_.begin() + static_cast<long>(j * ldh + j + 2), r);
+    for (vcl_size_t i = 0; i < j; ++i)
+    {
+      NumericT temp = cs[i] * r[i] + sn[i] * r[i+1];
+      r[i+1]        = cs[i] * r[i+1] - sn[i] * r[i];
+      r[i]          = temp;
+    }
+    NumericT denom = std::sqrt(r[j] * r[j] + h_next * h_next);
+    if (denom <= 0) // singular Hessenberg matrix, no progress possible
+      break;
+    cs[j] = r[j]   / denom;
+    sn[j] = h_next / denom;
+    r[j] = denom;
+    r[j+1] = 0;
+    g[j+1] = -sn[j] * g[j];
+    g[j]   =  cs[j] * g[j];
+
+    ++j;
+    tag_.iters(tag_.iters() + 1);
+
+    if (std::fabs(g[j]) < target || h_next <= 0)
+      break;
+  }
+
+  // y = R^{-1} g for the Krylov part, then D y_U = -B y_V for the recycle space part (the right hand side vanishes there):
+  y.assign(k + j, NumericT(0));
+  for (vcl_size_t i = j; i-- > 0; )
+  {
+    NumericT value = g[i];
+    for (vcl_size_t l = i + 1; l < j; ++l)
+      value -= R[i + l * ldh] * y[k + l];
+    y[k + i] = value / R[i + i * ldh];
+  }
+  for (vcl_size_t i = 0; i < k; ++i)
+  {
+    NumericT value = 0;
+    for (vcl_size_t l = 0; l < j; ++l)
+      value -= B_[i + l * ldb] * y[k + l];
+    y[i] = value / D[i];
+  }
+
+  assemble_G(k, j, D, G);
+  return j;
+}
+
+
+template<typename NumericT>
+void gcrodr_solver< viennacl::vector<NumericT> >::assemble_G(vcl_size_t k, vcl_size_t m, std::vector<NumericT> const & D, std::vector<NumericT> & G) const
+{
+  vcl_size_t ldh = tag_.krylov_dim() + 1;
+  vcl_size_t ldb = std::max<vcl_size_t>(tag_.recycle_dim(), 1);
+  vcl_size_t rows = k + m + 1;
+
+  G.assign(rows * (k + m), NumericT(0));
+  for (vcl_size_t i = 0; i < k; ++i)
+    G[i + i * rows] = D[i];
+  for (vcl_size_t j = 0; j < m; ++j)
+  {
+    for (vcl_size_t i = 0; i < k; ++i)
+      G[i + (k + j) * rows] = B_[i + j * ldb];
+    for (vcl_size_t i = 0; i <= j + 1; ++i)
+      G[k + i + (k + j) * rows] = H_[i + j * ldh];
+  }
+}
+
+
+template<typename NumericT>
+bool gcrodr_solver< viennacl::vector<NumericT> >::update_recycle_space(vcl_size_t n, vcl_size_t k, vcl_size_t m, vcl_size_t k_max, std::vector<NumericT> const & G)
+{
+  vcl_size_t s    = k + m;
+  vcl_size_t rows = s + 1;
+  vcl_size_t new_k = std::min<vcl_size_t>(k_max, s);
+  if (new_k == 0)
+    return false;
+
+  viennacl::range all_rows(0, n);
+  viennacl::context ctx = viennacl::traits::context(V_);
+
+  // W^T Vhat with W = [C, V(:, 0:m+1)] and Vhat = [U, V(:, 0:m)]. Since C^T V = 0 and V is orthonormal, only C^T U and V^T U are needed:
+  std::vector<NumericT> WtV(rows * s);
+  if (k > 0)
+  {
+    MatrixRangeType U(U_, all_rows, viennacl::range(0, k));
+    MatrixRangeType C(C_, all_rows, viennacl::range(0, k));
+    MatrixRangeType V(V_, all_rows, viennacl::range(0, m + 1));
+    matrix_type CtU_device = viennacl::linalg::prod(trans(C), U);
+    matrix_type VtU_device = viennacl::linalg::prod(trans(V), U);
+    std::vector<NumericT> CtU, VtU;
+    viennacl::linalg::detail::reduction_matrix_to_host(CtU_device, CtU);
+    viennacl::linalg::detail::reduction_matrix_to_host(VtU_device, VtU);
+    for (vcl_size_t j = 0; j < k; ++j)
+    {
+      for (vcl_size_t i = 0; i < k; ++i)
+        WtV[i + j * rows] = CtU[i + j * k];
+      for (vcl_size_t i = 0; i <= m; ++i)
+        WtV[k + i + j * rows] = VtU[i + j * (m + 1)];
+    }
+  }
+  for (vcl_size_t j = 0; j < m; ++j)
+    WtV[k + j + (k + j) * rows] = NumericT(1);
+
+  // harmonic Ritz problem G^T G y = theta G^T W^T Vhat y:
+  std::vector<NumericT> F(s * s), B(s * s), P;
+  viennacl::linalg::detail::reduction_gemm(true, false, s, s, rows, NumericT(1), &G[0], rows, &G[0],   rows, NumericT(0), &F[0], s);
+  viennacl::linalg::detail::reduction_gemm(true, false, s, s, rows, NumericT(1), &G[0], rows, &WtV[0], rows, NumericT(0), &B[0], s);
+  new_k = viennacl::linalg::detail::recycling_harmonic_ritz(s, F, B, new_k, P);
+  if (new_k == 0)
+    return false;
+
+  // G P = Q R:  C = W Q,  U = Vhat P R^{-1}
+  std::vector<NumericT> GP(rows * new_k), tau;
+  viennacl::linalg::detail::reduction_gemm(false, false, rows, new_k, s, NumericT(1), &G[0], rows, &P[0], s, NumericT(0), &GP[0], rows);
+  viennacl::linalg::detail::recycling_qr(rows, new_k, &GP[0], rows, tau);
+  std::vector<NumericT> Q = viennacl::linalg::detail::recycling_thin_q(rows, new_k, &GP[0], rows, tau);
+  for (vcl_size_t i = 0; i < new_k; ++i)
+    if (GP[i + i * rows] == 0)
+      return false;
+  for (vcl_size_t c = 0; c < s; ++c)   // P <- P R^{-1}, row by row
+    for (vcl_size_t j = 0; j < new_k; ++j)
+    {
+      NumericT value = P[c + j * s];
+      for (vcl_size_t l = 0; l < j; ++l)
+        value -= P[c + l * s] * GP[l + j * rows];
+      P[c + j * s] = value / GP[j + j * rows];
+    }
+
+  std::vector<NumericT> Q_top(k * new_k), Q_bottom((m + 1) * new_k), P_top(k * new_k), P_bottom(m * new_k);
+  for (vcl_size_t j = 0; j < new_k; ++j)
+  {
+    for (vcl_size_t i = 0; i < k; ++i)
+    {
+      Q_top[i + j * k] = Q[i + j * rows];
+      P_top[i + j * k] = P[i + j * s];
+    }
+    for (vcl_size_t i = 0; i <= m; ++i)
+      Q_bottom[i + j * (m + 1)] = Q[k + i + j * rows];
+    for (vcl_size_t i = 0; i < m; ++i)
+      P_bottom[i + j * m] = P[k + i + j * s];
+  }
+
+  MatrixRangeType new_C(new_C_, all_rows, viennacl::range(0, new_k));
+  MatrixRangeType new_U(new_U_, all_rows, viennacl::range(0, new_k));
+  {
+    matrix_type Q_bottom_device(m + 1, new_k, ctx), P_bottom_device(m, new_k, ctx);
+    viennacl::linalg::detail::reduction_host_to_matrix(Q_bottom, Q_bottom_device);
+    viennacl::linalg::detail::reduction_host_to_matrix(P_bottom, P_bottom_device);
+    new_C = viennacl::linalg::prod(MatrixRangeType(V_, all_rows, viennacl::range(0, m + 1)), Q_bottom_device);
+    new_U = viennacl::linalg::prod(MatrixRangeType(V_, all_rows, viennacl::range(0, m)),     P_bottom_device);
+  }
+  if (k > 0)
+  {
+    matrix_type Q_top_device(k, new_k, ctx), P_top_device(k, new_k, ctx);
+    viennacl::linalg::detail::reduction_host_to_matrix(Q_top, Q_top_device);
+    viennacl::linalg::detail::reduction_host_to_matrix(P_top, P_top_device);
+    new_C += viennacl::linalg::prod(MatrixRangeType(C_, all_rows, viennacl::range(0, k)), Q_top_device);
+    new_U += viennacl::linalg::prod(MatrixRangeType(U_, all_rows, viennacl::range(0, k)), P_top_device);
+  }
+
+  MatrixRangeType(C_, all_rows, viennacl::range(0, new_k)) = new_C;
+  MatrixRangeType(U_, all_rows, viennacl::range(0, new_k)) = new_U;
+  recycle_size_ = new_k;
+  return true;
+}
+
+
+template<typename NumericT>
+template<typename MatrixT, typename PreconditionerT>
+void gcrodr_solver< viennacl::vector<NumericT> >::solve(MatrixT const & A, vector_type const & b, vector_type & x, PreconditionerT const & precond)
+{
+  vcl_size_t n = b.size();
+  viennacl::context ctx = viennacl::traits::context(b);
+  vcl_size_t m_max = std::min<vcl_size_t>(tag_.krylov_dim(), n);
+  vcl_size_t k_max = std::min<vcl_size_t>(tag_.recycle_dim(), m_max > 0 ? m_max - 1 : 0);
+  vcl_size_t k_cols = std::max<vcl_size_t>(tag_.recycle_dim(), 1);
+
+  if (U_.size1() != n)
+    recycle_size_ = 0;
+  recycle_size_ = std::min(recycle_size_, k_max);
+  viennacl::linalg::detail::prepare_workspace_matrix(U_,     n, k_cols, ctx);
+  viennacl::linalg::detail::prepare_workspace_matrix(C_,     n, k_cols, ctx);
+  viennacl::linalg::detail::prepare_workspace_matrix(new_U_, n, k_cols, ctx);
+  viennacl::linalg::detail::prepare_workspace_matrix(new_C_, n, k_cols, ctx);
+  viennacl::linalg::detail::prepare_workspace_matrix(V_,     n, tag_.krylov_dim() + 1, ctx);
+  viennacl::linalg::detail::prepare_workspace_vector(residual_, n, ctx);
+  viennacl::linalg::detail::prepare_workspace_vector(w_, n, ctx);
+  viennacl::linalg::detail::prepare_workspace_vector(z_, n, ctx);
+  viennacl::linalg::detail::prepare_workspace_vector(buffer_, tag_.krylov_dim() + 1, ctx);
+  H_.resize((tag_.krylov_dim() + 1) * tag_.krylov_dim());
+  B_.resize(k_cols * tag_.krylov_dim());
+
+  tag_.iters(0);
+  tag_.error(0);
+
+  NumericT norm_rhs = viennacl::linalg::norm_2(b);
+  if (norm_rhs <= 0) //solution is zero if RHS norm is zero
+  {
+    x.clear();
+    return;
+  }
+
+  viennacl::range all_rows(0, n);
+  residual_ = viennacl::linalg::prod(A, x);
+  residual_ = b - residual_;
+
+  //
+  // Recycle space from a previous run: C = A M^{-1} U with orthonormal columns, then project the residual
+  //
+  vcl_size_t k = recycle_size_;
+  if (k > 0)
+  {
+    for (vcl_size_t j = 0; j < k; ++j)
+    {
+      viennacl::vector_base<NumericT> u_j(U_.handle(), n, j * U_.internal_size1(), 1);
+      viennacl::vector_base<NumericT> c_j(C_.handle(), n, j * C_.internal_size1(), 1);
+      apply_operator(A, precond, u_j, c_j);
+    }
+    if (!orthonormalize_recycle_space(n, k))
+      k = recycle_size_ = 0;
+  }
+  if (k > 0)
+  {
+    // x += M^{-1} U C^T r,  r -= C C^T r
+    MatrixRangeType U(U_, all_rows, viennacl::range(0, k));
+    MatrixRangeType C(C_, all_rows, viennacl::range(0, k));
+    viennacl::vector_range<vector_type> coeffs(buffer_, viennacl::range(0, k));
+    coeffs = viennacl::linalg::prod(trans(C), residual_);
+    residual_ -= viennacl::linalg::prod(C, coeffs);
+    z_ = viennacl::linalg::prod(U, coeffs);
+    precond.apply(z_);
+    x += z_;
+  }
+
+  NumericT beta = viennacl::linalg::norm_2(residual_);
+  tag_.error(beta / norm_rhs);
+
+  std::vector<NumericT> G, y, D;
+  while (tag_.error() >= tag_.tolerance() && tag_.iters() < tag_.max_iterations())
+  {
+    // normalize the columns of U. Then A M^{-1} U = C D with D = diag(1 / ||u_j||)
+    D.assign(k, NumericT(1));
+    for (vcl_size_t j = 0; j < k; ++j)
+    {
+      viennacl::vector_base<NumericT> u_j(U_.handle(), n, j * U_.internal_size1(), 1);
+      NumericT norm_u = viennacl::linalg::norm_2(u_j);
+      if (norm_u > 0)
+      {
+        u_j /= norm_u;
+        D[j] = NumericT(1) / norm_u;
+      }
+    }
+
+    viennacl::vector_base<NumericT> v_0(V_.handle(), n, 0, 1);
+    v_0 = residual_ / beta;
+
+    // Arnoldi process, which also provides the solution y of the least squares problem min || beta e_{k+1} - G y ||:
+    vcl_size_t m = arnoldi(A, precond, n, k, m_max - k, D, beta, NumericT(tag_.tolerance()) * norm_rhs, G, y);
+    if (m == 0)
+      break;
+
+    // x += M^{-1} [U, V] y
+    {
+      viennacl::vector_range<vector_type> coeffs(buffer_, viennacl::range(0, m));
+      write_buffer(m, &y[k]);
+      z_ = viennacl::linalg::prod(MatrixRangeType(V_, all_rows, viennacl::range(0, m)), coeffs);
+      if (k > 0)
+      {
+        viennacl::vector_range<vector_type> coeffs_U(buffer_, viennacl::range(0, k));
+        write_buffer(k, &y[0]);
+        z_ += viennacl::linalg::prod(MatrixRangeType(U_, all_rows, viennacl::range(0, k)), coeffs_U);
+      }
+      precond.apply(z_);
+      x += z_;
+    }
+
+    // r -= [C, V] (G y):
+    {
+      std::vector<NumericT> Gy(k + m + 1);
+      viennacl::linalg::detail::reduction_gemm(false, false, k + m + 1, 1, k + m, NumericT(1), &G[0], k + m + 1, &y[0], k + m, NumericT(0), &Gy[0], k + m + 1);
+      viennacl::vector_range<vector_type> coeffs(buffer_, viennacl::range(0, m + 1));
+      write_buffer(m + 1, &Gy[k]);
+      residual_ -= viennacl::linalg::prod(MatrixRangeType(V_, all_rows, viennacl::range(0, m + 1)), coeffs);
+      if (k > 0)
+      {
+        viennacl::vector_range<vector_type> coeffs_C(buffer_, viennacl::range(0, k));
+        write_buffer(k, &Gy[0]);
+        residual_ -= viennacl::linalg::prod(MatrixRangeType(C_, all_rows, viennacl::range(0, k)), coeffs_C);
+      }
+    }
+
+    beta = viennacl::linalg::norm_2(residual_);
+    tag_.error(beta / norm_rhs);
+
+    // deflated restart: new recycle space from the harmonic Ritz vectors of this cycle
+    if (k_max > 0)
+    {
+      if (update_recycle_space(n, k, m, k_max, G))
+        k = recycle_size_;
+      else
+        k = recycle_size_ = 0;
+    }
+  }
+}
+
+}
+}
+
+#endif
@@ -24,6 +24,7 @@
 
 #include <vector>
 #include <cmath>
+#include <algorithm>
 #include <limits>
 #include "viennacl/forwards.h"
 #include "viennacl/tools/tools.hpp"
@@ -36,6 +37,7 @@
 #include "viennacl/meta/result_of.hpp"
 
 #include "viennacl/linalg/iterative_operations.hpp"
+#include "viennacl/linalg/detail/iterative_solver_support.hpp"
 #include "viennacl/vector_proxy.hpp"
 
 
@@ -49,6 +51,19 @@ namespace linalg
 class gmres_tag       //generalized minimum residual
 {
 public:
+  /** @brief Orthogonalization schemes for the Krylov basis.
+  *
+  * 'householder' selects the established implementations: Householder reflections for the generic solver and the pipelined 'Simpler GMRES' for ViennaCL sparse matrices without preconditioner.
+  * All other values select the Arnoldi process with right preconditioning, which is available for ViennaCL vectors.
+  */
+  enum orthogonalization_type
+  {
+    householder = 0,           ///< Householder reflections (generic solver) or pipelined 'Simpler GMRES'
+    modified_gram_schmidt,     ///< Modified Gram-Schmidt: one inner product and one vector update per basis vector
+    classical_gram_schmidt_2,  ///< Classical Gram-Schmidt with one reorthogonalization pass (CGS2), each pass fused into two kernels
+    one_sync_gram_schmidt      ///< Classical Gram-Schmidt with a single reduction per iteration, the norm of the new basis vector is obtained from the Pythagorean identity
+  };
+
   /** @brief The constructor
   *
   * @param tol            Relative tolerance for the residual (solver quits if ||r|| < tol * ||r_initial||)
@@ -56,7 +71,7 @@ public:
   * @param krylov_dim     The maximum dimension of the Krylov space before restart (number of restarts is found by max_iterations / krylov_dim)
   */
   gmres_tag(double tol = 1e-10, unsigned int max_iterations = 300, unsigned int krylov_dim = 20)
-   : tol_(tol), iterations_(max_iterations), krylov_dim_(krylov_dim), iters_taken_(0) {}
+   : tol_(tol), iterations_(max_iterations), krylov_dim_(krylov_dim), orthogonalization_(householder), flexible_(false), iters_taken_(0) {}
 
   /** @brief Returns the relative tolerance */
   double tolerance() const { return tol_; }
@@ -83,10 +98,22 @@ public:
   /** @brief Sets the estimated relative error at the end of the solver run */
   void error(double e) const { last_error_ = e; }
 
+  /** @brief Returns the orthogonalization scheme for the Krylov basis */
+  orthogonalization_type orthogonalization() const { return orthogonalization_; }
+  /** @brief Sets the orthogonalization scheme for the Krylov basis */
+  void orthogonalization(orthogonalization_type type) { orthogonalization_ = type; }
+
+  /** @brief Returns true if flexible GMRES (FGMRES) is used, which allows the preconditioner to change between iterations */
+  bool flexible() const { return flexible_; }
+  /** @brief Enables or disables flexible GMRES (FGMRES). Stores the preconditioned basis vectors in addition to the Krylov basis. */
+  void flexible(bool b) { flexible_ = b; }
+
 private:
   double tol_;
   unsigned int iterations_;
   unsigned int krylov_dim_;
+  orthogonalization_type orthogonalization_;
+  bool flexible_;
 
   //return values from solver
   mutable unsigned int iters_taken_;
@@ -159,6 +186,424 @@ namespace detail
   }
 
 
+  /** @brief Forms the correction z of 'A Simpler GMRES' with 'k' basis vectors in place in 'res': Solves R eta = projection_rhs in place, then applies the Householder reflections P_1 * ... * P_k */
+  template<typename VectorT, typename NumericT>
+  void gmres_householder_form_update(VectorT & res, std::vector<NumericT> & projection_rhs, std::vector< std::vector<NumericT> > const & R,
+                                     std::vector<VectorT> const & householder_reflectors, std::vector<NumericT> const & betas, vcl_size_t k)
+  {
+    //
+    // Triangular solver stage:
+    //
+
+    for (int i2=static_cast<int>(k)-1; i2>-1; --i2)
+    {
+      vcl_size_t i = static_cast<vcl_size_t>(i2);
+      for (vcl_size_t j=i+1; j<k; ++j)
+        projection_rhs[i] -= R[j][i] * projection_rhs[j];     //R is transposed
+
+      projection_rhs[i] /= R[i][i];
+    }
+
+    //
+    // Note: 'projection_rhs' now holds the solution (eta_1, ..., eta_k)
+    //
+
+    res *= projection_rhs[0];
+
+    if (k > 0)
+    {
+      for (unsigned int i = 0; i < k-1; ++i)
+        res[i] += projection_rhs[i+1];
+    }
+
+    //
+    // Form z inplace in 'res' by applying P_1 * ... * P_{k}
+    //
+    for (int i=static_cast<int>(k)-1; i>=0; --i)
+      detail::gmres_householder_reflect(res, householder_reflectors[vcl_size_t(i)], betas[vcl_size_t(i)]);
+  }
+
+
+  /** @brief Returns true if the tag requests the Arnoldi-based implementation (flexible preconditioning or a Gram-Schmidt variant) */
+  inline bool gmres_use_arnoldi(gmres_tag const & tag)
+  {
+    return tag.flexible() || tag.orthogonalization() != gmres_tag::householder;
+  }
+
+  /** @brief Buffers of the GMRES implementation based on Householder reflections */
+  template<typename VectorT>
+  class gmres_householder_workspace
+  {
+    typedef typename viennacl::result_of::value_type<VectorT>::type            NumericType;
+    typedef typename viennacl::result_of::cpu_value_type<NumericType>::type    CPU_NumericType;
+
+  public:
+    /** @brief Prepares all buffers for a system of the size of 'rhs' and a Krylov space of dimension 'krylov_dim' */
+    void init(VectorT const & rhs, vcl_size_t krylov_dim, vcl_size_t max_krylov_dim)
+    {
+      detail::prepare_workspace_vector(res,            rhs);
+      detail::prepare_workspace_vector(v_k_tilde,      rhs);
+      detail::prepare_workspace_vector(v_k_tilde_temp, rhs);
+
+      R.resize(krylov_dim);
+      for (vcl_size_t i=0; i<krylov_dim; ++i)
+        R[i].resize(max_krylov_dim);
+      projection_rhs.resize(krylov_dim);
+
+      householder_reflectors.resize(krylov_dim);
+      for (vcl_size_t i=0; i<krylov_dim; ++i)
+        detail::prepare_workspace_vector(householder_reflectors[i], rhs);
+      betas.resize(krylov_dim);
+    }
+
+    VectorT res;
+    VectorT v_k_tilde;
+    VectorT v_k_tilde_temp;
+
+    std::vector< std::vector<CPU_NumericType> > R;
+    std::vector<CPU_NumericType> projection_rhs;
+
+    std::vector<VectorT>          householder_reflectors;
+    std::vector<CPU_NumericType>  betas;
+
+    VectorT                       monitor_result;         // current approximation passed to the monitor
+    std::vector<CPU_NumericType>  monitor_projection_rhs;
+  };
+
+  /** @brief Buffers of a GMRES solver object. Vector types other than viennacl::vector use Householder reflections. */
+  template<typename VectorT>
+  class gmres_workspace : public gmres_householder_workspace<VectorT> {};
+
+  /** @brief Buffers of the Arnoldi-based GMRES implementation for ViennaCL vectors.
+  *
+  * All buffers are only (re-)allocated if the system size, the Krylov space dimension or the memory domain changes, hence repeated solves with systems of the same size do not allocate memory.
+  */
+  template<typename NumericT>
+  class gmres_workspace< viennacl::vector<NumericT> >
+  {
+  public:
+    /** @brief Number of entries per vector in the buffers holding the first stage of the reductions */
+    static vcl_size_t buffer_chunk_size() { return 128; }
+
+    /** @brief Prepares all buffers for a system of the size of 'rhs' and a Krylov space of dimension 'krylov_dim' */
+    void init(viennacl::vector<NumericT> const & rhs, vcl_size_t krylov_dim, bool flexible)
+    {
+      viennacl::context ctx = viennacl::traits::context(rhs);
+      vcl_size_t chunk_size = buffer_chunk_size();
+
+      detail::prepare_workspace_vector(residual,          rhs.size(),                                ctx);
+      detail::prepare_workspace_vector(z,                 rhs.size(),                                ctx);
+      detail::prepare_workspace_vector(krylov_basis,      rhs.internal_size() * (krylov_dim + 1),    ctx); // not using viennacl::matrix here because of spurious padding in column number
+      detail::prepare_workspace_vector(z_basis,           flexible ? rhs.internal_size() * krylov_dim : 1, ctx);
+      detail::prepare_workspace_vector(R,                 (krylov_dim + 1) * (krylov_dim + 1),       ctx);
+      detail::prepare_workspace_vector(R_reorth,          (krylov_dim + 1) * (krylov_dim + 1),       ctx);
+      detail::prepare_workspace_vector(inner_prod_buffer, 3 * chunk_size,                            ctx);
+      detail::prepare_workspace_vector(vi_in_vk_buffer,   chunk_size * (krylov_dim + 1),             ctx);
+      detail::prepare_workspace_vector(r_dot_vk_buffer,   chunk_size,                                ctx);
+      detail::prepare_workspace_vector(coefficients,      krylov_dim + 1,                            ctx);
+      detail::prepare_workspace_vector(inner_prods,       krylov_dim + 2,                            ctx);
+
+      host_h.resize(krylov_dim + 2);
+      host_h_reorth.resize(krylov_dim + 2);
+      host_R.resize(krylov_dim * krylov_dim);
+      host_cs.resize(krylov_dim);
+      host_sn.resize(krylov_dim);
+      host_g.resize(krylov_dim + 1);
+      host_coefficients.resize(krylov_dim + 1);
+    }
+
+    viennacl::vector<NumericT> residual;          // r = b - A x, also used as dummy argument for the fused normalization
+    viennacl::vector<NumericT> z;                 // preconditioned basis vector M^{-1} v_k
+    viennacl::vector<NumericT> krylov_basis;      // v_0, ..., v_m, each padded to the internal size of the right hand side
+    viennacl::vector<NumericT> z_basis;           // z_0, ..., z_{m-1} for flexible GMRES
+    viennacl::vector<NumericT> R;                 // Hessenberg columns as computed by the fused Gram-Schmidt kernels
+    viennacl::vector<NumericT> R_reorth;          // corrections from the reorthogonalization pass of CGS2
+    viennacl::vector<NumericT> inner_prod_buffer;
+    viennacl::vector<NumericT> vi_in_vk_buffer;
+    viennacl::vector<NumericT> r_dot_vk_buffer;
+    viennacl::vector<NumericT> coefficients;      // coefficients of the basis vectors in the update of the result
+    viennacl::vector<NumericT> inner_prods;       // <v_0, w>, ..., <v_k, w>, <w, w> from the single reduction of the one-sync variant
+    viennacl::vector<NumericT> monitor_result;    // current approximation passed to the monitor, only allocated if a monitor is set
+
+    std::vector<NumericT> host_h;
+    std::vector<NumericT> host_h_reorth;
+    std::vector<NumericT> host_R;                 // upper triangular factor of the Hessenberg matrix after Givens rotations
+    std::vector<NumericT> host_cs;
+    std::vector<NumericT> host_sn;
+    std::vector<NumericT> host_g;
+    std::vector<NumericT> host_coefficients;
+  };
+
+
+  /** @brief Adds the correction of the current Arnoldi cycle with 'k' basis vectors to 'x': Solves R y = g, then computes x += Z y for flexible GMRES and x += M^{-1} V y otherwise */
+  template<typename NumericT, typename PreconditionerT>
+  void gmres_arnoldi_add_update(viennacl::vector<NumericT> & x,
+                                PreconditionerT const & precond,
+                                gmres_workspace< viennacl::vector<NumericT> > & ws,
+                                vcl_size_t k, vcl_size_t size, vcl_size_t internal_size, vcl_size_t krylov_dim, bool flexible)
+  {
+    //
+    // Triangular solver stage: R y = g. The coefficient of v_{i} ends up in host_coefficients[i+1] for use with pipelined_gmres_update_result()
+    //
+    ws.host_coefficients[0] = 0;
+    for (vcl_size_t i2=0; i2<k; ++i2)
+    {
+      vcl_size_t i = k - 1 - i2;
+      NumericT y_i = ws.host_g[i];
+      for (vcl_size_t j=i+1; j<k; ++j)
+        y_i -= ws.host_R[i + j*krylov_dim] * ws.host_coefficients[j+1];
+      ws.host_coefficients[i+1] = y_i / ws.host_R[i + i*krylov_dim];
+    }
+    viennacl::backend::memory_write(ws.coefficients.handle(), 0, sizeof(NumericT) * (k+1), &(ws.host_coefficients[0]));
+
+    //
+    // Update: x += Z y for flexible GMRES, x += M^{-1} V y otherwise
+    //
+    if (flexible)
+      viennacl::linalg::pipelined_gmres_update_result(x, x, ws.z_basis, size, internal_size, ws.coefficients, k+1);
+    else
+    {
+      ws.z.clear();
+      viennacl::linalg::pipelined_gmres_update_result(ws.z, ws.z, ws.krylov_basis, size, internal_size, ws.coefficients, k+1);
+      precond.apply(ws.z);
+      x += ws.z;
+    }
+  }
+
+  /** @brief Implementation of restarted GMRES based on the Arnoldi process with right preconditioning.
+  *
+  * Computes the Krylov basis with modified Gram-Schmidt, with two fused passes of classical Gram-Schmidt using the pipelined Gram-Schmidt kernels (CGS2),
+  * or with a single pass of classical Gram-Schmidt with one reduction per iteration:
+  * The inner products <v_i, w> and <w, w> are computed by one multi-inner-product kernel, then ||w - V h||^2 = <w, w> - ||h||^2 yields the norm of the new basis vector without a second reduction.
+  * If cancellation in this difference loses more than half of the significant digits, the norm is recomputed explicitly.
+  * The least squares problem is solved on the host using Givens rotations, so the residual estimate is available after each iteration.
+  * If flexible GMRES is requested, the preconditioned basis vectors z_k = M^{-1} v_k are stored and used for the update of the result,
+  * so the preconditioner may change between iterations.
+  *
+  * @param A          The system matrix
+  * @param rhs        The load vector
+  * @param result     The result vector, must have the same size as 'rhs'
+  * @param tag        Solver configuration tag
+  * @param precond    A preconditioner. Precondition operation is done via member function apply()
+  * @param ws         Buffers, which are reused across calls
+  * @param use_initial_guess  If false, the iteration starts from a zero initial guess. Otherwise, 'result' holds the initial guess on entry.
+  * @param monitor    Monitor called after each iteration. The current approximation is only formed if a monitor is set.
+  */
+  template<typename MatrixT, typename NumericT, typename PreconditionerT>
+  void gmres_arnoldi_solve(MatrixT const & A,
+                           viennacl::vector<NumericT> const & rhs,
+                           viennacl::vector<NumericT> & result,
+                           gmres_tag const & tag,
+                           PreconditionerT const & precond,
+                           gmres_workspace< viennacl::vector<NumericT> > & ws,
+                           bool use_initial_guess = false,
+                           solver_monitor< viennacl::vector<NumericT> > const & monitor = solver_monitor< viennacl::vector<NumericT> >())
+  {
+    typedef viennacl::vector_range<viennacl::vector<NumericT> >    RangeType;
+
+    vcl_size_t size          = rhs.size();
+    vcl_size_t internal_size = rhs.internal_size();
+    vcl_size_t krylov_dim    = std::min<vcl_size_t>(tag.krylov_dim(), size); //A Krylov space larger than the matrix is not needed (mathematically, error is certain to be zero already)
+    vcl_size_t R_dim         = krylov_dim + 1;
+    vcl_size_t chunk_size    = ws.buffer_chunk_size();
+    bool flexible = tag.flexible();
+    gmres_tag::orthogonalization_type ortho = tag.orthogonalization();
+    if (ortho == gmres_tag::householder) // Householder reflections are not used by the Arnoldi process
+      ortho = gmres_tag::modified_gram_schmidt;
+
+    ws.init(rhs, krylov_dim, flexible);
+    if (monitor.is_set())
+      detail::prepare_workspace_vector(ws.monitor_result, rhs);
+
+    // basis vectors v_0, ..., v_{m} as arguments of the multi-inner-product kernel of the one-sync variant:
+    std::vector<RangeType> basis_vectors;
+    std::vector<viennacl::vector_base<NumericT> const *> basis_pointers;
+    if (ortho == gmres_tag::one_sync_gram_schmidt)
+    {
+      for (vcl_size_t i=0; i<=krylov_dim; ++i)
+        basis_vectors.push_back(RangeType(ws.krylov_basis, viennacl::range(i*internal_size, i*internal_size + size)));
+      for (vcl_size_t i=0; i<=krylov_dim; ++i)
+        basis_pointers.push_back(&basis_vectors[i]);
+    }
+
+    tag.iters(0);
+    tag.error(0);
+    if (!use_initial_guess)
+      result.clear();
+
+    NumericT norm_rhs = viennacl::linalg::norm_2(rhs);
+    if (norm_rhs <= 0) //solution is zero if RHS norm is zero
+    {
+      result.clear();
+      return;
+    }
+
+    for (bool first_cycle = true; ; first_cycle = false)
+    {
+      //
+      // (Re-)Initialize residual: r = b - A*x (without temporary for the result of A*x)
+      //
+      if (first_cycle && !use_initial_guess)
+        ws.residual = rhs;
+      else
+      {
+        ws.residual = viennacl::linalg::prod(A, result);
+        ws.residual = rhs - ws.residual;
+      }
+
+      NumericT beta = viennacl::linalg::norm_2(ws.residual);
+      tag.error(beta / norm_rhs);
+      if (tag.error() < tag.tolerance() || tag.iters() >= tag.max_iterations())
+        return;
+
+      RangeType v0(ws.krylov_basis, viennacl::range(0, size));
+      v0 = ws.residual / beta;
+
+      std::fill(ws.host_g.begin(), ws.host_g.end(), NumericT(0));
+      ws.host_g[0] = beta;
+
+      //
+      // Arnoldi process:
+      //
+      vcl_size_t k = 0;
+      while (k < krylov_dim && tag.iters() < tag.max_iterations())
+      {
+        RangeType v_k(ws.krylov_basis, viennacl::range( k   *internal_size,  k   *internal_size + size));
+        RangeType w  (ws.krylov_basis, viennacl::range((k+1)*internal_size, (k+1)*internal_size + size));
+
+        // w = A M^{-1} v_k:
+        ws.z = v_k;
+        precond.apply(ws.z);
+        if (flexible)
+        {
+          RangeType z_k(ws.z_basis, viennacl::range(k*internal_size, k*internal_size + size));
+          z_k = ws.z;
+        }
+        w = viennacl::linalg::prod(A, ws.z);
+
+        // Orthogonalize w against v_0, ..., v_k and normalize. The column of the Hessenberg matrix ends up in host_h:
+        if (ortho == gmres_tag::modified_gram_schmidt)
+        {
+          for (vcl_size_t i=0; i<=k; ++i)
+          {
+            RangeType v_i(ws.krylov_basis, viennacl::range(i*internal_size, i*internal_size + size));
+            ws.host_h[i] = viennacl::linalg::inner_prod(v_i, w);
+            w -= ws.host_h[i] * v_i;
+          }
+          ws.host_h[k+1] = viennacl::linalg::norm_2(w);
+          if (ws.host_h[k+1] > 0)
+            w /= ws.host_h[k+1];
+        }
+        else if (ortho == gmres_tag::one_sync_gram_schmidt)
+        {
+          // single reduction: <v_0, w>, ..., <v_k, w>, <w, w>
+          viennacl::vector_tuple<NumericT> basis_and_w(std::vector<viennacl::vector_base<NumericT> const *>(basis_pointers.begin(), basis_pointers.begin() + static_cast<std::ptrdiff_t>(k+2))); // v_{k+1} is w
+          RangeType h_and_norm(ws.inner_prods, viennacl::range(0, k+2));
+          h_and_norm = viennacl::linalg::inner_prod(w, basis_and_w);
+          viennacl::backend::memory_read(ws.inner_prods.handle(), 0, sizeof(NumericT) * (k+2), &(ws.host_h[0]));
+
+          NumericT norm_w_squared = ws.host_h[k+1];
+          NumericT norm_h_squared = 0;
+          for (vcl_size_t i=0; i<=k; ++i)
+            norm_h_squared += ws.host_h[i] * ws.host_h[i];
+
+          // w -= V h in a single pass over the basis (coefficient 0 refers to the 'residual' argument, coefficient i+1 to v_i):
+          ws.host_coefficients[0] = 0;
+          for (vcl_size_t i=0; i<=k; ++i)
+            ws.host_coefficients[i+1] = -ws.host_h[i];
+          viennacl::backend::memory_write(ws.coefficients.handle(), 0, sizeof(NumericT) * (k+2), &(ws.host_coefficients[0]));
+          ws.z = w;
+          viennacl::linalg::pipelined_gmres_update_result(ws.z, ws.z, ws.krylov_basis, size, internal_size, ws.coefficients, k+2);
+
+          // ||w - V h||^2 = <w, w> - ||h||^2 for orthonormal V. Recompute the norm if the difference suffers from cancellation:
+          NumericT norm_w_orth_squared = norm_w_squared - norm_h_squared;
+          if (norm_w_orth_squared > std::sqrt(std::numeric_limits<NumericT>::epsilon()) * norm_w_squared)
+            ws.host_h[k+1] = std::sqrt(norm_w_orth_squared);
+          else
+            ws.host_h[k+1] = viennacl::linalg::norm_2(ws.z);
+
+          if (ws.host_h[k+1] > 0)
+            w = ws.z / ws.host_h[k+1];
+          else
+            w = ws.z;
+        }
+        else // classical_gram_schmidt_2
+        {
+          viennacl::linalg::pipelined_gmres_gram_schmidt_stage1(ws.krylov_basis, size, internal_size, k+1, ws.vi_in_vk_buffer, chunk_size);
+          viennacl::linalg::pipelined_gmres_gram_schmidt_stage2(ws.krylov_basis, size, internal_size, k+1,
+                                                                ws.vi_in_vk_buffer,
+                                                                ws.R, R_dim,
+                                                                ws.inner_prod_buffer, chunk_size);
+          // reorthogonalization pass:
+          viennacl::linalg::pipelined_gmres_gram_schmidt_stage1(ws.krylov_basis, size, internal_size, k+1, ws.vi_in_vk_buffer, chunk_size);
+          viennacl::linalg::pipelined_gmres_gram_schmidt_stage2(ws.krylov_basis, size, internal_size, k+1,
+                                                                ws.vi_in_vk_buffer,
+                                                                ws.R_reorth, R_dim,
+                                                                ws.inner_prod_buffer, chunk_size);
+
+          // Normalize w. The inner product <r, w> computed alongside is not needed here.
+          viennacl::linalg::pipelined_gmres_normalize_vk(w, ws.residual,
+                                                         ws.R, (k+1)*R_dim + k+1,
+                                                         ws.inner_prod_buffer, ws.r_dot_vk_buffer,
+                                                         chunk_size, 0);
+
+          vcl_size_t column_start = (k+1) * R_dim;
+          viennacl::backend::memory_read(ws.R.handle(),        sizeof(NumericT) * column_start, sizeof(NumericT) * (k+2), &(ws.host_h[0]));
+          viennacl::backend::memory_read(ws.R_reorth.handle(), sizeof(NumericT) * column_start, sizeof(NumericT) * (k+1), &(ws.host_h_reorth[0]));
+          for (vcl_size_t i=0; i<=k; ++i)
+            ws.host_h[i] += ws.host_h_reorth[i];
+        }
+
+        // Apply previous Givens rotations to the new column:
+        NumericT * h = &(ws.host_h[0]);
+        for (vcl_size_t i=0; i<k; ++i)
+        {
+          NumericT temp = ws.host_cs[i] * h[i] + ws.host_sn[i] * h[i+1];
+          h[i+1]        = ws.host_cs[i] * h[i+1] - ws.host_sn[i] * h[i];
+          h[i]          = temp;
+        }
+
+        // Compute new Givens rotation which eliminates h[k+1]:
+        NumericT h_next = h[k+1];
+        NumericT denom = std::sqrt(h[k] * h[k] + h_next * h_next);
+        if (denom <= 0) // singular Hessenberg matrix, no progress possible
+          break;
+        ws.host_cs[k] = h[k]   / denom;
+        ws.host_sn[k] = h_next / denom;
+        h[k] = denom;
+
+        for (vcl_size_t i=0; i<=k; ++i)
+          ws.host_R[i + k*krylov_dim] = h[i];
+
+        ws.host_g[k+1] = -ws.host_sn[k] * ws.host_g[k];
+        ws.host_g[k]   =  ws.host_cs[k] * ws.host_g[k];
+
+        ++k;
+        tag.iters( tag.iters() + 1 ); //increase iteration counter
+        tag.error( std::fabs(ws.host_g[k]) / norm_rhs );
+
+        if (tag.error() < tag.tolerance() || !(std::fabs(h_next) > 0)) // converged or invariant Krylov space found
+          break;
+
+        if (monitor.is_set())
+        {
+          ws.monitor_result = result;
+          gmres_arnoldi_add_update(ws.monitor_result, precond, ws, k, size, internal_size, krylov_dim, flexible);
+          if (monitor(ws.monitor_result, static_cast<NumericT>(tag.error())))
+          {
+            result = ws.monitor_result;
+            return;
+          }
+        }
+      }
+
+      if (k == 0)
+        return;
+
+      gmres_arnoldi_add_update(result, precond, ws, k, size, internal_size, krylov_dim, flexible);
+    }
+  }
+
   /** @brief Implementation of a pipelined GMRES solver without preconditioner
   *
   * Following algorithm 2.1 proposed by Walker in "A Simpler GMRES", but uses classical Gram-Schmidt instead of modified Gram-Schmidt for better parallelization.
@@ -175,6 +620,14 @@ namespace detail
                                                gmres_tag const & tag,
                                                viennacl::linalg::no_precond)
   {
+    if (gmres_use_arnoldi(tag))
+    {
+      viennacl::vector<ScalarType> result(rhs.size(), viennacl::traits::context(rhs));
+      gmres_workspace< viennacl::vector<ScalarType> > ws;
+      gmres_arnoldi_solve(A, rhs, result, tag, viennacl::linalg::no_precond(), ws);
+      return result;
+    }
+
     viennacl::vector<ScalarType> residual(rhs);
     viennacl::vector<ScalarType> result = viennacl::zero_vector<ScalarType>(rhs.size(), viennacl::traits::context(rhs));
 
@@ -569,187 +1022,237 @@ viennacl::vector<NumericT> solve(viennacl::hyb_matrix<NumericT> const & A,
 }
 
 
-
-/** @brief Implementation of the GMRES solver.
-*
-* Following the algorithm proposed by Walker in "A Simpler GMRES"
-*
-* @param matrix     The system matrix
-* @param rhs        The load vector
-* @param tag        Solver configuration tag
-* @param precond    A preconditioner. Precondition operation is done via member function apply()
-* @return The result vector
-*/
-template<typename MatrixT, typename VectorT, typename PreconditionerT>
-VectorT solve(MatrixT const & matrix, VectorT const & rhs, gmres_tag const & tag, PreconditionerT const & precond)
+namespace detail
 {
-  typedef typename viennacl::result_of::value_type<VectorT>::type            NumericType;
-  typedef typename viennacl::result_of::cpu_value_type<NumericType>::type    CPU_NumericType;
-  unsigned int problem_size = static_cast<unsigned int>(viennacl::traits::size(rhs));
-  VectorT result = rhs;
-  viennacl::traits::clear(result);
+  /** @brief Generic vector types always use the implementation based on Householder reflections */
+  template<typename MatrixT, typename VectorT, typename PreconditionerT>
+  bool gmres_try_arnoldi(MatrixT const &, VectorT const &, VectorT &, gmres_tag const &, PreconditionerT const &)
+  {
+    return false;
+  }
 
-  vcl_size_t krylov_dim = static_cast<vcl_size_t>(tag.krylov_dim());
-  if (problem_size < krylov_dim)
-    krylov_dim = problem_size; //A Krylov space larger than the matrix would lead to seg-faults (mathematically, error is certain to be zero already)
+  /** @brief ViennaCL vectors run the Arnoldi-based implementation if requested by the tag */
+  template<typename MatrixT, typename NumericT, typename PreconditionerT>
+  bool gmres_try_arnoldi(MatrixT const & A, viennacl::vector<NumericT> const & rhs, viennacl::vector<NumericT> & result, gmres_tag const & tag, PreconditionerT const & precond)
+  {
+    gmres_workspace< viennacl::vector<NumericT> > ws;
+    gmres_arnoldi_solve(A, rhs, result, tag, precond, ws);
+    return true;
+  }
+}
 
-  VectorT res = rhs;
-  VectorT v_k_tilde = rhs;
-  VectorT v_k_tilde_temp = rhs;
+namespace detail
+{
 
-  std::vector< std::vector<CPU_NumericType> > R(krylov_dim, std::vector<CPU_NumericType>(tag.krylov_dim()));
-  std::vector<CPU_NumericType> projection_rhs(krylov_dim);
+  /** @brief Implementation of the GMRES solver.
+  *
+  * Following the algorithm proposed by Walker in "A Simpler GMRES"
+  *
+  * @param matrix     The system matrix
+  * @param rhs        The load vector
+  * @param result     The result vector. Holds the initial guess on entry if 'use_initial_guess' is true.
+  * @param use_initial_guess  If false, the iteration starts from a zero initial guess
+  * @param tag        Solver configuration tag
+  * @param precond    A preconditioner. Precondition operation is done via member function apply()
+  * @param ws         Buffers, which are reused across calls
+  * @param monitor    Monitor called after each iteration. The current approximation is only formed if a monitor is set.
+  */
+  template<typename MatrixT, typename VectorT, typename PreconditionerT>
+  void solve_impl(MatrixT const & matrix,
+                  VectorT const & rhs,
+                  VectorT & result,
+                  bool use_initial_guess,
+                  gmres_tag const & tag,
+                  PreconditionerT const & precond,
+                  gmres_householder_workspace<VectorT> & ws,
+                  solver_monitor<VectorT> const & monitor)
+  {
+    typedef typename viennacl::result_of::value_type<VectorT>::type            NumericType;
+    typedef typename viennacl::result_of::cpu_value_type<NumericType>::type    CPU_NumericType;
+    unsigned int problem_size = static_cast<unsigned int>(viennacl::traits::size(rhs));
 
-  std::vector<VectorT>          householder_reflectors(krylov_dim, rhs);
-  std::vector<CPU_NumericType>  betas(krylov_dim);
+    vcl_size_t krylov_dim = static_cast<vcl_size_t>(tag.krylov_dim());
+    if (problem_size < krylov_dim)
+      krylov_dim = problem_size; //A Krylov space larger than the matrix would lead to seg-faults (mathematically, error is certain to be zero already)
 
-  CPU_NumericType norm_rhs = viennacl::linalg::norm_2(rhs);
+    ws.init(rhs, krylov_dim, tag.krylov_dim());
+    if (monitor.is_set())
+      detail::prepare_workspace_vector(ws.monitor_result, rhs);
 
-  if (norm_rhs <= 0) //solution is zero if RHS norm is zero
-    return result;
+    VectorT & res = ws.res;
+    VectorT & v_k_tilde = ws.v_k_tilde;
+    VectorT & v_k_tilde_temp = ws.v_k_tilde_temp;
 
-  tag.iters(0);
+    std::vector< std::vector<CPU_NumericType> > & R = ws.R;
+    std::vector<CPU_NumericType> & projection_rhs = ws.projection_rhs;
 
-  for (unsigned int it = 0; it <= tag.max_restarts(); ++it)
-  {
-    //
-    // (Re-)Initialize residual: r = b - A*x (without temporary for the result of A*x)
-    //
-    res = rhs;
-    res -= viennacl::linalg::prod(matrix, result);  //initial guess zero
-    precond.apply(res);
+    std::vector<VectorT>          & householder_reflectors = ws.householder_reflectors;
+    std::vector<CPU_NumericType>  & betas = ws.betas;
 
-    CPU_NumericType rho_0 = viennacl::linalg::norm_2(res);
+    CPU_NumericType norm_rhs = viennacl::linalg::norm_2(rhs);
 
-    //
-    // Check for premature convergence
-    //
-    if (rho_0 / norm_rhs < tag.tolerance() ) // norm_rhs is known to be nonzero here
+    tag.iters(0);
+    tag.error(0);
+
+    if (norm_rhs <= 0) //solution is zero if RHS norm is zero
     {
-      tag.error(rho_0 / norm_rhs);
-      return result;
+      viennacl::traits::clear(result);
+      return;
     }
 
-    //
-    // Normalize residual and set 'rho' to 1 as requested in 'A Simpler GMRES' by Walker and Zhou.
-    //
-    res /= rho_0;
-    CPU_NumericType rho = static_cast<CPU_NumericType>(1.0);
+    if (!use_initial_guess)
+      viennacl::traits::clear(result);
 
-
-    //
-    // Iterate up until maximal Krylove space dimension is reached:
-    //
-    vcl_size_t k = 0;
-    for (k = 0; k < krylov_dim; ++k)
+    for (unsigned int it = 0; it <= tag.max_restarts(); ++it)
     {
-      tag.iters( tag.iters() + 1 ); //increase iteration counter
+      //
+      // (Re-)Initialize residual: r = b - A*x (without temporary for the result of A*x)
+      //
+      res = rhs;
+      res -= viennacl::linalg::prod(matrix, result);
+      precond.apply(res);
 
-      // prepare storage:
-      viennacl::traits::clear(R[k]);
-      viennacl::traits::clear(householder_reflectors[k]);
+      CPU_NumericType rho_0 = viennacl::linalg::norm_2(res);
 
-      //compute v_k = A * v_{k-1} via Householder matrices
-      if (k == 0)
-      {
-        v_k_tilde = viennacl::linalg::prod(matrix, res);
-        precond.apply(v_k_tilde);
-      }
-      else
+      //
+      // Check for premature convergence
+      //
+      if (rho_0 / norm_rhs < tag.tolerance() ) // norm_rhs is known to be nonzero here
       {
-        viennacl::traits::clear(v_k_tilde);
-        v_k_tilde[k-1] = CPU_NumericType(1);
-
-        //Householder rotations, part 1: Compute P_1 * P_2 * ... * P_{k-1} * e_{k-1}
-        for (int i = static_cast<int>(k)-1; i > -1; --i)
-          detail::gmres_householder_reflect(v_k_tilde, householder_reflectors[vcl_size_t(i)], betas[vcl_size_t(i)]);
-
-        v_k_tilde_temp = viennacl::linalg::prod(matrix, v_k_tilde);
-        precond.apply(v_k_tilde_temp);
-        v_k_tilde = v_k_tilde_temp;
-
-        //Householder rotations, part 2: Compute P_{k-1} * ... * P_{1} * v_k_tilde
-        for (vcl_size_t i = 0; i < k; ++i)
-          detail::gmres_householder_reflect(v_k_tilde, householder_reflectors[i], betas[i]);
+        tag.error(rho_0 / norm_rhs);
+        return;
       }
 
       //
-      // Compute Householder reflection for v_k_tilde such that all entries below k-th entry are zero:
+      // Normalize residual and set 'rho' to 1 as requested in 'A Simpler GMRES' by Walker and Zhou.
       //
-      CPU_NumericType rho_k_k = 0;
-      detail::gmres_setup_householder_vector(v_k_tilde, householder_reflectors[k], betas[k], rho_k_k, k);
+      res /= rho_0;
+      CPU_NumericType rho = static_cast<CPU_NumericType>(1.0);
 
-      //
-      // copy first k entries from v_k_tilde to R[k] in order to fill k-th column with result of
-      // P_k * v_k_tilde = (v[0], ... , v[k-1], norm(v), 0, 0, ...) =: (rho_{1,k}, rho_{2,k}, ..., rho_{k,k}, 0, ..., 0);
-      //
-      detail::gmres_copy_helper(v_k_tilde, R[k], k);
-      R[k][k] = rho_k_k;
 
       //
-      // Update residual: r = P_k r
-      // Set zeta_k = r[k] including machine precision considerations: mathematically we have |r[k]| <= rho
-      // Set rho *= sin(acos(r[k] / rho))
+      // Iterate up until maximal Krylove space dimension is reached:
       //
-      detail::gmres_householder_reflect(res, householder_reflectors[k], betas[k]);
+      vcl_size_t k = 0;
+      for (k = 0; k < krylov_dim; ++k)
+      {
+        tag.iters( tag.iters() + 1 ); //increase iteration counter
 
-      if (res[k] > rho) //machine precision reached
-        res[k] = rho;
-      if (res[k] < -rho) //machine precision reached
-        res[k] = -rho;
-      projection_rhs[k] = res[k];
+        // prepare storage:
+        viennacl::traits::clear(R[k]);
+        viennacl::traits::clear(householder_reflectors[k]);
 
-      rho *= std::sin( std::acos(projection_rhs[k] / rho) );
+        //compute v_k = A * v_{k-1} via Householder matrices
+        if (k == 0)
+        {
+          v_k_tilde = viennacl::linalg::prod(matrix, res);
+          precond.apply(v_k_tilde);
+        }
+        else
+        {
+          viennacl::traits::clear(v_k_tilde);
+          v_k_tilde[k-1] = CPU_NumericType(1);
 
-      if (std::fabs(rho * rho_0 / norm_rhs) < tag.tolerance())  // Residual is sufficiently reduced, stop here
-      {
-        tag.error( std::fabs(rho*rho_0 / norm_rhs) );
-        ++k;
-        break;
-      }
-    } // for k
+          //Householder rotations, part 1: Compute P_1 * P_2 * ... * P_{k-1} * e_{k-1}
+          for (int i = static_cast<int>(k)-1; i > -1; --i)
+            detail::gmres_householder_reflect(v_k_tilde, householder_reflectors[vcl_size_t(i)], betas[vcl_size_t(i)]);
 
-    //
-    // Triangular solver stage:
-    //
+          v_k_tilde_temp = viennacl::linalg::prod(matrix, v_k_tilde);
+          precond.apply(v_k_tilde_temp);
+          v_k_tilde = v_k_tilde_temp;
 
-    for (int i2=static_cast<int>(k)-1; i2>-1; --i2)
-    {
-      vcl_size_t i = static_cast<vcl_size_t>(i2);
-      for (vcl_size_t j=i+1; j<k; ++j)
-        projection_rhs[i] -= R[j][i] * projection_rhs[j];     //R is transposed
+          //Householder rotations, part 2: Compute P_{k-1} * ... * P_{1} * v_k_tilde
+          for (vcl_size_t i = 0; i < k; ++i)
+            detail::gmres_householder_reflect(v_k_tilde, householder_reflectors[i], betas[i]);
+        }
 
-      projection_rhs[i] /= R[i][i];
-    }
+        //
+        // Compute Householder reflection for v_k_tilde such that all entries below k-th entry are zero:
+        //
+        CPU_NumericType rho_k_k = 0;
+        detail::gmres_setup_householder_vector(v_k_tilde, householder_reflectors[k], betas[k], rho_k_k, k);
+
+        //
+        // copy first k entries from v_k_tilde to R[k] in order to fill k-th column with result of
+        // P_k * v_k_tilde = (v[0], ... , v[k-1], norm(v), 0, 0, ...) =: (rho_{1,k}, rho_{2,k}, ..., rho_{k,k}, 0, ..., 0);
+        //
+        detail::gmres_copy_helper(v_k_tilde, R[k], k);
+        R[k][k] = rho_k_k;
+
+        //
+        // Update residual: r = P_k r
+        // Set zeta_k = r[k] including machine precision considerations: mathematically we have |r[k]| <= rho
+        // Set rho *= sin(acos(r[k] / rho))
+        //
+        detail::gmres_householder_reflect(res, householder_reflectors[k], betas[k]);
+
+        if (res[k] > rho) //machine precision reached
+          res[k] = rho;
+        if (res[k] < -rho) //machine precision reached
+          res[k] = -rho;
+        projection_rhs[k] = res[k];
+
+        rho *= std::sin( std::acos(projection_rhs[k] / rho) );
+
+        if (std::fabs(rho * rho_0 / norm_rhs) < tag.tolerance())  // Residual is sufficiently reduced, stop here
+        {
+          tag.error( std::fabs(rho*rho_0 / norm_rhs) );
+          ++k;
+          break;
+        }
 
-    //
-    // Note: 'projection_rhs' now holds the solution (eta_1, ..., eta_k)
-    //
+        if (monitor.is_set()) // form the current approximation from copies, since 'res' and 'projection_rhs' are needed for the next iteration
+        {
+          tag.error( std::fabs(rho*rho_0 / norm_rhs) );
+          ws.monitor_result = res;
+          ws.monitor_projection_rhs = projection_rhs;
+          detail::gmres_householder_form_update(ws.monitor_result, ws.monitor_projection_rhs, R, householder_reflectors, betas, k+1);
+          ws.monitor_result *= rho_0;
+          ws.monitor_result += result;
+          if (monitor(ws.monitor_result, static_cast<CPU_NumericType>(tag.error())))
+          {
+            result = ws.monitor_result;
+            return;
+          }
+        }
+      } // for k
 
-    res *= projection_rhs[0];
+      detail::gmres_householder_form_update(res, projection_rhs, R, householder_reflectors, betas, k);
+      res *= rho_0;
+      result += res;  // x += rho_0 * z    in the paper
 
-    if (k > 0)
-    {
-      for (unsigned int i = 0; i < k-1; ++i)
-        res[i] += projection_rhs[i+1];
+      //
+      // Check for convergence:
+      //
+      tag.error(std::fabs(rho*rho_0 / norm_rhs));
+      if ( tag.error() < tag.tolerance() )
+        return;
     }
+  }
 
-    //
-    // Form z inplace in 'res' by applying P_1 * ... * P_{k}
-    //
-    for (int i=static_cast<int>(k)-1; i>=0; --i)
-      detail::gmres_householder_reflect(res, householder_reflectors[vcl_size_t(i)], betas[vcl_size_t(i)]);
+}
+
+/** @brief Implementation of the GMRES solver.
+*
+* Following the algorithm proposed by Walker in "A Simpler GMRES"
+*
+* @param matrix     The system matrix
+* @param rhs        The load vector
+* @param tag        Solver configuration tag
+* @param precond    A preconditioner. Precondition operation is done via member function apply()
+* @return The result vector
+*/
+template<typename MatrixT, typename VectorT, typename PreconditionerT>
+VectorT solve(MatrixT const & matrix, VectorT const & rhs, gmres_tag const & tag, PreconditionerT const & precond)
+{
+  VectorT result = rhs;
+  viennacl::traits::clear(result);
 
-    res *= rho_0;
-    result += res;  // x += rho_0 * z    in the paper
+  if (detail::gmres_use_arnoldi(tag) && detail::gmres_try_arnoldi(matrix, rhs, result, tag, precond))
+    return result;
 
-    //
-    // Check for convergence:
-    //
-    tag.error(std::fabs(rho*rho_0 / norm_rhs));
-    if ( tag.error() < tag.tolerance() )
-      return result;
-  }
+  detail::gmres_householder_workspace<VectorT> ws;
+  detail::solve_impl(matrix, rhs, result, false, tag, precond, ws, detail::solver_monitor<VectorT>());
 
   return result;
 }
@@ -763,6 +1266,106 @@ VectorT solve(MatrixT const & A, VectorT const & rhs, gmres_tag const & tag)
 }
 
 
+namespace detail
+{
+  /** @brief Generic vector types use the implementation based on Householder reflections with the buffers owned by the solver object */
+  template<typename MatrixT, typename VectorT, typename PreconditionerT>
+  void run_solver(MatrixT const & A, VectorT const & rhs, VectorT & result, bool use_initial_guess, gmres_tag const & tag, PreconditionerT const & precond,
+                  gmres_workspace<VectorT> & ws, solver_monitor<VectorT> const & monitor)
+  {
+    solve_impl(A, rhs, result, use_initial_guess, tag, precond, ws, monitor);
+  }
+
+  /** @brief ViennaCL vectors use the Arnoldi-based implementation with the buffers owned by the solver object */
+  template<typename MatrixT, typename NumericT, typename PreconditionerT>
+  void run_solver(MatrixT const & A, viennacl::vector<NumericT> const & rhs, viennacl::vector<NumericT> & result, bool use_initial_guess, gmres_tag const & tag, PreconditionerT const & precond,
+                  gmres_workspace< viennacl::vector<NumericT> > & ws, solver_monitor< viennacl::vector<NumericT> > const & monitor)
+  {
+    gmres_arnoldi_solve(A, rhs, result, tag, precond, ws, use_initial_guess, monitor);
+  }
+}
+
+/** @brief A GMRES solver object, which owns the Krylov basis and all other buffers of the solver.
+*
+* For ViennaCL vectors the Arnoldi-based implementation is used, where the orthogonalization scheme and flexible preconditioning are selected in the tag (modified Gram-Schmidt if Householder reflections are requested).
+* Other vector types use Householder reflections.
+* The buffers are kept after a solver run, so repeated solves of systems with the same size do not allocate new buffers.
+* An initial guess can be provided either via set_initial_guess() or by passing the result vector to solve(), which then iterates in place.
+* A monitor callback set via set_monitor() is called after each iteration and may stop the solver run by returning true.
+* Since GMRES forms the approximation of the solution only at the end of each restart cycle, it is formed additionally in each iteration if a monitor is set.
+*/
+template<typename VectorT>
+class gmres_solver
+{
+public:
+  typedef typename detail::solver_monitor<VectorT>::numeric_type    numeric_type;
+
+  gmres_solver(gmres_tag const & tag = gmres_tag()) : tag_(tag), use_initial_guess_(false) {}
+
+  /** @brief Solves A x = b using the preconditioner 'precond' and returns x. Starts from the initial guess if one is set.
+  *
+  * The result is kept in a buffer of the solver object, hence no memory is allocated if the system size does not change.
+  * The returned reference is valid until the next call of operator().
+  */
+  template<typename MatrixT, typename PreconditionerT>
+  VectorT const & operator()(MatrixT const & A, VectorT const & b, PreconditionerT const & precond) const
+  {
+    detail::prepare_workspace_vector(result_, b);
+    if (use_initial_guess_)
+      result_ = init_guess_;
+    else
+      viennacl::traits::clear(result_);
+    detail::run_solver(A, b, result_, use_initial_guess_, tag_, precond, workspace_, monitor_);
+    return result_;
+  }
+
+  /** @brief Solves A x = b without preconditioner and returns x. Starts from the initial guess if one is set. */
+  template<typename MatrixT>
+  VectorT const & operator()(MatrixT const & A, VectorT const & b) const
+  {
+    return operator()(A, b, viennacl::linalg::no_precond());
+  }
+
+  /** @brief Solves A x = b in place using the preconditioner 'precond'. The entries of 'x' on entry are used as initial guess. No buffers are allocated if the system size does not change. */
+  template<typename MatrixT, typename PreconditionerT>
+  void solve(MatrixT const & A, VectorT const & b, VectorT & x, PreconditionerT const & precond) const
+  {
+    detail::run_solver(A, b, x, true, tag_, precond, workspace_, monitor_);
+  }
+
+  /** @brief Solves A x = b in place without preconditioner. The entries of 'x' on entry are used as initial guess. */
+  template<typename MatrixT>
+  void solve(MatrixT const & A, VectorT const & b, VectorT & x) const
+  {
+    solve(A, b, x, viennacl::linalg::no_precond());
+  }
+
+  /** @brief Sets the initial guess used by operator() */
+  void set_initial_guess(VectorT const & x)
+  {
+    detail::prepare_workspace_vector(init_guess_, x);
+    init_guess_ = x;
+    use_initial_guess_ = true;
+  }
+
+  /** @brief Sets a monitor, which is called after each iteration with the current result, the estimated relative residual and 'user_data'. The solver stops if the monitor returns true. */
+  void set_monitor(bool (*monitor_fun)(VectorT const &, numeric_type, void *), void * user_data)
+  {
+    monitor_.set(monitor_fun, user_data);
+  }
+
+  /** @brief Returns the solver tag holding the configuration as well as the number of iterations and the estimated error of the last run */
+  gmres_tag const & tag() const { return tag_; }
+
+private:
+  gmres_tag tag_;
+  VectorT init_guess_;
+  mutable VectorT result_;
+  bool use_initial_guess_;
+  detail::solver_monitor<VectorT> monitor_;
+  mutable detail::gmres_workspace<VectorT> workspace_;
+};
+
 }
 }
 
@@ -403,6 +403,67 @@ void pipelined_cg_vector_update(vector_base<NumericT> & result,
 }
 
 
+/** @brief Performs a joint vector update operation needed for the Chebyshev iteration and for polynomial preconditioners.
+  *
+  * This routines computes for vectors 'x', 'r', 'd', 'Ad':
+  *   x += d;
+  *   r -= Ad;
+  *   d  = alpha * d + beta * diag_inv .* r;
+  * where the diagonal scaling with 'diag_inv' is skipped if 'diag_inv' is NULL. No reduction is involved.
+  */
+template<typename NumericT>
+void chebyshev_vector_update(vector_base<NumericT> & x,
+                             vector_base<NumericT> & r,
+                             vector_base<NumericT> & d,
+                             vector_base<NumericT> const & Ad,
+                             NumericT alpha,
+                             NumericT beta,
+                             vector_base<NumericT> const * diag_inv)
+{
+  typedef NumericT       value_type;
+
+  value_type       * data_x  = detail::extract_raw_pointer<value_type>(x) + viennacl::traits::start(x);
+  value_type       * data_r  = detail::extract_raw_pointer<value_type>(r) + viennacl::traits::start(r);
+  value_type       * data_d  = detail::extract_raw_pointer<value_type>(d) + viennacl::traits::start(d);
+  value_type const * data_Ad = detail::extract_raw_pointer<value_type>(Ad) + viennacl::traits::start(Ad);
+  value_type const * data_diag_inv = diag_inv ? detail::extract_raw_pointer<value_type>(*diag_inv) + viennacl::traits::start(*diag_inv) : NULL;
+
+  // Note: The vectors are work vectors of the solvers, hence there is no need to check for strides
+  long size = static_cast<long>(viennacl::traits::size(x));
+
+  if (data_diag_inv)
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+    for (long i = 0; i < size; ++i)
+    {
+      value_type value_d = data_d[i];
+      value_type value_r = data_r[i] - data_Ad[i];
+
+      data_x[i] += value_d;
+      data_r[i]  = value_r;
+      data_d[i]  = alpha * value_d + beta * data_diag_inv[i] * value_r;
+    }
+  }
+  else
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+    for (long i = 0; i < size; ++i)
+    {
+      value_type value_d = data_d[i];
+      value_type value_r = data_r[i] - data_Ad[i];
+
+      data_x[i] += value_d;
+      data_r[i]  = value_r;
+      data_d[i]  = alpha * value_d + beta * value_r;
+    }
+  }
+}
+
+
 /** @brief Performs a fused matrix-vector product with a compressed_matrix for an efficient pipelined CG algorithm.
   *
   * This routines computes for a matrix A and vectors 'p' and 'Ap':
@@ -801,14 +862,20 @@ void pipelined_gmres_gram_schmidt_stage2(vector_base<T> & device_krylov_basis,
 {
   typedef T        value_type;
 
-  value_type * data_krylov_basis = detail::extract_raw_pointer<value_type>(device_krylov_basis);
+  value_type       * data_krylov_basis = detail::extract_raw_pointer<value_type>(device_krylov_basis);
+  value_type const * data_vi_in_vk     = detail::extract_raw_pointer<value_type>(vi_in_vk_buffer);
+  value_type       * data_R            = detail::extract_raw_pointer<value_type>(R_buffer);
+  value_type       * data_buffer       = detail::extract_raw_pointer<value_type>(inner_prod_buffer);
 
-  std::vector<T> values_vi_in_vk(k);
-
-  // Step 1: Finish reduction of <v_i, v_k> to obtain scalars:
+  // Step 1: Finish reduction of <v_i, v_k> to obtain scalars. These are written to R_buffer right away, so no temporary is needed:
+  value_type * values_vi_in_vk = data_R + k * krylov_dim;
   for (std::size_t i=0; i<k; ++i)
+  {
+    value_type value_vi_in_vk = 0;
     for (vcl_size_t j=0; j<buffer_chunk_size; ++j)
-      values_vi_in_vk[i] += vi_in_vk_buffer[i*buffer_chunk_size + j];
+      value_vi_in_vk += data_vi_in_vk[i*buffer_chunk_size + j];
+    values_vi_in_vk[i] = value_vi_in_vk;
+  }
 
 
   // Step 2: Compute v_k -= <v_i, v_k> v_i and reduction on ||v_k||:
@@ -824,11 +891,7 @@ void pipelined_gmres_gram_schmidt_stage2(vector_base<T> & device_krylov_basis,
     data_krylov_basis[static_cast<vcl_size_t>(i) + k * v_k_internal_size] = value_vk;
   }
 
-  // Step 3: Write values to R_buffer:
-  for (std::size_t i=0; i<k; ++i)
-    R_buffer[i + k * krylov_dim] = values_vi_in_vk[i];
-
-  inner_prod_buffer[buffer_chunk_size] = norm_vk;
+  data_buffer[buffer_chunk_size] = norm_vk;
 }
 
 /** @brief Computes x += eta_0 r + sum_{i=1}^{k-1} eta_i v_{i-1} */
@@ -22,6 +22,9 @@
     @brief Implementations of dense matrix related operations, including matrix-vector products, using a plain single-threaded or OpenMP-enabled execution on CPU.
 */
 
+#include <vector>
+#include <algorithm>
+
 #include "viennacl/forwards.h"
 #include "viennacl/scalar.hpp"
 #include "viennacl/vector.hpp"
@@ -37,6 +40,20 @@
 #include "viennacl/linalg/detail/op_applier.hpp"
 #include "viennacl/linalg/host_based/common.hpp"
 
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+// Minimum vector size for using OpenMP on vector operations:
+#ifndef VIENNACL_OPENMP_VECTOR_MIN_SIZE
+  #define VIENNACL_OPENMP_VECTOR_MIN_SIZE  5000
+#endif
+
+// Number of independent partial sums per row in the matrix-vector kernels, chosen such that the compiler can map them to SIMD registers:
+#ifndef VIENNACL_HOST_GEMV_LANES
+  #define VIENNACL_HOST_GEMV_LANES  8
+#endif
+
 namespace viennacl
 {
 namespace linalg
@@ -48,53 +65,222 @@ namespace host_based
 // Introductory note: By convention, all dimensions are already checked in the dispatcher frontend. No need to double-check again in here!
 //
 
-template<typename NumericT,
-         typename SizeT, typename DistanceT>
-void trans(const matrix_expression<const matrix_base<NumericT, SizeT, DistanceT>,
-           const matrix_base<NumericT, SizeT, DistanceT>, op_trans> & proxy, matrix_base<NumericT> & temp_trans)
+namespace detail
 {
-  const NumericT * temp_proxy = detail::extract_raw_pointer<NumericT>(proxy.lhs());
-  NumericT * temp = detail::extract_raw_pointer<NumericT>(temp_trans);
+  /** @brief Describes the location of the entries of a dense matrix (or submatrix) in memory: Entry (i, j) is located at data[i * row_inc + j * col_inc] */
+  template<typename NumericT>
+  struct dense_strides
+  {
+    NumericT & operator()(vcl_size_t i, vcl_size_t j) const { return data[i * row_inc + j * col_inc]; }
+
+    /** @brief Returns the description of the transposed matrix, which refers to the same memory */
+    dense_strides transposed() const
+    {
+      dense_strides s = *this;
+      std::swap(s.row_inc, s.col_inc);
+      return s;
+    }
+
+    NumericT * data;
+    vcl_size_t row_inc;
+    vcl_size_t col_inc;
+  };
+
+  template<typename MatrixT, typename PointerT>
+  dense_strides<PointerT> make_dense_strides(MatrixT const & A, PointerT * data)
+  {
+    dense_strides<PointerT> s;
+    if (A.row_major())
+    {
+      s.data    = data + A.start1() * A.internal_size2() + A.start2();
+      s.row_inc = A.stride1() * A.internal_size2();
+      s.col_inc = A.stride2();
+    }
+    else
+    {
+      s.data    = data + A.start1() + A.start2() * A.internal_size1();
+      s.row_inc = A.stride1();
+      s.col_inc = A.stride2() * A.internal_size1();
+    }
+    return s;
+  }
 
-  vcl_size_t proxy_int_size1=proxy.lhs().internal_size1();
-  vcl_size_t proxy_int_size2=proxy.lhs().internal_size2();
-  vcl_size_t temp_int_size1=temp_trans.internal_size1();
-  vcl_size_t temp_int_size2=temp_trans.internal_size2();
+  /** @brief Block size for the cache-blocked transposition. A block of the source and a block of the destination fit into the L1 cache. */
+  static const vcl_size_t transpose_block_size = 32;
+
+  /** @brief Writes B(j, i) = A(i, j) for a block of A with rows [row_begin, row_end) and columns [col_begin, col_end).
+  *
+  * If A is read and B is written with unit stride, the block is processed in 4x4 tiles held in registers,
+  * which the compiler maps to vector loads, shuffles and vector stores.
+  */
+  template<typename NumericT>
+  void transpose_block(NumericT const * A, vcl_size_t A_row_inc, vcl_size_t A_col_inc,
+                       NumericT       * B, vcl_size_t B_row_inc, vcl_size_t B_col_inc,
+                       vcl_size_t row_begin, vcl_size_t row_end, vcl_size_t col_begin, vcl_size_t col_end)
+  {
+    vcl_size_t i = row_begin;
+    if (A_col_inc == 1 && B_col_inc == 1)
+    {
+      for (; i + 4 <= row_end; i += 4)
+      {
+        vcl_size_t j = col_begin;
+        for (; j + 4 <= col_end; j += 4)
+        {
+          NumericT tile[4][4];
+          for (vcl_size_t k = 0; k < 4; ++k)
+            for (vcl_size_t l = 0; l < 4; ++l)
+              tile[l][k] = A[(i + k) * A_row_inc + j + l];
+          for (vcl_size_t l = 0; l < 4; ++l)
+            for (vcl_size_t k = 0; k < 4; ++k)
+              B[(j + l) * B_row_inc + i + k] = tile[l][k];
+        }
+        for (; j < col_end; ++j)
+          for (vcl_size_t k = 0; k < 4; ++k)
+            B[j * B_row_inc + i + k] = A[(i + k) * A_row_inc + j];
+      }
+    }
+
+    // general strides and remainder rows:
+    if (A_col_inc < A_row_inc) // stream along rows of A
+    {
+      for (; i < row_end; ++i)
+        for (vcl_size_t j = col_begin; j < col_end; ++j)
+          B[j * B_row_inc + i * B_col_inc] = A[i * A_row_inc + j * A_col_inc];
+    }
+    else // stream along columns of A
+    {
+      for (vcl_size_t j = col_begin; j < col_end; ++j)
+        for (vcl_size_t k = i; k < row_end; ++k)
+          B[j * B_row_inc + k * B_col_inc] = A[k * A_row_inc + j * A_col_inc];
+    }
+  }
+
+  /** @brief Writes B(j, i) = A(i, j) for an rows-by-cols matrix A, processed in cache-sized blocks in parallel */
+  template<typename NumericT>
+  void transpose_blocked(dense_strides<NumericT const> const & A, dense_strides<NumericT> const & B, vcl_size_t rows, vcl_size_t cols)
+  {
+    vcl_size_t block_size = transpose_block_size;
+    vcl_size_t num_blocks_rows = (rows + block_size - 1) / block_size;
+    vcl_size_t num_blocks_cols = (cols + block_size - 1) / block_size;
 
 #ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for
+    #pragma omp parallel for if (rows * cols > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
 #endif
-  for (long i2 = 0; i2 < static_cast<long>(proxy_int_size1*proxy_int_size2); ++i2)
+    for (long b = 0; b < static_cast<long>(num_blocks_rows * num_blocks_cols); ++b)
+    {
+      vcl_size_t row_begin = (static_cast<vcl_size_t>(b) / num_blocks_cols) * block_size;
+      vcl_size_t col_begin = (static_cast<vcl_size_t>(b) % num_blocks_cols) * block_size;
+      transpose_block(A.data, A.row_inc, A.col_inc, B.data, B.row_inc, B.col_inc,
+                      row_begin, std::min(row_begin + block_size, rows),
+                      col_begin, std::min(col_begin + block_size, cols));
+    }
+  }
+
+  /** @brief Transposes the leading n-by-n block of a square array with leading dimension ld in place, processing pairs of cache-sized blocks in parallel */
+  template<typename NumericT>
+  void transpose_inplace_square(NumericT * A, vcl_size_t ld, vcl_size_t n)
   {
-    vcl_size_t row = vcl_size_t(i2) / proxy_int_size2;
-    vcl_size_t col = vcl_size_t(i2) % proxy_int_size2;
+    vcl_size_t block_size = transpose_block_size;
+    vcl_size_t num_blocks = (n + block_size - 1) / block_size;
 
-    if (row < proxy.lhs().size1() && col < proxy.lhs().size2())
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for schedule(dynamic) if (n * n > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+    for (long bi = 0; bi < static_cast<long>(num_blocks); ++bi)
     {
-      if (proxy.lhs().row_major())
+      vcl_size_t row_begin = static_cast<vcl_size_t>(bi) * block_size;
+      vcl_size_t row_end   = std::min(row_begin + block_size, n);
+
+      // diagonal block:
+      for (vcl_size_t i = row_begin; i < row_end; ++i)
+        for (vcl_size_t j = row_begin; j < i; ++j)
+          std::swap(A[i * ld + j], A[j * ld + i]);
+
+      // pairs of off-diagonal blocks:
+      for (vcl_size_t col_begin = row_end; col_begin < n; col_begin += block_size)
       {
-        vcl_size_t pos = row_major::mem_index(proxy.lhs().start1() + proxy.lhs().stride1() * row,
-                                              proxy.lhs().start2() + proxy.lhs().stride2() * col,
-                                              proxy_int_size1, proxy_int_size2);
-        vcl_size_t new_pos = row_major::mem_index(temp_trans.start2() + temp_trans.stride2() * col,
-                                                  temp_trans.start1() + temp_trans.stride1() * row, temp_int_size1,
-                                                  temp_int_size2);
-        temp[new_pos] = temp_proxy[pos];
+        vcl_size_t col_end = std::min(col_begin + block_size, n);
+        for (vcl_size_t i = row_begin; i < row_end; ++i)
+          for (vcl_size_t j = col_begin; j < col_end; ++j)
+            std::swap(A[i * ld + j], A[j * ld + i]);
       }
-      else
+    }
+  }
+
+  /** @brief Transposes a rows-by-cols array stored row by row (without gaps) in place by following the cycles of the permutation.
+  *
+  * The entry at position p is moved to position (p * rows) mod (rows * cols - 1). Visited positions are tracked in a bit vector.
+  */
+  template<typename NumericT>
+  void transpose_inplace_cycles(NumericT * A, vcl_size_t rows, vcl_size_t cols)
+  {
+    vcl_size_t N = rows * cols;
+    if (rows < 2 || cols < 2)
+      return;
+
+    std::vector<bool> visited(N, false);
+    for (vcl_size_t start = 1; start < N - 1; ++start)
+    {
+      if (visited[start])
+        continue;
+
+      NumericT value = A[start];
+      vcl_size_t p = start;
+      do
       {
-        vcl_size_t pos = column_major::mem_index(proxy.lhs().start1() + proxy.lhs().stride1() * row,
-                                                 proxy.lhs().start2() + proxy.lhs().stride2() * col, proxy_int_size1,
-                                                 proxy_int_size2);
-        vcl_size_t new_pos = column_major::mem_index(temp_trans.start2() + temp_trans.stride2() * col,
-                                                     temp_trans.start1() + temp_trans.stride1() * row, temp_int_size1,
-                                                     temp_int_size2);
-        temp[new_pos] = temp_proxy[pos];
-      }
+        p = (p * rows) % (N - 1);
+        std::swap(value, A[p]);
+        visited[p] = true;
+      } while (p != start);
     }
   }
 }
 
+
+/** @brief Writes the transpose of a matrix to another matrix, i.e. temp_trans = trans(proxy.lhs()).
+*
+* The matrix is processed in cache-sized blocks in parallel. Padding entries are not touched, and the two matrices may use different memory layouts.
+*
+* @param proxy       Expression template of the transposed matrix
+* @param temp_trans  The result matrix
+*/
+template<typename NumericT,
+         typename SizeT, typename DistanceT>
+void trans(const matrix_expression<const matrix_base<NumericT, SizeT, DistanceT>,
+           const matrix_base<NumericT, SizeT, DistanceT>, op_trans> & proxy, matrix_base<NumericT> & temp_trans)
+{
+  matrix_base<NumericT, SizeT, DistanceT> const & A = proxy.lhs();
+
+  detail::dense_strides<NumericT const> src = detail::make_dense_strides(A, detail::extract_raw_pointer<NumericT>(A));
+  detail::dense_strides<NumericT>       dst = detail::make_dense_strides(temp_trans, detail::extract_raw_pointer<NumericT>(temp_trans));
+
+  detail::transpose_blocked(src, dst, A.size1(), A.size2());
+}
+
+/** @brief Transposes a matrix in place, i.e. replaces the buffer of the size1-by-size2 matrix A by the buffer of the transposed size2-by-size1 matrix with the same memory layout.
+*
+* The whole buffer including the padding is transposed, so the transposed matrix has internal sizes internal_size2(A)-by-internal_size1(A).
+* Square buffers are transposed by swapping pairs of blocks. Rectangular buffers are transposed by following the cycles of the underlying permutation,
+* which does not require additional memory for the entries, but is not parallelized.
+* Updating the sizes of A is left to the caller. A must not be a submatrix.
+*
+* @param A   The matrix
+*/
+template<typename NumericT>
+void trans_inplace(matrix_base<NumericT> & A)
+{
+  NumericT * data = detail::extract_raw_pointer<NumericT>(A);
+
+  // dimensions of the buffer in terms of stored rows (rows for row-major, columns for column-major)
+  vcl_size_t rows = A.row_major() ? A.internal_size1() : A.internal_size2();
+  vcl_size_t cols = A.row_major() ? A.internal_size2() : A.internal_size1();
+
+  if (rows == cols)
+    detail::transpose_inplace_square(data, cols, std::max(A.size1(), A.size2())); // all entries outside are padding
+  else
+    detail::transpose_inplace_cycles(data, rows, cols);
+}
+
 template<typename NumericT, typename ScalarT1>
 void am(matrix_base<NumericT> & mat1,
         matrix_base<NumericT> const & mat2, ScalarT1 const & alpha, vcl_size_t /*len_alpha*/, bool reciprocal_alpha, bool flip_sign_alpha)
@@ -848,108 +1034,443 @@ void element_op(matrix_base<NumericT> & A,
 
 // A * x
 
-/** @brief Carries out matrix-vector multiplication
-*
-* Implementation of the convenience expression result = prod(mat, vec);
-*
-* @param mat    The matrix
-* @param trans  Flag whether mat is to be transposed
-* @param vec    The vector
-* @param result The result vector
-*/
-template<typename NumericT>
-void prod_impl(const matrix_base<NumericT> & mat, bool trans,
-               const vector_base<NumericT> & vec,
-                     vector_base<NumericT> & result)
+namespace detail
 {
-  typedef NumericT        value_type;
+  /** @brief Computes result[r] = sum_c S(r, c) * x[c] for rows [row_begin, row_end) of a matrix S stored row by row with unit stride within a row.
+  *
+  * Four rows are processed at once, so that each entry of x is loaded once per four rows.
+  */
+  template<typename NumericT>
+  void gemv_dot_rows(NumericT const * S, vcl_size_t ld, vcl_size_t row_begin, vcl_size_t row_end, vcl_size_t cols,
+                     NumericT const * x, NumericT * result, vcl_size_t result_inc)
+  {
+    vcl_size_t const lanes = VIENNACL_HOST_GEMV_LANES;
+    vcl_size_t cols_simd = (cols / lanes) * lanes;
 
-  value_type const * data_A = detail::extract_raw_pointer<value_type>(mat);
-  value_type const * data_x = detail::extract_raw_pointer<value_type>(vec);
-  value_type       * data_result = detail::extract_raw_pointer<value_type>(result);
+    vcl_size_t r = row_begin;
+    for (; r + 4 <= row_end; r += 4)
+    {
+      NumericT const * a0 = S + r * ld;
+      NumericT const * a1 = a0 + ld;
+      NumericT const * a2 = a1 + ld;
+      NumericT const * a3 = a2 + ld;
+
+      NumericT acc0[VIENNACL_HOST_GEMV_LANES] = {0}, acc1[VIENNACL_HOST_GEMV_LANES] = {0};
+      NumericT acc2[VIENNACL_HOST_GEMV_LANES] = {0}, acc3[VIENNACL_HOST_GEMV_LANES] = {0};
+      for (vcl_size_t c = 0; c < cols_simd; c += lanes)
+        for (vcl_size_t l = 0; l < lanes; ++l)
+        {
+          NumericT xc = x[c + l];
+          acc0[l] += a0[c + l] * xc;
+          acc1[l] += a1[c + l] * xc;
+          acc2[l] += a2[c + l] * xc;
+          acc3[l] += a3[c + l] * xc;
+        }
 
-  vcl_size_t A_start1 = viennacl::traits::start1(mat);
-  vcl_size_t A_start2 = viennacl::traits::start2(mat);
-  vcl_size_t A_inc1   = viennacl::traits::stride1(mat);
-  vcl_size_t A_inc2   = viennacl::traits::stride2(mat);
-  vcl_size_t A_size1  = viennacl::traits::size1(mat);
-  vcl_size_t A_size2  = viennacl::traits::size2(mat);
-  vcl_size_t A_internal_size1  = viennacl::traits::internal_size1(mat);
-  vcl_size_t A_internal_size2  = viennacl::traits::internal_size2(mat);
+      NumericT s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+      for (vcl_size_t l = 0; l < lanes; ++l)
+      {
+        s0 += acc0[l]; s1 += acc1[l]; s2 += acc2[l]; s3 += acc3[l];
+      }
+      for (vcl_size_t c = cols_simd; c < cols; ++c)
+      {
+        NumericT xc = x[c];
+        s0 += a0[c] * xc; s1 += a1[c] * xc; s2 += a2[c] * xc; s3 += a3[c] * xc;
+      }
 
-  vcl_size_t start1 = viennacl::traits::start(vec);
-  vcl_size_t inc1   = viennacl::traits::stride(vec);
+      result[ r      * result_inc] = s0;
+      result[(r + 1) * result_inc] = s1;
+      result[(r + 2) * result_inc] = s2;
+      result[(r + 3) * result_inc] = s3;
+    }
 
-  vcl_size_t start2 = viennacl::traits::start(result);
-  vcl_size_t inc2   = viennacl::traits::stride(result);
+    for (; r < row_end; ++r)
+    {
+      NumericT const * a0 = S + r * ld;
+      NumericT acc0[VIENNACL_HOST_GEMV_LANES] = {0};
+      for (vcl_size_t c = 0; c < cols_simd; c += lanes)
+        for (vcl_size_t l = 0; l < lanes; ++l)
+          acc0[l] += a0[c + l] * x[c + l];
+
+      NumericT s0 = 0;
+      for (vcl_size_t l = 0; l < lanes; ++l)
+        s0 += acc0[l];
+      for (vcl_size_t c = cols_simd; c < cols; ++c)
+        s0 += a0[c] * x[c];
+
+      result[r * result_inc] = s0;
+    }
+  }
 
-  if (mat.row_major())
+  /** @brief Computes result[c] += sum_r S(r, c) * x[r] over rows [row_begin, row_end) and columns [col_begin, col_end) of a matrix S stored row by row with unit stride within a row.
+  *
+  * Four rows are processed at once, so that the result is loaded and stored once per four rows.
+  */
+  template<typename NumericT>
+  void gemv_axpy_rows(NumericT const * S, vcl_size_t ld, vcl_size_t row_begin, vcl_size_t row_end, vcl_size_t col_begin, vcl_size_t col_end,
+                      NumericT const * x, NumericT * result)
   {
-    if (trans)
+    vcl_size_t r = row_begin;
+    for (; r + 4 <= row_end; r += 4)
     {
-      {
-        value_type temp = data_x[start1];
-        for (vcl_size_t row = 0; row < A_size2; ++row)
-          data_result[row * inc2 + start2] = data_A[viennacl::row_major::mem_index(A_start1, row * A_inc2 + A_start2, A_internal_size1, A_internal_size2)] * temp;
-      }
+      NumericT const * a0 = S + r * ld;
+      NumericT const * a1 = a0 + ld;
+      NumericT const * a2 = a1 + ld;
+      NumericT const * a3 = a2 + ld;
+      NumericT x0 = x[r], x1 = x[r + 1], x2 = x[r + 2], x3 = x[r + 3];
+      for (vcl_size_t c = col_begin; c < col_end; ++c)
+        result[c] += a0[c] * x0 + a1[c] * x1 + a2[c] * x2 + a3[c] * x3;
+    }
+    for (; r < row_end; ++r)
+    {
+      NumericT const * a0 = S + r * ld;
+      NumericT x0 = x[r];
+      for (vcl_size_t c = col_begin; c < col_end; ++c)
+        result[c] += a0[c] * x0;
+    }
+  }
+
+  /** @brief Computes dot_result[r] = sum_c S(r, c) * dot_x[c] and axpy_result[c] += sum_r S(r, c) * axpy_x[r] over rows [row_begin, row_end) with a single pass over S. */
+  template<typename NumericT>
+  void gemv_fused_rows(NumericT const * S, vcl_size_t ld, vcl_size_t row_begin, vcl_size_t row_end, vcl_size_t cols,
+                       NumericT const * dot_x, NumericT * dot_result, vcl_size_t dot_result_inc,
+                       NumericT const * axpy_x, NumericT * axpy_result)
+  {
+    vcl_size_t const lanes = VIENNACL_HOST_GEMV_LANES;
+    vcl_size_t cols_simd = (cols / lanes) * lanes;
+
+    vcl_size_t r = row_begin;
+    for (; r + 2 <= row_end; r += 2)
+    {
+      NumericT const * a0 = S + r * ld;
+      NumericT const * a1 = a0 + ld;
+      NumericT w0 = axpy_x[r], w1 = axpy_x[r + 1];
 
-      for (vcl_size_t col = 1; col < A_size1; ++col)  //run through matrix sequentially
+      NumericT acc0[VIENNACL_HOST_GEMV_LANES] = {0}, acc1[VIENNACL_HOST_GEMV_LANES] = {0};
+      for (vcl_size_t c = 0; c < cols_simd; c += lanes)
       {
-        value_type temp = data_x[col * inc1 + start1];
-        for (vcl_size_t row = 0; row < A_size2; ++row)
+        NumericT upd[VIENNACL_HOST_GEMV_LANES];   // local copy, so that the compiler does not need to care about aliasing with S
+        for (vcl_size_t l = 0; l < lanes; ++l)
         {
-          data_result[row * inc2 + start2] += data_A[viennacl::row_major::mem_index(col * A_inc1 + A_start1, row * A_inc2 + A_start2, A_internal_size1, A_internal_size2)] * temp;
+          NumericT v0 = a0[c + l];
+          NumericT v1 = a1[c + l];
+          NumericT xc = dot_x[c + l];
+          acc0[l] += v0 * xc;
+          acc1[l] += v1 * xc;
+          upd[l] = v0 * w0 + v1 * w1;
         }
+        for (vcl_size_t l = 0; l < lanes; ++l)
+          axpy_result[c + l] += upd[l];
       }
+
+      NumericT s0 = 0, s1 = 0;
+      for (vcl_size_t l = 0; l < lanes; ++l)
+      {
+        s0 += acc0[l]; s1 += acc1[l];
+      }
+      for (vcl_size_t c = cols_simd; c < cols; ++c)
+      {
+        NumericT v0 = a0[c];
+        NumericT v1 = a1[c];
+        s0 += v0 * dot_x[c];
+        s1 += v1 * dot_x[c];
+        axpy_result[c] += v0 * w0 + v1 * w1;
+      }
+
+      dot_result[ r      * dot_result_inc] = s0;
+      dot_result[(r + 1) * dot_result_inc] = s1;
+    }
+
+    for (; r < row_end; ++r)
+    {
+      NumericT const * a0 = S + r * ld;
+      NumericT w0 = axpy_x[r];
+      NumericT s0 = 0;
+      for (vcl_size_t c = 0; c < cols; ++c)
+      {
+        s0 += a0[c] * dot_x[c];
+        axpy_result[c] += a0[c] * w0;
+      }
+      dot_result[r * dot_result_inc] = s0;
+    }
+  }
+}
+
+namespace detail
+{
+  /** @brief Describes a dense matrix as a sequence of 'stored rows' in memory, i.e. the rows of a row-major matrix or the columns of a column-major matrix */
+  template<typename NumericT>
+  struct gemv_stored_view
+  {
+    NumericT const * data;  // first entry of the first stored row
+    vcl_size_t ld;          // distance between two stored rows
+    vcl_size_t inc;         // distance between two entries within a stored row
+    vcl_size_t rows;        // number of stored rows
+    vcl_size_t cols;        // number of entries per stored row
+  };
+
+  template<typename NumericT>
+  gemv_stored_view<NumericT> make_gemv_stored_view(matrix_base<NumericT> const & A)
+  {
+    NumericT const * data = detail::extract_raw_pointer<NumericT>(A);
+    gemv_stored_view<NumericT> view;
+    if (A.row_major())
+    {
+      view.data = data + viennacl::traits::start1(A) * viennacl::traits::internal_size2(A) + viennacl::traits::start2(A);
+      view.ld   = viennacl::traits::stride1(A) * viennacl::traits::internal_size2(A);
+      view.inc  = viennacl::traits::stride2(A);
+      view.rows = viennacl::traits::size1(A);
+      view.cols = viennacl::traits::size2(A);
     }
     else
     {
+      view.data = data + viennacl::traits::start2(A) * viennacl::traits::internal_size1(A) + viennacl::traits::start1(A);
+      view.ld   = viennacl::traits::stride2(A) * viennacl::traits::internal_size1(A);
+      view.inc  = viennacl::traits::stride1(A);
+      view.rows = viennacl::traits::size2(A);
+      view.cols = viennacl::traits::size1(A);
+    }
+    return view;
+  }
+
+  /** @brief Returns a pointer to the entries of a vector with unit stride. Strided vectors are copied to the provided buffer. */
+  template<typename NumericT>
+  NumericT const * gemv_contiguous(vector_base<NumericT> const & vec, std::vector<NumericT> & buffer)
+  {
+    NumericT const * data = detail::extract_raw_pointer<NumericT>(vec) + viennacl::traits::start(vec);
+    vcl_size_t inc = viennacl::traits::stride(vec);
+    if (inc == 1 || viennacl::traits::size(vec) == 0)
+      return data;
+
+    buffer.resize(viennacl::traits::size(vec));
+    for (vcl_size_t i = 0; i < buffer.size(); ++i)
+      buffer[i] = data[i * inc];
+    return &buffer[0];
+  }
+
+  /** @brief Computes result[r] = sum_c S(r, c) * x[c] for all stored rows, parallelized over blocks of rows */
+  template<typename NumericT>
+  void gemv_dot(gemv_stored_view<NumericT> const & S, NumericT const * x, NumericT * result, vcl_size_t result_inc)
+  {
+    if (S.inc != 1)
+    {
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for
+      #pragma omp parallel for if (S.rows * S.cols > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
 #endif
-      for (long row = 0; row < static_cast<long>(A_size1); ++row)
+      for (long r = 0; r < static_cast<long>(S.rows); ++r)
       {
-        value_type temp = 0;
-        for (vcl_size_t col = 0; col < A_size2; ++col)
-          temp += data_A[viennacl::row_major::mem_index(static_cast<vcl_size_t>(row) * A_inc1 + A_start1, col * A_inc2 + A_start2, A_internal_size1, A_internal_size2)] * data_x[col * inc1 + start1];
-
-        data_result[static_cast<vcl_size_t>(row) * inc2 + start2] = temp;
+        NumericT const * a = S.data + static_cast<vcl_size_t>(r) * S.ld;
+        NumericT temp = 0;
+        for (vcl_size_t c = 0; c < S.cols; ++c)
+          temp += a[c * S.inc] * x[c];
+        result[static_cast<vcl_size_t>(r) * result_inc] = temp;
       }
+      return;
+    }
+
+    vcl_size_t block_size = 16;
+    long num_blocks = static_cast<long>((S.rows + block_size - 1) / block_size);
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (S.rows * S.cols > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+    for (long b = 0; b < num_blocks; ++b)
+    {
+      vcl_size_t row_begin = static_cast<vcl_size_t>(b) * block_size;
+      gemv_dot_rows(S.data, S.ld, row_begin, std::min(row_begin + block_size, S.rows), S.cols, x, result, result_inc);
     }
   }
-  else
+
+  /** @brief Computes result[c] = sum_r S(r, c) * x[r] for all columns of the stored rows. The result must have unit stride.
+  *
+  * Rows are distributed over the threads with per-thread partial results if there are sufficiently many of them.
+  * Otherwise, the threads work on disjoint blocks of columns.
+  */
+  template<typename NumericT>
+  void gemv_axpy(gemv_stored_view<NumericT> const & S, NumericT const * x, NumericT * result)
   {
-    if (!trans)
+    if (S.cols == 0)
+      return;
+
+    if (S.inc != 1)
     {
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for if (S.rows * S.cols > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+      for (long c = 0; c < static_cast<long>(S.cols); ++c)
       {
-        value_type temp = data_x[start1];
-        for (vcl_size_t row = 0; row < A_size1; ++row)
-          data_result[row * inc2 + start2] = data_A[viennacl::column_major::mem_index(row * A_inc1 + A_start1, A_start2, A_internal_size1, A_internal_size2)] * temp;
+        NumericT temp = 0;
+        for (vcl_size_t r = 0; r < S.rows; ++r)
+          temp += S.data[r * S.ld + static_cast<vcl_size_t>(c) * S.inc] * x[r];
+        result[c] = temp;
       }
-      for (vcl_size_t col = 1; col < A_size2; ++col)  //run through matrix sequentially
+      return;
+    }
+
+    for (vcl_size_t c = 0; c < S.cols; ++c)
+      result[c] = 0;
+
+    vcl_size_t num_threads = 1;
+#ifdef VIENNACL_WITH_OPENMP
+    if (S.rows * S.cols > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+      num_threads = static_cast<vcl_size_t>(omp_get_max_threads());
+#endif
+
+    if (num_threads == 1)
+      gemv_axpy_rows(S.data, S.ld, 0, S.rows, 0, S.cols, x, result);
+    else if (S.rows >= 16 * num_threads)
+    {
+      std::vector<NumericT> partial((num_threads - 1) * S.cols);
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel num_threads(static_cast<int>(num_threads))
+#endif
       {
-        value_type temp = data_x[col * inc1 + start1];
-        for (vcl_size_t row = 0; row < A_size1; ++row)
-          data_result[row * inc2 + start2] += data_A[viennacl::column_major::mem_index(row * A_inc1 + A_start1, col * A_inc2 + A_start2, A_internal_size1, A_internal_size2)] * temp;
+        vcl_size_t id = 0, nt = 1;
+#ifdef VIENNACL_WITH_OPENMP
+        id = static_cast<vcl_size_t>(omp_get_thread_num());
+        nt = static_cast<vcl_size_t>(omp_get_num_threads());
+#endif
+        NumericT * my_result = (id == 0) ? result : &partial[(id - 1) * S.cols];
+        if (id > 0)
+          std::fill(my_result, my_result + S.cols, NumericT(0));
+        gemv_axpy_rows(S.data, S.ld, (S.rows * id) / nt, (S.rows * (id + 1)) / nt, 0, S.cols, x, my_result);
       }
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for
+#endif
+      for (long c = 0; c < static_cast<long>(S.cols); ++c)
+        for (vcl_size_t t = 1; t < num_threads; ++t)
+          result[c] += partial[(t - 1) * S.cols + static_cast<vcl_size_t>(c)];
     }
     else
     {
+      vcl_size_t block_size = 256;
+      long num_blocks = static_cast<long>((S.cols + block_size - 1) / block_size);
 #ifdef VIENNACL_WITH_OPENMP
       #pragma omp parallel for
 #endif
-      for (long row = 0; row < static_cast<long>(A_size2); ++row)
+      for (long b = 0; b < num_blocks; ++b)
       {
-        value_type temp = 0;
-        for (vcl_size_t col = 0; col < A_size1; ++col)
-          temp += data_A[viennacl::column_major::mem_index(col * A_inc1 + A_start1, static_cast<vcl_size_t>(row) * A_inc2 + A_start2, A_internal_size1, A_internal_size2)] * data_x[col * inc1 + start1];
-
-        data_result[static_cast<vcl_size_t>(row) * inc2 + start2] = temp;
+        vcl_size_t col_begin = static_cast<vcl_size_t>(b) * block_size;
+        gemv_axpy_rows(S.data, S.ld, 0, S.rows, col_begin, std::min(col_begin + block_size, S.cols), x, result);
       }
     }
   }
 }
 
+/** @brief Carries out matrix-vector multiplication
+*
+* Implementation of the convenience expression result = prod(mat, vec);
+*
+* Depending on the memory layout, either each entry of the result is an inner product with a row in memory,
+* or the result is a linear combination of the rows in memory. Both are streamed with unit stride.
+*
+* @param mat    The matrix
+* @param trans  Flag whether mat is to be transposed
+* @param vec    The vector
+* @param result The result vector
+*/
+template<typename NumericT>
+void prod_impl(const matrix_base<NumericT> & mat, bool trans,
+               const vector_base<NumericT> & vec,
+                     vector_base<NumericT> & result)
+{
+  detail::gemv_stored_view<NumericT> S = detail::make_gemv_stored_view(mat);
+
+  std::vector<NumericT> x_buffer;
+  NumericT const * x = detail::gemv_contiguous(vec, x_buffer);
+
+  NumericT * data_result = detail::extract_raw_pointer<NumericT>(result) + viennacl::traits::start(result);
+  vcl_size_t result_inc  = viennacl::traits::stride(result);
+
+  if (mat.row_major() != trans)  // each entry of the result is an inner product with a stored row
+    detail::gemv_dot(S, x, data_result, result_inc);
+  else if (result_inc == 1)      // the result is a linear combination of the stored rows
+    detail::gemv_axpy(S, x, data_result);
+  else if (S.cols > 0)
+  {
+    std::vector<NumericT> temp(S.cols);
+    detail::gemv_axpy(S, x, &temp[0]);
+    for (vcl_size_t i = 0; i < temp.size(); ++i)
+      data_result[i * result_inc] = temp[i];
+  }
+}
+
+
+/** @brief Computes the two matrix-vector products y = A * x and z = trans(A) * w with a single pass over A
+*
+* Each stored row of A is used for an inner product and a linear combination at the same time.
+* The result vectors must not share memory with the input vectors.
+*
+* @param A   The matrix
+* @param x   The vector multiplied by A
+* @param y   The result A * x
+* @param w   The vector multiplied by trans(A)
+* @param z   The result trans(A) * w
+*/
+template<typename NumericT>
+void prod_and_trans_prod_impl(const matrix_base<NumericT> & A,
+                              const vector_base<NumericT> & x, vector_base<NumericT> & y,
+                              const vector_base<NumericT> & w, vector_base<NumericT> & z)
+{
+  detail::gemv_stored_view<NumericT> S = detail::make_gemv_stored_view(A);
+  if (S.inc != 1 || S.rows == 0 || S.cols == 0)
+  {
+    prod_impl(A, false, x, y);
+    prod_impl(A, true,  w, z);
+    return;
+  }
+
+  // in terms of stored rows: inner products with the rows, and a linear combination of the rows
+  vector_base<NumericT> const & dot_vec  = A.row_major() ? x : w;
+  vector_base<NumericT>       & dot_res  = A.row_major() ? y : z;
+  vector_base<NumericT> const & axpy_vec = A.row_major() ? w : x;
+  vector_base<NumericT>       & axpy_res = A.row_major() ? z : y;
+
+  std::vector<NumericT> dot_buffer, axpy_buffer;
+  NumericT const * dot_x  = detail::gemv_contiguous(dot_vec, dot_buffer);
+  NumericT const * axpy_x = detail::gemv_contiguous(axpy_vec, axpy_buffer);
+
+  NumericT * dot_result     = detail::extract_raw_pointer<NumericT>(dot_res) + viennacl::traits::start(dot_res);
+  vcl_size_t dot_result_inc = viennacl::traits::stride(dot_res);
+
+  vcl_size_t num_threads = 1;
+#ifdef VIENNACL_WITH_OPENMP
+  if (S.rows * S.cols > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+    num_threads = static_cast<vcl_size_t>(omp_get_max_threads());
+#endif
+
+  // per-thread partial results of the linear combination:
+  std::vector<NumericT> partial(num_threads * S.cols);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel num_threads(static_cast<int>(num_threads))
+#endif
+  {
+    vcl_size_t id = 0, nt = 1;
+#ifdef VIENNACL_WITH_OPENMP
+    id = static_cast<vcl_size_t>(omp_get_thread_num());
+    nt = static_cast<vcl_size_t>(omp_get_num_threads());
+#endif
+    detail::gemv_fused_rows(S.data, S.ld, (S.rows * id) / nt, (S.rows * (id + 1)) / nt, S.cols,
+                            dot_x, dot_result, dot_result_inc,
+                            axpy_x, &partial[id * S.cols]);
+  }
+
+  NumericT * axpy_result     = detail::extract_raw_pointer<NumericT>(axpy_res) + viennacl::traits::start(axpy_res);
+  vcl_size_t axpy_result_inc = viennacl::traits::stride(axpy_res);
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (num_threads > 1)
+#endif
+  for (long c = 0; c < static_cast<long>(S.cols); ++c)
+  {
+    NumericT temp = 0;
+    for (vcl_size_t t = 0; t < num_threads; ++t)
+      temp += partial[t * S.cols + static_cast<vcl_size_t>(c)];
+    axpy_result[static_cast<vcl_size_t>(c) * axpy_result_inc] = temp;
+  }
+}
+
 
 
 //
@@ -958,6 +1479,87 @@ void prod_impl(const matrix_base<NumericT> & mat, bool trans,
 
 namespace detail
 {
+  /** @brief Block size used for the blocked matrix-matrix products */
+  static const vcl_size_t prod_block_size = 64;
+
+  /** @brief Tag for writing all entries of a result block in prod_block() */
+  struct full_block_tag {};
+
+  inline bool prod_block_writes(vcl_size_t,   vcl_size_t,   full_block_tag)              { return true; }
+  inline bool prod_block_writes(vcl_size_t i, vcl_size_t j, viennacl::linalg::lower_tag) { return j <= i; }
+  inline bool prod_block_writes(vcl_size_t i, vcl_size_t j, viennacl::linalg::upper_tag) { return i <= j; }
+
+  /** @brief Computes the block of C starting at (offset_i, offset_j) as C = alpha * A * B + beta * C, where the summation index runs over [k_begin, k_end).
+  *
+  * Only the entries of the block selected by the tag (all entries, lower or upper triangle of C) are written.
+  * The buffers must hold prod_block_size * prod_block_size entries each.
+  */
+  template<typename MatrixAccT1, typename MatrixAccT2, typename MatrixAccT3, typename NumericT, typename TriangleTagT>
+  void prod_block(MatrixAccT1 & A, MatrixAccT2 & B, MatrixAccT3 & C,
+                  vcl_size_t C_size1, vcl_size_t C_size2,
+                  vcl_size_t offset_i, vcl_size_t offset_j, vcl_size_t k_begin, vcl_size_t k_end,
+                  NumericT alpha, NumericT beta,
+                  std::vector<NumericT> & buffer_A, std::vector<NumericT> & buffer_B, std::vector<NumericT> & buffer_C,
+                  TriangleTagT tag)
+  {
+    vcl_size_t const blocksize = prod_block_size;
+    vcl_size_t const block_size_i = std::min(blocksize, C_size1 - offset_i);
+    vcl_size_t const block_size_j = std::min(blocksize, C_size2 - offset_j);
+
+    // Reset block matrix:
+    std::fill(buffer_C.begin(), buffer_C.end(), NumericT(0));
+
+    //  C(block_idx_i, block_idx_i) += A(block_idx_i, block_idx_k) * B(block_idx_k, block_idx_j)
+    for (vcl_size_t offset_k = k_begin; offset_k < k_end; offset_k += blocksize)
+    {
+      // flush buffers:
+      std::fill(buffer_A.begin(), buffer_A.end(), NumericT(0));
+      std::fill(buffer_B.begin(), buffer_B.end(), NumericT(0));
+
+      // load current data:
+      for (vcl_size_t i = offset_i; i < std::min(offset_i + blocksize, C_size1); ++i)
+        for (vcl_size_t k = offset_k; k < std::min(offset_k + blocksize, k_end); ++k)
+          buffer_A[(i - offset_i) * blocksize + (k - offset_k)] = A(i, k);
+
+      for (vcl_size_t j = offset_j; j < std::min(offset_j + blocksize, C_size2); ++j)
+        for (vcl_size_t k = offset_k; k < std::min(offset_k + blocksize, k_end); ++k)
+          buffer_B[(k - offset_k) + (j - offset_j) * blocksize] = B(k, j);
+
+      // multiply (this is the hot spot in terms of flops). Partial blocks at the matrix boundary only run over their actual extent, which matters for tall and skinny matrices:
+      vcl_size_t const block_size_k = std::min(blocksize, k_end - offset_k);
+      for (vcl_size_t i = 0; i < block_size_i; ++i)
+      {
+        NumericT const * ptrA = &(buffer_A[i*blocksize]);
+        for (vcl_size_t j = 0; j < block_size_j; ++j)
+        {
+          NumericT const * ptrB = &(buffer_B[j*blocksize]);
+
+          NumericT temp = NumericT(0);
+          for (vcl_size_t k = 0; k < block_size_k; ++k)
+            temp += ptrA[k] * ptrB[k];  // buffer_A[i*blocksize + k] * buffer_B[k + j*blocksize];
+
+          buffer_C[i*blocksize + j] += temp;
+        }
+      }
+    }
+
+    // write result:
+    if (beta > 0 || beta < 0)
+    {
+      for (vcl_size_t i = offset_i; i < std::min(offset_i + blocksize, C_size1); ++i)
+        for (vcl_size_t j = offset_j; j < std::min(offset_j + blocksize, C_size2); ++j)
+          if (prod_block_writes(i, j, tag))
+            C(i,j) = beta * C(i,j) + alpha * buffer_C[(i - offset_i) * blocksize + (j - offset_j)];
+    }
+    else
+    {
+      for (vcl_size_t i = offset_i; i < std::min(offset_i + blocksize, C_size1); ++i)
+        for (vcl_size_t j = offset_j; j < std::min(offset_j + blocksize, C_size2); ++j)
+          if (prod_block_writes(i, j, tag))
+            C(i,j) =                 alpha * buffer_C[(i - offset_i) * blocksize + (j - offset_j)];
+    }
+  }
+
   template<typename MatrixAccT1, typename MatrixAccT2, typename MatrixAccT3, typename NumericT>
   void prod(MatrixAccT1 & A, MatrixAccT2 & B, MatrixAccT3 & C,
             vcl_size_t C_size1, vcl_size_t C_size2, vcl_size_t A_size2,
@@ -966,11 +1568,10 @@ namespace detail
     if (C_size1 == 0 || C_size2 == 0 || A_size2 == 0)
       return;
 
-    static const vcl_size_t blocksize = 64;
+    vcl_size_t const blocksize = prod_block_size;
 
     vcl_size_t num_blocks_C1 = (C_size1 - 1) / blocksize + 1;
     vcl_size_t num_blocks_C2 = (C_size2 - 1) / blocksize + 1;
-    vcl_size_t num_blocks_A2 = (A_size2 - 1) / blocksize + 1;
 
     //
     // outer loop pair: Run over all blocks with indices (block_idx_i, block_idx_j) of the result matrix C:
@@ -987,63 +1588,8 @@ namespace detail
 
       vcl_size_t block_idx_i = static_cast<vcl_size_t>(block_idx_i2);
       for (vcl_size_t block_idx_j=0; block_idx_j<num_blocks_C2; ++block_idx_j)
-      {
-        // Reset block matrix:
-        std::fill(buffer_C.begin(), buffer_C.end(), NumericT(0));
-
-        vcl_size_t offset_i = block_idx_i*blocksize;
-        vcl_size_t offset_j = block_idx_j*blocksize;
-
-        //  C(block_idx_i, block_idx_i) += A(block_idx_i, block_idx_k) * B(block_idx_k, block_idx_j)
-        for (vcl_size_t block_idx_k=0; block_idx_k<num_blocks_A2; ++block_idx_k)
-        {
-          // flush buffers:
-          std::fill(buffer_A.begin(), buffer_A.end(), NumericT(0));
-          std::fill(buffer_B.begin(), buffer_B.end(), NumericT(0));
-
-          vcl_size_t offset_k = block_idx_k*blocksize;
-
-          // load current data:
-          for (vcl_size_t i = offset_i; i < std::min(offset_i + blocksize, C_size1); ++i)
-            for (vcl_size_t k = offset_k; k < std::min(offset_k + blocksize, A_size2); ++k)
-              buffer_A[(i - offset_i) * blocksize + (k - offset_k)] = A(i, k);
-
-          for (vcl_size_t j = offset_j; j < std::min(offset_j + blocksize, C_size2); ++j)
-            for (vcl_size_t k = offset_k; k < std::min(offset_k + blocksize, A_size2); ++k)
-              buffer_B[(k - offset_k) + (j - offset_j) * blocksize] = B(k, j);
-
-          // multiply (this is the hot spot in terms of flops)
-          for (vcl_size_t i = 0; i < blocksize; ++i)
-          {
-            NumericT const * ptrA = &(buffer_A[i*blocksize]);
-            for (vcl_size_t j = 0; j < blocksize; ++j)
-            {
-              NumericT const * ptrB = &(buffer_B[j*blocksize]);
-
-              NumericT temp = NumericT(0);
-              for (vcl_size_t k = 0; k < blocksize; ++k)
-                temp += ptrA[k] * ptrB[k];  // buffer_A[i*blocksize + k] * buffer_B[k + j*blocksize];
-
-              buffer_C[i*blocksize + j] += temp;
-            }
-          }
-        }
-
-        // write result:
-        if (beta > 0 || beta < 0)
-        {
-          for (vcl_size_t i = offset_i; i < std::min(offset_i + blocksize, C_size1); ++i)
-            for (vcl_size_t j = offset_j; j < std::min(offset_j + blocksize, C_size2); ++j)
-              C(i,j) = beta * C(i,j) + alpha * buffer_C[(i - offset_i) * blocksize + (j - offset_j)];
-        }
-        else
-        {
-          for (vcl_size_t i = offset_i; i < std::min(offset_i + blocksize, C_size1); ++i)
-            for (vcl_size_t j = offset_j; j < std::min(offset_j + blocksize, C_size2); ++j)
-              C(i,j) =                 alpha * buffer_C[(i - offset_i) * blocksize + (j - offset_j)];
-        }
-
-      } // for block j
+        prod_block(A, B, C, C_size1, C_size2, block_idx_i * blocksize, block_idx_j * blocksize, 0, A_size2,
+                   alpha, beta, buffer_A, buffer_B, buffer_C, full_block_tag());
     } // for block i
 
   } // prod()
@@ -1366,6 +1912,308 @@ void prod_impl(const matrix_base<NumericT> & A, bool trans_A,
 
 
 
+//
+/////////////////////////   symmetric and triangular matrix-matrix products /////////////////////////////////
+//
+
+namespace detail
+{
+  inline bool is_lower(viennacl::linalg::lower_tag) { return true; }
+  inline bool is_lower(viennacl::linalg::upper_tag) { return false; }
+
+  /** @brief Accessor for a symmetric matrix of which only the lower or the upper triangle is referenced */
+  template<typename NumericT>
+  class symmetric_accessor
+  {
+  public:
+    symmetric_accessor(dense_strides<NumericT const> const & A, bool lower) : A_(A), lower_(lower) {}
+
+    NumericT operator()(vcl_size_t i, vcl_size_t j) const { return ((j <= i) == lower_) ? A_(i, j) : A_(j, i); }
+
+  private:
+    dense_strides<NumericT const> A_;
+    bool lower_;
+  };
+
+  /** @brief Accessor for a triangular matrix: Entries outside the triangle are zero and are not referenced, as is the diagonal if it is unit */
+  template<typename NumericT>
+  class triangular_accessor
+  {
+  public:
+    triangular_accessor(dense_strides<NumericT const> const & A, bool lower, bool unit_diagonal) : A_(A), lower_(lower), unit_diagonal_(unit_diagonal) {}
+
+    NumericT operator()(vcl_size_t i, vcl_size_t j) const
+    {
+      if (i == j)
+        return unit_diagonal_ ? NumericT(1) : A_(i, i);
+      return ((j < i) == lower_) ? A_(i, j) : NumericT(0);
+    }
+
+  private:
+    dense_strides<NumericT const> A_;
+    bool lower_;
+    bool unit_diagonal_;
+  };
+
+  /** @brief Computes the lower or upper triangle of the n-by-n matrix C = alpha * A * B + beta * C, where A is n-by-k and B is k-by-n.
+  *
+  * Only the blocks of C intersecting the triangle are computed, which roughly halves the work compared to prod().
+  */
+  template<typename MatrixAccT1, typename MatrixAccT2, typename MatrixAccT3, typename NumericT, typename TriangleTagT>
+  void prod_triangle(MatrixAccT1 & A, MatrixAccT2 & B, MatrixAccT3 & C,
+                     vcl_size_t n, vcl_size_t k,
+                     NumericT alpha, NumericT beta, TriangleTagT tag)
+  {
+    if (n == 0)
+      return;
+
+    vcl_size_t const blocksize = prod_block_size;
+    vcl_size_t num_blocks = (n - 1) / blocksize + 1;
+    bool lower = is_lower(tag);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for (long block_idx_i2=0; block_idx_i2<static_cast<long>(num_blocks); ++block_idx_i2)
+    {
+      // thread-local auxiliary buffers
+      std::vector<NumericT> buffer_A(blocksize * blocksize);
+      std::vector<NumericT> buffer_B(blocksize * blocksize);
+      std::vector<NumericT> buffer_C(blocksize * blocksize);
+
+      vcl_size_t block_idx_i = static_cast<vcl_size_t>(block_idx_i2);
+      vcl_size_t block_j_begin = lower ? 0               : block_idx_i;
+      vcl_size_t block_j_end   = lower ? block_idx_i + 1 : num_blocks;
+      for (vcl_size_t block_idx_j = block_j_begin; block_idx_j < block_j_end; ++block_idx_j)
+        prod_block(A, B, C, n, n, block_idx_i * blocksize, block_idx_j * blocksize, 0, k,
+                   alpha, beta, buffer_A, buffer_B, buffer_C, tag);
+    }
+  }
+
+  /** @brief Copies the lower (or upper) triangle of the n-by-n matrix C to the upper (or lower) triangle */
+  template<typename NumericT>
+  void mirror_triangle(dense_strides<NumericT> const & C, vcl_size_t n, bool lower)
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (n * n > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+    for (long i2 = 0; i2 < static_cast<long>(n); ++i2)
+    {
+      vcl_size_t i = static_cast<vcl_size_t>(i2);
+      for (vcl_size_t j = 0; j < i; ++j)
+      {
+        if (lower)
+          C(j, i) = C(i, j);
+        else
+          C(i, j) = C(j, i);
+      }
+    }
+  }
+
+  template<typename NumericT, typename ScalarT>
+  void trmm(matrix_base<NumericT> const & A, bool lower, bool unit_diagonal, bool trans_A,
+            matrix_base<NumericT> & B, ScalarT alpha, bool left)
+  {
+    vcl_size_t B_size1 = B.size1();
+    vcl_size_t B_size2 = B.size2();
+    if (B_size1 == 0 || B_size2 == 0)
+      return;
+
+    NumericT * data_B = extract_raw_pointer<NumericT>(B);
+    dense_strides<NumericT> strides_B = make_dense_strides(B, data_B);
+
+    // copy of B (row-major) as input, so that the result can be written to B directly:
+    std::vector<NumericT> temp(B_size1 * B_size2);
+    dense_strides<NumericT> strides_temp;
+    strides_temp.data    = &(temp[0]);
+    strides_temp.row_inc = B_size2;
+    strides_temp.col_inc = 1;
+    transpose_blocked(make_dense_strides(B, static_cast<NumericT const *>(data_B)), strides_temp.transposed(), B_size1, B_size2);
+
+    dense_strides<NumericT const> strides_A = make_dense_strides(A, extract_raw_pointer<NumericT>(A));
+    if (trans_A)
+    {
+      strides_A = strides_A.transposed();
+      lower = !lower;
+    }
+    triangular_accessor<NumericT> acc_A(strides_A, lower, unit_diagonal);
+    dense_strides<NumericT const> acc_temp;
+    acc_temp.data    = &(temp[0]);
+    acc_temp.row_inc = B_size2;
+    acc_temp.col_inc = 1;
+
+    vcl_size_t const blocksize = prod_block_size;
+    vcl_size_t n = A.size1();
+    vcl_size_t num_blocks_B1 = (B_size1 - 1) / blocksize + 1;
+    vcl_size_t num_blocks_B2 = (B_size2 - 1) / blocksize + 1;
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for (long block_idx_i2=0; block_idx_i2<static_cast<long>(num_blocks_B1); ++block_idx_i2)
+    {
+      // thread-local auxiliary buffers
+      std::vector<NumericT> buffer_A(blocksize * blocksize);
+      std::vector<NumericT> buffer_B(blocksize * blocksize);
+      std::vector<NumericT> buffer_C(blocksize * blocksize);
+
+      vcl_size_t offset_i = static_cast<vcl_size_t>(block_idx_i2) * blocksize;
+      for (vcl_size_t block_idx_j=0; block_idx_j<num_blocks_B2; ++block_idx_j)
+      {
+        vcl_size_t offset_j = block_idx_j * blocksize;
+
+        // skip the blocks of the summation range in which op(A) is zero:
+        if (left)  // B(i, j) = sum_k op(A)(i, k) * B(k, j)
+        {
+          vcl_size_t k_begin = lower ? 0 : offset_i;
+          vcl_size_t k_end   = lower ? std::min(offset_i + blocksize, n) : n;
+          prod_block(acc_A, acc_temp, strides_B, B_size1, B_size2, offset_i, offset_j, k_begin, k_end,
+                     static_cast<NumericT>(alpha), NumericT(0), buffer_A, buffer_B, buffer_C, full_block_tag());
+        }
+        else       // B(i, j) = sum_k B(i, k) * op(A)(k, j)
+        {
+          vcl_size_t k_begin = lower ? offset_j : 0;
+          vcl_size_t k_end   = lower ? n : std::min(offset_j + blocksize, n);
+          prod_block(acc_temp, acc_A, strides_B, B_size1, B_size2, offset_i, offset_j, k_begin, k_end,
+                     static_cast<NumericT>(alpha), NumericT(0), buffer_A, buffer_B, buffer_C, full_block_tag());
+        }
+      }
+    }
+  }
+
+} // namespace detail
+
+
+/** @brief Symmetric rank-k update: Computes the lower or upper triangle of C = alpha * A * A^T + beta * C, or of C = alpha * A^T * A + beta * C if trans_A is true.
+*
+* Only the blocks of C intersecting the triangle are computed. The other triangle of C is not referenced unless mirror is true, in which case it is overwritten with the computed triangle.
+*
+* @param A        The matrix A
+* @param trans_A  Whether A is transposed
+* @param C        The symmetric result matrix
+* @param alpha    Scaling factor for the product
+* @param beta     Scaling factor for C
+* @param tag      Either lower_tag or upper_tag
+* @param mirror   If true, the computed triangle is copied to the other triangle of C
+*/
+template<typename NumericT, typename ScalarT1, typename ScalarT2, typename TriangleTagT>
+void syrk(matrix_base<NumericT> const & A, bool trans_A,
+          matrix_base<NumericT> & C,
+          ScalarT1 alpha, ScalarT2 beta, TriangleTagT tag, bool mirror)
+{
+  detail::dense_strides<NumericT const> strides_A = detail::make_dense_strides(A, detail::extract_raw_pointer<NumericT>(A));
+  if (trans_A)
+    strides_A = strides_A.transposed();
+  detail::dense_strides<NumericT const> strides_AT = strides_A.transposed();
+  detail::dense_strides<NumericT>       strides_C  = detail::make_dense_strides(C, detail::extract_raw_pointer<NumericT>(C));
+
+  detail::prod_triangle(strides_A, strides_AT, strides_C, C.size1(), trans_A ? A.size1() : A.size2(),
+                        static_cast<NumericT>(alpha), static_cast<NumericT>(beta), tag);
+  if (mirror)
+    detail::mirror_triangle(strides_C, C.size1(), detail::is_lower(tag));
+}
+
+/** @brief Symmetric rank-2k update: Computes the lower or upper triangle of C = alpha * (A * B^T + B * A^T) + beta * C, or of C = alpha * (A^T * B + B^T * A) + beta * C if trans is true.
+*
+* @param A        The matrix A
+* @param B        The matrix B, which has the same size as A
+* @param trans    Whether A and B are transposed
+* @param C        The symmetric result matrix
+* @param alpha    Scaling factor for the products
+* @param beta     Scaling factor for C
+* @param tag      Either lower_tag or upper_tag
+* @param mirror   If true, the computed triangle is copied to the other triangle of C
+*/
+template<typename NumericT, typename ScalarT1, typename ScalarT2, typename TriangleTagT>
+void syr2k(matrix_base<NumericT> const & A, matrix_base<NumericT> const & B, bool trans,
+           matrix_base<NumericT> & C,
+           ScalarT1 alpha, ScalarT2 beta, TriangleTagT tag, bool mirror)
+{
+  detail::dense_strides<NumericT const> strides_A = detail::make_dense_strides(A, detail::extract_raw_pointer<NumericT>(A));
+  detail::dense_strides<NumericT const> strides_B = detail::make_dense_strides(B, detail::extract_raw_pointer<NumericT>(B));
+  if (trans)
+  {
+    strides_A = strides_A.transposed();
+    strides_B = strides_B.transposed();
+  }
+  detail::dense_strides<NumericT const> strides_AT = strides_A.transposed();
+  detail::dense_strides<NumericT const> strides_BT = strides_B.transposed();
+  detail::dense_strides<NumericT>       strides_C  = detail::make_dense_strides(C, detail::extract_raw_pointer<NumericT>(C));
+
+  vcl_size_t k = trans ? A.size1() : A.size2();
+  detail::prod_triangle(strides_A, strides_BT, strides_C, C.size1(), k, static_cast<NumericT>(alpha), static_cast<NumericT>(beta), tag);
+  detail::prod_triangle(strides_B, strides_AT, strides_C, C.size1(), k, static_cast<NumericT>(alpha), NumericT(1), tag);
+  if (mirror)
+    detail::mirror_triangle(strides_C, C.size1(), detail::is_lower(tag));
+}
+
+/** @brief Symmetric matrix-matrix product: Computes C = alpha * A * B + beta * C (left) or C = alpha * B * A + beta * C (right), where only the lower or upper triangle of the symmetric matrix A is referenced.
+*
+* @param A        The symmetric matrix A
+* @param tag      Either lower_tag or upper_tag, denoting the referenced triangle of A
+* @param B        The matrix B
+* @param C        The result matrix
+* @param alpha    Scaling factor for the product
+* @param beta     Scaling factor for C
+* @param left     Whether A is multiplied from the left
+*/
+template<typename NumericT, typename ScalarT1, typename ScalarT2, typename TriangleTagT>
+void symm(matrix_base<NumericT> const & A, TriangleTagT tag,
+          matrix_base<NumericT> const & B,
+          matrix_base<NumericT> & C,
+          ScalarT1 alpha, ScalarT2 beta, bool left)
+{
+  detail::symmetric_accessor<NumericT>  acc_A(detail::make_dense_strides(A, detail::extract_raw_pointer<NumericT>(A)), detail::is_lower(tag));
+  detail::dense_strides<NumericT const> strides_B = detail::make_dense_strides(B, detail::extract_raw_pointer<NumericT>(B));
+  detail::dense_strides<NumericT>       strides_C = detail::make_dense_strides(C, detail::extract_raw_pointer<NumericT>(C));
+
+  if (left)
+    detail::prod(acc_A, strides_B, strides_C, C.size1(), C.size2(), A.size1(), static_cast<NumericT>(alpha), static_cast<NumericT>(beta));
+  else
+    detail::prod(strides_B, acc_A, strides_C, C.size1(), C.size2(), A.size1(), static_cast<NumericT>(alpha), static_cast<NumericT>(beta));
+}
+
+/** @brief Triangular matrix-matrix product: Computes B = alpha * op(A) * B (left) or B = alpha * B * op(A) (right), where op(A) is either A or A^T.
+*
+* Only the triangle of A given by the tag is referenced, and blocks of the summation range in which op(A) is zero are skipped.
+* The input B is copied to a temporary buffer, so that the result can be written to B directly.
+*
+* @param A        The triangular matrix A
+* @param trans_A  Whether A is transposed
+* @param B        The matrix B, overwritten by the result
+* @param alpha    Scaling factor for the product
+* @param left     Whether A is multiplied from the left
+*/
+template<typename NumericT, typename ScalarT>
+void trmm(matrix_base<NumericT> const & A, viennacl::linalg::lower_tag, bool trans_A, matrix_base<NumericT> & B, ScalarT alpha, bool left)
+{
+  detail::trmm(A, true, false, trans_A, B, alpha, left);
+}
+
+/** @brief Triangular matrix-matrix product with a unit lower triangular matrix. See the overload for lower_tag. */
+template<typename NumericT, typename ScalarT>
+void trmm(matrix_base<NumericT> const & A, viennacl::linalg::unit_lower_tag, bool trans_A, matrix_base<NumericT> & B, ScalarT alpha, bool left)
+{
+  detail::trmm(A, true, true, trans_A, B, alpha, left);
+}
+
+/** @brief Triangular matrix-matrix product with an upper triangular matrix. See the overload for lower_tag. */
+template<typename NumericT, typename ScalarT>
+void trmm(matrix_base<NumericT> const & A, viennacl::linalg::upper_tag, bool trans_A, matrix_base<NumericT> & B, ScalarT alpha, bool left)
+{
+  detail::trmm(A, false, false, trans_A, B, alpha, left);
+}
+
+/** @brief Triangular matrix-matrix product with a unit upper triangular matrix. See the overload for lower_tag. */
+template<typename NumericT, typename ScalarT>
+void trmm(matrix_base<NumericT> const & A, viennacl::linalg::unit_upper_tag, bool trans_A, matrix_base<NumericT> & B, ScalarT alpha, bool left)
+{
+  detail::trmm(A, false, true, trans_A, B, alpha, left);
+}
+
+
+
+
 //
 /////////////////////////   miscellaneous operations /////////////////////////////////
 //
@@ -1852,11 +2700,14 @@ template <typename NumericT, typename S1>
      vcl_size_t start2 = viennacl::traits::start(vec2);
      vcl_size_t inc2   = viennacl::traits::stride(vec2);
 
-     vec2[start2] = vec1[start1];
-     for(vcl_size_t i = 1; i < size1; i++)
-     {
-       vec2[i * inc2 + start2] = vec2[(i - 1) * inc2 + start2] + vec1[i * inc1 + start1];
+     NumericT const * data_vec1 = detail::extract_raw_pointer<NumericT>(vec1);
+     NumericT       * data_vec2 = detail::extract_raw_pointer<NumericT>(vec2);
 
+     NumericT sum = 0;
+     for(vcl_size_t i = 0; i < size1; i++)
+     {
+       sum += data_vec1[i * inc1 + start1];
+       data_vec2[i * inc2 + start2] = sum;
      }
    }
 
@@ -1878,11 +2729,15 @@ template <typename NumericT, typename S1>
      vcl_size_t inc2   = viennacl::traits::stride(vec2);
 
 
-     vec2[start2] = 0;
-     for(vcl_size_t i = 1; i < size1; i++)
-     {
-       vec2[i * inc2 + start2] = vec2[(i - 1) * inc2 + start2] + vec1[(i - 1) * inc1 + start1];
+     NumericT const * data_vec1 = detail::extract_raw_pointer<NumericT>(vec1);
+     NumericT       * data_vec2 = detail::extract_raw_pointer<NumericT>(vec2);
 
+     NumericT sum = 0;
+     for(vcl_size_t i = 0; i < size1; i++)
+     {
+       NumericT value = data_vec1[i * inc1 + start1]; // read first, vec1 and vec2 may coincide
+       data_vec2[i * inc2 + start2] = sum;
+       sum += value;
      }
    }
 
@@ -23,6 +23,8 @@
 */
 
 #include <list>
+#include <vector>
+#include <algorithm>
 
 #include "viennacl/forwards.h"
 #include "viennacl/scalar.hpp"
@@ -31,12 +33,228 @@
 #include "viennacl/linalg/host_based/common.hpp"
 #include "viennacl/linalg/host_based/vector_operations.hpp"
 
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
 namespace viennacl
 {
 namespace linalg
 {
 namespace host_based
 {
+namespace detail
+{
+  /** @brief Elementwise epilogue of the sparse matrix-vector products: result = diag .* (alpha * prod(A, x) + beta * y), optionally accumulating inner_prod(result, w).
+  *
+  * The vector y may be the result vector itself, since each entry of y is read before the respective entry of the result is written.
+  * The vector y is not read if beta is zero.
+  */
+  template<typename NumericT>
+  class spmv_epilogue
+  {
+  public:
+    /** @brief Epilogue of the plain product result = prod(A, x) */
+    explicit spmv_epilogue(vector_base<NumericT> & result)
+      : result_(result), alpha_(1), beta_(0), y_(NULL), diag_(NULL), w_(NULL) { init(); }
+
+    spmv_epilogue(vector_base<NumericT> & result, NumericT alpha,
+                  vector_base<NumericT> const * y, NumericT beta,
+                  vector_base<NumericT> const * diag, vector_base<NumericT> const * w)
+      : result_(result), alpha_(alpha), beta_(beta), y_(beta != NumericT(0) ? y : NULL), diag_(diag), w_(w) { init(); }
+
+    /** @brief Returns true if the epilogue only writes the result of the matrix-vector product */
+    bool is_plain() const { return alpha_ == NumericT(1) && !y_ && !diag_ && !w_; }
+
+    vector_base<NumericT> & result() const { return result_; }
+
+    /** @brief Writes the entry 'row' of the result for the entry 'Ax' of the matrix-vector product and returns its contribution to inner_prod(result, w) */
+    NumericT operator()(vcl_size_t row, NumericT Ax) const
+    {
+      NumericT value = alpha_ * Ax;
+      if (y_buf_)
+        value += beta_ * y_buf_[row * y_inc_ + y_start_];
+      if (diag_buf_)
+        value *= diag_buf_[row * diag_inc_ + diag_start_];
+      result_buf_[row * result_inc_ + result_start_] = value;
+      return w_buf_ ? value * w_buf_[row * w_inc_ + w_start_] : NumericT(0);
+    }
+
+  private:
+    void init()
+    {
+      result_buf_   = extract_raw_pointer<NumericT>(result_.handle());
+      result_start_ = viennacl::traits::start(result_);
+      result_inc_   = viennacl::traits::stride(result_);
+      y_buf_    = y_    ? extract_raw_pointer<NumericT>(y_->handle())    : NULL;
+      y_start_  = y_    ? viennacl::traits::start(*y_)     : 0;
+      y_inc_    = y_    ? viennacl::traits::stride(*y_)    : 0;
+      diag_buf_   = diag_ ? extract_raw_pointer<NumericT>(diag_->handle()) : NULL;
+      diag_start_ = diag_ ? viennacl::traits::start(*diag_)  : 0;
+      diag_inc_   = diag_ ? viennacl::traits::stride(*diag_) : 0;
+      w_buf_    = w_    ? extract_raw_pointer<NumericT>(w_->handle())    : NULL;
+      w_start_  = w_    ? viennacl::traits::start(*w_)     : 0;
+      w_inc_    = w_    ? viennacl::traits::stride(*w_)    : 0;
+    }
+
+    vector_base<NumericT> & result_;
+    NumericT alpha_;
+    NumericT beta_;
+    vector_base<NumericT> const * y_;
+    vector_base<NumericT> const * diag_;
+    vector_base<NumericT> const * w_;
+
+    NumericT       * result_buf_;
+    NumericT const * y_buf_;
+    NumericT const * diag_buf_;
+    NumericT const * w_buf_;
+    vcl_size_t result_start_, result_inc_;
+    vcl_size_t y_start_, y_inc_;
+    vcl_size_t diag_start_, diag_inc_;
+    vcl_size_t w_start_, w_inc_;
+  };
+
+  /** @brief Applies the epilogue to all rows for a matrix-vector product accumulated in a host buffer. Returns the contribution to inner_prod(result, w). */
+  template<typename NumericT>
+  NumericT spmv_apply_epilogue(std::vector<NumericT> const & Ax, spmv_epilogue<NumericT> const & epilogue)
+  {
+    NumericT dot = 0;
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for reduction(+:dot) if (Ax.size() > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+    for (long row = 0; row < static_cast<long>(Ax.size()); ++row)
+      dot += epilogue(static_cast<vcl_size_t>(row), Ax[static_cast<vcl_size_t>(row)]);
+    return dot;
+  }
+
+  //
+  // Kernels for sparse matrix times tall-skinny dense matrix (few columns, row-major)
+  //
+
+  /** @brief Returns the first row of the part 'part_id' out of 'num_parts' parts of rows [0, num_rows) with about the same work each.
+  *
+  * The work of row i is given by offsets[i+1] - offsets[i] (i.e. the number of nonzeros for CSR row offsets) plus one for the row itself, so that empty rows are distributed as well.
+  */
+  template<typename OffsetT>
+  vcl_size_t balanced_row_partition(OffsetT const * offsets, vcl_size_t num_rows, vcl_size_t num_parts, vcl_size_t part_id)
+  {
+    if (part_id == 0)
+      return 0;
+    if (part_id >= num_parts)
+      return num_rows;
+
+    vcl_size_t total_work = static_cast<vcl_size_t>(offsets[num_rows] - offsets[0]) + num_rows;
+    vcl_size_t target     = (total_work * part_id) / num_parts;
+
+    // binary search for the first row i with offsets[i] - offsets[0] + i >= target:
+    vcl_size_t lower = 0;
+    vcl_size_t upper = num_rows;
+    while (lower < upper)
+    {
+      vcl_size_t mid = (lower + upper) / 2;
+      if (static_cast<vcl_size_t>(offsets[mid] - offsets[0]) + mid < target)
+        lower = mid + 1;
+      else
+        upper = mid;
+    }
+    return lower;
+  }
+
+  /** @brief Computes ColumnsV consecutive entries of a row of the result of a sparse matrix times a row-major dense matrix.
+  *
+  * The accumulators are kept in a fixed-size array, which the compiler keeps in (vector) registers, and the inner loop over the columns is vectorized.
+  * The nonzeros of the sparse row are given by 'nnz' values and column indices with the distance 'stride' in memory (1 for CSR, the internal number of rows for ELL formats).
+  *
+  * @param values     Nonzero values of the sparse row
+  * @param columns    Column indices of the sparse row
+  * @param nnz        Number of (possibly padded) entries in the sparse row
+  * @param stride     Distance of consecutive entries of the sparse row in memory
+  * @param X          Pointer to the first column of the block in the first row of the dense matrix
+  * @param ldx        Distance of consecutive rows of the dense matrix in memory
+  * @param y          Pointer to the first column of the block in the respective row of the result
+  */
+  template<unsigned int ColumnsV, bool SkipZerosV, typename NumericT, typename IndexT>
+  void spmm_row_block(NumericT const * values, IndexT const * columns, vcl_size_t nnz, vcl_size_t stride,
+                      NumericT const * X, vcl_size_t ldx, NumericT * y)
+  {
+    NumericT acc[ColumnsV];
+    for (unsigned int j = 0; j < ColumnsV; ++j)
+      acc[j] = 0;
+
+    for (vcl_size_t k = 0; k < nnz; ++k)
+    {
+      NumericT val = values[k * stride];
+      if (SkipZerosV && !(val < 0 || val > 0)) // padding of the ELL formats
+        continue;
+
+      NumericT const * x = X + static_cast<vcl_size_t>(columns[k * stride]) * ldx;
+      for (unsigned int j = 0; j < ColumnsV; ++j)
+        acc[j] += val * x[j];
+    }
+
+    for (unsigned int j = 0; j < ColumnsV; ++j)
+      y[j] = acc[j];
+  }
+
+  /** @brief Computes a full row of the result of a sparse matrix times a row-major dense matrix with 'num_cols' columns.
+  *
+  * Up to 16 columns are processed per pass over the sparse row. The remaining columns are covered by blocks of width 8, 4, 2, and 1,
+  * hence typical block sizes (4, 8, 16, 32, 64 columns) are processed with a single width only.
+  */
+  template<bool SkipZerosV, typename NumericT, typename IndexT>
+  void spmm_row(NumericT const * values, IndexT const * columns, vcl_size_t nnz, vcl_size_t stride,
+                NumericT const * X, vcl_size_t ldx, NumericT * y, vcl_size_t num_cols)
+  {
+    vcl_size_t j = 0;
+    for (; j + 16 <= num_cols; j += 16)
+      spmm_row_block<16, SkipZerosV>(values, columns, nnz, stride, X + j, ldx, y + j);
+    if (j + 8 <= num_cols)
+    {
+      spmm_row_block<8, SkipZerosV>(values, columns, nnz, stride, X + j, ldx, y + j);
+      j += 8;
+    }
+    if (j + 4 <= num_cols)
+    {
+      spmm_row_block<4, SkipZerosV>(values, columns, nnz, stride, X + j, ldx, y + j);
+      j += 4;
+    }
+    if (j + 2 <= num_cols)
+    {
+      spmm_row_block<2, SkipZerosV>(values, columns, nnz, stride, X + j, ldx, y + j);
+      j += 2;
+    }
+    if (j < num_cols)
+      spmm_row_block<1, SkipZerosV>(values, columns, nnz, stride, X + j, ldx, y + j);
+  }
+
+  /** @brief Returns true if the rows of the dense matrix are contiguous in memory, which is required by the kernels for tall-skinny dense matrices */
+  template<typename NumericT>
+  bool spmm_row_major_layout(matrix_base<NumericT> const & A)
+  {
+    return A.row_major() && viennacl::traits::stride2(A) == 1;
+  }
+
+  /** @brief Returns a pointer to the first entry of a row-major dense matrix */
+  template<typename NumericT>
+  NumericT const * spmm_row_major_data(matrix_base<NumericT> const & A)
+  {
+    return extract_raw_pointer<NumericT>(A) + viennacl::traits::start1(A) * viennacl::traits::internal_size2(A) + viennacl::traits::start2(A);
+  }
+
+  template<typename NumericT>
+  NumericT * spmm_row_major_data(matrix_base<NumericT> & A)
+  {
+    return extract_raw_pointer<NumericT>(A) + viennacl::traits::start1(A) * viennacl::traits::internal_size2(A) + viennacl::traits::start2(A);
+  }
+
+  /** @brief Returns the distance of consecutive rows of a row-major dense matrix in memory */
+  template<typename NumericT>
+  vcl_size_t spmm_row_major_ld(matrix_base<NumericT> const & A)
+  {
+    return viennacl::traits::stride1(A) * viennacl::traits::internal_size2(A);
+  }
+}
+
 //
 // Compressed matrix
 //
@@ -93,27 +311,28 @@ namespace detail
 }
 
 
-/** @brief Carries out matrix-vector multiplication with a compressed_matrix
+/** @brief Carries out matrix-vector multiplication with a compressed_matrix and a fused epilogue
 *
-* Implementation of the convenience expression result = prod(mat, vec);
+* Implementation of result = diag .* (alpha * prod(mat, vec) + beta * y), cf. detail::spmv_epilogue
 *
-* @param mat    The matrix
-* @param vec    The vector
-* @param result The result vector
+* @param mat      The matrix
+* @param vec      The vector
+* @param epilogue The epilogue writing the result vector
+* @return The inner product of the result with the vector w of the epilogue (zero if there is no such vector)
 */
 template<typename NumericT, unsigned int AlignmentV>
-void prod_impl(const viennacl::compressed_matrix<NumericT, AlignmentV> & mat,
-               const viennacl::vector_base<NumericT> & vec,
-                     viennacl::vector_base<NumericT> & result)
+NumericT prod_impl(const viennacl::compressed_matrix<NumericT, AlignmentV> & mat,
+                   const viennacl::vector_base<NumericT> & vec,
+                   detail::spmv_epilogue<NumericT> const & epilogue)
 {
-  NumericT           * result_buf = detail::extract_raw_pointer<NumericT>(result.handle());
   NumericT     const * vec_buf    = detail::extract_raw_pointer<NumericT>(vec.handle());
   NumericT     const * elements   = detail::extract_raw_pointer<NumericT>(mat.handle());
   unsigned int const * row_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle1());
   unsigned int const * col_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle2());
 
+  NumericT result_dot = 0;
 #ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for
+  #pragma omp parallel for reduction(+:result_dot)
 #endif
   for (long row = 0; row < static_cast<long>(mat.size1()); ++row)
   {
@@ -121,9 +340,26 @@ void prod_impl(const viennacl::compressed_matrix<NumericT, AlignmentV> & mat,
     vcl_size_t row_end = row_buffer[row+1];
     for (vcl_size_t i = row_buffer[row]; i < row_end; ++i)
       dot_prod += elements[i] * vec_buf[col_buffer[i] * vec.stride() + vec.start()];
-    result_buf[static_cast<vcl_size_t>(row) * result.stride() + result.start()] = dot_prod;
+    result_dot += epilogue(static_cast<vcl_size_t>(row), dot_prod);
   }
 
+  return result_dot;
+}
+
+/** @brief Carries out matrix-vector multiplication with a compressed_matrix
+*
+* Implementation of the convenience expression result = prod(mat, vec);
+*
+* @param mat    The matrix
+* @param vec    The vector
+* @param result The result vector
+*/
+template<typename NumericT, unsigned int AlignmentV>
+void prod_impl(const viennacl::compressed_matrix<NumericT, AlignmentV> & mat,
+               const viennacl::vector_base<NumericT> & vec,
+                     viennacl::vector_base<NumericT> & result)
+{
+  prod_impl(mat, vec, detail::spmv_epilogue<NumericT>(result));
 }
 
 /** @brief Carries out sparse_matrix-matrix multiplication first matrix being compressed
@@ -170,7 +406,34 @@ void prod_impl(const viennacl::compressed_matrix<NumericT, AlignmentV> & sp_mat,
   detail::matrix_array_wrapper<NumericT, column_major, false>
       result_wrapper_col(result_data, result_start1, result_start2, result_inc1, result_inc2, result_internal_size1, result_internal_size2);
 
-  if ( d_mat.row_major() ) {
+  if (detail::spmm_row_major_layout(d_mat) && detail::spmm_row_major_layout(result))
+  {
+    // row-major dense operands (e.g. blocks of vectors): all columns of a result row are computed from a single pass over the sparse row
+    NumericT const * X  = detail::spmm_row_major_data(d_mat);
+    NumericT       * Y  = detail::spmm_row_major_data(result);
+    vcl_size_t     ldx  = detail::spmm_row_major_ld(d_mat);
+    vcl_size_t     ldy  = detail::spmm_row_major_ld(result);
+    vcl_size_t num_cols = result.size2();
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel
+#endif
+    {
+      vcl_size_t id = 0, nt = 1;
+#ifdef VIENNACL_WITH_OPENMP
+      id = static_cast<vcl_size_t>(omp_get_thread_num());
+      nt = static_cast<vcl_size_t>(omp_get_num_threads());
+#endif
+      vcl_size_t row_begin = detail::balanced_row_partition(sp_mat_row_buffer, sp_mat.size1(), nt, id);
+      vcl_size_t row_end   = detail::balanced_row_partition(sp_mat_row_buffer, sp_mat.size1(), nt, id + 1);
+
+      for (vcl_size_t row = row_begin; row < row_end; ++row)
+        detail::spmm_row<false>(sp_mat_elements + sp_mat_row_buffer[row], sp_mat_col_buffer + sp_mat_row_buffer[row],
+                                sp_mat_row_buffer[row+1] - sp_mat_row_buffer[row], 1,
+                                X, ldx, Y + row * ldy, num_cols);
+    }
+  }
+  else if ( d_mat.row_major() ) {
 #ifdef VIENNACL_WITH_OPENMP
   #pragma omp parallel for
 #endif
@@ -901,6 +1164,50 @@ void prod_impl(const viennacl::compressed_compressed_matrix<NumericT> & mat,
 
 }
 
+/** @brief Carries out matrix-vector multiplication with a compressed_compressed_matrix and a fused epilogue
+*
+* Implementation of result = diag .* (alpha * prod(mat, vec) + beta * y), cf. detail::spmv_epilogue.
+* The product is accumulated in a host buffer, since rows without nonzeros need to be processed by the epilogue as well.
+*
+* @param mat      The matrix
+* @param vec      The vector
+* @param epilogue The epilogue writing the result vector
+* @return The inner product of the result with the vector w of the epilogue (zero if there is no such vector)
+*/
+template<typename NumericT>
+NumericT prod_impl(const viennacl::compressed_compressed_matrix<NumericT> & mat,
+                   const viennacl::vector_base<NumericT> & vec,
+                   detail::spmv_epilogue<NumericT> const & epilogue)
+{
+  if (epilogue.is_plain())
+  {
+    prod_impl(mat, vec, epilogue.result());
+    return 0;
+  }
+
+  NumericT     const * vec_buf     = detail::extract_raw_pointer<NumericT>(vec.handle());
+  NumericT     const * elements    = detail::extract_raw_pointer<NumericT>(mat.handle());
+  unsigned int const * row_buffer  = detail::extract_raw_pointer<unsigned int>(mat.handle1());
+  unsigned int const * row_indices = detail::extract_raw_pointer<unsigned int>(mat.handle3());
+  unsigned int const * col_buffer  = detail::extract_raw_pointer<unsigned int>(mat.handle2());
+
+  std::vector<NumericT> Ax(mat.size1());
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for
+#endif
+  for (long i = 0; i < static_cast<long>(mat.nnz1()); ++i)
+  {
+    NumericT dot_prod = 0;
+    vcl_size_t row_end = row_buffer[i+1];
+    for (vcl_size_t j = row_buffer[i]; j < row_end; ++j)
+      dot_prod += elements[j] * vec_buf[col_buffer[j] * vec.stride() + vec.start()];
+    Ax[row_indices[i]] = dot_prod;
+  }
+
+  return detail::spmv_apply_epilogue(Ax, epilogue);
+}
+
 
 
 //
@@ -992,6 +1299,38 @@ void prod_impl(const viennacl::coordinate_matrix<NumericT, AlignmentV> & mat,
       += elements[i] * vec_buf[coord_buffer[2*i+1] * vec.stride() + vec.start()];
 }
 
+/** @brief Carries out matrix-vector multiplication with a coordinate_matrix and a fused epilogue
+*
+* Implementation of result = diag .* (alpha * prod(mat, vec) + beta * y), cf. detail::spmv_epilogue.
+* The product is accumulated in a host buffer, since the entries are not required to be sorted by rows.
+*
+* @param mat      The matrix
+* @param vec      The vector
+* @param epilogue The epilogue writing the result vector
+* @return The inner product of the result with the vector w of the epilogue (zero if there is no such vector)
+*/
+template<typename NumericT, unsigned int AlignmentV>
+NumericT prod_impl(const viennacl::coordinate_matrix<NumericT, AlignmentV> & mat,
+                   const viennacl::vector_base<NumericT> & vec,
+                   detail::spmv_epilogue<NumericT> const & epilogue)
+{
+  if (epilogue.is_plain())
+  {
+    prod_impl(mat, vec, epilogue.result());
+    return 0;
+  }
+
+  NumericT     const * vec_buf      = detail::extract_raw_pointer<NumericT>(vec.handle());
+  NumericT     const * elements     = detail::extract_raw_pointer<NumericT>(mat.handle());
+  unsigned int const * coord_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle12());
+
+  std::vector<NumericT> Ax(mat.size1());
+  for (vcl_size_t i = 0; i < mat.nnz(); ++i)
+    Ax[coord_buffer[2*i]] += elements[i] * vec_buf[coord_buffer[2*i+1] * vec.stride() + vec.start()];
+
+  return detail::spmv_apply_epilogue(Ax, epilogue);
+}
+
 /** @brief Carries out Compressed Matrix(COO)-Dense Matrix multiplication
 *
 * Implementation of the convenience expression result = prod(sp_mat, d_mat);
@@ -1234,26 +1573,31 @@ void prod_impl(const viennacl::coordinate_matrix<NumericT, AlignmentV> & sp_mat,
 //
 // ELL Matrix
 //
-/** @brief Carries out matrix-vector multiplication with a ell_matrix
+/** @brief Carries out matrix-vector multiplication with an ell_matrix and a fused epilogue
 *
-* Implementation of the convenience expression result = prod(mat, vec);
+* Implementation of result = diag .* (alpha * prod(mat, vec) + beta * y), cf. detail::spmv_epilogue
 *
-* @param mat    The matrix
-* @param vec    The vector
-* @param result The result vector
+* @param mat      The matrix
+* @param vec      The vector
+* @param epilogue The epilogue writing the result vector
+* @return The inner product of the result with the vector w of the epilogue (zero if there is no such vector)
 */
 template<typename NumericT, unsigned int AlignmentV>
-void prod_impl(const viennacl::ell_matrix<NumericT, AlignmentV> & mat,
-               const viennacl::vector_base<NumericT> & vec,
-                     viennacl::vector_base<NumericT> & result)
+NumericT prod_impl(const viennacl::ell_matrix<NumericT, AlignmentV> & mat,
+                   const viennacl::vector_base<NumericT> & vec,
+                   detail::spmv_epilogue<NumericT> const & epilogue)
 {
-  NumericT           * result_buf   = detail::extract_raw_pointer<NumericT>(result.handle());
   NumericT     const * vec_buf      = detail::extract_raw_pointer<NumericT>(vec.handle());
   NumericT     const * elements     = detail::extract_raw_pointer<NumericT>(mat.handle());
   unsigned int const * coords       = detail::extract_raw_pointer<unsigned int>(mat.handle2());
 
-  for (vcl_size_t row = 0; row < mat.size1(); ++row)
+  NumericT result_dot = 0;
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for reduction(+:result_dot)
+#endif
+  for (long row2 = 0; row2 < static_cast<long>(mat.size1()); ++row2)
   {
+    vcl_size_t row = static_cast<vcl_size_t>(row2);
     NumericT sum = 0;
 
     for (unsigned int item_id = 0; item_id < mat.internal_maxnnz(); ++item_id)
@@ -1268,8 +1612,26 @@ void prod_impl(const viennacl::ell_matrix<NumericT, AlignmentV> & mat,
       }
     }
 
-    result_buf[row * result.stride() + result.start()] = sum;
+    result_dot += epilogue(row, sum);
   }
+
+  return result_dot;
+}
+
+/** @brief Carries out matrix-vector multiplication with a ell_matrix
+*
+* Implementation of the convenience expression result = prod(mat, vec);
+*
+* @param mat    The matrix
+* @param vec    The vector
+* @param result The result vector
+*/
+template<typename NumericT, unsigned int AlignmentV>
+void prod_impl(const viennacl::ell_matrix<NumericT, AlignmentV> & mat,
+               const viennacl::vector_base<NumericT> & vec,
+                     viennacl::vector_base<NumericT> & result)
+{
+  prod_impl(mat, vec, detail::spmv_epilogue<NumericT>(result));
 }
 
 /** @brief Carries out ell_matrix-d_matrix multiplication
@@ -1315,7 +1677,27 @@ void prod_impl(const viennacl::ell_matrix<NumericT, AlignmentV> & sp_mat,
   detail::matrix_array_wrapper<NumericT, column_major, false>
       result_wrapper_col(result_data, result_start1, result_start2, result_inc1, result_inc2, result_internal_size1, result_internal_size2);
 
-  if ( d_mat.row_major() ) {
+  if (detail::spmm_row_major_layout(d_mat) && detail::spmm_row_major_layout(result))
+  {
+    // row-major dense operands: all columns of a result row are computed from a single pass over the sparse row.
+    // Rows of an ELL matrix carry the same number of (padded) entries, hence a static partition is balanced.
+    NumericT const * X  = detail::spmm_row_major_data(d_mat);
+    NumericT       * Y  = detail::spmm_row_major_data(result);
+    vcl_size_t     ldx  = detail::spmm_row_major_ld(d_mat);
+    vcl_size_t     ldy  = detail::spmm_row_major_ld(result);
+    vcl_size_t num_cols = result.size2();
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for
+#endif
+    for (long row2 = 0; row2 < static_cast<long>(sp_mat.size1()); ++row2)
+    {
+      vcl_size_t row = static_cast<vcl_size_t>(row2);
+      detail::spmm_row<true>(sp_mat_elements + row, sp_mat_coords + row, sp_mat.maxnnz(), sp_mat.internal_size1(),
+                             X, ldx, Y + row * ldy, num_cols);
+    }
+  }
+  else if ( d_mat.row_major() ) {
 #ifdef VIENNACL_WITH_OPENMP
   #pragma omp parallel for
 #endif
@@ -1490,14 +1872,16 @@ void prod_impl(const viennacl::ell_matrix<NumericT, AlignmentV> & sp_mat,
           result_wrapper_col( row, col) = (NumericT)0; /* filling result with zeros, as the product loops are reordered */
     }
 
+    // rows are distributed among the threads, since all items of a row update the same entries of the result:
 #ifdef VIENNACL_WITH_OPENMP
   #pragma omp parallel for
 #endif
-    for (long item_id = 0; item_id < static_cast<long>(sp_mat.maxnnz()); ++item_id) {
+    for (long row2 = 0; row2 < static_cast<long>(sp_mat.size1()); ++row2) {
+      vcl_size_t row = static_cast<vcl_size_t>(row2);
 
-      for (vcl_size_t row = 0; row < sp_mat.size1(); ++row) {
+      for (vcl_size_t item_id = 0; item_id < sp_mat.maxnnz(); ++item_id) {
 
-        vcl_size_t offset = row + static_cast<vcl_size_t>(item_id) * sp_mat.internal_size1();
+        vcl_size_t offset = row + item_id * sp_mat.internal_size1();
         NumericT sp_mat_val = static_cast<NumericT>(sp_mat_elements[offset]);
         vcl_size_t sp_mat_col = static_cast<vcl_size_t>(sp_mat_coords[offset]);
 
@@ -1520,20 +1904,20 @@ void prod_impl(const viennacl::ell_matrix<NumericT, AlignmentV> & sp_mat,
 //
 // SELL-C-\sigma Matrix
 //
-/** @brief Carries out matrix-vector multiplication with a sliced_ell_matrix
+/** @brief Carries out matrix-vector multiplication with a sliced_ell_matrix and a fused epilogue
 *
-* Implementation of the convenience expression result = prod(mat, vec);
+* Implementation of result = diag .* (alpha * prod(mat, vec) + beta * y), cf. detail::spmv_epilogue
 *
-* @param mat    The matrix
-* @param vec    The vector
-* @param result The result vector
+* @param mat      The matrix
+* @param vec      The vector
+* @param epilogue The epilogue writing the result vector
+* @return The inner product of the result with the vector w of the epilogue (zero if there is no such vector)
 */
 template<typename NumericT, typename IndexT>
-void prod_impl(const viennacl::sliced_ell_matrix<NumericT, IndexT> & mat,
-               const viennacl::vector_base<NumericT> & vec,
-                     viennacl::vector_base<NumericT> & result)
+NumericT prod_impl(const viennacl::sliced_ell_matrix<NumericT, IndexT> & mat,
+                   const viennacl::vector_base<NumericT> & vec,
+                   detail::spmv_epilogue<NumericT> const & epilogue)
 {
-  NumericT       * result_buf        = detail::extract_raw_pointer<NumericT>(result.handle());
   NumericT const * vec_buf           = detail::extract_raw_pointer<NumericT>(vec.handle());
   NumericT const * elements          = detail::extract_raw_pointer<NumericT>(mat.handle());
   IndexT   const * columns_per_block = detail::extract_raw_pointer<IndexT>(mat.handle1());
@@ -1542,8 +1926,9 @@ void prod_impl(const viennacl::sliced_ell_matrix<NumericT, IndexT> & mat,
 
   vcl_size_t num_blocks = mat.size1() / mat.rows_per_block() + 1;
 
+  NumericT result_dot = 0;
 #ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for
+  #pragma omp parallel for reduction(+:result_dot)
 #endif
   for (long block_idx2 = 0; block_idx2 < static_cast<long>(num_blocks); ++block_idx2)
   {
@@ -1570,17 +1955,15 @@ void prod_impl(const viennacl::sliced_ell_matrix<NumericT, IndexT> & mat,
     vcl_size_t first_row_in_matrix = block_idx * mat.rows_per_block();
     for (IndexT row_in_block = 0; row_in_block < mat.rows_per_block(); ++row_in_block)
     {
-      if (first_row_in_matrix + row_in_block < result.size())
-        result_buf[(first_row_in_matrix + row_in_block) * result.stride() + result.start()] = result_values[row_in_block];
+      if (first_row_in_matrix + row_in_block < mat.size1())
+        result_dot += epilogue(first_row_in_matrix + row_in_block, result_values[row_in_block]);
     }
   }
-}
 
+  return result_dot;
+}
 
-//
-// Hybrid Matrix
-//
-/** @brief Carries out matrix-vector multiplication with a hyb_matrix
+/** @brief Carries out matrix-vector multiplication with a sliced_ell_matrix
 *
 * Implementation of the convenience expression result = prod(mat, vec);
 *
@@ -1588,12 +1971,139 @@ void prod_impl(const viennacl::sliced_ell_matrix<NumericT, IndexT> & mat,
 * @param vec    The vector
 * @param result The result vector
 */
-template<typename NumericT, unsigned int AlignmentV>
-void prod_impl(const viennacl::hyb_matrix<NumericT, AlignmentV> & mat,
+template<typename NumericT, typename IndexT>
+void prod_impl(const viennacl::sliced_ell_matrix<NumericT, IndexT> & mat,
                const viennacl::vector_base<NumericT> & vec,
                      viennacl::vector_base<NumericT> & result)
 {
-  NumericT           * result_buf     = detail::extract_raw_pointer<NumericT>(result.handle());
+  prod_impl(mat, vec, detail::spmv_epilogue<NumericT>(result));
+}
+
+/** @brief Carries out sliced_ell_matrix-d_matrix multiplication
+*
+* Implementation of the convenience expression result = prod(sp_mat, d_mat);
+* Row-major dense matrices with few columns (blocks of vectors) are processed by a dedicated kernel computing all columns of a row of the result from a single pass over the sparse row.
+*
+* @param sp_mat     The sparse matrix
+* @param d_mat      The dense matrix
+* @param result     The result dense matrix
+*/
+template<typename NumericT, typename IndexT>
+void prod_impl(const viennacl::sliced_ell_matrix<NumericT, IndexT> & sp_mat,
+               const viennacl::matrix_base<NumericT> & d_mat,
+                     viennacl::matrix_base<NumericT> & result)
+{
+  NumericT const * elements          = detail::extract_raw_pointer<NumericT>(sp_mat.handle());
+  IndexT   const * columns_per_block = detail::extract_raw_pointer<IndexT>(sp_mat.handle1());
+  IndexT   const * column_indices    = detail::extract_raw_pointer<IndexT>(sp_mat.handle2());
+  IndexT   const * block_start       = detail::extract_raw_pointer<IndexT>(sp_mat.handle3());
+
+  vcl_size_t rows_per_block = sp_mat.rows_per_block();
+  vcl_size_t num_blocks     = (sp_mat.size1() + rows_per_block - 1) / rows_per_block;
+  vcl_size_t num_cols       = result.size2();
+
+  // work per block is given by the number of columns of the block:
+  std::vector<vcl_size_t> block_offsets(num_blocks + 1, 0);
+  for (vcl_size_t block_idx = 0; block_idx < num_blocks; ++block_idx)
+    block_offsets[block_idx + 1] = block_offsets[block_idx] + columns_per_block[block_idx];
+
+  if (detail::spmm_row_major_layout(d_mat) && detail::spmm_row_major_layout(result))
+  {
+    NumericT const * X = detail::spmm_row_major_data(d_mat);
+    NumericT       * Y = detail::spmm_row_major_data(result);
+    vcl_size_t     ldx = detail::spmm_row_major_ld(d_mat);
+    vcl_size_t     ldy = detail::spmm_row_major_ld(result);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel
+#endif
+    {
+      vcl_size_t id = 0, nt = 1;
+#ifdef VIENNACL_WITH_OPENMP
+      id = static_cast<vcl_size_t>(omp_get_thread_num());
+      nt = static_cast<vcl_size_t>(omp_get_num_threads());
+#endif
+      vcl_size_t block_begin = detail::balanced_row_partition(&(block_offsets[0]), num_blocks, nt, id);
+      vcl_size_t block_end   = detail::balanced_row_partition(&(block_offsets[0]), num_blocks, nt, id + 1);
+
+      for (vcl_size_t block_idx = block_begin; block_idx < block_end; ++block_idx)
+      {
+        vcl_size_t first_row = block_idx * rows_per_block;
+        vcl_size_t last_row  = std::min(first_row + rows_per_block, sp_mat.size1());
+        for (vcl_size_t row = first_row; row < last_row; ++row)
+        {
+          vcl_size_t offset = block_start[block_idx] + (row - first_row);
+          detail::spmm_row<true>(elements + offset, column_indices + offset, columns_per_block[block_idx], rows_per_block,
+                                 X, ldx, Y + row * ldy, num_cols);
+        }
+      }
+    }
+  }
+  else
+  {
+    NumericT const * d_mat_data  = detail::extract_raw_pointer<NumericT>(d_mat);
+    NumericT       * result_data = detail::extract_raw_pointer<NumericT>(result);
+
+    detail::matrix_array_wrapper<NumericT const, row_major, false>
+        d_mat_wrapper_row(d_mat_data, viennacl::traits::start1(d_mat), viennacl::traits::start2(d_mat), viennacl::traits::stride1(d_mat), viennacl::traits::stride2(d_mat), viennacl::traits::internal_size1(d_mat), viennacl::traits::internal_size2(d_mat));
+    detail::matrix_array_wrapper<NumericT const, column_major, false>
+        d_mat_wrapper_col(d_mat_data, viennacl::traits::start1(d_mat), viennacl::traits::start2(d_mat), viennacl::traits::stride1(d_mat), viennacl::traits::stride2(d_mat), viennacl::traits::internal_size1(d_mat), viennacl::traits::internal_size2(d_mat));
+    detail::matrix_array_wrapper<NumericT, row_major, false>
+        result_wrapper_row(result_data, viennacl::traits::start1(result), viennacl::traits::start2(result), viennacl::traits::stride1(result), viennacl::traits::stride2(result), viennacl::traits::internal_size1(result), viennacl::traits::internal_size2(result));
+    detail::matrix_array_wrapper<NumericT, column_major, false>
+        result_wrapper_col(result_data, viennacl::traits::start1(result), viennacl::traits::start2(result), viennacl::traits::stride1(result), viennacl::traits::stride2(result), viennacl::traits::internal_size1(result), viennacl::traits::internal_size2(result));
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for
+#endif
+    for (long block_idx2 = 0; block_idx2 < static_cast<long>(num_blocks); ++block_idx2)
+    {
+      vcl_size_t block_idx = static_cast<vcl_size_t>(block_idx2);
+      vcl_size_t first_row = block_idx * rows_per_block;
+      vcl_size_t last_row  = std::min(first_row + rows_per_block, sp_mat.size1());
+      for (vcl_size_t row = first_row; row < last_row; ++row)
+      {
+        for (vcl_size_t col = 0; col < num_cols; ++col)
+        {
+          NumericT temp = 0;
+          for (vcl_size_t k = 0; k < columns_per_block[block_idx]; ++k)
+          {
+            vcl_size_t offset = block_start[block_idx] + k * rows_per_block + (row - first_row);
+            NumericT val = elements[offset];
+            if (val < 0 || val > 0) // val != 0 without compiler warnings
+            {
+              vcl_size_t sp_col = static_cast<vcl_size_t>(column_indices[offset]);
+              temp += val * (d_mat.row_major() ? d_mat_wrapper_row(sp_col, col) : d_mat_wrapper_col(sp_col, col));
+            }
+          }
+          if (result.row_major())
+            result_wrapper_row(row, col) = temp;
+          else
+            result_wrapper_col(row, col) = temp;
+        }
+      }
+    }
+  }
+}
+
+
+//
+// Hybrid Matrix
+//
+/** @brief Carries out matrix-vector multiplication with a hyb_matrix and a fused epilogue
+*
+* Implementation of result = diag .* (alpha * prod(mat, vec) + beta * y), cf. detail::spmv_epilogue
+*
+* @param mat      The matrix
+* @param vec      The vector
+* @param epilogue The epilogue writing the result vector
+* @return The inner product of the result with the vector w of the epilogue (zero if there is no such vector)
+*/
+template<typename NumericT, unsigned int AlignmentV>
+NumericT prod_impl(const viennacl::hyb_matrix<NumericT, AlignmentV> & mat,
+                   const viennacl::vector_base<NumericT> & vec,
+                   detail::spmv_epilogue<NumericT> const & epilogue)
+{
   NumericT     const * vec_buf        = detail::extract_raw_pointer<NumericT>(vec.handle());
   NumericT     const * elements       = detail::extract_raw_pointer<NumericT>(mat.handle());
   unsigned int const * coords         = detail::extract_raw_pointer<unsigned int>(mat.handle2());
@@ -1601,9 +2111,13 @@ void prod_impl(const viennacl::hyb_matrix<NumericT, AlignmentV> & mat,
   unsigned int const * csr_row_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle3());
   unsigned int const * csr_col_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle4());
 
-
-  for (vcl_size_t row = 0; row < mat.size1(); ++row)
+  NumericT result_dot = 0;
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for reduction(+:result_dot)
+#endif
+  for (long row2 = 0; row2 < static_cast<long>(mat.size1()); ++row2)
   {
+    vcl_size_t row = static_cast<vcl_size_t>(row2);
     NumericT sum = 0;
 
     //
@@ -1632,9 +2146,26 @@ void prod_impl(const viennacl::hyb_matrix<NumericT, AlignmentV> & mat,
         sum += (vec_buf[csr_col_buffer[item_id] * vec.stride() + vec.start()] * csr_elements[item_id]);
     }
 
-    result_buf[row * result.stride() + result.start()] = sum;
+    result_dot += epilogue(row, sum);
   }
 
+  return result_dot;
+}
+
+/** @brief Carries out matrix-vector multiplication with a hyb_matrix
+*
+* Implementation of the convenience expression result = prod(mat, vec);
+*
+* @param mat    The matrix
+* @param vec    The vector
+* @param result The result vector
+*/
+template<typename NumericT, unsigned int AlignmentV>
+void prod_impl(const viennacl::hyb_matrix<NumericT, AlignmentV> & mat,
+               const viennacl::vector_base<NumericT> & vec,
+                     viennacl::vector_base<NumericT> & result)
+{
+  prod_impl(mat, vec, detail::spmv_epilogue<NumericT>(result));
 }
 
 //
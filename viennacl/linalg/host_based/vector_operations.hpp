@@ -23,6 +23,7 @@
 */
 
 #include <cmath>
+#include <vector>
 #include <algorithm>  //for std::max and std::min
 
 #include "viennacl/forwards.h"
@@ -36,6 +37,10 @@
 #include "viennacl/linalg/detail/op_applier.hpp"
 #include "viennacl/traits/stride.hpp"
 
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
 
 // Minimum vector size for using OpenMP on vector operations:
 #ifndef VIENNACL_OPENMP_VECTOR_MIN_SIZE
@@ -909,6 +914,137 @@ void plane_rotation(vector_base<NumericT> & vec1,
   }
 }
 
+namespace detail
+{
+  /** @brief Applies a single update of a scatter operation */
+  template<typename NumericT>
+  void scatter_update(NumericT & entry, NumericT value, viennacl::op_assign)      { entry = value; }
+
+  template<typename NumericT>
+  void scatter_update(NumericT & entry, NumericT value, viennacl::op_inplace_add) { entry += value; }
+
+  template<typename NumericT>
+  void scatter_update(NumericT & entry, NumericT value, viennacl::op_max)         { entry = std::max(entry, value); }
+
+  /** @brief Reads data[(indices[i] - index_offset) * inc + start] into values[i] for all i. All indices must be smaller than index_end. */
+  template<typename NumericT, typename IndexT>
+  void gather_impl(NumericT const * data, vcl_size_t start, vcl_size_t inc,
+                   IndexT const * indices, vcl_size_t num_indices, vcl_size_t index_offset, vcl_size_t index_end,
+                   NumericT * values)
+  {
+    (void)index_end;
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (num_indices > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+    for (long i = 0; i < static_cast<long>(num_indices); ++i)
+    {
+      vcl_size_t index = static_cast<vcl_size_t>(indices[i]);
+      assert(index >= index_offset && index < index_end && bool("Index out of bounds in gather()"));
+      values[i] = data[(index - index_offset) * inc + start];
+    }
+  }
+
+  /** @brief Updates data[(indices[i] - index_offset) * inc + start] with values[i] for all i. All indices must be in [index_begin, index_end).
+  *
+  * The index range is split into contiguous blocks, one per thread. The positions i are first bucketed by the block of indices[i] (stable counting sort),
+  * then each thread applies the updates of its bucket in the order given. Thus, duplicate indices are handled as in a sequential loop and no atomic operations are required.
+  */
+  template<typename NumericT, typename IndexT, typename OpT>
+  void scatter_impl(NumericT const * values, IndexT const * indices, vcl_size_t num_indices, vcl_size_t index_offset,
+                    NumericT * data, vcl_size_t start, vcl_size_t inc, vcl_size_t index_begin, vcl_size_t index_end, OpT op)
+  {
+    (void)index_end;
+#ifdef VIENNACL_WITH_OPENMP
+    if (num_indices > VIENNACL_OPENMP_VECTOR_MIN_SIZE && omp_get_max_threads() > 1)
+    {
+      vcl_size_t range_size = index_end - index_begin;
+      vcl_size_t num_threads = 1;
+      std::vector<vcl_size_t> offsets;   // offsets[block * num_threads + id + 1]: number of updates in the input chunk of thread 'id' for the block
+      std::vector<vcl_size_t> positions(num_indices);
+
+      #pragma omp parallel
+      {
+        #pragma omp single
+        {
+          num_threads = static_cast<vcl_size_t>(omp_get_num_threads());
+          offsets.resize(num_threads * num_threads + 1, 0);
+        }
+
+        vcl_size_t id          = static_cast<vcl_size_t>(omp_get_thread_num());
+        vcl_size_t chunk_begin = (num_indices * id      ) / num_threads;
+        vcl_size_t chunk_end   = (num_indices * (id + 1)) / num_threads;
+
+        for (vcl_size_t i = chunk_begin; i < chunk_end; ++i)
+        {
+          vcl_size_t index = static_cast<vcl_size_t>(indices[i]);
+          assert(index >= index_begin && index < index_end && bool("Index out of bounds in scatter()"));
+          ++offsets[((index - index_begin) * num_threads / range_size) * num_threads + id + 1];
+        }
+
+        #pragma omp barrier
+        #pragma omp single
+        {
+          for (vcl_size_t k = 1; k < offsets.size(); ++k)
+            offsets[k] += offsets[k-1];
+        }
+
+        // positions are ordered by block, then by input chunk, then by position within the chunk:
+        std::vector<vcl_size_t> next(num_threads);
+        for (vcl_size_t block = 0; block < num_threads; ++block)
+          next[block] = offsets[block * num_threads + id];
+        for (vcl_size_t i = chunk_begin; i < chunk_end; ++i)
+          positions[next[((static_cast<vcl_size_t>(indices[i]) - index_begin) * num_threads / range_size)]++] = i;
+
+        #pragma omp barrier
+        for (vcl_size_t k = offsets[id * num_threads]; k < offsets[(id + 1) * num_threads]; ++k)
+        {
+          vcl_size_t i = positions[k];
+          scatter_update(data[(static_cast<vcl_size_t>(indices[i]) - index_offset) * inc + start], values[i], op);
+        }
+      }
+      return;
+    }
+#endif
+
+    for (vcl_size_t i = 0; i < num_indices; ++i)
+    {
+      vcl_size_t index = static_cast<vcl_size_t>(indices[i]);
+      assert(index >= index_begin && index < index_end && bool("Index out of bounds in scatter()"));
+      scatter_update(data[(index - index_offset) * inc + start], values[i], op);
+    }
+  }
+}
+
+/** @brief Reads the entries vec[indices[i]] into values[i], i = 0, ..., num_indices-1.
+*
+* @param vec          The vector (or -range, or -slice)
+* @param indices      Array of indices into the vector
+* @param num_indices  Number of indices
+* @param values       Array of length num_indices receiving the entries
+*/
+template<typename NumericT, typename IndexT>
+void gather(vector_base<NumericT> const & vec, IndexT const * indices, vcl_size_t num_indices, NumericT * values)
+{
+  detail::gather_impl(detail::extract_raw_pointer<NumericT>(vec), viennacl::traits::start(vec), viennacl::traits::stride(vec),
+                      indices, num_indices, 0, viennacl::traits::size(vec), values);
+}
+
+/** @brief Updates the entries vec[indices[i]] with values[i], i = 0, ..., num_indices-1.
+*
+* @param values       Array of length num_indices holding the values
+* @param indices      Array of indices into the vector
+* @param num_indices  Number of indices
+* @param vec          The vector (or -range, or -slice)
+* @param op           The update: op_assign() for vec[j] = v, op_inplace_add() for vec[j] += v, op_max() for vec[j] = max(vec[j], v)
+*/
+template<typename NumericT, typename IndexT, typename OpT>
+void scatter(NumericT const * values, IndexT const * indices, vcl_size_t num_indices, vector_base<NumericT> & vec, OpT op)
+{
+  detail::scatter_impl(values, indices, num_indices, 0,
+                       detail::extract_raw_pointer<NumericT>(vec), viennacl::traits::start(vec), viennacl::traits::stride(vec),
+                       0, viennacl::traits::size(vec), op);
+}
+
 } //namespace host_based
 } //namespace linalg
 } //namespace viennacl
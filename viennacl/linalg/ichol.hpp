@@ -19,105 +19,641 @@
 ============================================================================= */
 
 /** @file viennacl/linalg/ichol.hpp
-  @brief Implementations of incomplete Cholesky factorization preconditioners with static nonzero pattern.
+  @brief Implementations of incomplete Cholesky factorization preconditioners with static nonzero pattern (ICHOL0) and with threshold (ICHOLT).
+
+  The factor L is stored once in CSR format. Substitutions with L^T use a column-oriented (CSC) view of L, which only consists of index arrays into the values of L.
+  Both factorization and substitutions are parallelized by level scheduling on the host.
 */
 
 #include <vector>
 #include <cmath>
+#include <algorithm>
 #include <iostream>
 #include "viennacl/forwards.h"
 #include "viennacl/tools/tools.hpp"
+#include "viennacl/vector.hpp"
 #include "viennacl/compressed_matrix.hpp"
 
 #include "viennacl/linalg/host_based/common.hpp"
 
-#include <map>
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+// Minimum number of rows in a level for processing the level with OpenMP:
+#ifndef VIENNACL_OPENMP_ICHOL_MIN_LEVEL_SIZE
+  #define VIENNACL_OPENMP_ICHOL_MIN_LEVEL_SIZE  64
+#endif
 
 namespace viennacl
 {
 namespace linalg
 {
 
-/** @brief A tag for incomplete Cholesky factorization with static pattern (ILU0)
+/** @brief A tag for incomplete Cholesky factorization with static pattern (ICHOL0)
 */
 class ichol0_tag {};
 
 
-/** @brief Implementation of a ILU-preconditioner with static pattern. Optimized version for CSR matrices.
-  *
-  *  Refer to Chih-Jen Lin and Jorge J. Moré, Incomplete Cholesky Factorizations with Limited Memory, SIAM J. Sci. Comput., 21(1), 24–45
-  *  for one of many descriptions of incomplete Cholesky Factorizations
+/** @brief A tag for incomplete Cholesky factorization with threshold (ICHOLT)
+*/
+class icholt_tag
+{
+public:
+  /** @brief The constructor.
   *
-  *  @param A       The input matrix in CSR format
-  *  // param tag     An ichol0_tag in order to dispatch among several other preconditioners.
+  * @param entries_per_col   Maximum number of off-diagonal nonzero entries per column of L
+  * @param drop_tolerance    Entries smaller than drop_tolerance times the norm of the respective row of the system matrix are dropped
   */
-template<typename NumericT>
-void precondition(viennacl::compressed_matrix<NumericT> & A, ichol0_tag const & /* tag */)
+  icholt_tag(unsigned int entries_per_col = 20,
+             double       drop_tolerance = 1e-4)
+    : entries_per_col_(entries_per_col),
+      drop_tolerance_(drop_tolerance) {}
+
+  void set_drop_tolerance(double tol)
+  {
+    if (tol > 0)
+      drop_tolerance_ = tol;
+  }
+  double get_drop_tolerance() const { return drop_tolerance_; }
+
+  void set_entries_per_col(unsigned int e)
+  {
+    if (e > 0)
+      entries_per_col_ = e;
+  }
+  unsigned int get_entries_per_col() const { return entries_per_col_; }
+
+private:
+  unsigned int entries_per_col_;
+  double       drop_tolerance_;
+};
+
+
+namespace detail
 {
-  assert( (viennacl::traits::context(A).memory_type() == viennacl::MAIN_MEMORY) && bool("System matrix must reside in main memory for ICHOL0") );
+  /** @brief Incomplete Cholesky factor L (A ~ L L^T) in CSR format together with a CSC view and the level sets for the substitutions.
+  */
+  template<typename NumericT>
+  struct ichol_factor
+  {
+    ichol_factor() : size_(0), ram_ctx_(NULL) {}
 
-  NumericT           * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A.handle());
-  unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
-  unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
+    vcl_size_t size_;
+
+    // host context whose thread team sets up and applies the factor (NULL for the default host context)
+    viennacl::host_context const * ram_ctx_;
 
-  //std::cout << A.size1() << std::endl;
-  for (vcl_size_t i=0; i<A.size1(); ++i)
+    // L in CSR format, column indices sorted, diagonal entry last in each row
+    std::vector<unsigned int> row_buffer_;
+    std::vector<unsigned int> col_buffer_;
+    std::vector<NumericT>     elements_;
+
+    // CSC view of L: column j holds the entries elements_[csc_index_[k]] in rows csc_row_buffer_[k] for k in [csc_col_buffer_[j], csc_col_buffer_[j+1]). The diagonal entry is first.
+    std::vector<unsigned int> csc_col_buffer_;
+    std::vector<unsigned int> csc_row_buffer_;
+    std::vector<unsigned int> csc_index_;
+
+    // Level sets for the substitution with L (rows) and with L^T (columns)
+    std::vector<unsigned int> lower_level_buffer_;
+    std::vector<unsigned int> lower_level_rows_;
+    std::vector<unsigned int> upper_level_buffer_;
+    std::vector<unsigned int> upper_level_rows_;
+
+    vcl_size_t nnz() const { return elements_.size(); }
+  };
+
+  /** @brief Groups rows into level sets given the level of each row. Rows within a level are kept in ascending order.
+  *
+  * @param levels        Level of each row
+  * @param num_levels    Number of levels
+  * @param level_buffer  Level l consists of level_rows[level_buffer[l]], ..., level_rows[level_buffer[l+1] - 1] (output)
+  * @param level_rows    Rows ordered by level (output)
+  */
+  inline void ichol_bucket_levels(std::vector<unsigned int> const & levels, unsigned int num_levels,
+                                  std::vector<unsigned int> & level_buffer, std::vector<unsigned int> & level_rows)
+  {
+    level_buffer.assign(num_levels + 1, 0);
+    for (vcl_size_t i=0; i<levels.size(); ++i)
+      ++level_buffer[levels[i] + 1];
+    for (unsigned int l=0; l<num_levels; ++l)
+      level_buffer[l+1] += level_buffer[l];
+
+    level_rows.resize(levels.size());
+    std::vector<unsigned int> pos(level_buffer.begin(), level_buffer.end() - 1);
+    for (vcl_size_t i=0; i<levels.size(); ++i)
+      level_rows[pos[levels[i]]++] = static_cast<unsigned int>(i);
+  }
+
+  /** @brief Sets up the CSC view and the level sets of the substitutions for a factor whose CSR arrays are already available. */
+  template<typename NumericT>
+  void ichol_finalize(ichol_factor<NumericT> & L)
   {
-    unsigned int row_i_begin = row_buffer[i];
-    unsigned int row_i_end   = row_buffer[i+1];
+    vcl_size_t size = L.size_;
+
+    // CSC view. Rows are visited in ascending order, hence the diagonal comes first in each column:
+    L.csc_col_buffer_.assign(size + 1, 0);
+    L.csc_row_buffer_.resize(L.col_buffer_.size());
+    L.csc_index_.resize(L.col_buffer_.size());
+    for (vcl_size_t k=0; k<L.col_buffer_.size(); ++k)
+      ++L.csc_col_buffer_[L.col_buffer_[k] + 1];
+    for (vcl_size_t j=0; j<size; ++j)
+      L.csc_col_buffer_[j+1] += L.csc_col_buffer_[j];
+    {
+      std::vector<unsigned int> pos(L.csc_col_buffer_.begin(), L.csc_col_buffer_.end() - 1);
+      for (vcl_size_t i=0; i<size; ++i)
+        for (unsigned int k=L.row_buffer_[i]; k<L.row_buffer_[i+1]; ++k)
+        {
+          unsigned int p = pos[L.col_buffer_[k]]++;
+          L.csc_row_buffer_[p] = static_cast<unsigned int>(i);
+          L.csc_index_[p]      = k;
+        }
+    }
+
+    // Levels of the forward substitution: row i depends on all rows j < i with L(i,j) != 0
+    std::vector<unsigned int> levels(size, 0);
+    unsigned int num_levels = 0;
+    for (vcl_size_t i=0; i<size; ++i)
+    {
+      unsigned int level = 0;
+      for (unsigned int k=L.row_buffer_[i]; k+1<L.row_buffer_[i+1]; ++k)
+        level = std::max(level, levels[L.col_buffer_[k]] + 1);
+      levels[i] = level;
+      num_levels = std::max(num_levels, level + 1);
+    }
+    ichol_bucket_levels(levels, num_levels, L.lower_level_buffer_, L.lower_level_rows_);
 
-    // get a_ii:
-    NumericT a_ii = 0;
-    for (unsigned int buf_index_aii = row_i_begin; buf_index_aii < row_i_end; ++buf_index_aii)
+    // Levels of the backward substitution: unknown j depends on all unknowns i > j with L(i,j) != 0
+    num_levels = 0;
+    for (vcl_size_t j2=0; j2<size; ++j2)
     {
-      if (col_buffer[buf_index_aii] == i)
+      vcl_size_t j = size - j2 - 1;
+      unsigned int level = 0;
+      for (unsigned int k=L.csc_col_buffer_[j]+1; k<L.csc_col_buffer_[j+1]; ++k)
+        level = std::max(level, levels[L.csc_row_buffer_[k]] + 1);
+      levels[j] = level;
+      num_levels = std::max(num_levels, level + 1);
+    }
+    ichol_bucket_levels(levels, num_levels, L.upper_level_buffer_, L.upper_level_rows_);
+  }
+
+  /** @brief Computes the incomplete Cholesky factorization with the lower triangular sparsity pattern of the system matrix.
+  *
+  * Row i of L only depends on rows j < i with A(i,j) != 0, hence all rows of one level of the forward substitution are computed in parallel.
+  * If a nonpositive pivot is encountered, the respective diagonal entry of the system matrix is used instead.
+  *
+  * @param row_buffer  Row array of the symmetric system matrix
+  * @param col_buffer  Column array of the symmetric system matrix
+  * @param elements    Values of the symmetric system matrix
+  * @param size        Number of rows
+  * @param L           The factor (output)
+  */
+  template<typename NumericT>
+  void ichol0_factorize(unsigned int const * row_buffer, unsigned int const * col_buffer, NumericT const * elements, vcl_size_t size,
+                        ichol_factor<NumericT> & L)
+  {
+    L.size_ = size;
+
+    // extract lower triangular part of A with sorted column indices:
+    L.row_buffer_.assign(size + 1, 0);
+    for (vcl_size_t i=0; i<size; ++i)
+      for (unsigned int k=row_buffer[i]; k<row_buffer[i+1]; ++k)
+        if (col_buffer[k] <= i)
+          ++L.row_buffer_[i+1];
+    for (vcl_size_t i=0; i<size; ++i)
+      L.row_buffer_[i+1] += L.row_buffer_[i];
+
+    L.col_buffer_.resize(L.row_buffer_[size]);
+    L.elements_.resize(L.row_buffer_[size]);
+    std::vector<NumericT> diag_A(size, 0);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for
+#endif
+    for (long i2=0; i2<static_cast<long>(size); ++i2)
+    {
+      vcl_size_t i = static_cast<vcl_size_t>(i2);
+      unsigned int row_begin = L.row_buffer_[i];
+      unsigned int row_end   = row_begin;
+      for (unsigned int k=row_buffer[i]; k<row_buffer[i+1]; ++k)
       {
-        a_ii = std::sqrt(elements[buf_index_aii]);
-        elements[buf_index_aii] = a_ii;
-        break;
+        if (col_buffer[k] > i)
+          continue;
+
+        // insertion sort, rows are short:
+        unsigned int pos = row_end++;
+        while (pos > row_begin && L.col_buffer_[pos-1] > col_buffer[k])
+        {
+          L.col_buffer_[pos] = L.col_buffer_[pos-1];
+          L.elements_[pos]   = L.elements_[pos-1];
+          --pos;
+        }
+        L.col_buffer_[pos] = col_buffer[k];
+        L.elements_[pos]   = elements[k];
       }
+
+      assert( (row_end > row_begin && L.col_buffer_[row_end-1] == i) && bool("Zero diagonal entry encountered in ICHOL0") );
+      diag_A[i] = L.elements_[row_end-1];
     }
 
-    // Now scale column/row i, i.e. A(k, i) /= A(i, i)
-    for (unsigned int buf_index_aii = row_i_begin; buf_index_aii < row_i_end; ++buf_index_aii)
+    ichol_finalize(L);
+
+    unsigned int const * L_row_buffer = &(L.row_buffer_[0]);
+    unsigned int const * L_col_buffer = L.col_buffer_.size() > 0 ? &(L.col_buffer_[0]) : NULL;
+    NumericT           * L_elements   = L.elements_.size()   > 0 ? &(L.elements_[0])   : NULL;
+
+    for (vcl_size_t l=0; l+1<L.lower_level_buffer_.size(); ++l)
     {
-      if (col_buffer[buf_index_aii] > i)
-        elements[buf_index_aii] /= a_ii;
+      long level_start = static_cast<long>(L.lower_level_buffer_[l]);
+      long level_stop  = static_cast<long>(L.lower_level_buffer_[l+1]);
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for if (level_stop - level_start > VIENNACL_OPENMP_ICHOL_MIN_LEVEL_SIZE)
+#endif
+      for (long k2=level_start; k2<level_stop; ++k2)
+      {
+        unsigned int i = L.lower_level_rows_[static_cast<vcl_size_t>(k2)];
+        unsigned int row_i_begin = L_row_buffer[i];
+        unsigned int row_i_end   = L_row_buffer[i+1] - 1; // diagonal excluded
+
+        NumericT diag = L_elements[row_i_end];
+        for (unsigned int k=row_i_begin; k<row_i_end; ++k)
+        {
+          // L(i,j) = (A(i,j) - sum_{m<j} L(i,m) L(j,m)) / L(j,j)
+          unsigned int j = L_col_buffer[k];
+          unsigned int row_j_end = L_row_buffer[j+1] - 1;
+          unsigned int kj = L_row_buffer[j];
+          NumericT sum = L_elements[k];
+          for (unsigned int ki=row_i_begin; ki<k; ++ki)
+          {
+            unsigned int m = L_col_buffer[ki];
+            while (kj < row_j_end && L_col_buffer[kj] < m)
+              ++kj;
+            if (kj == row_j_end)
+              break;
+            if (L_col_buffer[kj] == m)
+              sum -= L_elements[ki] * L_elements[kj];
+          }
+          L_elements[k] = sum / L_elements[row_j_end];
+          diag -= L_elements[k] * L_elements[k];
+        }
+
+        if (diag <= 0)
+          diag = diag_A[i];
+        L_elements[row_i_end] = std::sqrt(diag);
+      }
     }
+  }
 
-    // Now compute A(k, j) -= A(k, i) * A(j, i) for all nonzero k, j in column i:
-    for (unsigned int buf_index_j = row_i_begin; buf_index_j < row_i_end; ++buf_index_j)
-    {
-      unsigned int j = col_buffer[buf_index_j];
-      if (j <= i)
-        continue;
+  /** @brief Comparison of entries by magnitude, used for keeping the largest entries of a column in ICHOLT */
+  template<typename NumericT>
+  bool ichol_larger_magnitude(std::pair<unsigned int, NumericT> const & a, std::pair<unsigned int, NumericT> const & b)
+  {
+    return std::fabs(a.second) > std::fabs(b.second);
+  }
+
+  /** @brief Computes the incomplete Cholesky factorization with threshold by a left-looking column-oriented algorithm.
+  *
+  * Column j of L only depends on columns which are descendants of j in the elimination tree of the system matrix.
+  * Columns are therefore grouped by their height in the elimination tree and all columns of one group are computed in parallel.
+  * If a nonpositive pivot is encountered, the respective diagonal entry of the system matrix is used instead.
+  *
+  * @param row_buffer  Row array of the symmetric system matrix
+  * @param col_buffer  Column array of the symmetric system matrix
+  * @param elements    Values of the symmetric system matrix
+  * @param size        Number of rows
+  * @param tag         The tag holding drop tolerance and maximum number of entries per column
+  * @param L           The factor (output)
+  */
+  template<typename NumericT>
+  void icholt_factorize(unsigned int const * row_buffer, unsigned int const * col_buffer, NumericT const * elements, vcl_size_t size,
+                        icholt_tag const & tag, ichol_factor<NumericT> & L)
+  {
+    typedef std::pair<unsigned int, NumericT>   EntryType;
+
+    unsigned int const none = static_cast<unsigned int>(-1);
 
-      NumericT a_ji = elements[buf_index_j];
+    // elimination tree (Liu's algorithm with path compression), using the lower triangular part of each row:
+    std::vector<unsigned int> parent(size, none);
+    {
+      std::vector<unsigned int> ancestor(size, none);
+      for (vcl_size_t i=0; i<size; ++i)
+        for (unsigned int k=row_buffer[i]; k<row_buffer[i+1]; ++k)
+        {
+          unsigned int r = col_buffer[k];
+          if (r >= i)
+            continue;
+          while (ancestor[r] != none && ancestor[r] != i)
+          {
+            unsigned int next = ancestor[r];
+            ancestor[r] = static_cast<unsigned int>(i);
+            r = next;
+          }
+          if (ancestor[r] == none)
+          {
+            ancestor[r] = static_cast<unsigned int>(i);
+            parent[r]   = static_cast<unsigned int>(i);
+          }
+        }
+    }
 
-      for (unsigned int buf_index_k = row_i_begin; buf_index_k < row_i_end; ++buf_index_k)
+    // height of each node in the elimination tree. Parents have larger indices than their children.
+    std::vector<unsigned int> height(size, 0);
+    unsigned int num_levels = (size > 0) ? 1 : 0;
+    for (vcl_size_t i=0; i<size; ++i)
+      if (parent[i] != none)
       {
-        unsigned int k = col_buffer[buf_index_k];
-        if (k < j)
-          continue;
+        height[parent[i]] = std::max(height[parent[i]], height[i] + 1);
+        num_levels = std::max(num_levels, height[i] + 2);
+      }
+
+    std::vector<unsigned int> level_buffer, level_cols;
+    ichol_bucket_levels(height, num_levels, level_buffer, level_cols);
+
+    // columns of L, sorted by row index with the diagonal first:
+    std::vector<std::vector<EntryType> > columns(size);
+    // (column, position in column) of all computed entries in each row of L:
+    std::vector<std::vector<std::pair<unsigned int, unsigned int> > > row_refs(size);
 
-        NumericT a_ki = elements[buf_index_k];
+    NumericT drop_tol = static_cast<NumericT>(tag.get_drop_tolerance());
+    vcl_size_t max_entries = tag.get_entries_per_col();
 
-        //Now check whether A(k, j) is in nonzero pattern:
-        unsigned int row_j_begin = row_buffer[j];
-        unsigned int row_j_end   = row_buffer[j+1];
-        for (unsigned int buf_index_kj = row_j_begin; buf_index_kj < row_j_end; ++buf_index_kj)
+    // dense work vector and marker for each thread, reused for all levels:
+#ifdef VIENNACL_WITH_OPENMP
+    vcl_size_t num_threads = static_cast<vcl_size_t>(omp_get_max_threads());
+#else
+    vcl_size_t num_threads = 1;
+#endif
+    std::vector<std::vector<NumericT> >     work(num_threads, std::vector<NumericT>(size, 0));
+    std::vector<std::vector<unsigned int> > markers(num_threads, std::vector<unsigned int>(size, none));
+
+    for (unsigned int l=0; l<num_levels; ++l)
+    {
+      long level_start = static_cast<long>(level_buffer[l]);
+      long level_stop  = static_cast<long>(level_buffer[l+1]);
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel if (level_stop - level_start > VIENNACL_OPENMP_ICHOL_MIN_LEVEL_SIZE)
+#endif
+      {
+#ifdef VIENNACL_WITH_OPENMP
+        vcl_size_t thread_id = static_cast<vcl_size_t>(omp_get_thread_num());
+#else
+        vcl_size_t thread_id = 0;
+#endif
+        std::vector<NumericT>     & w       = work[thread_id];
+        std::vector<unsigned int> & marker  = markers[thread_id];
+        std::vector<unsigned int>   pattern;
+        std::vector<EntryType>      entries;
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp for
+#endif
+        for (long k2=level_start; k2<level_stop; ++k2)
         {
-          if (col_buffer[buf_index_kj] == k)
+          unsigned int j = level_cols[static_cast<vcl_size_t>(k2)];
+
+          // load A(j:n, j), which is the upper part of row j due to symmetry:
+          pattern.clear();
+          NumericT diag_A = 0;
+          NumericT norm_A = 0;
+          for (unsigned int k=row_buffer[j]; k<row_buffer[j+1]; ++k)
+          {
+            unsigned int i = col_buffer[k];
+            norm_A += elements[k] * elements[k];
+            if (i < j)
+              continue;
+            if (marker[i] != j)
+            {
+              marker[i] = j;
+              pattern.push_back(i);
+            }
+            w[i] += elements[k];
+            if (i == j)
+              diag_A = elements[k];
+          }
+          norm_A = std::sqrt(norm_A);
+
+          // w -= L(j:n, k) L(j, k) for all previously computed columns k with L(j, k) != 0
+          for (vcl_size_t r=0; r<row_refs[j].size(); ++r)
+          {
+            std::vector<EntryType> const & col_k = columns[row_refs[j][r].first];
+            vcl_size_t pos = row_refs[j][r].second;
+            NumericT l_jk = col_k[pos].second;
+            for (vcl_size_t p=pos; p<col_k.size(); ++p)
+            {
+              unsigned int i = col_k[p].first;
+              if (marker[i] != j)
+              {
+                marker[i] = j;
+                pattern.push_back(i);
+              }
+              w[i] -= col_k[p].second * l_jk;
+            }
+          }
+
+          assert( (marker[j] == j) && bool("Zero diagonal entry encountered in ICHOLT") );
+          NumericT diag = w[j];
+          if (diag <= 0)
+            diag = diag_A;
+          diag = std::sqrt(diag);
+
+          // scale and drop:
+          entries.clear();
+          for (vcl_size_t p=0; p<pattern.size(); ++p)
+          {
+            unsigned int i = pattern[p];
+            NumericT value = w[i] / diag;
+            w[i] = 0;
+            if (i != j && std::fabs(value) >= drop_tol * norm_A)
+              entries.push_back(EntryType(i, value));
+          }
+
+          if (entries.size() > max_entries)
           {
-            elements[buf_index_kj] -= a_ki * a_ji;
-            break;
+            std::nth_element(entries.begin(), entries.begin() + static_cast<long>(max_entries), entries.end(), ichol_larger_magnitude<NumericT>);
+            entries.resize(max_entries);
           }
+          std::sort(entries.begin(), entries.end());
+
+          std::vector<EntryType> & col_j = columns[j];
+          col_j.reserve(entries.size() + 1);
+          col_j.push_back(EntryType(j, diag));
+          col_j.insert(col_j.end(), entries.begin(), entries.end());
         }
       }
+
+      // register the new entries in the rows they belong to:
+      for (long k2=level_start; k2<level_stop; ++k2)
+      {
+        unsigned int j = level_cols[static_cast<vcl_size_t>(k2)];
+        for (vcl_size_t p=1; p<columns[j].size(); ++p)
+          row_refs[columns[j][p].first].push_back(std::make_pair(j, static_cast<unsigned int>(p)));
+      }
     }
 
+    // pack columns into the CSR arrays of L. Visiting columns in ascending order yields sorted rows with the diagonal last.
+    L.size_ = size;
+    L.row_buffer_.assign(size + 1, 0);
+    for (vcl_size_t j=0; j<size; ++j)
+      for (vcl_size_t p=0; p<columns[j].size(); ++p)
+        ++L.row_buffer_[columns[j][p].first + 1];
+    for (vcl_size_t i=0; i<size; ++i)
+      L.row_buffer_[i+1] += L.row_buffer_[i];
+
+    L.col_buffer_.resize(L.row_buffer_[size]);
+    L.elements_.resize(L.row_buffer_[size]);
+    std::vector<unsigned int> pos(L.row_buffer_.begin(), L.row_buffer_.end() - 1);
+    for (vcl_size_t j=0; j<size; ++j)
+    {
+      for (vcl_size_t p=0; p<columns[j].size(); ++p)
+      {
+        unsigned int k = pos[columns[j][p].first]++;
+        L.col_buffer_[k] = static_cast<unsigned int>(j);
+        L.elements_[k]   = columns[j][p].second;
+      }
+      std::vector<EntryType>().swap(columns[j]);
+    }
+
+    ichol_finalize(L);
   }
 
+  /** @brief Applies the incomplete Cholesky preconditioner, i.e. solves L L^T x = vec and overwrites vec with x.
+  *
+  * The substitution with L runs over the rows of L, the substitution with L^T over the columns of L using the CSC view. Unknowns within one level are computed in parallel.
+  */
+  template<typename NumericT, typename VectorT>
+  void ichol_apply(ichol_factor<NumericT> const & L, VectorT & vec)
+  {
+    if (L.size_ == 0)
+      return;
+
+    viennacl::detail::host_context_scope scope(L.ram_ctx_);
+
+    unsigned int const * row_buffer = &(L.row_buffer_[0]);
+    unsigned int const * col_buffer = &(L.col_buffer_[0]);
+    NumericT     const * elements   = &(L.elements_[0]);
+
+    // forward substitution with L:
+    for (vcl_size_t l=0; l+1<L.lower_level_buffer_.size(); ++l)
+    {
+      long level_start = static_cast<long>(L.lower_level_buffer_[l]);
+      long level_stop  = static_cast<long>(L.lower_level_buffer_[l+1]);
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for if (level_stop - level_start > VIENNACL_OPENMP_ICHOL_MIN_LEVEL_SIZE)
+#endif
+      for (long k2=level_start; k2<level_stop; ++k2)
+      {
+        unsigned int i = L.lower_level_rows_[static_cast<vcl_size_t>(k2)];
+        unsigned int row_end = row_buffer[i+1] - 1;
+        NumericT sum = vec[i];
+        for (unsigned int k=row_buffer[i]; k<row_end; ++k)
+          sum -= elements[k] * vec[col_buffer[k]];
+        vec[i] = sum / elements[row_end];
+      }
+    }
+
+    unsigned int const * csc_col_buffer = &(L.csc_col_buffer_[0]);
+    unsigned int const * csc_row_buffer = &(L.csc_row_buffer_[0]);
+    unsigned int const * csc_index      = &(L.csc_index_[0]);
+
+    // backward substitution with L^T:
+    for (vcl_size_t l=0; l+1<L.upper_level_buffer_.size(); ++l)
+    {
+      long level_start = static_cast<long>(L.upper_level_buffer_[l]);
+      long level_stop  = static_cast<long>(L.upper_level_buffer_[l+1]);
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for if (level_stop - level_start > VIENNACL_OPENMP_ICHOL_MIN_LEVEL_SIZE)
+#endif
+      for (long k2=level_start; k2<level_stop; ++k2)
+      {
+        unsigned int j = L.upper_level_rows_[static_cast<vcl_size_t>(k2)];
+        unsigned int col_begin = csc_col_buffer[j];
+        NumericT sum = vec[j];
+        for (unsigned int k=col_begin+1; k<csc_col_buffer[j+1]; ++k)
+          sum -= elements[csc_index[k]] * vec[csc_row_buffer[k]];
+        vec[j] = sum / elements[csc_index[col_begin]];
+      }
+    }
+  }
+
+  /** @brief Applies the incomplete Cholesky preconditioner to a ViennaCL vector in main memory. Strided vectors are gathered into a contiguous buffer. */
+  template<typename NumericT>
+  void ichol_apply_host(ichol_factor<NumericT> const & L, viennacl::vector<NumericT> & vec)
+  {
+    NumericT * data = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(vec.handle()) + vec.start();
+    if (vec.stride() == 1)
+      ichol_apply(L, data);
+    else
+    {
+      std::vector<NumericT> temp(vec.size());
+      for (vcl_size_t i=0; i<vec.size(); ++i)
+        temp[i] = data[i * vec.stride()];
+      ichol_apply(L, temp);
+      for (vcl_size_t i=0; i<vec.size(); ++i)
+        data[i * vec.stride()] = temp[i];
+    }
+  }
+
+  /** @brief Applies the incomplete Cholesky preconditioner to a ViennaCL vector in any memory domain. Vectors not residing in main memory are temporarily migrated to the host. */
+  template<typename NumericT>
+  void ichol_apply(ichol_factor<NumericT> const & L, viennacl::vector<NumericT> & vec)
+  {
+    if (viennacl::traits::context(vec).memory_type() != viennacl::MAIN_MEMORY)
+    {
+      viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+      viennacl::context old_ctx = viennacl::traits::context(vec);
+
+      viennacl::switch_memory_context(vec, host_ctx);
+      ichol_apply_host(L, vec);
+      viennacl::switch_memory_context(vec, old_ctx);
+    }
+    else
+      ichol_apply_host(L, vec);
+  }
+}
+
+
+/** @brief Implementation of a ILU-preconditioner with static pattern. Optimized version for CSR matrices.
+  *
+  *  Refer to Chih-Jen Lin and Jorge J. Moré, Incomplete Cholesky Factorizations with Limited Memory, SIAM J. Sci. Comput., 21(1), 24–45
+  *  for one of many descriptions of incomplete Cholesky Factorizations
+  *
+  *  The factor L is written to the upper triangular part of A (A = L L^T with L^T in the upper triangular part), the strict lower triangular part of A remains unchanged.
+  *
+  *  @param A       The input matrix in CSR format
+  *  // param tag     An ichol0_tag in order to dispatch among several other preconditioners.
+  */
+template<typename NumericT>
+void precondition(viennacl::compressed_matrix<NumericT> & A, ichol0_tag const & /* tag */)
+{
+  assert( (viennacl::traits::context(A).memory_type() == viennacl::MAIN_MEMORY) && bool("System matrix must reside in main memory for ICHOL0") );
+
+  NumericT           * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A.handle());
+  unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
+  unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
+
+  viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(A));
+
+  detail::ichol_factor<NumericT> L;
+  detail::ichol0_factorize(row_buffer, col_buffer, elements, A.size1(), L);
+
+  // Row j of the upper triangular part of A is column j of L:
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for
+#endif
+  for (long j2=0; j2<static_cast<long>(A.size1()); ++j2)
+  {
+    vcl_size_t j = static_cast<vcl_size_t>(j2);
+    std::vector<unsigned int>::const_iterator col_begin = L.csc_row_buffer_.begin() + L.csc_col_buffer_[j];
+    std::vector<unsigned int>::const_iterator col_end   = L.csc_row_buffer_.begin() + L.csc_col_buffer_[j+1];
+    for (unsigned int k=row_buffer[j]; k<row_buffer[j+1]; ++k)
+    {
+      if (col_buffer[k] < j)
+        continue;
+      std::vector<unsigned int>::const_iterator it = std::lower_bound(col_begin, col_end, col_buffer[k]);
+      elements[k] = L.elements_[L.csc_index_[static_cast<vcl_size_t>(it - L.csc_row_buffer_.begin())]];
+    }
+  }
 }
 
 
@@ -129,44 +665,44 @@ class ichol0_precond
   typedef typename MatrixT::value_type      NumericType;
 
 public:
-  ichol0_precond(MatrixT const & mat, ichol0_tag const & tag) : tag_(tag), LLT(mat.size1(), mat.size2(), viennacl::context(viennacl::MAIN_MEMORY))
+  ichol0_precond(MatrixT const & mat, ichol0_tag const & tag) : tag_(tag)
   {
-      //initialize preconditioner:
-      //std::cout << "Start CPU precond" << std::endl;
-      init(mat);
-      //std::cout << "End CPU precond" << std::endl;
+    //initialize preconditioner:
+    init(mat);
   }
 
   template<typename VectorT>
   void apply(VectorT & vec) const
   {
-    unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LLT.handle1());
-    unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LLT.handle2());
-    NumericType  const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericType>(LLT.handle());
-
-    // Note: L is stored in a column-oriented fashion, i.e. transposed w.r.t. the row-oriented layout. Thus, the factorization A = L L^T holds L in the upper triangular part of A.
-    viennacl::linalg::host_based::detail::csr_trans_inplace_solve<NumericType>(row_buffer, col_buffer, elements, vec, LLT.size2(), lower_tag());
-    viennacl::linalg::host_based::detail::csr_inplace_solve<NumericType>(row_buffer, col_buffer, elements, vec, LLT.size2(), upper_tag());
+    detail::ichol_apply(L_, vec);
   }
 
+  /** @brief Returns the number of nonzeros of the factor L */
+  vcl_size_t nnz() const { return L_.nnz(); }
+
 private:
   void init(MatrixT const & mat)
   {
     viennacl::context host_ctx(viennacl::MAIN_MEMORY);
-    viennacl::switch_memory_context(LLT, host_ctx);
-
-    viennacl::copy(mat, LLT);
-    viennacl::linalg::precondition(LLT, tag_);
+    viennacl::compressed_matrix<NumericType> temp(mat.size1(), mat.size2(), host_ctx);
+    viennacl::switch_memory_context(temp, host_ctx);
+    viennacl::copy(mat, temp);
+
+    viennacl::detail::host_context_scope scope(NULL);
+    detail::ichol0_factorize(viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(temp.handle1()),
+                             viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(temp.handle2()),
+                             viennacl::linalg::host_based::detail::extract_raw_pointer<NumericType>(temp.handle()),
+                             temp.size1(), L_);
   }
 
-  ichol0_tag const & tag_;
-  viennacl::compressed_matrix<NumericType> LLT;
+  ichol0_tag tag_;
+  detail::ichol_factor<NumericType> L_;
 };
 
 
-/** @brief ILU0 preconditioner class, can be supplied to solve()-routines.
+/** @brief ICHOL0 preconditioner class, can be supplied to solve()-routines.
 *
-*  Specialization for compressed_matrix
+*  Specialization for compressed_matrix. Vectors not residing in main memory are temporarily migrated to the host.
 */
 template<typename NumericT, unsigned int AlignmentV>
 class ichol0_precond< compressed_matrix<NumericT, AlignmentV> >
@@ -174,46 +710,126 @@ class ichol0_precond< compressed_matrix<NumericT, AlignmentV> >
   typedef compressed_matrix<NumericT, AlignmentV>   MatrixType;
 
 public:
-  ichol0_precond(MatrixType const & mat, ichol0_tag const & tag) : tag_(tag), LLT(mat.size1(), mat.size2(), viennacl::traits::context(mat))
+  ichol0_precond(MatrixType const & mat, ichol0_tag const & tag) : tag_(tag)
   {
     //initialize preconditioner:
-    //std::cout << "Start GPU precond" << std::endl;
     init(mat);
-    //std::cout << "End GPU precond" << std::endl;
   }
 
   void apply(vector<NumericT> & vec) const
   {
-    if (viennacl::traits::context(vec).memory_type() != viennacl::MAIN_MEMORY)
-    {
-      viennacl::context host_ctx(viennacl::MAIN_MEMORY);
-      viennacl::context old_ctx = viennacl::traits::context(vec);
-
-      viennacl::switch_memory_context(vec, host_ctx);
-      viennacl::linalg::inplace_solve(trans(LLT), vec, lower_tag());
-      viennacl::linalg::inplace_solve(      LLT , vec, upper_tag());
-      viennacl::switch_memory_context(vec, old_ctx);
-    }
-    else //apply ILU0 directly:
-    {
-      // Note: L is stored in a column-oriented fashion, i.e. transposed w.r.t. the row-oriented layout. Thus, the factorization A = L L^T holds L in the upper triangular part of A.
-      viennacl::linalg::inplace_solve(trans(LLT), vec, lower_tag());
-      viennacl::linalg::inplace_solve(      LLT , vec, upper_tag());
-    }
+    detail::ichol_apply(L_, vec);
   }
 
+  /** @brief Returns the number of nonzeros of the factor L */
+  vcl_size_t nnz() const { return L_.nnz(); }
+
 private:
   void init(MatrixType const & mat)
   {
     viennacl::context host_ctx(viennacl::MAIN_MEMORY);
-    viennacl::switch_memory_context(LLT, host_ctx);
-    LLT = mat;
+    viennacl::compressed_matrix<NumericT> temp(mat.size1(), mat.size2(), viennacl::traits::context(mat));
+    viennacl::switch_memory_context(temp, host_ctx);
+    temp = mat;
+
+    L_.ram_ctx_ = viennacl::traits::ram_context(mat);
+    viennacl::detail::host_context_scope scope(L_.ram_ctx_);
+    detail::ichol0_factorize(viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(temp.handle1()),
+                             viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(temp.handle2()),
+                             viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(temp.handle()),
+                             temp.size1(), L_);
+  }
+
+  ichol0_tag tag_;
+  detail::ichol_factor<NumericT> L_;
+};
+
+
+/** @brief Incomplete Cholesky preconditioner class with threshold (ICHOLT), can be supplied to solve()-routines
+*/
+template<typename MatrixT>
+class icholt_precond
+{
+  typedef typename MatrixT::value_type      NumericType;
+
+public:
+  icholt_precond(MatrixT const & mat, icholt_tag const & tag) : tag_(tag)
+  {
+    //initialize preconditioner:
+    init(mat);
+  }
+
+  template<typename VectorT>
+  void apply(VectorT & vec) const
+  {
+    detail::ichol_apply(L_, vec);
+  }
+
+  /** @brief Returns the number of nonzeros of the factor L */
+  vcl_size_t nnz() const { return L_.nnz(); }
+
+private:
+  void init(MatrixT const & mat)
+  {
+    viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+    viennacl::compressed_matrix<NumericType> temp(mat.size1(), mat.size2(), host_ctx);
+    viennacl::switch_memory_context(temp, host_ctx);
+    viennacl::copy(mat, temp);
+
+    viennacl::detail::host_context_scope scope(NULL);
+    detail::icholt_factorize(viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(temp.handle1()),
+                             viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(temp.handle2()),
+                             viennacl::linalg::host_based::detail::extract_raw_pointer<NumericType>(temp.handle()),
+                             temp.size1(), tag_, L_);
+  }
+
+  icholt_tag tag_;
+  detail::ichol_factor<NumericType> L_;
+};
+
+
+/** @brief ICHOLT preconditioner class, can be supplied to solve()-routines.
+*
+*  Specialization for compressed_matrix. Vectors not residing in main memory are temporarily migrated to the host.
+*/
+template<typename NumericT, unsigned int AlignmentV>
+class icholt_precond< compressed_matrix<NumericT, AlignmentV> >
+{
+  typedef compressed_matrix<NumericT, AlignmentV>   MatrixType;
+
+public:
+  icholt_precond(MatrixType const & mat, icholt_tag const & tag) : tag_(tag)
+  {
+    //initialize preconditioner:
+    init(mat);
+  }
+
+  void apply(vector<NumericT> & vec) const
+  {
+    detail::ichol_apply(L_, vec);
+  }
+
+  /** @brief Returns the number of nonzeros of the factor L */
+  vcl_size_t nnz() const { return L_.nnz(); }
 
-    viennacl::linalg::precondition(LLT, tag_);
+private:
+  void init(MatrixType const & mat)
+  {
+    viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+    viennacl::compressed_matrix<NumericT> temp(mat.size1(), mat.size2(), viennacl::traits::context(mat));
+    viennacl::switch_memory_context(temp, host_ctx);
+    temp = mat;
+
+    L_.ram_ctx_ = viennacl::traits::ram_context(mat);
+    viennacl::detail::host_context_scope scope(L_.ram_ctx_);
+    detail::icholt_factorize(viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(temp.handle1()),
+                             viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(temp.handle2()),
+                             viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(temp.handle()),
+                             temp.size1(), tag_, L_);
   }
 
-  ichol0_tag const & tag_;
-  viennacl::compressed_matrix<NumericT> LLT;
+  icholt_tag tag_;
+  detail::ichol_factor<NumericT> L_;
 };
 
 }
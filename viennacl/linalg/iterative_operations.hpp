@@ -23,6 +23,7 @@
 */
 
 #include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
 #include "viennacl/range.hpp"
 #include "viennacl/scalar.hpp"
 #include "viennacl/tools/tools.hpp"
@@ -67,8 +68,11 @@ void pipelined_cg_vector_update(vector_base<NumericT> & result,
   switch (viennacl::traits::handle(result).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
+  {
+    viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(result));
     viennacl::linalg::host_based::pipelined_cg_vector_update(result, alpha, p, r, Ap, beta, inner_prod_buffer);
     break;
+  }
 #ifdef VIENNACL_WITH_OPENCL
   case viennacl::OPENCL_MEMORY:
     viennacl::linalg::opencl::pipelined_cg_vector_update(result, alpha, p, r, Ap, beta, inner_prod_buffer);
@@ -87,6 +91,73 @@ void pipelined_cg_vector_update(vector_base<NumericT> & result,
 }
 
 
+namespace detail
+{
+  /** @brief Composes the joint vector update of the Chebyshev iteration from the standard vector operations. Used for compute backends without a dedicated kernel. */
+  template<typename NumericT>
+  void chebyshev_vector_update_composed(vector_base<NumericT> & x,
+                                        vector_base<NumericT> & r,
+                                        vector_base<NumericT> & d,
+                                        vector_base<NumericT> const & Ad,
+                                        NumericT alpha,
+                                        NumericT beta,
+                                        vector_base<NumericT> const * diag_inv)
+  {
+    x += d;
+    r -= Ad;
+    if (diag_inv)
+    {
+      viennacl::vector<NumericT> z = viennacl::linalg::element_prod(*diag_inv, r);
+      d = alpha * d + beta * z;
+    }
+    else
+      d = alpha * d + beta * r;
+  }
+}
+
+/** @brief Performs a joint vector update operation needed for the Chebyshev iteration and for polynomial preconditioners.
+  *
+  * This routines computes for vectors 'x', 'r', 'd', 'Ad':
+  *   x += d;
+  *   r -= Ad;
+  *   d  = alpha * d + beta * diag_inv .* r;
+  * where the diagonal scaling with 'diag_inv' is skipped if 'diag_inv' is NULL. No reduction is involved.
+  */
+template<typename NumericT>
+void chebyshev_vector_update(vector_base<NumericT> & x,
+                             vector_base<NumericT> & r,
+                             vector_base<NumericT> & d,
+                             vector_base<NumericT> const & Ad,
+                             NumericT alpha,
+                             NumericT beta,
+                             vector_base<NumericT> const * diag_inv = NULL)
+{
+  switch (viennacl::traits::handle(x).get_active_handle_id())
+  {
+  case viennacl::MAIN_MEMORY:
+  {
+    viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(x));
+    viennacl::linalg::host_based::chebyshev_vector_update(x, r, d, Ad, alpha, beta, diag_inv);
+    break;
+  }
+#ifdef VIENNACL_WITH_OPENCL
+  case viennacl::OPENCL_MEMORY:
+    detail::chebyshev_vector_update_composed(x, r, d, Ad, alpha, beta, diag_inv);
+    break;
+#endif
+#ifdef VIENNACL_WITH_CUDA
+  case viennacl::CUDA_MEMORY:
+    detail::chebyshev_vector_update_composed(x, r, d, Ad, alpha, beta, diag_inv);
+    break;
+#endif
+  case viennacl::MEMORY_NOT_INITIALIZED:
+    throw memory_exception("not initialised!");
+  default:
+    throw memory_exception("not implemented");
+  }
+}
+
+
 /** @brief Performs a joint vector update operation needed for an efficient pipelined CG algorithm.
   *
   * This routines computes for a matrix A and vectors 'p' and 'Ap':
@@ -102,8 +173,11 @@ void pipelined_cg_prod(MatrixT const & A,
   switch (viennacl::traits::handle(p).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
+  {
+    viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(p));
     viennacl::linalg::host_based::pipelined_cg_prod(A, p, Ap, inner_prod_buffer);
     break;
+  }
 #ifdef VIENNACL_WITH_OPENCL
   case viennacl::OPENCL_MEMORY:
     viennacl::linalg::opencl::pipelined_cg_prod(A, p, Ap, inner_prod_buffer);
@@ -141,8 +215,11 @@ void pipelined_bicgstab_update_s(vector_base<NumericT> & s,
   switch (viennacl::traits::handle(s).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
+  {
+    viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(s));
     viennacl::linalg::host_based::pipelined_bicgstab_update_s(s, r, Ap, inner_prod_buffer, buffer_chunk_size, buffer_chunk_offset);
     break;
+  }
 #ifdef VIENNACL_WITH_OPENCL
   case viennacl::OPENCL_MEMORY:
     viennacl::linalg::opencl::pipelined_bicgstab_update_s(s, r, Ap, inner_prod_buffer, buffer_chunk_size, buffer_chunk_offset);
@@ -178,8 +255,11 @@ void pipelined_bicgstab_vector_update(vector_base<NumericT> & result, NumericT a
   switch (viennacl::traits::handle(s).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
+  {
+    viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(s));
     viennacl::linalg::host_based::pipelined_bicgstab_vector_update(result, alpha, p, omega, s, residual, As, beta, Ap, r0star, inner_prod_buffer, buffer_chunk_size);
     break;
+  }
   #ifdef VIENNACL_WITH_OPENCL
   case viennacl::OPENCL_MEMORY:
     viennacl::linalg::opencl::pipelined_bicgstab_vector_update(result, alpha, p, omega, s, residual, As, beta, Ap, r0star, inner_prod_buffer, buffer_chunk_size);
@@ -216,8 +296,11 @@ void pipelined_bicgstab_prod(MatrixT const & A,
   switch (viennacl::traits::handle(p).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
+  {
+    viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(p));
     viennacl::linalg::host_based::pipelined_bicgstab_prod(A, p, Ap, r0star, inner_prod_buffer, buffer_chunk_size, buffer_chunk_offset);
     break;
+  }
 #ifdef VIENNACL_WITH_OPENCL
   case viennacl::OPENCL_MEMORY:
     viennacl::linalg::opencl::pipelined_bicgstab_prod(A, p, Ap, r0star, inner_prod_buffer, buffer_chunk_size, buffer_chunk_offset);
@@ -257,8 +340,11 @@ void pipelined_gmres_normalize_vk(vector_base<T> & v_k,
   switch (viennacl::traits::handle(v_k).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
+  {
+    viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(v_k));
     viennacl::linalg::host_based::pipelined_gmres_normalize_vk(v_k, residual, R_buffer, offset_in_R, inner_prod_buffer, r_dot_vk_buffer, buffer_chunk_size, buffer_chunk_offset);
     break;
+  }
 #ifdef VIENNACL_WITH_OPENCL
   case viennacl::OPENCL_MEMORY:
     viennacl::linalg::opencl::pipelined_gmres_normalize_vk(v_k, residual, R_buffer, offset_in_R, inner_prod_buffer, r_dot_vk_buffer, buffer_chunk_size, buffer_chunk_offset);
@@ -293,8 +379,11 @@ void pipelined_gmres_gram_schmidt_stage1(vector_base<T> const & device_krylov_ba
   switch (viennacl::traits::handle(device_krylov_basis).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
+  {
+    viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(device_krylov_basis));
     viennacl::linalg::host_based::pipelined_gmres_gram_schmidt_stage1(device_krylov_basis, v_k_size, v_k_internal_size, k, vi_in_vk_buffer, buffer_chunk_size);
     break;
+  }
 #ifdef VIENNACL_WITH_OPENCL
   case viennacl::OPENCL_MEMORY:
     viennacl::linalg::opencl::pipelined_gmres_gram_schmidt_stage1(device_krylov_basis, v_k_size, v_k_internal_size, k, vi_in_vk_buffer, buffer_chunk_size);
@@ -331,8 +420,11 @@ void pipelined_gmres_gram_schmidt_stage2(vector_base<T> & device_krylov_basis,
   switch (viennacl::traits::handle(device_krylov_basis).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
+  {
+    viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(device_krylov_basis));
     viennacl::linalg::host_based::pipelined_gmres_gram_schmidt_stage2(device_krylov_basis, v_k_size, v_k_internal_size, k, vi_in_vk_buffer, R_buffer, krylov_dim, inner_prod_buffer, buffer_chunk_size);
     break;
+  }
 #ifdef VIENNACL_WITH_OPENCL
   case viennacl::OPENCL_MEMORY:
     viennacl::linalg::opencl::pipelined_gmres_gram_schmidt_stage2(device_krylov_basis, v_k_size, v_k_internal_size, k, vi_in_vk_buffer, R_buffer, krylov_dim, inner_prod_buffer, buffer_chunk_size);
@@ -364,8 +456,11 @@ void pipelined_gmres_update_result(vector_base<T> & result,
   switch (viennacl::traits::handle(result).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
+  {
+    viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(result));
     viennacl::linalg::host_based::pipelined_gmres_update_result(result, residual, krylov_basis, v_k_size, v_k_internal_size, coefficients, k);
     break;
+  }
 #ifdef VIENNACL_WITH_OPENCL
   case viennacl::OPENCL_MEMORY:
     viennacl::linalg::opencl::pipelined_gmres_update_result(result, residual, krylov_basis, v_k_size, v_k_internal_size, coefficients, k);
@@ -398,8 +493,11 @@ void pipelined_gmres_prod(MatrixType const & A,
   switch (viennacl::traits::handle(p).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
+  {
+    viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(p));
     viennacl::linalg::host_based::pipelined_gmres_prod(A, p, Ap, inner_prod_buffer);
     break;
+  }
 #ifdef VIENNACL_WITH_OPENCL
   case viennacl::OPENCL_MEMORY:
     viennacl::linalg::opencl::pipelined_gmres_prod(A, p, Ap, inner_prod_buffer);
@@ -59,8 +59,11 @@ namespace viennacl
       switch (viennacl::traits::handle(proxy).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(proxy));
           viennacl::linalg::host_based::trans(proxy, temp_trans);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::trans(proxy,temp_trans);
@@ -79,6 +82,33 @@ namespace viennacl
     }
 
 
+    namespace detail
+    {
+      /** @brief Transposes the buffer of a matrix in place, such that it holds the transposed matrix with the same memory layout and swapped internal sizes.
+      *
+      * Used for A = trans(A). Updating the sizes of A is left to the caller. A must not be a submatrix.
+      * The host backend transposes without a temporary copy of the matrix, other backends use a temporary.
+      */
+      template<typename NumericT>
+      void trans_inplace(matrix_base<NumericT> & A)
+      {
+        if (viennacl::traits::active_handle_id(A) == viennacl::MAIN_MEMORY)
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(A));
+          viennacl::linalg::host_based::trans_inplace(A);
+        }
+        else if (viennacl::traits::active_handle_id(A) == viennacl::MEMORY_NOT_INITIALIZED)
+          throw memory_exception("not initialised!");
+        else
+        {
+          matrix_base<NumericT> temp(A.size2(), A.size1(), A.row_major(), viennacl::traits::context(A));
+          viennacl::linalg::trans(matrix_expression<const matrix_base<NumericT>, const matrix_base<NumericT>, op_trans>(A, A), temp);
+          viennacl::backend::memory_copy(temp.handle(), A.handle(), 0, 0, sizeof(NumericT) * A.internal_size());
+        }
+      }
+    }
+
+
     template<typename NumericT,
               typename ScalarType1>
     void am(matrix_base<NumericT> & mat1,
@@ -87,8 +117,11 @@ namespace viennacl
       switch (viennacl::traits::handle(mat1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(mat1));
           viennacl::linalg::host_based::am(mat1, mat2, alpha, len_alpha, reciprocal_alpha, flip_sign_alpha);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::am(mat1, mat2, alpha, len_alpha, reciprocal_alpha, flip_sign_alpha);
@@ -116,10 +149,13 @@ namespace viennacl
       switch (viennacl::traits::handle(mat1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(mat1));
           viennacl::linalg::host_based::ambm(mat1,
                                              mat2, alpha, len_alpha, reciprocal_alpha, flip_sign_alpha,
                                              mat3,  beta, len_beta,  reciprocal_beta,  flip_sign_beta);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::ambm(mat1,
@@ -151,10 +187,13 @@ namespace viennacl
       switch (viennacl::traits::handle(mat1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(mat1));
           viennacl::linalg::host_based::ambm_m(mat1,
                                                mat2, alpha, len_alpha, reciprocal_alpha, flip_sign_alpha,
                                                mat3,  beta, len_beta,  reciprocal_beta,  flip_sign_beta);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::ambm_m(mat1,
@@ -183,8 +222,11 @@ namespace viennacl
       switch (viennacl::traits::handle(mat).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(mat));
           viennacl::linalg::host_based::matrix_assign(mat, s, clear);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::matrix_assign(mat, s, clear);
@@ -209,8 +251,11 @@ namespace viennacl
       switch (viennacl::traits::handle(mat).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(mat));
           viennacl::linalg::host_based::matrix_diagonal_assign(mat, s);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::matrix_diagonal_assign(mat, s);
@@ -236,8 +281,11 @@ namespace viennacl
       switch (viennacl::traits::handle(v).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(v));
           viennacl::linalg::host_based::matrix_diag_from_vector(v, k, A);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::matrix_diag_from_vector(v, k, A);
@@ -262,8 +310,11 @@ namespace viennacl
       switch (viennacl::traits::handle(A).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(A));
           viennacl::linalg::host_based::matrix_diag_to_vector(A, k, v);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::matrix_diag_to_vector(A, k, v);
@@ -287,8 +338,11 @@ namespace viennacl
       switch (viennacl::traits::handle(A).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(A));
           viennacl::linalg::host_based::matrix_row(A, i, v);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::matrix_row(A, i, v);
@@ -312,8 +366,11 @@ namespace viennacl
       switch (viennacl::traits::handle(A).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(A));
           viennacl::linalg::host_based::matrix_column(A, j, v);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::matrix_column(A, j, v);
@@ -418,8 +475,11 @@ namespace viennacl
       switch (viennacl::traits::handle(mat).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(mat));
           viennacl::linalg::host_based::prod_impl(mat, false, vec, result);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::prod_impl(mat, false, vec, result);
@@ -459,8 +519,11 @@ namespace viennacl
       switch (viennacl::traits::handle(mat_trans.lhs()).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(mat_trans.lhs()));
           viennacl::linalg::host_based::prod_impl(mat_trans.lhs(), true, vec, result);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::prod_impl(mat_trans.lhs(), true, vec, result);
@@ -479,6 +542,73 @@ namespace viennacl
     }
 
 
+    // y = A * x, z = trans(A) * w
+
+    /** @brief Computes the two matrix-vector products y = prod(A, x) and z = prod(trans(A), w) at once.
+    *
+    * On the host, A is read only once, which halves the memory traffic compared to two separate products.
+    * This is useful in e.g. Lanczos bidiagonalization or least squares solvers.
+    * If a result vector shares memory with an input vector, the inputs are copied to temporaries first. The two result vectors must not share memory.
+    *
+    * @param A   The matrix
+    * @param x   The vector multiplied by A
+    * @param y   The result vector A * x
+    * @param w   The vector multiplied by trans(A)
+    * @param z   The result vector trans(A) * w
+    */
+    template<typename NumericT>
+    void prod_and_trans_prod(const matrix_base<NumericT> & A,
+                             const vector_base<NumericT> & x, vector_base<NumericT> & y,
+                             const vector_base<NumericT> & w, vector_base<NumericT> & z)
+    {
+      assert( (viennacl::traits::size1(A) == viennacl::traits::size(y)) && bool("Size check failed at y = prod(A, x): size1(A) != size(y)"));
+      assert( (viennacl::traits::size2(A) == viennacl::traits::size(x)) && bool("Size check failed at y = prod(A, x): size2(A) != size(x)"));
+      assert( (viennacl::traits::size1(A) == viennacl::traits::size(w)) && bool("Size check failed at z = prod(trans(A), w): size1(A) != size(w)"));
+      assert( (viennacl::traits::size2(A) == viennacl::traits::size(z)) && bool("Size check failed at z = prod(trans(A), w): size2(A) != size(z)"));
+
+      // Both products read their input while writing their result, hence aliased inputs are copied first. Empty vectors do not hold a buffer:
+      if (viennacl::traits::size1(A) > 0 && viennacl::traits::size2(A) > 0)
+      {
+        assert( (viennacl::traits::handle(y) != viennacl::traits::handle(z)) && bool("The result vectors of prod_and_trans_prod() must not share memory!"));
+
+        if (   viennacl::traits::handle(y) == viennacl::traits::handle(x) || viennacl::traits::handle(y) == viennacl::traits::handle(w)
+            || viennacl::traits::handle(z) == viennacl::traits::handle(x) || viennacl::traits::handle(z) == viennacl::traits::handle(w))
+        {
+          viennacl::vector<NumericT> temp_x(x);
+          viennacl::vector<NumericT> temp_w(w);
+          prod_and_trans_prod(A, temp_x, y, temp_w, z);
+          return;
+        }
+      }
+
+      switch (viennacl::traits::handle(A).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(A));
+          viennacl::linalg::host_based::prod_and_trans_prod_impl(A, x, y, w, z);
+          break;
+        }
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+          viennacl::linalg::opencl::prod_impl(A, false, x, y);
+          viennacl::linalg::opencl::prod_impl(A, true,  w, z);
+          break;
+#endif
+#ifdef VIENNACL_WITH_CUDA
+        case viennacl::CUDA_MEMORY:
+          viennacl::linalg::cuda::prod_impl(A, false, x, y);
+          viennacl::linalg::cuda::prod_impl(A, true,  w, z);
+          break;
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+
     //
     /////////////////////////   matrix-matrix products /////////////////////////////////
     //
@@ -503,8 +633,11 @@ namespace viennacl
       switch (viennacl::traits::handle(A).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(A));
           viennacl::linalg::host_based::prod_impl(A, false, B, false, C, alpha, beta);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::prod_impl(A, false, B, false, C, alpha, beta);
@@ -545,8 +678,11 @@ namespace viennacl
       switch (viennacl::traits::handle(A.lhs()).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(A.lhs()));
           viennacl::linalg::host_based::prod_impl(A.lhs(), true, B, false, C, alpha, beta);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::prod_impl(A.lhs(), true, B, false, C, alpha, beta);
@@ -586,8 +722,11 @@ namespace viennacl
       switch (viennacl::traits::handle(A).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(A));
           viennacl::linalg::host_based::prod_impl(A, false, B.lhs(), true, C, alpha, beta);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::prod_impl(A, false, B.lhs(), true, C, alpha, beta);
@@ -626,8 +765,11 @@ namespace viennacl
       switch (viennacl::traits::handle(A.lhs()).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(A.lhs()));
           viennacl::linalg::host_based::prod_impl(A.lhs(), true, B.lhs(), true, C, alpha, beta);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::prod_impl(A.lhs(), true, B.lhs(), true, C, alpha, beta);
@@ -646,6 +788,155 @@ namespace viennacl
     }
 
 
+    ///////////////////////// Symmetric and triangular matrix-matrix products /////////////
+
+    /** @brief Symmetric rank-k update: Computes the lower or upper triangle of C = alpha * A * A^T + beta * C, or of C = alpha * A^T * A + beta * C if trans_A is true.
+    *
+    * Only the triangle given by the tag is computed, which requires about half the work of the corresponding prod().
+    * Currently only available for the host backend.
+    *
+    * @param A        The matrix A
+    * @param trans_A  Whether A is transposed
+    * @param C        The symmetric result matrix
+    * @param alpha    Scaling factor for the product
+    * @param beta     Scaling factor for C
+    * @param tag      Either lower_tag or upper_tag
+    * @param mirror   If true, the computed triangle is also copied to the other triangle of C. Otherwise the other triangle is not referenced.
+    */
+    template<typename NumericT, typename ScalarT, typename TriangleTagT>
+    void syrk(matrix_base<NumericT> const & A, bool trans_A,
+              matrix_base<NumericT> & C,
+              ScalarT alpha, ScalarT beta, TriangleTagT tag, bool mirror = false)
+    {
+      assert(viennacl::traits::size1(C) == viennacl::traits::size2(C) && bool("Size check failed in syrk(): size1(C) != size2(C)"));
+      assert((trans_A ? viennacl::traits::size2(A) : viennacl::traits::size1(A)) == viennacl::traits::size1(C) && bool("Size check failed in syrk(): size of A does not match size of C"));
+
+      switch (viennacl::traits::handle(A).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(A));
+          viennacl::linalg::host_based::syrk(A, trans_A, C, alpha, beta, tag, mirror);
+          break;
+        }
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+    /** @brief Symmetric rank-2k update: Computes the lower or upper triangle of C = alpha * (A * B^T + B * A^T) + beta * C, or of C = alpha * (A^T * B + B^T * A) + beta * C if trans is true.
+    *
+    * Currently only available for the host backend.
+    *
+    * @param A        The matrix A
+    * @param B        The matrix B, which has the same size as A
+    * @param trans    Whether A and B are transposed
+    * @param C        The symmetric result matrix
+    * @param alpha    Scaling factor for the products
+    * @param beta     Scaling factor for C
+    * @param tag      Either lower_tag or upper_tag
+    * @param mirror   If true, the computed triangle is also copied to the other triangle of C
+    */
+    template<typename NumericT, typename ScalarT, typename TriangleTagT>
+    void syr2k(matrix_base<NumericT> const & A, matrix_base<NumericT> const & B, bool trans,
+               matrix_base<NumericT> & C,
+               ScalarT alpha, ScalarT beta, TriangleTagT tag, bool mirror = false)
+    {
+      assert(viennacl::traits::size1(A) == viennacl::traits::size1(B) && viennacl::traits::size2(A) == viennacl::traits::size2(B) && bool("Size check failed in syr2k(): size(A) != size(B)"));
+      assert(viennacl::traits::size1(C) == viennacl::traits::size2(C) && bool("Size check failed in syr2k(): size1(C) != size2(C)"));
+      assert((trans ? viennacl::traits::size2(A) : viennacl::traits::size1(A)) == viennacl::traits::size1(C) && bool("Size check failed in syr2k(): size of A does not match size of C"));
+
+      switch (viennacl::traits::handle(A).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(A));
+          viennacl::linalg::host_based::syr2k(A, B, trans, C, alpha, beta, tag, mirror);
+          break;
+        }
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+    /** @brief Symmetric matrix-matrix product: Computes C = alpha * A * B + beta * C (left) or C = alpha * B * A + beta * C (right), where only the lower or upper triangle of the symmetric matrix A is referenced.
+    *
+    * Currently only available for the host backend.
+    *
+    * @param A        The symmetric matrix A
+    * @param tag      Either lower_tag or upper_tag, denoting the referenced triangle of A
+    * @param B        The matrix B
+    * @param C        The result matrix
+    * @param alpha    Scaling factor for the product
+    * @param beta     Scaling factor for C
+    * @param left     Whether A is multiplied from the left
+    */
+    template<typename NumericT, typename ScalarT, typename TriangleTagT>
+    void symm(matrix_base<NumericT> const & A, TriangleTagT tag,
+              matrix_base<NumericT> const & B,
+              matrix_base<NumericT> & C,
+              ScalarT alpha, ScalarT beta, bool left = true)
+    {
+      assert(viennacl::traits::size1(A) == viennacl::traits::size2(A) && bool("Size check failed in symm(): size1(A) != size2(A)"));
+      assert(viennacl::traits::size1(B) == viennacl::traits::size1(C) && viennacl::traits::size2(B) == viennacl::traits::size2(C) && bool("Size check failed in symm(): size(B) != size(C)"));
+      assert((left ? viennacl::traits::size1(B) : viennacl::traits::size2(B)) == viennacl::traits::size1(A) && bool("Size check failed in symm(): size of A does not match size of B"));
+
+      switch (viennacl::traits::handle(A).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(A));
+          viennacl::linalg::host_based::symm(A, tag, B, C, alpha, beta, left);
+          break;
+        }
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+    /** @brief Triangular matrix-matrix product: Computes B = alpha * op(A) * B (left) or B = alpha * B * op(A) (right), where op(A) is either A or A^T.
+    *
+    * Only the triangle of A given by the tag (lower_tag, upper_tag, unit_lower_tag, or unit_upper_tag) is referenced.
+    * Currently only available for the host backend.
+    *
+    * @param A        The triangular matrix A
+    * @param tag      The tag denoting the triangle of A and whether the diagonal is unit
+    * @param trans_A  Whether A is transposed
+    * @param B        The matrix B, overwritten by the result
+    * @param alpha    Scaling factor for the product
+    * @param left     Whether A is multiplied from the left
+    */
+    template<typename NumericT, typename ScalarT, typename TriangleTagT>
+    void trmm(matrix_base<NumericT> const & A, TriangleTagT tag, bool trans_A,
+              matrix_base<NumericT> & B,
+              ScalarT alpha, bool left = true)
+    {
+      assert(viennacl::traits::size1(A) == viennacl::traits::size2(A) && bool("Size check failed in trmm(): size1(A) != size2(A)"));
+      assert((left ? viennacl::traits::size1(B) : viennacl::traits::size2(B)) == viennacl::traits::size1(A) && bool("Size check failed in trmm(): size of A does not match size of B"));
+
+      switch (viennacl::traits::handle(A).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(A));
+          viennacl::linalg::host_based::trmm(A, tag, trans_A, B, alpha, left);
+          break;
+        }
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+
+
     ///////////////////////// Elementwise operations /////////////
 
 
@@ -665,8 +956,11 @@ namespace viennacl
       switch (viennacl::traits::handle(A).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(A));
           viennacl::linalg::host_based::element_op(A, proxy);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::element_op(A, proxy);
@@ -821,10 +1115,13 @@ namespace viennacl
       switch (viennacl::traits::handle(mat1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(mat1));
           viennacl::linalg::host_based::scaled_rank_1_update(mat1,
                                                              alpha, len_alpha, reciprocal_alpha, flip_sign_alpha,
                                                              vec1, vec2);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::scaled_rank_1_update(mat1,
@@ -863,8 +1160,11 @@ namespace viennacl
       switch (viennacl::traits::handle(A).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(A));
           viennacl::linalg::host_based::bidiag_pack(A, dh, sh);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::bidiag_pack(A, dh, sh);
@@ -906,8 +1206,11 @@ namespace viennacl
       switch (viennacl::traits::handle(A).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(A));
           viennacl::linalg::host_based::copy_vec(A, V, row_start, col_start, copy_col);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::copy_vec(A, V, row_start, col_start, copy_col);
@@ -942,8 +1245,11 @@ namespace viennacl
     switch (viennacl::traits::handle(A).get_active_handle_id())
     {
       case viennacl::MAIN_MEMORY:
+      {
+        viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(A));
         viennacl::linalg::host_based::house_update_A_left(A, D, start);
         break;
+      }
 #ifdef VIENNACL_WITH_OPENCL
       case viennacl::OPENCL_MEMORY:
         viennacl::linalg::opencl::house_update_A_left(A, D, start);
@@ -978,8 +1284,11 @@ namespace viennacl
     switch (viennacl::traits::handle(A).get_active_handle_id())
     {
       case viennacl::MAIN_MEMORY:
+      {
+        viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(A));
         viennacl::linalg::host_based::house_update_A_right(A, D);
         break;
+      }
 #ifdef VIENNACL_WITH_OPENCL
       case viennacl::OPENCL_MEMORY:
         viennacl::linalg::opencl::house_update_A_right(A, D);
@@ -1014,8 +1323,11 @@ namespace viennacl
     switch (viennacl::traits::handle(Q).get_active_handle_id())
     {
       case viennacl::MAIN_MEMORY:
+      {
+        viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(Q));
         viennacl::linalg::host_based::house_update_QL(Q, D, A_size1);
         break;
+      }
 #ifdef VIENNACL_WITH_OPENCL
       case viennacl::OPENCL_MEMORY:
         viennacl::linalg::opencl::house_update_QL(Q, D, A_size1);
@@ -1056,8 +1368,11 @@ namespace viennacl
     switch (viennacl::traits::handle(Q).get_active_handle_id())
     {
       case viennacl::MAIN_MEMORY:
+      {
+        viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(Q));
         viennacl::linalg::host_based::givens_next(Q, tmp1, tmp2, l, m);
         break;
+      }
 #ifdef VIENNACL_WITH_OPENCL
       case viennacl::OPENCL_MEMORY:
         viennacl::linalg::opencl::givens_next(Q, tmp1, tmp2, l, m);
@@ -1092,8 +1407,11 @@ namespace viennacl
     switch (viennacl::traits::handle(vec1).get_active_handle_id())
     {
       case viennacl::MAIN_MEMORY:
+      {
+        viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(vec1));
         viennacl::linalg::host_based::inclusive_scan(vec1, vec2);
         break;
+      }
 #ifdef VIENNACL_WITH_OPENCL
       case viennacl::OPENCL_MEMORY:
         viennacl::linalg::opencl::inclusive_scan(vec1, vec2);
@@ -1128,8 +1446,11 @@ namespace viennacl
     switch (viennacl::traits::handle(vec1).get_active_handle_id())
     {
       case viennacl::MAIN_MEMORY:
+      {
+        viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(vec1));
         viennacl::linalg::host_based::exclusive_scan(vec1, vec2);
         break;
+      }
 #ifdef VIENNACL_WITH_OPENCL
       case viennacl::OPENCL_MEMORY:
         viennacl::linalg::opencl::exclusive_scan(vec1, vec2);
@@ -62,8 +62,11 @@ namespace viennacl
         switch (viennacl::traits::handle(vec).get_active_handle_id())
         {
           case viennacl::MAIN_MEMORY:
+          {
+            viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(vec));
             viennacl::linalg::host_based::detail::level_scheduling_substitute(vec, row_index_array, row_buffer, col_buffer, element_buffer, num_rows);
             break;
+          }
 #ifdef VIENNACL_WITH_OPENCL
           case viennacl::OPENCL_MEMORY:
             viennacl::linalg::opencl::detail::level_scheduling_substitute(vec, row_index_array, row_buffer, col_buffer, element_buffer, num_rows);
@@ -63,8 +63,11 @@ namespace viennacl
       switch (viennacl::traits::handle(V).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(V));
           viennacl::linalg::host_based::nmf(V, W, H, conf);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
           case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::nmf(V,W,H,conf);
@@ -0,0 +1,243 @@
+#ifndef VIENNACL_LINALG_POLYNOMIAL_PRECOND_HPP_
+#define VIENNACL_LINALG_POLYNOMIAL_PRECOND_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/polynomial_precond.hpp
+    @brief Chebyshev and Neumann polynomial preconditioners, which only require sparse matrix-vector products and vector updates.
+*/
+
+#include <vector>
+#include <cmath>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/tools/tools.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/sparse_matrix_operations.hpp"
+#include "viennacl/linalg/row_scaling.hpp"
+#include "viennacl/linalg/chebyshev.hpp"
+#include "viennacl/linalg/iterative_operations.hpp"
+#include "viennacl/traits/context.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+
+/** @brief A tag for a polynomial preconditioner.
+*
+* The preconditioner applies p(D^{-1}A) D^{-1}, where D is the diagonal of A (or the identity if diagonal scaling is disabled) and p is a polynomial of the given degree.
+* Bounds of the spectrum of D^{-1}A are estimated from a few Lanczos steps during the setup unless they are set explicitly.
+*/
+class polynomial_precond_tag
+{
+public:
+  /** @brief The type of the polynomial */
+  enum polynomial_type
+  {
+    chebyshev_polynomial = 0,  ///< Chebyshev polynomial for the interval of the spectrum
+    neumann_polynomial         ///< Truncated Neumann series, i.e. damped Richardson iterations
+  };
+
+  /** @brief The constructor
+  *
+  * @param degree           Degree of the polynomial. The application of the preconditioner requires 'degree' sparse matrix-vector products.
+  * @param type             Chebyshev polynomial or truncated Neumann series
+  * @param diagonal_scaling Whether the polynomial is applied to the Jacobi-scaled matrix D^{-1}A. Only available for compressed_matrix and coordinate_matrix, ignored for other formats.
+  */
+  polynomial_precond_tag(unsigned int degree = 3, polynomial_type type = chebyshev_polynomial, bool diagonal_scaling = true)
+    : degree_(degree), type_(type), diagonal_scaling_(diagonal_scaling), estimation_steps_(20), lower_(0), upper_(0) {}
+
+  /** @brief Returns the degree of the polynomial */
+  unsigned int degree() const { return degree_; }
+  /** @brief Returns the type of the polynomial */
+  polynomial_type type() const { return type_; }
+  /** @brief Returns whether the polynomial is applied to the Jacobi-scaled matrix */
+  bool diagonal_scaling() const { return diagonal_scaling_; }
+
+  /** @brief Sets the bounds of the spectrum of the (scaled) system matrix. Passing zero for both restores the automatic estimate. */
+  void set_spectrum_bounds(double lower, double upper) { lower_ = lower; upper_ = upper; }
+  /** @brief Returns true if the bounds of the spectrum are set by the user rather than estimated */
+  bool has_spectrum_bounds() const { return upper_ > 0; }
+  double spectrum_lower() const { return lower_; }
+  double spectrum_upper() const { return upper_; }
+
+  /** @brief Sets the number of Lanczos steps used for estimating the bounds of the spectrum */
+  void set_estimation_steps(unsigned int steps) { if (steps > 0) estimation_steps_ = steps; }
+  /** @brief Returns the number of Lanczos steps used for estimating the bounds of the spectrum */
+  unsigned int estimation_steps() const { return estimation_steps_; }
+
+private:
+  unsigned int degree_;
+  polynomial_type type_;
+  bool diagonal_scaling_;
+  unsigned int estimation_steps_;
+  double lower_;
+  double upper_;
+};
+
+namespace detail
+{
+  /** @brief Extracts the inverse of the diagonal for the diagonal scaling of a polynomial preconditioner. Returns false if the matrix type does not provide its diagonal. */
+  template<typename MatrixT,
+           bool has_diagonal = detail::row_scaling_for_viennacl<MatrixT>::value >
+  struct polynomial_precond_diagonal
+  {
+    template<typename NumericT>
+    static bool apply(MatrixT const &, viennacl::vector<NumericT> &) { return false; }
+  };
+
+  template<typename MatrixT>
+  struct polynomial_precond_diagonal<MatrixT, true>
+  {
+    template<typename NumericT>
+    static bool apply(MatrixT const & A, viennacl::vector<NumericT> & diag_inv)
+    {
+      viennacl::vector<NumericT> diag(A.size1(), viennacl::traits::context(A));
+      viennacl::linalg::detail::row_info(A, diag, viennacl::linalg::detail::SPARSE_ROW_DIAGONAL);
+
+      // Rows without a diagonal entry are not scaled:
+      std::vector<NumericT> host_diag(diag.size());
+      viennacl::copy(diag, host_diag);
+      for (vcl_size_t i=0; i<host_diag.size(); ++i)
+        host_diag[i] = (host_diag[i] != NumericT(0)) ? NumericT(1) / host_diag[i] : NumericT(1);
+
+      diag_inv.resize(host_diag.size(), viennacl::traits::context(A), false);
+      viennacl::copy(host_diag, diag_inv);
+      return true;
+    }
+  };
+
+  /** @brief Diagonal scaling vec <- D^{-1} vec used for estimating the spectrum of D^{-1}A */
+  template<typename NumericT>
+  class polynomial_precond_scaling
+  {
+  public:
+    polynomial_precond_scaling(viennacl::vector<NumericT> const & diag_inv) : diag_inv_(diag_inv) {}
+
+    void apply(viennacl::vector<NumericT> & vec) const { vec = viennacl::linalg::element_prod(vec, diag_inv_); }
+
+  private:
+    viennacl::vector<NumericT> const & diag_inv_;
+  };
+}
+
+/** @brief Polynomial preconditioner for symmetric positive definite matrices, can be supplied to solve()-routines and used with any of the ViennaCL sparse matrix types.
+*
+* The preconditioner is a fixed number of steps of the (Jacobi-scaled) Chebyshev or Richardson iteration with zero initial guess, hence it is a symmetric positive definite linear operator suitable for CG.
+* Its application consists of sparse matrix-vector products and fused vector updates only, no inner products are computed.
+*/
+template<typename MatrixT>
+class polynomial_precond
+{
+  typedef typename viennacl::result_of::cpu_value_type<typename MatrixT::value_type>::type  NumericType;
+
+public:
+  polynomial_precond(MatrixT const & mat, polynomial_precond_tag const & tag) : A_(mat), tag_(tag), use_diagonal_(false), lower_(0), upper_(0)
+  {
+    init();
+  }
+
+  /** @brief Sets up the diagonal scaling and the bounds of the spectrum. Needs to be called if the system matrix changes. */
+  void init()
+  {
+    viennacl::context ctx = viennacl::traits::context(A_);
+    vcl_size_t size = A_.size1();
+
+    use_diagonal_ = tag_.diagonal_scaling() && detail::polynomial_precond_diagonal<MatrixT>::apply(A_, diag_inv_);
+
+    lower_ = tag_.spectrum_lower();
+    upper_ = tag_.spectrum_upper();
+    if (!tag_.has_spectrum_bounds())
+    {
+      if (use_diagonal_)
+        viennacl::linalg::detail::chebyshev_estimate_spectrum<NumericType>(A_, detail::polynomial_precond_scaling<NumericType>(diag_inv_), size, ctx, tag_.estimation_steps(), lower_, upper_);
+      else
+        viennacl::linalg::detail::chebyshev_estimate_spectrum<NumericType>(A_, viennacl::linalg::no_precond(), size, ctx, tag_.estimation_steps(), lower_, upper_);
+      if (upper_ <= 0) // estimate failed, fall back to plain (scaled) Richardson steps
+        upper_ = 2;
+      viennacl::linalg::detail::chebyshev_safe_bounds(lower_, upper_);
+    }
+    assert(lower_ > 0 && lower_ < upper_ && bool("Invalid bounds of the spectrum for the polynomial preconditioner!"));
+
+    x_.resize(size, ctx, false);
+    r_.resize(size, ctx, false);
+    d_.resize(size, ctx, false);
+    Ad_.resize(size, ctx, false);
+  }
+
+  /** @brief Applies the polynomial preconditioner to 'vec' */
+  void apply(viennacl::vector<NumericType> & vec) const
+  {
+    assert(vec.size() == A_.size1() && bool("Size mismatch"));
+
+    NumericType theta = NumericType((upper_ + lower_) / 2.0);
+    NumericType delta = NumericType((upper_ - lower_) / 2.0);
+    NumericType sigma = theta / delta;
+    NumericType rho   = NumericType(1) / sigma;
+    viennacl::vector<NumericType> const * diag_inv = use_diagonal_ ? &diag_inv_ : NULL;
+
+    // first step: d = D^{-1} vec / theta, the iterate is zero:
+    r_ = vec;
+    if (use_diagonal_)
+      d_ = viennacl::linalg::element_prod(diag_inv_, r_);
+    else
+      d_ = r_;
+    d_ /= theta;
+    x_.clear();
+
+    for (unsigned int k=0; k<tag_.degree(); ++k)
+    {
+      Ad_ = viennacl::linalg::prod(A_, d_);
+      if (tag_.type() == polynomial_precond_tag::neumann_polynomial)
+        viennacl::linalg::chebyshev_vector_update(x_, r_, d_, Ad_, NumericType(0), NumericType(1) / theta, diag_inv);
+      else
+      {
+        NumericType rho_new = NumericType(1) / (NumericType(2) * sigma - rho);
+        viennacl::linalg::chebyshev_vector_update(x_, r_, d_, Ad_, rho_new * rho, NumericType(2) * rho_new / delta, diag_inv);
+        rho = rho_new;
+      }
+    }
+
+    vec = x_ + d_;
+  }
+
+  /** @brief Returns the lower bound of the spectrum of the (scaled) system matrix used by the polynomial */
+  double spectrum_lower() const { return lower_; }
+  /** @brief Returns the upper bound of the spectrum of the (scaled) system matrix used by the polynomial */
+  double spectrum_upper() const { return upper_; }
+
+private:
+  MatrixT const & A_;
+  polynomial_precond_tag tag_;
+  bool use_diagonal_;
+  double lower_;
+  double upper_;
+  viennacl::vector<NumericType> diag_inv_;
+
+  mutable viennacl::vector<NumericType> x_;
+  mutable viennacl::vector<NumericType> r_;
+  mutable viennacl::vector<NumericType> d_;
+  mutable viennacl::vector<NumericType> Ad_;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,751 @@
+#ifndef VIENNACL_LINALG_QR_METHOD_REDUCTION_HPP_
+#define VIENNACL_LINALG_QR_METHOD_REDUCTION_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/qr-method-reduction.hpp
+    @brief Blocked reduction of dense matrices to tridiagonal or Hessenberg form on the host, used by the QR method.
+
+    Householder reflectors are aggregated over panels of columns, so that most of the update of the trailing matrix is carried out by matrix-matrix products.
+    All matrices are dense column-major arrays with a leading dimension.
+*/
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "viennacl/matrix.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/matrix_operations.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+/** @brief Number of columns aggregated into one block of Householder reflectors */
+#define VIENNACL_QR_METHOD_BLOCK_SIZE  32
+
+/** @brief Below this size the remaining matrix is reduced one reflector at a time */
+#define VIENNACL_QR_METHOD_BLOCK_CROSSOVER  128
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace detail
+{
+  /** @brief C = alpha * op(A) * op(B) + beta * C for column-major host arrays, carried out by the blocked host matrix-matrix product. */
+  template<typename NumericT>
+  void reduction_gemm(bool trans_A, bool trans_B,
+                      vcl_size_t m, vcl_size_t n, vcl_size_t k,
+                      NumericT alpha, NumericT const * A, vcl_size_t lda,
+                                      NumericT const * B, vcl_size_t ldb,
+                      NumericT beta,  NumericT       * C, vcl_size_t ldc)
+  {
+    using viennacl::linalg::host_based::detail::matrix_array_wrapper;
+    using viennacl::linalg::host_based::detail::prod;
+
+    if (m == 0 || n == 0)
+      return;
+    if (k == 0)
+    {
+      for (vcl_size_t j = 0; j < n; ++j)
+        for (vcl_size_t i = 0; i < m; ++i)
+          C[i + j * ldc] *= beta;
+      return;
+    }
+
+    matrix_array_wrapper<NumericT, viennacl::column_major, false> wrapper_C(C, 0, 0, 1, 1, ldc, n);
+    if (!trans_A && !trans_B)
+    {
+      matrix_array_wrapper<NumericT const, viennacl::column_major, false> wrapper_A(A, 0, 0, 1, 1, lda, k);
+      matrix_array_wrapper<NumericT const, viennacl::column_major, false> wrapper_B(B, 0, 0, 1, 1, ldb, n);
+      prod(wrapper_A, wrapper_B, wrapper_C, m, n, k, alpha, beta);
+    }
+    else if (!trans_A && trans_B)
+    {
+      matrix_array_wrapper<NumericT const, viennacl::column_major, false> wrapper_A(A, 0, 0, 1, 1, lda, k);
+      matrix_array_wrapper<NumericT const, viennacl::column_major, true>  wrapper_B(B, 0, 0, 1, 1, ldb, k);
+      prod(wrapper_A, wrapper_B, wrapper_C, m, n, k, alpha, beta);
+    }
+    else if (trans_A && !trans_B)
+    {
+      matrix_array_wrapper<NumericT const, viennacl::column_major, true>  wrapper_A(A, 0, 0, 1, 1, lda, m);
+      matrix_array_wrapper<NumericT const, viennacl::column_major, false> wrapper_B(B, 0, 0, 1, 1, ldb, n);
+      prod(wrapper_A, wrapper_B, wrapper_C, m, n, k, alpha, beta);
+    }
+    else
+    {
+      matrix_array_wrapper<NumericT const, viennacl::column_major, true>  wrapper_A(A, 0, 0, 1, 1, lda, m);
+      matrix_array_wrapper<NumericT const, viennacl::column_major, true>  wrapper_B(B, 0, 0, 1, 1, ldb, k);
+      prod(wrapper_A, wrapper_B, wrapper_C, m, n, k, alpha, beta);
+    }
+  }
+
+  /** @brief Generates a Householder reflector H = I - tau * v * v^T with H * [alpha; x] = [beta; 0] and v = [1; x_out].
+  *
+  * @param n       Length of the vector [alpha; x]
+  * @param alpha   First entry, overwritten by beta
+  * @param x       Remaining n-1 entries (contiguous), overwritten by the trailing part of v
+  * @return        tau (zero if no reflection is needed)
+  */
+  template<typename NumericT>
+  NumericT reduction_householder(vcl_size_t n, NumericT & alpha, NumericT * x)
+  {
+    if (n <= 1)
+      return 0;
+
+    NumericT x_norm2 = 0;
+    for (vcl_size_t i = 0; i + 1 < n; ++i)
+      x_norm2 += x[i] * x[i];
+    if (x_norm2 <= 0)
+      return 0;
+
+    NumericT beta = std::sqrt(alpha * alpha + x_norm2);
+    if (alpha > 0)
+      beta = -beta;
+    NumericT tau = (beta - alpha) / beta;
+    NumericT scale = NumericT(1) / (alpha - beta);
+    for (vcl_size_t i = 0; i + 1 < n; ++i)
+      x[i] *= scale;
+    alpha = beta;
+    return tau;
+  }
+
+  /** @brief y = A * v for the symmetric m x m matrix A of which only the lower triangle is referenced */
+  template<typename NumericT>
+  void reduction_symv_lower(vcl_size_t m, NumericT const * A, vcl_size_t lda, NumericT const * v, NumericT * y)
+  {
+    // contributions of the lower triangle including the diagonal: y_j = A(j:m, j)^T v(j:m)
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (m > VIENNACL_QR_METHOD_BLOCK_CROSSOVER)
+#endif
+    for (long j2 = 0; j2 < static_cast<long>(m); ++j2)
+    {
+      vcl_size_t j = vcl_size_t(j2);
+      NumericT const * a = A + j * lda;
+      NumericT sum = 0;
+      for (vcl_size_t r = j; r < m; ++r)
+        sum += a[r] * v[r];
+      y[j] = sum;
+    }
+
+    // contributions of the strict upper triangle, computed as the strict lower triangle times v in chunks of rows:
+    long num_chunks = static_cast<long>((m + 255) / 256);
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (m > VIENNACL_QR_METHOD_BLOCK_CROSSOVER)
+#endif
+    for (long chunk = 0; chunk < num_chunks; ++chunk)
+    {
+      vcl_size_t row_begin = vcl_size_t(chunk) * 256;
+      vcl_size_t row_end   = std::min<vcl_size_t>(m, row_begin + 256);
+      for (vcl_size_t c = 0; c + 1 < row_end; ++c)
+      {
+        NumericT const * a = A + c * lda;
+        NumericT vc = v[c];
+        for (vcl_size_t r = std::max(row_begin, c + 1); r < row_end; ++r)
+          y[r] += a[r] * vc;
+      }
+    }
+  }
+
+  /** @brief A -= V * W^T + W * V^T on the lower triangle of the m x m matrix A, where V and W are m x k */
+  template<typename NumericT>
+  void reduction_syr2k_lower(vcl_size_t m, vcl_size_t k,
+                             NumericT const * V, vcl_size_t ldv,
+                             NumericT const * W, vcl_size_t ldw,
+                             NumericT * A, vcl_size_t lda)
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for schedule(dynamic, 16) if (m > VIENNACL_QR_METHOD_BLOCK_CROSSOVER)
+#endif
+    for (long j2 = 0; j2 < static_cast<long>(m); ++j2)
+    {
+      vcl_size_t j = vcl_size_t(j2);
+      NumericT * a = A + j * lda;
+      for (vcl_size_t l = 0; l < k; ++l)
+      {
+        NumericT const * v = V + l * ldv;
+        NumericT const * w = W + l * ldw;
+        NumericT w_j = w[j];
+        NumericT v_j = v[j];
+        for (vcl_size_t r = j; r < m; ++r)
+          a[r] -= v[r] * w_j + w[r] * v_j;
+      }
+    }
+  }
+
+  /** @brief Forms the triangular factor T of the block reflector H_0 * ... * H_{k-1} = I - V * T * V^T, where V (m x k) is unit lower triangular with explicitly stored ones and zeros. */
+  template<typename NumericT>
+  void reduction_block_reflector_factor(vcl_size_t m, vcl_size_t k, NumericT const * V, vcl_size_t ldv, NumericT const * tau, NumericT * T, vcl_size_t ldt)
+  {
+    std::vector<NumericT> t(k);
+    for (vcl_size_t i = 0; i < k; ++i)
+    {
+      // T(0:i, i) = -tau_i * T(0:i, 0:i) * V(:, 0:i)^T * v_i
+      NumericT const * v_i = V + i * ldv;
+      for (vcl_size_t l = 0; l < i; ++l)
+      {
+        NumericT const * v_l = V + l * ldv;
+        NumericT sum = 0;
+        for (vcl_size_t r = i; r < m; ++r)
+          sum += v_l[r] * v_i[r];
+        t[l] = -tau[i] * sum;
+      }
+      for (vcl_size_t q = 0; q < i; ++q)
+      {
+        NumericT sum = 0;
+        for (vcl_size_t l = q; l < i; ++l)
+          sum += T[q + l * ldt] * t[l];
+        T[q + i * ldt] = sum;
+      }
+      for (vcl_size_t q = i + 1; q < k; ++q)
+        T[q + i * ldt] = 0;
+      T[i + i * ldt] = tau[i];
+    }
+  }
+
+  /** @brief Applies the block reflector (I - V * T * V^T) or its transpose from the left to the m x n matrix C. */
+  template<typename NumericT>
+  void reduction_apply_block_reflector(bool transposed, vcl_size_t m, vcl_size_t n, vcl_size_t k,
+                                       NumericT const * V, vcl_size_t ldv,
+                                       NumericT const * T, vcl_size_t ldt,
+                                       NumericT * C, vcl_size_t ldc)
+  {
+    if (m == 0 || n == 0 || k == 0)
+      return;
+
+    // W = V^T * C
+    std::vector<NumericT> W(k * n);
+    reduction_gemm(true, false, k, n, m, NumericT(1), V, ldv, C, ldc, NumericT(0), &W[0], k);
+
+    // W = T * W or W = T^T * W (T is upper triangular)
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (n > VIENNACL_QR_METHOD_BLOCK_CROSSOVER)
+#endif
+    for (long j = 0; j < static_cast<long>(n); ++j)
+    {
+      NumericT * w = &W[vcl_size_t(j) * k];
+      if (transposed)
+      {
+        for (vcl_size_t q = k; q-- > 0; )
+        {
+          NumericT sum = 0;
+          for (vcl_size_t l = 0; l <= q; ++l)
+            sum += T[l + q * ldt] * w[l];
+          w[q] = sum;
+        }
+      }
+      else
+      {
+        for (vcl_size_t q = 0; q < k; ++q)
+        {
+          NumericT sum = 0;
+          for (vcl_size_t l = q; l < k; ++l)
+            sum += T[q + l * ldt] * w[l];
+          w[q] = sum;
+        }
+      }
+    }
+
+    // C -= V * W
+    reduction_gemm(false, false, m, n, k, NumericT(-1), V, ldv, &W[0], k, NumericT(1), C, ldc);
+  }
+
+  /** @brief Copies the reflectors k0, ..., k0+k-1 into an explicit unit lower triangular matrix.
+  *
+  * Reflector j has its head (the implicit one) at row j of the m x ... array A, the trailing part is stored below.
+  * The result holds rows k0, ..., m-1 of the reflectors.
+  */
+  template<typename NumericT>
+  void reduction_explicit_reflectors(vcl_size_t m, vcl_size_t k0, vcl_size_t k, NumericT const * A, vcl_size_t lda, std::vector<NumericT> & V)
+  {
+    vcl_size_t rows = m - k0;
+    V.assign(rows * k, NumericT(0));
+    for (vcl_size_t l = 0; l < k; ++l)
+    {
+      NumericT const * a = A + (k0 + l) * lda;
+      NumericT * v = &V[l * rows];
+      v[l] = 1;
+      for (vcl_size_t r = l + 1; r < rows; ++r)
+        v[r] = a[k0 + r];
+    }
+  }
+
+  /** @brief Forms Q = H_0 * H_1 * ... * H_{k-1} (m x m) explicitly, using block reflectors applied in backward order.
+  *
+  * Reflector j has its head at row j of A and its trailing part stored in A(j+1:m, j).
+  */
+  template<typename NumericT>
+  void reduction_form_q(vcl_size_t m, vcl_size_t k, NumericT const * A, vcl_size_t lda, NumericT const * tau,
+                        NumericT * Q, vcl_size_t ldq)
+  {
+    for (vcl_size_t j = 0; j < m; ++j)
+      for (vcl_size_t i = 0; i < m; ++i)
+        Q[i + j * ldq] = (i == j) ? NumericT(1) : NumericT(0);
+    if (k == 0)
+      return;
+
+    vcl_size_t nb = VIENNACL_QR_METHOD_BLOCK_SIZE;
+    std::vector<NumericT> V;
+    std::vector<NumericT> T(nb * nb);
+    for (vcl_size_t block_start = ((k - 1) / nb) * nb; ; block_start -= nb)
+    {
+      vcl_size_t kb = std::min(nb, k - block_start);
+      vcl_size_t rows = m - block_start;
+      reduction_explicit_reflectors(m, block_start, kb, A, lda, V);
+      reduction_block_reflector_factor(rows, kb, &V[0], rows, tau + block_start, &T[0], nb);
+
+      // columns left of block_start are still unit vectors and not affected:
+      reduction_apply_block_reflector(false, rows, rows, kb, &V[0], rows, &T[0], nb,
+                                      Q + block_start + block_start * ldq, ldq);
+      if (block_start == 0)
+        break;
+    }
+  }
+
+
+  /** @brief Reduces the lower triangle of the symmetric n x n matrix A to tridiagonal form by one reflector at a time, starting at column 'start'. */
+  template<typename NumericT>
+  void reduction_tridiagonal_unblocked(vcl_size_t n, vcl_size_t start, NumericT * A, vcl_size_t lda, NumericT * d, NumericT * e, NumericT * tau)
+  {
+    std::vector<NumericT> w(n);
+    for (vcl_size_t i = start; i + 1 < n; ++i)
+    {
+      NumericT * a = A + i * lda;
+      vcl_size_t m = n - i - 1;
+      tau[i] = reduction_householder(m, a[i + 1], a + std::min(i + 2, n - 1));
+      e[i] = a[i + 1];
+      if (tau[i] > 0 || tau[i] < 0)
+      {
+        a[i + 1] = 1;
+        NumericT const * v = a + i + 1;
+        NumericT * A22 = A + (i + 1) + (i + 1) * lda;
+
+        // w = tau * A22 * v - 1/2 * tau^2 * (v^T A22 v) * v
+        reduction_symv_lower(m, A22, lda, v, &w[0]);
+        NumericT dot = 0;
+        for (vcl_size_t r = 0; r < m; ++r)
+        {
+          w[r] *= tau[i];
+          dot += w[r] * v[r];
+        }
+        NumericT alpha = NumericT(-0.5) * tau[i] * dot;
+        for (vcl_size_t r = 0; r < m; ++r)
+          w[r] += alpha * v[r];
+
+        // A22 -= v * w^T + w * v^T
+        reduction_syr2k_lower(m, 1, v, m, &w[0], m, A22, lda);
+        a[i + 1] = e[i];
+      }
+      d[i] = a[i];
+    }
+    d[n - 1] = A[(n - 1) + (n - 1) * lda];
+    if (n > 0)
+      tau[n - 1] = 0;
+  }
+
+  /** @brief Reduces the first nb columns of the symmetric (lower triangle) m x m matrix A and computes the matrix W for the rank-2k update of the trailing matrix.
+  *
+  * On exit, A(c+1, c) holds one, the reflectors are stored below. The caller restores the off-diagonal e.
+  */
+  template<typename NumericT>
+  void reduction_tridiagonal_panel(vcl_size_t m, vcl_size_t nb, NumericT * A, vcl_size_t lda, NumericT * e, NumericT * tau, NumericT * W, vcl_size_t ldw)
+  {
+    for (vcl_size_t c = 0; c < nb; ++c)
+    {
+      NumericT * a_c = A + c * lda;
+      NumericT * w_c = W + c * ldw;
+
+      // update A(c:m, c) with the previous reflectors of the panel:
+      for (vcl_size_t l = 0; l < c; ++l)
+      {
+        NumericT const * a_l = A + l * lda;
+        NumericT const * w_l = W + l * ldw;
+        NumericT w_cl = w_l[c];
+        NumericT a_cl = a_l[c];
+        for (vcl_size_t r = c; r < m; ++r)
+          a_c[r] -= a_l[r] * w_cl + w_l[r] * a_cl;
+      }
+
+      if (c + 1 >= m)
+        break;
+
+      tau[c] = reduction_householder(m - c - 1, a_c[c + 1], a_c + std::min(c + 2, m - 1));
+      e[c] = a_c[c + 1];
+      a_c[c + 1] = 1;
+
+      NumericT const * v = a_c + c + 1;
+      vcl_size_t len = m - c - 1;
+
+      // W(c+1:m, c) = A(c+1:m, c+1:m) * v
+      reduction_symv_lower(len, A + (c + 1) + (c + 1) * lda, lda, v, w_c + c + 1);
+
+      // W(c+1:m, c) -= A(c+1:m, 0:c) * (W(c+1:m, 0:c)^T v) + W(c+1:m, 0:c) * (A(c+1:m, 0:c)^T v)
+      for (vcl_size_t l = 0; l < c; ++l)
+      {
+        NumericT const * a_l = A + l * lda + c + 1;
+        NumericT const * w_l = W + l * ldw + c + 1;
+        NumericT wv = 0, av = 0;
+        for (vcl_size_t r = 0; r < len; ++r)
+        {
+          wv += w_l[r] * v[r];
+          av += a_l[r] * v[r];
+        }
+        w_c[l] = wv;   // scratch
+        NumericT * y = w_c + c + 1;
+        for (vcl_size_t r = 0; r < len; ++r)
+          y[r] -= a_l[r] * wv + w_l[r] * av;
+      }
+
+      NumericT * y = w_c + c + 1;
+      NumericT dot = 0;
+      for (vcl_size_t r = 0; r < len; ++r)
+      {
+        y[r] *= tau[c];
+        dot += y[r] * v[r];
+      }
+      NumericT alpha = NumericT(-0.5) * tau[c] * dot;
+      for (vcl_size_t r = 0; r < len; ++r)
+        y[r] += alpha * v[r];
+    }
+  }
+
+  /** @brief Blocked reduction of the symmetric n x n matrix A (lower triangle referenced) to tridiagonal form Q^T A Q = T.
+  *
+  * On exit, d and e hold the diagonal and the off-diagonal of T (e[i] couples i and i+1), the reflectors are stored below the first subdiagonal of A.
+  * Reflector i acts on rows i+1, ..., n-1.
+  */
+  template<typename NumericT>
+  void tridiagonal_reduction_blocked(vcl_size_t n, NumericT * A, vcl_size_t lda,
+                                     std::vector<NumericT> & d, std::vector<NumericT> & e, std::vector<NumericT> & tau)
+  {
+    d.resize(n);
+    e.resize(n);
+    tau.resize(n);
+    if (n == 0)
+      return;
+    e[n - 1] = 0;
+
+    vcl_size_t nb = VIENNACL_QR_METHOD_BLOCK_SIZE;
+    vcl_size_t i = 0;
+    std::vector<NumericT> W(n * nb);
+    for (; i + VIENNACL_QR_METHOD_BLOCK_CROSSOVER < n; i += nb)
+    {
+      vcl_size_t m = n - i;
+      NumericT * A_i = A + i + i * lda;
+      std::fill(W.begin(), W.end(), NumericT(0));
+      reduction_tridiagonal_panel(m, nb, A_i, lda, &e[i], &tau[i], &W[0], m);
+
+      // A(i+nb:n, i+nb:n) -= V * W^T + W * V^T
+      reduction_syr2k_lower(m - nb, nb, A_i + nb, lda, &W[nb], m, A_i + nb + nb * lda, lda);
+
+      for (vcl_size_t j = i; j < i + nb; ++j)
+      {
+        A[(j + 1) + j * lda] = e[j];
+        d[j] = A[j + j * lda];
+      }
+    }
+
+    reduction_tridiagonal_unblocked(n, i, A, lda, &d[0], &e[0], &tau[0]);
+  }
+
+
+  /** @brief Reduces the n x n matrix A to upper Hessenberg form by one reflector at a time, starting at column 'start'. */
+  template<typename NumericT>
+  void reduction_hessenberg_unblocked(vcl_size_t n, vcl_size_t start, NumericT * A, vcl_size_t lda, NumericT * tau)
+  {
+    std::vector<NumericT> w(n);
+    for (vcl_size_t j = start; j + 1 < n; ++j)
+    {
+      NumericT * a = A + j * lda;
+      vcl_size_t m = n - j - 1;
+      tau[j] = reduction_householder(m, a[j + 1], a + std::min(j + 2, n - 1));
+      if (!(tau[j] > 0 || tau[j] < 0))
+        continue;
+
+      NumericT a_head = a[j + 1];
+      a[j + 1] = 1;
+      NumericT const * v = a + j + 1;
+
+      // right: A(0:n, j+1:n) -= tau * (A(0:n, j+1:n) v) v^T
+      std::fill(w.begin(), w.end(), NumericT(0));
+      for (vcl_size_t l = 0; l < m; ++l)
+      {
+        NumericT const * col = A + (j + 1 + l) * lda;
+        NumericT vl = v[l];
+        for (vcl_size_t r = 0; r < n; ++r)
+          w[r] += col[r] * vl;
+      }
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for if (n > VIENNACL_QR_METHOD_BLOCK_CROSSOVER)
+#endif
+      for (long l = 0; l < static_cast<long>(m); ++l)
+      {
+        NumericT * col = A + (j + 1 + vcl_size_t(l)) * lda;
+        NumericT factor = tau[j] * v[l];
+        for (vcl_size_t r = 0; r < n; ++r)
+          col[r] -= w[r] * factor;
+      }
+
+      // left: A(j+1:n, j+1:n) -= tau * v (v^T A(j+1:n, j+1:n))
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for if (n > VIENNACL_QR_METHOD_BLOCK_CROSSOVER)
+#endif
+      for (long l = 0; l < static_cast<long>(m); ++l)
+      {
+        NumericT * col = A + (j + 1 + vcl_size_t(l)) * lda + j + 1;
+        NumericT sum = 0;
+        for (vcl_size_t r = 0; r < m; ++r)
+          sum += v[r] * col[r];
+        sum *= tau[j];
+        for (vcl_size_t r = 0; r < m; ++r)
+          col[r] -= sum * v[r];
+      }
+
+      a[j + 1] = a_head;
+    }
+    if (n > 0)
+      tau[n - 1] = 0;
+  }
+
+  /** @brief Reduces the panel of ib columns starting at column p of the n x n matrix A, such that the entries below the first subdiagonal become zero.
+  *
+  * Computes the triangular factor T of the block reflector V and Y = A * V * T, which are needed for the update of the remaining matrix.
+  * Only the panel columns are modified in A.
+  */
+  template<typename NumericT>
+  void reduction_hessenberg_panel(vcl_size_t n, vcl_size_t p, vcl_size_t ib, NumericT * A, vcl_size_t lda, NumericT * tau,
+                                  NumericT * T, vcl_size_t ldt, NumericT * Y, vcl_size_t ldy)
+  {
+#define VIENNACL_QR_A(i, j) A[(i) + (j) * lda]
+#define VIENNACL_QR_Y(i, j) Y[(i) + (j) * ldy]
+#define VIENNACL_QR_T(i, j) T[(i) + (j) * ldt]
+
+    std::vector<NumericT> w(ib);
+    NumericT ei = 0;
+    for (vcl_size_t l = 0; l < ib; ++l)
+    {
+      vcl_size_t j = p + l;
+      if (l > 0)
+      {
+        // A(p+1:n, j) -= Y(p+1:n, 0:l) * A(j, p:p+l)^T
+        for (vcl_size_t q = 0; q < l; ++q)
+        {
+          NumericT factor = VIENNACL_QR_A(j, p + q);
+          for (vcl_size_t r = p + 1; r < n; ++r)
+            VIENNACL_QR_A(r, j) -= VIENNACL_QR_Y(r, q) * factor;
+        }
+
+        // apply (I - V T^T V^T) to the column b = A(p+1:n, j) with V = A(p+1:n, p:p+l) unit lower triangular:
+        for (vcl_size_t q = 0; q < l; ++q)   // w = V^T b
+        {
+          NumericT sum = VIENNACL_QR_A(p + 1 + q, j);
+          for (vcl_size_t r = p + 2 + q; r < n; ++r)
+            sum += VIENNACL_QR_A(r, p + q) * VIENNACL_QR_A(r, j);
+          w[q] = sum;
+        }
+        for (vcl_size_t q = l; q-- > 0; )     // w = T^T w
+        {
+          NumericT sum = 0;
+          for (vcl_size_t s = 0; s <= q; ++s)
+            sum += VIENNACL_QR_T(s, q) * w[s];
+          w[q] = sum;
+        }
+        for (vcl_size_t q = 0; q < l; ++q)   // b -= V w
+        {
+          VIENNACL_QR_A(p + 1 + q, j) -= w[q];
+          for (vcl_size_t r = p + 2 + q; r < n; ++r)
+            VIENNACL_QR_A(r, j) -= VIENNACL_QR_A(r, p + q) * w[q];
+        }
+
+        VIENNACL_QR_A(j, j - 1) = ei;
+      }
+
+      // reflector annihilating A(j+2:n, j)
+      tau[l] = reduction_householder(n - j - 1, VIENNACL_QR_A(j + 1, j), &VIENNACL_QR_A(std::min(j + 2, n - 1), j));
+      ei = VIENNACL_QR_A(j + 1, j);
+      VIENNACL_QR_A(j + 1, j) = 1;
+
+      // Y(p+1:n, l) = A(p+1:n, j+1:n) * v
+      for (vcl_size_t r = p + 1; r < n; ++r)
+        VIENNACL_QR_Y(r, l) = 0;
+      for (vcl_size_t c = j + 1; c < n; ++c)
+      {
+        NumericT vc = VIENNACL_QR_A(c, j);
+        NumericT const * col = &VIENNACL_QR_A(0, c);
+        NumericT * y = &VIENNACL_QR_Y(0, l);
+        for (vcl_size_t r = p + 1; r < n; ++r)
+          y[r] += col[r] * vc;
+      }
+
+      // T(0:l, l) = V(j+1:n, 0:l)^T v
+      for (vcl_size_t q = 0; q < l; ++q)
+      {
+        NumericT sum = 0;
+        for (vcl_size_t r = j + 1; r < n; ++r)
+          sum += VIENNACL_QR_A(r, p + q) * VIENNACL_QR_A(r, j);
+        VIENNACL_QR_T(q, l) = sum;
+      }
+
+      // Y(p+1:n, l) = tau * (Y(p+1:n, l) - Y(p+1:n, 0:l) * T(0:l, l))
+      for (vcl_size_t q = 0; q < l; ++q)
+      {
+        NumericT factor = VIENNACL_QR_T(q, l);
+        for (vcl_size_t r = p + 1; r < n; ++r)
+          VIENNACL_QR_Y(r, l) -= VIENNACL_QR_Y(r, q) * factor;
+      }
+      for (vcl_size_t r = p + 1; r < n; ++r)
+        VIENNACL_QR_Y(r, l) *= tau[l];
+
+      // T(0:l, l) = -tau * T(0:l, 0:l) * T(0:l, l)
+      for (vcl_size_t q = 0; q < l; ++q)
+      {
+        NumericT sum = 0;
+        for (vcl_size_t s = q; s < l; ++s)
+          sum += VIENNACL_QR_T(q, s) * VIENNACL_QR_T(s, l);
+        VIENNACL_QR_T(q, l) = -tau[l] * sum;
+      }
+      VIENNACL_QR_T(l, l) = tau[l];
+      for (vcl_size_t q = l + 1; q < ib; ++q)
+        VIENNACL_QR_T(q, l) = 0;
+    }
+    VIENNACL_QR_A(p + ib, p + ib - 1) = ei;
+
+    // Y(0:p+1, :) = A(0:p+1, p+1:n) * V * T
+    for (vcl_size_t l = 0; l < ib; ++l)
+      for (vcl_size_t r = 0; r <= p; ++r)
+        VIENNACL_QR_Y(r, l) = VIENNACL_QR_A(r, p + 1 + l);
+    for (vcl_size_t l = 0; l < ib; ++l)   // Y = Y * V1, V1 = A(p+1:p+ib+1, p:p+ib) unit lower triangular
+      for (vcl_size_t s = l + 1; s < ib; ++s)
+      {
+        NumericT factor = VIENNACL_QR_A(p + 1 + s, p + l);
+        for (vcl_size_t r = 0; r <= p; ++r)
+          VIENNACL_QR_Y(r, l) += VIENNACL_QR_Y(r, s) * factor;
+      }
+    if (n > p + ib + 1)
+      reduction_gemm(false, false, p + 1, ib, n - p - ib - 1,
+                     NumericT(1), &VIENNACL_QR_A(0, p + ib + 1), lda, &VIENNACL_QR_A(p + ib + 1, p), lda,
+                     NumericT(1), Y, ldy);
+    for (vcl_size_t l = ib; l-- > 0; )    // Y = Y * T
+    {
+      for (vcl_size_t r = 0; r <= p; ++r)
+      {
+        NumericT sum = 0;
+        for (vcl_size_t s = 0; s <= l; ++s)
+          sum += VIENNACL_QR_Y(r, s) * VIENNACL_QR_T(s, l);
+        VIENNACL_QR_Y(r, l) = sum;
+      }
+    }
+
+#undef VIENNACL_QR_A
+#undef VIENNACL_QR_Y
+#undef VIENNACL_QR_T
+  }
+
+  /** @brief Blocked reduction of the n x n matrix A to upper Hessenberg form Q^T A Q = H.
+  *
+  * On exit, the upper Hessenberg part of A holds H, the reflectors are stored below the first subdiagonal.
+  * Reflector j acts on rows j+1, ..., n-1.
+  */
+  template<typename NumericT>
+  void hessenberg_reduction_blocked(vcl_size_t n, NumericT * A, vcl_size_t lda, std::vector<NumericT> & tau)
+  {
+    tau.resize(n);
+    if (n == 0)
+      return;
+
+    vcl_size_t nb = VIENNACL_QR_METHOD_BLOCK_SIZE;
+    std::vector<NumericT> T(nb * nb), Y(n * nb), V;
+    vcl_size_t p = 0;
+    for (; p + 1 + VIENNACL_QR_METHOD_BLOCK_CROSSOVER < n; p += nb)
+    {
+      vcl_size_t ib = nb;
+      reduction_hessenberg_panel(n, p, ib, A, lda, &tau[p], &T[0], nb, &Y[0], n);
+
+      // right update of the trailing columns: A(0:n, p+ib:n) -= Y * V(p+ib:n, :)^T
+      NumericT * a_head = A + (p + ib) + (p + ib - 1) * lda;
+      NumericT ei = *a_head;
+      *a_head = 1;
+      reduction_gemm(false, true, n, n - p - ib, ib,
+                     NumericT(-1), &Y[0], n, A + (p + ib) + p * lda, lda,
+                     NumericT(1), A + (p + ib) * lda, lda);
+      *a_head = ei;
+
+      // right update of the panel columns above the panel: A(0:p+1, p+1:p+ib) -= Y(0:p+1, 0:ib-1) * V1^T
+      for (vcl_size_t m = ib - 1; m-- > 0; )
+        for (vcl_size_t q = 0; q < m; ++q)
+        {
+          NumericT factor = A[(p + 1 + m) + (p + q) * lda];
+          for (vcl_size_t r = 0; r <= p; ++r)
+            Y[r + m * n] += Y[r + q * n] * factor;
+        }
+      for (vcl_size_t m = 0; m + 1 < ib; ++m)
+        for (vcl_size_t r = 0; r <= p; ++r)
+          A[r + (p + 1 + m) * lda] -= Y[r + m * n];
+
+      // left update of the trailing columns: A(p+1:n, p+ib:n) = (I - V T V^T)^T A(p+1:n, p+ib:n)
+      reduction_explicit_reflectors(n - 1, p, ib, A + 1, lda, V);
+      reduction_apply_block_reflector(true, n - p - 1, n - p - ib, ib, &V[0], n - p - 1, &T[0], nb,
+                                      A + (p + 1) + (p + ib) * lda, lda);
+    }
+
+    reduction_hessenberg_unblocked(n, p, A, lda, &tau[0]);
+  }
+
+  /** @brief Copies a dense ViennaCL matrix into a column-major host array */
+  template<typename NumericT>
+  void reduction_matrix_to_host(matrix_base<NumericT> const & M, std::vector<NumericT> & host)
+  {
+    vcl_size_t rows = M.size1();
+    vcl_size_t cols = M.size2();
+    std::vector<NumericT> buffer(M.internal_size());
+    viennacl::backend::memory_read(M.handle(), 0, sizeof(NumericT) * buffer.size(), &buffer[0]);
+
+    host.resize(rows * cols);
+    for (vcl_size_t j = 0; j < cols; ++j)
+      for (vcl_size_t i = 0; i < rows; ++i)
+        host[i + j * rows] = M.row_major() ? buffer[viennacl::row_major::mem_index(i * M.stride1() + M.start1(), j * M.stride2() + M.start2(), M.internal_size1(), M.internal_size2())]
+                                           : buffer[viennacl::column_major::mem_index(i * M.stride1() + M.start1(), j * M.stride2() + M.start2(), M.internal_size1(), M.internal_size2())];
+  }
+
+  /** @brief Copies a column-major host array into a dense ViennaCL matrix */
+  template<typename NumericT>
+  void reduction_host_to_matrix(std::vector<NumericT> const & host, matrix_base<NumericT> & M)
+  {
+    vcl_size_t rows = M.size1();
+    vcl_size_t cols = M.size2();
+    std::vector<NumericT> buffer(M.internal_size());
+    viennacl::backend::memory_read(M.handle(), 0, sizeof(NumericT) * buffer.size(), &buffer[0]);
+
+    for (vcl_size_t j = 0; j < cols; ++j)
+      for (vcl_size_t i = 0; i < rows; ++i)
+      {
+        if (M.row_major())
+          buffer[viennacl::row_major::mem_index(i * M.stride1() + M.start1(), j * M.stride2() + M.start2(), M.internal_size1(), M.internal_size2())] = host[i + j * rows];
+        else
+          buffer[viennacl::column_major::mem_index(i * M.stride1() + M.start1(), j * M.stride2() + M.start2(), M.internal_size1(), M.internal_size2())] = host[i + j * rows];
+      }
+    viennacl::backend::memory_write(M.handle(), 0, sizeof(NumericT) * buffer.size(), &buffer[0]);
+  }
+
+} //namespace detail
+} //namespace linalg
+} //namespace viennacl
+
+#endif
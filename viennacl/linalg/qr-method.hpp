@@ -23,6 +23,8 @@
 
 #include "viennacl/linalg/qr-method-common.hpp"
 #include "viennacl/linalg/tql2.hpp"
+#include "viennacl/linalg/tridiag_eig.hpp"
+#include "viennacl/linalg/qr-method-reduction.hpp"
 #include "viennacl/linalg/prod.hpp"
 
 #include <boost/numeric/ublas/vector.hpp>
@@ -244,7 +246,7 @@ void update_float_QR_column_gpu(matrix_base<SCALARTYPE> & A,
 
         FastMatrix<SCALARTYPE> H(vcl_size_t(nn), vcl_H.internal_size2());//, V(nn);
 
-        std::vector<float>  buf(5 * vcl_size_t(nn));
+        std::vector<SCALARTYPE>  buf(5 * vcl_size_t(nn));
         //boost::numeric::ublas::vector<float>  buf(5 * nn);
         viennacl::vector<SCALARTYPE> buf_vcl(5 * vcl_size_t(nn));
 
@@ -690,40 +692,6 @@ void update_float_QR_column_gpu(matrix_base<SCALARTYPE> & A,
     }
 
 
-    template <typename SCALARTYPE>
-    bool householder_twoside(
-                        matrix_base<SCALARTYPE>& A,
-                        matrix_base<SCALARTYPE>& Q,
-                        vector_base<SCALARTYPE>& D,
-                        vcl_size_t start)
-    {
-        vcl_size_t A_size1 = static_cast<vcl_size_t>(viennacl::traits::size1(A));
-        if(start + 2 >= A_size1)
-            return false;
-
-        prepare_householder_vector(A, D, A_size1, start + 1, start, start + 1, true);
-        viennacl::linalg::house_update_A_left(A, D, start);
-        viennacl::linalg::house_update_A_right(A, D);
-        viennacl::linalg::house_update_QL(Q, D, A_size1);
-
-        return true;
-    }
-
-    template <typename SCALARTYPE>
-    void tridiagonal_reduction(matrix_base<SCALARTYPE>& A,
-                               matrix_base<SCALARTYPE>& Q)
-    {
-        vcl_size_t sz = A.size1();
-
-        viennacl::vector<SCALARTYPE> hh_vector(sz);
-
-        for(vcl_size_t i = 0; i < sz; i++)
-        {
-            householder_twoside(A, Q, hh_vector, i);
-        }
-
-    }
-
     template <typename SCALARTYPE>
     void qr_method(viennacl::matrix<SCALARTYPE> & A,
                    viennacl::matrix<SCALARTYPE> & Q,
@@ -733,43 +701,69 @@ void update_float_QR_column_gpu(matrix_base<SCALARTYPE> & A,
     {
 
         assert(A.size1() == A.size2() && bool("Input matrix must be square for QR method!"));
-    /*    if (!viennacl::is_row_major<F>::value && !is_symmetric)
-        {
-          std::cout << "qr_method for non-symmetric column-major matrices not implemented yet!" << std::endl;
-          exit(EXIT_FAILURE);
-        }
 
-        */
         vcl_size_t mat_size = A.size1();
         D.resize(A.size1());
         E.resize(A.size1());
+        if (mat_size == 0)
+          return;
 
-        viennacl::vector<SCALARTYPE> vcl_D(mat_size), vcl_E(mat_size);
-        //std::vector<SCALARTYPE> std_D(mat_size), std_E(mat_size);
-
-        Q = viennacl::identity_matrix<SCALARTYPE>(Q.size1());
+        // blocked reduction to tridiagonal (symmetric) or Hessenberg form on the host:
+        std::vector<SCALARTYPE> A_host, tau, d, e;
+        detail::reduction_matrix_to_host(A, A_host);
 
-        // reduce to tridiagonal form
-        detail::tridiagonal_reduction(A, Q);
+        if(is_symmetric)
+          detail::tridiagonal_reduction_blocked(mat_size, &A_host[0], mat_size, d, e, tau);
+        else
+          detail::hessenberg_reduction_blocked(mat_size, &A_host[0], mat_size, tau);
 
-        // pack diagonal and super-diagonal
-        viennacl::linalg::bidiag_pack(A, vcl_D, vcl_E);
-        copy(vcl_D, D);
-        copy(vcl_E, E);
+        // accumulate the Householder reflectors, which act on rows and columns 1, ..., mat_size-1:
+        std::vector<SCALARTYPE> Q_host(mat_size * mat_size);
+        Q_host[0] = SCALARTYPE(1);
+        if (mat_size > 1)
+          detail::reduction_form_q(mat_size - 1, mat_size - 1, &A_host[1], mat_size, &tau[0], &Q_host[1 + mat_size], mat_size);
 
         // find eigenvalues of symmetric tridiagonal matrix
         if(is_symmetric)
         {
-          viennacl::linalg::tql2(Q, D, E);
-
+          D = d;
+          E[0] = 0;
+          for (vcl_size_t i = 1; i < mat_size; ++i)
+            E[i] = e[i - 1];
+
+          // eigenpairs of the tridiagonal matrix by divide-and-conquer, then back-transform with Q:
+          std::vector<SCALARTYPE> eigenvalues, eigenvectors;
+          viennacl::linalg::tridiag_eig(D, E, eigenvalues, eigenvectors);
+
+          std::vector<SCALARTYPE> QZ(mat_size * mat_size);
+          detail::reduction_gemm(false, false, mat_size, mat_size, mat_size,
+                                 SCALARTYPE(1), &Q_host[0], mat_size, &eigenvectors[0], mat_size,
+                                 SCALARTYPE(0), &QZ[0], mat_size);
+          detail::reduction_host_to_matrix(QZ, Q);
+
+          D = eigenvalues;
+          std::fill(E.begin(), E.end(), SCALARTYPE(0));
         }
         else
         {
-              detail::hqr2(A, Q, D, E);
+          // the reflectors are stored below the subdiagonal, clear them:
+          for (vcl_size_t j = 0; j < mat_size; ++j)
+            for (vcl_size_t i = j + 2; i < mat_size; ++i)
+              A_host[i + j * mat_size] = 0;
+          detail::reduction_host_to_matrix(A_host, A);
+          detail::reduction_host_to_matrix(Q_host, Q);
+
+          // pack diagonal and super-diagonal
+          viennacl::vector<SCALARTYPE> vcl_D(mat_size), vcl_E(mat_size);
+          viennacl::linalg::bidiag_pack(A, vcl_D, vcl_E);
+          copy(vcl_D, D);
+          copy(vcl_E, E);
+
+          detail::hqr2(A, Q, D, E);
         }
 
 
-        boost::numeric::ublas::matrix<float> eigen_values(A.size1(), A.size1());
+        boost::numeric::ublas::matrix<SCALARTYPE> eigen_values(A.size1(), A.size1());
         eigen_values.clear();
 
         for (vcl_size_t i = 0; i < A.size1(); i++)
@@ -813,6 +807,38 @@ void qr_method_sym(viennacl::matrix<SCALARTYPE>& A,
     detail::qr_method(A, Q, D, E, true);
 }
 
+/** @brief Computes the eigenvalues of a symmetric matrix only.
+*
+*   Skips the accumulation of the orthogonal transformation, so only the reduction to tridiagonal form remains as O(n^3) work.
+*   The content of A is not modified.
+*
+*   @param A   The symmetric input matrix
+*   @param D   Eigenvalues in ascending order
+*/
+template <typename SCALARTYPE>
+void qr_method_sym(viennacl::matrix<SCALARTYPE> const & A,
+                   std::vector<SCALARTYPE>& D
+                  )
+{
+    assert(A.size1() == A.size2() && bool("Input matrix must be square for QR method!"));
+
+    vcl_size_t mat_size = A.size1();
+    D.resize(mat_size);
+    if (mat_size == 0)
+      return;
+
+    std::vector<SCALARTYPE> A_host, tau, d, e;
+    detail::reduction_matrix_to_host(A, A_host);
+    detail::tridiagonal_reduction_blocked(mat_size, &A_host[0], mat_size, d, e, tau);
+
+    // convert to the convention of tridiag_eig, where E[i] couples rows i-1 and i:
+    std::vector<SCALARTYPE> E(mat_size);
+    for (vcl_size_t i = 1; i < mat_size; ++i)
+      E[i] = e[i - 1];
+
+    D = viennacl::linalg::tridiag_eigenvalues(d, E, viennacl::linalg::tridiag_eig_tag(false));
+}
+
 }
 }
 
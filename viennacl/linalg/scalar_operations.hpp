@@ -68,8 +68,11 @@ namespace viennacl
       switch (viennacl::traits::handle(s1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(s1));
           viennacl::linalg::host_based::as(s1, s2, alpha, len_alpha, reciprocal_alpha, flip_sign_alpha);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::as(s1, s2, alpha, len_alpha, reciprocal_alpha, flip_sign_alpha);
@@ -118,10 +121,13 @@ namespace viennacl
       switch (viennacl::traits::handle(s1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(s1));
           viennacl::linalg::host_based::asbs(s1,
                                              s2, alpha, len_alpha, reciprocal_alpha, flip_sign_alpha,
                                              s3,  beta, len_beta,  reciprocal_beta,  flip_sign_beta);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::asbs(s1,
@@ -174,10 +180,13 @@ namespace viennacl
       switch (viennacl::traits::handle(s1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(s1));
           viennacl::linalg::host_based::asbs_s(s1,
                                                s2, alpha, len_alpha, reciprocal_alpha, flip_sign_alpha,
                                                s3,  beta, len_beta,  reciprocal_beta,  flip_sign_beta);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::asbs_s(s1,
@@ -215,8 +224,11 @@ namespace viennacl
       switch (viennacl::traits::handle(s1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(s1));
           viennacl::linalg::host_based::swap(s1, s2);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::swap(s1, s2);
@@ -54,8 +54,11 @@ namespace viennacl
         switch (viennacl::traits::handle(mat).get_active_handle_id())
         {
           case viennacl::MAIN_MEMORY:
+          {
+            viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(mat));
             viennacl::linalg::host_based::detail::row_info(mat, vec, info_selector);
             break;
+          }
 #ifdef VIENNACL_WITH_OPENCL
           case viennacl::OPENCL_MEMORY:
             viennacl::linalg::opencl::detail::row_info(mat, vec, info_selector);
@@ -99,8 +102,11 @@ namespace viennacl
       switch (viennacl::traits::handle(mat).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(mat));
           viennacl::linalg::host_based::prod_impl(mat, vec, result);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::prod_impl(mat, vec, result);
@@ -119,6 +125,110 @@ namespace viennacl
     }
 
 
+    namespace detail
+    {
+      /** @brief Composes the fused sparse matrix-vector product of prod_axpby() from the standard operations. Used for compute backends without a dedicated kernel. */
+      template<typename SparseMatrixType, class ScalarType>
+      ScalarType prod_axpby_composed(const SparseMatrixType & mat,
+                                     const viennacl::vector_base<ScalarType> & vec,
+                                     ScalarType alpha,
+                                     const viennacl::vector_base<ScalarType> & y,
+                                     ScalarType beta,
+                                     viennacl::vector_base<ScalarType> & result,
+                                     const viennacl::vector_base<ScalarType> * diag,
+                                     const viennacl::vector_base<ScalarType> * w)
+      {
+        viennacl::vector<ScalarType> temp(result.size(), viennacl::traits::context(result));
+        viennacl::linalg::prod_impl(mat, vec, temp);
+        if (beta != ScalarType(0))
+          viennacl::linalg::avbv(result, temp, alpha, 1, false, false, y, beta, 1, false, false);
+        else
+          viennacl::linalg::av(result, temp, alpha, 1, false, false);
+        if (diag)
+          result = viennacl::linalg::element_prod(result, *diag);
+
+        ScalarType result_dot = 0;
+        if (w)
+          viennacl::linalg::inner_prod_cpu(result, *w, result_dot);
+        return result_dot;
+      }
+    }
+
+    /** @brief Carries out a sparse matrix-vector product with a fused elementwise epilogue: result = diag .* (alpha * prod(mat, vec) + beta * y)
+    *
+    * Saves the temporary and the additional pass over the vectors required by evaluating the product and the vector update separately.
+    * The vectors 'y' and 'w' may be the result vector itself; 'y' is not read if beta is zero and 'w' yields the inner product of the new result with itself.
+    * The vectors 'vec' and 'diag' must not share memory with the result vector.
+    *
+    * @param mat    The sparse matrix
+    * @param vec    The vector multiplied with the sparse matrix
+    * @param alpha  Scaling factor for the matrix-vector product
+    * @param y      The vector added to the scaled matrix-vector product
+    * @param beta   Scaling factor for 'y'
+    * @param result The result vector
+    * @param diag   Optional diagonal scaling of the result. Not applied if NULL.
+    * @param w      Optional vector for computing inner_prod(result, w) within the same pass. Not used if NULL.
+    * @return The inner product of the result with 'w', zero if 'w' is NULL
+    */
+    template<typename SparseMatrixType, class ScalarType>
+    typename viennacl::enable_if< viennacl::is_any_sparse_matrix<SparseMatrixType>::value, ScalarType>::type
+    prod_axpby(const SparseMatrixType & mat,
+               const viennacl::vector_base<ScalarType> & vec,
+               ScalarType alpha,
+               const viennacl::vector_base<ScalarType> & y,
+               ScalarType beta,
+                     viennacl::vector_base<ScalarType> & result,
+               const viennacl::vector_base<ScalarType> * diag = NULL,
+               const viennacl::vector_base<ScalarType> * w = NULL)
+    {
+      assert( (mat.size1() == result.size()) && bool("Size check failed for compressed matrix-vector product: size1(mat) != size(result)"));
+      assert( (mat.size2() == vec.size())    && bool("Size check failed for compressed matrix-vector product: size2(mat) != size(x)"));
+      assert( (y.size() == result.size())    && bool("Size check failed for compressed matrix-vector product: size(y) != size(result)"));
+      assert( (viennacl::traits::handle(vec) != viennacl::traits::handle(result)) && bool("The vector multiplied with the sparse matrix must not be the result vector!"));
+      assert( (!diag || viennacl::traits::handle(*diag) != viennacl::traits::handle(result)) && bool("The diagonal scaling must not be the result vector!"));
+
+      switch (viennacl::traits::handle(mat).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(mat));
+          return viennacl::linalg::host_based::prod_impl(mat, vec, viennacl::linalg::host_based::detail::spmv_epilogue<ScalarType>(result, alpha, &y, beta, diag, w));
+        }
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+          return detail::prod_axpby_composed(mat, vec, alpha, y, beta, result, diag, w);
+#endif
+#ifdef VIENNACL_WITH_CUDA
+        case viennacl::CUDA_MEMORY:
+          return detail::prod_axpby_composed(mat, vec, alpha, y, beta, result, diag, w);
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+    /** @brief Carries out the sparse matrix-vector product result = alpha * prod(mat, vec) + beta * result in a single pass over the result vector
+    *
+    * @param mat    The matrix
+    * @param vec    The vector. Must not share memory with the result vector.
+    * @param result The result vector
+    * @param alpha  Scaling factor for the matrix-vector product
+    * @param beta   Scaling factor for the previous result (not read if zero)
+    */
+    template<typename SparseMatrixType, class ScalarType>
+    typename viennacl::enable_if< viennacl::is_any_sparse_matrix<SparseMatrixType>::value>::type
+    prod_impl(const SparseMatrixType & mat,
+              const viennacl::vector_base<ScalarType> & vec,
+                    viennacl::vector_base<ScalarType> & result,
+              ScalarType alpha,
+              ScalarType beta)
+    {
+      viennacl::linalg::prod_axpby(mat, vec, alpha, result, beta, result);
+    }
+
+
     // A * B
     /** @brief Carries out matrix-matrix multiplication first matrix being sparse
     *
@@ -140,8 +250,11 @@ namespace viennacl
       switch (viennacl::traits::handle(sp_mat).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(sp_mat));
           viennacl::linalg::host_based::prod_impl(sp_mat, d_mat, result);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::prod_impl(sp_mat, d_mat, result);
@@ -159,6 +272,88 @@ namespace viennacl
       }
     }
 
+    namespace detail
+    {
+      /** @brief Returns the offset of the first entry of column 'j' of a dense matrix in its memory buffer */
+      template<typename ScalarType>
+      vcl_size_t dense_column_start(const viennacl::matrix_base<ScalarType> & A, vcl_size_t j)
+      {
+        if (A.row_major())
+          return viennacl::traits::start1(A) * viennacl::traits::internal_size2(A) + viennacl::traits::start2(A) + j * viennacl::traits::stride2(A);
+        return (viennacl::traits::start2(A) + j * viennacl::traits::stride2(A)) * viennacl::traits::internal_size1(A) + viennacl::traits::start1(A);
+      }
+
+      /** @brief Returns the distance of consecutive entries of a column of a dense matrix in its memory buffer */
+      template<typename ScalarType>
+      vcl_size_t dense_column_stride(const viennacl::matrix_base<ScalarType> & A)
+      {
+        if (A.row_major())
+          return viennacl::traits::stride1(A) * viennacl::traits::internal_size2(A);
+        return viennacl::traits::stride1(A);
+      }
+
+      /** @brief Computes the product of a sparse matrix with a dense matrix by one sparse matrix-vector product per column. Used for compute backends without a dedicated kernel.
+      *
+      * The columns of both dense matrices are accessed in place as strided vectors, so no temporaries are created.
+      */
+      template<typename SparseMatrixType, class ScalarType>
+      void prod_columnwise(const SparseMatrixType & sp_mat,
+                           const viennacl::matrix_base<ScalarType> & d_mat,
+                                 viennacl::matrix_base<ScalarType> & result)
+      {
+        viennacl::backend::mem_handle & d_mat_handle = const_cast<viennacl::backend::mem_handle &>(d_mat.handle());
+        for (vcl_size_t j = 0; j < result.size2(); ++j)
+        {
+          viennacl::vector_base<ScalarType> x(d_mat_handle,    d_mat.size1(),  dense_column_start(d_mat, j),  dense_column_stride(d_mat));
+          viennacl::vector_base<ScalarType> y(result.handle(), result.size1(), dense_column_start(result, j), dense_column_stride(result));
+          viennacl::linalg::prod_impl(sp_mat, x, y);
+        }
+      }
+    }
+
+    /** @brief Carries out matrix-matrix multiplication of a sliced_ell_matrix with a dense matrix
+    *
+    * Implementation of the convenience expression result = prod(sp_mat, d_mat);
+    * The OpenCL and CUDA backends do not provide a dedicated kernel for this product, hence one sparse matrix-vector product per column of the result is carried out there.
+    *
+    * @param sp_mat   The sparse matrix
+    * @param d_mat    The dense matrix
+    * @param result   The result matrix (dense)
+    */
+    template<class ScalarType, typename IndexT>
+    void prod_impl(const viennacl::sliced_ell_matrix<ScalarType, IndexT> & sp_mat,
+                   const viennacl::matrix_base<ScalarType> & d_mat,
+                         viennacl::matrix_base<ScalarType> & result)
+    {
+      assert( (sp_mat.size1() == result.size1()) && bool("Size check failed for sliced_ell_matrix - dense matrix product: size1(sp_mat) != size1(result)"));
+      assert( (sp_mat.size2() == d_mat.size1()) && bool("Size check failed for sliced_ell_matrix - dense matrix product: size2(sp_mat) != size1(d_mat)"));
+      assert( (d_mat.size2() == result.size2()) && bool("Size check failed for sliced_ell_matrix - dense matrix product: size2(d_mat) != size2(result)"));
+
+      switch (viennacl::traits::handle(sp_mat).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(sp_mat));
+          viennacl::linalg::host_based::prod_impl(sp_mat, d_mat, result);
+          break;
+        }
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+          detail::prod_columnwise(sp_mat, d_mat, result);
+          break;
+#endif
+#ifdef VIENNACL_WITH_CUDA
+        case viennacl::CUDA_MEMORY:
+          detail::prod_columnwise(sp_mat, d_mat, result);
+          break;
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
     // A * transpose(B)
     /** @brief Carries out matrix-matrix multiplication first matrix being sparse, and the second transposed
     *
@@ -182,8 +377,11 @@ namespace viennacl
       switch (viennacl::traits::handle(sp_mat).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(sp_mat));
           viennacl::linalg::host_based::prod_impl(sp_mat, d_mat, result);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::prod_impl(sp_mat, d_mat, result);
@@ -219,8 +417,11 @@ namespace viennacl
       switch (viennacl::traits::handle(mat).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(mat));
           viennacl::linalg::host_based::inplace_solve(mat, vec, tag);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::inplace_solve(mat, vec, tag);
@@ -257,8 +458,11 @@ namespace viennacl
       switch (viennacl::traits::handle(mat.lhs()).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(mat.lhs()));
           viennacl::linalg::host_based::inplace_solve(mat, vec, tag);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::inplace_solve(mat, vec, tag);
@@ -295,8 +499,11 @@ namespace viennacl
         switch (viennacl::traits::handle(mat.lhs()).get_active_handle_id())
         {
           case viennacl::MAIN_MEMORY:
+          {
+            viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(mat.lhs()));
             viennacl::linalg::host_based::detail::block_inplace_solve(mat, block_index_array, num_blocks, mat_diagonal, vec, tag);
             break;
+          }
   #ifdef VIENNACL_WITH_OPENCL
           case viennacl::OPENCL_MEMORY:
             viennacl::linalg::opencl::detail::block_inplace_solve(mat, block_index_array, num_blocks, mat_diagonal, vec, tag);
@@ -332,43 +539,6 @@ namespace viennacl
     return matrix_expression< const M1, const M1, op_trans>(mat, mat);
   }
 
-  //free functions:
-  /** @brief Implementation of the operation 'result = v1 + A * v2', where A is a matrix
-  *
-  * @param result The vector the result is written to.
-  * @param proxy  An expression template proxy class holding v1, A, and v2.
-  */
-  template<typename SCALARTYPE, typename SparseMatrixType>
-  typename viennacl::enable_if< viennacl::is_any_sparse_matrix<SparseMatrixType>::value,
-                                viennacl::vector<SCALARTYPE> >::type
-  operator+(viennacl::vector_base<SCALARTYPE> & result,
-            const viennacl::vector_expression< const SparseMatrixType, const viennacl::vector_base<SCALARTYPE>, viennacl::op_prod> & proxy)
-  {
-    assert(proxy.lhs().size1() == result.size() && bool("Dimensions for addition of sparse matrix-vector product to vector don't match!"));
-    vector<SCALARTYPE> temp(proxy.lhs().size1());
-    viennacl::linalg::prod_impl(proxy.lhs(), proxy.rhs(), temp);
-    result += temp;
-    return result;
-  }
-
-  /** @brief Implementation of the operation 'result = v1 - A * v2', where A is a matrix
-  *
-  * @param result The vector the result is written to.
-  * @param proxy  An expression template proxy class.
-  */
-  template<typename SCALARTYPE, typename SparseMatrixType>
-  typename viennacl::enable_if< viennacl::is_any_sparse_matrix<SparseMatrixType>::value,
-                                viennacl::vector<SCALARTYPE> >::type
-  operator-(viennacl::vector_base<SCALARTYPE> & result,
-            const viennacl::vector_expression< const SparseMatrixType, const viennacl::vector_base<SCALARTYPE>, viennacl::op_prod> & proxy)
-  {
-    assert(proxy.lhs().size1() == result.size() && bool("Dimensions for addition of sparse matrix-vector product to vector don't match!"));
-    vector<SCALARTYPE> temp(proxy.lhs().size1());
-    viennacl::linalg::prod_impl(proxy.lhs(), proxy.rhs(), temp);
-    result += temp;
-    return result;
-  }
-
 } //namespace viennacl
 
 
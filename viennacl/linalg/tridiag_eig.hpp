@@ -0,0 +1,1151 @@
+#ifndef VIENNACL_LINALG_TRIDIAG_EIG_HPP_
+#define VIENNACL_LINALG_TRIDIAG_EIG_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/tridiag_eig.hpp
+    @brief Multithreaded host solvers for the symmetric tridiagonal eigenvalue problem.
+
+    Eigenvalues of an index or value range are computed by Sturm-count bisection, where disjoint index ranges are processed in parallel.
+    Large parts of the spectrum are computed with the implicit QL method instead if there are not enough threads for bisection to pay off.
+    Eigenpairs are computed by Cuppen's divide-and-conquer method with the deflation and eigenvector recomputation of Gu and Eisenstat.
+    Eigenvectors of small parts of the spectrum are computed by inverse iteration on the bisection eigenvalues instead, where clusters are processed in parallel.
+    Independent subproblems of the divide-and-conquer tree are solved in parallel, large merges are parallelized internally.
+*/
+
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <utility>
+#include <cassert>
+
+#include "viennacl/forwards.h"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+/** @brief Maximum size of the subproblems solved by the implicit QL method at the leaves of the divide-and-conquer tree. */
+#define VIENNACL_TRIDIAG_DC_LEAF_SIZE  32
+
+/** @brief Eigenvectors are computed by inverse iteration if fewer than n / VIENNACL_TRIDIAG_INVIT_FRACTION of them are requested, otherwise by divide-and-conquer. */
+#define VIENNACL_TRIDIAG_INVIT_FRACTION  4
+
+/** @brief Minimum number of secular equation roots in a merge step for which the merge is parallelized internally. */
+#define VIENNACL_OPENMP_TRIDIAG_DC_MIN_SIZE  64
+
+namespace viennacl
+{
+namespace linalg
+{
+
+/** @brief A tag for the symmetric tridiagonal eigensolver. Selects the part of the spectrum and whether eigenvectors are computed.
+*
+* Eigenvalues are always returned in ascending order. Indices refer to this ordering and start at zero.
+*/
+class tridiag_eig_tag
+{
+public:
+  /** @brief Part of the spectrum to compute */
+  enum range_type
+  {
+    all_eigenvalues = 0,  ///< The full spectrum
+    index_range,          ///< Eigenvalues with index in [first, last)
+    value_range           ///< Eigenvalues in the half-open interval [lower, upper)
+  };
+
+  /** @brief The constructor.
+  *
+  * @param compute_vectors   If true, eigenvectors are computed along with the eigenvalues
+  */
+  tridiag_eig_tag(bool compute_vectors = true)
+    : compute_vectors_(compute_vectors), range_(all_eigenvalues), first_(0), last_(0), lower_(0), upper_(0) {}
+
+  /** @brief Sets whether eigenvectors are computed */
+  void compute_eigenvectors(bool b) { compute_vectors_ = b; }
+  /** @brief Returns whether eigenvectors are computed */
+  bool compute_eigenvectors() const { return compute_vectors_; }
+
+  /** @brief Request all eigenvalues (default) */
+  void set_all() { range_ = all_eigenvalues; }
+  /** @brief Request the eigenvalues with (ascending) index in [first, last) */
+  void set_index_range(vcl_size_t first, vcl_size_t last) { range_ = index_range; first_ = first; last_ = last; }
+  /** @brief Request the eigenvalues in the interval [lower, upper) */
+  void set_value_range(double lower, double upper) { range_ = value_range; lower_ = lower; upper_ = upper; }
+
+  range_type range() const { return range_; }
+  vcl_size_t first_index() const { return first_; }
+  vcl_size_t last_index() const { return last_; }
+  double lower_value() const { return lower_; }
+  double upper_value() const { return upper_; }
+
+private:
+  bool compute_vectors_;
+  range_type range_;
+  vcl_size_t first_;
+  vcl_size_t last_;
+  double lower_;
+  double upper_;
+};
+
+
+namespace detail
+{
+  /** @brief Returns the number of eigenvalues of the tridiagonal matrix smaller than x (Sturm count).
+  *
+  * @param n        Size of the matrix
+  * @param d        Diagonal
+  * @param e2       Squared off-diagonal, e2[i] couples the entries i-1 and i, e2[0] is not used
+  * @param x        Shift
+  * @param pivmin   Smallest pivot magnitude allowed in the LDL^T factorization of T - x*I
+  */
+  template<typename NumericT>
+  vcl_size_t tridiag_sturm_count(vcl_size_t n, NumericT const * d, NumericT const * e2, NumericT x, NumericT pivmin)
+  {
+    vcl_size_t count = 0;
+    NumericT q = d[0] - x;
+    if (std::fabs(q) < pivmin)
+      q = -pivmin;
+    if (q < 0)
+      ++count;
+    for (vcl_size_t i = 1; i < n; ++i)
+    {
+      q = d[i] - x - e2[i] / q;
+      if (std::fabs(q) < pivmin)
+        q = -pivmin;
+      if (q < 0)
+        ++count;
+    }
+    return count;
+  }
+
+  /** @brief Computes the eigenvalues with index in [first, last) by bisection. Disjoint chunks of indices are processed in parallel.
+  *
+  * Each Sturm count within a chunk refines the enclosing intervals of all eigenvalues of the chunk.
+  *
+  * @param d       Diagonal (size n)
+  * @param e       Off-diagonal, e[i] couples the entries i-1 and i, e[0] is not used
+  * @param first   Index of the first eigenvalue
+  * @param last    Index past the last eigenvalue
+  * @param result  Receives the eigenvalues in ascending order (size last - first)
+  */
+  template<typename NumericT>
+  void tridiag_bisect(std::vector<NumericT> const & d, std::vector<NumericT> const & e,
+                      vcl_size_t first, vcl_size_t last,
+                      std::vector<NumericT> & result)
+  {
+    vcl_size_t n = d.size();
+    result.resize(last - first);
+    if (first >= last)
+      return;
+
+    NumericT eps = std::numeric_limits<NumericT>::epsilon();
+
+    std::vector<NumericT> e2(n);
+    NumericT e2_max = 0;
+    for (vcl_size_t i = 1; i < n; ++i)
+    {
+      e2[i] = e[i] * e[i];
+      e2_max = std::max(e2_max, e2[i]);
+    }
+    NumericT pivmin = std::numeric_limits<NumericT>::min() * std::max<NumericT>(1, e2_max);
+
+    // Gerschgorin interval:
+    NumericT gl = d[0];
+    NumericT gu = d[0];
+    for (vcl_size_t i = 0; i < n; ++i)
+    {
+      NumericT r = ((i > 0) ? std::fabs(e[i]) : NumericT(0)) + ((i + 1 < n) ? std::fabs(e[i+1]) : NumericT(0));
+      gl = std::min(gl, d[i] - r);
+      gu = std::max(gu, d[i] + r);
+    }
+    NumericT tnorm = std::max(std::fabs(gl), std::fabs(gu));
+    gl -= 2 * eps * tnorm * NumericT(n) + 2 * pivmin;
+    gu += 2 * eps * tnorm * NumericT(n) + 2 * pivmin;
+    NumericT abstol = eps * tnorm;
+
+    vcl_size_t num_values = last - first;
+    vcl_size_t num_chunks = 1;
+#ifdef VIENNACL_WITH_OPENMP
+    num_chunks = std::min(num_values, static_cast<vcl_size_t>(4 * omp_get_max_threads()));
+#endif
+    vcl_size_t chunk_size = (num_values - 1) / num_chunks + 1;
+    num_chunks = (num_values - 1) / chunk_size + 1;
+
+    NumericT const * d_ptr  = &d[0];
+    NumericT const * e2_ptr = &e2[0];
+    NumericT       * result_ptr = &result[0];
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for (long chunk = 0; chunk < static_cast<long>(num_chunks); ++chunk)
+    {
+      vcl_size_t k0 = first + vcl_size_t(chunk) * chunk_size;
+      vcl_size_t k1 = std::min(last, k0 + chunk_size);
+
+      std::vector<NumericT> lower(k1 - k0, gl);
+      std::vector<NumericT> upper(k1 - k0, gu);
+
+      for (vcl_size_t k = k1; k-- > k0; )
+      {
+        NumericT lo = lower[k - k0];
+        NumericT hi = upper[k - k0];
+        while (hi - lo > 2 * eps * std::max(std::fabs(lo), std::fabs(hi)) + abstol)
+        {
+          NumericT mid = lo + (hi - lo) / 2;
+          if (mid <= lo || mid >= hi)
+            break;
+          vcl_size_t count = tridiag_sturm_count(n, d_ptr, e2_ptr, mid, pivmin);
+
+          // eigenvalues with index smaller than 'count' are below 'mid':
+          for (vcl_size_t j = k0; j < std::min(count, k1); ++j)
+            upper[j - k0] = std::min(upper[j - k0], mid);
+          for (vcl_size_t j = std::max(count, k0); j < k1; ++j)
+            lower[j - k0] = std::max(lower[j - k0], mid);
+
+          if (count <= k)
+            lo = mid;
+          else
+            hi = mid;
+        }
+        result_ptr[k - first] = lo + (hi - lo) / 2;
+      }
+    }
+  }
+
+
+  /** @brief Implicit QL method with eigenvectors for a small tridiagonal matrix. Derived from the EISPACK routine tql2.
+  *
+  * @param n     Size of the matrix
+  * @param d     Diagonal, overwritten by the unsorted eigenvalues
+  * @param e     Off-diagonal of size n, e[i] couples the entries i and i+1. Destroyed on exit.
+  * @param Q     Column-major storage for the eigenvectors, must hold the identity on entry. Eigenvectors are not computed if NULL.
+  * @param ldq   Leading dimension of Q
+  */
+  template<typename NumericT>
+  void tridiag_ql_implicit(vcl_size_t n, NumericT * d, NumericT * e, NumericT * Q, vcl_size_t ldq)
+  {
+    NumericT eps = std::numeric_limits<NumericT>::epsilon();
+    NumericT f = 0;
+    NumericT tst1 = 0;
+    e[n - 1] = 0;
+
+    for (vcl_size_t l = 0; l < n; ++l)
+    {
+      tst1 = std::max(tst1, std::fabs(d[l]) + std::fabs(e[l]));
+      vcl_size_t m = l;
+      while (m < n - 1)
+      {
+        if (std::fabs(e[m]) <= eps * tst1)
+          break;
+        ++m;
+      }
+
+      if (m > l)
+      {
+        vcl_size_t iter = 0;
+        do
+        {
+          ++iter;
+          NumericT g = d[l];
+          NumericT p = (d[l + 1] - g) / (2 * e[l]);
+          NumericT r = std::sqrt(p * p + 1);
+          if (p < 0)
+            r = -r;
+          d[l] = e[l] / (p + r);
+          d[l + 1] = e[l] * (p + r);
+          NumericT dl1 = d[l + 1];
+          NumericT h = g - d[l];
+          for (vcl_size_t i = l + 2; i < n; ++i)
+            d[i] -= h;
+          f += h;
+
+          p = d[m];
+          NumericT c = 1, c2 = 1, c3 = 1;
+          NumericT el1 = e[l + 1];
+          NumericT s = 0, s2 = 0;
+          for (vcl_size_t i = m; i-- > l; )
+          {
+            c3 = c2;
+            c2 = c;
+            s2 = s;
+            g = c * e[i];
+            h = c * p;
+            r = std::sqrt(p * p + e[i] * e[i]);
+            e[i + 1] = s * r;
+            s = e[i] / r;
+            c = p / r;
+            p = c * d[i] - s * g;
+            d[i + 1] = h + s * (c * g + s * d[i]);
+
+            if (Q)
+            {
+              NumericT * q0 = Q + i * ldq;
+              NumericT * q1 = Q + (i + 1) * ldq;
+              for (vcl_size_t k = 0; k < n; ++k)
+              {
+                h = q1[k];
+                q1[k] = s * q0[k] + c * h;
+                q0[k] = c * q0[k] - s * h;
+              }
+            }
+          }
+          p = -s * s2 * c3 * el1 * e[l] / dl1;
+          e[l] = s * p;
+          d[l] = c * p;
+        } while (std::fabs(e[l]) > eps * tst1 && iter < 30 * n);
+      }
+      d[l] = d[l] + f;
+      e[l] = 0;
+    }
+
+    // sort eigenvalues and eigenvectors in ascending order:
+    if (!Q)
+    {
+      std::sort(d, d + n);
+      return;
+    }
+    for (vcl_size_t i = 0; i + 1 < n; ++i)
+    {
+      vcl_size_t k = i;
+      for (vcl_size_t j = i + 1; j < n; ++j)
+        if (d[j] < d[k])
+          k = j;
+      if (k != i)
+      {
+        std::swap(d[i], d[k]);
+        for (vcl_size_t j = 0; j < n; ++j)
+          std::swap(Q[i * ldq + j], Q[k * ldq + j]);
+      }
+    }
+  }
+
+
+  /** @brief Computes the i-th root of the secular equation 1/rho + sum_k z_k^2 / (d_k - lambda) = 0.
+  *
+  * The root is returned as lambda = d[origin] + tau, where origin is the pole closer to the root.
+  * This representation keeps the differences d_k - lambda accurate, which is required for orthogonal eigenvectors.
+  * Uses a rational approximation by two poles, safeguarded by bisection.
+  */
+  template<typename NumericT>
+  void tridiag_secular_root(vcl_size_t K, vcl_size_t i, NumericT const * dl, NumericT const * zl, NumericT rho,
+                            vcl_size_t & origin, NumericT & tau)
+  {
+    NumericT eps = std::numeric_limits<NumericT>::epsilon();
+    NumericT lo, hi;
+
+    if (i + 1 < K)
+    {
+      NumericT mid = (dl[i + 1] - dl[i]) / 2;
+      NumericT f = NumericT(1) / rho;
+      for (vcl_size_t k = 0; k < K; ++k)
+        f += zl[k] * zl[k] / ((dl[k] - dl[i]) - mid);
+
+      if (f >= 0)   // root in (d_i, d_i + mid]
+      {
+        origin = i;
+        lo = 0;
+        hi = mid;
+      }
+      else          // root in (d_i + mid, d_{i+1})
+      {
+        origin = i + 1;
+        lo = (dl[i] - dl[i + 1]) + mid;
+        hi = 0;
+      }
+    }
+    else
+    {
+      NumericT z_norm2 = 0;
+      for (vcl_size_t k = 0; k < K; ++k)
+        z_norm2 += zl[k] * zl[k];
+      origin = K - 1;
+      lo = 0;
+      hi = rho * z_norm2 * (1 + 4 * eps);
+    }
+
+    NumericT x = lo + (hi - lo) / 2;
+    for (vcl_size_t iter = 0; iter < 100; ++iter)
+    {
+      NumericT psi = 0, dpsi = 0, phi = 0, dphi = 0;
+      for (vcl_size_t k = 0; k <= i; ++k)
+      {
+        NumericT t = zl[k] / ((dl[k] - dl[origin]) - x);
+        psi  += zl[k] * t;
+        dpsi += t * t;
+      }
+      for (vcl_size_t k = i + 1; k < K; ++k)
+      {
+        NumericT t = zl[k] / ((dl[k] - dl[origin]) - x);
+        phi  += zl[k] * t;
+        dphi += t * t;
+      }
+      NumericT f = NumericT(1) / rho + psi + phi;
+
+      if (std::fabs(f) <= 8 * eps * NumericT(K) * (NumericT(1) / rho + std::fabs(psi) + std::fabs(phi)))
+        break;
+      if (f < 0)
+        lo = x;
+      else
+        hi = x;
+
+      // fit psi and phi by one pole each and solve the resulting quadratic for the increment y:
+      NumericT da = (dl[i] - dl[origin]) - x;
+      NumericT y;
+      if (i + 1 < K)
+      {
+        NumericT db = (dl[i + 1] - dl[origin]) - x;
+        NumericT qa = dpsi * da * da;
+        NumericT qb = dphi * db * db;
+        NumericT c  = f - dpsi * da - dphi * db;
+        NumericT a2 = c;
+        NumericT b2 = -(c * (da + db) + qa + qb);
+        NumericT c2 = c * da * db + qa * db + qb * da;
+        if (a2 == 0)
+          y = (b2 != 0) ? -c2 / b2 : (lo + hi) / 2 - x;
+        else
+        {
+          NumericT disc = std::sqrt(std::max<NumericT>(0, b2 * b2 - 4 * a2 * c2));
+          NumericT y1 = (b2 >= 0) ? (-b2 - disc) / (2 * a2) : (-b2 + disc) / (2 * a2);
+          NumericT y2 = (y1 != 0) ? c2 / (a2 * y1) : 0;
+          y = (x + y1 > lo && x + y1 < hi) ? y1 : y2;
+        }
+      }
+      else
+      {
+        NumericT qa = dpsi * da * da;
+        NumericT c  = f - dpsi * da;
+        y = (c != 0) ? da + qa / c : (lo + hi) / 2 - x;
+      }
+
+      NumericT x_new = x + y;
+      if (!(x_new > lo && x_new < hi))
+        x_new = lo + (hi - lo) / 2;
+      if (std::fabs(x_new - x) <= 2 * eps * std::fabs(x_new) || hi - lo <= 2 * eps * std::max(std::fabs(lo), std::fabs(hi)))
+      {
+        x = x_new;
+        break;
+      }
+      x = x_new;
+    }
+    tau = x;
+  }
+
+
+  /** @brief Merges two adjacent solved subproblems of the divide-and-conquer method.
+  *
+  * On entry, d holds the eigenvalues (ascending) of the two subproblems of sizes n1 and n - n1,
+  * and the diagonal blocks of the column-major block Q hold their eigenvectors. The off-diagonal blocks of Q are zero.
+  * beta is the coupling removed when splitting the problem.
+  * On exit, d and Q hold the eigenpairs of the merged problem in ascending order.
+  */
+  template<typename NumericT>
+  void tridiag_dc_merge(vcl_size_t n, vcl_size_t n1, NumericT * d, NumericT * Q, vcl_size_t ldq, NumericT beta, bool parallel)
+  {
+    NumericT eps = std::numeric_limits<NumericT>::epsilon();
+    NumericT rho = 2 * std::fabs(beta);
+    NumericT sign = (beta < 0) ? NumericT(-1) : NumericT(1);
+    NumericT inv_sqrt2 = NumericT(1) / std::sqrt(NumericT(2));
+
+    // rank-one modification vector (normalized to unit length, absorbed the factor two into rho):
+    std::vector<NumericT> z(n);
+    for (vcl_size_t j = 0; j < n1; ++j)
+      z[j] = Q[j * ldq + n1 - 1] * inv_sqrt2;
+    for (vcl_size_t j = n1; j < n; ++j)
+      z[j] = sign * Q[j * ldq + n1] * inv_sqrt2;
+
+    // merge the two sorted lists of eigenvalues:
+    std::vector<vcl_size_t> perm(n);
+    {
+      vcl_size_t i1 = 0, i2 = n1;
+      for (vcl_size_t k = 0; k < n; ++k)
+      {
+        if (i2 >= n || (i1 < n1 && d[i1] <= d[i2]))
+          perm[k] = i1++;
+        else
+          perm[k] = i2++;
+      }
+    }
+
+    // nonzero rows of the columns of Q: 1 = upper block, 2 = lower block, 3 = both
+    std::vector<unsigned char> col_type(n);
+    for (vcl_size_t j = 0; j < n; ++j)
+      col_type[j] = (j < n1) ? 1 : 2;
+
+    NumericT d_max = 0, z_max = 0;
+    for (vcl_size_t j = 0; j < n; ++j)
+    {
+      d_max = std::max(d_max, std::fabs(d[j]));
+      z_max = std::max(z_max, std::fabs(z[j]));
+    }
+    NumericT tol = 8 * eps * std::max(d_max, z_max);
+
+    //
+    // Deflation: Drop components with small z_j and combine close eigenvalues with a Givens rotation
+    //
+    std::vector<vcl_size_t> nondeflated;
+    std::vector<vcl_size_t> deflated;
+    nondeflated.reserve(n);
+    deflated.reserve(n);
+    bool have_prev = false;
+    vcl_size_t prev = 0;
+    for (vcl_size_t k = 0; k < n; ++k)
+    {
+      vcl_size_t j = perm[k];
+      if (rho * std::fabs(z[j]) <= tol)
+      {
+        deflated.push_back(j);
+        continue;
+      }
+      if (!have_prev)
+      {
+        prev = j;
+        have_prev = true;
+        continue;
+      }
+
+      NumericT tau = std::sqrt(z[prev] * z[prev] + z[j] * z[j]);
+      NumericT c = z[j] / tau;
+      NumericT s = -z[prev] / tau;
+      if (std::fabs((d[j] - d[prev]) * c * s) <= tol)
+      {
+        z[j] = tau;
+        z[prev] = 0;
+
+        unsigned char type = static_cast<unsigned char>(col_type[prev] | col_type[j]);
+        vcl_size_t row_begin = (type & 1) ? 0 : n1;
+        vcl_size_t row_end   = (type & 2) ? n : n1;
+        NumericT * q_prev = Q + prev * ldq;
+        NumericT * q_j    = Q + j * ldq;
+        for (vcl_size_t r = row_begin; r < row_end; ++r)
+        {
+          NumericT qp = q_prev[r];
+          NumericT qj = q_j[r];
+          q_prev[r] = c * qp + s * qj;
+          q_j[r]    = c * qj - s * qp;
+        }
+        col_type[prev] = col_type[j] = type;
+
+        NumericT d_prev = d[prev] * c * c + d[j] * s * s;
+        NumericT d_j    = d[prev] * s * s + d[j] * c * c;
+        d[prev] = d_prev;
+        d[j]    = d_j;
+        deflated.push_back(prev);
+      }
+      else
+        nondeflated.push_back(prev);
+      prev = j;
+    }
+    if (have_prev)
+      nondeflated.push_back(prev);
+
+    vcl_size_t K = nondeflated.size();
+
+    //
+    // Secular equation and eigenvectors of the nondeflated part
+    //
+    std::vector<NumericT> dl(K), zl(K), tau(K), zhat(K), U(K * K);
+    std::vector<vcl_size_t> origin(K);
+    for (vcl_size_t k = 0; k < K; ++k)
+    {
+      dl[k] = d[nondeflated[k]];
+      zl[k] = z[nondeflated[k]];
+    }
+
+    bool parallel_merge = parallel && (K >= VIENNACL_OPENMP_TRIDIAG_DC_MIN_SIZE);
+    (void)parallel_merge;
+
+    if (K == 1)
+    {
+      origin[0] = 0;
+      tau[0] = rho * zl[0] * zl[0];
+      U[0] = 1;
+    }
+    else if (K > 1)
+    {
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for if (parallel_merge)
+#endif
+      for (long i = 0; i < static_cast<long>(K); ++i)
+        tridiag_secular_root(K, vcl_size_t(i), &dl[0], &zl[0], rho, origin[vcl_size_t(i)], tau[vcl_size_t(i)]);
+
+      // recompute z such that the computed eigenvalues are exact for the modified problem (Gu, Eisenstat):
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for if (parallel_merge)
+#endif
+      for (long k2 = 0; k2 < static_cast<long>(K); ++k2)
+      {
+        vcl_size_t k = vcl_size_t(k2);
+        NumericT w = (dl[origin[K - 1]] - dl[k]) + tau[K - 1];
+        for (vcl_size_t j = 0; j < k; ++j)
+          w *= ((dl[origin[j]] - dl[k]) + tau[j]) / (dl[j] - dl[k]);
+        for (vcl_size_t j = k; j + 1 < K; ++j)
+          w *= ((dl[origin[j]] - dl[k]) + tau[j]) / (dl[j + 1] - dl[k]);
+        NumericT val = std::sqrt(std::fabs(w) / rho);
+        zhat[k] = (zl[k] < 0) ? -val : val;
+      }
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for if (parallel_merge)
+#endif
+      for (long i2 = 0; i2 < static_cast<long>(K); ++i2)
+      {
+        vcl_size_t i = vcl_size_t(i2);
+        NumericT * u = &U[i * K];
+        NumericT norm2 = 0;
+        for (vcl_size_t k = 0; k < K; ++k)
+        {
+          u[k] = zhat[k] / ((dl[k] - dl[origin[i]]) - tau[i]);
+          norm2 += u[k] * u[k];
+        }
+        NumericT inv_norm = NumericT(1) / std::sqrt(norm2);
+        for (vcl_size_t k = 0; k < K; ++k)
+          u[k] *= inv_norm;
+      }
+    }
+
+    //
+    // Sort all eigenvalues and assemble the eigenvectors in ascending order
+    //
+    std::vector<std::pair<NumericT, vcl_size_t> > order(n);
+    for (vcl_size_t i = 0; i < K; ++i)
+      order[i] = std::make_pair(dl[origin[i]] + tau[i], i);
+    for (vcl_size_t i = 0; i < deflated.size(); ++i)
+      order[K + i] = std::make_pair(d[deflated[i]], K + i);
+    std::sort(order.begin(), order.end());
+
+    std::vector<vcl_size_t> position(n);
+    for (vcl_size_t i = 0; i < n; ++i)
+      position[order[i].second] = i;
+
+    std::vector<NumericT> Q_new(n * n);
+
+    // eigenvectors of the nondeflated part: Q_new(:, position[i]) = Q(:, nondeflated) * U(:, i).
+    // Blocked over 32 output columns and 256 rows such that each segment of Q is reused from cache.
+    long num_blocks = static_cast<long>((K + 31) / 32);
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (parallel_merge)
+#endif
+    for (long b = 0; b < num_blocks; ++b)
+    {
+      vcl_size_t i_begin = vcl_size_t(b) * 32;
+      vcl_size_t i_end   = std::min<vcl_size_t>(K, i_begin + 32);
+
+      for (vcl_size_t chunk_begin = 0; chunk_begin < n; chunk_begin += 256)
+      {
+        vcl_size_t chunk_end = std::min<vcl_size_t>(n, chunk_begin + 256);
+        for (vcl_size_t k = 0; k < K; ++k)
+        {
+          vcl_size_t col = nondeflated[k];
+          vcl_size_t row_begin = std::max(chunk_begin, (col_type[col] & 1) ? vcl_size_t(0) : n1);
+          vcl_size_t row_end   = std::min(chunk_end,   (col_type[col] & 2) ? n : n1);
+          if (row_begin >= row_end)
+            continue;
+          NumericT const * q = Q + col * ldq;
+
+          vcl_size_t i = i_begin;
+          for (; i + 4 <= i_end; i += 4)
+          {
+            NumericT u0 = U[i * K + k], u1 = U[(i+1) * K + k], u2 = U[(i+2) * K + k], u3 = U[(i+3) * K + k];
+            NumericT * o0 = &Q_new[position[i] * n];
+            NumericT * o1 = &Q_new[position[i+1] * n];
+            NumericT * o2 = &Q_new[position[i+2] * n];
+            NumericT * o3 = &Q_new[position[i+3] * n];
+            for (vcl_size_t r = row_begin; r < row_end; ++r)
+            {
+              NumericT qr = q[r];
+              o0[r] += u0 * qr;
+              o1[r] += u1 * qr;
+              o2[r] += u2 * qr;
+              o3[r] += u3 * qr;
+            }
+          }
+          for (; i < i_end; ++i)
+          {
+            NumericT ui = U[i * K + k];
+            NumericT * oi = &Q_new[position[i] * n];
+            for (vcl_size_t r = row_begin; r < row_end; ++r)
+              oi[r] += ui * q[r];
+          }
+        }
+      }
+    }
+
+    for (vcl_size_t i = 0; i < deflated.size(); ++i)
+    {
+      NumericT const * q = Q + deflated[i] * ldq;
+      NumericT * out = &Q_new[position[K + i] * n];
+      for (vcl_size_t r = 0; r < n; ++r)
+        out[r] = q[r];
+    }
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (parallel_merge)
+#endif
+    for (long j = 0; j < static_cast<long>(n); ++j)
+    {
+      NumericT const * src = &Q_new[vcl_size_t(j) * n];
+      NumericT * dest = Q + vcl_size_t(j) * ldq;
+      for (vcl_size_t r = 0; r < n; ++r)
+        dest[r] = src[r];
+    }
+
+    for (vcl_size_t i = 0; i < n; ++i)
+      d[i] = order[i].first;
+  }
+
+
+  /** @brief Node of the divide-and-conquer tree: the subproblem [offset, offset + size), split after 'split' rows (zero for leaves) */
+  struct tridiag_dc_node
+  {
+    vcl_size_t offset;
+    vcl_size_t size;
+    vcl_size_t split;
+  };
+
+  template<typename NumericT>
+  void tridiag_dc_build_tree(vcl_size_t offset, vcl_size_t size, vcl_size_t depth,
+                             NumericT * d, NumericT const * e,
+                             std::vector<std::vector<tridiag_dc_node> > & levels)
+  {
+    if (levels.size() <= depth)
+      levels.resize(depth + 1);
+
+    tridiag_dc_node node;
+    node.offset = offset;
+    node.size   = size;
+    node.split  = 0;
+    if (size > VIENNACL_TRIDIAG_DC_LEAF_SIZE)
+    {
+      node.split = size / 2;
+      // remove the coupling as a rank-one modification:
+      NumericT rho = std::fabs(e[offset + node.split - 1]);
+      d[offset + node.split - 1] -= rho;
+      d[offset + node.split]     -= rho;
+      tridiag_dc_build_tree(offset, node.split, depth + 1, d, e, levels);
+      tridiag_dc_build_tree(offset + node.split, size - node.split, depth + 1, d, e, levels);
+    }
+    levels[depth].push_back(node);
+  }
+
+  template<typename NumericT>
+  void tridiag_dc_solve_node(tridiag_dc_node const & node, NumericT * d, NumericT const * e, NumericT * Q, vcl_size_t ldq, bool parallel)
+  {
+    NumericT * Q_block = Q + node.offset * ldq + node.offset;
+    if (node.split == 0)
+    {
+      std::vector<NumericT> e_local(node.size);
+      for (vcl_size_t i = 0; i + 1 < node.size; ++i)
+        e_local[i] = e[node.offset + i];
+      for (vcl_size_t i = 0; i < node.size; ++i)
+        Q_block[i * ldq + i] = 1;
+      tridiag_ql_implicit(node.size, d + node.offset, &e_local[0], Q_block, ldq);
+    }
+    else
+      tridiag_dc_merge(node.size, node.split, d + node.offset, Q_block, ldq, e[node.offset + node.split - 1], parallel);
+  }
+
+  /** @brief Divide-and-conquer method for all eigenpairs of a symmetric tridiagonal matrix.
+  *
+  * @param d   Diagonal, overwritten by the eigenvalues in ascending order
+  * @param e   Off-diagonal of size n, e[i] couples the entries i and i+1
+  * @param Q   Receives the eigenvectors as a column-major n x n matrix
+  */
+  template<typename NumericT>
+  void tridiag_dc(std::vector<NumericT> & d, std::vector<NumericT> const & e, std::vector<NumericT> & Q)
+  {
+    vcl_size_t n = d.size();
+    Q.assign(n * n, NumericT(0));
+
+    std::vector<std::vector<tridiag_dc_node> > levels;
+    tridiag_dc_build_tree(0, n, 0, &d[0], &e[0], levels);
+
+    vcl_size_t num_threads = 1;
+#ifdef VIENNACL_WITH_OPENMP
+    num_threads = static_cast<vcl_size_t>(omp_get_max_threads());
+#endif
+
+    // process the tree bottom-up. Independent nodes are processed in parallel as long as there are enough of them:
+    for (vcl_size_t level = levels.size(); level-- > 0; )
+    {
+      std::vector<tridiag_dc_node> const & nodes = levels[level];
+      bool parallel_nodes = (nodes.size() >= num_threads) && (nodes.size() > 1);
+      (void)parallel_nodes;
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for schedule(dynamic) if (parallel_nodes)
+#endif
+      for (long i = 0; i < static_cast<long>(nodes.size()); ++i)
+        tridiag_dc_solve_node(nodes[vcl_size_t(i)], &d[0], &e[0], &Q[0], n, !parallel_nodes);
+    }
+  }
+
+
+  /** @brief LU factorization with partial pivoting of T - shift * I for a symmetric tridiagonal matrix T. Derived from the LAPACK routine dlagtf.
+  *
+  * @param n       Size of the matrix
+  * @param d       Diagonal
+  * @param e       Off-diagonal, e[i] couples the entries i and i+1
+  * @param shift   The shift
+  * @param u1      Receives the diagonal of U
+  * @param u2      Receives the first superdiagonal of U
+  * @param u3      Receives the second superdiagonal of U (only nonzero after row interchanges)
+  * @param l       Receives the multipliers of L
+  * @param pivot   Receives whether rows k and k+1 were interchanged in step k
+  */
+  template<typename NumericT>
+  void tridiag_shifted_lu(vcl_size_t n, NumericT const * d, NumericT const * e, NumericT shift,
+                          NumericT * u1, NumericT * u2, NumericT * u3, NumericT * l, char * pivot)
+  {
+    NumericT diag  = d[0] - shift;
+    NumericT super = (n > 1) ? e[0] : NumericT(0);
+    for (vcl_size_t k = 0; k + 1 < n; ++k)
+    {
+      NumericT sub        = e[k];
+      NumericT next_diag  = d[k+1] - shift;
+      NumericT next_super = (k + 2 < n) ? e[k+1] : NumericT(0);
+      if (std::fabs(diag) >= std::fabs(sub))
+      {
+        pivot[k] = 0;
+        l[k]  = (diag != 0) ? sub / diag : NumericT(0);
+        u1[k] = diag;
+        u2[k] = super;
+        u3[k] = 0;
+        diag  = next_diag - l[k] * super;
+        super = next_super;
+      }
+      else
+      {
+        pivot[k] = 1;
+        l[k]  = diag / sub;
+        u1[k] = sub;
+        u2[k] = next_diag;
+        u3[k] = next_super;
+        diag  = super - l[k] * next_diag;
+        super = -l[k] * next_super;
+      }
+    }
+    u1[n-1] = diag;
+  }
+
+  /** @brief Solves (T - shift * I) x = b in place with the factorization from tridiag_shifted_lu(). Pivots smaller than 'tol' are perturbed to 'tol'. Derived from the LAPACK routine dlagts.
+  *
+  * The solution is rescaled if it approaches overflow, hence only its direction is meaningful.
+  */
+  template<typename NumericT>
+  void tridiag_shifted_lu_solve(vcl_size_t n, NumericT const * u1, NumericT const * u2, NumericT const * u3, NumericT const * l, char const * pivot,
+                                NumericT tol, NumericT * x)
+  {
+    NumericT bignum = std::sqrt((std::numeric_limits<NumericT>::max)());
+
+    for (vcl_size_t k = 0; k + 1 < n; ++k)
+    {
+      if (pivot[k])
+        std::swap(x[k], x[k+1]);
+      x[k+1] -= l[k] * x[k];
+    }
+
+    for (vcl_size_t k = n; k-- > 0; )
+    {
+      NumericT s = x[k];
+      if (k + 1 < n) s -= u2[k] * x[k+1];
+      if (k + 2 < n) s -= u3[k] * x[k+2];
+      NumericT p = u1[k];
+      if (std::fabs(p) < tol)
+        p = (p < 0) ? -tol : tol;
+      x[k] = s / p;
+
+      if (std::fabs(x[k]) > bignum)
+      {
+        NumericT scl = 1 / std::fabs(x[k]);
+        for (vcl_size_t i = 0; i < n; ++i)
+          x[i] *= scl;
+      }
+    }
+  }
+
+  /** @brief Fills x with deterministic pseudo-random numbers in [-1, 1] derived from 'seed' */
+  template<typename NumericT>
+  void tridiag_random_vector(std::vector<NumericT> & x, unsigned long seed)
+  {
+    for (vcl_size_t i = 0; i < x.size(); ++i)
+    {
+      seed = (seed * 1103515245UL + 12345UL) & 0x7fffffffUL;
+      x[i] = NumericT(2) * NumericT(seed >> 8) / NumericT(0x7fffff) - NumericT(1);
+    }
+  }
+
+  /** @brief Computes the eigenvectors of a symmetric tridiagonal matrix for the given eigenvalues by inverse iteration. Derived from the LAPACK routine dstein.
+  *
+  * Consecutive eigenvalues closer than 1e-3 times the norm of the matrix form a cluster, whose eigenvectors are reorthogonalized against each other.
+  * Clusters are processed in parallel.
+  *
+  * @param d   Diagonal (size n)
+  * @param e   Off-diagonal of size n, e[i] couples the entries i and i+1
+  * @param w   Eigenvalues in ascending order
+  * @param Z   Receives the eigenvectors as a column-major n x m matrix (m eigenvalues)
+  */
+  template<typename NumericT>
+  void tridiag_inverse_iteration(std::vector<NumericT> const & d, std::vector<NumericT> const & e,
+                                 std::vector<NumericT> const & w, std::vector<NumericT> & Z)
+  {
+    vcl_size_t n = d.size();
+    vcl_size_t m = w.size();
+    Z.assign(n * m, NumericT(0));
+    if (m == 0)
+      return;
+
+    NumericT eps = std::numeric_limits<NumericT>::epsilon();
+    NumericT onenrm = 0;
+    for (vcl_size_t i = 0; i < n; ++i)
+      onenrm = std::max(onenrm, std::fabs(d[i]) + ((i > 0) ? std::fabs(e[i-1]) : NumericT(0)) + ((i + 1 < n) ? std::fabs(e[i]) : NumericT(0)));
+    if (onenrm <= 0)
+      onenrm = 1;
+    NumericT ortol  = NumericT(1e-3) * onenrm;
+    NumericT dtpcrt = std::sqrt(NumericT(0.1) / NumericT(n));
+    NumericT tol    = eps * onenrm;
+
+    std::vector<vcl_size_t> cluster_start(1, 0);
+    for (vcl_size_t j = 1; j < m; ++j)
+      if (w[j] - w[j-1] > ortol)
+        cluster_start.push_back(j);
+    cluster_start.push_back(m);
+
+    NumericT const * d_ptr = &d[0];
+    NumericT const * e_ptr = &e[0];
+    NumericT       * Z_ptr = &Z[0];
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for (long c = 0; c < static_cast<long>(cluster_start.size()) - 1; ++c)
+    {
+      vcl_size_t j0 = cluster_start[vcl_size_t(c)];
+      vcl_size_t j1 = cluster_start[vcl_size_t(c) + 1];
+
+      std::vector<NumericT> u1(n), u2(n), u3(n), l(n), x(n);
+      std::vector<char> pivot(n);
+      NumericT xjm = 0;
+      for (vcl_size_t j = j0; j < j1; ++j)
+      {
+        // separate (numerically) equal eigenvalues within a cluster:
+        NumericT xj = w[j];
+        if (j > j0 && xj - xjm < 10 * std::fabs(eps * xj))
+          xj = xjm + 10 * std::fabs(eps * xj);
+        xjm = xj;
+
+        tridiag_shifted_lu(n, d_ptr, e_ptr, xj, &u1[0], &u2[0], &u3[0], &l[0], &pivot[0]);
+        tridiag_random_vector(x, 4711UL + j);
+
+        // iterate until the solution has grown sufficiently, plus two extra steps:
+        vcl_size_t num_converged = 0;
+        for (vcl_size_t iter = 0; iter < 5 && num_converged < 3; ++iter)
+        {
+          NumericT asum = 0;
+          for (vcl_size_t i = 0; i < n; ++i)
+            asum += std::fabs(x[i]);
+          if (asum <= 0)
+          {
+            tridiag_random_vector(x, 4711UL + j + 1000003UL * (iter + 1));
+            continue;
+          }
+          NumericT scl = NumericT(n) * onenrm * std::max(eps, std::fabs(u1[n-1])) / asum;
+          for (vcl_size_t i = 0; i < n; ++i)
+            x[i] *= scl;
+
+          tridiag_shifted_lu_solve(n, &u1[0], &u2[0], &u3[0], &l[0], &pivot[0], tol, &x[0]);
+
+          for (vcl_size_t k = j0; k < j; ++k)
+          {
+            NumericT const * z = Z_ptr + k * n;
+            NumericT dot = 0;
+            for (vcl_size_t i = 0; i < n; ++i)
+              dot += x[i] * z[i];
+            for (vcl_size_t i = 0; i < n; ++i)
+              x[i] -= dot * z[i];
+          }
+
+          NumericT nrm = 0;
+          for (vcl_size_t i = 0; i < n; ++i)
+            nrm = std::max(nrm, std::fabs(x[i]));
+          if (nrm >= dtpcrt)
+            ++num_converged;
+        }
+
+        // normalize such that the entry of largest magnitude is positive:
+        NumericT nrm2 = 0;
+        NumericT x_max = 0;
+        for (vcl_size_t i = 0; i < n; ++i)
+        {
+          nrm2 += x[i] * x[i];
+          if (std::fabs(x[i]) > std::fabs(x_max))
+            x_max = x[i];
+        }
+        NumericT scl = (nrm2 > 0) ? NumericT(1) / std::sqrt(nrm2) : NumericT(0);
+        if (x_max < 0)
+          scl = -scl;
+        NumericT * z = Z_ptr + j * n;
+        for (vcl_size_t i = 0; i < n; ++i)
+          z[i] = x[i] * scl;
+      }
+    }
+  }
+
+} //namespace detail
+
+
+/** @brief Computes eigenvalues and optionally eigenvectors of a symmetric tridiagonal matrix on the host.
+*
+* Eigenvalues only are obtained by parallel bisection (or the QL method for large parts of the spectrum), eigenpairs by the parallel divide-and-conquer method.
+* If eigenvectors are requested for less than n / VIENNACL_TRIDIAG_INVIT_FRACTION eigenvalues, they are computed by inverse iteration on the bisection eigenvalues.
+* For larger subsets the full eigendecomposition is computed and the requested part is extracted.
+*
+* @param diagonal        The diagonal of the matrix (size n)
+* @param superdiagonal   The off-diagonal (size n), superdiagonal[i] couples the entries i-1 and i. superdiagonal[0] is not used.
+* @param eigenvalues     Receives the requested eigenvalues in ascending order
+* @param eigenvectors    Receives the corresponding eigenvectors as a column-major n x m matrix (m eigenvalues). Not touched if no eigenvectors are requested.
+* @param tag             Solver options, cf. tridiag_eig_tag
+*/
+template<typename NumericT>
+void tridiag_eig(std::vector<NumericT> const & diagonal,
+                 std::vector<NumericT> const & superdiagonal,
+                 std::vector<NumericT> & eigenvalues,
+                 std::vector<NumericT> & eigenvectors,
+                 tridiag_eig_tag const & tag = tridiag_eig_tag())
+{
+  vcl_size_t n = diagonal.size();
+  assert(superdiagonal.size() >= n && bool("Size of superdiagonal does not match the size of the diagonal!"));
+
+  eigenvalues.clear();
+  if (n == 0)
+    return;
+
+  vcl_size_t first = 0;
+  vcl_size_t last  = n;
+  if (tag.range() == tridiag_eig_tag::index_range)
+  {
+    first = std::min(tag.first_index(), n);
+    last  = std::max(first, std::min(tag.last_index(), n));
+  }
+  else if (tag.range() == tridiag_eig_tag::value_range)
+  {
+    std::vector<NumericT> e2(n);
+    NumericT e2_max = 0;
+    for (vcl_size_t i = 1; i < n; ++i)
+    {
+      e2[i] = superdiagonal[i] * superdiagonal[i];
+      e2_max = std::max(e2_max, e2[i]);
+    }
+    NumericT pivmin = std::numeric_limits<NumericT>::min() * std::max<NumericT>(1, e2_max);
+    first = detail::tridiag_sturm_count(n, &diagonal[0], &e2[0], static_cast<NumericT>(tag.lower_value()), pivmin);
+    last  = detail::tridiag_sturm_count(n, &diagonal[0], &e2[0], static_cast<NumericT>(tag.upper_value()), pivmin);
+    last  = std::max(first, last);
+  }
+
+  if (!tag.compute_eigenvectors())
+  {
+    vcl_size_t num_threads = 1;
+#ifdef VIENNACL_WITH_OPENMP
+    num_threads = static_cast<vcl_size_t>(omp_get_max_threads());
+#endif
+    std::vector<NumericT> d(diagonal.begin(), diagonal.begin() + static_cast<long>(n));
+    std::vector<NumericT> e(superdiagonal.begin(), superdiagonal.begin() + static_cast<long>(n));
+
+    // one bisection costs about 1/20 of the serial QL method for the full spectrum:
+    if (20 * (last - first) < n * num_threads)
+      detail::tridiag_bisect(d, e, first, last, eigenvalues);
+    else
+    {
+      for (vcl_size_t i = 0; i + 1 < n; ++i)
+        e[i] = e[i + 1];
+      detail::tridiag_ql_implicit(n, &d[0], &e[0], static_cast<NumericT *>(NULL), 0);
+      eigenvalues.assign(d.begin() + static_cast<long>(first), d.begin() + static_cast<long>(last));
+    }
+    return;
+  }
+
+  // scale to unit norm in order to make the deflation tolerances of the divide-and-conquer method independent of the scaling:
+  NumericT scale = 0;
+  for (vcl_size_t i = 0; i < n; ++i)
+  {
+    scale = std::max(scale, std::fabs(diagonal[i]));
+    if (i > 0)
+      scale = std::max(scale, std::fabs(superdiagonal[i]));
+  }
+  if (scale <= 0)
+    scale = 1;
+
+  std::vector<NumericT> d(n), e(n);
+  for (vcl_size_t i = 0; i < n; ++i)
+  {
+    d[i] = diagonal[i] / scale;
+    e[i] = (i + 1 < n) ? superdiagonal[i + 1] / scale : NumericT(0);
+  }
+
+  if (VIENNACL_TRIDIAG_INVIT_FRACTION * (last - first) < n)
+  {
+    detail::tridiag_bisect(diagonal, superdiagonal, first, last, eigenvalues);
+
+    std::vector<NumericT> w(last - first);
+    for (vcl_size_t i = 0; i < w.size(); ++i)
+      w[i] = eigenvalues[i] / scale;
+    detail::tridiag_inverse_iteration(d, e, w, eigenvectors);
+    return;
+  }
+
+  std::vector<NumericT> Q;
+  detail::tridiag_dc(d, e, Q);
+
+  eigenvalues.resize(last - first);
+  for (vcl_size_t i = first; i < last; ++i)
+    eigenvalues[i - first] = d[i] * scale;
+
+  if (first == 0 && last == n)
+    eigenvectors.swap(Q);
+  else
+  {
+    eigenvectors.resize(n * (last - first));
+    std::copy(Q.begin() + static_cast<long>(first * n), Q.begin() + static_cast<long>(last * n), eigenvectors.begin());
+  }
+}
+
+/** @brief Computes the eigenvalues of a symmetric tridiagonal matrix on the host. Eigenvectors are not computed.
+*
+* @param diagonal        The diagonal of the matrix (size n)
+* @param superdiagonal   The off-diagonal (size n), superdiagonal[i] couples the entries i-1 and i. superdiagonal[0] is not used.
+* @param tag             Selects the part of the spectrum, cf. tridiag_eig_tag
+* @return                The requested eigenvalues in ascending order
+*/
+template<typename NumericT>
+std::vector<NumericT> tridiag_eigenvalues(std::vector<NumericT> const & diagonal,
+                                          std::vector<NumericT> const & superdiagonal,
+                                          tridiag_eig_tag const & tag = tridiag_eig_tag(false))
+{
+  tridiag_eig_tag values_tag(tag);
+  values_tag.compute_eigenvectors(false);
+
+  std::vector<NumericT> eigenvalues;
+  std::vector<NumericT> no_eigenvectors;
+  tridiag_eig(diagonal, superdiagonal, eigenvalues, no_eigenvectors, values_tag);
+  return eigenvalues;
+}
+
+} // end namespace linalg
+} // end namespace viennacl
+#endif
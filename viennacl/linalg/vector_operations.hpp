@@ -22,6 +22,9 @@
     @brief Implementations of vector operations.
 */
 
+#include <vector>
+#include <algorithm>
+
 #include "viennacl/forwards.h"
 #include "viennacl/range.hpp"
 #include "viennacl/scalar.hpp"
@@ -32,6 +35,7 @@
 #include "viennacl/traits/start.hpp"
 #include "viennacl/traits/handle.hpp"
 #include "viennacl/traits/stride.hpp"
+#include "viennacl/backend/memory.hpp"
 #include "viennacl/linalg/host_based/vector_operations.hpp"
 
 #ifdef VIENNACL_WITH_OPENCL
@@ -55,8 +59,11 @@ namespace viennacl
       switch (viennacl::traits::handle(vec1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(vec1));
           viennacl::linalg::host_based::av(vec1, vec2, alpha, len_alpha, reciprocal_alpha, flip_sign_alpha);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::av(vec1, vec2, alpha, len_alpha, reciprocal_alpha, flip_sign_alpha);
@@ -86,10 +93,13 @@ namespace viennacl
       switch (viennacl::traits::handle(vec1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(vec1));
           viennacl::linalg::host_based::avbv(vec1,
                                                   vec2, alpha, len_alpha, reciprocal_alpha, flip_sign_alpha,
                                                   vec3,  beta, len_beta,  reciprocal_beta,  flip_sign_beta);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::avbv(vec1,
@@ -123,10 +133,13 @@ namespace viennacl
       switch (viennacl::traits::handle(vec1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(vec1));
           viennacl::linalg::host_based::avbv_v(vec1,
                                                     vec2, alpha, len_alpha, reciprocal_alpha, flip_sign_alpha,
                                                     vec3,  beta, len_beta,  reciprocal_beta,  flip_sign_beta);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::avbv_v(vec1,
@@ -161,8 +174,11 @@ namespace viennacl
       switch (viennacl::traits::handle(vec1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(vec1));
           viennacl::linalg::host_based::vector_assign(vec1, alpha, up_to_internal_size);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::vector_assign(vec1, alpha, up_to_internal_size);
@@ -194,8 +210,11 @@ namespace viennacl
       switch (viennacl::traits::handle(vec1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(vec1));
           viennacl::linalg::host_based::vector_swap(vec1, vec2);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::vector_swap(vec1, vec2);
@@ -232,8 +251,11 @@ namespace viennacl
       switch (viennacl::traits::handle(vec1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(vec1));
           viennacl::linalg::host_based::element_op(vec1, proxy);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::element_op(vec1, proxy);
@@ -365,8 +387,11 @@ namespace viennacl
       switch (viennacl::traits::handle(vec1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(vec1));
           viennacl::linalg::host_based::inner_prod_impl(vec1, vec2, result);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::inner_prod_impl(vec1, vec2, result);
@@ -437,8 +462,11 @@ namespace viennacl
       switch (viennacl::traits::handle(vec1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(vec1));
           viennacl::linalg::host_based::inner_prod_impl(vec1, vec2, result);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::inner_prod_cpu(vec1, vec2, result);
@@ -509,8 +537,11 @@ namespace viennacl
       switch (viennacl::traits::handle(x).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(x));
           viennacl::linalg::host_based::inner_prod_impl(x, y_tuple, result);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::inner_prod_impl(x, y_tuple, result);
@@ -541,8 +572,11 @@ namespace viennacl
       switch (viennacl::traits::handle(vec).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(vec));
           viennacl::linalg::host_based::norm_1_impl(vec, result);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::norm_1_impl(vec, result);
@@ -588,8 +622,11 @@ namespace viennacl
       switch (viennacl::traits::handle(vec).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(vec));
           viennacl::linalg::host_based::norm_1_impl(vec, result);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::norm_1_cpu(vec, result);
@@ -635,8 +672,11 @@ namespace viennacl
       switch (viennacl::traits::handle(vec).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(vec));
           viennacl::linalg::host_based::norm_2_impl(vec, result);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::norm_2_impl(vec, result);
@@ -680,8 +720,11 @@ namespace viennacl
       switch (viennacl::traits::handle(vec).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(vec));
           viennacl::linalg::host_based::norm_2_impl(vec, result);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::norm_2_cpu(vec, result);
@@ -727,8 +770,11 @@ namespace viennacl
       switch (viennacl::traits::handle(vec).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(vec));
           viennacl::linalg::host_based::norm_inf_impl(vec, result);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::norm_inf_impl(vec, result);
@@ -772,8 +818,11 @@ namespace viennacl
       switch (viennacl::traits::handle(vec).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(vec));
           viennacl::linalg::host_based::norm_inf_impl(vec, result);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::norm_inf_cpu(vec, result);
@@ -819,7 +868,10 @@ namespace viennacl
       switch (viennacl::traits::handle(vec).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(vec));
           return viennacl::linalg::host_based::index_norm_inf(vec);
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           return viennacl::linalg::opencl::index_norm_inf(vec);
@@ -858,8 +910,11 @@ namespace viennacl
       switch (viennacl::traits::handle(vec).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(vec));
           viennacl::linalg::host_based::max_impl(vec, result);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::max_impl(vec, result);
@@ -901,8 +956,11 @@ namespace viennacl
       switch (viennacl::traits::handle(vec).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(vec));
           viennacl::linalg::host_based::max_impl(vec, result);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::max_cpu(vec, result);
@@ -944,8 +1002,11 @@ namespace viennacl
       switch (viennacl::traits::handle(vec).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(vec));
           viennacl::linalg::host_based::min_impl(vec, result);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::min_impl(vec, result);
@@ -987,8 +1048,11 @@ namespace viennacl
       switch (viennacl::traits::handle(vec).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(vec));
           viennacl::linalg::host_based::min_impl(vec, result);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::min_cpu(vec, result);
@@ -1037,8 +1101,11 @@ namespace viennacl
       switch (viennacl::traits::handle(vec1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(vec1));
           viennacl::linalg::host_based::plane_rotation(vec1, vec2, alpha, beta);
           break;
+        }
 #ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::plane_rotation(vec1, vec2, alpha, beta);
@@ -1056,6 +1123,160 @@ namespace viennacl
       }
     }
 
+    namespace detail
+    {
+      /** @brief Determines the smallest and the largest index of a nonempty index array */
+      template<typename IndexT>
+      void index_bounds(std::vector<IndexT> const & indices, vcl_size_t & min_index, vcl_size_t & max_index)
+      {
+        min_index = static_cast<vcl_size_t>(indices[0]);
+        max_index = static_cast<vcl_size_t>(indices[0]);
+        for (vcl_size_t i=1; i<indices.size(); ++i)
+        {
+          min_index = std::min(min_index, static_cast<vcl_size_t>(indices[i]));
+          max_index = std::max(max_index, static_cast<vcl_size_t>(indices[i]));
+        }
+      }
+
+      /** @brief Reads the entries min_index, ..., max_index of a vector (including the entries in between for slices) to the host */
+      template<typename NumericT>
+      void read_index_range(vector_base<NumericT> const & vec, vcl_size_t min_index, vcl_size_t max_index, std::vector<NumericT> & buffer)
+      {
+        vcl_size_t first = viennacl::traits::start(vec) + min_index * viennacl::traits::stride(vec);
+        buffer.resize((max_index - min_index) * viennacl::traits::stride(vec) + 1);
+        viennacl::backend::memory_read(viennacl::traits::handle(vec), sizeof(NumericT) * first, sizeof(NumericT) * buffer.size(), &(buffer[0]));
+      }
+
+      /** @brief Writes the entries min_index, ..., max_index of a vector as obtained from read_index_range() back */
+      template<typename NumericT>
+      void write_index_range(vector_base<NumericT> & vec, vcl_size_t min_index, std::vector<NumericT> const & buffer)
+      {
+        vcl_size_t first = viennacl::traits::start(vec) + min_index * viennacl::traits::stride(vec);
+        viennacl::backend::memory_write(viennacl::traits::handle(vec), sizeof(NumericT) * first, sizeof(NumericT) * buffer.size(), &(buffer[0]));
+      }
+    }
+
+    /** @brief Reads the entries vec[indices[i]] of a vector into values[i] in a single operation. Replaces repeated (slow) element access via vec[j].
+    *
+    * For vectors in OpenCL or CUDA memory, the range of entries spanned by the indices is transferred to the host in one piece.
+    * The transfer covers all entries from the smallest to the largest index (including the gaps of a slice), independent of the number of indices.
+    * Thus, for a few indices spread over a long vector, the cost is that of reading the whole vector.
+    *
+    * @param vec      The vector (or -range, or -slice)
+    * @param indices  The indices of the entries to read
+    * @param values   The entries, resized to the number of indices
+    */
+    template<typename NumericT, typename IndexT>
+    void gather(vector_base<NumericT> const & vec, std::vector<IndexT> const & indices, std::vector<NumericT> & values)
+    {
+      values.resize(indices.size());
+      if (indices.empty())
+        return;
+
+      switch (viennacl::traits::handle(vec).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(vec));
+          viennacl::linalg::host_based::gather(vec, &(indices[0]), indices.size(), &(values[0]));
+          break;
+        }
+#if defined(VIENNACL_WITH_OPENCL) || defined(VIENNACL_WITH_CUDA)
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+#endif
+#ifdef VIENNACL_WITH_CUDA
+        case viennacl::CUDA_MEMORY:
+#endif
+        {
+          vcl_size_t min_index, max_index;
+          detail::index_bounds(indices, min_index, max_index);
+          assert(max_index < vec.size() && bool("Index out of bounds in gather()"));
+
+          std::vector<NumericT> buffer;
+          detail::read_index_range(vec, min_index, max_index, buffer);
+          viennacl::linalg::host_based::detail::gather_impl(&(buffer[0]), 0, viennacl::traits::stride(vec),
+                                                            &(indices[0]), indices.size(), min_index, max_index + 1, &(values[0]));
+          break;
+        }
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+    /** @brief Returns the entries vec[indices[i]] of a vector, cf. gather(vec, indices, values) */
+    template<typename NumericT, typename IndexT>
+    std::vector<NumericT> gather(vector_base<NumericT> const & vec, std::vector<IndexT> const & indices)
+    {
+      std::vector<NumericT> values;
+      gather(vec, indices, values);
+      return values;
+    }
+
+    /** @brief Updates the entries vec[indices[i]] of a vector with values[i] in a single operation. Replaces repeated (slow) element access via vec[j].
+    *
+    * Duplicate indices are processed in the order given, i.e. for op_assign() the last value is written.
+    * For vectors in OpenCL or CUDA memory, the range of entries spanned by the indices is transferred to the host, updated, and written back.
+    * Both transfers cover all entries from the smallest to the largest index (including the gaps of a slice), independent of the number of indices.
+    * Thus, for a few indices spread over a long vector, the cost is that of reading and writing the whole vector.
+    *
+    * @param values   The values
+    * @param indices  The indices of the entries to update
+    * @param vec      The vector (or -range, or -slice)
+    * @param op       The update: op_assign() for vec[j] = v, op_inplace_add() for vec[j] += v, op_max() for vec[j] = max(vec[j], v)
+    */
+    template<typename NumericT, typename IndexT, typename OpT>
+    void scatter(std::vector<NumericT> const & values, std::vector<IndexT> const & indices, vector_base<NumericT> & vec, OpT op)
+    {
+      assert(values.size() == indices.size() && bool("Number of values and indices differ in scatter()"));
+      if (indices.empty())
+        return;
+
+      switch (viennacl::traits::handle(vec).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+        {
+          viennacl::detail::host_context_scope scope(viennacl::traits::ram_context(vec));
+          viennacl::linalg::host_based::scatter(&(values[0]), &(indices[0]), indices.size(), vec, op);
+          break;
+        }
+#if defined(VIENNACL_WITH_OPENCL) || defined(VIENNACL_WITH_CUDA)
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+#endif
+#ifdef VIENNACL_WITH_CUDA
+        case viennacl::CUDA_MEMORY:
+#endif
+        {
+          vcl_size_t min_index, max_index;
+          detail::index_bounds(indices, min_index, max_index);
+          assert(max_index < vec.size() && bool("Index out of bounds in scatter()"));
+
+          std::vector<NumericT> buffer;
+          detail::read_index_range(vec, min_index, max_index, buffer);
+          viennacl::linalg::host_based::detail::scatter_impl(&(values[0]), &(indices[0]), indices.size(), min_index,
+                                                             &(buffer[0]), 0, viennacl::traits::stride(vec), min_index, max_index + 1, op);
+          detail::write_index_range(vec, min_index, buffer);
+          break;
+        }
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+    /** @brief Assigns values[i] to the entries vec[indices[i]] of a vector, cf. scatter(values, indices, vec, op) */
+    template<typename NumericT, typename IndexT>
+    void scatter(std::vector<NumericT> const & values, std::vector<IndexT> const & indices, vector_base<NumericT> & vec)
+    {
+      scatter(values, indices, vec, viennacl::op_assign());
+    }
+
   } //namespace linalg
 
   template<typename T, typename LHS, typename RHS, typename OP>
@@ -254,6 +254,16 @@ matrix_base<NumericT, SizeT, DistanceT> & matrix_base<NumericT, SizeT, DistanceT
     resize(other.size1(), other.size2(), false);
   }
 
+  if (row_major_ != other.row_major()) // layout conversion: write the transpose of other to the transposed view of this matrix, which has the layout of other
+  {
+    self_type this_trans(elements_,
+                         size2_, start2_, stride2_, internal_size2_,
+                         size1_, start1_, stride1_, internal_size1_,
+                         !row_major_);
+    viennacl::linalg::trans(matrix_expression<const self_type, const self_type, op_trans>(other, other), this_trans);
+    return *this;
+  }
+
   viennacl::linalg::am(*this,
                        other, cpu_value_type(1.0), 1, false, false);
   return *this;
@@ -302,20 +312,38 @@ matrix_base<NumericT, SizeT, DistanceT> & matrix_base<NumericT, SizeT, DistanceT
     internal_size2_ = viennacl::tools::align_to_multiple<size_type>(size2_, dense_padding_size);
     if (!row_major_fixed_)
       row_major_ = viennacl::traits::row_major(proxy);
+    viennacl::backend::memory_create(elements_, sizeof(NumericT)*internal_size(), viennacl::traits::context(proxy));
+    if (size1_ != internal_size1_ || size2_ != internal_size2_)
+      clear();
   }
 
-  if ( handle() == proxy.lhs().handle() )
+  self_type const & A = proxy.lhs();
+  if ( handle() == A.handle() )
   {
-    viennacl::matrix_base<NumericT> temp(proxy.lhs().size2(), proxy.lhs().size1(),proxy.lhs().row_major());
-    viennacl::linalg::trans(proxy, temp);
-    if ( proxy.lhs().size1() != proxy.lhs().size2() )
-      this->resize(proxy.lhs().size2(), proxy.lhs().size1());
-    elements_ = temp.handle();
+    bool whole_buffer = start1_ == 0 && start2_ == 0 && stride1_ == 1 && stride2_ == 1
+                     && A.start1() == 0 && A.start2() == 0 && A.stride1() == 1 && A.stride2() == 1
+                     && size1_ == A.size1() && size2_ == A.size2() && internal_size1_ == A.internal_size1() && internal_size2_ == A.internal_size2()
+                     && row_major_ == A.row_major();
+
+    if ( whole_buffer && (size1_ == size2_ || &A == this) ) // A = trans(A): transpose in place
+    {
+      viennacl::linalg::detail::trans_inplace(*this);
+      std::swap(size1_, size2_);
+      std::swap(internal_size1_, internal_size2_);
+    }
+    else
+    {
+      viennacl::matrix_base<NumericT> temp(A.size2(), A.size1(), A.row_major(), viennacl::traits::context(A));
+      viennacl::linalg::trans(proxy, temp);
+      if ( size1_ != temp.size1() || size2_ != temp.size2() )
+        this->resize(temp.size1(), temp.size2(), false);
+      *this = temp;
+    }
   }
   else
   {
-    if ( proxy.lhs().size1() != proxy.lhs().size2() )
-      this->resize(proxy.lhs().size2(), proxy.lhs().size1());
+    if ( size1_ != A.size2() || size2_ != A.size1() )
+      this->resize(A.size2(), A.size1(), false);
     viennacl::linalg::trans(proxy, *this);
   }
   return *this;
@@ -23,14 +23,96 @@
     @brief Convenience include for bandwidth reduction algorithms such as Cuthill-McKee or Gibbs-Poole-Stockmeyer.  Experimental.
 */
 
+#include <vector>
+#include <algorithm>
+
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/traits/context.hpp"
+#include "viennacl/backend/util.hpp"
 #include "viennacl/misc/cuthill_mckee.hpp"
 #include "viennacl/misc/gibbs_poole_stockmeyer.hpp"
+#include "viennacl/misc/reverse_cuthill_mckee.hpp"
+#include "viennacl/misc/nested_dissection.hpp"
 
 
 namespace viennacl
 {
   //TODO: Add convenience overload here. Which should be default?
 
+/** @brief Applies a permutation of the unknowns to a compressed_matrix, i.e. result(r[i], r[j]) = A(i, j).
+*
+* The rows of the result are assembled in parallel directly from the CSR arrays of A. The result is created in the memory context of A.
+*
+* @param A       The matrix to be permuted. Matrices in OpenCL or CUDA memory are copied to the host.
+* @param r       The permutation, where r[i] is the new index of the unknown i, e.g. as returned by reorder()
+* @param result  The permuted matrix
+*/
+template<typename NumericT, unsigned int AlignmentV, typename IndexT>
+void permute(viennacl::compressed_matrix<NumericT, AlignmentV> const & A, std::vector<IndexT> const & r, viennacl::compressed_matrix<NumericT, AlignmentV> & result)
+{
+  assert(A.size1() == A.size2() && bool("Permutation requires a square matrix"));
+  assert(r.size() == A.size1() && bool("Size of permutation does not match the matrix"));
+
+  if (A.nnz() == 0) // nothing to permute
+  {
+    result = A;
+    return;
+  }
+
+  detail::csr_host_view<NumericT> view(A, true);
+  unsigned int const * row_buffer = view.row_buffer();
+  unsigned int const * col_buffer = view.col_buffer();
+  NumericT     const * elements   = view.elements();
+  vcl_size_t n = view.size1();
+
+  std::vector<unsigned int> inverse(n);
+  for (vcl_size_t i=0; i<n; ++i)
+    inverse[static_cast<vcl_size_t>(r[i])] = static_cast<unsigned int>(i);
+
+  std::vector<unsigned int> new_rows(n + 1);
+  std::vector<unsigned int> new_cols(view.nnz());
+  std::vector<NumericT>     new_elements(view.nnz());
+
+  new_rows[0] = 0;
+  for (vcl_size_t i=0; i<n; ++i)
+    new_rows[i+1] = new_rows[i] + view.degree(inverse[i]);
+
+  long num_rows = static_cast<long>(n);
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for
+#endif
+  for (long row = 0; row < num_rows; ++row)
+  {
+    unsigned int old_row = inverse[static_cast<vcl_size_t>(row)];
+    unsigned int row_begin = new_rows[static_cast<vcl_size_t>(row)];
+
+    // copy the row with permuted column indices and sort it by insertion (rows are short):
+    unsigned int k = row_begin;
+    for (unsigned int j = row_buffer[old_row]; j < row_buffer[old_row + 1]; ++j, ++k)
+    {
+      unsigned int col   = static_cast<unsigned int>(r[col_buffer[j]]);
+      NumericT     value = elements[j];
+      unsigned int pos = k;
+      for (; pos > row_begin && new_cols[pos - 1] > col; --pos)
+      {
+        new_cols[pos]     = new_cols[pos - 1];
+        new_elements[pos] = new_elements[pos - 1];
+      }
+      new_cols[pos]     = col;
+      new_elements[pos] = value;
+    }
+  }
+
+  result.switch_memory_context(viennacl::traits::context(A));
+
+  viennacl::backend::typesafe_host_array<unsigned int> new_row_buffer(result.handle1(), n + 1);
+  viennacl::backend::typesafe_host_array<unsigned int> new_col_buffer(result.handle2(), view.nnz());
+  for (vcl_size_t i=0; i<new_rows.size(); ++i)
+    new_row_buffer.set(i, new_rows[i]);
+  for (vcl_size_t i=0; i<new_cols.size(); ++i)
+    new_col_buffer.set(i, new_cols[i]);
+  result.set(new_row_buffer.get(), new_col_buffer.get(), &(new_elements[0]), n, n, view.nnz());
+}
 
 } //namespace viennacl
 
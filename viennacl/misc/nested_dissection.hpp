@@ -0,0 +1,241 @@
+#ifndef VIENNACL_MISC_NESTED_DISSECTION_HPP
+#define VIENNACL_MISC_NESTED_DISSECTION_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+/** @file viennacl/misc/nested_dissection.hpp
+*    @brief Nested dissection ordering of the unknowns of a compressed_matrix for reducing fill-in in factorizations.  Experimental.
+*/
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <cassert>
+
+#include "viennacl/forwards.h"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/misc/reverse_cuthill_mckee.hpp"
+
+namespace viennacl
+{
+namespace detail
+{
+  /** @brief A subgraph of the dissection tree: Its nodes receive the labels first_label, first_label+1, ... */
+  struct nested_dissection_part
+  {
+    std::vector<unsigned int> nodes;
+    vcl_size_t first_label;
+  };
+
+  /** @brief Labels the nodes of a part consecutively in the given order */
+  inline void nested_dissection_label(std::vector<unsigned int> const & nodes, vcl_size_t first_label, std::vector<unsigned int> & permutation)
+  {
+    for (vcl_size_t i=0; i<nodes.size(); ++i)
+      permutation[nodes[i]] = static_cast<unsigned int>(first_label + i);
+  }
+
+  /** @brief Dissects a part by a level of a breadth-first search from a pseudo-peripheral node.
+  *
+  * The nodes before the separating level and the nodes after it are appended to 'new_parts', the separator receives the last labels of the part.
+  * Parts which are small or have fewer than three levels are labeled in Cuthill-McKee order. Disconnected parts are split into their connected components.
+  * Only the entries of 'level', 'position' and 'permutation' belonging to the part are accessed, hence different parts can be processed concurrently.
+  */
+  template<typename NumericT>
+  void nested_dissection_split(csr_host_view<NumericT> const & A, nested_dissection_part const & part,
+                               std::vector<unsigned int> const & subgraph, unsigned int id, vcl_size_t min_subgraph_size,
+                               std::vector<unsigned int> & level, std::vector<unsigned int> & position,
+                               std::vector<unsigned int> & permutation, std::vector<nested_dissection_part> & new_parts)
+  {
+    if (part.nodes.size() <= min_subgraph_size)
+    {
+      nested_dissection_label(part.nodes, part.first_label, permutation);
+      return;
+    }
+
+    csr_subgraph_nodes is_member(subgraph, id);
+    std::vector<unsigned int> nodes;
+    std::vector<vcl_size_t>   level_offsets;
+
+    unsigned int root = csr_pseudo_peripheral_node(A, part.nodes[0], is_member, level, position, nodes, level_offsets, false);
+    csr_bfs(A, root, is_member, level, position, nodes, level_offsets, false);
+
+    if (nodes.size() < part.nodes.size()) // disconnected: each connected component becomes a new part
+    {
+      std::vector<unsigned int> component_nodes;
+      std::vector<unsigned int> visited(nodes);
+      vcl_size_t first_label = part.first_label;
+
+      new_parts.push_back(nested_dissection_part());
+      new_parts.back().nodes.swap(nodes);
+      new_parts.back().first_label = first_label;
+      first_label += new_parts.back().nodes.size();
+
+      for (vcl_size_t i=0; i<part.nodes.size(); ++i)
+      {
+        if (level[part.nodes[i]] != csr_bfs_unvisited())
+          continue;
+
+        csr_bfs(A, part.nodes[i], is_member, level, position, component_nodes, level_offsets, false);
+        visited.insert(visited.end(), component_nodes.begin(), component_nodes.end());
+
+        new_parts.push_back(nested_dissection_part());
+        new_parts.back().nodes.swap(component_nodes);
+        new_parts.back().first_label = first_label;
+        first_label += new_parts.back().nodes.size();
+      }
+
+      csr_bfs_reset(visited, level);
+      return;
+    }
+
+    vcl_size_t num_levels = level_offsets.size() - 1;
+    if (num_levels < 3)
+    {
+      nested_dissection_label(nodes, part.first_label, permutation);
+      csr_bfs_reset(nodes, level);
+      return;
+    }
+
+    // separating level: the level containing the median node, but neither the first nor the last level:
+    vcl_size_t separator_level = 1;
+    while (separator_level < num_levels - 2 && level_offsets[separator_level + 1] <= nodes.size() / 2)
+      ++separator_level;
+
+    nested_dissection_part part_a;
+    nested_dissection_part part_b;
+    std::vector<unsigned int> separator;
+
+    part_a.nodes.assign(nodes.begin(), nodes.begin() + static_cast<long>(level_offsets[separator_level]));
+    part_b.nodes.assign(nodes.begin() + static_cast<long>(level_offsets[separator_level + 1]), nodes.end());
+
+    // nodes of the separating level without neighbors in the next level are not needed in the separator:
+    unsigned int const * row_buffer = A.row_buffer();
+    unsigned int const * col_buffer = A.col_buffer();
+    for (vcl_size_t i = level_offsets[separator_level]; i < level_offsets[separator_level + 1]; ++i)
+    {
+      unsigned int node = nodes[i];
+      bool is_separating = false;
+      for (unsigned int j = row_buffer[node]; j < row_buffer[node+1]; ++j)
+      {
+        unsigned int neighbor = col_buffer[j];
+        if (is_member(neighbor) && level[neighbor] == separator_level + 1)
+        {
+          is_separating = true;
+          break;
+        }
+      }
+
+      if (is_separating)
+        separator.push_back(node);
+      else
+        part_a.nodes.push_back(node);
+    }
+
+    part_a.first_label = part.first_label;
+    part_b.first_label = part.first_label + part_a.nodes.size();
+    nested_dissection_label(separator, part_b.first_label + part_b.nodes.size(), permutation);
+
+    csr_bfs_reset(nodes, level);
+    new_parts.push_back(part_a);
+    new_parts.push_back(part_b);
+  }
+}
+
+/** @brief A tag class for selecting the nested dissection ordering of a compressed_matrix.
+*
+* The graph of the matrix is recursively dissected by separators obtained from breadth-first searches, where the separators are numbered last.
+* Subgraphs with at most min_subgraph_size() nodes are not dissected further. The sparsity pattern of the matrix is assumed to be symmetric.
+*/
+class nested_dissection_tag
+{
+public:
+  nested_dissection_tag(vcl_size_t min_subgraph_size = 64) : min_subgraph_size_(min_subgraph_size) {}
+
+  vcl_size_t min_subgraph_size() const { return min_subgraph_size_; }
+  void min_subgraph_size(vcl_size_t num_nodes) { min_subgraph_size_ = num_nodes; }
+
+private:
+  vcl_size_t min_subgraph_size_;
+};
+
+/** @brief Computes a nested dissection ordering of the unknowns of a compressed_matrix.
+*
+* The dissection tree is processed level by level, where the subgraphs of each level are dissected in parallel.
+*
+* @param A    The system matrix with symmetric sparsity pattern. Matrices in OpenCL or CUDA memory are copied to the host.
+* @param tag  Configuration of the dissection
+* @return     The permutation r, where r[i] is the new index of the unknown i. Can be applied to the matrix via permute().
+*/
+template<typename NumericT, unsigned int AlignmentV>
+std::vector<unsigned int> reorder(viennacl::compressed_matrix<NumericT, AlignmentV> const & A, nested_dissection_tag const & tag)
+{
+  assert(A.size1() == A.size2() && bool("Reordering requires a square matrix"));
+
+  detail::csr_host_view<NumericT> view(A, false);
+  vcl_size_t n = view.size1();
+  unsigned int no_subgraph = std::numeric_limits<unsigned int>::max();
+
+  std::vector<unsigned int> permutation(n);
+  std::vector<unsigned int> subgraph(n);
+  std::vector<unsigned int> level(n, detail::csr_bfs_unvisited());
+  std::vector<unsigned int> position(n);
+
+  std::vector<detail::nested_dissection_part> parts;
+  if (n > 0)
+  {
+    parts.resize(1);
+    parts[0].nodes.resize(n);
+    for (vcl_size_t i=0; i<n; ++i)
+      parts[0].nodes[i] = static_cast<unsigned int>(i);
+    parts[0].first_label = 0;
+  }
+
+  while (!parts.empty()) // one level of the dissection tree per iteration
+  {
+    long num_parts = static_cast<long>(parts.size());
+
+    // nodes numbered in previous iterations are not part of any subgraph:
+    std::fill(subgraph.begin(), subgraph.end(), no_subgraph);
+    for (long p = 0; p < num_parts; ++p)
+    {
+      std::vector<unsigned int> const & part_nodes = parts[static_cast<vcl_size_t>(p)].nodes;
+      for (vcl_size_t i=0; i<part_nodes.size(); ++i)
+        subgraph[part_nodes[i]] = static_cast<unsigned int>(p);
+    }
+
+    std::vector< std::vector<detail::nested_dissection_part> > new_parts(parts.size());
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for (long p = 0; p < num_parts; ++p)
+      detail::nested_dissection_split(view, parts[static_cast<vcl_size_t>(p)], subgraph, static_cast<unsigned int>(p), tag.min_subgraph_size(),
+                                      level, position, permutation, new_parts[static_cast<vcl_size_t>(p)]);
+
+    parts.clear();
+    for (vcl_size_t p=0; p<new_parts.size(); ++p)
+      parts.insert(parts.end(), new_parts[p].begin(), new_parts[p].end());
+  }
+
+  return permutation;
+}
+
+} //namespace viennacl
+
+
+#endif
@@ -0,0 +1,374 @@
+#ifndef VIENNACL_MISC_REVERSE_CUTHILL_MCKEE_HPP
+#define VIENNACL_MISC_REVERSE_CUTHILL_MCKEE_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+/** @file viennacl/misc/reverse_cuthill_mckee.hpp
+*    @brief Reverse Cuthill-McKee reordering operating directly on the CSR arrays of a compressed_matrix, using a level-synchronous parallel breadth-first search.  Experimental.
+*/
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+#include "viennacl/forwards.h"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/traits/handle.hpp"
+#include "viennacl/backend/memory.hpp"
+#include "viennacl/backend/util.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+// Minimum number of nodes in a level of the breadth-first search for processing the level in parallel:
+#ifndef VIENNACL_REORDER_PARALLEL_MIN_LEVEL_SIZE
+  #define VIENNACL_REORDER_PARALLEL_MIN_LEVEL_SIZE  2048
+#endif
+
+namespace viennacl
+{
+namespace detail
+{
+  /** @brief Host view of the CSR arrays of a compressed_matrix. Uses the buffers directly if the matrix resides in main memory, otherwise a copy is created. */
+  template<typename NumericT>
+  class csr_host_view
+  {
+  public:
+    template<unsigned int AlignmentV>
+    csr_host_view(viennacl::compressed_matrix<NumericT, AlignmentV> const & A, bool with_elements)
+      : size1_(A.size1()), size2_(A.size2()), nnz_(A.nnz()), row_buffer_(NULL), col_buffer_(NULL), elements_(NULL)
+    {
+      if (size1_ == 0)
+        return;
+
+      if (nnz_ == 0) // the row buffer of a matrix without entries is not necessarily initialized
+      {
+        row_copy_.resize(size1_ + 1, 0);
+        row_buffer_ = &row_copy_[0];
+        return;
+      }
+
+      if (viennacl::traits::active_handle_id(A) == viennacl::MAIN_MEMORY)
+      {
+        row_buffer_ = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
+        col_buffer_ = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
+        if (with_elements)
+          elements_ = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A.handle());
+        return;
+      }
+
+      viennacl::backend::typesafe_host_array<unsigned int> row_buffer(A.handle1(), size1_ + 1);
+      viennacl::backend::memory_read(A.handle1(), 0, row_buffer.raw_size(), row_buffer.get());
+      row_copy_.resize(size1_ + 1);
+      for (vcl_size_t i=0; i<row_copy_.size(); ++i)
+        row_copy_[i] = static_cast<unsigned int>(row_buffer[i]);
+      row_buffer_ = &row_copy_[0];
+
+      if (nnz_ > 0)
+      {
+        viennacl::backend::typesafe_host_array<unsigned int> col_buffer(A.handle2(), nnz_);
+        viennacl::backend::memory_read(A.handle2(), 0, col_buffer.raw_size(), col_buffer.get());
+        col_copy_.resize(nnz_);
+        for (vcl_size_t i=0; i<col_copy_.size(); ++i)
+          col_copy_[i] = static_cast<unsigned int>(col_buffer[i]);
+        col_buffer_ = &col_copy_[0];
+
+        if (with_elements)
+        {
+          element_copy_.resize(nnz_);
+          viennacl::backend::memory_read(A.handle(), 0, sizeof(NumericT) * nnz_, &(element_copy_[0]));
+          elements_ = &element_copy_[0];
+        }
+      }
+    }
+
+    vcl_size_t size1() const { return size1_; }
+    vcl_size_t size2() const { return size2_; }
+    vcl_size_t nnz()   const { return nnz_; }
+
+    unsigned int const * row_buffer() const { return row_buffer_; }
+    unsigned int const * col_buffer() const { return col_buffer_; }
+    NumericT     const * elements()   const { return elements_; }
+
+    /** @brief Number of entries in row i, i.e. the degree of node i in the graph of the matrix */
+    unsigned int degree(vcl_size_t i) const { return row_buffer_[i+1] - row_buffer_[i]; }
+
+  private:
+    vcl_size_t size1_;
+    vcl_size_t size2_;
+    vcl_size_t nnz_;
+    unsigned int const * row_buffer_;
+    unsigned int const * col_buffer_;
+    NumericT     const * elements_;
+    std::vector<unsigned int> row_copy_;
+    std::vector<unsigned int> col_copy_;
+    std::vector<NumericT>     element_copy_;
+  };
+
+  /** @brief Marker for nodes not visited by a breadth-first search */
+  inline unsigned int csr_bfs_unvisited() { return std::numeric_limits<unsigned int>::max(); }
+
+  /** @brief Predicate accepting all nodes of a graph */
+  struct csr_all_nodes
+  {
+    bool operator()(unsigned int) const { return true; }
+  };
+
+  /** @brief Predicate accepting the nodes of a subgraph, i.e. the nodes with a given id */
+  struct csr_subgraph_nodes
+  {
+    csr_subgraph_nodes(std::vector<unsigned int> const & ids, unsigned int id) : ids_(ids), id_(id) {}
+
+    bool operator()(unsigned int node) const { return ids_[node] == id_; }
+
+  private:
+    std::vector<unsigned int> const & ids_;
+    unsigned int id_;
+  };
+
+  /** @brief Compares nodes by increasing degree, ties are broken by the node index */
+  template<typename NumericT>
+  struct csr_degree_less
+  {
+    csr_degree_less(csr_host_view<NumericT> const & A) : A_(A) {}
+
+    bool operator()(unsigned int a, unsigned int b) const
+    {
+      unsigned int deg_a = A_.degree(a);
+      unsigned int deg_b = A_.degree(b);
+      return deg_a < deg_b || (deg_a == deg_b && a < b);
+    }
+
+  private:
+    csr_host_view<NumericT> const & A_;
+  };
+
+  /** @brief Level-synchronous breadth-first search from 'root' over the nodes accepted by 'is_member'.
+  *
+  * The visited nodes are appended to 'nodes' in Cuthill-McKee order:
+  * The children of a node in the next level are the unvisited neighbors for which it is the first neighbor in the current level, sorted by increasing degree.
+  * Since the parent of each node is determined by reading the current level only, the levels are processed in parallel without synchronization and
+  * the result is identical to the sequential Cuthill-McKee algorithm.
+  *
+  * On entry, 'level' must hold csr_bfs_unvisited() for all member nodes. On exit, 'level' and 'position' hold the level and the index in 'nodes' for all visited nodes.
+  * 'level_offsets' holds the index of the first node of each level in 'nodes', followed by the number of nodes.
+  */
+  template<typename NumericT, typename MemberT>
+  void csr_bfs(csr_host_view<NumericT> const & A, unsigned int root, MemberT const & is_member,
+               std::vector<unsigned int> & level, std::vector<unsigned int> & position,
+               std::vector<unsigned int> & nodes, std::vector<vcl_size_t> & level_offsets, bool allow_parallel)
+  {
+    unsigned int const * row_buffer = A.row_buffer();
+    unsigned int const * col_buffer = A.col_buffer();
+    unsigned int unvisited = csr_bfs_unvisited();
+
+    nodes.clear();
+    level_offsets.clear();
+    nodes.push_back(root);
+    level[root] = 0;
+    position[root] = 0;
+    level_offsets.push_back(0);
+
+    std::vector< std::vector<unsigned int> > children(1);
+#ifdef VIENNACL_WITH_OPENMP
+    if (allow_parallel)
+      children.resize(static_cast<vcl_size_t>(omp_get_max_threads()));
+#else
+    (void)allow_parallel;
+#endif
+    std::vector<vcl_size_t> children_offsets(children.size() + 1);
+
+    for (unsigned int current_level = 0; level_offsets.back() < nodes.size(); ++current_level)
+    {
+      long level_begin = static_cast<long>(level_offsets.back());
+      long level_end   = static_cast<long>(nodes.size());
+      long num_threads = 1;
+      level_offsets.push_back(nodes.size());
+
+      // collect the children of each node of the current level:
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel num_threads(static_cast<int>(children.size())) if (children.size() > 1 && level_end - level_begin > VIENNACL_REORDER_PARALLEL_MIN_LEVEL_SIZE)
+#endif
+      {
+        long id = 0;
+#ifdef VIENNACL_WITH_OPENMP
+        id = omp_get_thread_num();
+        #pragma omp single
+        num_threads = omp_get_num_threads();
+#endif
+        std::vector<unsigned int> & my_children = children[static_cast<vcl_size_t>(id)];
+        my_children.clear();
+
+        long chunk_begin = level_begin + ((level_end - level_begin) *  id     ) / num_threads;
+        long chunk_end   = level_begin + ((level_end - level_begin) * (id + 1)) / num_threads;
+        for (long i = chunk_begin; i < chunk_end; ++i)
+        {
+          unsigned int node = nodes[static_cast<vcl_size_t>(i)];
+          vcl_size_t first_child = my_children.size();
+
+          for (unsigned int j = row_buffer[node]; j < row_buffer[node+1]; ++j)
+          {
+            unsigned int neighbor = col_buffer[j];
+            if (!is_member(neighbor) || level[neighbor] != unvisited)
+              continue;
+
+            // 'node' is the parent if no other neighbor in the current level precedes it:
+            bool is_parent = true;
+            for (unsigned int k = row_buffer[neighbor]; k < row_buffer[neighbor+1]; ++k)
+            {
+              unsigned int other = col_buffer[k];
+              if (is_member(other) && level[other] == current_level && position[other] < static_cast<unsigned int>(i))
+              {
+                is_parent = false;
+                break;
+              }
+            }
+            if (is_parent)
+              my_children.push_back(neighbor);
+          }
+
+          std::sort(my_children.begin() + static_cast<long>(first_child), my_children.end(), csr_degree_less<NumericT>(A));
+        }
+      }
+
+      // append the children in the order of their parents:
+      children_offsets[0] = nodes.size();
+      for (long t = 0; t < num_threads; ++t)
+        children_offsets[static_cast<vcl_size_t>(t) + 1] = children_offsets[static_cast<vcl_size_t>(t)] + children[static_cast<vcl_size_t>(t)].size();
+      nodes.resize(children_offsets[static_cast<vcl_size_t>(num_threads)]);
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for if (num_threads > 1)
+#endif
+      for (long t = 0; t < num_threads; ++t)
+      {
+        std::vector<unsigned int> const & my_children = children[static_cast<vcl_size_t>(t)];
+        vcl_size_t offset = children_offsets[static_cast<vcl_size_t>(t)];
+        for (vcl_size_t k = 0; k < my_children.size(); ++k)
+        {
+          nodes[offset + k] = my_children[k];
+          level[my_children[k]] = current_level + 1;
+          position[my_children[k]] = static_cast<unsigned int>(offset + k);
+        }
+      }
+    }
+  }
+
+  /** @brief Resets the levels of the nodes visited by a breadth-first search */
+  inline void csr_bfs_reset(std::vector<unsigned int> const & nodes, std::vector<unsigned int> & level)
+  {
+    for (vcl_size_t i=0; i<nodes.size(); ++i)
+      level[nodes[i]] = csr_bfs_unvisited();
+  }
+
+  /** @brief Finds a pseudo-peripheral node of the connected component containing 'start' (algorithm by George and Liu).
+  *
+  * Starting from 'start', a breadth-first search is repeated from a node of minimum degree in the last level as long as the number of levels increases.
+  * On exit, the levels of all nodes are reset.
+  */
+  template<typename NumericT, typename MemberT>
+  unsigned int csr_pseudo_peripheral_node(csr_host_view<NumericT> const & A, unsigned int start, MemberT const & is_member,
+                                          std::vector<unsigned int> & level, std::vector<unsigned int> & position,
+                                          std::vector<unsigned int> & nodes, std::vector<vcl_size_t> & level_offsets, bool allow_parallel)
+  {
+    unsigned int root = start;
+    csr_bfs(A, root, is_member, level, position, nodes, level_offsets, allow_parallel);
+    vcl_size_t num_levels = level_offsets.size() - 1;
+
+    while (num_levels > 1)
+    {
+      unsigned int candidate = nodes[level_offsets[num_levels - 1]];
+      for (vcl_size_t i = level_offsets[num_levels - 1] + 1; i < nodes.size(); ++i)
+        if (csr_degree_less<NumericT>(A)(nodes[i], candidate))
+          candidate = nodes[i];
+
+      csr_bfs_reset(nodes, level);
+      csr_bfs(A, candidate, is_member, level, position, nodes, level_offsets, allow_parallel);
+      if (level_offsets.size() - 1 <= num_levels)
+        break;
+
+      root = candidate;
+      num_levels = level_offsets.size() - 1;
+    }
+
+    csr_bfs_reset(nodes, level);
+    return root;
+  }
+}
+
+/** @brief A tag class for selecting the reverse Cuthill-McKee algorithm for reducing the bandwidth of a compressed_matrix.
+*
+* The reordering operates directly on the CSR arrays. Each connected component is numbered by a parallel level-synchronous breadth-first search starting at a pseudo-peripheral node.
+* The sparsity pattern of the matrix is assumed to be symmetric.
+*/
+struct reverse_cuthill_mckee_tag {};
+
+/** @brief Computes a reverse Cuthill-McKee ordering of the unknowns of a compressed_matrix.
+*
+* @param A    The system matrix with symmetric sparsity pattern. Matrices in OpenCL or CUDA memory are copied to the host.
+* @return     The permutation r, where r[i] is the new index of the unknown i. Can be applied to the matrix via permute().
+*/
+template<typename NumericT, unsigned int AlignmentV>
+std::vector<unsigned int> reorder(viennacl::compressed_matrix<NumericT, AlignmentV> const & A, reverse_cuthill_mckee_tag)
+{
+  assert(A.size1() == A.size2() && bool("Reordering requires a square matrix"));
+
+  detail::csr_host_view<NumericT> view(A, false);
+  vcl_size_t n = view.size1();
+
+  std::vector<unsigned int> permutation(n);
+  std::vector<unsigned int> level(n, detail::csr_bfs_unvisited());
+  std::vector<unsigned int> position(n);
+  std::vector<bool>         is_numbered(n, false);
+  std::vector<unsigned int> nodes;
+  std::vector<vcl_size_t>   level_offsets;
+
+  vcl_size_t next_index = 0;
+  vcl_size_t start = 0;
+  while (next_index < n) // one connected component per iteration
+  {
+    while (is_numbered[start])
+      ++start;
+
+    unsigned int root = detail::csr_pseudo_peripheral_node(view, static_cast<unsigned int>(start), detail::csr_all_nodes(), level, position, nodes, level_offsets, true);
+    detail::csr_bfs(view, root, detail::csr_all_nodes(), level, position, nodes, level_offsets, true);
+
+    // reverse numbering, the first component is numbered last:
+    long num_nodes = static_cast<long>(nodes.size());
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (num_nodes > VIENNACL_REORDER_PARALLEL_MIN_LEVEL_SIZE)
+#endif
+    for (long i = 0; i < num_nodes; ++i)
+      permutation[nodes[static_cast<vcl_size_t>(i)]] = static_cast<unsigned int>(n - 1 - (next_index + static_cast<vcl_size_t>(i)));
+
+    for (vcl_size_t i = 0; i < nodes.size(); ++i)
+      is_numbered[nodes[i]] = true;
+    next_index += nodes.size();
+    detail::csr_bfs_reset(nodes, level);
+  }
+
+  return permutation;
+}
+
+} //namespace viennacl
+
+
+#endif
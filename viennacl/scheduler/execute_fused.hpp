@@ -0,0 +1,984 @@
+#ifndef VIENNACL_SCHEDULER_EXECUTE_FUSED_HPP
+#define VIENNACL_SCHEDULER_EXECUTE_FUSED_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+/** @file viennacl/scheduler/execute_fused.hpp
+    @brief Executes a group of statements such as 'x += a*p; r -= a*Ap; rr = inner_prod(r,r);' within a single loop over the vector entries on the host.
+*/
+
+#include <cmath>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <utility>
+#include <cstring>
+
+#include "viennacl/forwards.h"
+#include "viennacl/scalar.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/scheduler/forwards.h"
+#include "viennacl/scheduler/execute.hpp"
+#include "viennacl/tools/shared_ptr.hpp"
+#include "viennacl/device_specific/statements_container.hpp"
+#include "viennacl/linalg/host_based/vector_operations.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+// Number of vector entries processed by each statement of a fused group before proceeding with the next statement:
+#ifndef VIENNACL_FUSED_BLOCK_SIZE
+  #define VIENNACL_FUSED_BLOCK_SIZE  256
+#endif
+
+namespace viennacl
+{
+namespace scheduler
+{
+namespace detail
+{
+  /** @brief Extracts the operands of a given numeric type from a lhs_rhs_element */
+  template<typename NumericT>
+  struct fused_element_access {};
+
+  template<>
+  struct fused_element_access<float>
+  {
+    static viennacl::vector_base<float> * vector(lhs_rhs_element const & e) { return e.vector_float; }
+    static viennacl::scalar<float>      * scalar(lhs_rhs_element const & e) { return e.scalar_float; }
+    static float                     host_scalar(lhs_rhs_element const & e) { return e.host_float; }
+  };
+
+  template<>
+  struct fused_element_access<double>
+  {
+    static viennacl::vector_base<double> * vector(lhs_rhs_element const & e) { return e.vector_double; }
+    static viennacl::scalar<double>      * scalar(lhs_rhs_element const & e) { return e.scalar_double; }
+    static double                     host_scalar(lhs_rhs_element const & e) { return e.host_double; }
+  };
+
+
+  /** @brief An operand of a fused statement: either a vector read from memory, a constant, or the result of an instruction */
+  template<typename NumericT>
+  struct fused_slot
+  {
+    enum kind_type { VECTOR_SLOT, CONSTANT_SLOT, TEMPORARY_SLOT };
+
+    fused_slot(kind_type k) : kind(k), data(NULL), start(0), stride(1), value(0), scalar(NULL) {}
+
+    kind_type        kind;
+    NumericT const * data;    // VECTOR_SLOT
+    vcl_size_t       start;
+    vcl_size_t       stride;
+    NumericT         value;   // CONSTANT_SLOT
+    viennacl::scalar<NumericT> const * scalar;  // CONSTANT_SLOT holding the value of a device scalar, updated at each run
+  };
+
+  /** @brief An elementwise operation of a fused statement: result = lhs OP rhs (or OP lhs for unary operations) */
+  struct fused_instruction
+  {
+    lhs_rhs_element     expression;  // the subexpression of the statement computed by the instruction
+    operation_node_type op;
+    vcl_size_t lhs;
+    vcl_size_t rhs;
+    vcl_size_t result;
+  };
+
+  /** @brief A memory access of a statement, used for the detection of dependencies between statements */
+  struct fused_access
+  {
+    viennacl::backend::mem_handle const * handle;
+    vcl_size_t start;
+    vcl_size_t stride;
+    bool       is_write;
+  };
+
+  /** @brief A statement compiled into a sequence of elementwise instructions on blocks of entries */
+  template<typename NumericT>
+  struct fused_statement
+  {
+    fused_statement() : size(0), result_slot(0), result_slot2(0), scale_slot(static_cast<vcl_size_t>(-1)),
+                        assign_type(OPERATION_BINARY_ASSIGN_TYPE), reduction_type(OPERATION_INVALID_TYPE),
+                        vector_target(NULL), scalar_target(NULL) {}
+
+    vcl_size_t size;
+    std::vector<fused_slot<NumericT> > slots;
+    std::vector<fused_instruction>     code;
+    vcl_size_t result_slot;      // entries assigned to the vector target, or first operand of the reduction
+    vcl_size_t result_slot2;     // second operand of an inner product
+    vcl_size_t scale_slot;       // constant applied to the entries of result_slot when writing the vector target, vcl_size_t(-1) if none
+
+    operation_node_type  assign_type;     // =, +=, -=
+    operation_node_type  reduction_type;  // OPERATION_INVALID_TYPE for vector statements
+
+    viennacl::vector_base<NumericT> * vector_target;
+    viennacl::scalar<NumericT>      * scalar_target;
+
+    std::vector<fused_access>                               vector_accesses;
+    std::vector<viennacl::backend::mem_handle const *>      scalar_reads;
+  };
+
+  /** @brief Returns true if the operation is an elementwise unary function supported by the fused executor */
+  inline bool fused_is_unary(operation_node_type op)
+  {
+    switch (op)
+    {
+    case OPERATION_UNARY_MINUS_TYPE:
+    case OPERATION_UNARY_ABS_TYPE:  case OPERATION_UNARY_FABS_TYPE:
+    case OPERATION_UNARY_ACOS_TYPE: case OPERATION_UNARY_ASIN_TYPE: case OPERATION_UNARY_ATAN_TYPE:
+    case OPERATION_UNARY_CEIL_TYPE: case OPERATION_UNARY_FLOOR_TYPE:
+    case OPERATION_UNARY_COS_TYPE:  case OPERATION_UNARY_SIN_TYPE:  case OPERATION_UNARY_TAN_TYPE:
+    case OPERATION_UNARY_COSH_TYPE: case OPERATION_UNARY_SINH_TYPE: case OPERATION_UNARY_TANH_TYPE:
+    case OPERATION_UNARY_EXP_TYPE:  case OPERATION_UNARY_LOG_TYPE:  case OPERATION_UNARY_LOG10_TYPE:
+    case OPERATION_UNARY_SQRT_TYPE:
+      return true;
+    default:
+      return false;
+    }
+  }
+
+  /** @brief Returns true if the operation is an elementwise binary operation supported by the fused executor */
+  inline bool fused_is_binary(operation_node_type op)
+  {
+    switch (op)
+    {
+    case OPERATION_BINARY_ADD_TYPE:
+    case OPERATION_BINARY_SUB_TYPE:
+    case OPERATION_BINARY_MULT_TYPE:
+    case OPERATION_BINARY_DIV_TYPE:
+    case OPERATION_BINARY_ELEMENT_PROD_TYPE:
+    case OPERATION_BINARY_ELEMENT_DIV_TYPE:
+    case OPERATION_BINARY_ELEMENT_POW_TYPE:
+    case OPERATION_BINARY_ELEMENT_FMAX_TYPE:
+    case OPERATION_BINARY_ELEMENT_FMIN_TYPE:
+      return true;
+    default:
+      return false;
+    }
+  }
+
+  /** @brief Returns true if the operation is a reduction of a vector to a scalar supported by the fused executor */
+  inline bool fused_is_reduction(operation_node_type op)
+  {
+    return op == OPERATION_BINARY_INNER_PROD_TYPE
+        || op == OPERATION_UNARY_NORM_1_TYPE
+        || op == OPERATION_UNARY_NORM_2_TYPE
+        || op == OPERATION_UNARY_NORM_INF_TYPE
+        || op == OPERATION_UNARY_MAX_TYPE
+        || op == OPERATION_UNARY_MIN_TYPE;
+  }
+
+  /** @brief Applies an elementwise operation to n entries */
+  template<typename NumericT>
+  void fused_apply(operation_node_type op, NumericT const * a, NumericT const * b, NumericT * r, vcl_size_t n)
+  {
+    switch (op)
+    {
+    case OPERATION_BINARY_ADD_TYPE:          for (vcl_size_t k = 0; k < n; ++k) r[k] = a[k] + b[k]; break;
+    case OPERATION_BINARY_SUB_TYPE:          for (vcl_size_t k = 0; k < n; ++k) r[k] = a[k] - b[k]; break;
+    case OPERATION_BINARY_MULT_TYPE:
+    case OPERATION_BINARY_ELEMENT_PROD_TYPE: for (vcl_size_t k = 0; k < n; ++k) r[k] = a[k] * b[k]; break;
+    case OPERATION_BINARY_DIV_TYPE:
+    case OPERATION_BINARY_ELEMENT_DIV_TYPE:  for (vcl_size_t k = 0; k < n; ++k) r[k] = a[k] / b[k]; break;
+    case OPERATION_BINARY_ELEMENT_POW_TYPE:  for (vcl_size_t k = 0; k < n; ++k) r[k] = std::pow(a[k], b[k]); break;
+    case OPERATION_BINARY_ELEMENT_FMAX_TYPE: for (vcl_size_t k = 0; k < n; ++k) r[k] = std::max(a[k], b[k]); break;
+    case OPERATION_BINARY_ELEMENT_FMIN_TYPE: for (vcl_size_t k = 0; k < n; ++k) r[k] = std::min(a[k], b[k]); break;
+
+    case OPERATION_UNARY_MINUS_TYPE: for (vcl_size_t k = 0; k < n; ++k) r[k] = -a[k]; break;
+    case OPERATION_UNARY_ABS_TYPE:
+    case OPERATION_UNARY_FABS_TYPE:  for (vcl_size_t k = 0; k < n; ++k) r[k] = std::fabs(a[k]); break;
+    case OPERATION_UNARY_ACOS_TYPE:  for (vcl_size_t k = 0; k < n; ++k) r[k] = std::acos(a[k]); break;
+    case OPERATION_UNARY_ASIN_TYPE:  for (vcl_size_t k = 0; k < n; ++k) r[k] = std::asin(a[k]); break;
+    case OPERATION_UNARY_ATAN_TYPE:  for (vcl_size_t k = 0; k < n; ++k) r[k] = std::atan(a[k]); break;
+    case OPERATION_UNARY_CEIL_TYPE:  for (vcl_size_t k = 0; k < n; ++k) r[k] = std::ceil(a[k]); break;
+    case OPERATION_UNARY_FLOOR_TYPE: for (vcl_size_t k = 0; k < n; ++k) r[k] = std::floor(a[k]); break;
+    case OPERATION_UNARY_COS_TYPE:   for (vcl_size_t k = 0; k < n; ++k) r[k] = std::cos(a[k]); break;
+    case OPERATION_UNARY_SIN_TYPE:   for (vcl_size_t k = 0; k < n; ++k) r[k] = std::sin(a[k]); break;
+    case OPERATION_UNARY_TAN_TYPE:   for (vcl_size_t k = 0; k < n; ++k) r[k] = std::tan(a[k]); break;
+    case OPERATION_UNARY_COSH_TYPE:  for (vcl_size_t k = 0; k < n; ++k) r[k] = std::cosh(a[k]); break;
+    case OPERATION_UNARY_SINH_TYPE:  for (vcl_size_t k = 0; k < n; ++k) r[k] = std::sinh(a[k]); break;
+    case OPERATION_UNARY_TANH_TYPE:  for (vcl_size_t k = 0; k < n; ++k) r[k] = std::tanh(a[k]); break;
+    case OPERATION_UNARY_EXP_TYPE:   for (vcl_size_t k = 0; k < n; ++k) r[k] = std::exp(a[k]); break;
+    case OPERATION_UNARY_LOG_TYPE:   for (vcl_size_t k = 0; k < n; ++k) r[k] = std::log(a[k]); break;
+    case OPERATION_UNARY_LOG10_TYPE: for (vcl_size_t k = 0; k < n; ++k) r[k] = std::log10(a[k]); break;
+    case OPERATION_UNARY_SQRT_TYPE:  for (vcl_size_t k = 0; k < n; ++k) r[k] = std::sqrt(a[k]); break;
+    default:
+      throw statement_not_supported_exception("Operation not supported by the fused executor");
+    }
+  }
+
+  /** @brief Returns true if two operands of a statement are the same object, the same host scalar value, or identical subexpressions */
+  inline bool fused_equal(statement const & s, lhs_rhs_element const & a, lhs_rhs_element const & b)
+  {
+    if (a.type_family != b.type_family || a.subtype != b.subtype || a.numeric_type != b.numeric_type)
+      return false;
+
+    switch (a.type_family)
+    {
+    case INVALID_TYPE_FAMILY:
+      return true;
+    case COMPOSITE_OPERATION_FAMILY:
+    {
+      statement_node const & x = s.array()[a.node_index];
+      statement_node const & y = s.array()[b.node_index];
+      if (x.op.type_family != y.op.type_family || x.op.type != y.op.type || !fused_equal(s, x.lhs, y.lhs))
+        return false;
+      return x.op.type_family != OPERATION_BINARY_TYPE_FAMILY || fused_equal(s, x.rhs, y.rhs);
+    }
+    default:
+      break;
+    }
+
+    if (a.subtype == HOST_SCALAR_TYPE)
+    {
+      switch (a.numeric_type)
+      {
+      case FLOAT_TYPE:  return a.host_float  == b.host_float;
+      case DOUBLE_TYPE: return a.host_double == b.host_double;
+      default:          return false;
+      }
+    }
+
+    // all other operands are pointers to objects, stored at the beginning of the union:
+    return std::memcmp(&a.vector_float, &b.vector_float, sizeof(a.vector_float)) == 0;
+  }
+
+
+  /** @brief A group of statements on vectors of the same size and numeric type, executed within a single blocked loop over the vector entries.
+  *
+  * Statements are appended one after another. A statement is only appended if it does not depend on the previous statements of the group other than elementwise,
+  * i.e. all accesses to the same buffer use the same offset and stride, and no scalar computed by a reduction in the group is read.
+  * Since all statements are applied to a block of entries before proceeding with the next block, the results are the same as for sequential execution.
+  */
+  template<typename NumericT>
+  class fused_group
+  {
+    typedef fused_element_access<NumericT>  access_type;
+    typedef fused_slot<NumericT>            slot_type;
+
+  public:
+    /** @brief Compiles the statement into 'fs'. Returns false if the statement is not supported by the fused executor. */
+    static bool compile(statement const & s, fused_statement<NumericT> & fs)
+    {
+      statement_node const & root = s.array()[s.root()];
+
+      if (   root.op.type != OPERATION_BINARY_ASSIGN_TYPE
+          && root.op.type != OPERATION_BINARY_INPLACE_ADD_TYPE
+          && root.op.type != OPERATION_BINARY_INPLACE_SUB_TYPE)
+        return false;
+      if (root.lhs.numeric_type != statement_node_numeric_type(result_of::numeric_type_id<NumericT>::value))
+        return false;
+
+      fs = fused_statement<NumericT>();
+      fs.assign_type = root.op.type;
+
+      if (root.lhs.type_family == VECTOR_TYPE_FAMILY && root.lhs.subtype == DENSE_VECTOR_TYPE)
+      {
+        viennacl::vector_base<NumericT> * target = access_type::vector(root.lhs);
+        if (viennacl::traits::active_handle_id(*target) != viennacl::MAIN_MEMORY)
+          return false;
+
+        fs.vector_target = target;
+        fs.size = target->size();
+        if (!compile_operand(s, root.rhs, fs, fs.result_slot))
+          return false;
+
+        // a final multiplication by a constant is applied when writing the target, i.e. x += alpha * y is a single pass:
+        if (!fs.code.empty() && fs.code.back().result == fs.result_slot && fs.code.back().op == OPERATION_BINARY_MULT_TYPE)
+        {
+          fused_instruction const & instr = fs.code.back();
+          if (fs.slots[instr.rhs].kind == slot_type::CONSTANT_SLOT)
+          {
+            fs.scale_slot = instr.rhs;
+            fs.result_slot = instr.lhs;
+            fs.code.pop_back();
+          }
+          else if (fs.slots[instr.lhs].kind == slot_type::CONSTANT_SLOT)
+          {
+            fs.scale_slot = instr.lhs;
+            fs.result_slot = instr.rhs;
+            fs.code.pop_back();
+          }
+        }
+
+        // the entries of the target may only be read at the same position as they are written:
+        for (std::size_t i=0; i<fs.vector_accesses.size(); ++i)
+          if (   *fs.vector_accesses[i].handle == target->handle()
+              && (fs.vector_accesses[i].start != target->start() || fs.vector_accesses[i].stride != target->stride()))
+            return false;
+
+        fused_access a;
+        a.handle = &target->handle();
+        a.start  = target->start();
+        a.stride = target->stride();
+        a.is_write = true;
+        fs.vector_accesses.push_back(a);
+        return true;
+      }
+      else if (root.lhs.type_family == SCALAR_TYPE_FAMILY && root.lhs.subtype == DEVICE_SCALAR_TYPE && root.rhs.type_family == COMPOSITE_OPERATION_FAMILY)
+      {
+        viennacl::scalar<NumericT> * target = access_type::scalar(root.lhs);
+        if (viennacl::traits::active_handle_id(*target) != viennacl::MAIN_MEMORY)
+          return false;
+
+        statement_node const & leaf = s.array()[root.rhs.node_index];
+        if (!fused_is_reduction(leaf.op.type))
+          return false;
+
+        fs.scalar_target  = target;
+        fs.reduction_type = leaf.op.type;
+        if (!compile_operand(s, leaf.lhs, fs, fs.result_slot))
+          return false;
+        if (leaf.op.type == OPERATION_BINARY_INNER_PROD_TYPE && !compile_operand(s, leaf.rhs, fs, fs.result_slot2))
+          return false;
+
+        // reductions of (non-empty) vectors only:
+        return fs.size > 0;
+      }
+
+      return false;
+    }
+
+    /** @brief Returns true if the compiled statement can be appended to the group */
+    bool is_compatible(fused_statement<NumericT> const & fs) const
+    {
+      if (statements_.empty())
+        return true;
+      if (fs.size != statements_[0].size)
+        return false;
+
+      for (std::size_t i=0; i<statements_.size(); ++i)
+      {
+        fused_statement<NumericT> const & other = statements_[i];
+
+        for (std::size_t j=0; j<fs.vector_accesses.size(); ++j)
+          for (std::size_t k=0; k<other.vector_accesses.size(); ++k)
+          {
+            fused_access const & a = fs.vector_accesses[j];
+            fused_access const & b = other.vector_accesses[k];
+            if (   (a.is_write || b.is_write)
+                && *a.handle == *b.handle
+                && (a.start != b.start || a.stride != b.stride))
+              return false;
+          }
+
+        // scalars computed within the group are only available after the loop:
+        if (other.scalar_target)
+          for (std::size_t j=0; j<fs.scalar_reads.size(); ++j)
+            if (*fs.scalar_reads[j] == other.scalar_target->handle())
+              return false;
+      }
+
+      return true;
+    }
+
+    fused_group() : num_reductions_(0), slot_offsets_(1, 0) {}
+
+    void push_back(fused_statement<NumericT> const & fs)
+    {
+      statements_.push_back(fs);
+      slot_offsets_.push_back(slot_offsets_.back() + fs.slots.size());
+      reduction_ids_.push_back(fs.scalar_target ? num_reductions_++ : 0);
+    }
+
+    bool empty() const { return statements_.empty(); }
+
+    void clear()
+    {
+      statements_.clear();
+      num_reductions_ = 0;
+      slot_offsets_.resize(1);
+      reduction_ids_.clear();
+    }
+
+    /** @brief Runs all statements of the group within a single loop. Device scalars are read at each run, hence the group can be run repeatedly. */
+    void run()
+    {
+      if (statements_.empty())
+        return;
+
+      for (std::size_t i=0; i<statements_.size(); ++i)
+        for (std::size_t j=0; j<statements_[i].slots.size(); ++j)
+          if (statements_[i].slots[j].scalar)
+            statements_[i].slots[j].value = NumericT(*statements_[i].slots[j].scalar);
+
+      vcl_size_t const block_size = VIENNACL_FUSED_BLOCK_SIZE;
+      vcl_size_t size       = statements_[0].size;
+      vcl_size_t num_blocks = (size + block_size - 1) / block_size;
+      vcl_size_t num_slots  = slot_offsets_.back();
+
+      vcl_size_t max_threads = 1;
+#ifdef VIENNACL_WITH_OPENMP
+      if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+        max_threads = std::min(static_cast<vcl_size_t>(omp_get_max_threads()), num_blocks);
+#endif
+
+      // buffers are kept for subsequent runs:
+      buffer_.resize(max_threads * num_slots * block_size);
+      operands_.resize(max_threads * num_slots);
+      partial_results_.resize(max_threads * num_reductions_);
+      for (std::size_t i=0; i<statements_.size(); ++i)
+        if (statements_[i].scalar_target)
+          for (vcl_size_t t = 0; t < max_threads; ++t)
+            partial_results_[t * num_reductions_ + reduction_ids_[i]] = initial_reduction_value(statements_[i].reduction_type);
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel num_threads(static_cast<int>(max_threads)) if (max_threads > 1)
+#endif
+      {
+        vcl_size_t id = 0, nt = 1;
+#ifdef VIENNACL_WITH_OPENMP
+        id = static_cast<vcl_size_t>(omp_get_thread_num());
+        nt = static_cast<vcl_size_t>(omp_get_num_threads());
+#endif
+        NumericT        * buffer      = &buffer_[id * num_slots * block_size];
+        NumericT const ** operands    = &operands_[id * num_slots];
+        NumericT        * my_results  = num_reductions_ > 0 ? &partial_results_[id * num_reductions_] : NULL;
+
+        // constants are broadcast once:
+        for (std::size_t i=0; i<statements_.size(); ++i)
+          for (std::size_t j=0; j<statements_[i].slots.size(); ++j)
+            if (statements_[i].slots[j].kind == slot_type::CONSTANT_SLOT)
+              std::fill(buffer + (slot_offsets_[i] + j) * block_size, buffer + (slot_offsets_[i] + j + 1) * block_size, statements_[i].slots[j].value);
+
+        for (vcl_size_t block = (num_blocks * id) / nt; block < (num_blocks * (id + 1)) / nt; ++block)
+        {
+          vcl_size_t i0 = block * block_size;
+          vcl_size_t n  = std::min(block_size, size - i0);
+
+          for (std::size_t i=0; i<statements_.size(); ++i)
+          {
+            fused_statement<NumericT> const & fs = statements_[i];
+            NumericT         * my_buffer   = buffer + slot_offsets_[i] * block_size;
+            NumericT const  ** my_operands = operands + slot_offsets_[i];
+
+            // vectors are read after the previous statements wrote their entries of the block:
+            for (std::size_t j=0; j<fs.slots.size(); ++j)
+            {
+              slot_type const & slot = fs.slots[j];
+              NumericT * slot_buffer = my_buffer + j * block_size;
+              if (slot.kind == slot_type::VECTOR_SLOT)
+              {
+                if (slot.stride == 1)
+                  my_operands[j] = slot.data + slot.start + i0;
+                else
+                {
+                  for (vcl_size_t k = 0; k < n; ++k)
+                    slot_buffer[k] = slot.data[slot.start + (i0 + k) * slot.stride];
+                  my_operands[j] = slot_buffer;
+                }
+              }
+              else
+                my_operands[j] = slot_buffer;
+            }
+
+            for (std::size_t j=0; j<fs.code.size(); ++j)
+            {
+              fused_instruction const & instr = fs.code[j];
+              fused_apply(instr.op, my_operands[instr.lhs], my_operands[instr.rhs], my_buffer + instr.result * block_size, n);
+            }
+
+            NumericT const * values = my_operands[fs.result_slot];
+            if (fs.vector_target)
+              store(fs, values, i0, n);
+            else
+            {
+              NumericT & result = my_results[reduction_ids_[i]];
+              result = reduce(fs.reduction_type, result, values, my_operands[fs.result_slot2], n);
+            }
+          }
+        }
+      }
+
+      // combine partial results and write scalars:
+      for (std::size_t i=0; i<statements_.size(); ++i)
+      {
+        fused_statement<NumericT> const & fs = statements_[i];
+        if (!fs.scalar_target)
+          continue;
+
+        NumericT result = initial_reduction_value(fs.reduction_type);
+        for (vcl_size_t t = 0; t < max_threads; ++t)
+          result = combine(fs.reduction_type, result, partial_results_[t * num_reductions_ + reduction_ids_[i]]);
+        if (fs.reduction_type == OPERATION_UNARY_NORM_2_TYPE)
+          result = std::sqrt(result);
+
+        if (fs.assign_type == OPERATION_BINARY_INPLACE_ADD_TYPE)
+          result = NumericT(*fs.scalar_target) + result;
+        else if (fs.assign_type == OPERATION_BINARY_INPLACE_SUB_TYPE)
+          result = NumericT(*fs.scalar_target) - result;
+        *fs.scalar_target = result;
+      }
+    }
+
+  private:
+    static vcl_size_t add_slot(fused_statement<NumericT> & fs, slot_type const & slot)
+    {
+      fs.slots.push_back(slot);
+      return fs.slots.size() - 1;
+    }
+
+    /** @brief Compiles an operand (vector, scalar, or elementwise expression) and returns the slot holding its entries */
+    static bool compile_operand(statement const & s, lhs_rhs_element const & elem, fused_statement<NumericT> & fs, vcl_size_t & result_slot)
+    {
+      if (elem.type_family != COMPOSITE_OPERATION_FAMILY && elem.numeric_type != statement_node_numeric_type(result_of::numeric_type_id<NumericT>::value))
+        return false;
+
+      if (elem.type_family == VECTOR_TYPE_FAMILY && elem.subtype == DENSE_VECTOR_TYPE)
+      {
+        viennacl::vector_base<NumericT> const * vec = access_type::vector(elem);
+        if (viennacl::traits::active_handle_id(*vec) != viennacl::MAIN_MEMORY)
+          return false;
+        if (fs.size == 0)
+          fs.size = vec->size();
+        if (vec->size() != fs.size)
+          return false;
+
+        slot_type slot(slot_type::VECTOR_SLOT);
+        slot.data   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(vec->handle());
+        slot.start  = vec->start();
+        slot.stride = vec->stride();
+        result_slot = add_slot(fs, slot);
+
+        fused_access a;
+        a.handle = &vec->handle();
+        a.start  = vec->start();
+        a.stride = vec->stride();
+        a.is_write = false;
+        fs.vector_accesses.push_back(a);
+        return true;
+      }
+      else if (elem.type_family == SCALAR_TYPE_FAMILY && elem.subtype == HOST_SCALAR_TYPE)
+      {
+        slot_type slot(slot_type::CONSTANT_SLOT);
+        slot.value  = access_type::host_scalar(elem);
+        result_slot = add_slot(fs, slot);
+        return true;
+      }
+      else if (elem.type_family == SCALAR_TYPE_FAMILY && elem.subtype == DEVICE_SCALAR_TYPE)
+      {
+        viennacl::scalar<NumericT> const * alpha = access_type::scalar(elem);
+        slot_type slot(slot_type::CONSTANT_SLOT);
+        slot.value  = NumericT(*alpha);
+        slot.scalar = alpha;
+        result_slot = add_slot(fs, slot);
+        fs.scalar_reads.push_back(&alpha->handle());
+        return true;
+      }
+      else if (elem.type_family == COMPOSITE_OPERATION_FAMILY)
+      {
+        statement_node const & node = s.array()[elem.node_index];
+
+        // identical subexpressions are computed only once:
+        for (std::size_t i=0; i<fs.code.size(); ++i)
+          if (fused_equal(s, elem, fs.code[i].expression))
+          {
+            result_slot = fs.code[i].result;
+            return true;
+          }
+
+        fused_instruction instr;
+        instr.expression = elem;
+        instr.op = node.op.type;
+        if (node.op.type_family == OPERATION_UNARY_TYPE_FAMILY && fused_is_unary(node.op.type))
+        {
+          if (!compile_operand(s, node.lhs, fs, instr.lhs))
+            return false;
+          instr.rhs = instr.lhs;
+        }
+        else if (node.op.type_family == OPERATION_BINARY_TYPE_FAMILY && fused_is_binary(node.op.type))
+        {
+          if (!compile_operand(s, node.lhs, fs, instr.lhs) || !compile_operand(s, node.rhs, fs, instr.rhs))
+            return false;
+        }
+        else
+          return false;
+
+        instr.result = add_slot(fs, slot_type(slot_type::TEMPORARY_SLOT));
+        fs.code.push_back(instr);
+        result_slot = instr.result;
+        return true;
+      }
+
+      return false;
+    }
+
+    /** @brief Writes the entries [i0, i0 + n) of the vector target of a statement */
+    static void store(fused_statement<NumericT> const & fs, NumericT const * values, vcl_size_t i0, vcl_size_t n)
+    {
+      NumericT * data   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(fs.vector_target->handle());
+      vcl_size_t stride = fs.vector_target->stride();
+      NumericT alpha    = (fs.scale_slot < fs.slots.size()) ? fs.slots[fs.scale_slot].value : NumericT(1);
+      data += fs.vector_target->start() + i0 * stride;
+
+      if (stride == 1)
+      {
+        if (fs.assign_type == OPERATION_BINARY_INPLACE_ADD_TYPE)
+          for (vcl_size_t k = 0; k < n; ++k)
+            data[k] += values[k] * alpha;
+        else if (fs.assign_type == OPERATION_BINARY_INPLACE_SUB_TYPE)
+          for (vcl_size_t k = 0; k < n; ++k)
+            data[k] -= values[k] * alpha;
+        else
+          for (vcl_size_t k = 0; k < n; ++k)
+            data[k] = values[k] * alpha;
+      }
+      else
+      {
+        if (fs.assign_type == OPERATION_BINARY_INPLACE_ADD_TYPE)
+          for (vcl_size_t k = 0; k < n; ++k)
+            data[k * stride] += values[k] * alpha;
+        else if (fs.assign_type == OPERATION_BINARY_INPLACE_SUB_TYPE)
+          for (vcl_size_t k = 0; k < n; ++k)
+            data[k * stride] -= values[k] * alpha;
+        else
+          for (vcl_size_t k = 0; k < n; ++k)
+            data[k * stride] = values[k] * alpha;
+      }
+    }
+
+    static NumericT initial_reduction_value(operation_node_type op)
+    {
+      if (op == OPERATION_UNARY_MAX_TYPE)
+        return -std::numeric_limits<NumericT>::max();
+      if (op == OPERATION_UNARY_MIN_TYPE)
+        return std::numeric_limits<NumericT>::max();
+      return NumericT(0);
+    }
+
+    static NumericT combine(operation_node_type op, NumericT a, NumericT b)
+    {
+      switch (op)
+      {
+      case OPERATION_UNARY_NORM_INF_TYPE:
+      case OPERATION_UNARY_MAX_TYPE:      return std::max(a, b);
+      case OPERATION_UNARY_MIN_TYPE:      return std::min(a, b);
+      default:                            return a + b;
+      }
+    }
+
+    /** @brief Accumulates the reduction over n entries */
+    static NumericT reduce(operation_node_type op, NumericT result, NumericT const * a, NumericT const * b, vcl_size_t n)
+    {
+      NumericT temp = 0;
+      switch (op)
+      {
+      case OPERATION_BINARY_INNER_PROD_TYPE: for (vcl_size_t k = 0; k < n; ++k) temp += a[k] * b[k];      return result + temp;
+      case OPERATION_UNARY_NORM_1_TYPE:      for (vcl_size_t k = 0; k < n; ++k) temp += std::fabs(a[k]);  return result + temp;
+      case OPERATION_UNARY_NORM_2_TYPE:      for (vcl_size_t k = 0; k < n; ++k) temp += a[k] * a[k];      return result + temp;
+      case OPERATION_UNARY_NORM_INF_TYPE:    for (vcl_size_t k = 0; k < n; ++k) result = std::max(result, std::fabs(a[k])); return result;
+      case OPERATION_UNARY_MAX_TYPE:         for (vcl_size_t k = 0; k < n; ++k) result = std::max(result, a[k]); return result;
+      case OPERATION_UNARY_MIN_TYPE:         for (vcl_size_t k = 0; k < n; ++k) result = std::min(result, a[k]); return result;
+      default:
+        throw statement_not_supported_exception("Reduction not supported by the fused executor");
+      }
+    }
+
+    std::vector<fused_statement<NumericT> > statements_;
+    vcl_size_t                              num_reductions_;
+    std::vector<vcl_size_t>                 slot_offsets_;     // offsets of the slots of each statement in the per-thread buffer
+    std::vector<vcl_size_t>                 reduction_ids_;
+
+    std::vector<NumericT>                   buffer_;
+    std::vector<NumericT const *>           operands_;
+    std::vector<NumericT>                   partial_results_;
+  };
+
+
+  /** @brief A pool of temporary vectors and scalars in main memory. Temporaries are handed out until release() is called and are then reused. */
+  template<typename NumericT>
+  class fused_temporaries
+  {
+    typedef tools::shared_ptr<viennacl::vector<NumericT> >  vector_pointer;
+    typedef tools::shared_ptr<viennacl::scalar<NumericT> >  scalar_pointer;
+
+  public:
+    fused_temporaries() : num_used_vectors_(0), num_used_scalars_(0) {}
+
+    viennacl::vector<NumericT> & vector(vcl_size_t size)
+    {
+      for (std::size_t i=num_used_vectors_; i<vectors_.size(); ++i)
+        if (vectors_[i]->size() == size)
+        {
+          std::swap(vectors_[i], vectors_[num_used_vectors_]);
+          return *vectors_[num_used_vectors_++];
+        }
+
+      vectors_.push_back(vector_pointer(new viennacl::vector<NumericT>(size, viennacl::context(viennacl::MAIN_MEMORY))));
+      std::swap(vectors_.back(), vectors_[num_used_vectors_]);
+      return *vectors_[num_used_vectors_++];
+    }
+
+    viennacl::scalar<NumericT> & scalar()
+    {
+      if (num_used_scalars_ == scalars_.size())
+        scalars_.push_back(scalar_pointer(new viennacl::scalar<NumericT>(0, viennacl::context(viennacl::MAIN_MEMORY))));
+      return *scalars_[num_used_scalars_++];
+    }
+
+    void release()
+    {
+      num_used_vectors_ = 0;
+      num_used_scalars_ = 0;
+    }
+
+    /** @brief Returns the number of temporary vectors and scalars allocated by the pool */
+    std::size_t size() const { return vectors_.size() + scalars_.size(); }
+
+    void clear()
+    {
+      release();
+      vectors_.clear();
+      scalars_.clear();
+    }
+
+  private:
+    std::vector<vector_pointer> vectors_;
+    std::vector<scalar_pointer> scalars_;
+    std::size_t num_used_vectors_;
+    std::size_t num_used_scalars_;
+  };
+
+
+  /** @brief Replaces the operands of elementwise operations which are neither elementwise nor plain objects (e.g. prod(A, x) or inner_prod(x, y)) by temporaries.
+  *
+  * The statements computing the temporaries are appended to 'result', followed by the remaining elementwise statement.
+  * Identical subexpressions are assigned to the same temporary.
+  */
+  template<typename NumericT>
+  class fused_lowering
+  {
+    typedef fused_element_access<NumericT>  access_type;
+
+  public:
+    fused_lowering(statement const & s, fused_temporaries<NumericT> & temporaries, std::vector<statement> & result)
+      : s_(s), array_(s.array()), temporaries_(temporaries), result_(result), size_(0) {}
+
+    void apply()
+    {
+      statement_node const & root = s_.array()[s_.root()];
+
+      bool is_host_vector_statement =    root.lhs.type_family == VECTOR_TYPE_FAMILY && root.lhs.subtype == DENSE_VECTOR_TYPE
+                                      && root.rhs.type_family == COMPOSITE_OPERATION_FAMILY
+                                      && viennacl::traits::active_handle_id(*access_type::vector(root.lhs)) == viennacl::MAIN_MEMORY;
+      if (is_host_vector_statement && is_elementwise(s_.array()[root.rhs.node_index]))
+      {
+        size_ = access_type::vector(root.lhs)->size();
+        lower_node(root.rhs.node_index);
+      }
+
+      if (lowered_.empty())
+        result_.push_back(s_);
+      else
+        result_.push_back(statement(array_));
+    }
+
+  private:
+    static bool is_elementwise(statement_node const & node)
+    {
+      return (node.op.type_family == OPERATION_UNARY_TYPE_FAMILY  && fused_is_unary(node.op.type))
+          || (node.op.type_family == OPERATION_BINARY_TYPE_FAMILY && fused_is_binary(node.op.type));
+    }
+
+    void lower_node(vcl_size_t node_index)
+    {
+      lower_operand(array_[node_index].lhs);
+      if (array_[node_index].op.type_family == OPERATION_BINARY_TYPE_FAMILY)
+        lower_operand(array_[node_index].rhs);
+    }
+
+    void lower_operand(lhs_rhs_element & elem)
+    {
+      if (elem.type_family != COMPOSITE_OPERATION_FAMILY)
+        return;
+
+      statement_node const & node = s_.array()[elem.node_index];
+      if (is_elementwise(node))
+      {
+        lower_node(elem.node_index);
+        return;
+      }
+
+      for (std::size_t i=0; i<lowered_.size(); ++i)
+        if (fused_equal(s_, elem, lowered_[i].first))
+        {
+          elem = lowered_[i].second;
+          return;
+        }
+
+      lhs_rhs_element temp;
+      temp.numeric_type = statement_node_numeric_type(result_of::numeric_type_id<NumericT>::value);
+      if (fused_is_reduction(node.op.type))
+      {
+        temp.type_family = SCALAR_TYPE_FAMILY;
+        temp.subtype     = DEVICE_SCALAR_TYPE;
+        statement::assign_element(temp, temporaries_.scalar());
+      }
+      else
+      {
+        temp.type_family = VECTOR_TYPE_FAMILY;
+        temp.subtype     = DENSE_VECTOR_TYPE;
+        statement::assign_element(temp, static_cast<viennacl::vector_base<NumericT> const &>(temporaries_.vector(size_)));
+      }
+
+      // temp = subexpression:
+      statement::container_type array = s_.array();
+      array[s_.root()].lhs = temp;
+      array[s_.root()].op.type_family = OPERATION_BINARY_TYPE_FAMILY;
+      array[s_.root()].op.type        = OPERATION_BINARY_ASSIGN_TYPE;
+      array[s_.root()].rhs = elem;
+      result_.push_back(statement(array));
+
+      lowered_.push_back(std::make_pair(elem, temp));
+      elem = temp;
+    }
+
+    statement const & s_;
+    statement::container_type array_;
+    fused_temporaries<NumericT> & temporaries_;
+    std::vector<statement> & result_;
+    vcl_size_t size_;
+    std::vector<std::pair<lhs_rhs_element, lhs_rhs_element> > lowered_;
+  };
+
+
+  /** @brief A sequence of statements compiled into fused groups and statements which cannot be fused, ready to be run (repeatedly).
+  *
+  * Subexpressions such as prod(A, x) within elementwise expressions are computed into temporaries first, cf. fused_lowering.
+  * The temporaries are owned by the program and are reused by subsequent statements.
+  */
+  class fused_program
+  {
+    enum step_type { FLOAT_GROUP, DOUBLE_GROUP, UNFUSED_STATEMENT };
+    typedef std::pair<step_type, std::size_t>  step;
+
+  public:
+    /** @brief Appends a statement to the last group if it depends on the group only elementwise, otherwise starts a new group */
+    void push_back(statement const & s)
+    {
+      statement_node_numeric_type numeric_type = s.array()[s.root()].lhs.numeric_type;
+
+      if (numeric_type == FLOAT_TYPE)
+        push_back(s, float_groups_, float_temporaries_, FLOAT_GROUP);
+      else if (numeric_type == DOUBLE_TYPE)
+        push_back(s, double_groups_, double_temporaries_, DOUBLE_GROUP);
+      else
+        push_back_unfused(s);
+    }
+
+    /** @brief Runs all statements in the order they were appended */
+    void run()
+    {
+      for (std::size_t i=0; i<steps_.size(); ++i)
+      {
+        switch (steps_[i].first)
+        {
+        case FLOAT_GROUP:  float_groups_[steps_[i].second].run();  break;
+        case DOUBLE_GROUP: double_groups_[steps_[i].second].run(); break;
+        default:           scheduler::execute(statements_[steps_[i].second]); break;
+        }
+      }
+    }
+
+    /** @brief Returns the number of steps run one after another, i.e. the number of fused groups plus the number of statements which cannot be fused */
+    std::size_t num_steps() const { return steps_.size(); }
+
+    /** @brief Returns the number of temporaries allocated for subexpressions which are not elementwise, cf. fused_lowering */
+    std::size_t num_temporaries() const { return float_temporaries_.size() + double_temporaries_.size(); }
+
+    void clear()
+    {
+      steps_.clear();
+      float_groups_.clear();
+      double_groups_.clear();
+      statements_.clear();
+      float_temporaries_.clear();
+      double_temporaries_.clear();
+    }
+
+  private:
+    template<typename NumericT>
+    void push_back(statement const & s, std::vector<fused_group<NumericT> > & groups, fused_temporaries<NumericT> & temporaries, step_type type)
+    {
+      std::vector<statement> lowered;
+      fused_lowering<NumericT>(s, temporaries, lowered).apply();
+
+      for (std::size_t i=0; i<lowered.size(); ++i)
+        if (!append(lowered[i], groups, type))
+          push_back_unfused(lowered[i]);
+
+      // temporaries are no longer needed by subsequent statements:
+      temporaries.release();
+    }
+
+    void push_back_unfused(statement const & s)
+    {
+      steps_.push_back(step(UNFUSED_STATEMENT, statements_.size()));
+      statements_.push_back(s);
+    }
+
+    template<typename NumericT>
+    bool append(statement const & s, std::vector<fused_group<NumericT> > & groups, step_type type)
+    {
+      fused_statement<NumericT> fs;
+      if (!fused_group<NumericT>::compile(s, fs))
+        return false;
+
+      if (steps_.empty() || steps_.back().first != type || !groups.back().is_compatible(fs))
+      {
+        steps_.push_back(step(type, groups.size()));
+        groups.push_back(fused_group<NumericT>());
+      }
+      groups.back().push_back(fs);
+      return true;
+    }
+
+    std::vector<step>                 steps_;
+    std::vector<fused_group<float> >  float_groups_;
+    std::vector<fused_group<double> > double_groups_;
+    std::vector<statement>            statements_;
+    fused_temporaries<float>          float_temporaries_;
+    fused_temporaries<double>         double_temporaries_;
+  };
+
+} // namespace detail
+
+
+/** @brief Executes a group of statements. Results are the same as for executing the statements one after another.
+*
+* Statements operating on vectors in main memory (elementwise vector updates such as x += a*p as well as reductions such as inner_prod(r,r) or norm_2(r))
+* are fused into a single blocked loop over the vector entries as long as they depend on each other only elementwise.
+* Other statements are passed on to execute(statement const &).
+*/
+inline void execute(device_specific::statements_container const & statements)
+{
+  detail::fused_program program;
+
+  typedef device_specific::statements_container::data_type::const_iterator iterator_type;
+  for (iterator_type it = statements.data().begin(); it != statements.data().end(); ++it)
+    program.push_back(*it);
+
+  program.run();
+}
+
+} // namespace scheduler
+} // namespace viennacl
+
+#endif
@@ -33,6 +33,7 @@
 #include "viennacl/compressed_matrix.hpp"
 #include "viennacl/coordinate_matrix.hpp"
 #include "viennacl/ell_matrix.hpp"
+#include "viennacl/sliced_ell_matrix.hpp"
 #include "viennacl/hyb_matrix.hpp"
 
 namespace viennacl
@@ -274,6 +275,20 @@ namespace detail
         throw statement_not_supported_exception("Invalid numeric type in matrix-{matrix,vector} multiplication");
       }
     }
+    else if (A.subtype == SLICED_ELL_MATRIX_TYPE)
+    {
+      switch (A.numeric_type)
+      {
+      case FLOAT_TYPE:
+        viennacl::linalg::prod_impl(*A.sliced_ell_matrix_float, *x.vector_float, *result.vector_float);
+        break;
+      case DOUBLE_TYPE:
+        viennacl::linalg::prod_impl(*A.sliced_ell_matrix_double, *x.vector_double, *result.vector_double);
+        break;
+      default:
+        throw statement_not_supported_exception("Invalid numeric type in matrix-{matrix,vector} multiplication");
+      }
+    }
     else if (A.subtype == HYB_MATRIX_TYPE)
     {
       switch (A.numeric_type)
@@ -295,6 +310,49 @@ namespace detail
     }
   }
 
+  /** @brief Computes result += alpha * A * x for sparse matrices A within a single fused kernel. Returns false if A is not a sparse matrix, if x is not a dense vector, or if result and x share the same buffer. */
+  inline bool sparse_matrix_vector_prod_axpby(lhs_rhs_element result,
+                                              lhs_rhs_element const & A,
+                                              lhs_rhs_element const & x,
+                                              double alpha)
+  {
+    if (A.type_family != MATRIX_TYPE_FAMILY || x.type_family != VECTOR_TYPE_FAMILY || x.subtype != DENSE_VECTOR_TYPE || result.subtype != DENSE_VECTOR_TYPE)
+      return false;
+
+    if (A.numeric_type == FLOAT_TYPE)
+    {
+      if (result.vector_float->handle() == x.vector_float->handle())
+        return false;
+
+      float a = static_cast<float>(alpha);
+      switch (A.subtype)
+      {
+      case COMPRESSED_MATRIX_TYPE: viennacl::linalg::prod_impl(*A.compressed_matrix_float, *x.vector_float, *result.vector_float, a, 1.0f); return true;
+      case COORDINATE_MATRIX_TYPE: viennacl::linalg::prod_impl(*A.coordinate_matrix_float, *x.vector_float, *result.vector_float, a, 1.0f); return true;
+      case ELL_MATRIX_TYPE:        viennacl::linalg::prod_impl(*A.ell_matrix_float,        *x.vector_float, *result.vector_float, a, 1.0f); return true;
+      case SLICED_ELL_MATRIX_TYPE: viennacl::linalg::prod_impl(*A.sliced_ell_matrix_float, *x.vector_float, *result.vector_float, a, 1.0f); return true;
+      case HYB_MATRIX_TYPE:        viennacl::linalg::prod_impl(*A.hyb_matrix_float,        *x.vector_float, *result.vector_float, a, 1.0f); return true;
+      default: return false;
+      }
+    }
+    else if (A.numeric_type == DOUBLE_TYPE)
+    {
+      if (result.vector_double->handle() == x.vector_double->handle())
+        return false;
+
+      switch (A.subtype)
+      {
+      case COMPRESSED_MATRIX_TYPE: viennacl::linalg::prod_impl(*A.compressed_matrix_double, *x.vector_double, *result.vector_double, alpha, 1.0); return true;
+      case COORDINATE_MATRIX_TYPE: viennacl::linalg::prod_impl(*A.coordinate_matrix_double, *x.vector_double, *result.vector_double, alpha, 1.0); return true;
+      case ELL_MATRIX_TYPE:        viennacl::linalg::prod_impl(*A.ell_matrix_double,        *x.vector_double, *result.vector_double, alpha, 1.0); return true;
+      case SLICED_ELL_MATRIX_TYPE: viennacl::linalg::prod_impl(*A.sliced_ell_matrix_double, *x.vector_double, *result.vector_double, alpha, 1.0); return true;
+      case HYB_MATRIX_TYPE:        viennacl::linalg::prod_impl(*A.hyb_matrix_double,        *x.vector_double, *result.vector_double, alpha, 1.0); return true;
+      default: return false;
+      }
+    }
+    return false;
+  }
+
 } // namespace detail
 
 inline void execute_matrix_prod(statement const & s, statement_node const & root_node)
@@ -356,14 +414,6 @@ inline void execute_matrix_prod(statement const & s, statement_node const & root
   {
     if (root_node.op.type != OPERATION_BINARY_ASSIGN_TYPE)
     {
-      //split y += A*x
-      statement_node new_root_z;
-      detail::new_element(new_root_z.lhs, root_node.lhs, ctx);
-
-      // compute z = A * x
-      detail::matrix_vector_prod(s, new_root_z.lhs, x, y);
-
-      // assignment y = z
       double alpha = 0;
       if (root_node.op.type == OPERATION_BINARY_INPLACE_ADD_TYPE)
         alpha = 1.0;
@@ -372,12 +422,24 @@ inline void execute_matrix_prod(statement const & s, statement_node const & root
       else
         throw statement_not_supported_exception("Invalid assignment type for matrix-vector product");
 
-      lhs_rhs_element y2 = root_node.lhs;
-      detail::axbx(y2,
-                   y2, 1.0, 1, false, false,
-                   new_root_z.lhs, alpha, 1, false, false);
+      // sparse matrices: y += alpha * A * x in a single pass
+      if (!detail::sparse_matrix_vector_prod_axpby(root_node.lhs, x, y, alpha))
+      {
+        //split y += A*x
+        statement_node new_root_z;
+        detail::new_element(new_root_z.lhs, root_node.lhs, ctx);
+
+        // compute z = A * x
+        detail::matrix_vector_prod(s, new_root_z.lhs, x, y);
 
-      detail::delete_element(new_root_z.lhs);
+        // assignment y = z
+        lhs_rhs_element y2 = root_node.lhs;
+        detail::axbx(y2,
+                     y2, 1.0, 1, false, false,
+                     new_root_z.lhs, alpha, 1, false, false);
+
+        detail::delete_element(new_root_z.lhs);
+      }
     }
     else
       detail::matrix_vector_prod(s, root_node.lhs, x, y);
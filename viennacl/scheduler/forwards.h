@@ -279,6 +279,7 @@ enum statement_node_subtype
   COMPRESSED_MATRIX_TYPE,
   COORDINATE_MATRIX_TYPE,
   ELL_MATRIX_TYPE,
+  SLICED_ELL_MATRIX_TYPE,
   HYB_MATRIX_TYPE
 
   // other matrix types to be added here
@@ -455,6 +456,9 @@ struct lhs_rhs_element
     viennacl::ell_matrix<float>    *ell_matrix_float;
     viennacl::ell_matrix<double>   *ell_matrix_double;
 
+    viennacl::sliced_ell_matrix<float>    *sliced_ell_matrix_float;
+    viennacl::sliced_ell_matrix<double>   *sliced_ell_matrix_double;
+
     //viennacl::hyb_matrix<float>    *hyb_matrix_char;
     //viennacl::hyb_matrix<double>   *hyb_matrix_uchar;
     //viennacl::hyb_matrix<float>    *hyb_matrix_short;
@@ -612,6 +616,9 @@ public:
   static void assign_element(lhs_rhs_element & elem, viennacl::ell_matrix<float>  const & m) { elem.ell_matrix_float  = const_cast<viennacl::ell_matrix<float>  *>(&m); }
   static void assign_element(lhs_rhs_element & elem, viennacl::ell_matrix<double> const & m) { elem.ell_matrix_double = const_cast<viennacl::ell_matrix<double> *>(&m); }
 
+  static void assign_element(lhs_rhs_element & elem, viennacl::sliced_ell_matrix<float>  const & m) { elem.sliced_ell_matrix_float  = const_cast<viennacl::sliced_ell_matrix<float>  *>(&m); }
+  static void assign_element(lhs_rhs_element & elem, viennacl::sliced_ell_matrix<double> const & m) { elem.sliced_ell_matrix_double = const_cast<viennacl::sliced_ell_matrix<double> *>(&m); }
+
   static void assign_element(lhs_rhs_element & elem, viennacl::hyb_matrix<float>  const & m) { elem.hyb_matrix_float  = const_cast<viennacl::hyb_matrix<float>  *>(&m); }
   static void assign_element(lhs_rhs_element & elem, viennacl::hyb_matrix<double> const & m) { elem.hyb_matrix_double = const_cast<viennacl::hyb_matrix<double> *>(&m); }
 
@@ -727,6 +734,18 @@ public:
     return next_free;
   }
 
+  template<typename T>
+  static vcl_size_t add_element(vcl_size_t next_free,
+                                lhs_rhs_element            & elem,
+                                viennacl::sliced_ell_matrix<T> const & t)
+  {
+    elem.type_family  = MATRIX_TYPE_FAMILY;
+    elem.subtype      = SLICED_ELL_MATRIX_TYPE;
+    elem.numeric_type = statement_node_numeric_type(result_of::numeric_type_id<T>::value);
+    assign_element(elem, t);
+    return next_free;
+  }
+
   template<typename T>
   static vcl_size_t add_element(vcl_size_t next_free,
                                 lhs_rhs_element            & elem,
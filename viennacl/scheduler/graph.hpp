@@ -0,0 +1,271 @@
+#ifndef VIENNACL_SCHEDULER_GRAPH_HPP
+#define VIENNACL_SCHEDULER_GRAPH_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+/** @file viennacl/scheduler/graph.hpp
+    @brief A sequence of operations recorded once and replayed repeatedly, e.g. within each iteration of an iterative solver.
+*/
+
+#include <vector>
+
+#include "viennacl/forwards.h"
+#include "viennacl/scalar.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/scheduler/forwards.h"
+#include "viennacl/scheduler/execute.hpp"
+#include "viennacl/scheduler/execute_fused.hpp"
+
+namespace viennacl
+{
+namespace scheduler
+{
+namespace detail
+{
+  /** @brief Replaces the vector 'old_vector' by 'new_vector' in an operand of a statement. Returns true if the operand was changed. */
+  template<typename NumericT>
+  bool rebind_element(lhs_rhs_element & elem, viennacl::vector_base<NumericT> const & old_vector, viennacl::vector_base<NumericT> const & new_vector)
+  {
+    if (   elem.type_family == VECTOR_TYPE_FAMILY && elem.subtype == DENSE_VECTOR_TYPE
+        && elem.numeric_type == statement_node_numeric_type(result_of::numeric_type_id<NumericT>::value)
+        && fused_element_access<NumericT>::vector(elem) == &old_vector)
+    {
+      statement::assign_element(elem, new_vector);
+      return true;
+    }
+    return false;
+  }
+
+  /** @brief Replaces the scalar 'old_scalar' by 'new_scalar' in an operand of a statement. Returns true if the operand was changed. */
+  template<typename NumericT>
+  bool rebind_element(lhs_rhs_element & elem, viennacl::scalar<NumericT> const & old_scalar, viennacl::scalar<NumericT> const & new_scalar)
+  {
+    if (   elem.type_family == SCALAR_TYPE_FAMILY && elem.subtype == DEVICE_SCALAR_TYPE
+        && elem.numeric_type == statement_node_numeric_type(result_of::numeric_type_id<NumericT>::value)
+        && fused_element_access<NumericT>::scalar(elem) == &old_scalar)
+    {
+      statement::assign_element(elem, new_scalar);
+      return true;
+    }
+    return false;
+  }
+
+  /** @brief Location and layout of a vector referenced by a recorded operation at the time of compilation. Used for detecting vectors which were resized or swapped since. */
+  struct graph_vector_binding
+  {
+    graph_vector_binding() : vector(NULL), data(NULL), size(0), start(0), stride(0) {}
+
+    void const * vector;
+    char const * data;     // buffer in main memory, NULL for other memory domains
+    vcl_size_t   size;
+    vcl_size_t   start;
+    vcl_size_t   stride;
+
+    bool operator==(graph_vector_binding const & other) const
+    {
+      return vector == other.vector && data == other.data && size == other.size && start == other.start && stride == other.stride;
+    }
+  };
+
+  template<typename NumericT>
+  graph_vector_binding vector_binding(viennacl::vector_base<NumericT> const & v)
+  {
+    graph_vector_binding b;
+    b.vector = &v;
+    b.data   = (v.handle().get_active_handle_id() == viennacl::MAIN_MEMORY) ? v.handle().ram_handle().get() : NULL;
+    b.size   = v.size();
+    b.start  = v.start();
+    b.stride = v.stride();
+    return b;
+  }
+
+  /** @brief Returns true and the binding if the operand is a vector of a numeric type supported by operation_graph */
+  inline bool vector_binding(lhs_rhs_element const & elem, graph_vector_binding & b)
+  {
+    if (elem.type_family != VECTOR_TYPE_FAMILY || elem.subtype != DENSE_VECTOR_TYPE)
+      return false;
+
+    switch (elem.numeric_type)
+    {
+    case FLOAT_TYPE:  b = vector_binding(*elem.vector_float);  return true;
+    case DOUBLE_TYPE: b = vector_binding(*elem.vector_double); return true;
+    default:          return false;
+    }
+  }
+}
+
+/** @brief A sequence of operations recorded once and executed repeatedly.
+*
+* Recording builds the statement trees once. The first execution (or compile()) determines which statements are fused into single loops over vectors in main memory,
+* cf. execute(device_specific::statements_container const &), and binds the memory buffers. Subsequent executions only run the loops.
+* Statements on OpenCL or CUDA memory are passed on to execute(statement const &) at each execution, saving the construction of the statements.
+*
+* The objects referenced by the recorded operations must stay alive while the graph is in use.
+* Each execution checks the sizes and buffers of the referenced vectors. If a vector was resized, assigned a new buffer, or swapped with another vector since the last compilation,
+* the operations are compiled again, hence the results always refer to the current state of the vectors.
+* The values of host scalars are captured at the time of recording. Use viennacl::scalar<> for coefficients which change between executions, as these are read at each execution.
+* Vectors and scalars can be replaced by other objects via rebind(), for example in order to swap the roles of two vectors after each iteration.
+*
+* Example:
+* @code
+* viennacl::scheduler::operation_graph update;
+* update.record(x,  viennacl::op_inplace_add(), alpha * p);
+* update.record(r,  viennacl::op_inplace_sub(), alpha * Ap);
+* update.record(rr, viennacl::op_assign(),      viennacl::linalg::inner_prod(r, r));
+* for (...)
+* {
+*   alpha = ...;        // alpha is a viennacl::scalar<>
+*   update.execute();
+* }
+* @endcode
+*/
+class operation_graph
+{
+public:
+  operation_graph() : compiled_(false) {}
+
+  /** @brief Records the operation 'lhs OP rhs', e.g. record(x, viennacl::op_inplace_add(), alpha * p) */
+  template<typename LHS, typename OP, typename RHS>
+  void record(LHS & lhs, OP const & op, RHS const & rhs)
+  {
+    record(statement(lhs, op, rhs));
+  }
+
+  /** @brief Records a statement */
+  void record(statement const & s)
+  {
+    statements_.push_back(s);
+    compiled_ = false;
+  }
+
+  /** @brief Replaces all occurrences of the vector 'old_vector' in the recorded operations by 'new_vector'. Returns the number of replaced operands. */
+  template<typename NumericT>
+  vcl_size_t rebind(viennacl::vector_base<NumericT> const & old_vector, viennacl::vector_base<NumericT> const & new_vector)
+  {
+    return rebind_impl(old_vector, new_vector);
+  }
+
+  /** @brief Replaces all occurrences of the scalar 'old_scalar' in the recorded operations by 'new_scalar'. Returns the number of replaced operands. */
+  template<typename NumericT>
+  vcl_size_t rebind(viennacl::scalar<NumericT> const & old_scalar, viennacl::scalar<NumericT> const & new_scalar)
+  {
+    return rebind_impl(old_scalar, new_scalar);
+  }
+
+  /** @brief Prepares the recorded operations for execution. Called by execute() if necessary. */
+  void compile()
+  {
+    program_.clear();
+    bindings_.clear();
+    for (std::size_t i=0; i<statements_.size(); ++i)
+    {
+      program_.push_back(statements_[i]);
+
+      statement::container_type const & array = statements_[i].array();
+      detail::graph_vector_binding b;
+      for (std::size_t j=0; j<array.size(); ++j)
+      {
+        if (detail::vector_binding(array[j].lhs, b))
+          bindings_.push_back(b);
+        if (detail::vector_binding(array[j].rhs, b))
+          bindings_.push_back(b);
+      }
+    }
+    compiled_ = true;
+  }
+
+  /** @brief Executes the recorded operations in the order of recording. Compiles the operations again if referenced vectors changed their size or buffer since the last compilation. */
+  void execute()
+  {
+    if (!compiled_ || !bindings_valid())
+      compile();
+    program_.run();
+  }
+
+  /** @brief Returns the number of recorded operations */
+  vcl_size_t size() const { return statements_.size(); }
+
+  /** @brief Removes all recorded operations */
+  void clear()
+  {
+    statements_.clear();
+    program_.clear();
+    bindings_.clear();
+    compiled_ = false;
+  }
+
+private:
+  /** @brief Returns true if all vectors referenced by the recorded operations have the size, layout and buffer they had at compilation */
+  bool bindings_valid() const
+  {
+    std::size_t k = 0;
+    detail::graph_vector_binding b;
+    for (std::size_t i=0; i<statements_.size(); ++i)
+    {
+      statement::container_type const & array = statements_[i].array();
+      for (std::size_t j=0; j<array.size(); ++j)
+      {
+        if (detail::vector_binding(array[j].lhs, b) && !(k < bindings_.size() && b == bindings_[k++]))
+          return false;
+        if (detail::vector_binding(array[j].rhs, b) && !(k < bindings_.size() && b == bindings_[k++]))
+          return false;
+      }
+    }
+    return k == bindings_.size();
+  }
+
+  template<typename OldT, typename NewT>
+  vcl_size_t rebind_impl(OldT const & old_object, NewT const & new_object)
+  {
+    vcl_size_t num_replaced = 0;
+    for (std::size_t i=0; i<statements_.size(); ++i)
+    {
+      statement::container_type array = statements_[i].array();
+      vcl_size_t num_replaced_in_statement = 0;
+      for (std::size_t j=0; j<array.size(); ++j)
+      {
+        if (detail::rebind_element(array[j].lhs, old_object, new_object))
+          ++num_replaced_in_statement;
+        if (detail::rebind_element(array[j].rhs, old_object, new_object))
+          ++num_replaced_in_statement;
+      }
+
+      if (num_replaced_in_statement > 0)
+      {
+        statements_[i] = statement(array);
+        num_replaced += num_replaced_in_statement;
+      }
+    }
+
+    if (num_replaced > 0)
+      compiled_ = false;
+    return num_replaced;
+  }
+
+  std::vector<statement>                     statements_;
+  std::vector<detail::graph_vector_binding>  bindings_;
+  detail::fused_program                      program_;
+  bool                                       compiled_;
+};
+
+} // namespace scheduler
+} // namespace viennacl
+
+#endif
+
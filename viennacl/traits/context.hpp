@@ -43,6 +43,8 @@ viennacl::context context(T const & t)
   if (traits::active_handle_id(t) == OPENCL_MEMORY)
     return viennacl::context(traits::opencl_handle(t).context());
 #endif
+  if (traits::active_handle_id(t) == MAIN_MEMORY && traits::ram_context(t))
+    return viennacl::context(*traits::ram_context(t));
 
   return viennacl::context(traits::active_handle_id(t));
 }
@@ -54,6 +56,8 @@ inline viennacl::context context(viennacl::backend::mem_handle const & h)
   if (h.get_active_handle_id() == OPENCL_MEMORY)
     return viennacl::context(h.opencl_handle().context());
 #endif
+  if (h.get_active_handle_id() == MAIN_MEMORY && h.ram_context())
+    return viennacl::context(*h.ram_context());
 
   return viennacl::context(h.get_active_handle_id());
 }
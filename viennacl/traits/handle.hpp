@@ -249,6 +249,52 @@ viennacl::memory_types active_handle_id(viennacl::matrix_expression<LHS, RHS, OP
 }
 /** \endcond */
 
+
+//
+// Host context
+//
+/** @brief Returns the host context of an object in main memory. NULL refers to the default host context. */
+template<typename T>
+viennacl::host_context const * ram_context(T const & obj)
+{
+  return handle(obj).ram_context();
+}
+
+/** \cond */
+template<typename T>
+viennacl::host_context const * ram_context(circulant_matrix<T> const &) { return NULL; }
+
+template<typename T>
+viennacl::host_context const * ram_context(hankel_matrix<T> const &) { return NULL; }
+
+template<typename T>
+viennacl::host_context const * ram_context(toeplitz_matrix<T> const &) { return NULL; }
+
+template<typename T>
+viennacl::host_context const * ram_context(vandermonde_matrix<T> const &) { return NULL; }
+
+template<typename LHS, typename RHS, typename OP>
+viennacl::host_context const * ram_context(viennacl::vector_expression<LHS, RHS, OP> const &);
+
+template<typename LHS, typename RHS, typename OP>
+viennacl::host_context const * ram_context(viennacl::scalar_expression<LHS, RHS, OP> const & obj)
+{
+  return ram_context(obj.lhs());
+}
+
+template<typename LHS, typename RHS, typename OP>
+viennacl::host_context const * ram_context(viennacl::vector_expression<LHS, RHS, OP> const & obj)
+{
+  return ram_context(obj.lhs());
+}
+
+template<typename LHS, typename RHS, typename OP>
+viennacl::host_context const * ram_context(viennacl::matrix_expression<LHS, RHS, OP> const & obj)
+{
+  return ram_context(obj.lhs());
+}
+/** \endcond */
+
 } //namespace traits
 } //namespace viennacl
 
@@ -2267,7 +2267,9 @@ namespace detail
       bool op_aliasing_lhs = op_aliasing(lhs, proxy.lhs());
       bool op_aliasing_rhs = op_aliasing(lhs, proxy.rhs());
 
-      if (op_aliasing_lhs || op_aliasing_rhs)
+      if (op_identical(lhs, proxy.lhs()) && !op_aliasing_rhs) // x = x + expr, e.g. y = y + prod(A, x)
+        op_executor<vector_base<T>, op_inplace_add, RHS>::apply(lhs, proxy.rhs());
+      else if (op_aliasing_lhs || op_aliasing_rhs)
       {
         vector_base<T> temp(proxy.lhs());
         op_executor<vector_base<T>, op_inplace_add, RHS>::apply(temp, proxy.rhs());
@@ -2631,7 +2633,9 @@ namespace detail
       bool op_aliasing_lhs = op_aliasing(lhs, proxy.lhs());
       bool op_aliasing_rhs = op_aliasing(lhs, proxy.rhs());
 
-      if (op_aliasing_lhs || op_aliasing_rhs)
+      if (op_identical(lhs, proxy.lhs()) && !op_aliasing_rhs) // x = x - expr, e.g. b = b - prod(A, x)
+        op_executor<vector_base<T>, op_inplace_sub, RHS>::apply(lhs, proxy.rhs());
+      else if (op_aliasing_lhs || op_aliasing_rhs)
       {
         vector_base<T> temp(proxy.lhs());
         op_executor<vector_base<T>, op_inplace_sub, RHS>::apply(temp, proxy.rhs());